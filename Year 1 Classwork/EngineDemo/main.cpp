@@ -3,13 +3,17 @@
  * Author:             Elizabeth Lowry
  * Date Created:       February 4, 2014
  * Description:        Runs a simple game to demonstrate MyFirstEngine.
- * Last Modified:      March 25, 2014
- * Last Modification:  Testing mouse and keyboard input.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Running headless on the null backend with per-frame CPU
+ *                      timings.
  ******************************************************************************/
 
 #include "MyFirstEngine.h"
 #include <cmath>
 #include <conio.h>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
 #include <iostream>
 
 using namespace MyFirstEngine;
@@ -179,7 +183,7 @@ protected:
                 m_oSprite.SetColor( Color::OPAQUE );
             }
         }
-        m_oSprite.Update( a_dDeltaTime );
+        Animator::UpdateAll();
         if( Keyboard::KeyIsPressed( Keyboard::ESCAPE ) )
         {
             GameEngine::ClearStates();
@@ -277,8 +281,62 @@ private:
     Frame::Array m_oFrameList;
 };
 
+// Print how long the CPU took over each frame of a headless run, along with
+// what the frame asked the null backend to do, then sum it all up
+void PrintFrameTimings()
+{
+    unsigned int uiFrames = NullBackend::FrameCount();
+    if( 0 == uiFrames )
+    {
+        return;
+    }
+    std::cout << std::endl
+              << "frame,cpu_ms,draw_calls,indices,uniform_sets,binds,"
+                 "buffer_bytes,texture_bytes" << std::endl;
+    double dTotal = 0.0;
+    double dMin = NullBackend::RecordedFrame( 0 ).dCPUTime;
+    double dMax = dMin;
+    for( unsigned int ui = 0; ui < uiFrames; ++ui )
+    {
+        const NullBackend::FrameStats& roFrame =
+            NullBackend::RecordedFrame( ui );
+        std::cout << ui << "," << std::fixed << std::setprecision( 4 )
+                  << roFrame.dCPUTime * 1000.0 << ","
+                  << roFrame.oCalls.uiDrawCalls << ","
+                  << roFrame.oCalls.ulIndices << ","
+                  << roFrame.oCalls.uiUniformSets << ","
+                  << roFrame.oCalls.uiBinds << ","
+                  << roFrame.oCalls.ulBufferBytes << ","
+                  << roFrame.oCalls.ulTextureBytes << std::endl;
+        dTotal += roFrame.dCPUTime;
+        dMin = ( roFrame.dCPUTime < dMin ? roFrame.dCPUTime : dMin );
+        dMax = ( roFrame.dCPUTime > dMax ? roFrame.dCPUTime : dMax );
+    }
+    const NullBackend::Resources& roResident = NullBackend::Resident();
+    std::cout << std::endl << uiFrames << " frames, CPU ms per frame: min "
+              << dMin * 1000.0 << ", mean " << dTotal * 1000.0 / uiFrames
+              << ", max " << dMax * 1000.0 << std::endl
+              << "Draw calls per frame: "
+              << NullBackend::Totals().uiDrawCalls / uiFrames << std::endl
+              << "Resident: " << roResident.uiTextures << " textures ("
+              << roResident.ulTextureBytes << " bytes), "
+              << roResident.uiBuffers << " buffers ("
+              << roResident.ulBufferBytes << " bytes), "
+              << roResident.uiPrograms << " programs" << std::endl;
+}
+
+// Run with "--headless [frames]" to run the demo for that many frames (600 if
+// not given) without a window or a GPU, and print per-frame CPU timings
 int main(int argc, char* argv[])
 {
+    bool bHeadless = ( 1 < argc && 0 == std::strcmp( argv[1], "--headless" ) );
+    if( bHeadless )
+    {
+        int iFrames = ( 2 < argc ? std::atoi( argv[2] ) : 600 );
+        NullBackend::Install();
+        NullBackend::SetFrameLimit( 0 < iFrames ? iFrames : 600 );
+    }
+
     std::cout << "Initializing Game Engine...";
     bool bSuccess = GameEngine::Initialize( 800, 600, "Simple Test Program" );
     if( !bSuccess )
@@ -287,19 +345,24 @@ int main(int argc, char* argv[])
     }
     else
     {
-        std::cout << "\tGame Engine Initialized." << std::endl
-                  << std::endl << "Close game window or press Escape to exit...";
+        std::cout << "\tGame Engine Initialized." << std::endl << std::endl
+                  << ( bHeadless ? "Running headless..."
+                                 : "Close game window or press Escape to "
+                                   "exit..." );
         SimpleState::Initialize();
         GameEngine::MainWindow().SetClearColor( Color::GrayScale::ONE_HALF );
         SimpleState::Instance().Push();
+        NullBackend::ResetStats();
         GameEngine::Run();
 
-        std::cout << "\tWindow closed." << std::endl
-                  << std::endl << "Terminating Game Engine...";
+        std::cout << "\tWindow closed." << std::endl;
+        PrintFrameTimings();
+        std::cout << std::endl << "Terminating Game Engine...";
         SimpleState::Terminate();
         GameEngine::Terminate();
         std::cout << "\tGame Engine terminated." << std::endl;
     }
+    NullBackend::Uninstall();
 
     //TODO
     return 0;
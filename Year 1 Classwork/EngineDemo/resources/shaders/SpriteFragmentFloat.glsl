@@ -0,0 +1,50 @@
+/******************************************************************************
+ * File:               SpriteFragmentFloat.glsl
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Single-precision fragment shader for a Sprite.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Creation.
+ ******************************************************************************/
+
+#version 410
+
+uniform vec4 u_v4Color;
+uniform sampler2D u_t2dTexture;
+uniform vec2 u_v2OffsetUV;
+uniform vec2 u_v2SizeUV;
+uniform bool u_bClampX;
+uniform bool u_bClampY;
+
+in vec2 v_v2TexCoordinate;
+
+float ScaleUV( in float a_fValue, in float a_fOffset,
+               in float a_fSize, in bool a_bClamp )
+{
+    if( a_bClamp )
+    {
+        if( a_fValue < 0.0 )
+        {
+            return a_fOffset;
+        }
+        if( a_fValue > 1.0 )
+        {
+            return a_fOffset + a_fSize;
+        }
+        return a_fOffset + ( a_fValue * a_fSize );
+    }
+
+    int iSteps = int( a_fValue );
+    float fPosition = a_fValue - float( iSteps );
+    return float( iSteps ) + a_fOffset + ( a_fSize * fPosition );
+}
+
+void main()
+{
+    vec2 v2TexCoordinateUV =
+        vec2( ScaleUV( v_v2TexCoordinate.x, u_v2OffsetUV.x,
+                       u_v2SizeUV.x, u_bClampX ),
+              ScaleUV( v_v2TexCoordinate.y, u_v2OffsetUV.y,
+                       u_v2SizeUV.y, u_bClampY ) );
+    gl_FragColor = texture( u_t2dTexture, v2TexCoordinateUV ) * u_v4Color;
+}
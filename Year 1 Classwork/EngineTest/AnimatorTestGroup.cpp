@@ -0,0 +1,461 @@
+/******************************************************************************
+ * File:               AnimatorTestGroup.cpp
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Animator tests, comparing the batch update to the
+ *                      per-object update it replaced.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Creation.
+ ******************************************************************************/
+
+#include "AnimatorTestGroup.h"
+#include "MyFirstEngine.h"
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace MyFirstEngine;
+
+namespace
+{
+
+// Completion callbacks called since the count was last cleared
+unsigned int sg_uiCompletions = 0;
+void CountCompletion( AnimatedSprite& a_roSprite ) { ++sg_uiCompletions; }
+
+// Step a linear congruential generator and return its high bits
+unsigned int Random( unsigned int& a_ruiSeed )
+{
+    a_ruiSeed = a_ruiSeed * 1664525u + 1013904223u;
+    return a_ruiSeed >> 8;
+}
+
+// AnimatedSprite as it was before there was an Animator, reduced to playing,
+// pausing, rewinding, and updating itself.  Endless animations used to divide
+// by their zero length to count completed loops, so only their frame numbers
+// are worth comparing.
+class OldAnimatedSprite : public Sprite
+{
+public:
+
+    OldAnimatedSprite( Texture& a_roTexture,
+                       const Frame::Array& ac_roFrameList,
+                       double a_dFPS, unsigned int a_uiLoops )
+        : Sprite( a_roTexture, ac_roFrameList ), m_dFPS( a_dFPS ),
+          m_uiLoops( a_uiLoops ), m_uiCompletedLoops( 0 ),
+          m_uiCompletions( 0 ), m_dSeconds( 0.0 ), m_dUnpauseTime( 0.0 ),
+          m_bPaused( true ) {}
+    virtual ~OldAnimatedSprite() {}
+
+    virtual OldAnimatedSprite& Update( double a_dTime )
+    {
+        if( m_bPaused || IsCompleted() )
+        {
+            return *this;
+        }
+        if( 0.0 == m_dFPS )
+        {
+            if( FrameCount() - 1 == FrameNumber() )
+            {
+                ++m_uiCompletedLoops;
+            }
+            if( !IsCompleted() )
+            {
+                SetFrameNumber( FrameNumber() + 1 );
+            }
+        }
+        else
+        {
+            double dElapsedSeconds = m_dSeconds + ( a_dTime - m_dUnpauseTime );
+            m_uiCompletedLoops = ( 0 == m_uiLoops ? 0 :
+                                   (unsigned int)( dElapsedSeconds /
+                                                   LengthInSeconds() ) );
+            SetFrameNumber( IsCompleted() ? FrameCount() - 1 :
+                            (unsigned int)( dElapsedSeconds * m_dFPS ) );
+        }
+        if( IsCompleted() )
+        {
+            ++m_uiCompletions;
+        }
+        return *this;
+    }
+
+    void Play( double a_dTime )
+    {
+        if( m_bPaused )
+        {
+            m_dUnpauseTime = a_dTime;
+            m_bPaused = false;
+        }
+    }
+    void Pause( double a_dTime )
+    {
+        if( !m_bPaused )
+        {
+            m_dSeconds = ( IsCompleted() ? LengthInSeconds() :
+                           m_dSeconds + ( a_dTime - m_dUnpauseTime ) );
+            m_bPaused = true;
+        }
+    }
+    void Rewind( double a_dTime )
+    {
+        m_dSeconds = 0.0;
+        m_dUnpauseTime = ( m_bPaused ? m_dUnpauseTime : a_dTime );
+        SetFrameNumber( 0 );
+        m_uiCompletedLoops = 0;
+    }
+
+    bool IsCompleted() const
+    {
+        return ( 0 == FrameCount() ? true :
+                 0 == m_uiLoops ? false :
+                 m_uiLoops <= m_uiCompletedLoops );
+    }
+    bool IsPaused() const { return m_bPaused; }
+    unsigned int Loops() const { return m_uiLoops; }
+    unsigned int CompletedLoops() const { return m_uiCompletedLoops; }
+    unsigned int Completions() const { return m_uiCompletions; }
+    double LengthInSeconds() const
+    {
+        return ( 0.0 == m_dFPS ? 0.0 : m_uiLoops * FrameCount() / m_dFPS );
+    }
+
+private:
+
+    double m_dFPS;
+    unsigned int m_uiLoops;
+    unsigned int m_uiCompletedLoops;
+    unsigned int m_uiCompletions;
+    double m_dSeconds;
+    double m_dUnpauseTime;
+    bool m_bPaused;
+
+};  // class OldAnimatedSprite
+
+// Does an animated sprite look the same as the old one?
+bool Matches( const AnimatedSprite& ac_roSprite,
+              const OldAnimatedSprite& ac_roExpected )
+{
+    return ( ac_roExpected.FrameNumber() == ac_roSprite.FrameNumber() &&
+             ac_roExpected.IsPaused() == ac_roSprite.IsPaused() &&
+             ac_roExpected.IsCompleted() == ac_roSprite.IsCompleted() &&
+             ( 0 == ac_roExpected.Loops() ||
+               ac_roExpected.CompletedLoops() ==
+                   ac_roSprite.CompletedLoops() ) );
+}
+
+// Animations with every combination of frame count, frame rate, and loop
+// count that matters, each paired with an old sprite set up the same way
+class AnimationSet
+{
+public:
+
+    AnimationSet( unsigned int a_uiCount, unsigned int a_uiSeed )
+        : m_oTexture( "" )
+    {
+        for( unsigned int ui = 0; ui <= 8; ++ui )
+        {
+            m_oFrameLists.push_back( new Frame::Array( ui ) );
+        }
+        for( unsigned int ui = 0; ui < a_uiCount; ++ui )
+        {
+            const Frame::Array& croFrames =
+                *m_oFrameLists[ Random( a_uiSeed ) % m_oFrameLists.size() ];
+            double dFPS = ( 0 == Random( a_uiSeed ) % 3 ? 0.0 :
+                            1 + Random( a_uiSeed ) % 30 +
+                            ( Random( a_uiSeed ) % 7 ) / 8.0 );
+            unsigned int uiLoops = Random( a_uiSeed ) % 4;
+            m_oSprites.push_back( new AnimatedSprite( m_oTexture, croFrames,
+                                                      dFPS, uiLoops,
+                                                      &CountCompletion ) );
+            m_oExpected.push_back(
+                new OldAnimatedSprite( m_oTexture, croFrames, dFPS, uiLoops ) );
+        }
+    }
+    virtual ~AnimationSet()
+    {
+        for each( AnimatedSprite* poSprite in m_oSprites )
+        {
+            delete poSprite;
+        }
+        for each( OldAnimatedSprite* poSprite in m_oExpected )
+        {
+            delete poSprite;
+        }
+        for each( Frame::Array* poFrames in m_oFrameLists )
+        {
+            delete poFrames;
+        }
+    }
+
+    unsigned int Size() const { return m_oSprites.size(); }
+    AnimatedSprite& New( unsigned int a_ui ) { return *m_oSprites[ a_ui ]; }
+    OldAnimatedSprite& Old( unsigned int a_ui ) { return *m_oExpected[ a_ui ]; }
+
+    // Total completions the old sprites have had
+    unsigned int ExpectedCompletions() const
+    {
+        unsigned int uiCompletions = 0;
+        for each( OldAnimatedSprite* poSprite in m_oExpected )
+        {
+            uiCompletions += poSprite->Completions();
+        }
+        return uiCompletions;
+    }
+
+    // Index of the first sprite that doesn't match its old sprite, or
+    // Size() if they all do
+    unsigned int FirstMismatch() const
+    {
+        for( unsigned int ui = 0; ui < m_oSprites.size(); ++ui )
+        {
+            if( !Matches( *m_oSprites[ ui ], *m_oExpected[ ui ] ) )
+            {
+                return ui;
+            }
+        }
+        return m_oSprites.size();
+    }
+
+private:
+
+    Texture m_oTexture;
+    std::vector< Frame::Array* > m_oFrameLists;
+    std::vector< AnimatedSprite* > m_oSprites;
+    std::vector< OldAnimatedSprite* > m_oExpected;
+
+};  // class AnimationSet
+
+// Plays a set of animations for a number of engine frames, playing, pausing,
+// and rewinding them at random, and compares them to the old sprites after
+// every update.  Ends the game once the frames are up or anything differs.
+class Lockstep : public GameState
+{
+public:
+
+    Lockstep( bool a_bBatch, unsigned int a_uiFrames )
+        : m_oAnimations( 2000, 7 ), m_bBatch( a_bBatch ),
+          m_uiFrames( a_uiFrames ), m_uiFrame( 0 ), m_uiSeed( 11 ) {}
+    virtual ~Lockstep() {}
+
+    unsigned int Frames() const { return m_uiFrame; }
+    const std::string& Mismatch() const { return m_oMismatch; }
+
+protected:
+
+    // Start most of the animations right away
+    virtual void OnEnter() override
+    {
+        for( unsigned int ui = 0; ui < m_oAnimations.Size(); ++ui )
+        {
+            if( 0 != Random( m_uiSeed ) % 4 )
+            {
+                m_oAnimations.New( ui ).Play();
+                m_oAnimations.Old( ui ).Play( GameEngine::LastTime() );
+            }
+        }
+    }
+
+    virtual void OnUpdate( double a_dDeltaTime ) override
+    {
+        double dTime = GameEngine::LastTime();
+        for( unsigned int ui = 0; ui < m_oAnimations.Size(); ++ui )
+        {
+            AnimatedSprite& roSprite = m_oAnimations.New( ui );
+            OldAnimatedSprite& roExpected = m_oAnimations.Old( ui );
+            switch( Random( m_uiSeed ) % 200 )
+            {
+            case 0: roSprite.Play(); roExpected.Play( dTime ); break;
+            case 1: roSprite.Pause(); roExpected.Pause( dTime ); break;
+            case 2: roSprite.Rewind(); roExpected.Rewind( dTime ); break;
+            default: break;
+            }
+        }
+
+        unsigned int uiCompletions = sg_uiCompletions;
+        for( unsigned int ui = 0; ui < m_oAnimations.Size(); ++ui )
+        {
+            m_oAnimations.Old( ui ).Update( dTime );
+        }
+        if( m_bBatch )
+        {
+            Animator::UpdateAll();
+        }
+        else
+        {
+            for( unsigned int ui = 0; ui < m_oAnimations.Size(); ++ui )
+            {
+                m_oAnimations.New( ui ).Update( a_dDeltaTime );
+            }
+        }
+
+        ++m_uiFrame;
+        unsigned int uiMismatch = m_oAnimations.FirstMismatch();
+        if( uiMismatch < m_oAnimations.Size() )
+        {
+            std::ostringstream oMessage;
+            oMessage << "Animation " << uiMismatch << " differed on frame "
+                     << m_uiFrame;
+            m_oMismatch = oMessage.str();
+        }
+        else if( m_oAnimations.ExpectedCompletions() != sg_uiCompletions )
+        {
+            std::ostringstream oMessage;
+            oMessage << "Completion callbacks differed on frame " << m_uiFrame
+                     << " (" << sg_uiCompletions - uiCompletions << " called)";
+            m_oMismatch = oMessage.str();
+        }
+        if( !m_oMismatch.empty() || m_uiFrames <= m_uiFrame )
+        {
+            GameEngine::ClearStates();
+        }
+    }
+
+private:
+
+    AnimationSet m_oAnimations;
+    bool m_bBatch;
+    unsigned int m_uiFrames;
+    unsigned int m_uiFrame;
+    unsigned int m_uiSeed;
+    std::string m_oMismatch;
+
+};  // class Lockstep
+
+// Run the engine headless, updating animations one way or the other, and see
+// that every frame matches the old per-object update.  The frame time isn't a
+// whole number of any animation's frames, so frame boundaries get tested from
+// both sides.
+UnitTest::Result RunLockstep( bool a_bBatch )
+{
+    const unsigned int cuiFrames = 600;
+    if( !GameEngine::Initialize() )
+    {
+        return UnitTest::Fail( "Engine didn't initialize" );
+    }
+    double dFrameTime = NullBackend::FrameTime();
+    NullBackend::SetFrameTime( 0.0173 );
+    sg_uiCompletions = 0;
+    unsigned int uiFrames = 0;
+    std::string oMismatch;
+    {
+        Lockstep oState( a_bBatch, cuiFrames );
+        oState.Push();
+        GameEngine::Run();
+        uiFrames = oState.Frames();
+        oMismatch = oState.Mismatch();
+    }
+    GameEngine::Terminate();
+    NullBackend::SetFrameTime( dFrameTime );
+    if( !oMismatch.empty() )
+    {
+        return UnitTest::Fail( oMismatch );
+    }
+    if( cuiFrames != uiFrames )
+    {
+        return UnitTest::Fail( "Game ended early" );
+    }
+    if( 0 != Animator::Count() )
+    {
+        return UnitTest::Fail( "Destroyed sprites left animations behind" );
+    }
+    return UnitTest::PASS;
+}
+
+}   // namespace
+
+AnimatorTestGroup::AnimatorTestGroup()
+    : UnitTestGroup("Animator tests")
+{
+    AddTest( "Batch update matches the old update", BatchUpdate );
+    AddTest( "Sprite update matches the old update", SpriteUpdate );
+    AddTest( "Updating 100,000 animations", Benchmark );
+}
+
+UnitTest::Result AnimatorTestGroup::BatchUpdate()
+{
+    return RunLockstep( true );
+}
+
+UnitTest::Result AnimatorTestGroup::SpriteUpdate()
+{
+    return RunLockstep( false );
+}
+
+// Time a frame-rate-driven update of 100,000 endless animations, the old way
+// and the batched way, and check they still agree at the end
+UnitTest::Result AnimatorTestGroup::Benchmark()
+{
+    const unsigned int cuiCount = 100000;
+    const unsigned int cuiFrames = 100;
+    std::vector< Frame::Array* > oFrameLists;
+    for( unsigned int ui = 1; ui <= 8; ++ui )
+    {
+        oFrameLists.push_back( new Frame::Array( ui ) );
+    }
+    Texture oTexture( "" );
+    std::vector< AnimatedSprite* > oSprites;
+    std::vector< OldAnimatedSprite* > oExpected;
+    double dTime = GameEngine::LastTime();
+    unsigned int uiSeed = 3;
+    for( unsigned int ui = 0; ui < cuiCount; ++ui )
+    {
+        const Frame::Array& croFrames =
+            *oFrameLists[ Random( uiSeed ) % oFrameLists.size() ];
+        double dFPS = 1 + Random( uiSeed ) % 30;
+        oSprites.push_back( new AnimatedSprite( oTexture, croFrames, dFPS ) );
+        oExpected.push_back(
+            new OldAnimatedSprite( oTexture, croFrames, dFPS, 0 ) );
+        oSprites.back()->Play();
+        oExpected.back()->Play( dTime );
+    }
+
+    double dOldSeconds = 0.0;
+    double dBatchSeconds = 0.0;
+    Animator::Stats oLastUpdate = { 0, 0, 0, 0 };
+    for( unsigned int ui = 0; ui < cuiFrames; ++ui )
+    {
+        dTime += 1.0 / 60.0;
+        double dStart = NullBackend::CPUTime();
+        for each( OldAnimatedSprite* poSprite in oExpected )
+        {
+            poSprite->Update( dTime );
+        }
+        double dMiddle = NullBackend::CPUTime();
+        Animator::UpdateAll( dTime );
+        double dEnd = NullBackend::CPUTime();
+        dOldSeconds += dMiddle - dStart;
+        dBatchSeconds += dEnd - dMiddle;
+        oLastUpdate = Animator::LastUpdate();
+    }
+
+    unsigned int uiMismatches = 0;
+    for( unsigned int ui = 0; ui < cuiCount; ++ui )
+    {
+        if( !Matches( *oSprites[ ui ], *oExpected[ ui ] ) )
+        {
+            ++uiMismatches;
+        }
+        delete oSprites[ ui ];
+        delete oExpected[ ui ];
+    }
+    for each( Frame::Array* poFrames in oFrameLists )
+    {
+        delete poFrames;
+    }
+
+    if( 0 != uiMismatches )
+    {
+        return UnitTest::Fail( "Batch update differed from the old update" );
+    }
+    if( cuiCount != oLastUpdate.uiAnimations ||
+        cuiCount != oLastUpdate.uiAdvanced )
+    {
+        return UnitTest::Fail( "Not every animation was advanced" );
+    }
+    std::ostringstream oMessage;
+    oMessage << "Old update " << dOldSeconds * 1000.0 / cuiFrames
+             << " ms/frame, batch update "
+             << dBatchSeconds * 1000.0 / cuiFrames << " ms/frame";
+    return UnitTest::Pass( oMessage.str() );
+}
@@ -0,0 +1,30 @@
+/******************************************************************************
+ * File:               AnimatorTestGroup.h
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Animator tests, comparing the batch update to the
+ *                      per-object update it replaced.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Creation.
+ ******************************************************************************/
+
+#ifndef ANIMATOR_TEST_GROUP__H
+#define ANIMATOR_TEST_GROUP__H
+
+#include "UnitTestGroup.h"
+
+class AnimatorTestGroup : public UnitTestGroup
+{
+public:
+
+    AnimatorTestGroup();
+
+private:
+
+    static UnitTest::Result BatchUpdate();
+    static UnitTest::Result SpriteUpdate();
+    static UnitTest::Result Benchmark();
+
+};
+
+#endif  // ANIMATOR_TEST_GROUP__H
@@ -0,0 +1,157 @@
+/******************************************************************************
+ * File:               CullingBenchmarkTestGroup.cpp
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Culling benchmark, scrolling the camera across a world
+ *                      of a million objects.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Creation.
+ ******************************************************************************/
+
+#include "CullingBenchmarkTestGroup.h"
+#include "MyFirstEngine.h"
+#include <algorithm>
+#include <sstream>
+#include <vector>
+
+using namespace MyFirstEngine;
+
+namespace
+{
+
+// Objects in the world, and frames spent scrolling across it
+const unsigned int sgc_uiObjects = 1000000;
+const unsigned int sgc_uiFrames = 60;
+
+// The world is a long strip, centered vertically on the camera, which starts
+// a little way in and scrolls along it at a constant speed.  The camera shows
+// an 800 x 600 rectangle of it.
+const double sgc_dWorldLength = 200000.0;
+const double sgc_dWorldHeight = 2000.0;
+const double sgc_dStart = 1000.0;
+const double sgc_dScrollSpeed = 16.0;   // world units per frame
+const double sgc_dHalfWidth = 400.0;
+const double sgc_dHalfHeight = 300.0;
+
+// Step a linear congruential generator and return its high bits
+unsigned int Random( unsigned int& a_ruiSeed )
+{
+    a_ruiSeed = a_ruiSeed * 1664525u + 1013904223u;
+    return a_ruiSeed >> 8;
+}
+
+// Flat boxes scattered across the world, kept as separate arrays for each
+// coordinate the way Culling::Cull takes them
+struct World
+{
+    std::vector< double > oMinX, oMinY, oMinZ, oMaxX, oMaxY, oMaxZ;
+
+    World( unsigned int a_uiCount, unsigned int a_uiSeed )
+        : oMinX( a_uiCount ), oMinY( a_uiCount ), oMinZ( a_uiCount, 0.0 ),
+          oMaxX( a_uiCount ), oMaxY( a_uiCount ), oMaxZ( a_uiCount, 0.0 )
+    {
+        for( unsigned int ui = 0; ui < a_uiCount; ++ui )
+        {
+            double dSize = 8 + Random( a_uiSeed ) % 33;
+            oMinX[ ui ] = Random( a_uiSeed ) %
+                          (unsigned int)sgc_dWorldLength;
+            oMinY[ ui ] = (double)( Random( a_uiSeed ) %
+                                    (unsigned int)sgc_dWorldHeight ) -
+                          sgc_dWorldHeight / 2;
+            oMaxX[ ui ] = oMinX[ ui ] + dSize;
+            oMaxY[ ui ] = oMinY[ ui ] + dSize;
+        }
+    }
+};
+
+}   // namespace
+
+CullingBenchmarkTestGroup::CullingBenchmarkTestGroup()
+    : UnitTestGroup("Culling benchmarks")
+{
+    AddTest( "Scrolling across 1,000,000 objects", Scrolling );
+}
+
+// CPU time per frame to cull a million-object world as the 2D camera scrolls
+// across it, testing all the boxes at once with Culling::Cull and one at a
+// time with Frustum::Test.  Both should pass the same boxes every frame, and
+// only a small fraction of the world should be visible at once.
+UnitTest::Result CullingBenchmarkTestGroup::Scrolling()
+{
+    World oWorld( sgc_uiObjects, 5 );
+    std::vector< unsigned int > oBatch( sgc_uiObjects );
+    std::vector< unsigned int > oSingle( sgc_uiObjects );
+    Camera::Enable();
+    Camera::SetScreenSize( sgc_dHalfWidth, sgc_dHalfHeight );
+    GameEngine::PushModelView( GLTransform3D::Identity() );
+
+    double dBatchSeconds = 0.0;
+    double dSingleSeconds = 0.0;
+    unsigned int uiMismatches = 0;
+    unsigned int uiFewest = sgc_uiObjects;
+    unsigned int uiMost = 0;
+    for( unsigned int ui = 0; ui < sgc_uiFrames; ++ui )
+    {
+        Camera::SetPosition( sgc_dStart + ui * sgc_dScrollSpeed, 0.0 );
+        Camera::Refresh();
+
+        double dStart = NullBackend::CPUTime();
+        unsigned int uiBatch =
+            Culling::Cull( &oWorld.oMinX[0], &oWorld.oMinY[0],
+                           &oWorld.oMinZ[0], &oWorld.oMaxX[0],
+                           &oWorld.oMaxY[0], &oWorld.oMaxZ[0],
+                           sgc_uiObjects, &oBatch[0] );
+        double dMiddle = NullBackend::CPUTime();
+        Space::Frustum oFrustum = Culling::ViewFrustum();
+        unsigned int uiPlanes = Culling::ViewPlanes();
+        unsigned int uiSingle = 0;
+        for( unsigned int uiObject = 0; uiObject < sgc_uiObjects; ++uiObject )
+        {
+            Space::BoundingBox oBox =
+                { { oWorld.oMinX[ uiObject ], oWorld.oMinY[ uiObject ],
+                    oWorld.oMinZ[ uiObject ] },
+                  { oWorld.oMaxX[ uiObject ], oWorld.oMaxY[ uiObject ],
+                    oWorld.oMaxZ[ uiObject ] } };
+            if( Space::Frustum::OUTSIDE != oFrustum.Test( oBox, uiPlanes ) )
+            {
+                oSingle[ uiSingle++ ] = uiObject;
+            }
+        }
+        double dEnd = NullBackend::CPUTime();
+        dBatchSeconds += dMiddle - dStart;
+        dSingleSeconds += dEnd - dMiddle;
+
+        if( uiBatch != uiSingle ||
+            !std::equal( oBatch.begin(), oBatch.begin() + uiBatch,
+                         oSingle.begin() ) )
+        {
+            ++uiMismatches;
+        }
+        uiFewest = std::min( uiFewest, uiBatch );
+        uiMost = std::max( uiMost, uiBatch );
+    }
+
+    GameEngine::PopModelView();
+    Camera::SetPosition( Point3D::Origin() );
+    Camera::UseDefaultScreenSize();
+    Camera::Disable();
+    Camera::Refresh();
+
+    if( 0 != uiMismatches )
+    {
+        return UnitTest::Fail( "Batch culling passed different objects" );
+    }
+    if( 0 == uiFewest || sgc_uiObjects / 100 < uiMost )
+    {
+        std::ostringstream oMessage;
+        oMessage << "Between " << uiFewest << " and " << uiMost
+                 << " objects passed instead of a small fraction";
+        return UnitTest::Fail( oMessage.str() );
+    }
+    std::ostringstream oMessage;
+    oMessage << "Batch culling " << dBatchSeconds * 1000.0 / sgc_uiFrames
+             << " ms/frame, one at a time "
+             << dSingleSeconds * 1000.0 / sgc_uiFrames << " ms/frame, "
+             << uiFewest << " to " << uiMost << " objects visible";
+    return UnitTest::Pass( oMessage.str() );
+}
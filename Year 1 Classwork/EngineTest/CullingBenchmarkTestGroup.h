@@ -0,0 +1,28 @@
+/******************************************************************************
+ * File:               CullingBenchmarkTestGroup.h
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Culling benchmark, scrolling the camera across a world
+ *                      of a million objects.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Creation.
+ ******************************************************************************/
+
+#ifndef CULLING_BENCHMARK_TEST_GROUP__H
+#define CULLING_BENCHMARK_TEST_GROUP__H
+
+#include "UnitTestGroup.h"
+
+class CullingBenchmarkTestGroup : public UnitTestGroup
+{
+public:
+
+    CullingBenchmarkTestGroup();
+
+private:
+
+    static UnitTest::Result Scrolling();
+
+};
+
+#endif  // CULLING_BENCHMARK_TEST_GROUP__H
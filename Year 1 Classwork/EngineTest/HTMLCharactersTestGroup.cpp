@@ -0,0 +1,164 @@
+/******************************************************************************
+ * File:               HTMLCharactersTestGroup.cpp
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Tests that HTML::Find accepts exactly the names in
+ *                      HTML::Map, for the same characters.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Creation.
+ ******************************************************************************/
+
+#include "HTMLCharactersTestGroup.h"
+#include "MyFirstEngine.h"
+#include <cstring>  // for strlen
+#include <sstream>
+#include <string>
+
+namespace
+{
+
+// Every character that can appear in a number code, plus letters that can't
+const char sgc_acNumberCharacters[] = "#xX0123456789abcdefABCDEFgG";
+const unsigned int sgc_uiNumberCharacterCount =
+    sizeof( sgc_acNumberCharacters ) - 1;
+
+// Every HTML name in the map
+const char* const sgc_apcNames[] =
+{
+    "AElig", "Aacute", "Acirc", "Agrave", "Aring", "Atilde", "Auml", "Ccedil",
+    "Dagger", "ETH", "Eacute", "Ecirc", "Egrave", "Euml", "Iacute", "Icirc",
+    "Igrave", "Iuml", "Ntilde", "OElig", "Oacute", "Ocirc", "Ograve",
+    "Oslash", "Otilde", "Ouml", "Scaron", "THORN", "Uacute", "Ucirc",
+    "Ugrave", "Uuml", "Yacute", "Yuml", "Zcaron", "Zscaron", "aacute",
+    "acirc", "acute", "aelig", "agrave", "amp", "apos", "aring", "atilde",
+    "auml", "bdquo", "brvbar", "bull", "ccedil", "cedil", "cent", "circ",
+    "copy", "curren", "dagger", "deg", "divide", "eacute", "ecirc", "egrave",
+    "eth", "euml", "euro", "fnof", "frac12", "frac14", "frac34", "gt",
+    "hellip", "iacute", "icirc", "iexcl", "igrave", "iquest", "iuml",
+    "laquo", "ldquo", "lsaquo", "lsquo", "lt", "macr", "mdash", "micro",
+    "middot", "nbsp", "ndash", "not", "ntilde", "oacute", "ocirc", "oelig",
+    "ograve", "ordf", "ordm", "oslash", "otilde", "ouml", "para", "permil",
+    "plusmn", "pound", "quot", "raquo", "rdquo", "reg", "rsaquo", "rsquo",
+    "sbquo", "scaron", "sect", "shy", "sup1", "sup2", "sup3", "szlig",
+    "thorn", "tilde", "times", "trade", "uacute", "ucirc", "ugrave", "uml",
+    "uuml", "yacute", "yen", "yuml", "zcaron"
+};
+const unsigned int sgc_uiNameCount =
+    sizeof( sgc_apcNames ) / sizeof( const char* );
+
+// Check that Find and the map agree on a name, returning a description of the
+// disagreement if they don't or an empty string if they do
+std::string Disagreement( const std::string& ac_roName )
+{
+    const MyFirstEngine::CharacterMap& roMap = HTML::Map();
+    char cFound = '\0';
+    bool bFound = HTML::Find( ac_roName.data(), ac_roName.size(), cFound );
+    bool bMapped = roMap.Has( ac_roName.c_str() );
+    if( bFound == bMapped &&
+        ( !bFound || roMap[ ac_roName.c_str() ] == cFound ) )
+    {
+        return "";
+    }
+    std::ostringstream oMessage;
+    oMessage << "Find and Map disagree on \"" << ac_roName << "\"";
+    return oMessage.str();
+}
+
+}   // namespace
+
+HTMLCharactersTestGroup::HTMLCharactersTestGroup()
+    : UnitTestGroup("HTML character tests")
+{
+    AddTest( "Find agrees with Map on short names", ShortNames );
+    AddTest( "Find agrees with Map on HTML names", HTMLNames );
+}
+
+// Every single character, and every name of two to four characters made of
+// number code characters, which covers every number code for every char in
+// every case along with leading zeros, values too large, and stray letters.
+UnitTest::Result HTMLCharactersTestGroup::ShortNames()
+{
+    unsigned int uiFound = 0;
+    for( unsigned int ui = 0; ui < 256; ++ui )
+    {
+        std::string oMessage = Disagreement( std::string( 1, (char)ui ) );
+        if( !oMessage.empty() )
+        {
+            return UnitTest::Fail( oMessage );
+        }
+    }
+    for( unsigned int uiLength = 2; uiLength <= 4; ++uiLength )
+    {
+        unsigned int uiCount = 1;
+        for( unsigned int ui = 0; ui < uiLength; ++ui )
+        {
+            uiCount *= sgc_uiNumberCharacterCount;
+        }
+        std::string oName( uiLength, ' ' );
+        for( unsigned int ui = 0; ui < uiCount; ++ui )
+        {
+            unsigned int uiDigits = ui;
+            for( unsigned int uj = 0; uj < uiLength; ++uj )
+            {
+                oName[ uj ] = sgc_acNumberCharacters[
+                    uiDigits % sgc_uiNumberCharacterCount ];
+                uiDigits /= sgc_uiNumberCharacterCount;
+            }
+            std::string oMessage = Disagreement( oName );
+            if( !oMessage.empty() )
+            {
+                return UnitTest::Fail( oMessage );
+            }
+            char cFound = '\0';
+            if( HTML::Find( oName.data(), oName.size(), cFound ) )
+            {
+                ++uiFound;
+            }
+        }
+    }
+
+    // Each char has a decimal code, plus a hex code after each of three
+    // prefixes.  The hex digits can be spelled two ways for the 120 values
+    // with one letter digit and four ways for the 36 with two.  The only HTML
+    // name made of these characters is "deg".
+    const unsigned int cuiSpellings = 256 + 120 + 36 * 3;
+    const unsigned int cuiExpected = 256 + 3 * cuiSpellings + 1;
+    if( cuiExpected != uiFound )
+    {
+        std::ostringstream oMessage;
+        oMessage << "Expected " << cuiExpected << " number codes, found "
+                 << uiFound;
+        return UnitTest::Fail( oMessage.str() );
+    }
+    return UnitTest::PASS;
+}
+
+// Every HTML name, along with the same name cut short, run long, and with its
+// first letter in the other case
+UnitTest::Result HTMLCharactersTestGroup::HTMLNames()
+{
+    for( unsigned int ui = 0; ui < sgc_uiNameCount; ++ui )
+    {
+        std::string oName( sgc_apcNames[ ui ] );
+        char cFound = '\0';
+        if( !HTML::Find( oName.c_str(), cFound ) )
+        {
+            return UnitTest::Fail( "Find didn't know \"" + oName + "\"" );
+        }
+        std::string oOtherCase( oName );
+        oOtherCase[0] = (char)( 'a' <= oName[0] ? oName[0] - 'a' + 'A'
+                                                : oName[0] - 'A' + 'a' );
+        const std::string caoNames[] =
+            { oName, oName.substr( 0, oName.size() - 1 ), oName + "x",
+              oName + oName[ oName.size() - 1 ], oOtherCase };
+        for each( const std::string& roName in caoNames )
+        {
+            std::string oMessage = Disagreement( roName );
+            if( !oMessage.empty() )
+            {
+                return UnitTest::Fail( oMessage );
+            }
+        }
+    }
+    return UnitTest::PASS;
+}
@@ -0,0 +1,29 @@
+/******************************************************************************
+ * File:               HTMLCharactersTestGroup.h
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Tests that HTML::Find accepts exactly the names in
+ *                      HTML::Map, for the same characters.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Creation.
+ ******************************************************************************/
+
+#ifndef HTML_CHARACTERS_TEST_GROUP__H
+#define HTML_CHARACTERS_TEST_GROUP__H
+
+#include "UnitTestGroup.h"
+
+class HTMLCharactersTestGroup : public UnitTestGroup
+{
+public:
+
+    HTMLCharactersTestGroup();
+
+private:
+
+    static UnitTest::Result ShortNames();
+    static UnitTest::Result HTMLNames();
+
+};
+
+#endif  // HTML_CHARACTERS_TEST_GROUP__H
@@ -0,0 +1,346 @@
+/******************************************************************************
+ * File:               InputTestGroup.cpp
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Keyboard and mouse state tests, posting input events
+ *                      to headless game sessions on the null backend.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Creation.
+ ******************************************************************************/
+
+#include "InputTestGroup.h"
+#include "MyFirstEngine.h"
+#include <cmath>
+#include <sstream>
+#include <string>
+
+using namespace MyFirstEngine;
+
+namespace
+{
+
+// One frame of a scripted session.  Checks what the keyboard and mouse report
+// this frame and posts events for the frames to come, setting the failure
+// message if anything is wrong.  Returns false once the script is done.
+typedef bool (*Step)( unsigned int a_uiFrame, std::string& a_roFailure );
+
+// A headless game session that runs a script, one step each frame, until the
+// script is done or something fails
+class Script : public GameState
+{
+public:
+
+    Script( Step a_pfStep ) : m_pfStep( a_pfStep ), m_uiFrame( 0 ) {}
+    virtual ~Script() {}
+
+    unsigned int Frames() const { return m_uiFrame; }
+    const std::string& Failure() const { return m_oFailure; }
+
+protected:
+
+    virtual void OnUpdate( double a_dDeltaTime ) override
+    {
+        if( !m_pfStep( m_uiFrame++, m_oFailure ) || !m_oFailure.empty() )
+        {
+            GameEngine::ClearStates();
+        }
+    }
+
+private:
+
+    Step m_pfStep;
+    unsigned int m_uiFrame;
+    std::string m_oFailure;
+
+};  // class Script
+
+// Post an event the given fraction of a frame after this frame's time.
+// Events have to be posted in the order they happen.
+void Post( Input::Device a_eDevice, int a_iCode, bool a_bPressed,
+           double a_dFrames )
+{
+    Input::Post( a_eDevice, a_iCode, a_bPressed, GameEngine::LastTime() +
+                 NullBackend::FrameTime() * a_dFrames );
+}
+
+// Is a time the given number of frames long, give or take rounding?
+bool Frames( double a_dSeconds, double a_dFrames )
+{
+    return std::abs( a_dSeconds - NullBackend::FrameTime() * a_dFrames ) <
+           1.0e-9;
+}
+
+// Run a script on a freshly initialized engine.  The frame limit stops a
+// script that never finishes.
+UnitTest::Result Run( Step a_pfStep, unsigned int a_uiFrames )
+{
+    if( !GameEngine::Initialize() )
+    {
+        return UnitTest::Fail( "Engine didn't initialize" );
+    }
+    Script oScript( a_pfStep );
+    NullBackend::SetFrameLimit( a_uiFrames + 1 );
+    oScript.Push();
+    GameEngine::Run();
+    NullBackend::SetFrameLimit( 0 );
+    GameEngine::Terminate();
+    if( !oScript.Failure().empty() )
+    {
+        return UnitTest::Fail( oScript.Failure() );
+    }
+    if( a_uiFrames != oScript.Frames() )
+    {
+        return UnitTest::Fail( "Session ended early" );
+    }
+    return UnitTest::PASS;
+}
+
+// A key and a button each pressed and released before the next frame
+bool TapStep( unsigned int a_uiFrame, std::string& a_roFailure )
+{
+    switch( a_uiFrame )
+    {
+    case 0:
+        Post( Input::KEYBOARD, Keyboard::A, true, 0.25 );
+        Post( Input::MOUSE_BUTTON, Mouse::LEFT_BUTTON, true, 0.25 );
+        Post( Input::KEYBOARD, Keyboard::A, false, 0.5 );
+        Post( Input::MOUSE_BUTTON, Mouse::LEFT_BUTTON, false, 0.75 );
+        return true;
+    case 1:
+        if( !Keyboard::KeyWasPressed( Keyboard::A ) ||
+            !Keyboard::KeyWasReleased( Keyboard::A ) ||
+            Keyboard::KeyIsPressed( Keyboard::A ) ||
+            Keyboard::AnyKeyIsPressed() )
+        {
+            a_roFailure = "Tapped key wasn't both pressed and released";
+        }
+        else if( !Mouse::ButtonWasPressed( Mouse::LEFT_BUTTON ) ||
+                 !Mouse::ButtonWasReleased( Mouse::LEFT_BUTTON ) ||
+                 Mouse::LeftButtonIsPressed() )
+        {
+            a_roFailure = "Clicked button wasn't both pressed and released";
+        }
+        else if( !Frames( Keyboard::KeyTime( Keyboard::A ), 0.5 ) ||
+                 !Frames( Mouse::LeftButtonTime(), 0.25 ) )
+        {
+            a_roFailure = "Times weren't taken from the releases";
+        }
+        return true;
+    default:
+        if( Keyboard::KeyWasPressed( Keyboard::A ) ||
+            Keyboard::KeyWasReleased( Keyboard::A ) ||
+            Mouse::ButtonWasPressed( Mouse::LEFT_BUTTON ) ||
+            Mouse::ButtonWasReleased( Mouse::LEFT_BUTTON ) )
+        {
+            a_roFailure = "Changes were still reported a frame later";
+        }
+        return false;
+    }
+}
+
+// Events after the next frame's time wait for the frame after
+bool DeferredStep( unsigned int a_uiFrame, std::string& a_roFailure )
+{
+    switch( a_uiFrame )
+    {
+    case 0:
+        Post( Input::KEYBOARD, Keyboard::D, true, 0.5 );
+        Post( Input::KEYBOARD, Keyboard::W, true, 1.5 );
+        Post( Input::MOUSE_BUTTON, Mouse::RIGHT_BUTTON, true, 1.75 );
+        return true;
+    case 1:
+        if( !Keyboard::KeyIsPressed( Keyboard::D ) )
+        {
+            a_roFailure = "Event before the frame wasn't applied";
+        }
+        else if( Keyboard::KeyIsPressed( Keyboard::W ) ||
+                 Keyboard::KeyWasPressed( Keyboard::W ) ||
+                 Mouse::RightButtonIsPressed() ||
+                 Mouse::ButtonWasPressed( Mouse::RIGHT_BUTTON ) )
+        {
+            a_roFailure = "Events after the frame were applied early";
+        }
+        return true;
+    default:
+        if( !Keyboard::KeyIsPressed( Keyboard::W ) ||
+            !Keyboard::KeyWasPressed( Keyboard::W ) ||
+            !Mouse::RightButtonIsPressed() ||
+            !Mouse::ButtonWasPressed( Mouse::RIGHT_BUTTON ) )
+        {
+            a_roFailure = "Deferred events weren't applied the next frame";
+        }
+        else if( !Frames( Keyboard::KeyTime( Keyboard::W ), 0.5 ) ||
+                 !Frames( Mouse::RightButtonTime(), 0.25 ) )
+        {
+            a_roFailure = "Deferred events didn't keep their times";
+        }
+        else if( !Keyboard::KeyIsPressed( Keyboard::D ) ||
+                 Keyboard::KeyWasPressed( Keyboard::D ) )
+        {
+            a_roFailure = "Held key was reported as pressed again";
+        }
+        return false;
+    }
+}
+
+// Both shift keys pressed, one of them twice, then released one at a time.
+// Shift should count as pressed until both are up, timed from the first
+// press, and repeated presses or releases of keys that aren't down shouldn't
+// change the counts.
+bool ModifierStep( unsigned int a_uiFrame, std::string& a_roFailure )
+{
+    switch( a_uiFrame )
+    {
+    case 0:
+        Post( Input::KEYBOARD, Keyboard::LEFT_SHIFT, true, 0.25 );
+        Post( Input::KEYBOARD, Keyboard::RIGHT_SHIFT, true, 0.5 );
+        Post( Input::KEYBOARD, Keyboard::LEFT_SHIFT, true, 0.75 );
+        Post( Input::KEYBOARD, Keyboard::LEFT_CONTROL, false, 0.875 );
+        return true;
+    case 1:
+        if( !Keyboard::ShiftIsPressed() || !Keyboard::AnyKeyIsPressed() ||
+            Keyboard::ControlIsPressed() )
+        {
+            a_roFailure = "Shift keys weren't counted";
+        }
+        else if( Keyboard::KeyWasReleased( Keyboard::LEFT_CONTROL ) )
+        {
+            a_roFailure = "Releasing a key that wasn't down was reported";
+        }
+        else if( !Frames( Keyboard::ShiftTime(), 0.75 ) )
+        {
+            a_roFailure = "Shift wasn't timed from the first press";
+        }
+        Post( Input::KEYBOARD, Keyboard::LEFT_SHIFT, false, 0.5 );
+        return true;
+    case 2:
+        if( !Keyboard::ShiftIsPressed() ||
+            !Keyboard::KeyWasReleased( Keyboard::LEFT_SHIFT ) )
+        {
+            a_roFailure = "Releasing one shift key released shift";
+        }
+        else if( !Frames( Keyboard::ShiftTime(), 1.75 ) )
+        {
+            a_roFailure = "Releasing one shift key restarted shift's time";
+        }
+        Post( Input::KEYBOARD, Keyboard::RIGHT_SHIFT, false, 0.5 );
+        return true;
+    default:
+        if( Keyboard::ShiftIsPressed() || Keyboard::AnyKeyIsPressed() )
+        {
+            a_roFailure = "Shift still pressed after both keys were released";
+        }
+        else if( !Frames( Keyboard::ShiftTime(), 0.5 ) )
+        {
+            a_roFailure = "Shift wasn't timed from the last release";
+        }
+        return false;
+    }
+}
+
+// Keys and buttons held down for the benchmark, how many state queries were
+// true, and how long they took
+const Keyboard::Key sgc_aeHeldKeys[] = { Keyboard::W, Keyboard::SPACE,
+                                         Keyboard::LEFT_SHIFT, Keyboard::F12 };
+const unsigned int sgc_uiHeldKeys =
+    sizeof( sgc_aeHeldKeys ) / sizeof( *sgc_aeHeldKeys );
+const unsigned int sgc_uiRounds = 10000;
+unsigned int sg_uiKeysFound = 0;
+unsigned int sg_uiButtonsFound = 0;
+double sg_dKeySeconds = 0.0;
+double sg_dButtonSeconds = 0.0;
+
+// Hold some keys and a button down, then ask about every key and button over
+// and over
+bool BenchmarkStep( unsigned int a_uiFrame, std::string& a_roFailure )
+{
+    if( 0 == a_uiFrame )
+    {
+        for( unsigned int ui = 0; ui < sgc_uiHeldKeys; ++ui )
+        {
+            Post( Input::KEYBOARD, sgc_aeHeldKeys[ ui ], true, 0.5 );
+        }
+        Post( Input::MOUSE_BUTTON, Mouse::LEFT_BUTTON, true, 0.5 );
+        return true;
+    }
+
+    sg_uiKeysFound = 0;
+    sg_uiButtonsFound = 0;
+    double dStart = NullBackend::CPUTime();
+    for( unsigned int ui = 0; ui < sgc_uiRounds; ++ui )
+    {
+        for( int i = 0; i < Keyboard::KEY_COUNT; ++i )
+        {
+            if( Keyboard::KeyIsPressed( (Keyboard::Key)i ) &&
+                Keyboard::KeyWasPressed( (Keyboard::Key)i ) )
+            {
+                ++sg_uiKeysFound;
+            }
+        }
+    }
+    double dMiddle = NullBackend::CPUTime();
+    for( unsigned int ui = 0; ui < sgc_uiRounds; ++ui )
+    {
+        for( int i = 0; i < Mouse::BUTTON_COUNT; ++i )
+        {
+            if( Mouse::ButtonIsPressed( (Mouse::Button)i ) &&
+                Mouse::ButtonWasPressed( (Mouse::Button)i ) )
+            {
+                ++sg_uiButtonsFound;
+            }
+        }
+    }
+    double dEnd = NullBackend::CPUTime();
+    sg_dKeySeconds = dMiddle - dStart;
+    sg_dButtonSeconds = dEnd - dMiddle;
+    return false;
+}
+
+}   // namespace
+
+InputTestGroup::InputTestGroup()
+    : UnitTestGroup("Keyboard and mouse tests")
+{
+    AddTest( "Pressed and released in the same frame", SameFrame );
+    AddTest( "Events after the frame wait for the next", Deferred );
+    AddTest( "Modifier key counts", Modifiers );
+    AddTest( "Querying key and button states", Benchmark );
+}
+
+UnitTest::Result InputTestGroup::SameFrame()
+{
+    return Run( TapStep, 3 );
+}
+
+UnitTest::Result InputTestGroup::Deferred()
+{
+    return Run( DeferredStep, 3 );
+}
+
+UnitTest::Result InputTestGroup::Modifiers()
+{
+    return Run( ModifierStep, 4 );
+}
+
+// Time asking whether each key and button is pressed and went down this frame.
+// Only the answers are checked; the times are just reported.
+UnitTest::Result InputTestGroup::Benchmark()
+{
+    UnitTest::Result oResult = Run( BenchmarkStep, 2 );
+    if( !oResult.pass )
+    {
+        return oResult;
+    }
+    if( sgc_uiHeldKeys * sgc_uiRounds != sg_uiKeysFound ||
+        sgc_uiRounds != sg_uiButtonsFound )
+    {
+        return UnitTest::Fail( "Held keys and buttons weren't all found" );
+    }
+    std::ostringstream oMessage;
+    oMessage << "Keys " << sg_dKeySeconds * 1.0e9 /
+                           ( sgc_uiRounds * Keyboard::KEY_COUNT )
+             << " ns/query, buttons " << sg_dButtonSeconds * 1.0e9 /
+                                         ( sgc_uiRounds * Mouse::BUTTON_COUNT )
+             << " ns/query";
+    return UnitTest::Pass( oMessage.str() );
+}
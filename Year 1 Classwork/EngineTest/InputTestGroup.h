@@ -0,0 +1,31 @@
+/******************************************************************************
+ * File:               InputTestGroup.h
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Keyboard and mouse state tests, posting input events
+ *                      to headless game sessions on the null backend.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Creation.
+ ******************************************************************************/
+
+#ifndef INPUT_TEST_GROUP__H
+#define INPUT_TEST_GROUP__H
+
+#include "UnitTestGroup.h"
+
+class InputTestGroup : public UnitTestGroup
+{
+public:
+
+    InputTestGroup();
+
+private:
+
+    static UnitTest::Result SameFrame();
+    static UnitTest::Result Deferred();
+    static UnitTest::Result Modifiers();
+    static UnitTest::Result Benchmark();
+
+};
+
+#endif  // INPUT_TEST_GROUP__H
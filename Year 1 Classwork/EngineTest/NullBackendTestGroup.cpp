@@ -0,0 +1,274 @@
+/******************************************************************************
+ * File:               NullBackendTestGroup.cpp
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Null backend tests, checking that headless runs start,
+ *                      stop, keep time, and count what the engine does.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Creation.
+ ******************************************************************************/
+
+#include "NullBackendTestGroup.h"
+#include "TestTexture.h"
+#include "MyFirstEngine.h"
+#include <cmath>
+#include <sstream>
+#include <vector>
+
+using namespace MyFirstEngine;
+
+namespace
+{
+
+// The shader programs the engine sets up when it's initialized
+const unsigned int sgc_uiPrograms = 3;
+
+// A headless game state that remembers the time of each update, and can draw
+// a cleared screen with one quad on it each frame instead of just swapping.
+class Counter : public GameState
+{
+public:
+
+    Counter( bool a_bDraw = false ) : m_bDraw( a_bDraw ) {}
+    virtual ~Counter() {}
+
+    const std::vector< double >& Times() const { return m_oTimes; }
+
+    virtual void Draw() const override
+    {
+        if( m_bDraw )
+        {
+            GameWindow::ClearCurrent();
+            QuadShaderProgram::DrawQuad( Color::WHITE );
+        }
+        GameWindow::SwapAllBuffers();
+    }
+
+protected:
+
+    virtual void OnUpdate( double a_dDeltaTime ) override
+    {
+        m_oTimes.push_back( GameEngine::LastTime() );
+    }
+
+private:
+
+    bool m_bDraw;
+    std::vector< double > m_oTimes;
+
+};  // class Counter
+
+// Run a state until the null backend has recorded the given number of frames,
+// with the stats reset first so nothing from loading is counted
+void RunFrames( Counter& a_roState, unsigned int a_uiFrames )
+{
+    NullBackend::ResetStats();
+    NullBackend::SetFrameLimit( a_uiFrames );
+    a_roState.Push();
+    GameEngine::Run();
+    NullBackend::SetFrameLimit( 0 );
+}
+
+// Are no objects left?
+bool NoneResident()
+{
+    const NullBackend::Resources& oResident = NullBackend::Resident();
+    return 0 == oResident.uiWindows && 0 == oResident.uiTextures &&
+           0 == oResident.ulTextureBytes && 0 == oResident.uiBuffers &&
+           0 == oResident.ulBufferBytes && 0 == oResident.uiVertexArrays &&
+           0 == oResident.uiShaders && 0 == oResident.uiPrograms;
+}
+
+}   // namespace
+
+NullBackendTestGroup::NullBackendTestGroup()
+    : UnitTestGroup("Null backend tests")
+{
+    AddTest( "Starting and stopping headless", StartAndStop );
+    AddTest( "Frames and the clock", FramesAndClock );
+    AddTest( "Draw calls counted", DrawCalls );
+    AddTest( "Objects and sizes", Objects );
+}
+
+// The engine should initialize without a display, creating its window and
+// shader programs, and terminating it should delete everything it created.
+UnitTest::Result NullBackendTestGroup::StartAndStop()
+{
+    if( !NullBackend::IsInstalled() )
+    {
+        return UnitTest::Fail( "Null backend not installed" );
+    }
+    if( !GameEngine::Initialize() )
+    {
+        return UnitTest::Fail( "Engine didn't initialize" );
+    }
+    NullBackend::Resources oStarted = NullBackend::Resident();
+    GameEngine::Terminate();
+    if( 1 != oStarted.uiWindows || sgc_uiPrograms != oStarted.uiPrograms ||
+        0 == oStarted.uiShaders || 0 == oStarted.uiVertexArrays )
+    {
+        std::ostringstream oMessage;
+        oMessage << "Started with " << oStarted.uiWindows << " windows, "
+                 << oStarted.uiPrograms << " programs, "
+                 << oStarted.uiShaders << " shaders, and "
+                 << oStarted.uiVertexArrays << " vertex arrays";
+        return UnitTest::Fail( oMessage.str() );
+    }
+    if( !NoneResident() )
+    {
+        return UnitTest::Fail( "Objects left over after terminating" );
+    }
+    return UnitTest::PASS;
+}
+
+// Each swap should end one frame and move the clock on by exactly one frame
+// time, and the frame limit should end the run once it's reached.
+UnitTest::Result NullBackendTestGroup::FramesAndClock()
+{
+    const unsigned int cuiFrames = 10;
+    if( !GameEngine::Initialize() )
+    {
+        return UnitTest::Fail( "Engine didn't initialize" );
+    }
+    Counter oCounter;
+    RunFrames( oCounter, cuiFrames );
+    GameEngine::Terminate();
+    if( cuiFrames != oCounter.Times().size() ||
+        cuiFrames != NullBackend::FrameCount() )
+    {
+        std::ostringstream oMessage;
+        oMessage << oCounter.Times().size() << " updates and "
+                 << NullBackend::FrameCount() << " frames instead of "
+                 << cuiFrames;
+        return UnitTest::Fail( oMessage.str() );
+    }
+    for( unsigned int ui = 0; ui < cuiFrames; ++ui )
+    {
+        if( 0 < ui &&
+            1e-9 < std::abs( oCounter.Times()[ ui ] -
+                             oCounter.Times()[ ui - 1 ] -
+                             NullBackend::FrameTime() ) )
+        {
+            std::ostringstream oMessage;
+            oMessage << "Clock moved by "
+                     << oCounter.Times()[ ui ] - oCounter.Times()[ ui - 1 ]
+                     << " seconds before update " << ui;
+            return UnitTest::Fail( oMessage.str() );
+        }
+        if( 0.0 > NullBackend::RecordedFrame( ui ).dCPUTime )
+        {
+            return UnitTest::Fail( "Negative CPU time" );
+        }
+    }
+    return UnitTest::PASS;
+}
+
+// A frame that clears the screen and draws one quad should record exactly
+// that, the totals should add up the frames, and resetting should zero both.
+UnitTest::Result NullBackendTestGroup::DrawCalls()
+{
+    const unsigned int cuiFrames = 5;
+    if( !GameEngine::Initialize() )
+    {
+        return UnitTest::Fail( "Engine didn't initialize" );
+    }
+    Counter oCounter( true );
+    RunFrames( oCounter, cuiFrames );
+    GameEngine::Terminate();
+    if( cuiFrames != NullBackend::FrameCount() )
+    {
+        return UnitTest::Fail( "Wrong number of frames" );
+    }
+    NullBackend::Stats oSum = {};
+    for( unsigned int ui = 0; ui < cuiFrames; ++ui )
+    {
+        const NullBackend::Stats& oFrame =
+            NullBackend::RecordedFrame( ui ).oCalls;
+        if( 1 != oFrame.uiDrawCalls || 4 != oFrame.ulIndices ||
+            1 != oFrame.ulInstances || 1 != oFrame.uiClears )
+        {
+            std::ostringstream oMessage;
+            oMessage << "Frame " << ui << " had " << oFrame.uiDrawCalls
+                     << " draw calls, " << oFrame.ulIndices << " indices, "
+                     << oFrame.ulInstances << " instances, and "
+                     << oFrame.uiClears << " clears";
+            return UnitTest::Fail( oMessage.str() );
+        }
+        oSum.uiDrawCalls += oFrame.uiDrawCalls;
+        oSum.ulIndices += oFrame.ulIndices;
+        oSum.uiClears += oFrame.uiClears;
+        oSum.uiUniformSets += oFrame.uiUniformSets;
+        oSum.uiBinds += oFrame.uiBinds;
+    }
+    const NullBackend::Stats& oTotals = NullBackend::Totals();
+    if( oSum.uiDrawCalls != oTotals.uiDrawCalls ||
+        oSum.ulIndices != oTotals.ulIndices ||
+        oSum.uiClears != oTotals.uiClears ||
+        oSum.uiUniformSets != oTotals.uiUniformSets ||
+        oSum.uiBinds != oTotals.uiBinds )
+    {
+        return UnitTest::Fail( "Totals don't add up the frames" );
+    }
+    NullBackend::ResetStats();
+    if( 0 != NullBackend::FrameCount() ||
+        0 != NullBackend::Totals().uiDrawCalls ||
+        0 != NullBackend::CurrentFrame().uiDrawCalls )
+    {
+        return UnitTest::Fail( "Stats not reset" );
+    }
+    return UnitTest::PASS;
+}
+
+// Textures and buffers should be counted while they exist, along with the
+// memory they'd use, and stop being counted once they're destroyed.  The
+// texture is a TestTexture, uploaded from the cache it's built with, so the
+// test doesn't depend on any image file.
+UnitTest::Result NullBackendTestGroup::Objects()
+{
+    const unsigned int cuiRegionSize = 256;
+    if( !GameEngine::Initialize() )
+    {
+        return UnitTest::Fail( "Engine didn't initialize" );
+    }
+    NullBackend::Resources oBefore = NullBackend::Resident();
+    bool bTextureCounted = false;
+    bool bTextureDeleted = false;
+    bool bBufferCounted = false;
+    bool bBufferDeleted = false;
+    {
+        TestTexture oTexture( 4, 4 );
+        oTexture.Load( false );
+        NullBackend::Resources oResident = NullBackend::Resident();
+        bTextureCounted = oTexture.IsValid() &&
+            oBefore.uiTextures + 1 == oResident.uiTextures &&
+            oBefore.ulTextureBytes + 4 * 4 * 4 <= oResident.ulTextureBytes;
+        oTexture.Destroy( false );
+        oResident = NullBackend::Resident();
+        bTextureDeleted =
+            oBefore.uiTextures == oResident.uiTextures &&
+            oBefore.ulTextureBytes == oResident.ulTextureBytes;
+
+        StreamBuffer oBuffer( cuiRegionSize );
+        oBuffer.BeginFrame();
+        oResident = NullBackend::Resident();
+        bBufferCounted =
+            oBefore.uiBuffers < oResident.uiBuffers &&
+            oBefore.ulBufferBytes + cuiRegionSize <= oResident.ulBufferBytes;
+        oBuffer.EndFrame();
+        oBuffer.Destroy();
+        oResident = NullBackend::Resident();
+        bBufferDeleted =
+            oBefore.uiBuffers == oResident.uiBuffers &&
+            oBefore.ulBufferBytes == oResident.ulBufferBytes;
+    }
+    GameEngine::Terminate();
+    if( !bTextureCounted || !bBufferCounted )
+    {
+        return UnitTest::Fail( "Objects not counted while they existed" );
+    }
+    if( !bTextureDeleted || !bBufferDeleted )
+    {
+        return UnitTest::Fail( "Objects still counted after being deleted" );
+    }
+    return UnitTest::PASS;
+}
@@ -0,0 +1,30 @@
+/******************************************************************************
+ * File:               NullBackendTestGroup.h
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Null backend tests.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Creation.
+ ******************************************************************************/
+
+#ifndef NULL_BACKEND_TEST_GROUP__H
+#define NULL_BACKEND_TEST_GROUP__H
+
+#include "UnitTestGroup.h"
+
+class NullBackendTestGroup : public UnitTestGroup
+{
+public:
+
+    NullBackendTestGroup();
+
+private:
+
+    static UnitTest::Result StartAndStop();
+    static UnitTest::Result FramesAndClock();
+    static UnitTest::Result DrawCalls();
+    static UnitTest::Result Objects();
+
+};
+
+#endif  // NULL_BACKEND_TEST_GROUP__H
@@ -0,0 +1,289 @@
+/******************************************************************************
+ * File:               PrecisionTestGroup.cpp
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Tests comparing the single-precision transform pipeline
+ *                      to the double-precision one.  Both are built here, so
+ *                      the float results are checked whichever precision the
+ *                      engine was built with.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Creation.
+ ******************************************************************************/
+
+#include "PrecisionTestGroup.h"
+#include "MyFirstEngine.h"
+#include <cmath>
+#include <sstream>
+#include <vector>
+
+using namespace MyFirstEngine;
+
+namespace
+{
+
+// The screen scenes are drawn to, in pixels, and how far from the origin
+// the camera can scroll
+const double sgc_dScreenWidth = 1920.0;
+const double sgc_dScreenHeight = 1080.0;
+const double sgc_dWorldSize = 10000.0;
+
+// Texture atlas sprites are cut from, in texels
+const double sgc_dAtlasSize = 4096.0;
+
+// How far a float result may be from the double one - a sixteenth of a pixel
+// on screen, or a sixteenth of a texel in the atlas
+const double sgc_dPixelTolerance = 1.0 / 16.0;
+const double sgc_dTexelTolerance = 1.0 / 16.0;
+
+// Step a linear congruential generator and return its high bits
+unsigned int Random( unsigned int& a_ruiSeed )
+{
+    a_ruiSeed = a_ruiSeed * 1664525u + 1013904223u;
+    return a_ruiSeed >> 8;
+}
+
+// A random number in the given range
+double Random( unsigned int& a_ruiSeed, double a_dMin, double a_dMax )
+{
+    return a_dMin + ( a_dMax - a_dMin ) * ( Random( a_ruiSeed ) % 1000000 ) /
+                    1000000.0;
+}
+
+// A sprite in a scrolling world, as the engine would draw it: the camera is
+// applied to the projection stack, then the sprite's parent and the sprite
+// itself are applied to the model-view stack.  Objects build these in double
+// precision either way.
+struct Scene
+{
+    Transform3D oCamera;
+    Transform3D oScreen;
+    Transform3D oParent;
+    Transform3D oModel;
+};
+
+// A sprite somewhere on screen, with a camera that's scrolled somewhere in the
+// world
+Scene RandomScene( unsigned int& a_ruiSeed )
+{
+    double dCameraX = Random( a_ruiSeed, -sgc_dWorldSize, sgc_dWorldSize );
+    double dCameraY = Random( a_ruiSeed, -sgc_dWorldSize, sgc_dWorldSize );
+    Scene oScene;
+    oScene.oCamera = Space::Translation( -dCameraX, -dCameraY, 0.0 );
+    oScene.oScreen = Space::Scaling( 2.0 / sgc_dScreenWidth,
+                                     2.0 / sgc_dScreenHeight, 1.0 );
+    oScene.oParent =
+        Space::Rotation( Random( a_ruiSeed, -Math::PI, Math::PI ) ) *
+        Space::Translation( dCameraX + Random( a_ruiSeed, -sgc_dScreenWidth,
+                                               sgc_dScreenWidth ) / 2,
+                            dCameraY + Random( a_ruiSeed, -sgc_dScreenHeight,
+                                               sgc_dScreenHeight ) / 2,
+                            0.0 );
+    oScene.oModel =
+        Space::Scaling( Random( a_ruiSeed, 8.0, 256.0 ),
+                        Random( a_ruiSeed, 8.0, 256.0 ), 1.0 ) *
+        Space::Rotation( Random( a_ruiSeed, -Math::PI, Math::PI ) ) *
+        Space::Translation( Random( a_ruiSeed, -200.0, 200.0 ),
+                            Random( a_ruiSeed, -200.0, 200.0 ), 0.0 );
+    return oScene;
+}
+
+// Build the model-view-projection matrix the way the engine's stacks do,
+// converting each transformation to the given precision as it's applied
+template< typename T >
+Math::Matrix< T, 4 > ModelViewProjection( const Scene& ac_roScene )
+{
+    Math::Matrix< T, 4 > oProjection = Math::Matrix< T, 4 >::Identity();
+    oProjection *= Math::Matrix< T, 4 >( ac_roScene.oCamera );
+    oProjection *= Math::Matrix< T, 4 >( ac_roScene.oScreen );
+    Math::Matrix< T, 4 > oModelView = Math::Matrix< T, 4 >::Identity();
+    oModelView = Math::Matrix< T, 4 >( ac_roScene.oParent ) * oModelView;
+    oModelView = Math::Matrix< T, 4 >( ac_roScene.oModel ) * oModelView;
+    return oModelView * oProjection;
+}
+
+// Where a corner of the unit quad ends up in normalized device coordinates,
+// working in the given precision like the vertex shader would
+template< typename T >
+void Corner( const Math::Matrix< T, 4 >& ac_roMatrix, unsigned int a_uiCorner,
+             double& a_rdX, double& a_rdY )
+{
+    T tX = (T)( 0 == a_uiCorner % 2 ? -0.5 : 0.5 );
+    T tY = (T)( 2 > a_uiCorner ? -0.5 : 0.5 );
+    T tW = tX * ac_roMatrix[0][3] + tY * ac_roMatrix[1][3] + ac_roMatrix[3][3];
+    a_rdX = (double)( ( tX * ac_roMatrix[0][0] + tY * ac_roMatrix[1][0] +
+                        ac_roMatrix[3][0] ) / tW );
+    a_rdY = (double)( ( tX * ac_roMatrix[0][1] + tY * ac_roMatrix[1][1] +
+                        ac_roMatrix[3][1] ) / tW );
+}
+
+// A frame cut from somewhere in the atlas, possibly rotated a quarter turn to
+// pack better, the way frames set up a sprite's texture matrix
+Transform2D RandomFrame( unsigned int& a_ruiSeed )
+{
+    double dWidth = Random( a_ruiSeed, 1.0, 512.0 ) / sgc_dAtlasSize;
+    double dHeight = Random( a_ruiSeed, 1.0, 512.0 ) / sgc_dAtlasSize;
+    double dLeft = Random( a_ruiSeed, 0.0, 1.0 - dWidth );
+    double dBottom = Random( a_ruiSeed, 0.0, 1.0 - dHeight );
+    Transform2D oFrame = Plane::Scaling( dWidth, dHeight );
+    if( 0 == Random( a_ruiSeed ) % 2 )
+    {
+        oFrame *= Plane::Rotation( Math::PI / 2,
+                                   Plane::Point( dWidth / 2, dHeight / 2 ) );
+    }
+    return oFrame * Plane::Translation( dLeft, dBottom );
+}
+
+// Where a corner of the sprite ends up in the atlas, working in the given
+// precision
+template< typename T >
+void TexCoordinate( const Math::Matrix< T, 3 >& ac_roMatrix,
+                    unsigned int a_uiCorner, double& a_rdS, double& a_rdT )
+{
+    T tS = (T)( 0 == a_uiCorner % 2 ? 0.0 : 1.0 );
+    T tT = (T)( 2 > a_uiCorner ? 0.0 : 1.0 );
+    a_rdS = (double)( tS * ac_roMatrix[0][0] + tT * ac_roMatrix[1][0] +
+                      ac_roMatrix[2][0] );
+    a_rdT = (double)( tS * ac_roMatrix[0][1] + tT * ac_roMatrix[1][1] +
+                      ac_roMatrix[2][1] );
+}
+
+}   // namespace
+
+PrecisionTestGroup::PrecisionTestGroup()
+    : UnitTestGroup("Transform precision tests")
+{
+    AddTest( "Float positions within tolerance", Positions );
+    AddTest( "Float texture coordinates within tolerance",
+             TextureCoordinates );
+    AddTest( "Engine stacks use the build's precision", EngineStacks );
+    AddTest( "Benchmark", Benchmark );
+}
+
+// Sprites anywhere in a large scrolling world should land within a fraction of
+// a pixel of where the double pipeline puts them
+UnitTest::Result PrecisionTestGroup::Positions()
+{
+    const unsigned int cuiScenes = 10000;
+    double dWorst = 0.0;
+    unsigned int uiSeed = 1;
+    for( unsigned int ui = 0; ui < cuiScenes; ++ui )
+    {
+        Scene oScene = RandomScene( uiSeed );
+        Math::Matrix< double, 4 > oDouble =
+            ModelViewProjection< double >( oScene );
+        Math::Matrix< float, 4 > oFloat =
+            ModelViewProjection< float >( oScene );
+        for( unsigned int uiCorner = 0; uiCorner < 4; ++uiCorner )
+        {
+            double dX, dY, dFloatX, dFloatY;
+            Corner( oDouble, uiCorner, dX, dY );
+            Corner( oFloat, uiCorner, dFloatX, dFloatY );
+            double dError =
+                std::abs( dFloatX - dX ) * sgc_dScreenWidth / 2 +
+                std::abs( dFloatY - dY ) * sgc_dScreenHeight / 2;
+            dWorst = ( dError > dWorst ? dError : dWorst );
+        }
+    }
+    std::ostringstream oMessage;
+    oMessage << "Float positions were up to " << dWorst << " pixels off";
+    if( sgc_dPixelTolerance < dWorst )
+    {
+        return UnitTest::Fail( oMessage.str() );
+    }
+    return UnitTest::Pass( oMessage.str() );
+}
+
+// Frames anywhere in a large atlas should sample within a fraction of a texel
+// of where the double pipeline samples
+UnitTest::Result PrecisionTestGroup::TextureCoordinates()
+{
+    const unsigned int cuiFrames = 10000;
+    double dWorst = 0.0;
+    unsigned int uiSeed = 2;
+    for( unsigned int ui = 0; ui < cuiFrames; ++ui )
+    {
+        Transform2D oDouble = RandomFrame( uiSeed );
+        Math::Matrix< float, 3 > oFloat( oDouble );
+        for( unsigned int uiCorner = 0; uiCorner < 4; ++uiCorner )
+        {
+            double dS, dT, dFloatS, dFloatT;
+            TexCoordinate( oDouble, uiCorner, dS, dT );
+            TexCoordinate( oFloat, uiCorner, dFloatS, dFloatT );
+            double dError = ( std::abs( dFloatS - dS ) +
+                              std::abs( dFloatT - dT ) ) * sgc_dAtlasSize;
+            dWorst = ( dError > dWorst ? dError : dWorst );
+        }
+    }
+    std::ostringstream oMessage;
+    oMessage << "Float texture coordinates were up to " << dWorst
+             << " texels off";
+    if( sgc_dTexelTolerance < dWorst )
+    {
+        return UnitTest::Fail( oMessage.str() );
+    }
+    return UnitTest::Pass( oMessage.str() );
+}
+
+// The engine's stacks should hold GLScalar and multiply in that precision, so
+// they give exactly what the pipeline above gives for the build's precision
+UnitTest::Result PrecisionTestGroup::EngineStacks()
+{
+    const unsigned int cuiScenes = 100;
+    unsigned int uiSeed = 3;
+    for( unsigned int ui = 0; ui < cuiScenes; ++ui )
+    {
+        Scene oScene = RandomScene( uiSeed );
+        GameEngine::PushProjection( GLTransform3D::Identity() );
+        GameEngine::ApplyAfterProjection( GLTransform3D( oScene.oCamera ) );
+        GameEngine::ApplyAfterProjection( GLTransform3D( oScene.oScreen ) );
+        GameEngine::PushModelView( GLTransform3D::Identity() );
+        GameEngine::ApplyBeforeModelView( GLTransform3D( oScene.oParent ) );
+        GameEngine::ApplyBeforeModelView( GLTransform3D( oScene.oModel ) );
+        GLTransform3D oEngine = GameEngine::ModelViewProjection();
+        GameEngine::PopModelView();
+        GameEngine::PopProjection();
+        if( ModelViewProjection< GLScalar >( oScene ) != oEngine )
+        {
+            return UnitTest::Fail( "Engine stacks gave a different matrix" );
+        }
+    }
+    return UnitTest::PASS;
+}
+
+// CPU time per drawn object to build its model-view-projection matrix in
+// each precision.  Only reports the times - which is faster depends on the
+// compiler and CPU.
+UnitTest::Result PrecisionTestGroup::Benchmark()
+{
+    const unsigned int cuiObjects = 100000;
+    std::vector< Scene > oScenes;
+    unsigned int uiSeed = 4;
+    for( unsigned int ui = 0; ui < cuiObjects; ++ui )
+    {
+        oScenes.push_back( RandomScene( uiSeed ) );
+    }
+
+    // Sum a corner of every result, so the work can't be skipped
+    double dStart = NullBackend::CPUTime();
+    double dSum = 0.0;
+    for( unsigned int ui = 0; ui < cuiObjects; ++ui )
+    {
+        dSum += ModelViewProjection< double >( oScenes[ ui ] )[3][0];
+    }
+    double dMiddle = NullBackend::CPUTime();
+    for( unsigned int ui = 0; ui < cuiObjects; ++ui )
+    {
+        dSum -= ModelViewProjection< float >( oScenes[ ui ] )[3][0];
+    }
+    double dEnd = NullBackend::CPUTime();
+    if( 1.0 < std::abs( dSum ) )
+    {
+        return UnitTest::Fail( "Float and double results differed" );
+    }
+
+    std::ostringstream oMessage;
+    oMessage << "Double " << ( dMiddle - dStart ) * 1e9 / cuiObjects
+             << " ns/object, float " << ( dEnd - dMiddle ) * 1e9 / cuiObjects
+             << " ns/object";
+    return UnitTest::Pass( oMessage.str() );
+}
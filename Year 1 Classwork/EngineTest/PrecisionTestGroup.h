@@ -0,0 +1,31 @@
+/******************************************************************************
+ * File:               PrecisionTestGroup.h
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Tests comparing the single-precision transform pipeline
+ *                      to the double-precision one.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Creation.
+ ******************************************************************************/
+
+#ifndef PRECISION_TEST_GROUP__H
+#define PRECISION_TEST_GROUP__H
+
+#include "UnitTestGroup.h"
+
+class PrecisionTestGroup : public UnitTestGroup
+{
+public:
+
+    PrecisionTestGroup();
+
+private:
+
+    static UnitTest::Result Positions();
+    static UnitTest::Result TextureCoordinates();
+    static UnitTest::Result EngineStacks();
+    static UnitTest::Result Benchmark();
+
+};
+
+#endif  // PRECISION_TEST_GROUP__H
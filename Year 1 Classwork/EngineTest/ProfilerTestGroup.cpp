@@ -0,0 +1,337 @@
+/******************************************************************************
+ * File:               ProfilerTestGroup.cpp
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Profiler tests, covering the event ring, aggregation,
+ *                      per-frame counters, and agreement with the null
+ *                      backend's counts.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Creation.
+ ******************************************************************************/
+
+#include "ProfilerTestGroup.h"
+#include "TestTexture.h"
+#include "MyFirstEngine.h"
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+using namespace MyFirstEngine;
+
+namespace
+{
+
+// A CPU zone with the given name and times
+Profiler::Event MakeEvent( const char* ac_pcName, double a_dStart,
+                           double a_dEnd, double a_dChildTime = 0.0,
+                           unsigned int a_uiDepth = 0 )
+{
+    Profiler::Event oEvent;
+    oEvent.pcName = ac_pcName;
+    oEvent.dStart = a_dStart;
+    oEvent.dEnd = a_dEnd;
+    oEvent.dChildTime = a_dChildTime;
+    oEvent.uiDepth = a_uiDepth;
+    oEvent.uiThread = 0;
+    oEvent.bGPU = false;
+    return oEvent;
+}
+
+// Are two times the same, give or take rounding?
+bool Close( double a_dLeft, double a_dRight )
+{
+    return std::abs( a_dLeft - a_dRight ) < 1.0e-9;
+}
+
+// A headless game state that clears the screen and draws the same number of
+// quads and sprites every frame
+class Scene : public GameState
+{
+public:
+
+    Scene( Texture& a_roTexture, unsigned int a_uiQuads,
+           unsigned int a_uiSprites )
+        : m_roTexture( a_roTexture ), m_uiQuads( a_uiQuads ),
+          m_uiSprites( a_uiSprites ) {}
+    virtual ~Scene() {}
+
+    virtual void Draw() const override
+    {
+        GameWindow::ClearCurrent();
+        for( unsigned int ui = 0; ui < m_uiQuads; ++ui )
+        {
+            QuadShaderProgram::DrawQuad( Color::WHITE );
+        }
+        for( unsigned int ui = 0; ui < m_uiSprites; ++ui )
+        {
+            SpriteShaderProgram::DrawSprite( m_roTexture, Point2D( 0.0 ) );
+        }
+        GameWindow::SwapAllBuffers();
+    }
+
+private:
+
+    Texture& m_roTexture;
+    unsigned int m_uiQuads;
+    unsigned int m_uiSprites;
+
+};  // class Scene
+
+}   // namespace
+
+ProfilerTestGroup::ProfilerTestGroup()
+    : UnitTestGroup("Profiler tests")
+{
+    AddTest( "Event ring wraps around", RingWraparound );
+    AddTest( "Zones aggregated by name", Aggregate );
+    AddTest( "Counters kept at the end of a frame", EndFrame );
+    AddTest( "Counts agree with the null backend", EngineFrames );
+}
+
+// A ring should round its capacity up to a power of two, and once full, keep
+// only the newest events, oldest first, counting the ones it dropped.
+UnitTest::Result ProfilerTestGroup::RingWraparound()
+{
+    const unsigned int cuiPushes = 21;
+    Profiler::EventRing oRing( 5 );
+    if( 8 != oRing.Capacity() )
+    {
+        return UnitTest::Fail( "Capacity not rounded up to a power of two" );
+    }
+    for( unsigned int ui = 0; ui < cuiPushes; ++ui )
+    {
+        oRing.Push( MakeEvent( "zone", ui, ui + 0.5 ) );
+        unsigned int uiExpected = ( ui < 8 ? ui + 1 : 8 );
+        if( uiExpected != oRing.Size() ||
+            ui + 1 - uiExpected != oRing.Dropped() )
+        {
+            std::ostringstream oMessage;
+            oMessage << "After " << ui + 1 << " pushes, held " << oRing.Size()
+                     << " and dropped " << oRing.Dropped();
+            return UnitTest::Fail( oMessage.str() );
+        }
+        for( unsigned int uj = 0; uj < oRing.Size(); ++uj )
+        {
+            if( (double)( ui + 1 - oRing.Size() + uj ) != oRing[ uj ].dStart )
+            {
+                std::ostringstream oMessage;
+                oMessage << "After " << ui + 1 << " pushes, event " << uj
+                         << " was out of order";
+                return UnitTest::Fail( oMessage.str() );
+            }
+        }
+    }
+    bool bThrew = false;
+    try
+    {
+        oRing[ oRing.Size() ];
+    }
+    catch( std::out_of_range& )
+    {
+        bThrew = true;
+    }
+    if( !bThrew )
+    {
+        return UnitTest::Fail( "Reading past the newest event didn't throw" );
+    }
+    oRing.Clear();
+    if( 0 != oRing.Size() || 0 != oRing.Dropped() )
+    {
+        return UnitTest::Fail( "Clearing didn't empty the ring" );
+    }
+    return UnitTest::PASS;
+}
+
+// Events with the same name should be summed into one entry, whether or not
+// the names share an address, with nested time left out of the self time.
+// Names beyond the maximum should be left out.
+UnitTest::Result ProfilerTestGroup::Aggregate()
+{
+    static const char sc_acInner[] = "inner";
+    char acInnerCopy[ sizeof( sc_acInner ) ];
+    for( unsigned int ui = 0; ui < sizeof( sc_acInner ); ++ui )
+    {
+        acInnerCopy[ ui ] = sc_acInner[ ui ];
+    }
+    Profiler::EventRing oRing( 16 );
+    oRing.Push( MakeEvent( sc_acInner, 1.0, 2.0, 0.0, 1 ) );
+    oRing.Push( MakeEvent( acInnerCopy, 3.0, 6.0, 0.0, 1 ) );
+    oRing.Push( MakeEvent( "outer", 0.0, 10.0, 4.0 ) );
+    oRing.Push( MakeEvent( "other", 11.0, 11.5 ) );
+
+    Profiler::ZoneStats aoStats[4];
+    unsigned int uiStats = Profiler::Aggregate( oRing, aoStats, 4 );
+    if( 3 != uiStats )
+    {
+        std::ostringstream oMessage;
+        oMessage << "Expected 3 names, got " << uiStats;
+        return UnitTest::Fail( oMessage.str() );
+    }
+    const Profiler::ZoneStats& roInner = aoStats[0];
+    const Profiler::ZoneStats& roOuter = aoStats[1];
+    if( 2 != roInner.uiCalls || !Close( 4.0, roInner.dTotalTime ) ||
+        !Close( 4.0, roInner.dSelfTime ) || !Close( 1.0, roInner.dMinTime ) ||
+        !Close( 3.0, roInner.dMaxTime ) )
+    {
+        return UnitTest::Fail( "Same-named zones weren't summed" );
+    }
+    if( 1 != roOuter.uiCalls || !Close( 10.0, roOuter.dTotalTime ) ||
+        !Close( 6.0, roOuter.dSelfTime ) )
+    {
+        return UnitTest::Fail( "Nested time wasn't left out of self time" );
+    }
+
+    if( 2 != Profiler::Aggregate( oRing, aoStats, 2 ) ||
+        2 != aoStats[0].uiCalls || 1 != aoStats[1].uiCalls )
+    {
+        return UnitTest::Fail( "Names past the maximum weren't left out" );
+    }
+    if( 0 != Profiler::Aggregate( oRing, nullptr, 4 ) )
+    {
+        return UnitTest::Fail( "Aggregating into nothing wrote entries" );
+    }
+    return UnitTest::PASS;
+}
+
+// Counting should add to the current frame, ending a frame should move the
+// counts to the last frame and start again from zero, and nothing should be
+// counted while the profiler is disabled.
+UnitTest::Result ProfilerTestGroup::EndFrame()
+{
+    Profiler::Clear();
+    Profiler::Count( Profiler::TEXTURE_BINDS, 2 );
+    Profiler::Count( Profiler::BUFFER_STALLS );
+    Profiler::Count( Profiler::TEXTURE_BINDS, 3 );
+    Profiler::SetEnabled( false );
+    Profiler::Count( Profiler::TEXTURE_BINDS, 100 );
+    Profiler::SetEnabled( true );
+    if( 5 != Profiler::CounterValue( Profiler::TEXTURE_BINDS ) ||
+        1 != Profiler::CounterValue( Profiler::BUFFER_STALLS ) ||
+        0 != Profiler::CounterValue( Profiler::DRAW_CALLS ) )
+    {
+        return UnitTest::Fail( "Counts weren't added up" );
+    }
+
+    Profiler::EndFrame();
+    Profiler::FrameStats oFirst = Profiler::LastFrame();
+    if( 5 != oFirst.auiCounters[ Profiler::TEXTURE_BINDS ] ||
+        1 != oFirst.auiCounters[ Profiler::BUFFER_STALLS ] )
+    {
+        return UnitTest::Fail( "Ending a frame didn't keep its counts" );
+    }
+    for( unsigned int ui = 0; ui < Profiler::COUNTER_COUNT; ++ui )
+    {
+        if( 0 != Profiler::CounterValue( (Profiler::Counter)ui ) )
+        {
+            return UnitTest::Fail( "Ending a frame didn't reset the counts" );
+        }
+    }
+
+    Profiler::EndFrame();
+    const Profiler::FrameStats& roSecond = Profiler::LastFrame();
+    if( 0 != roSecond.auiCounters[ Profiler::TEXTURE_BINDS ] ||
+        oFirst.dEnd != roSecond.dStart || roSecond.dEnd < roSecond.dStart )
+    {
+        return UnitTest::Fail( "The next frame didn't follow on" );
+    }
+    Profiler::Clear();
+    return UnitTest::PASS;
+}
+
+// Draw quads and sprites for a few frames.  Every frame the null backend
+// records should have one draw call per quad or sprite and each program's
+// named number of uniform sets.  If the engine was built with profiling, the
+// profiler's counts for the last frame should match the null backend's, and
+// every frame's update should have been timed.
+UnitTest::Result ProfilerTestGroup::EngineFrames()
+{
+    const unsigned int cuiFrames = 4;
+    const unsigned int cuiQuads = 3;
+    const unsigned int cuiSprites = 5;
+    const unsigned int cuiUniforms =
+        cuiQuads * QuadShaderProgram::UNIFORM_COUNT +
+        cuiSprites * SpriteShaderProgram::UNIFORM_COUNT;
+    if( !GameEngine::Initialize() )
+    {
+        return UnitTest::Fail( "Engine didn't initialize" );
+    }
+    unsigned int uiFrames = 0;
+    std::string oMismatch;
+    NullBackend::Stats oLastFrame = {};
+    Profiler::FrameStats oProfiled = {};
+    Profiler::ZoneStats aoZones[16];
+    unsigned int uiZones = 0;
+    {
+        TestTexture oTexture( 4, 4 );
+        Scene oScene( oTexture, cuiQuads, cuiSprites );
+        Profiler::Clear();
+        NullBackend::ResetStats();
+        NullBackend::SetFrameLimit( cuiFrames );
+        oScene.Push();
+        GameEngine::Run();
+        NullBackend::SetFrameLimit( 0 );
+        uiFrames = NullBackend::FrameCount();
+        for( unsigned int ui = 0; ui < uiFrames && oMismatch.empty(); ++ui )
+        {
+            const NullBackend::Stats& roFrame =
+                NullBackend::RecordedFrame( ui ).oCalls;
+            if( cuiQuads + cuiSprites != roFrame.uiDrawCalls ||
+                cuiUniforms != roFrame.uiUniformSets )
+            {
+                std::ostringstream oMessage;
+                oMessage << "Frame " << ui << " had " << roFrame.uiDrawCalls
+                         << " draw calls and " << roFrame.uiUniformSets
+                         << " uniform sets instead of "
+                         << cuiQuads + cuiSprites << " and " << cuiUniforms;
+                oMismatch = oMessage.str();
+            }
+        }
+        if( 0 < uiFrames )
+        {
+            oLastFrame = NullBackend::RecordedFrame( uiFrames - 1 ).oCalls;
+        }
+        oProfiled = Profiler::LastFrame();
+        uiZones = Profiler::Aggregate( Profiler::ThreadEvents(), aoZones, 16 );
+    }
+    GameEngine::Terminate();
+    Profiler::Clear();
+    if( cuiFrames != uiFrames )
+    {
+        return UnitTest::Fail( "Wrong number of frames" );
+    }
+    if( !oMismatch.empty() )
+    {
+        return UnitTest::Fail( oMismatch );
+    }
+
+    // A build without profiling records no zones at all
+    if( 0 == uiZones )
+    {
+        return UnitTest::Pass( "Profiling isn't built into the engine, so "
+                               "only the null backend's counts were checked" );
+    }
+    if( oLastFrame.uiDrawCalls !=
+            oProfiled.auiCounters[ Profiler::DRAW_CALLS ] ||
+        oLastFrame.uiUniformSets !=
+            oProfiled.auiCounters[ Profiler::UNIFORM_UPLOADS ] )
+    {
+        std::ostringstream oMessage;
+        oMessage << "Profiler counted "
+                 << oProfiled.auiCounters[ Profiler::DRAW_CALLS ]
+                 << " draw calls and "
+                 << oProfiled.auiCounters[ Profiler::UNIFORM_UPLOADS ]
+                 << " uniform uploads, null backend " << oLastFrame.uiDrawCalls
+                 << " and " << oLastFrame.uiUniformSets;
+        return UnitTest::Fail( oMessage.str() );
+    }
+    for( unsigned int ui = 0; ui < uiZones; ++ui )
+    {
+        if( std::string( "GameState::OnUpdate" ) == aoZones[ ui ].pcName )
+        {
+            return ( cuiFrames == aoZones[ ui ].uiCalls ? UnitTest::PASS :
+                     UnitTest::Fail( "Not every update was timed" ) );
+        }
+    }
+    return UnitTest::Fail( "Updates weren't timed" );
+}
@@ -0,0 +1,32 @@
+/******************************************************************************
+ * File:               ProfilerTestGroup.h
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Profiler tests, covering the event ring, aggregation,
+ *                      per-frame counters, and agreement with the null
+ *                      backend's counts.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Creation.
+ ******************************************************************************/
+
+#ifndef PROFILER_TEST_GROUP__H
+#define PROFILER_TEST_GROUP__H
+
+#include "UnitTestGroup.h"
+
+class ProfilerTestGroup : public UnitTestGroup
+{
+public:
+
+    ProfilerTestGroup();
+
+private:
+
+    static UnitTest::Result RingWraparound();
+    static UnitTest::Result Aggregate();
+    static UnitTest::Result EndFrame();
+    static UnitTest::Result EngineFrames();
+
+};
+
+#endif  // PROFILER_TEST_GROUP__H
@@ -0,0 +1,434 @@
+/******************************************************************************
+ * File:               ProgramBinaryCacheTestGroup.cpp
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Program binary cache tests, setting up shader programs
+ *                      on the null backend with a recording cache backend.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Creation.
+ ******************************************************************************/
+
+#include "ProgramBinaryCacheTestGroup.h"
+#include "MyFirstEngine.h"
+#include <cstddef>  // for size_t
+#include <cstring>  // for memcmp and memcpy
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace MyFirstEngine;
+
+namespace
+{
+
+typedef ProgramBinaryCache::Key Key;
+
+// Cache entries written by these tests go here, away from the real cache
+const char* const sgc_pcDirectory = "resources/shaders/testcache/";
+
+// Every test program is set up from the same source, so it has the same key
+const char* const sgc_pcVertexSource =
+    "#version 330\nvoid main() { gl_Position = vec4( 0.0 ); }\n";
+const char* const sgc_pcFragmentSource =
+    "#version 330\nout vec4 oColor;\nvoid main() { oColor = vec4( 1.0 ); }\n";
+
+// What the recording backend hands over as the binary of every program
+const char sgc_acBinary[] = "Linked program binary";
+const std::size_t sgc_uiBinarySize = sizeof( sgc_acBinary );
+const GLenum sgc_eFormat = 0x4D46;
+
+// Size of a cache file holding that binary - magic number, version, key,
+// format, size, and checksum, followed by the binary itself
+const std::size_t sgc_uiEntrySize = 4 + 3 * sizeof( unsigned int ) +
+                                    2 * sizeof( Key ) + sgc_uiBinarySize;
+
+// Stands in for the driver, counting the calls the cache makes.  Binaries it
+// handed over are the only ones it loads, and only while it's accepting them,
+// which stands in for a driver update that doesn't change its identity.
+class RecordingBackend : public ProgramBinaryCache::Backend
+{
+public:
+
+    RecordingBackend( const char* ac_pcIdentity = "Recording driver" )
+        : m_oIdentity( ac_pcIdentity ), m_bAccepting( true ),
+          m_uiPrepares( 0 ), m_uiGets( 0 ), m_uiLoads( 0 ) {}
+    virtual ~RecordingBackend() {}
+
+    virtual bool IsSupported() const override { return true; }
+    virtual DumbString DriverIdentity() const override { return m_oIdentity; }
+    virtual void PrepareToStore( GLuint a_uiProgram ) const override
+    {
+        ++m_uiPrepares;
+    }
+    virtual std::size_t BinarySize( GLuint a_uiProgram ) const override
+    {
+        return sgc_uiBinarySize;
+    }
+    virtual bool GetBinary( GLuint a_uiProgram, GLenum& a_reFormat,
+                            char* a_pcData,
+                            std::size_t a_uiSize ) const override
+    {
+        ++m_uiGets;
+        if( sgc_uiBinarySize != a_uiSize )
+        {
+            return false;
+        }
+        a_reFormat = sgc_eFormat;
+        std::memcpy( a_pcData, sgc_acBinary, a_uiSize );
+        return true;
+    }
+    virtual bool LoadBinary( GLuint a_uiProgram, GLenum a_eFormat,
+                             const char* ac_pcData,
+                             std::size_t a_uiSize ) const override
+    {
+        ++m_uiLoads;
+        return ( m_bAccepting && sgc_eFormat == a_eFormat &&
+                 sgc_uiBinarySize == a_uiSize &&
+                 0 == std::memcmp( ac_pcData, sgc_acBinary, a_uiSize ) );
+    }
+
+    void SetAccepting( bool a_bAccepting ) { m_bAccepting = a_bAccepting; }
+    unsigned int Prepares() const { return m_uiPrepares; }
+    unsigned int Gets() const { return m_uiGets; }
+    unsigned int Loads() const { return m_uiLoads; }
+
+private:
+
+    DumbString m_oIdentity;
+    bool m_bAccepting;
+    mutable unsigned int m_uiPrepares;
+    mutable unsigned int m_uiGets;
+    mutable unsigned int m_uiLoads;
+
+};
+
+// A shader program that sets itself up as soon as it's made
+class TestProgram : public ShaderProgram
+{
+public:
+
+    TestProgram( const Shader& ac_roVertexShader,
+                 const Shader& ac_roFragmentShader )
+        : ShaderProgram( ac_roVertexShader, ac_roFragmentShader ) { Setup(); }
+    virtual ~TestProgram() { Destroy(); }
+
+};
+
+// What happened when a test program was set up
+struct Outcome
+{
+    Key ulKey;
+    bool bValid;
+    unsigned int uiCompiles;
+    unsigned int uiLinks;
+};
+
+// Set up a program from the test sources with the given cache, first deleting
+// any entry left over from an earlier run if asked.  The shaders get new names
+// each time, so nothing is reused from the last program but the cache entry.
+Outcome Build( ProgramBinaryCache& a_roCache, bool a_bClearEntry = false )
+{
+    static unsigned int suiBuilds = 0;
+    std::ostringstream oName;
+    oName << "ProgramBinaryCacheTest" << suiBuilds++;
+    ProgramBinaryCache* poPrevious = ProgramBinaryCache::Current();
+    ProgramBinaryCache::SetCurrent( &a_roCache );
+
+    Outcome oOutcome;
+    Shader oVertex( GL_VERTEX_SHADER, ( oName.str() + ".vert" ).c_str(),
+                    sgc_pcVertexSource );
+    Shader oFragment( GL_FRAGMENT_SHADER, ( oName.str() + ".frag" ).c_str(),
+                      sgc_pcFragmentSource );
+    const Key caulHashes[] = { oVertex.SourceHash(), oFragment.SourceHash() };
+    oOutcome.ulKey = a_roCache.MakeKey( caulHashes, 2 );
+    if( a_bClearEntry )
+    {
+        a_roCache.Invalidate( oOutcome.ulKey );
+    }
+    NullBackend::ResetStats();
+    {
+        TestProgram oProgram( oVertex, oFragment );
+        oOutcome.bValid = oProgram.IsValid();
+        oOutcome.uiCompiles = NullBackend::CurrentFrame().uiShaderCompiles;
+        oOutcome.uiLinks = NullBackend::CurrentFrame().uiProgramLinks;
+    }
+    oVertex.Delete();
+    oFragment.Delete();
+
+    ProgramBinaryCache::SetCurrent( poPrevious );
+    return oOutcome;
+}
+
+// Describe what's wrong with how a program was set up, or return an empty
+// string if it was linked from source or loaded from the cache as expected
+std::string Mismatch( const Outcome& ac_roOutcome, bool a_bFromCache )
+{
+    std::ostringstream oMessage;
+    if( 0 == ac_roOutcome.ulKey )
+    {
+        oMessage << "Program had no cache key";
+    }
+    else if( !ac_roOutcome.bValid )
+    {
+        oMessage << "Program wasn't valid";
+    }
+    else if( ( a_bFromCache ? 0u : 2u ) != ac_roOutcome.uiCompiles ||
+             ( a_bFromCache ? 0u : 1u ) != ac_roOutcome.uiLinks )
+    {
+        oMessage << "Program " << ( a_bFromCache ? "loaded from the cache"
+                                                 : "built from source" )
+                 << " made " << ac_roOutcome.uiCompiles << " compiles and "
+                 << ac_roOutcome.uiLinks << " links";
+    }
+    return oMessage.str();
+}
+
+// Describe what's wrong with a cache's counters, or return an empty string
+std::string Mismatch( const ProgramBinaryCache& ac_roCache,
+                      unsigned int a_uiHits, unsigned int a_uiMisses,
+                      unsigned int a_uiRejections )
+{
+    std::ostringstream oMessage;
+    if( a_uiHits != ac_roCache.Hits() || a_uiMisses != ac_roCache.Misses() ||
+        a_uiRejections != ac_roCache.Rejections() )
+    {
+        oMessage << "Expected " << a_uiHits << " hits, " << a_uiMisses
+                 << " misses, and " << a_uiRejections << " rejections, got "
+                 << ac_roCache.Hits() << ", " << ac_roCache.Misses()
+                 << ", and " << ac_roCache.Rejections();
+    }
+    return oMessage.str();
+}
+
+// Size of a file, or -1 if there's no such file
+long FileSize( const char* ac_pcFileName )
+{
+    std::ifstream oFile( ac_pcFileName, std::ios::in | std::ios::binary );
+    if( !oFile )
+    {
+        return -1;
+    }
+    oFile.seekg( 0, std::ios::end );
+    return (long)oFile.tellg();
+}
+
+// Change the last byte of a file, as a disk error might
+void FlipLastByte( const char* ac_pcFileName )
+{
+    std::fstream oFile( ac_pcFileName,
+                        std::ios::in | std::ios::out | std::ios::binary );
+    oFile.seekg( -1, std::ios::end );
+    char cByte = (char)oFile.get();
+    oFile.seekp( -1, std::ios::end );
+    oFile.put( (char)( cByte ^ 0x5A ) );
+}
+
+// Cut a file short, as a crash partway through writing it might
+void Truncate( const char* ac_pcFileName, std::size_t a_uiSize )
+{
+    std::vector< char > oData( a_uiSize );
+    {
+        std::ifstream oInput( ac_pcFileName, std::ios::in | std::ios::binary );
+        oInput.read( &( oData[0] ), a_uiSize );
+    }
+    std::ofstream oOutput( ac_pcFileName, std::ios::out | std::ios::binary |
+                                          std::ios::trunc );
+    oOutput.write( &( oData[0] ), a_uiSize );
+}
+
+}   // namespace
+
+ProgramBinaryCacheTestGroup::ProgramBinaryCacheTestGroup()
+    : UnitTestGroup("Program binary cache tests")
+{
+    AddTest( "Miss builds from source and writes back", Miss );
+    AddTest( "Hit skips compiling and linking", Hit );
+    AddTest( "Corrupt entries fall back to source", Corrupt );
+    AddTest( "Stale entries fall back to source", Stale );
+}
+
+// With no entry for a program, it should be compiled and linked from source,
+// asked to keep its binary, and have that binary written to the cache.
+UnitTest::Result ProgramBinaryCacheTestGroup::Miss()
+{
+    RecordingBackend oBackend;
+    ProgramBinaryCache oCache( sgc_pcDirectory, oBackend );
+    Outcome oOutcome = Build( oCache, true );
+    long lSize = FileSize( oCache.FileName( oOutcome.ulKey ) );
+    oCache.Invalidate( oOutcome.ulKey );
+
+    std::string oMessage = Mismatch( oOutcome, false );
+    if( oMessage.empty() )
+    {
+        oMessage = Mismatch( oCache, 0, 1, 0 );
+    }
+    if( !oMessage.empty() )
+    {
+        return UnitTest::Fail( oMessage );
+    }
+    if( 1 != oBackend.Prepares() || 1 != oBackend.Gets() ||
+        0 != oBackend.Loads() )
+    {
+        return UnitTest::Fail( "Binary wasn't retrieved exactly once" );
+    }
+    if( (long)sgc_uiEntrySize != lSize )
+    {
+        std::ostringstream oSizeMessage;
+        oSizeMessage << "Cache file was " << lSize << " bytes instead of "
+                     << sgc_uiEntrySize;
+        return UnitTest::Fail( oSizeMessage.str() );
+    }
+    return UnitTest::PASS;
+}
+
+// Once a program's binary is in the cache, a later program from the same
+// sources, set up through a different cache object as on a later run, should
+// load it without compiling, linking, or writing anything.
+UnitTest::Result ProgramBinaryCacheTestGroup::Hit()
+{
+    RecordingBackend oBackend;
+    ProgramBinaryCache oWriter( sgc_pcDirectory, oBackend );
+    Outcome oWritten = Build( oWriter, true );
+    ProgramBinaryCache oReader( sgc_pcDirectory, oBackend );
+    Outcome oOutcome = Build( oReader );
+    oReader.Invalidate( oOutcome.ulKey );
+
+    std::string oMessage = Mismatch( oWritten, false );
+    if( oMessage.empty() )
+    {
+        oMessage = Mismatch( oOutcome, true );
+    }
+    if( oMessage.empty() )
+    {
+        oMessage = Mismatch( oReader, 1, 0, 0 );
+    }
+    if( !oMessage.empty() )
+    {
+        return UnitTest::Fail( oMessage );
+    }
+    if( oWritten.ulKey != oOutcome.ulKey )
+    {
+        return UnitTest::Fail( "Same sources made different keys" );
+    }
+    if( 1 != oBackend.Loads() || 1 != oBackend.Gets() ||
+        1 != oBackend.Prepares() )
+    {
+        return UnitTest::Fail( "Cached binary wasn't loaded exactly once" );
+    }
+    return UnitTest::PASS;
+}
+
+// An entry with a changed byte or missing its end should be caught before the
+// driver sees it, deleted, and replaced by the binary of the program linked
+// from source in its place, which the next program should then load.
+UnitTest::Result ProgramBinaryCacheTestGroup::Corrupt()
+{
+    RecordingBackend oBackend;
+    ProgramBinaryCache oCache( sgc_pcDirectory, oBackend );
+    Outcome oWritten = Build( oCache, true );
+    DumbString oFileName = oCache.FileName( oWritten.ulKey );
+
+    FlipLastByte( oFileName );
+    Outcome oFlipped = Build( oCache );
+    long lFlippedSize = FileSize( oFileName );
+    Truncate( oFileName, sgc_uiEntrySize - sgc_uiBinarySize / 2 );
+    Outcome oTruncated = Build( oCache );
+    long lTruncatedSize = FileSize( oFileName );
+    Outcome oReloaded = Build( oCache );
+    oCache.Invalidate( oWritten.ulKey );
+
+    std::string oMessage = Mismatch( oWritten, false );
+    if( oMessage.empty() )
+    {
+        oMessage = Mismatch( oFlipped, false );
+    }
+    if( oMessage.empty() )
+    {
+        oMessage = Mismatch( oTruncated, false );
+    }
+    if( oMessage.empty() )
+    {
+        oMessage = Mismatch( oReloaded, true );
+    }
+    if( oMessage.empty() )
+    {
+        oMessage = Mismatch( oCache, 1, 1, 2 );
+    }
+    if( !oMessage.empty() )
+    {
+        return UnitTest::Fail( oMessage );
+    }
+    if( 1 != oBackend.Loads() )
+    {
+        return UnitTest::Fail( "Driver was handed a corrupt binary" );
+    }
+    if( 3 != oBackend.Gets() || (long)sgc_uiEntrySize != lFlippedSize ||
+        (long)sgc_uiEntrySize != lTruncatedSize )
+    {
+        return UnitTest::Fail( "Corrupt entries weren't written over" );
+    }
+    return UnitTest::PASS;
+}
+
+// An entry the driver won't load anymore should be deleted and written over,
+// and a driver with a different identity shouldn't look at the old driver's
+// entries at all.
+UnitTest::Result ProgramBinaryCacheTestGroup::Stale()
+{
+    RecordingBackend oBackend;
+    ProgramBinaryCache oCache( sgc_pcDirectory, oBackend );
+    Outcome oWritten = Build( oCache, true );
+    oBackend.SetAccepting( false );
+    Outcome oRejected = Build( oCache );
+    oBackend.SetAccepting( true );
+    Outcome oReloaded = Build( oCache );
+
+    RecordingBackend oUpdatedBackend( "Updated recording driver" );
+    ProgramBinaryCache oUpdatedCache( sgc_pcDirectory, oUpdatedBackend );
+    Outcome oUpdated = Build( oUpdatedCache, true );
+    long lOldSize = FileSize( oCache.FileName( oWritten.ulKey ) );
+    oCache.Invalidate( oWritten.ulKey );
+    oUpdatedCache.Invalidate( oUpdated.ulKey );
+
+    std::string oMessage = Mismatch( oWritten, false );
+    if( oMessage.empty() )
+    {
+        oMessage = Mismatch( oRejected, false );
+    }
+    if( oMessage.empty() )
+    {
+        oMessage = Mismatch( oReloaded, true );
+    }
+    if( oMessage.empty() )
+    {
+        oMessage = Mismatch( oCache, 1, 1, 1 );
+    }
+    if( !oMessage.empty() )
+    {
+        return UnitTest::Fail( oMessage );
+    }
+    if( 2 != oBackend.Loads() || 2 != oBackend.Gets() )
+    {
+        return UnitTest::Fail( "Rejected entry wasn't written over" );
+    }
+
+    oMessage = Mismatch( oUpdated, false );
+    if( oMessage.empty() )
+    {
+        oMessage = Mismatch( oUpdatedCache, 0, 1, 0 );
+    }
+    if( !oMessage.empty() )
+    {
+        return UnitTest::Fail( "Updated driver: " + oMessage );
+    }
+    if( oWritten.ulKey == oUpdated.ulKey || 0 != oUpdatedBackend.Loads() )
+    {
+        return UnitTest::Fail( "Updated driver used the old driver's entry" );
+    }
+    if( (long)sgc_uiEntrySize != lOldSize )
+    {
+        return UnitTest::Fail( "Updated driver disturbed the old entry" );
+    }
+    return UnitTest::PASS;
+}
@@ -0,0 +1,31 @@
+/******************************************************************************
+ * File:               ProgramBinaryCacheTestGroup.h
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Program binary cache tests, setting up shader programs
+ *                      on the null backend with a recording cache backend.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Creation.
+ ******************************************************************************/
+
+#ifndef PROGRAM_BINARY_CACHE_TEST_GROUP__H
+#define PROGRAM_BINARY_CACHE_TEST_GROUP__H
+
+#include "UnitTestGroup.h"
+
+class ProgramBinaryCacheTestGroup : public UnitTestGroup
+{
+public:
+
+    ProgramBinaryCacheTestGroup();
+
+private:
+
+    static UnitTest::Result Miss();
+    static UnitTest::Result Hit();
+    static UnitTest::Result Corrupt();
+    static UnitTest::Result Stale();
+
+};
+
+#endif  // PROGRAM_BINARY_CACHE_TEST_GROUP__H
@@ -0,0 +1,287 @@
+/******************************************************************************
+ * File:               QuadtreeBenchmarkTestGroup.cpp
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Quadtree benchmark, moving and searching a hundred
+ *                      thousand objects at 60 frames a second.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Creation.
+ ******************************************************************************/
+
+#include "QuadtreeBenchmarkTestGroup.h"
+#include "MyFirstEngine.h"
+#include <algorithm>
+#include <sstream>
+#include <vector>
+
+using namespace MyFirstEngine;
+
+namespace
+{
+
+typedef Plane::Quadtree< unsigned int > Tree;
+
+// Objects, and one second's worth of frames for them to move in
+const unsigned int sgc_uiObjects = 100000;
+const unsigned int sgc_uiFrames = 60;
+const double sgc_dFrameTime = 1.0 / 60.0;
+const double sgc_dWorldSize = 8192.0;
+
+// Each frame searches a circle around each of a hundred objects, and the
+// rectangle a camera would show as it scrolls diagonally across the world
+const unsigned int sgc_uiCircles = 100;
+const double sgc_dRadius = 64.0;
+const double sgc_dViewWidth = 800.0;
+const double sgc_dViewHeight = 600.0;
+const double sgc_dScrollSpeed = 16.0;   // world units per frame
+
+// Nodes split or merged each frame, and how many frames pass between checks
+// of the queries against a linear scan
+const unsigned int sgc_uiRebalanceBudget = 256;
+const unsigned int sgc_uiCheckInterval = 15;
+
+// Marks the end of each query's results, since no object has this handle
+const unsigned int sgc_uiEndOfQuery = Tree::INVALID;
+
+// Step a linear congruential generator and return its high bits
+unsigned int Random( unsigned int& a_ruiSeed )
+{
+    a_ruiSeed = a_ruiSeed * 1664525u + 1013904223u;
+    return a_ruiSeed >> 8;
+}
+
+// Move one side of a rectangle, reversing it if it would leave the world
+void Move( double& a_rdMin, double& a_rdMax, double& a_rdVelocity )
+{
+    double dOffset = a_rdVelocity * sgc_dFrameTime;
+    if( 0.0 > a_rdMin + dOffset || sgc_dWorldSize < a_rdMax + dOffset )
+    {
+        a_rdVelocity = -a_rdVelocity;
+        dOffset = -dOffset;
+    }
+    a_rdMin += dOffset;
+    a_rdMax += dOffset;
+}
+
+// Objects moving in straight lines at up to 100 units a second, bouncing off
+// the edges of the world, kept as separate arrays for each coordinate the way
+// Quadtree::Update takes them
+struct Movers
+{
+    std::vector< double > oMinX, oMinY, oMaxX, oMaxY;
+    std::vector< double > oVelocityX, oVelocityY;
+
+    Movers( unsigned int a_uiCount, unsigned int a_uiSeed )
+        : oMinX( a_uiCount ), oMinY( a_uiCount ), oMaxX( a_uiCount ),
+          oMaxY( a_uiCount ), oVelocityX( a_uiCount ), oVelocityY( a_uiCount )
+    {
+        const unsigned int cuiRange = (unsigned int)sgc_dWorldSize - 32;
+        for( unsigned int ui = 0; ui < a_uiCount; ++ui )
+        {
+            oMinX[ ui ] = Random( a_uiSeed ) % cuiRange;
+            oMinY[ ui ] = Random( a_uiSeed ) % cuiRange;
+            oMaxX[ ui ] = oMinX[ ui ] + 2 + Random( a_uiSeed ) % 19;
+            oMaxY[ ui ] = oMinY[ ui ] + 2 + Random( a_uiSeed ) % 19;
+            oVelocityX[ ui ] = (double)( Random( a_uiSeed ) % 201 ) - 100.0;
+            oVelocityY[ ui ] = (double)( Random( a_uiSeed ) % 201 ) - 100.0;
+        }
+    }
+
+    // Move every object one frame's worth
+    void Step()
+    {
+        for( unsigned int ui = 0; ui < oMinX.size(); ++ui )
+        {
+            Move( oMinX[ ui ], oMaxX[ ui ], oVelocityX[ ui ] );
+            Move( oMinY[ ui ], oMaxY[ ui ], oVelocityY[ ui ] );
+        }
+    }
+};
+
+// Where one frame's queries are
+struct Queries
+{
+    double adCircleX[ sgc_uiCircles ];
+    double adCircleY[ sgc_uiCircles ];
+    double adViewMin[2];
+    double adViewMax[2];
+
+    // Circles centered on evenly spaced objects, and the view scrolled the
+    // given number of frames in from the world's corner
+    Queries( const Movers& ac_roMovers, unsigned int a_uiFrame )
+    {
+        const unsigned int cuiSpacing =
+            (unsigned int)ac_roMovers.oMinX.size() / sgc_uiCircles;
+        for( unsigned int ui = 0; ui < sgc_uiCircles; ++ui )
+        {
+            unsigned int uiObject = ui * cuiSpacing;
+            adCircleX[ ui ] = ( ac_roMovers.oMinX[ uiObject ] +
+                                ac_roMovers.oMaxX[ uiObject ] ) / 2;
+            adCircleY[ ui ] = ( ac_roMovers.oMinY[ uiObject ] +
+                                ac_roMovers.oMaxY[ uiObject ] ) / 2;
+        }
+        adViewMin[0] = adViewMin[1] = a_uiFrame * sgc_dScrollSpeed;
+        adViewMax[0] = adViewMin[0] + sgc_dViewWidth;
+        adViewMax[1] = adViewMin[1] + sgc_dViewHeight;
+    }
+};
+
+// Sort the results of the query that started at the given index and mark
+// where it ended, so query results found in different orders can be compared
+void EndQuery( std::vector< unsigned int >& a_roResults,
+               unsigned int a_uiStart )
+{
+    std::sort( a_roResults.begin() + a_uiStart, a_roResults.end() );
+    a_roResults.push_back( sgc_uiEndOfQuery );
+}
+
+// Run a frame's queries on the tree
+void Search( const Tree& ac_roTree, const Queries& ac_roQueries,
+             std::vector< unsigned int >& a_roResults )
+{
+    a_roResults.clear();
+    for( unsigned int ui = 0; ui < sgc_uiCircles; ++ui )
+    {
+        unsigned int uiStart = (unsigned int)a_roResults.size();
+        ac_roTree.QueryCircle( ac_roQueries.adCircleX[ ui ],
+                               ac_roQueries.adCircleY[ ui ], sgc_dRadius,
+                               a_roResults );
+        EndQuery( a_roResults, uiStart );
+    }
+    unsigned int uiStart = (unsigned int)a_roResults.size();
+    ac_roTree.QueryRectangle( ac_roQueries.adViewMin[0],
+                              ac_roQueries.adViewMin[1],
+                              ac_roQueries.adViewMax[0],
+                              ac_roQueries.adViewMax[1], a_roResults );
+    EndQuery( a_roResults, uiStart );
+}
+
+// Run the same queries by testing every object, giving the same results if
+// the tree found everything it should have
+void Scan( const Movers& ac_roMovers,
+           const std::vector< unsigned int >& ac_roHandles,
+           const Queries& ac_roQueries,
+           std::vector< unsigned int >& a_roResults )
+{
+    a_roResults.clear();
+    const unsigned int cuiCount = (unsigned int)ac_roHandles.size();
+    for( unsigned int ui = 0; ui < sgc_uiCircles; ++ui )
+    {
+        unsigned int uiStart = (unsigned int)a_roResults.size();
+        double dX = ac_roQueries.adCircleX[ ui ];
+        double dY = ac_roQueries.adCircleY[ ui ];
+        for( unsigned int uiObject = 0; uiObject < cuiCount; ++uiObject )
+        {
+            double dNearestX =
+                std::max( ac_roMovers.oMinX[ uiObject ],
+                          std::min( dX, ac_roMovers.oMaxX[ uiObject ] ) );
+            double dNearestY =
+                std::max( ac_roMovers.oMinY[ uiObject ],
+                          std::min( dY, ac_roMovers.oMaxY[ uiObject ] ) );
+            if( ( dNearestX - dX ) * ( dNearestX - dX ) +
+                ( dNearestY - dY ) * ( dNearestY - dY ) <=
+                sgc_dRadius * sgc_dRadius )
+            {
+                a_roResults.push_back( ac_roHandles[ uiObject ] );
+            }
+        }
+        EndQuery( a_roResults, uiStart );
+    }
+    unsigned int uiStart = (unsigned int)a_roResults.size();
+    for( unsigned int uiObject = 0; uiObject < cuiCount; ++uiObject )
+    {
+        if( ac_roMovers.oMinX[ uiObject ] <= ac_roQueries.adViewMax[0] &&
+            ac_roMovers.oMaxX[ uiObject ] >= ac_roQueries.adViewMin[0] &&
+            ac_roMovers.oMinY[ uiObject ] <= ac_roQueries.adViewMax[1] &&
+            ac_roMovers.oMaxY[ uiObject ] >= ac_roQueries.adViewMin[1] )
+        {
+            a_roResults.push_back( ac_roHandles[ uiObject ] );
+        }
+    }
+    EndQuery( a_roResults, uiStart );
+}
+
+}   // namespace
+
+QuadtreeBenchmarkTestGroup::QuadtreeBenchmarkTestGroup()
+    : UnitTestGroup("Quadtree benchmarks")
+{
+    AddTest( "Moving 100,000 objects at 60 Hz", MovingObjects );
+}
+
+// CPU time per frame to move a hundred thousand objects around the tree,
+// rebalance it a little at a time, and search it with a hundred circles and a
+// view rectangle.  Every few frames the queries are repeated by linear scan,
+// which should find exactly the same objects, and is timed for comparison.
+UnitTest::Result QuadtreeBenchmarkTestGroup::MovingObjects()
+{
+    Movers oMovers( sgc_uiObjects, 7 );
+    std::vector< unsigned int > oValues( sgc_uiObjects );
+    for( unsigned int ui = 0; ui < sgc_uiObjects; ++ui )
+    {
+        oValues[ ui ] = ui;
+    }
+    std::vector< unsigned int > oHandles( sgc_uiObjects );
+    Tree oTree( 0.0, 0.0, sgc_dWorldSize, sgc_dWorldSize );
+    oTree.Reserve( sgc_uiObjects );
+    oTree.Insert( sgc_uiObjects, &oValues[0], &oMovers.oMinX[0],
+                  &oMovers.oMinY[0], &oMovers.oMaxX[0], &oMovers.oMaxY[0],
+                  &oHandles[0] );
+    oTree.Rebalance();
+
+    std::vector< unsigned int > oFound;
+    std::vector< unsigned int > oExpected;
+    double dUpdateSeconds = 0.0;
+    double dRebalanceSeconds = 0.0;
+    double dSearchSeconds = 0.0;
+    double dScanSeconds = 0.0;
+    unsigned int uiChecks = 0;
+    unsigned int uiMismatches = 0;
+    for( unsigned int ui = 0; ui < sgc_uiFrames; ++ui )
+    {
+        oMovers.Step();
+        Queries oQueries( oMovers, ui );
+
+        double dStart = NullBackend::CPUTime();
+        oTree.Update( sgc_uiObjects, &oHandles[0], &oMovers.oMinX[0],
+                      &oMovers.oMinY[0], &oMovers.oMaxX[0],
+                      &oMovers.oMaxY[0] );
+        double dUpdated = NullBackend::CPUTime();
+        oTree.Rebalance( sgc_uiRebalanceBudget );
+        double dRebalanced = NullBackend::CPUTime();
+        Search( oTree, oQueries, oFound );
+        double dSearched = NullBackend::CPUTime();
+        dUpdateSeconds += dUpdated - dStart;
+        dRebalanceSeconds += dRebalanced - dUpdated;
+        dSearchSeconds += dSearched - dRebalanced;
+
+        if( 0 == ( ui + 1 ) % sgc_uiCheckInterval )
+        {
+            Scan( oMovers, oHandles, oQueries, oExpected );
+            dScanSeconds += NullBackend::CPUTime() - dSearched;
+            ++uiChecks;
+            if( oExpected != oFound )
+            {
+                ++uiMismatches;
+            }
+        }
+    }
+
+    if( sgc_uiObjects != oTree.Count() )
+    {
+        return UnitTest::Fail( "Objects lost from the tree" );
+    }
+    if( 0 != uiMismatches )
+    {
+        return UnitTest::Fail( "Tree queries differed from a linear scan" );
+    }
+    std::ostringstream oMessage;
+    oMessage << "Update " << dUpdateSeconds * 1000.0 / sgc_uiFrames
+             << " ms/frame, rebalance "
+             << dRebalanceSeconds * 1000.0 / sgc_uiFrames
+             << " ms/frame, search "
+             << dSearchSeconds * 1000.0 / sgc_uiFrames
+             << " ms/frame, linear scan "
+             << dScanSeconds * 1000.0 / uiChecks << " ms/frame";
+    return UnitTest::Pass( oMessage.str() );
+}
@@ -0,0 +1,28 @@
+/******************************************************************************
+ * File:               QuadtreeBenchmarkTestGroup.h
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Quadtree benchmark, moving and searching a hundred
+ *                      thousand objects at 60 frames a second.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Creation.
+ ******************************************************************************/
+
+#ifndef QUADTREE_BENCHMARK_TEST_GROUP__H
+#define QUADTREE_BENCHMARK_TEST_GROUP__H
+
+#include "UnitTestGroup.h"
+
+class QuadtreeBenchmarkTestGroup : public UnitTestGroup
+{
+public:
+
+    QuadtreeBenchmarkTestGroup();
+
+private:
+
+    static UnitTest::Result MovingObjects();
+
+};
+
+#endif  // QUADTREE_BENCHMARK_TEST_GROUP__H
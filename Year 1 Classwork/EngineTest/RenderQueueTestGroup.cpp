@@ -0,0 +1,379 @@
+/******************************************************************************
+ * File:               RenderQueueTestGroup.cpp
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Render queue sorting and submission tests.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Draws are batched so overlapping ones keep their order.
+ ******************************************************************************/
+
+#include "RenderQueueTestGroup.h"
+#include "MyFirstEngine.h"
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+using namespace MyFirstEngine;
+
+namespace
+{
+
+typedef RenderQueue::Key Key;
+typedef RenderQueue::Recorder Recorder;
+typedef std::pair< Key, unsigned int > IndexedKey;
+
+// A texture that sorts as opaque without having to be loaded from a file
+class OpaqueTexture : public Texture
+{
+public:
+    OpaqueTexture() : Texture( "" ) { m_bOpaque = true; }
+    virtual ~OpaqueTexture() {}
+};
+
+// One submission a flush is expected to make
+struct Expected
+{
+    Recorder::Action eAction;
+    RenderQueue::Program eProgram;
+    Texture* poTexture;
+};
+
+// A model-view-projection matrix that puts the origin at the given depth,
+// and optionally moves it sideways.  A unit quad is drawn from half a unit
+// left of the origin to half a unit right of it, so quads one unit apart
+// touch without overlapping.
+GLTransform3D AtDepth( double a_dDepth, double a_dX = 0.0 )
+{
+    GLTransform3D oMatrix = GLTransform3D::Identity();
+    oMatrix[3][0] = (GLScalar)a_dX;
+    oMatrix[3][2] = (GLScalar)a_dDepth;
+    return oMatrix;
+}
+
+// Add a sprite at the given depth and sideways position
+void AddSprite( RenderQueue& a_roQueue, Texture& a_roTexture, double a_dDepth,
+                const Color::ColorVector& ac_roColor = Color::WHITE,
+                double a_dX = 0.0 )
+{
+    a_roQueue.AddSprite( a_roTexture, AtDepth( a_dDepth, a_dX ),
+                         Point2D( 0.0, 0.0 ), Point2D( 1.0, 1.0 ),
+                         Transform2D::Identity(), ac_roColor );
+}
+
+// Did the recorder get exactly the expected submissions, in order?
+bool Matches( const Recorder& ac_roRecorder,
+              const Expected* ac_paoExpected, unsigned int a_uiCount )
+{
+    if( a_uiCount != ac_roRecorder.Size() )
+    {
+        return false;
+    }
+    for( unsigned int ui = 0; ui < a_uiCount; ++ui )
+    {
+        const Recorder::Submission& roSubmission = ac_roRecorder[ ui ];
+        if( ac_paoExpected[ ui ].eAction != roSubmission.eAction ||
+            ac_paoExpected[ ui ].eProgram != roSubmission.eProgram ||
+            ac_paoExpected[ ui ].poTexture != roSubmission.poTexture )
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool KeyLess( const IndexedKey& ac_roLeft, const IndexedKey& ac_roRight )
+{
+    return ac_roLeft.first < ac_roRight.first;
+}
+
+}   // namespace
+
+RenderQueueTestGroup::RenderQueueTestGroup()
+    : UnitTestGroup("Render queue tests")
+{
+    AddTest( "Sort key fields", SortKeys );
+    AddTest( "Radix sort keeps equal keys in order", StableSort );
+    AddTest( "Submission order and state changes", SubmissionOrder );
+    AddTest( "Translucent draws keep their order", TranslucentOrder );
+    AddTest( "Overlapping draws keep their order", OverlapOrder );
+    AddTest( "Recording and flushing", Recording );
+}
+
+UnitTest::Result RenderQueueTestGroup::SortKeys()
+{
+    const RenderQueue::Program QUAD = RenderQueue::QUAD_PROGRAM;
+    const RenderQueue::Program SPRITE = RenderQueue::SPRITE_PROGRAM;
+    if( RenderQueue::MakeKey( 0, -1.0, 9, SPRITE, 9 ) >=
+        RenderQueue::MakeKey( 1, 1.0, 0, QUAD, 0 ) )
+    {
+        return UnitTest::Fail( "Layer wasn't the most significant field" );
+    }
+    if( RenderQueue::MakeKey( 0, 0.5, 9, QUAD, 0 ) >=
+        RenderQueue::MakeKey( 0, -0.5, 0, QUAD, 0 ) )
+    {
+        return UnitTest::Fail( "Farther draws didn't sort first" );
+    }
+    if( RenderQueue::MakeKey( 0, 0.0, 0, SPRITE, 9 ) >=
+        RenderQueue::MakeKey( 0, 0.0, 1, QUAD, 0 ) )
+    {
+        return UnitTest::Fail( "Earlier batches didn't sort first" );
+    }
+    if( RenderQueue::MakeKey( 0, 0.0, 0, QUAD, 5 ) >=
+            RenderQueue::MakeKey( 0, 0.0, 0, SPRITE, 0 ) ||
+        RenderQueue::MakeKey( 0, 0.0, 0, SPRITE, 0 ) >=
+            RenderQueue::MakeKey( 0, 0.0, 0, SPRITE, 1 ) )
+    {
+        return UnitTest::Fail( "Draws weren't grouped by program, then "
+                               "texture" );
+    }
+    if( RenderQueue::MakeKey( 0, 0.0, 70000, QUAD, 0 ) !=
+            RenderQueue::MakeKey( 0, 0.0, 0xFFFFFFFF, SPRITE, 7 ) ||
+        RenderQueue::MakeKey( 0, 0.0, 70000, QUAD, 0 ) <=
+            RenderQueue::MakeKey( 0, 0.0, 1000, SPRITE, 7 ) )
+    {
+        return UnitTest::Fail( "Keys past the last batch depended on state" );
+    }
+    if( RenderQueue::MakeKey( 2, -5.0, 0, QUAD, 0 ) !=
+            RenderQueue::MakeKey( 2, -1.0, 0, QUAD, 0 ) ||
+        RenderQueue::MakeKey( 2, 5.0, 0, QUAD, 0 ) !=
+            RenderQueue::MakeKey( 2, 1.0, 0, QUAD, 0 ) )
+    {
+        return UnitTest::Fail( "Depth wasn't clamped" );
+    }
+    return UnitTest::PASS;
+}
+
+// Compare the radix sort to a standard stable sort of the same keys, with
+// plenty of duplicates
+UnitTest::Result RenderQueueTestGroup::StableSort()
+{
+    const unsigned int uiCount = 1000;
+    std::vector< Key > oKeys( uiCount ), oScratchKeys( uiCount );
+    std::vector< unsigned int > oIndices( uiCount ), oScratchIndices( uiCount );
+    std::vector< IndexedKey > oExpected;
+    unsigned int uiSeed = 1;
+    for( unsigned int ui = 0; ui < uiCount; ++ui )
+    {
+        uiSeed = uiSeed * 1664525u + 1013904223u;
+        oKeys[ ui ] = RenderQueue::MakeKey(
+            (unsigned char)( ( uiSeed >> 8 ) % 3 ),
+            ( ( uiSeed >> 12 ) % 5 ) / 2.0 - 1.0,
+            ( uiSeed >> 16 ) % 3,
+            (RenderQueue::Program)( ( uiSeed >> 20 ) % 2 ),
+            ( uiSeed >> 24 ) % 4 );
+        oIndices[ ui ] = ui;
+        oExpected.push_back( IndexedKey( oKeys[ ui ], ui ) );
+    }
+    std::stable_sort( oExpected.begin(), oExpected.end(), KeyLess );
+    RenderQueue::Sort( &( oKeys[0] ), &( oIndices[0] ), &( oScratchKeys[0] ),
+                       &( oScratchIndices[0] ), uiCount );
+    for( unsigned int ui = 0; ui < uiCount; ++ui )
+    {
+        if( oExpected[ ui ].first != oKeys[ ui ] ||
+            oExpected[ ui ].second != oIndices[ ui ] )
+        {
+            return UnitTest::Fail( "Sorted order didn't match" );
+        }
+    }
+    return UnitTest::PASS;
+}
+
+// Opaque quads and sprites laid side by side, added in an order that would
+// switch program or texture on almost every draw
+UnitTest::Result RenderQueueTestGroup::SubmissionOrder()
+{
+    const RenderQueue::Program QUAD = RenderQueue::QUAD_PROGRAM;
+    const RenderQueue::Program SPRITE = RenderQueue::SPRITE_PROGRAM;
+    const RenderQueue::Program NONE = RenderQueue::PROGRAM_COUNT;
+    OpaqueTexture oA, oB;
+    RenderQueue oQueue;
+    oQueue.Begin();
+    AddSprite( oQueue, oA, 0.0, Color::WHITE, 0.0 );
+    oQueue.AddQuad( AtDepth( 0.0, 1.0 ), Color::WHITE );
+    AddSprite( oQueue, oB, 0.0, Color::WHITE, 2.0 );
+    AddSprite( oQueue, oA, 0.0, Color::WHITE, 3.0 );
+    oQueue.AddQuad( AtDepth( 0.0, 4.0 ), Color::WHITE );
+    AddSprite( oQueue, oB, 0.0, Color::WHITE, 5.0 );
+    oQueue.AddQuad( AtDepth( 0.5 ), Color::WHITE );
+    oQueue.SetLayer( 1 ).AddQuad( AtDepth( -1.0 ), Color::WHITE );
+    if( 8 != oQueue.Size() )
+    {
+        return UnitTest::Fail( "Draws weren't added to the queue" );
+    }
+
+    Recorder oRecorder;
+    oQueue.Flush( oRecorder );
+    const Expected acoExpected[] =
+    {
+        { Recorder::USE_PROGRAM, QUAD, nullptr },
+        { Recorder::DRAW, QUAD, nullptr },          // farther, so first
+        { Recorder::DRAW, QUAD, nullptr },
+        { Recorder::DRAW, QUAD, nullptr },
+        { Recorder::USE_PROGRAM, SPRITE, nullptr },
+        { Recorder::BIND_TEXTURE, NONE, &oA },
+        { Recorder::DRAW, SPRITE, &oA },
+        { Recorder::DRAW, SPRITE, &oA },
+        { Recorder::BIND_TEXTURE, NONE, &oB },
+        { Recorder::DRAW, SPRITE, &oB },
+        { Recorder::DRAW, SPRITE, &oB },
+        { Recorder::USE_PROGRAM, QUAD, nullptr },
+        { Recorder::DRAW, QUAD, nullptr }           // higher layer, so last
+    };
+    if( !Matches( oRecorder, acoExpected,
+                  sizeof( acoExpected ) / sizeof( Expected ) ) )
+    {
+        return UnitTest::Fail( "Submissions weren't sorted" );
+    }
+    if( RenderQueue::MakeKey( 0, 0.5, 1, QUAD, 0 ) != oRecorder[1].ulKey )
+    {
+        return UnitTest::Fail( "Farther quad wasn't drawn first" );
+    }
+
+    const RenderQueue::Stats& roStats = oQueue.LastFlush();
+    if( 8 != roStats.uiDraws || 3 != roStats.uiProgramChanges ||
+        2 != roStats.uiTextureChanges )
+    {
+        return UnitTest::Fail( "State changes weren't counted" );
+    }
+    if( 6 != roStats.uiUnsortedProgramChanges ||
+        4 != roStats.uiUnsortedTextureChanges )
+    {
+        return UnitTest::Fail( "Unsorted state changes weren't counted" );
+    }
+    if( 0 != oQueue.Size() || oQueue.IsRecording() )
+    {
+        return UnitTest::Fail( "Flushing didn't empty the queue" );
+    }
+    return UnitTest::PASS;
+}
+
+// Translucent draws - by color or because the texture isn't known to be
+// opaque - and opaque draws on top of them keep the order they were added in
+UnitTest::Result RenderQueueTestGroup::TranslucentOrder()
+{
+    const RenderQueue::Program QUAD = RenderQueue::QUAD_PROGRAM;
+    const RenderQueue::Program SPRITE = RenderQueue::SPRITE_PROGRAM;
+    const RenderQueue::Program NONE = RenderQueue::PROGRAM_COUNT;
+    const Color::ColorVector oHalf( 1.0f, 1.0f, 1.0f, 0.5f );
+    OpaqueTexture oA, oB;
+    Texture oUnloaded( "" );
+    RenderQueue oQueue;
+    oQueue.Begin();
+    AddSprite( oQueue, oUnloaded, 0.0 );
+    AddSprite( oQueue, oA, 0.0, oHalf );
+    oQueue.AddQuad( AtDepth( 0.0 ), Color::WHITE );
+    AddSprite( oQueue, oB, 0.0, oHalf );
+    AddSprite( oQueue, oA, 0.0, oHalf );
+    oQueue.AddQuad( AtDepth( 0.5 ), oHalf );
+
+    Recorder oRecorder;
+    oQueue.Flush( oRecorder );
+    const Expected acoExpected[] =
+    {
+        { Recorder::USE_PROGRAM, QUAD, nullptr },
+        { Recorder::DRAW, QUAD, nullptr },          // farther, so first
+        { Recorder::USE_PROGRAM, SPRITE, nullptr },
+        { Recorder::BIND_TEXTURE, NONE, &oUnloaded },
+        { Recorder::DRAW, SPRITE, &oUnloaded },
+        { Recorder::BIND_TEXTURE, NONE, &oA },
+        { Recorder::DRAW, SPRITE, &oA },
+        { Recorder::USE_PROGRAM, QUAD, nullptr },
+        { Recorder::DRAW, QUAD, nullptr },          // opaque, but on top
+        { Recorder::USE_PROGRAM, SPRITE, nullptr },
+        { Recorder::BIND_TEXTURE, NONE, &oB },
+        { Recorder::DRAW, SPRITE, &oB },
+        { Recorder::BIND_TEXTURE, NONE, &oA },
+        { Recorder::DRAW, SPRITE, &oA }
+    };
+    if( !Matches( oRecorder, acoExpected,
+                  sizeof( acoExpected ) / sizeof( Expected ) ) )
+    {
+        return UnitTest::Fail( "Translucent draws were reordered" );
+    }
+    if( 4 != oQueue.LastFlush().uiProgramChanges ||
+        4 != oQueue.LastFlush().uiTextureChanges )
+    {
+        return UnitTest::Fail( "State changes weren't counted" );
+    }
+    return UnitTest::PASS;
+}
+
+// Opaque sprites stacked on top of each other keep their order, and only a
+// draw that doesn't overlap anything in the open batch joins it
+UnitTest::Result RenderQueueTestGroup::OverlapOrder()
+{
+    const RenderQueue::Program QUAD = RenderQueue::QUAD_PROGRAM;
+    const RenderQueue::Program SPRITE = RenderQueue::SPRITE_PROGRAM;
+    const RenderQueue::Program NONE = RenderQueue::PROGRAM_COUNT;
+    OpaqueTexture oA, oB;
+    RenderQueue oQueue;
+    oQueue.Begin();
+    AddSprite( oQueue, oA, 0.0, Color::WHITE, 0.0 );
+    AddSprite( oQueue, oB, 0.0, Color::WHITE, 0.5 );
+    AddSprite( oQueue, oA, 0.0, Color::WHITE, 0.0 );
+    oQueue.AddQuad( AtDepth( 0.0, 1.0 ), Color::WHITE );
+    oQueue.AddQuad( AtDepth( 0.0, 0.25 ), Color::WHITE );
+
+    Recorder oRecorder;
+    oQueue.Flush( oRecorder );
+    const Expected acoExpected[] =
+    {
+        { Recorder::USE_PROGRAM, SPRITE, nullptr },
+        { Recorder::BIND_TEXTURE, NONE, &oA },
+        { Recorder::DRAW, SPRITE, &oA },
+        { Recorder::BIND_TEXTURE, NONE, &oB },
+        { Recorder::DRAW, SPRITE, &oB },            // overlaps the first
+        { Recorder::USE_PROGRAM, QUAD, nullptr },
+        { Recorder::DRAW, QUAD, nullptr },          // beside the third
+        { Recorder::USE_PROGRAM, SPRITE, nullptr },
+        { Recorder::BIND_TEXTURE, NONE, &oA },
+        { Recorder::DRAW, SPRITE, &oA },            // overlaps the second
+        { Recorder::USE_PROGRAM, QUAD, nullptr },
+        { Recorder::DRAW, QUAD, nullptr }           // overlaps the third
+    };
+    if( !Matches( oRecorder, acoExpected,
+                  sizeof( acoExpected ) / sizeof( Expected ) ) )
+    {
+        return UnitTest::Fail( "Overlapping draws were reordered" );
+    }
+    return UnitTest::PASS;
+}
+
+UnitTest::Result RenderQueueTestGroup::Recording()
+{
+    if( nullptr != RenderQueue::Current() )
+    {
+        return UnitTest::Fail( "A queue was recording before any began" );
+    }
+    RenderQueue oFirst, oSecond;
+    oFirst.Begin();
+    oFirst.SetLayer( 3 ).AddQuad( AtDepth( 0.0 ), Color::WHITE );
+    if( !oFirst.IsRecording() || &oFirst != RenderQueue::Current() )
+    {
+        return UnitTest::Fail( "Beginning didn't make the queue current" );
+    }
+    oSecond.Begin();
+    if( oFirst.IsRecording() || !oSecond.IsRecording() ||
+        1 != oFirst.Size() || 0 != oSecond.GetLayer() )
+    {
+        return UnitTest::Fail( "Beginning another queue didn't take over" );
+    }
+    oSecond.AddQuad( AtDepth( 0.0 ), Color::WHITE );
+    oSecond.Clear();
+    Recorder oRecorder;
+    oSecond.Flush( oRecorder );
+    if( 0 != oRecorder.Size() || 0 != oSecond.LastFlush().uiDraws ||
+        nullptr != RenderQueue::Current() )
+    {
+        return UnitTest::Fail( "Flushing a cleared queue submitted draws" );
+    }
+    {
+        RenderQueue oThird;
+        oThird.Begin();
+    }
+    if( nullptr != RenderQueue::Current() )
+    {
+        return UnitTest::Fail( "A destroyed queue was still current" );
+    }
+    return UnitTest::PASS;
+}
@@ -0,0 +1,32 @@
+/******************************************************************************
+ * File:               RenderQueueTestGroup.h
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Render queue sorting and submission tests.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Added overlapping draw test.
+ ******************************************************************************/
+
+#ifndef RENDER_QUEUE_TEST_GROUP__H
+#define RENDER_QUEUE_TEST_GROUP__H
+
+#include "UnitTestGroup.h"
+
+class RenderQueueTestGroup : public UnitTestGroup
+{
+public:
+
+    RenderQueueTestGroup();
+
+private:
+
+    static UnitTest::Result SortKeys();
+    static UnitTest::Result StableSort();
+    static UnitTest::Result SubmissionOrder();
+    static UnitTest::Result TranslucentOrder();
+    static UnitTest::Result OverlapOrder();
+    static UnitTest::Result Recording();
+
+};
+
+#endif  // RENDER_QUEUE_TEST_GROUP__H
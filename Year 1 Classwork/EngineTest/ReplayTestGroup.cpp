@@ -0,0 +1,293 @@
+/******************************************************************************
+ * File:               ReplayTestGroup.cpp
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Input recording and replay tests, playing headless game
+ *                      sessions on the null backend.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Creation.
+ ******************************************************************************/
+
+#include "ReplayTestGroup.h"
+#include "MyFirstEngine.h"
+#include <cmath>
+#include <cstdio>
+#include <sstream>
+#include <vector>
+
+using namespace MyFirstEngine;
+
+namespace
+{
+
+// Where recordings are written, in the working directory
+const char* const sgc_pcRecording = "ReplayTest.input";
+
+// The keys and buttons a session presses
+const Keyboard::Key sgc_aeKeys[] = { Keyboard::A, Keyboard::W, Keyboard::S,
+                                     Keyboard::D, Keyboard::SPACE,
+                                     Keyboard::LEFT_SHIFT };
+const unsigned int sgc_uiKeyCount =
+    sizeof( sgc_aeKeys ) / sizeof( *sgc_aeKeys );
+const Mouse::Button sgc_aeButtons[] = { Mouse::LEFT_BUTTON,
+                                        Mouse::RIGHT_BUTTON,
+                                        Mouse::MIDDLE_BUTTON };
+const unsigned int sgc_uiButtonCount =
+    sizeof( sgc_aeButtons ) / sizeof( *sgc_aeButtons );
+
+// Step a linear congruential generator and return its high bits
+unsigned int Random( unsigned int& a_ruiSeed )
+{
+    a_ruiSeed = a_ruiSeed * 1664525u + 1013904223u;
+    return a_ruiSeed >> 8;
+}
+
+// Fold a value's bytes into an FNV-1a hash
+void Mix( unsigned long long& a_rulHash, double a_dValue )
+{
+    const unsigned char* cpucByte = (const unsigned char*)&a_dValue;
+    for( unsigned int ui = 0; ui < sizeof( a_dValue ); ++ui )
+    {
+        a_rulHash ^= cpucByte[ ui ];
+        a_rulHash *= 1099511628211ull;
+    }
+}
+void Mix( unsigned long long& a_rulHash, bool a_bValue )
+{
+    Mix( a_rulHash, a_bValue ? 1.0 : 0.0 );
+}
+
+// A headless game session.  Each frame, it hashes everything a game could
+// read from the keyboard and mouse, then posts a few random key and button
+// events to happen before the next frame.  Ends the game after the given
+// number of frames.
+class Session : public GameState
+{
+public:
+
+    Session( unsigned int a_uiFrames, unsigned int a_uiSeed )
+        : m_uiFrames( a_uiFrames ), m_uiSeed( a_uiSeed ) {}
+    virtual ~Session() {}
+
+    // What each frame saw
+    const std::vector< unsigned long long >& Hashes() const
+    { return m_oHashes; }
+    const std::vector< double >& Times() const { return m_oTimes; }
+    const std::vector< double >& DeltaTimes() const { return m_oDeltaTimes; }
+    const std::vector< bool >& Replayed() const { return m_oReplayed; }
+    const std::vector< bool >& Changed() const { return m_oChanged; }
+
+protected:
+
+    virtual void OnUpdate( double a_dDeltaTime ) override
+    {
+        unsigned long long ulHash = 14695981039346656037ull;
+        bool bChanged = false;
+        Mix( ulHash, GameEngine::LastTime() );
+        Mix( ulHash, a_dDeltaTime );
+        for( unsigned int ui = 0; ui < sgc_uiKeyCount; ++ui )
+        {
+            Keyboard::Key eKey = sgc_aeKeys[ ui ];
+            Mix( ulHash, Keyboard::KeyIsPressed( eKey ) );
+            Mix( ulHash, Keyboard::KeyWasPressed( eKey ) );
+            Mix( ulHash, Keyboard::KeyWasReleased( eKey ) );
+            Mix( ulHash, Keyboard::KeyTime( eKey ) );
+            bChanged = bChanged || Keyboard::KeyWasPressed( eKey ) ||
+                       Keyboard::KeyWasReleased( eKey );
+        }
+        Mix( ulHash, Keyboard::AnyKeyTime() );
+        Mix( ulHash, Keyboard::ShiftTime() );
+        for( unsigned int ui = 0; ui < sgc_uiButtonCount; ++ui )
+        {
+            Mouse::Button eButton = sgc_aeButtons[ ui ];
+            Mix( ulHash, Mouse::ButtonIsPressed( eButton ) );
+            Mix( ulHash, Mouse::ButtonWasPressed( eButton ) );
+            Mix( ulHash, Mouse::ButtonWasReleased( eButton ) );
+            Mix( ulHash, Mouse::ButtonTime( eButton ) );
+            bChanged = bChanged || Mouse::ButtonWasPressed( eButton ) ||
+                       Mouse::ButtonWasReleased( eButton );
+        }
+        Point2D oPosition = Mouse::Position();
+        Mix( ulHash, (double)oPosition.x );
+        Mix( ulHash, (double)oPosition.y );
+        Mix( ulHash, nullptr != Mouse::Window() );
+
+        m_oHashes.push_back( ulHash );
+        m_oTimes.push_back( GameEngine::LastTime() );
+        m_oDeltaTimes.push_back( a_dDeltaTime );
+        m_oReplayed.push_back( Input::IsReplaying() );
+        m_oChanged.push_back( bChanged );
+        if( m_uiFrames <= m_oHashes.size() )
+        {
+            GameEngine::ClearStates();
+            return;
+        }
+
+        // Post up to three events, spread over the time before the next frame
+        unsigned int uiEvents = Random( m_uiSeed ) % 4;
+        for( unsigned int ui = 0; ui < uiEvents; ++ui )
+        {
+            double dTime = GameEngine::LastTime() +
+                           NullBackend::FrameTime() * ( ui + 1 ) / 4;
+            bool bPressed = ( 0 != Random( m_uiSeed ) % 2 );
+            if( 0 != Random( m_uiSeed ) % 4 )
+            {
+                Input::Post( Input::KEYBOARD,
+                             sgc_aeKeys[ Random( m_uiSeed ) % sgc_uiKeyCount ],
+                             bPressed, dTime );
+            }
+            else
+            {
+                Input::Post( Input::MOUSE_BUTTON,
+                             sgc_aeButtons[ Random( m_uiSeed ) %
+                                            sgc_uiButtonCount ],
+                             bPressed, dTime );
+            }
+        }
+    }
+
+private:
+
+    unsigned int m_uiFrames;
+    unsigned int m_uiSeed;
+    std::vector< unsigned long long > m_oHashes;
+    std::vector< double > m_oTimes;
+    std::vector< double > m_oDeltaTimes;
+    std::vector< bool > m_oReplayed;
+    std::vector< bool > m_oChanged;
+
+};  // class Session
+
+// How a session gets its input
+enum Source
+{
+    LIVE,
+    RECORD,
+    REPLAY
+};
+
+// Play a session from start to finish on a freshly initialized engine, so
+// every session starts from the same state.  Returns false if the engine
+// didn't initialize or the recording couldn't be started.
+bool Play( Session& a_roSession, Source a_eSource )
+{
+    if( !GameEngine::Initialize() )
+    {
+        return false;
+    }
+    bool bStarted = ( RECORD == a_eSource
+                      ? Input::StartRecording( sgc_pcRecording ) :
+                      REPLAY == a_eSource
+                      ? Input::StartReplay( sgc_pcRecording ) : true );
+    if( bStarted )
+    {
+        a_roSession.Push();
+        GameEngine::Run();
+    }
+    GameEngine::Terminate();
+    return bStarted;
+}
+
+}   // namespace
+
+ReplayTestGroup::ReplayTestGroup()
+    : UnitTestGroup("Input replay tests")
+{
+    AddTest( "Replays see the same states", SameStates );
+    AddTest( "Replays running out", RunningOut );
+}
+
+// Record a session, then replay it while posting different live input, which
+// should be thrown away.  Every frame's state should hash the same as when it
+// was recorded.  The same live input without the replay should not.
+UnitTest::Result ReplayTestGroup::SameStates()
+{
+    const unsigned int cuiFrames = 300;
+    Session oRecorded( cuiFrames, 1 );
+    Session oReplayed( cuiFrames, 2 );
+    Session oLive( cuiFrames, 2 );
+    bool bRecorded = Play( oRecorded, RECORD );
+    bool bReplayed = bRecorded && Play( oReplayed, REPLAY );
+    std::remove( sgc_pcRecording );
+    if( !bRecorded || !bReplayed || !Play( oLive, LIVE ) )
+    {
+        return UnitTest::Fail( "Sessions couldn't be played" );
+    }
+    if( cuiFrames != oRecorded.Hashes().size() ||
+        cuiFrames != oReplayed.Hashes().size() )
+    {
+        return UnitTest::Fail( "Sessions ended early" );
+    }
+    for( unsigned int ui = 0; ui < cuiFrames; ++ui )
+    {
+        if( oRecorded.Hashes()[ ui ] != oReplayed.Hashes()[ ui ] )
+        {
+            std::ostringstream oMessage;
+            oMessage << "Replayed state differed on frame " << ui;
+            return UnitTest::Fail( oMessage.str() );
+        }
+    }
+    if( oRecorded.Hashes() == oLive.Hashes() )
+    {
+        return UnitTest::Fail( "Different input gave the same states" );
+    }
+    return UnitTest::PASS;
+}
+
+// Replay a recording with the clock running twice as fast as when it was
+// recorded.  Once the recording runs out, time should carry on from the last
+// frame replayed at the live frame rate, and live input should take over.
+UnitTest::Result ReplayTestGroup::RunningOut()
+{
+    const unsigned int cuiRecorded = 100;
+    const unsigned int cuiLive = 50;
+    double dFrameTime = NullBackend::FrameTime();
+    Session oRecorded( cuiRecorded, 1 );
+    Session oReplayed( cuiRecorded + cuiLive, 2 );
+    bool bRecorded = Play( oRecorded, RECORD );
+    NullBackend::SetFrameTime( dFrameTime * 2 );
+    bool bReplayed = bRecorded && Play( oReplayed, REPLAY );
+    NullBackend::SetFrameTime( dFrameTime );
+    std::remove( sgc_pcRecording );
+    if( !bRecorded || !bReplayed )
+    {
+        return UnitTest::Fail( "Sessions couldn't be played" );
+    }
+    if( cuiRecorded + cuiLive != oReplayed.Hashes().size() )
+    {
+        return UnitTest::Fail( "Session ended early" );
+    }
+    for( unsigned int ui = 0; ui < cuiRecorded; ++ui )
+    {
+        if( !oReplayed.Replayed()[ ui ] ||
+            oRecorded.Times()[ ui ] != oReplayed.Times()[ ui ] )
+        {
+            return UnitTest::Fail( "Frame times didn't come from the "
+                                   "recording" );
+        }
+    }
+    bool bLiveInput = false;
+    for( unsigned int ui = cuiRecorded; ui < cuiRecorded + cuiLive; ++ui )
+    {
+        if( oReplayed.Replayed()[ ui ] )
+        {
+            return UnitTest::Fail( "Replay didn't stop" );
+        }
+        if( 1e-9 < std::abs( oReplayed.Times()[ ui ] -
+                             oReplayed.Times()[ ui - 1 ] - dFrameTime * 2 ) ||
+            1e-9 < std::abs( oReplayed.DeltaTimes()[ ui ] - dFrameTime * 2 ) )
+        {
+            std::ostringstream oMessage;
+            oMessage << "Time jumped by " << oReplayed.DeltaTimes()[ ui ]
+                     << " seconds " << ui - cuiRecorded
+                     << " frames after the replay ran out";
+            return UnitTest::Fail( oMessage.str() );
+        }
+        bLiveInput = bLiveInput || oReplayed.Changed()[ ui ];
+    }
+    if( !bLiveInput )
+    {
+        return UnitTest::Fail( "Live input didn't take over" );
+    }
+    return UnitTest::PASS;
+}
@@ -0,0 +1,28 @@
+/******************************************************************************
+ * File:               ReplayTestGroup.h
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Input recording and replay tests.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Creation.
+ ******************************************************************************/
+
+#ifndef REPLAY_TEST_GROUP__H
+#define REPLAY_TEST_GROUP__H
+
+#include "UnitTestGroup.h"
+
+class ReplayTestGroup : public UnitTestGroup
+{
+public:
+
+    ReplayTestGroup();
+
+private:
+
+    static UnitTest::Result SameStates();
+    static UnitTest::Result RunningOut();
+
+};
+
+#endif  // REPLAY_TEST_GROUP__H
@@ -0,0 +1,250 @@
+/******************************************************************************
+ * File:               SpriteBatchTestGroup.cpp
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Sprite batch packing tests, and a comparison of the
+ *                      time taken to submit sprites with and without a batch.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Creation.
+ ******************************************************************************/
+
+#include "SpriteBatchTestGroup.h"
+#include "TestTexture.h"
+#include "MyFirstEngine.h"
+#include <sstream>
+#include <vector>
+
+using namespace MyFirstEngine;
+
+namespace
+{
+
+typedef SpriteBatch::Recorder Recorder;
+
+// Step a linear congruential generator and return its high bits
+unsigned int Random( unsigned int& a_ruiSeed )
+{
+    a_ruiSeed = a_ruiSeed * 1664525u + 1013904223u;
+    return a_ruiSeed >> 8;
+}
+
+// A model-view-projection matrix and color that both identify the instance
+// they were added with, so it can be picked out after grouping
+GLTransform3D Tagged( unsigned int a_uiTag )
+{
+    GLTransform3D oMatrix = GLTransform3D::Identity();
+    oMatrix[3][0] = (GLScalar)a_uiTag;
+    return oMatrix;
+}
+Color::ColorVector TaggedColor( unsigned int a_uiTag )
+{
+    return Color::ColorVector( (Color::Channel)a_uiTag, (Color::Channel)0,
+                               (Color::Channel)0, (Color::Channel)0xFF );
+}
+
+}   // namespace
+
+SpriteBatchTestGroup::SpriteBatchTestGroup()
+    : UnitTestGroup("Sprite batch tests")
+{
+    AddTest( "Instances packed by texture", Packing );
+    AddTest( "Submitting 10,000 sprites", Benchmark );
+}
+
+// Sprites with three textures added in interleaved order should come out as
+// one frame table upload and one draw per texture, with the textures in the
+// order they were first added and each texture's sprites in the order they
+// were added.
+UnitTest::Result SpriteBatchTestGroup::Packing()
+{
+    // Texture and frame number for each sprite, in the order they're added
+    struct Added
+    {
+        unsigned int uiTexture;
+        unsigned int uiFrameNumber;
+    };
+    const Added caoAdded[] = { { 0, 0 }, { 1, 1 }, { 0, 4 },
+                               { 2, 0 }, { 1, 2 }, { 0, 2 } };
+    const unsigned int cuiAdded = sizeof( caoAdded ) / sizeof( Added );
+
+    // Expected draws, which sprites they hold, and the frame table index of
+    // each of those sprites.  The first texture's three frames come first in
+    // the table, then the second's two, then the third's whole texture.
+    const unsigned int cauiDrawCounts[] = { 3, 2, 1 };
+    const unsigned int cauiOrder[] = { 0, 2, 5, 1, 4, 3 };
+    const unsigned int cauiFrames[] = { 0, 1, 2, 4, 3, 5 };
+
+    TestTexture oA( 4, 4 );
+    TestTexture oB( 8, 8 );
+    TestTexture oC( 2, 2 );
+    Texture* const capoTextures[] = { &oA, &oB, &oC };
+    const Frame::Array oAFrames( 3 );
+    const Frame::Array oBFrames( 2 );
+    const Frame::Array oWholeTexture( 0 );
+    const Frame::Array* const capcoFrames[] =
+        { &oAFrames, &oBFrames, &oWholeTexture };
+
+    SpriteBatch oBatch;
+    oBatch.Begin();
+    for( unsigned int ui = 0; ui < cuiAdded; ++ui )
+    {
+        unsigned int uiTexture = caoAdded[ ui ].uiTexture;
+        oBatch.Add( *capoTextures[ uiTexture ], *capcoFrames[ uiTexture ],
+                    caoAdded[ ui ].uiFrameNumber, Tagged( ui ),
+                    TaggedColor( ui ) );
+    }
+    Recorder oRecorder;
+    oBatch.Flush( oRecorder );
+
+    if( 1 != oRecorder.Uploads() || 6 != oRecorder.FrameCount() )
+    {
+        return UnitTest::Fail( "Frame table not uploaded exactly once" );
+    }
+    if( 3 != oRecorder.DrawCount() || cuiAdded != oRecorder.InstanceCount() )
+    {
+        std::ostringstream oMessage;
+        oMessage << "Expected 3 draws of " << cuiAdded << " instances, got "
+                 << oRecorder.DrawCount() << " draws of "
+                 << oRecorder.InstanceCount();
+        return UnitTest::Fail( oMessage.str() );
+    }
+    unsigned int uiFirst = 0;
+    for( unsigned int ui = 0; ui < 3; ++ui )
+    {
+        const Recorder::Draw& roDraw = oRecorder.GetDraw( ui );
+        if( capoTextures[ ui ] != roDraw.poTexture ||
+            uiFirst != roDraw.uiFirst ||
+            cauiDrawCounts[ ui ] != roDraw.uiCount )
+        {
+            std::ostringstream oMessage;
+            oMessage << "Draw " << ui << " had the wrong texture or instances";
+            return UnitTest::Fail( oMessage.str() );
+        }
+        uiFirst += roDraw.uiCount;
+    }
+    for( unsigned int ui = 0; ui < cuiAdded; ++ui )
+    {
+        const SpriteBatch::Instance& roInstance = oRecorder.GetInstance( ui );
+        if( (float)cauiOrder[ ui ] != roInstance.afModelViewProjection[12] ||
+            Color::Pack( TaggedColor( cauiOrder[ ui ] ) ) !=
+                roInstance.oColor )
+        {
+            std::ostringstream oMessage;
+            oMessage << "Instance " << ui << " wasn't sprite "
+                     << cauiOrder[ ui ];
+            return UnitTest::Fail( oMessage.str() );
+        }
+        if( cauiFrames[ ui ] != roInstance.uiFrame )
+        {
+            std::ostringstream oMessage;
+            oMessage << "Instance " << ui << " used frame "
+                     << roInstance.uiFrame << " instead of "
+                     << cauiFrames[ ui ];
+            return UnitTest::Fail( oMessage.str() );
+        }
+    }
+
+    const SpriteBatch::Stats& roStats = oBatch.LastFlush();
+    if( cuiAdded != roStats.uiInstances || 3 != roStats.uiDraws ||
+        6 != roStats.uiFrames )
+    {
+        return UnitTest::Fail( "Flush stats didn't match what was submitted" );
+    }
+    if( 0 != oBatch.Size() || 0 != oBatch.FrameCount() )
+    {
+        return UnitTest::Fail( "Flushing didn't empty the batch" );
+    }
+    return UnitTest::PASS;
+}
+
+// Time drawing 10,000 sprites one at a time against adding them to a batch
+// and flushing it, both through the null backend, so what's measured is the
+// CPU cost of submitting them.  Batches don't cull, so culling is turned off
+// for the sprites drawn one at a time too.  Only the draw counts are checked;
+// the times are just reported.
+UnitTest::Result SpriteBatchTestGroup::Benchmark()
+{
+    const unsigned int cuiCount = 10000;
+    const unsigned int cuiTextures = 4;
+    const unsigned int cuiRounds = 10;
+    if( !GameEngine::Initialize() )
+    {
+        return UnitTest::Fail( "Engine didn't initialize" );
+    }
+    double dOneByOneSeconds = 0.0;
+    double dBatchedSeconds = 0.0;
+    unsigned int uiOneByOneDraws = 0;
+    SpriteBatch::Stats oLastFlush = { 0, 0, 0 };
+    {
+        std::vector< TestTexture* > oTextures;
+        for( unsigned int ui = 0; ui < cuiTextures; ++ui )
+        {
+            oTextures.push_back( new TestTexture( 32, 32 ) );
+        }
+        std::vector< Sprite* > oSprites;
+        unsigned int uiSeed = 5;
+        for( unsigned int ui = 0; ui < cuiCount; ++ui )
+        {
+            oSprites.push_back(
+                new Sprite( *oTextures[ Random( uiSeed ) % cuiTextures ],
+                            Point2D( 32.0 ),
+                            Point3D( Random( uiSeed ) % 1920 - 960.0,
+                                     Random( uiSeed ) % 1080 - 540.0,
+                                     0.0 ) ) );
+        }
+
+        SpriteBatch oBatch;
+        Culling::Disable();
+        for( unsigned int ui = 0; ui < cuiRounds; ++ui )
+        {
+            NullBackend::ResetStats();
+            double dStart = NullBackend::CPUTime();
+            for each( Sprite* poSprite in oSprites )
+            {
+                poSprite->Draw();
+            }
+            double dMiddle = NullBackend::CPUTime();
+            uiOneByOneDraws = NullBackend::CurrentFrame().uiDrawCalls;
+            oBatch.Begin();
+            for each( Sprite* poSprite in oSprites )
+            {
+                oBatch.Add( *poSprite );
+            }
+            oBatch.Flush();
+            double dEnd = NullBackend::CPUTime();
+            dOneByOneSeconds += dMiddle - dStart;
+            dBatchedSeconds += dEnd - dMiddle;
+            oLastFlush = oBatch.LastFlush();
+        }
+        Culling::Enable();
+
+        for each( Sprite* poSprite in oSprites )
+        {
+            delete poSprite;
+        }
+        for each( TestTexture* poTexture in oTextures )
+        {
+            delete poTexture;
+        }
+    }
+    NullBackend::ResetStats();
+    GameEngine::Terminate();
+
+    if( cuiCount != uiOneByOneDraws )
+    {
+        return UnitTest::Fail( "Not every sprite was drawn one at a time" );
+    }
+    if( cuiCount != oLastFlush.uiInstances ||
+        cuiTextures != oLastFlush.uiDraws )
+    {
+        std::ostringstream oMessage;
+        oMessage << "Batch made " << oLastFlush.uiDraws << " draws of "
+                 << oLastFlush.uiInstances << " sprites";
+        return UnitTest::Fail( oMessage.str() );
+    }
+    std::ostringstream oMessage;
+    oMessage << "One at a time " << dOneByOneSeconds * 1000.0 / cuiRounds
+             << " ms, batched " << dBatchedSeconds * 1000.0 / cuiRounds
+             << " ms per " << cuiCount << " sprites";
+    return UnitTest::Pass( oMessage.str() );
+}
@@ -0,0 +1,29 @@
+/******************************************************************************
+ * File:               SpriteBatchTestGroup.h
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Sprite batch packing tests, and a comparison of the
+ *                      time taken to submit sprites with and without a batch.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Creation.
+ ******************************************************************************/
+
+#ifndef SPRITE_BATCH_TEST_GROUP__H
+#define SPRITE_BATCH_TEST_GROUP__H
+
+#include "UnitTestGroup.h"
+
+class SpriteBatchTestGroup : public UnitTestGroup
+{
+public:
+
+    SpriteBatchTestGroup();
+
+private:
+
+    static UnitTest::Result Packing();
+    static UnitTest::Result Benchmark();
+
+};
+
+#endif  // SPRITE_BATCH_TEST_GROUP__H
@@ -0,0 +1,304 @@
+/******************************************************************************
+ * File:               StreamBufferTestGroup.cpp
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Stream buffer tests against a simulated GPU timeline.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Checking the room left in a region.
+ ******************************************************************************/
+
+#include "StreamBufferTestGroup.h"
+#include "MyFirstEngine.h"
+#include <cstring>
+
+using MyFirstEngine::StreamBuffer;
+
+namespace
+{
+
+typedef StreamBuffer::SimulatedBackend SimulatedGPU;
+
+// Has the GPU passed the fence placed the last time the current region was
+// used?  Frame numbers count from zero, and the simulated fences count from
+// one, so frame N's fence is fence N + 1.
+bool RegionIsFree( const SimulatedGPU& ac_roGPU, unsigned int a_uiFrame,
+                   unsigned int a_uiRegions )
+{
+    return ( a_uiFrame < a_uiRegions ||
+             ac_roGPU.Passed() >= a_uiFrame - a_uiRegions + 1 );
+}
+
+}   // namespace
+
+StreamBufferTestGroup::StreamBufferTestGroup()
+    : UnitTestGroup("Stream buffer tests")
+{
+    AddTest( "Regions used in turn", RegionsInOrder );
+    AddTest( "Waiting for the GPU", WaitingForTheGPU );
+    AddTest( "Allocations that don't fit", FullRegions );
+    AddTest( "Orphaning without persistent mapping", Orphaning );
+    AddTest( "Regions of unaligned size", UnalignedRegions );
+}
+
+UnitTest::Result StreamBufferTestGroup::RegionsInOrder()
+{
+    SimulatedGPU oGPU( true );
+    StreamBuffer oStream( 256, GL_ARRAY_BUFFER, 3, oGPU );
+    for( unsigned int ui = 0; ui < 3; ++ui )
+    {
+        oStream.BeginFrame();
+        if( ui != oStream.CurrentRegion() )
+        {
+            return UnitTest::Fail( "Regions weren't used in turn" );
+        }
+        StreamBuffer::Allocation oFirst = oStream.Allocate( 10, 1 );
+        StreamBuffer::Allocation oSecond = oStream.Allocate( 20, 16 );
+        if( nullptr == oFirst.pData || nullptr == oSecond.pData ||
+            ui * 256 != oFirst.uiOffset || ui * 256 + 16 != oSecond.uiOffset )
+        {
+            return UnitTest::Fail( "Allocations weren't aligned in the "
+                                   "frame's region" );
+        }
+        std::memset( oFirst.pData, ui + 1, 10 );
+        oStream.EndFrame();
+    }
+    if( !oStream.IsPersistent() || 0 == oStream.ID() )
+    {
+        return UnitTest::Fail( "Buffer wasn't persistently mapped" );
+    }
+    if( 1 != oGPU.Data()[0] || 2 != oGPU.Data()[256] ||
+        3 != oGPU.Data()[512] || 0 != oGPU.Uploads() )
+    {
+        return UnitTest::Fail( "Writes didn't go straight to the buffer" );
+    }
+    if( 3 != oGPU.Inserted() || 0 != oStream.GetStats().uiStalls ||
+        3 != oStream.GetStats().uiFrames )
+    {
+        return UnitTest::Fail( "Each frame didn't place one fence" );
+    }
+    return UnitTest::PASS;
+}
+
+// With three regions, the GPU can be up to two frames behind without the CPU
+// ever waiting.  Any further behind, and every frame has to wait.
+UnitTest::Result StreamBufferTestGroup::WaitingForTheGPU()
+{
+    const unsigned int cuiRegions = 3;
+    const unsigned int cuiFrames = 100;
+    SimulatedGPU oGPU( true );
+    StreamBuffer oStream( 64, GL_ARRAY_BUFFER, cuiRegions, oGPU );
+    for( unsigned int ui = 0; ui < cuiFrames; ++ui )
+    {
+        oStream.BeginFrame();
+        if( !RegionIsFree( oGPU, ui, cuiRegions ) )
+        {
+            return UnitTest::Fail( "Wrote to a region the GPU was reading" );
+        }
+        oStream.Allocate( 32 );
+        oStream.EndFrame();
+        if( oGPU.Inserted() > cuiRegions - 1 )
+        {
+            oGPU.Advance();
+        }
+    }
+    if( 0 != oStream.GetStats().uiStalls || 0 != oGPU.Waits() )
+    {
+        return UnitTest::Fail( "Waited on a GPU two frames behind" );
+    }
+
+    // The GPU stops passing fences on its own.  Being two frames behind, the
+    // first frame still finds its region free, but every frame after that
+    // has to wait.
+    oStream.ResetStats();
+    for( unsigned int ui = cuiFrames; ui < cuiFrames + 10; ++ui )
+    {
+        oStream.BeginFrame();
+        if( !RegionIsFree( oGPU, ui, cuiRegions ) )
+        {
+            return UnitTest::Fail( "Wrote to a region the GPU was reading" );
+        }
+        oStream.Allocate( 32 );
+        oStream.EndFrame();
+    }
+    if( 9 != oStream.GetStats().uiStalls || 9 != oGPU.Waits() )
+    {
+        return UnitTest::Fail( "Stalls weren't counted" );
+    }
+
+    // Once the GPU catches up, nothing has to wait
+    oGPU.Finish();
+    oStream.BeginFrame();
+    oStream.EndFrame();
+    if( 9 != oStream.GetStats().uiStalls || 9 != oGPU.Waits() ||
+        11 != oStream.GetStats().uiFrames )
+    {
+        return UnitTest::Fail( "Waited on a GPU that had caught up" );
+    }
+
+    // A new buffer starts over with no fences to wait for
+    oStream.Destroy();
+    if( 0 != oStream.ID() )
+    {
+        return UnitTest::Fail( "Destroying didn't delete the buffer" );
+    }
+    unsigned int uiWaits = oGPU.Waits();
+    for( unsigned int ui = 0; ui < cuiRegions; ++ui )
+    {
+        oStream.BeginFrame();
+        if( ui != oStream.CurrentRegion() || uiWaits != oGPU.Waits() )
+        {
+            return UnitTest::Fail( "Recreated buffer waited on old fences" );
+        }
+        oStream.EndFrame();
+    }
+    return UnitTest::PASS;
+}
+
+UnitTest::Result StreamBufferTestGroup::FullRegions()
+{
+    SimulatedGPU oGPU( true );
+    StreamBuffer oStream( 256, GL_ARRAY_BUFFER, 3, oGPU );
+
+    // Allocating starts a frame if one hasn't been started
+    if( nullptr != oStream.Allocate( 257 ).pData ||
+        1 != oStream.GetStats().uiFrames ||
+        1 != oStream.GetStats().uiFailedAllocations )
+    {
+        return UnitTest::Fail( "Allocated more than a region" );
+    }
+    if( nullptr == oStream.Allocate( 256 ).pData ||
+        nullptr != oStream.Allocate( 1 ).pData ||
+        2 != oStream.GetStats().uiFailedAllocations )
+    {
+        return UnitTest::Fail( "Allocated past the end of a full region" );
+    }
+    oStream.EndFrame();
+    oStream.BeginFrame();
+    StreamBuffer::Allocation oAllocation = oStream.Allocate( 1, 1 );
+    oAllocation = oStream.Allocate( 4, 64 );
+    if( 256 + 64 != oAllocation.uiOffset || 68 != oStream.BytesUsed() )
+    {
+        return UnitTest::Fail( "Alignment wasn't applied" );
+    }
+    oStream.EndFrame();
+    if( 68 != oStream.GetStats().uiLastFrameBytes ||
+        256 != oStream.GetStats().uiPeakFrameBytes )
+    {
+        return UnitTest::Fail( "Frame sizes weren't tracked" );
+    }
+    oStream.ResetStats();
+    if( 0 != oStream.GetStats().uiFrames ||
+        0 != oStream.GetStats().uiFailedAllocations ||
+        0 != oStream.GetStats().uiPeakFrameBytes )
+    {
+        return UnitTest::Fail( "Stats weren't reset" );
+    }
+    return UnitTest::PASS;
+}
+
+// Without persistent mapping, each frame orphans the buffer and uploads only
+// what was written, and no fences are needed
+UnitTest::Result StreamBufferTestGroup::Orphaning()
+{
+    SimulatedGPU oGPU( false );
+    StreamBuffer oStream( 128, GL_ARRAY_BUFFER, 3, oGPU );
+    oStream.BeginFrame();
+    if( oStream.IsPersistent() || 1 != oGPU.Orphans() )
+    {
+        return UnitTest::Fail( "Buffer wasn't orphaned" );
+    }
+    StreamBuffer::Allocation oFirst = oStream.Allocate( 8, 4 );
+    std::memset( oFirst.pData, 7, 8 );
+    oStream.Submit();
+    oStream.Submit();
+    StreamBuffer::Allocation oSecond = oStream.Allocate( 8, 16 );
+    std::memset( oSecond.pData, 9, 8 );
+    oStream.EndFrame();
+    if( 2 != oGPU.Uploads() || 24 != oGPU.UploadedBytes() ||
+        16 != oSecond.uiOffset )
+    {
+        return UnitTest::Fail( "Uploads didn't cover just what was written" );
+    }
+    if( 7 != oGPU.Data()[0] || 7 != oGPU.Data()[7] ||
+        9 != oGPU.Data()[16] || 9 != oGPU.Data()[23] )
+    {
+        return UnitTest::Fail( "Uploaded data didn't match" );
+    }
+    for( unsigned int ui = 0; ui < 5; ++ui )
+    {
+        oStream.BeginFrame();
+        if( 0 != oStream.CurrentRegion() )
+        {
+            return UnitTest::Fail( "Orphaned buffer used another region" );
+        }
+        oStream.EndFrame();
+    }
+    if( 6 != oGPU.Orphans() || 0 != oGPU.Inserted() ||
+        0 != oStream.GetStats().uiStalls )
+    {
+        return UnitTest::Fail( "Orphaned buffer used fences" );
+    }
+    return UnitTest::PASS;
+}
+
+// Regions after the first don't start on an aligned offset when the region
+// size isn't a multiple of the alignment, so alignment has to apply to the
+// offset in the whole buffer
+UnitTest::Result StreamBufferTestGroup::UnalignedRegions()
+{
+    const unsigned int cuiRegionSize = 1000;
+    const unsigned int cuiRegions = 3;
+    SimulatedGPU oGPU( true );
+    StreamBuffer oStream( cuiRegionSize, GL_ARRAY_BUFFER, cuiRegions, oGPU );
+    for( unsigned int ui = 0; ui < cuiRegions; ++ui )
+    {
+        unsigned int uiBase = ui * cuiRegionSize;
+        oStream.BeginFrame();
+        StreamBuffer::Allocation oFirst = oStream.Allocate( 16, 16 );
+        StreamBuffer::Allocation oSecond = oStream.Allocate( 1, 1 );
+        if( cuiRegionSize - ( oSecond.uiOffset + 1 - uiBase ) !=
+                oStream.Available( 1 ) ||
+            cuiRegionSize - ( oSecond.uiOffset + 16 - uiBase ) !=
+                oStream.Available( 16 ) )
+        {
+            return UnitTest::Fail( "Room left didn't allow for alignment" );
+        }
+        StreamBuffer::Allocation oThird = oStream.Allocate( 16, 16 );
+        if( nullptr == oFirst.pData || nullptr == oSecond.pData ||
+            nullptr == oThird.pData )
+        {
+            return UnitTest::Fail( "Allocations didn't fit" );
+        }
+        if( 0 != oFirst.uiOffset % 16 || 0 != oThird.uiOffset % 16 )
+        {
+            return UnitTest::Fail( "Offsets in the buffer weren't aligned" );
+        }
+        if( oFirst.uiOffset < uiBase || oFirst.uiOffset >= uiBase + 16 ||
+            oSecond.uiOffset != oFirst.uiOffset + 16 ||
+            oThird.uiOffset != oFirst.uiOffset + 32 )
+        {
+            return UnitTest::Fail( "Allocations weren't packed in the "
+                                   "frame's region" );
+        }
+        if( oGPU.Data() + oThird.uiOffset != oThird.pData )
+        {
+            return UnitTest::Fail( "Pointer didn't match the offset" );
+        }
+
+        // The rest of the region is still available, but nothing past it
+        unsigned int uiRest = uiBase + cuiRegionSize - oThird.uiOffset - 16;
+        if( uiRest != oStream.Available( 1 ) ||
+            uiRest != oStream.Available( 16 ) )
+        {
+            return UnitTest::Fail( "Room left in the region was wrong" );
+        }
+        if( nullptr != oStream.Allocate( uiRest + 1, 1 ).pData ||
+            nullptr == oStream.Allocate( uiRest, 1 ).pData ||
+            cuiRegionSize != oStream.BytesUsed() )
+        {
+            return UnitTest::Fail( "Region's end wasn't respected" );
+        }
+        oStream.EndFrame();
+    }
+    return UnitTest::PASS;
+}
@@ -0,0 +1,31 @@
+/******************************************************************************
+ * File:               StreamBufferTestGroup.h
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Stream buffer tests against a simulated GPU timeline.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Added a test for regions of unaligned size.
+ ******************************************************************************/
+
+#ifndef STREAM_BUFFER_TEST_GROUP__H
+#define STREAM_BUFFER_TEST_GROUP__H
+
+#include "UnitTestGroup.h"
+
+class StreamBufferTestGroup : public UnitTestGroup
+{
+public:
+
+    StreamBufferTestGroup();
+
+private:
+
+    static UnitTest::Result RegionsInOrder();
+    static UnitTest::Result WaitingForTheGPU();
+    static UnitTest::Result FullRegions();
+    static UnitTest::Result Orphaning();
+    static UnitTest::Result UnalignedRegions();
+
+};
+
+#endif  // STREAM_BUFFER_TEST_GROUP__H
@@ -0,0 +1,43 @@
+/******************************************************************************
+ * File:               TestTexture.h
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Texture filled in memory, so tests don't need image
+ *                      files.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Creation.
+ ******************************************************************************/
+
+#ifndef TEST_TEXTURE__H
+#define TEST_TEXTURE__H
+
+#include "MyFirstEngine.h"
+
+// A texture with no file, whose cache starts out filled with a single color.
+// Loading it uploads the cache, and since there's no file to reload from,
+// TextureResidency never throws the cache away.
+class TestTexture : public MyFirstEngine::Texture
+{
+public:
+
+    TestTexture( int a_iWidth, int a_iHeight, Color::Channel a_ucAlpha = 0xFF )
+        : Texture( "" )
+    {
+        m_oSize = IntPoint2D( a_iWidth, a_iHeight );
+        m_oFrame.framePixels = m_oSize;
+        m_oFrame.slicePixels = m_oSize;
+        unsigned int uiBytes = a_iWidth * a_iHeight * 4;
+        m_paucData = new unsigned char[ uiBytes ];
+        for( unsigned int ui = 0; ui < uiBytes; ui += 4 )
+        {
+            m_paucData[ ui ] = 0xFF;
+            m_paucData[ ui + 1 ] = 0xFF;
+            m_paucData[ ui + 2 ] = 0xFF;
+            m_paucData[ ui + 3 ] = a_ucAlpha;
+        }
+    }
+    virtual ~TestTexture() {}
+
+};  // class TestTexture
+
+#endif  // TEST_TEXTURE__H
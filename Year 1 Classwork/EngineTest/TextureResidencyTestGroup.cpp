@@ -0,0 +1,319 @@
+/******************************************************************************
+ * File:               TextureResidencyTestGroup.cpp
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Texture residency tests, loading and evicting textures
+ *                      under GPU and cache budgets on the null backend.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Creation.
+ ******************************************************************************/
+
+#include "TextureResidencyTestGroup.h"
+#include "TestTexture.h"
+#include "MyFirstEngine.h"
+#include <sstream>
+#include <string>
+
+using namespace MyFirstEngine;
+
+namespace
+{
+
+// Side length of every texture in these tests
+const int sgc_iSize = 16;
+
+// A texture with a file to reload from, so TextureResidency is free to throw
+// its cache away.  The cache starts out filled like a TestTexture's, and the
+// file is never actually read, as long as the texture isn't reloaded after
+// losing both its cache and its GL object.
+class FileTexture : public TestTexture
+{
+public:
+
+    FileTexture( const char* ac_pcFile ) : TestTexture( sgc_iSize, sgc_iSize )
+    {
+        m_oFile = ac_pcFile;
+    }
+    virtual ~FileTexture() {}
+
+    bool IsCached() const { return nullptr != m_paucData; }
+
+};
+
+// Budgets for a single test, put back to no limit when the test is done so
+// the next test starts from the default
+class Budgets
+{
+public:
+
+    Budgets( unsigned long long a_ulGPU, unsigned long long a_ulCache )
+    {
+        TextureResidency::SetGPUBudget( a_ulGPU );
+        TextureResidency::SetCacheBudget( a_ulCache );
+        TextureResidency::ResetStats();
+        NullBackend::ResetStats();
+    }
+    ~Budgets()
+    {
+        TextureResidency::SetGPUBudget( 0 );
+        TextureResidency::SetCacheBudget( 0 );
+        TextureResidency::ResetStats();
+    }
+
+};
+
+// Which textures have GL objects, as a letter for each texture that does and
+// a dash for each that doesn't, e.g. "A-C"
+std::string Loaded( Texture* const* a_capoTextures, unsigned int a_uiCount )
+{
+    std::string oLoaded;
+    for( unsigned int ui = 0; ui < a_uiCount; ++ui )
+    {
+        oLoaded += ( a_capoTextures[ ui ]->IsValid()
+                     ? (char)( 'A' + ui ) : '-' );
+    }
+    return oLoaded;
+}
+
+// Which textures have caches, in the same form
+std::string Cached( FileTexture* const* a_capoTextures,
+                    unsigned int a_uiCount )
+{
+    std::string oCached;
+    for( unsigned int ui = 0; ui < a_uiCount; ++ui )
+    {
+        oCached += ( a_capoTextures[ ui ]->IsCached()
+                     ? (char)( 'A' + ui ) : '-' );
+    }
+    return oCached;
+}
+
+// Failure message for textures loaded or cached other than expected
+std::string Mismatch( const char* ac_pcWhat, const std::string& ac_roExpected,
+                      const std::string& ac_roActual )
+{
+    std::ostringstream oMessage;
+    oMessage << ac_pcWhat << " textures were " << ac_roActual
+             << " instead of " << ac_roExpected;
+    return oMessage.str();
+}
+
+}   // namespace
+
+TextureResidencyTestGroup::TextureResidencyTestGroup()
+    : UnitTestGroup("Texture residency tests")
+{
+    AddTest( "Least recently used texture evicted", GPUEviction );
+    AddTest( "Evicted texture reloaded from cache", Reload );
+    AddTest( "Pinned textures never evicted", Pinning );
+    AddTest( "Least recently used cache evicted", CacheEviction );
+}
+
+// With room for two textures, making three current should destroy the first
+// one's GL object, leaving two textures' worth loaded and one eviction
+// counted.
+UnitTest::Result TextureResidencyTestGroup::GPUEviction()
+{
+    if( !GameEngine::Initialize() )
+    {
+        return UnitTest::Fail( "Engine didn't initialize" );
+    }
+    std::string oFailure;
+    {
+        const unsigned int cuiBefore = NullBackend::Resident().uiTextures;
+        TestTexture oA( sgc_iSize, sgc_iSize );
+        TestTexture oB( sgc_iSize, sgc_iSize );
+        TestTexture oC( sgc_iSize, sgc_iSize );
+        Texture* const capoTextures[] = { &oA, &oB, &oC };
+        const unsigned long long culBudget =
+            2 * TextureResidency::GPUBytes( oA );
+        Budgets oBudgets( culBudget, 0 );
+        for( unsigned int ui = 0; ui < 3; ++ui )
+        {
+            capoTextures[ ui ]->MakeCurrent();
+        }
+        std::string oLoaded = Loaded( capoTextures, 3 );
+        if( "-BC" != oLoaded )
+        {
+            oFailure = Mismatch( "Loaded", "-BC", oLoaded );
+        }
+        else if( culBudget != TextureResidency::GPUBytes() ||
+                 1 != TextureResidency::GPUStats().ulEvictions )
+        {
+            oFailure = "GPU bytes or evictions counted wrong";
+        }
+        else if( cuiBefore + 2 != NullBackend::Resident().uiTextures )
+        {
+            oFailure = "Evicted texture's GL object wasn't deleted";
+        }
+    }
+    GameEngine::Terminate();
+    return ( oFailure.empty() ? UnitTest::PASS : UnitTest::Fail( oFailure ) );
+}
+
+// Making an evicted texture current again should upload it from its cache,
+// which counts as a GPU miss and a cache hit, and evict the texture that's
+// now least recently used.  Making a texture that's still loaded current
+// shouldn't upload anything.
+UnitTest::Result TextureResidencyTestGroup::Reload()
+{
+    if( !GameEngine::Initialize() )
+    {
+        return UnitTest::Fail( "Engine didn't initialize" );
+    }
+    std::string oFailure;
+    {
+        TestTexture oA( sgc_iSize, sgc_iSize );
+        TestTexture oB( sgc_iSize, sgc_iSize );
+        TestTexture oC( sgc_iSize, sgc_iSize );
+        Texture* const capoTextures[] = { &oA, &oB, &oC };
+        Budgets oBudgets( 2 * TextureResidency::GPUBytes( oA ), 0 );
+        for( unsigned int ui = 0; ui < 3; ++ui )
+        {
+            capoTextures[ ui ]->MakeCurrent();
+        }
+        TextureResidency::ResetStats();
+        NullBackend::ResetStats();
+
+        oA.MakeCurrent();
+        std::string oLoaded = Loaded( capoTextures, 3 );
+        const TextureResidency::Stats& roGPU = TextureResidency::GPUStats();
+        if( "A-C" != oLoaded )
+        {
+            oFailure = Mismatch( "Loaded", "A-C", oLoaded );
+        }
+        else if( 1 != NullBackend::CurrentFrame().uiTextureUploads )
+        {
+            oFailure = "Evicted texture wasn't uploaded exactly once";
+        }
+        else if( 1 != roGPU.ulMisses || 1 != roGPU.ulEvictions ||
+                 1 != TextureResidency::CacheStats().ulHits )
+        {
+            oFailure = "Reload not counted as a GPU miss and a cache hit";
+        }
+        else
+        {
+            oC.MakeCurrent();
+            if( 1 != NullBackend::CurrentFrame().uiTextureUploads ||
+                1 != roGPU.ulHits )
+            {
+                oFailure = "Loaded texture was uploaded again";
+            }
+        }
+    }
+    GameEngine::Terminate();
+    return ( oFailure.empty() ? UnitTest::PASS : UnitTest::Fail( oFailure ) );
+}
+
+// With the first two textures pinned, loading a third should go over budget
+// without evicting anything, since the third is the most recently used.
+// Unpinning the second should evict the third, and reloading the third should
+// evict the second, with the first, least recently used, kept all along.
+UnitTest::Result TextureResidencyTestGroup::Pinning()
+{
+    if( !GameEngine::Initialize() )
+    {
+        return UnitTest::Fail( "Engine didn't initialize" );
+    }
+    std::string oFailure;
+    {
+        TestTexture oA( sgc_iSize, sgc_iSize );
+        TestTexture oB( sgc_iSize, sgc_iSize );
+        TestTexture oC( sgc_iSize, sgc_iSize );
+        Texture* const capoTextures[] = { &oA, &oB, &oC };
+        const unsigned long long culTexture = TextureResidency::GPUBytes( oA );
+        Budgets oBudgets( 2 * culTexture, 0 );
+        oA.Pin();
+        oB.Pin();
+        for( unsigned int ui = 0; ui < 3; ++ui )
+        {
+            capoTextures[ ui ]->MakeCurrent();
+        }
+        std::string oPinned = Loaded( capoTextures, 3 );
+        unsigned long long ulPinnedBytes = TextureResidency::GPUBytes();
+        oB.Pin( false );
+        std::string oUnpinned = Loaded( capoTextures, 3 );
+        oC.MakeCurrent();
+        std::string oReloaded = Loaded( capoTextures, 3 );
+        if( "ABC" != oPinned || 3 * culTexture != ulPinnedBytes )
+        {
+            oFailure = Mismatch( "Pinned and loaded", "ABC", oPinned );
+        }
+        else if( "AB-" != oUnpinned )
+        {
+            oFailure = Mismatch( "Unpinned and loaded", "AB-", oUnpinned );
+        }
+        else if( "A-C" != oReloaded )
+        {
+            oFailure = Mismatch( "Reloaded and loaded", "A-C", oReloaded );
+        }
+        else if( 2 != TextureResidency::GPUStats().ulEvictions )
+        {
+            oFailure = "Evictions counted wrong";
+        }
+        oA.Pin( false );
+        oB.Pin( false );
+    }
+    GameEngine::Terminate();
+    return ( oFailure.empty() ? UnitTest::PASS : UnitTest::Fail( oFailure ) );
+}
+
+// With room for two caches, loading three textures that have files should
+// throw away the first one's cache but keep its GL object.  Loading a texture
+// with no file should keep its cache and evict the next least recently used
+// one instead.  Making the first texture current again is a GPU hit, so
+// losing its cache doesn't cost an upload.
+UnitTest::Result TextureResidencyTestGroup::CacheEviction()
+{
+    if( !GameEngine::Initialize() )
+    {
+        return UnitTest::Fail( "Engine didn't initialize" );
+    }
+    std::string oFailure;
+    {
+        FileTexture oA( "resources/textures/ResidencyA.png" );
+        FileTexture oB( "resources/textures/ResidencyB.png" );
+        FileTexture oC( "resources/textures/ResidencyC.png" );
+        TestTexture oNoFile( sgc_iSize, sgc_iSize );
+        FileTexture* const capoTextures[] = { &oA, &oB, &oC };
+        Texture* const capoLoaded[] = { &oA, &oB, &oC };
+        const unsigned long long culBudget =
+            2 * TextureResidency::CacheBytes( oA );
+        Budgets oBudgets( 0, culBudget );
+        for( unsigned int ui = 0; ui < 3; ++ui )
+        {
+            capoTextures[ ui ]->MakeCurrent();
+        }
+        std::string oFirstCached = Cached( capoTextures, 3 );
+        std::string oLoaded = Loaded( capoLoaded, 3 );
+        oNoFile.MakeCurrent();
+        std::string oThenCached = Cached( capoTextures, 3 );
+        NullBackend::ResetStats();
+        oA.MakeCurrent();
+        if( "-BC" != oFirstCached )
+        {
+            oFailure = Mismatch( "Cached", "-BC", oFirstCached );
+        }
+        else if( "ABC" != oLoaded )
+        {
+            oFailure = Mismatch( "Loaded", "ABC", oLoaded );
+        }
+        else if( "--C" != oThenCached )
+        {
+            oFailure = Mismatch( "Cached with no-file texture", "--C",
+                                 oThenCached );
+        }
+        else if( culBudget != TextureResidency::CacheBytes() ||
+                 2 != TextureResidency::CacheStats().ulEvictions )
+        {
+            oFailure = "Cache bytes or evictions counted wrong";
+        }
+        else if( !oA.IsValid() ||
+                 0 != NullBackend::CurrentFrame().uiTextureUploads )
+        {
+            oFailure = "Texture with an evicted cache was uploaded again";
+        }
+    }
+    GameEngine::Terminate();
+    return ( oFailure.empty() ? UnitTest::PASS : UnitTest::Fail( oFailure ) );
+}
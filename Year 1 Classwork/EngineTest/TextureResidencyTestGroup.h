@@ -0,0 +1,31 @@
+/******************************************************************************
+ * File:               TextureResidencyTestGroup.h
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Texture residency tests, loading and evicting textures
+ *                      under GPU and cache budgets on the null backend.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Creation.
+ ******************************************************************************/
+
+#ifndef TEXTURE_RESIDENCY_TEST_GROUP__H
+#define TEXTURE_RESIDENCY_TEST_GROUP__H
+
+#include "UnitTestGroup.h"
+
+class TextureResidencyTestGroup : public UnitTestGroup
+{
+public:
+
+    TextureResidencyTestGroup();
+
+private:
+
+    static UnitTest::Result GPUEviction();
+    static UnitTest::Result Reload();
+    static UnitTest::Result Pinning();
+    static UnitTest::Result CacheEviction();
+
+};
+
+#endif  // TEXTURE_RESIDENCY_TEST_GROUP__H
@@ -0,0 +1,59 @@
+/******************************************************************************
+ * File:               main.cpp
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Runs a list of engine unit test groups on the null
+ *                      backend, so no window or GPU is needed.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Added quadtree benchmarks.
+ ******************************************************************************/
+
+#include "UnitTester.h"
+#include "NullBackendTestGroup.h"
+#include "RenderQueueTestGroup.h"
+#include "StreamBufferTestGroup.h"
+#include "AnimatorTestGroup.h"
+#include "CullingBenchmarkTestGroup.h"
+#include "QuadtreeBenchmarkTestGroup.h"
+#include "PrecisionTestGroup.h"
+#include "SpriteBatchTestGroup.h"
+#include "ProfilerTestGroup.h"
+#include "ReplayTestGroup.h"
+#include "InputTestGroup.h"
+#include "ProgramBinaryCacheTestGroup.h"
+#include "HTMLCharactersTestGroup.h"
+#include "TextureResidencyTestGroup.h"
+#include "MyFirstEngine.h"
+#include <conio.h>
+#include <iostream>
+#include <string>
+
+using MyFirstEngine::NullBackend;
+
+int main(int argc, char* argv[])
+{
+    // set up
+    NullBackend::Install();
+    UnitTester oTester;
+    oTester.AddTestGroup( NullBackendTestGroup() );
+    oTester.AddTestGroup( RenderQueueTestGroup() );
+    oTester.AddTestGroup( StreamBufferTestGroup() );
+    oTester.AddTestGroup( AnimatorTestGroup() );
+    oTester.AddTestGroup( CullingBenchmarkTestGroup() );
+    oTester.AddTestGroup( QuadtreeBenchmarkTestGroup() );
+    oTester.AddTestGroup( PrecisionTestGroup() );
+    oTester.AddTestGroup( SpriteBatchTestGroup() );
+    oTester.AddTestGroup( ProfilerTestGroup() );
+    oTester.AddTestGroup( ReplayTestGroup() );
+    oTester.AddTestGroup( InputTestGroup() );
+    oTester.AddTestGroup( ProgramBinaryCacheTestGroup() );
+    oTester.AddTestGroup( HTMLCharactersTestGroup() );
+    oTester.AddTestGroup( TextureResidencyTestGroup() );
+
+    // run
+    oTester( std::cout );
+    NullBackend::Uninstall();
+    std::cout << std::endl << std::endl << "Press any key to exit...";
+    _getch();
+    return 0;
+}
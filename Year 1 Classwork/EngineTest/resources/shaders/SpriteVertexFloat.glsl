@@ -0,0 +1,25 @@
+/******************************************************************************
+ * File:               SpriteVertexFloat.glsl
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Single-precision vertex shader for a Sprite.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Creation.
+ ******************************************************************************/
+
+#version 410
+
+uniform mat4 u_m4ModelViewProjection;
+uniform mat3 u_m3TexTransform;
+
+in vec2 i_v2Position;
+in vec2 i_v2TexCoordinate;
+
+out vec2 v_v2TexCoordinate;
+
+void main()
+{
+    gl_Position = u_m4ModelViewProjection * vec4( i_v2Position, 0.0, 1.0 );
+    vec3 v3TexCoordinate = u_m3TexTransform * vec3( i_v2TexCoordinate, 1.0 );
+    v_v2TexCoordinate = v3TexCoordinate.xy;
+}
@@ -0,0 +1,68 @@
+/******************************************************************************
+ * File:               BoundsCheck.h
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Configurable index checking for element access operators.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Creation.
+ ******************************************************************************/
+
+#ifndef BOUNDS_CHECK__H
+#define BOUNDS_CHECK__H
+
+#include <cassert>
+#include <sstream>
+#include <stdexcept>
+
+// How operator[] checks indices on matrices, vectors, and dynamic arrays.
+// Named At() functions always check and throw, whatever this is set to.
+//   MATH_LIBRARY_BOUNDS_CHECK_THROW  - throw std::out_of_range with the index
+//                                      and extent (default for debug builds)
+//   MATH_LIBRARY_BOUNDS_CHECK_ASSERT - assert, so development builds still
+//                                      catch mistakes without exception
+//                                      handling in every inner loop
+//   MATH_LIBRARY_BOUNDS_CHECK_NONE   - no check at all (default otherwise)
+// Set MATH_LIBRARY_BOUNDS_CHECK to one of these in the project's preprocessor
+// definitions to override the default.  Since the access operators are inline,
+// the setting of the code doing the accessing is what counts.
+#define MATH_LIBRARY_BOUNDS_CHECK_NONE 0
+#define MATH_LIBRARY_BOUNDS_CHECK_ASSERT 1
+#define MATH_LIBRARY_BOUNDS_CHECK_THROW 2
+
+#ifndef MATH_LIBRARY_BOUNDS_CHECK
+#ifdef _DEBUG
+#define MATH_LIBRARY_BOUNDS_CHECK MATH_LIBRARY_BOUNDS_CHECK_THROW
+#else
+#define MATH_LIBRARY_BOUNDS_CHECK MATH_LIBRARY_BOUNDS_CHECK_NONE
+#endif
+#endif
+
+#if MATH_LIBRARY_BOUNDS_CHECK == MATH_LIBRARY_BOUNDS_CHECK_THROW
+#define MATH_LIBRARY_CHECK_INDEX( ac_pcWhat, a_uiIndex, a_uiExtent ) \
+    ( (a_uiIndex) < (a_uiExtent) ? (void)0 : \
+      Utility::ThrowOutOfRange( ac_pcWhat, a_uiIndex, a_uiExtent ) )
+#elif MATH_LIBRARY_BOUNDS_CHECK == MATH_LIBRARY_BOUNDS_CHECK_ASSERT
+#define MATH_LIBRARY_CHECK_INDEX( ac_pcWhat, a_uiIndex, a_uiExtent ) \
+    assert( (a_uiIndex) < (a_uiExtent) && ac_pcWhat )
+#else
+#define MATH_LIBRARY_CHECK_INDEX( ac_pcWhat, a_uiIndex, a_uiExtent ) \
+    ( (void)0 )
+#endif
+
+namespace Utility
+{
+
+// Throw an out_of_range exception saying which index was out of what range
+inline void ThrowOutOfRange( const char* ac_pcWhat,
+                             unsigned int a_uiIndex,
+                             unsigned int a_uiExtent )
+{
+    std::ostringstream oMessage;
+    oMessage << "Cannot access " << ac_pcWhat << " " << a_uiIndex
+             << " of " << a_uiExtent;
+    throw std::out_of_range( oMessage.str() );
+}
+
+}   // namespace Utility
+
+#endif  // BOUNDS_CHECK__H
@@ -3,8 +3,8 @@
  * Author:             Elizabeth Lowry
  * Date Created:       December 11, 2013
  * Description:        Vector for representing RGBA colors.
- * Last Modified:      February 27, 2014
- * Last Modification:  Adding functions.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Non-virtual destructor.
  ******************************************************************************/
 
 #ifndef COLOR_VECTOR__H
@@ -26,7 +26,7 @@ public:
     typedef BaseType::BaseType RootType;
 
     // destructor
-    virtual ~ColorVector();
+    ~ColorVector();
 
     // Constructors that forward to base class constructors
     ColorVector();
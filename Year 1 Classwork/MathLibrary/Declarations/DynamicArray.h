@@ -3,13 +3,14 @@
  * Author:             Elizabeth Lowry
  * Date Created:       March 11, 2014
  * Description:        Class representing an array that can be resized.
- * Last Modified:      March 20, 2014
- * Last Modification:  Moving implementations to separate inl file.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Configurable bounds checking for operator[].
  ******************************************************************************/
 
 #ifndef DYNAMIC_ARRAY__H
 #define DYNAMIC_ARRAY__H
 
+#include "BoundsCheck.h"
 #include <stdexcept>
 
 namespace Utility
@@ -40,9 +41,12 @@ public:
     // assign size of 1
     DynamicArray& operator=( const T& ac_rData );
 
-    // access array elements
+    // access array elements - At() always checks the index, operator[] only
+    // checks as configured in BoundsCheck.h
     T& operator[]( unsigned int a_uiIndex );
     const T& operator[]( unsigned int a_uiIndex ) const;
+    T& At( unsigned int a_uiIndex );
+    const T& At( unsigned int a_uiIndex ) const;
 
     // manage array size
     unsigned int Size() const { return m_uiSize; }
@@ -0,0 +1,97 @@
+/******************************************************************************
+ * File:               EventQueue.h
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Lock-free queue for passing events between two threads.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Creation.
+ ******************************************************************************/
+
+#ifndef EVENT_QUEUE__H
+#define EVENT_QUEUE__H
+
+#include <vector>
+
+// Keeps reads and writes of queued events on the right side of the position
+// updates.  On x86, the processor doesn't reorder stores with other stores or
+// loads with other loads, so only the compiler needs stopping.
+#ifdef _MSC_VER
+#include <intrin.h>
+#define EVENT_QUEUE__BARRIER() _ReadWriteBarrier()
+#else
+#define EVENT_QUEUE__BARRIER() __sync_synchronize()
+#endif
+
+namespace Utility
+{
+
+// Fixed-size first-in, first-out queue with one producer and one consumer.
+// One thread may push events while another pops them, without either ever
+// waiting on a lock, and events come out in exactly the order they went in:
+//
+//   Utility::EventQueue< InputEvent > oQueue( 256 );
+//   oQueue.Push( oEvent );             // producer, e.g. an input callback
+//   ...
+//   InputEvent oNext;
+//   while( oQueue.Pop( oNext ) ) { Apply( oNext ); }   // consumer, each frame
+//
+// Nothing is allocated after construction.  If the producer gets more than
+// Capacity() events ahead of the consumer, further pushes fail and are
+// counted as dropped rather than overwriting events not yet popped.
+//
+// The positions are only ever written by one side each, so all they need is
+// for the event to be written before the position that publishes it, and read
+// after the position that says it's there.  Clear, Capacity, and the
+// destructor aren't safe to call while the other side is using the queue.
+template< typename T >
+class EventQueue
+{
+public:
+
+    // Capacity is rounded up to a power of two
+    EventQueue( unsigned int a_uiCapacity = DEFAULT_CAPACITY );
+
+    // Producer side - add an event, returning false if the queue is full
+    bool Push( const T& ac_roEvent );
+
+    // Consumer side - take the oldest event, returning false if there are
+    // none, or look at it without taking it
+    bool Pop( T& a_roEvent );
+    bool Peek( T& a_roEvent ) const;
+
+    // Consumer side - throw away every queued event
+    void Clear();
+
+    // Events currently queued.  Either side may ask, but the answer may be
+    // out of date by the time it's used.
+    unsigned int Size() const { return m_uiPushed - m_uiPopped; }
+    bool IsEmpty() const { return m_uiPushed == m_uiPopped; }
+
+    // How many pushes have failed since construction
+    unsigned int Dropped() const { return m_uiDropped; }
+
+    unsigned int Capacity() const { return m_uiMask + 1; }
+
+    static const unsigned int DEFAULT_CAPACITY = 1024;
+
+private:
+
+    std::vector< T > m_oEvents;
+    unsigned int m_uiMask;  // capacity - 1
+
+    // Total pushes and pops, which wrap around together.  Kept on separate
+    // cache lines so the two threads don't keep taking the line from each
+    // other.
+    char m_acPadding[64];
+    volatile unsigned int m_uiPushed;
+    unsigned int m_uiDropped;
+    char m_acMorePadding[64];
+    volatile unsigned int m_uiPopped;
+
+};  // class EventQueue
+
+}   // namespace Utility
+
+#include "../Implementations/EventQueue.inl"
+
+#endif  // EVENT_QUEUE__H
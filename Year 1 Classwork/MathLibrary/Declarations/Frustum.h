@@ -0,0 +1,138 @@
+/******************************************************************************
+ * File:               Frustum.h
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Bounding boxes and the view frustum tests used for
+ *                      culling objects that can't be seen.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Creation.
+ ******************************************************************************/
+
+#ifndef FRUSTUM__H
+#define FRUSTUM__H
+
+#include "Transform.h"
+#include "ImExportMacro.h"
+
+namespace Space
+{
+
+// Axis-aligned box.  The coordinates are plain arrays instead of Points, which
+// carry reference members, so large arrays of boxes stay compact.  There are
+// no constructors, so a box can be brace-initialized:
+//
+//   const Space::BoundingBox UNIT_SQUARE = { { -0.5, -0.5, 0.0 },
+//                                            { 0.5, 0.5, 0.0 } };
+//
+// Boxes are expected to have no minimum greater than the matching maximum.
+// Flat boxes, like the one above, are fine.
+struct IMEXPORT_CLASS BoundingBox
+{
+    double adMin[3];
+    double adMax[3];
+
+    // Smallest box containing this one after an affine transformation, for
+    // row vectors with the translation in the last row.  The last column of a
+    // full transformation is ignored.
+    BoundingBox Transformed( const Transform& ac_roTransform ) const;
+    BoundingBox Transformed( const AffineTransform& ac_roTransform ) const;
+
+    // Smallest box containing both this box and the other
+    BoundingBox Merged( const BoundingBox& ac_roBox ) const;
+
+    // Does this box contain the other one entirely?
+    bool Contains( const BoundingBox& ac_roBox ) const;
+
+};
+
+// The six planes bounding the volume a view-projection transformation maps
+// into OpenGL's clip space, -w <= x, y, z <= w.  A box is only outside if it's
+// entirely on the wrong side of at least one plane, so the tests are
+// conservative - a box near a corner of the frustum may pass without actually
+// being visible, but nothing visible is ever rejected.  Points exactly on a
+// plane count as inside.
+//
+// Each test takes a mask of the planes to check.  A parallel projection of a
+// flat scene only needs SIDE_PLANES, the view rectangle.  The mask can also be
+// passed down a hierarchy:
+//
+//   unsigned int uiPlanes = Space::Frustum::ALL_PLANES;
+//   if( Space::Frustum::OUTSIDE !=
+//       oFrustum.TestAndNarrow( oParentBox, uiPlanes ) )
+//   {
+//       // uiPlanes now only holds the planes oParentBox crosses, so boxes
+//       // inside oParentBox don't need to be tested against the others
+//       ...
+//   }
+//
+class IMEXPORT_CLASS Frustum
+{
+public:
+
+    // Plane bits for masks
+    enum Planes
+    {
+        LEFT_PLANE = 0x01,
+        RIGHT_PLANE = 0x02,
+        BOTTOM_PLANE = 0x04,
+        TOP_PLANE = 0x08,
+        NEAR_PLANE = 0x10,
+        FAR_PLANE = 0x20,
+
+        SIDE_PLANES = 0x0F,
+        ALL_PLANES = 0x3F
+    };
+    static const unsigned int PLANE_COUNT = 6;
+
+    // Results of testing a box
+    enum Containment
+    {
+        OUTSIDE = 0,
+        INTERSECTING,
+        INSIDE
+    };
+
+    // Default frustum contains everything
+    Frustum();
+
+    // Frustum for the given view-projection transformation, for row vectors.
+    // Planes of a model-view-projection transformation are in model space, so
+    // boxes in model space can be tested without transforming them first.
+    explicit Frustum( const Transform& ac_roViewProjection );
+
+    // Plane coefficients a, b, c, d, where a point is inside if
+    // a*x + b*y + c*z + d >= 0.  Planes aren't normalized.
+    const double* GetPlane( unsigned int a_uiIndex ) const
+    { return m_aadPlanes[ a_uiIndex ]; }
+
+    // Test a box against the planes in the mask
+    Containment Test( const BoundingBox& ac_roBox,
+                      unsigned int a_uiPlanes = ALL_PLANES ) const;
+
+    // Test a box against the planes in the mask, then replace the mask with
+    // only the planes the box crosses, or zero if the box is outside
+    Containment TestAndNarrow( const BoundingBox& ac_roBox,
+                               unsigned int& a_ruiPlanes ) const;
+
+    // Test a whole array of boxes at once, stored as separate arrays for each
+    // coordinate.  The indices of the boxes that aren't outside are written to
+    // the results array, in order, and the number of them is returned.
+    unsigned int Cull( const double* ac_padMinX, const double* ac_padMinY,
+                       const double* ac_padMinZ, const double* ac_padMaxX,
+                       const double* ac_padMaxY, const double* ac_padMaxZ,
+                       unsigned int a_uiCount, unsigned int* a_pauiResults,
+                       unsigned int a_uiPlanes = ALL_PLANES ) const;
+
+private:
+
+    double m_aadPlanes[ PLANE_COUNT ][4];
+
+};  // class Frustum
+
+}   // namespace Space
+
+#ifdef INLINE_IMPLEMENTATION
+#include "../Implementations/Frustum.inl"
+#endif
+
+#endif  // FRUSTUM__H
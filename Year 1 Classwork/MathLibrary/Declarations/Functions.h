@@ -3,8 +3,8 @@
  * Author:             Elizabeth Lowry
  * Date Created:       December 2, 2013
  * Description:        Various library functions not contained in a class.
- * Last Modified:      March 5, 2014
- * Last Modification:  Debugging.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Separate Round overloads for integers.
  ******************************************************************************/
 
 #ifndef FUNCTIONS__H
@@ -68,6 +68,12 @@ template< typename T >
 T Interpolate( const T& ac_rPointA,
                const T& ac_rPointB,
                float a_fProgress = 0.5f );
+template< typename T >
+void Interpolate( const T* a_pacPointsA,
+                  const T* a_pacPointsB,
+                  float a_fProgress,
+                  T* a_paResults,
+                  unsigned int a_uiCount );
 
 // Call fmod for floating-point types and operator% for everything else
 template< typename T, typename U >
@@ -89,14 +95,29 @@ typename std::enable_if< std::is_floating_point< T >::value ||
                          std::is_floating_point< U >::value, T& >::type
     ModuloAssign( T& a_rDividend, const U& ac_rDivisor );
 
-// Return the power of two closest to the given value
+// Index of the highest set bit of a non-zero value
+unsigned int HighestBit( unsigned long long a_ullValue );
+
+// Return the power of two closest to the given value, rounding down on ties.
+// Values less than or equal to zero return one.
 template< typename T >
 typename std::enable_if< std::is_scalar< T >::value, T >::type
     NearestPowerOfTwo( const T& ac_rValue );
+template< typename T >
+void NearestPowerOfTwo( const T* a_pacValues,
+                        T* a_paResults,
+                        unsigned int a_uiCount );
 
+// Round to the nearest whole number, rounding down on ties
 template< typename T >
-typename std::enable_if< std::is_scalar< T >::value, T >::type
+typename std::enable_if< std::is_scalar< T >::value &&
+                         !std::is_floating_point< T >::value, T >::type
     Round( const T& ac_rValue );
+template< typename T >
+typename std::enable_if< std::is_floating_point< T >::value, T >::type
+    Round( const T& ac_rValue );
+template< typename T >
+void Round( const T* a_pacValues, T* a_paResults, unsigned int a_uiCount );
 
 // Scroll a value into the given bounds, [ ac_rMin, ac_rMax ).
 template< typename T >
@@ -108,6 +129,13 @@ typename std::enable_if< std::is_scalar< T >::value, T >::type
 template< typename T >
 typename std::enable_if< std::is_scalar< T >::value, T >::type
     ScrollRadians( const T& ac_rValue );
+template< typename T >
+void ScrollRadians( const T* a_pacValues,
+                    T* a_paResults,
+                    unsigned int a_uiCount );
+
+// The array versions of the functions above apply the function to each of
+// a_uiCount elements.  The results array may be the same as an input array.
 
 // Complex conjugate (if you ever want to use a matrix full of complex numbers,
 // you'll need to define an explicit specialization for this function).
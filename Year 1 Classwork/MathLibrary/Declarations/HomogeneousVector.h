@@ -8,8 +8,8 @@
  *                      transformed vector = original vector * transform matrix,
  *                      instead of transform matrix * original vector as it
  *                      would be if column vectors were used.
- * Last Modified:      February 10, 2014
- * Last Modification:  Templatizing PointVector.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Non-virtual destructor.
  ******************************************************************************/
 
 #ifndef HOMOGENEOUS_VECTOR__H
@@ -35,7 +35,7 @@ public:
     typedef PointVector< double > PointType;
 
     // destructor
-    virtual ~HomogeneousVector();
+    ~HomogeneousVector();
 
     // Constructors that forward to base class constructors
     HomogeneousVector();
@@ -133,7 +133,7 @@ public:
     typedef PointVector< double > PointType;
 
     // destructor
-    virtual ~HomogeneousVector();
+    ~HomogeneousVector();
 
     // Constructors that forward to base class constructors
     HomogeneousVector();
@@ -3,15 +3,16 @@
  * Author:             Elizabeth Lowry
  * Date Created:       November 18, 2013
  * Description:        Base class for matrices of numeric type.
- * Last Modified:      February 24, 2014
- * Last Modification:  MostDerivedAddress moved to Utility namespace.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Removed the MostDerivedAddress base class and virtual
+ *                      destructor.  Configurable bounds checking for operator[].
  ******************************************************************************/
 
 #ifndef MATRIX__H
 #define MATRIX__H
 
+#include "BoundsCheck.h"
 #include "Functions.h"
-#include "MostDerivedAddress.h"
 #include <iostream>
 #include <type_traits>  // for enable_if and is_scalar
 
@@ -22,9 +23,16 @@ namespace Math
 template< typename T, unsigned int N, bool t_bIsRow/* = true*/ >
 class Vector;
 
-// Represents a matrix of values of a set type with set dimensions.
+// Forward declare lazy expression type
+template< typename E, typename T, unsigned int M, unsigned int N >
+class MatrixExpression;
+
+// Represents a matrix of values of a set type with set dimensions.  There are
+// no virtual functions, so a matrix is nothing but its elements and an array of
+// matrices or vectors can be handed straight to OpenGL.  Wrap a matrix type in
+// Utility::Polymorphic if you need Address() or virtual destruction.
 template< typename T, unsigned int M, unsigned int N = M >
-class Matrix : public Utility::MostDerivedAddress
+class Matrix
 {
 public:
 
@@ -37,7 +45,7 @@ public:
     typedef Matrix< T, N, M > TransposeType;
 
     // destructor
-    virtual ~Matrix();
+    ~Matrix();
     
     // Construct/assign from a differently-sized/typed matrix
     template< typename U, unsigned int P, unsigned int Q >
@@ -52,8 +60,9 @@ public:
     Matrix( const T& ac_rFill = DefaultValue< T >() );
     Matrix& operator=( const T& ac_rFill );
 
-    // Fill with one value along the identity diagonal and another elsewhere
-    Matrix( const T& ac_rIdentityFill, const T& ac_rFill );
+    // Fill with the first value off the identity diagonal and the second along
+    // it, so Matrix( 0, 1 ) is an identity matrix
+    Matrix( const T& ac_rFill, const T& ac_rIdentityFill );
 
     // Construct/assign with parameter data
     Matrix( const T (&ac_raData)[ M*N ] );
@@ -71,6 +80,12 @@ public:
     Matrix( const RowVectorType* const (&ac_racpoRows)[ M ] );
     Matrix& operator=( const RowVectorType* const (&ac_racpoRows)[ M ] );
 
+    // Construct/assign by evaluating a lazy expression (see MatrixExpression.h)
+    template< typename E >
+    explicit Matrix( const MatrixExpression< E, T, M, N >& ac_roExpression );
+    template< typename E >
+    Matrix& operator=( const MatrixExpression< E, T, M, N >& ac_roExpression );
+
     // Assign to arrays
     template< typename U, unsigned int P >
     inline typename ArrayReference< U, P >::type
@@ -92,7 +107,8 @@ public:
     bool operator==( const Matrix& ac_roMatrix ) const;
     bool operator!=( const Matrix& ac_roMatrix ) const;
     
-    // Array access
+    // Array access - At() always checks the indices, operator[] only checks as
+    // configured in BoundsCheck.h
     T (&operator[]( unsigned int a_uiRow ))[ N ];
     const T (&operator[]( unsigned int a_uiRow ) const)[ N ];
     T& At( unsigned int a_uiRow, unsigned int a_uiColumn );
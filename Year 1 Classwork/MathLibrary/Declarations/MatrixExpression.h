@@ -0,0 +1,234 @@
+/******************************************************************************
+ * File:               MatrixExpression.h
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Lazily-evaluated matrix arithmetic.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Checking for aliasing by address, now that matrices
+ *                      aren't polymorphic.
+ ******************************************************************************/
+
+#ifndef MATRIX_EXPRESSION__H
+#define MATRIX_EXPRESSION__H
+
+#include "Matrix.h"
+#include <type_traits>  // for enable_if and is_scalar
+
+namespace Math
+{
+
+//
+// Normal matrix arithmetic creates a full Matrix object for every intermediate
+// result, so something like A * B * C * D + E builds and destroys four
+// temporary matrices, vtables and all.  Wrapping the first operand in Lazy()
+// instead builds a tree of lightweight expression objects that is only
+// evaluated when assigned to a matrix:
+//
+//   oModel = Lazy( oBefore ) * oScale * oRotate * oTranslate * oAfter;
+//
+// Sums, differences, and scalar products are computed an element at a time,
+// straight into the target.  Each matrix product is computed exactly once,
+// into plain storage inside the expression.  If the target matrix is also one
+// of the operands, the whole result is computed before any of it is written.
+//
+// Expressions hold references to the matrices they were built from, so they
+// should be evaluated in the same statement that builds them.
+//
+
+// Base for all expressions.  E is the derived expression type, which must
+// provide these functions:
+//   T At( unsigned int a_uiRow, unsigned int a_uiColumn ) const;
+//   bool Aliases( const void* ac_pAddress ) const;
+// so that evaluating an expression takes no virtual function calls.
+template< typename E, typename T, unsigned int M, unsigned int N >
+class MatrixExpression
+{
+public:
+
+    typedef T ValueType;
+    static const unsigned int ROWS = M;
+    static const unsigned int COLUMNS = N;
+
+    // The expression as its actual type
+    const E& Derived() const;
+
+    // Write the result into a matrix
+    void EvaluateInto( Matrix< T, M, N >& a_roMatrix ) const;
+    Matrix< T, M, N > Evaluate() const;
+
+};
+
+// An operand that is a matrix
+template< typename T, unsigned int M, unsigned int N >
+class MatrixReference
+    : public MatrixExpression< MatrixReference< T, M, N >, T, M, N >
+{
+public:
+
+    MatrixReference( const Matrix< T, M, N >& ac_roMatrix );
+    T At( unsigned int a_uiRow, unsigned int a_uiColumn ) const;
+    bool Aliases( const void* ac_pAddress ) const;
+
+private:
+
+    const Matrix< T, M, N >& m_roMatrix;
+
+};
+
+// Sum of two expressions of the same size
+template< typename L, typename R >
+class MatrixSum
+    : public MatrixExpression< MatrixSum< L, R >, typename L::ValueType,
+                               L::ROWS, L::COLUMNS >
+{
+public:
+
+    typedef typename L::ValueType T;
+
+    MatrixSum( const L& ac_roLeft, const R& ac_roRight );
+    T At( unsigned int a_uiRow, unsigned int a_uiColumn ) const;
+    bool Aliases( const void* ac_pAddress ) const;
+
+private:
+
+    L m_oLeft;
+    R m_oRight;
+
+};
+
+// Difference of two expressions of the same size
+template< typename L, typename R >
+class MatrixDifference
+    : public MatrixExpression< MatrixDifference< L, R >, typename L::ValueType,
+                               L::ROWS, L::COLUMNS >
+{
+public:
+
+    typedef typename L::ValueType T;
+
+    MatrixDifference( const L& ac_roLeft, const R& ac_roRight );
+    T At( unsigned int a_uiRow, unsigned int a_uiColumn ) const;
+    bool Aliases( const void* ac_pAddress ) const;
+
+private:
+
+    L m_oLeft;
+    R m_oRight;
+
+};
+
+// Expression multiplied by a scalar.  As with Matrix::operator*=, the result
+// has the same element type as the expression.
+template< typename E, typename U >
+class MatrixScaled
+    : public MatrixExpression< MatrixScaled< E, U >, typename E::ValueType,
+                               E::ROWS, E::COLUMNS >
+{
+public:
+
+    typedef typename E::ValueType T;
+
+    MatrixScaled( const E& ac_roExpression, const U& ac_rScalar );
+    T At( unsigned int a_uiRow, unsigned int a_uiColumn ) const;
+    bool Aliases( const void* ac_pAddress ) const;
+
+private:
+
+    E m_oExpression;
+    U m_Scalar;
+
+};
+
+// Matrix product of two expressions.  The product is computed the first time
+// an element is requested and kept for the rest.
+template< typename L, typename R >
+class MatrixProduct
+    : public MatrixExpression< MatrixProduct< L, R >, typename L::ValueType,
+                               L::ROWS, R::COLUMNS >
+{
+public:
+
+    typedef typename L::ValueType T;
+
+    MatrixProduct( const L& ac_roLeft, const R& ac_roRight );
+    MatrixProduct( const MatrixProduct& ac_roProduct );
+    T At( unsigned int a_uiRow, unsigned int a_uiColumn ) const;
+    bool Aliases( const void* ac_pAddress ) const;
+
+private:
+
+    // Fill in the stored product
+    void Compute() const;
+
+    L m_oLeft;
+    R m_oRight;
+    mutable bool m_bComputed;
+    mutable T m_aaResult[ L::ROWS ][ R::COLUMNS ];
+
+};
+
+// Start a lazy expression with a matrix
+template< typename T, unsigned int M, unsigned int N >
+MatrixReference< T, M, N > Lazy( const Matrix< T, M, N >& ac_roMatrix );
+
+// Addition
+template< typename L, typename R, typename T, unsigned int M, unsigned int N >
+MatrixSum< L, R >
+    operator+( const MatrixExpression< L, T, M, N >& ac_roLeft,
+               const MatrixExpression< R, T, M, N >& ac_roRight );
+template< typename L, typename T, unsigned int M, unsigned int N >
+MatrixSum< L, MatrixReference< T, M, N > >
+    operator+( const MatrixExpression< L, T, M, N >& ac_roLeft,
+               const Matrix< T, M, N >& ac_roRight );
+template< typename R, typename T, unsigned int M, unsigned int N >
+MatrixSum< MatrixReference< T, M, N >, R >
+    operator+( const Matrix< T, M, N >& ac_roLeft,
+               const MatrixExpression< R, T, M, N >& ac_roRight );
+
+// Subtraction
+template< typename L, typename R, typename T, unsigned int M, unsigned int N >
+MatrixDifference< L, R >
+    operator-( const MatrixExpression< L, T, M, N >& ac_roLeft,
+               const MatrixExpression< R, T, M, N >& ac_roRight );
+template< typename L, typename T, unsigned int M, unsigned int N >
+MatrixDifference< L, MatrixReference< T, M, N > >
+    operator-( const MatrixExpression< L, T, M, N >& ac_roLeft,
+               const Matrix< T, M, N >& ac_roRight );
+template< typename R, typename T, unsigned int M, unsigned int N >
+MatrixDifference< MatrixReference< T, M, N >, R >
+    operator-( const Matrix< T, M, N >& ac_roLeft,
+               const MatrixExpression< R, T, M, N >& ac_roRight );
+
+// Scalar multiplication
+template< typename E, typename T, unsigned int M, unsigned int N, typename U >
+typename std::enable_if< std::is_scalar< U >::value, MatrixScaled< E, U > >::type
+    operator*( const MatrixExpression< E, T, M, N >& ac_roExpression,
+               const U& ac_rScalar );
+template< typename U, typename E, typename T, unsigned int M, unsigned int N >
+typename std::enable_if< std::is_scalar< U >::value, MatrixScaled< E, U > >::type
+    operator*( const U& ac_rScalar,
+               const MatrixExpression< E, T, M, N >& ac_roExpression );
+
+// Matrix multiplication
+template< typename L, typename R, typename T,
+          unsigned int M, unsigned int N, unsigned int P >
+MatrixProduct< L, R >
+    operator*( const MatrixExpression< L, T, M, N >& ac_roLeft,
+               const MatrixExpression< R, T, N, P >& ac_roRight );
+template< typename L, typename T,
+          unsigned int M, unsigned int N, unsigned int P >
+MatrixProduct< L, MatrixReference< T, N, P > >
+    operator*( const MatrixExpression< L, T, M, N >& ac_roLeft,
+               const Matrix< T, N, P >& ac_roRight );
+template< typename R, typename T,
+          unsigned int M, unsigned int N, unsigned int P >
+MatrixProduct< MatrixReference< T, M, N >, R >
+    operator*( const Matrix< T, M, N >& ac_roLeft,
+               const MatrixExpression< R, T, N, P >& ac_roRight );
+
+}   // namespace Math
+
+// Always include template function implementations with this header
+#include "../Implementations/MatrixExpression.inl"
+
+#endif  // MATRIX_EXPRESSION__H
@@ -0,0 +1,103 @@
+/******************************************************************************
+ * File:               PackedColor.h
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Four-byte RGBA colors for large arrays, like per-vertex
+ *                      colors, with conversions to and from float colors.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Creation.
+ ******************************************************************************/
+
+#ifndef PACKED_COLOR__H
+#define PACKED_COLOR__H
+
+#include "ColorVector.h"
+#include "Hex.h"
+#include "ImExportMacro.h"
+
+namespace Color
+{
+
+// An RGBA color in four bytes.  Unlike Hex, the channels are always in red,
+// green, blue, alpha order in memory whatever the system's endianness, so an
+// array of these can be handed straight to OpenGL as GL_RGBA/GL_UNSIGNED_BYTE.
+// There are no constructors, so constants made with the PACKED_COLOR macro are
+// initialized at compile time:
+//
+//   const Color::PackedColor HALF_RED = PACKED_COLOR( 0x7FFF0000 );
+//
+struct IMEXPORT_CLASS PackedColor
+{
+    Channel r;
+    Channel g;
+    Channel b;
+    Channel a;
+
+    // Convert to and from 0xAARRGGBB hex values
+    static PackedColor FromHex( FourChannelInt a_uiHex );
+    FourChannelInt ToHex() const;
+
+    // Convert from float channel values, clamping and rounding the same way
+    // Hex does
+    static PackedColor FromFloats( float a_fRed, float a_fGreen, float a_fBlue,
+                                   float a_fAlpha = 1.0f );
+
+    // Compare all four channels
+    bool operator==( const PackedColor& ac_roColor ) const;
+    bool operator!=( const PackedColor& ac_roColor ) const;
+
+    // Multiply or divide red, green, and blue by alpha.  Unpremultiplying a
+    // fully transparent color gives transparent black.
+    PackedColor Premultiplied() const;
+    PackedColor Unpremultiplied() const;
+
+};
+
+// Convert single colors to and from color vectors
+IMEXPORT PackedColor Pack( const ColorVector& ac_roColor );
+IMEXPORT ColorVector Unpack( const PackedColor& ac_roColor );
+
+// Convert arrays of colors to and from floats in r, g, b, a order.  Packing
+// clamps to [0, 1] and rounds the same way Hex does.
+IMEXPORT void Pack( const float* ac_pafColors,
+                    PackedColor* a_paoResults,
+                    unsigned int a_uiCount );
+IMEXPORT void Unpack( const PackedColor* ac_paoColors,
+                      float* a_pafResults,
+                      unsigned int a_uiCount );
+
+// Convert between sRGB-encoded and linear channel values in [0, 1]
+IMEXPORT float SRGBToLinear( float a_fValue );
+IMEXPORT float LinearToSRGB( float a_fValue );
+
+// Convert arrays of sRGB-encoded packed colors to and from linear floats in
+// r, g, b, a order.  Alpha is always linear, so it isn't converted.
+IMEXPORT void PackSRGB( const float* ac_pafLinearColors,
+                        PackedColor* a_paoResults,
+                        unsigned int a_uiCount );
+IMEXPORT void UnpackSRGB( const PackedColor* ac_paoColors,
+                          float* a_pafLinearResults,
+                          unsigned int a_uiCount );
+
+// Multiply or divide arrays of colors by their alpha values
+IMEXPORT void Premultiply( const PackedColor* ac_paoColors,
+                           PackedColor* a_paoResults,
+                           unsigned int a_uiCount );
+IMEXPORT void Unpremultiply( const PackedColor* ac_paoColors,
+                             PackedColor* a_paoResults,
+                             unsigned int a_uiCount );
+
+}   // namespace Color
+
+// Compile-time packed color from a 0xAARRGGBB hex value
+#define PACKED_COLOR( a_uiHex ) \
+    { (Color::Channel)( ( (a_uiHex) >> 16 ) & 0xFF ), \
+      (Color::Channel)( ( (a_uiHex) >> 8 ) & 0xFF ), \
+      (Color::Channel)( (a_uiHex) & 0xFF ), \
+      (Color::Channel)( ( (a_uiHex) >> 24 ) & 0xFF ) }
+
+#ifdef INLINE_IMPLEMENTATION
+#include "../Implementations/PackedColor.inl"
+#endif
+
+#endif  // PACKED_COLOR__H
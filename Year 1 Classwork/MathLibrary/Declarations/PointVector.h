@@ -8,8 +8,8 @@
  *                      transformed point = original point * transform matrix,
  *                      instead of transform matrix * original point as it
  *                      would be if column vectors were used.
- * Last Modified:      February 12, 2014
- * Last Modification:  Refactoring.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Non-virtual destructor.
  ******************************************************************************/
 
 #ifndef POINT_VECTOR__H
@@ -37,7 +37,7 @@ public:
     typedef BaseType::BaseType RootType;
 
     // destructor
-    virtual ~PointVector();
+    ~PointVector();
 
     // Constructors that forward to base class constructors
     PointVector();
@@ -104,7 +104,7 @@ public:
     typedef BaseType::BaseType RootType;
 
     // destructor
-    virtual ~PointVector();
+    ~PointVector();
 
     // Constructors that forward to base class constructors
     PointVector();
@@ -0,0 +1,59 @@
+/******************************************************************************
+ * File:               Polymorphic.h
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Wrapper that adds a virtual destructor and Address() to
+ *                      a non-polymorphic type, such as a matrix.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Creation.
+ ******************************************************************************/
+
+#ifndef POLYMORPHIC__H
+#define POLYMORPHIC__H
+
+#include "MostDerivedAddress.h"
+
+namespace Utility
+{
+
+// Matrices and vectors don't have a vtable, so that arrays of them are just
+// arrays of numbers.  If you do need to delete one through a base pointer or
+// compare most-derived addresses, use this instead:
+//
+//   Utility::Polymorphic< Transform3D > oTransform( Transform3D::Identity() );
+//
+// Only construction with up to three arguments is forwarded.
+template< typename T >
+class Polymorphic : public T, public MostDerivedAddress
+{
+public:
+
+    typedef T ValueType;
+
+    Polymorphic() {}
+    Polymorphic( const T& ac_roValue ) : T( ac_roValue ) {}
+    template< typename A >
+    Polymorphic( const A& ac_roA ) : T( ac_roA ) {}
+    template< typename A, typename B >
+    Polymorphic( const A& ac_roA, const B& ac_roB ) : T( ac_roA, ac_roB ) {}
+    template< typename A, typename B, typename C >
+    Polymorphic( const A& ac_roA, const B& ac_roB, const C& ac_roC )
+        : T( ac_roA, ac_roB, ac_roC ) {}
+
+    virtual ~Polymorphic() {}
+
+    Polymorphic& operator=( const T& ac_roValue )
+    {
+        T::operator=( ac_roValue );
+        return *this;
+    }
+
+    // The wrapped value
+    T& Value() { return *this; }
+    const T& Value() const { return *this; }
+
+};
+
+}   // namespace Utility
+
+#endif  // POLYMORPHIC__H
@@ -0,0 +1,253 @@
+/******************************************************************************
+ * File:               Quadtree.h
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Loose quadtree for finding 2D objects by location.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Creation.
+ ******************************************************************************/
+
+#ifndef QUADTREE__H
+#define QUADTREE__H
+
+#include <vector>
+
+namespace Plane
+{
+
+// Loose quadtree of axis-aligned rectangles, each with a value of type T
+// attached.  Each node covers a square cell, but holds any rectangle whose
+// center is in the cell and whose width and height are no larger than the
+// cell, so its contents can stick out of the cell by half its size on every
+// side.  That means a rectangle's node depends only on its center and size,
+// and a moving object only changes nodes when it crosses a cell border.
+//
+// Objects are referred to by the handle Insert returns.  Handles stay the same
+// while the object is in the tree, but once it's removed the handle may be
+// given to another object.  Nodes and objects are kept in pools, so once
+// they've grown large enough (or Reserve has made them so), updates don't
+// allocate any memory:
+//
+//   Plane::Quadtree< Enemy* > oTree( 0.0, 0.0, 4096.0, 4096.0 );
+//   unsigned int uiHandle = oTree.Insert( poEnemy, dMinX, dMinY,
+//                                         dMaxX, dMaxY );
+//   ...
+//   oTree.Update( uiHandle, dMinX, dMinY, dMaxX, dMaxY );
+//   oTree.Rebalance( 64 );
+//   oTree.QueryCircle( dX, dY, dRadius, oNearbyHandles );
+//
+// Nodes are only split once they hold more than SPLIT_COUNT objects, and only
+// merged back once their whole subtree holds no more than MERGE_COUNT.  Rather
+// than reshaping the tree whenever an object moves, nodes that need it are
+// queued, and Rebalance works through as many of them as it's given time for.
+// Queries give the right answer whether or not the tree is balanced; balance
+// only affects how quickly.
+//
+// Objects centered outside the world rectangle are kept in the root node,
+// which is always searched.  Rectangles touching at an edge or corner count
+// as overlapping.
+template< typename T >
+class Quadtree
+{
+public:
+
+    // Handle that never refers to an object
+    static const unsigned int INVALID = 0xFFFFFFFF;
+
+    // Nodes are split when they hold more than this many objects...
+    static const unsigned int SPLIT_COUNT = 8;
+
+    // ...and merged when their subtree holds no more than this many
+    static const unsigned int MERGE_COUNT = 4;
+
+    // Deepest the tree is allowed to grow
+    static const unsigned int MAX_DEPTH = 16;
+
+    // Tree covering the given world rectangle, which is expanded into a square
+    // if it isn't one already
+    Quadtree( double a_dMinX, double a_dMinY, double a_dMaxX, double a_dMaxY,
+              unsigned int a_uiMaxDepth = 8 );
+
+    // Allocate room ahead of time
+    void Reserve( unsigned int a_uiObjects, unsigned int a_uiNodes = 0 );
+
+    // Remove all objects
+    void Clear();
+
+    // Add an object and return its handle
+    unsigned int Insert( const T& ac_rValue,
+                         double a_dMinX, double a_dMinY,
+                         double a_dMaxX, double a_dMaxY );
+
+    // Add a number of objects at once, writing their handles to the given
+    // array
+    void Insert( unsigned int a_uiCount, const T* ac_paValues,
+                 const double* ac_padMinX, const double* ac_padMinY,
+                 const double* ac_padMaxX, const double* ac_padMaxY,
+                 unsigned int* a_pauiHandles );
+
+    // Move an object
+    void Update( unsigned int a_uiHandle,
+                 double a_dMinX, double a_dMinY,
+                 double a_dMaxX, double a_dMaxY );
+
+    // Move a number of objects at once
+    void Update( unsigned int a_uiCount, const unsigned int* ac_pauiHandles,
+                 const double* ac_padMinX, const double* ac_padMinY,
+                 const double* ac_padMaxX, const double* ac_padMaxY );
+
+    // Remove an object
+    void Remove( unsigned int a_uiHandle );
+
+    // Remove a number of objects at once
+    void Remove( unsigned int a_uiCount, const unsigned int* ac_pauiHandles );
+
+    // Split or merge up to the given number of queued nodes, or all of them
+    // by default, and return how many are still queued
+    unsigned int Rebalance( unsigned int a_uiBudget = INVALID );
+
+    // Add the handles of the objects whose rectangles overlap the given
+    // rectangle to the end of the results
+    void QueryRectangle( double a_dMinX, double a_dMinY,
+                         double a_dMaxX, double a_dMaxY,
+                         std::vector< unsigned int >& a_roResults ) const;
+
+    // Add the handles of the objects whose rectangles overlap the given circle
+    // to the end of the results
+    void QueryCircle( double a_dCenterX, double a_dCenterY, double a_dRadius,
+                      std::vector< unsigned int >& a_roResults ) const;
+
+    // Add the handles of the objects whose rectangles are hit by the ray from
+    // the given origin in the given direction, before it has gone the given
+    // multiple of the direction, to the end of the results.  The direction
+    // doesn't need to be normalized.
+    void QueryRay( double a_dOriginX, double a_dOriginY,
+                   double a_dDirectionX, double a_dDirectionY,
+                   double a_dMaxDistance,
+                   std::vector< unsigned int >& a_roResults ) const;
+
+    // Access an object's value and rectangle
+    T& Value( unsigned int a_uiHandle );
+    const T& Value( unsigned int a_uiHandle ) const;
+    void GetBounds( unsigned int a_uiHandle,
+                    double& a_rdMinX, double& a_rdMinY,
+                    double& a_rdMaxX, double& a_rdMaxY ) const;
+
+    // Is the handle for an object currently in the tree?
+    bool Contains( unsigned int a_uiHandle ) const;
+
+    // Number of objects, nodes in use, and nodes waiting for Rebalance
+    unsigned int Count() const { return m_uiCount; }
+    unsigned int NodeCount() const { return m_uiNodeCount; }
+    unsigned int QueuedCount() const
+    { return (unsigned int)m_oQueue.size() - m_uiQueueStart; }
+
+private:
+
+    struct Node
+    {
+        double dCenterX, dCenterY;
+        double dHalfSize;       // half the width of the cell
+        unsigned int uiParent;
+        unsigned int uiFirstChild;  // children are four consecutive nodes
+        unsigned int uiFirstObject;
+        unsigned int uiObjects;     // objects in this node
+        unsigned int uiTotal;       // objects in this node and its children
+        unsigned int uiDepth;
+        bool bQueued;
+    };
+
+    struct Object
+    {
+        double adMin[2];
+        double adMax[2];
+        T oValue;
+        unsigned int uiNode;    // INVALID if this slot is free
+        unsigned int uiPrevious;
+        unsigned int uiNext;    // next free slot, if this slot is free
+        unsigned int uiDepth;   // deepest node that could hold the object
+        unsigned int uiCellX, uiCellY;  // center's cell at the deepest level
+        unsigned int uiNodeDepth;   // copied from the node, so most updates
+        bool bNodeIsLeaf;           // don't need to look at the node at all
+    };
+
+    // Find the deepest level whose cells could hold the object, or zero if
+    // its center is outside the world, and the cell its center is in at the
+    // deepest level the tree allows.  Nodes are chosen from these integer
+    // cells rather than by comparing coordinates, so an object always goes to
+    // the same node from the same rectangle.
+    void Locate( Object& a_roObject ) const;
+
+    // Which of a node's children holds the given cell, counting from zero
+    unsigned int Quadrant( const Node& ac_roNode,
+                           const Object& ac_roObject ) const;
+
+    // Deepest existing node that could hold the object
+    unsigned int FindNode( const Object& ac_roObject ) const;
+
+    // Add an object to or remove it from a node's list of objects, without
+    // updating the counts of the nodes above
+    void Attach( unsigned int a_uiObject, unsigned int a_uiNode );
+    void Detach( unsigned int a_uiObject );
+
+    // Add, remove, or move an object, updating the counts of the nodes above
+    // and queueing any that need rebalancing
+    void Link( unsigned int a_uiObject, unsigned int a_uiNode );
+    void Unlink( unsigned int a_uiObject );
+    void Move( unsigned int a_uiObject, unsigned int a_uiNode );
+
+    // Helpers for the above - take an object out of a node's total, noting
+    // the node if it can now be merged, and queue a node if it can be split
+    unsigned int Uncount( unsigned int a_uiNode, unsigned int a_uiMerge );
+    void CheckSplit( unsigned int a_uiNode );
+
+    // Add a node to the rebalancing queue
+    void Enqueue( unsigned int a_uiNode );
+
+    // Give a node children and move down the objects that fit in them
+    void Split( unsigned int a_uiNode );
+
+    // Move all of a node's descendants' objects into it and free its children
+    void Merge( unsigned int a_uiNode );
+    void Collect( unsigned int a_uiNode, unsigned int a_uiTarget );
+
+    // Get a block of four child nodes from the pool or return it
+    unsigned int AllocateChildren( unsigned int a_uiParent );
+    void FreeChildren( unsigned int a_uiFirstChild );
+
+    // Tests for each kind of query, defined in the inl
+    struct RectangleTest;
+    struct CircleTest;
+    struct RayTest;
+
+    // Search the nodes whose loose bounds pass the test, testing every object
+    // in them
+    template< typename Test >
+    void Query( const Test& ac_roTest,
+                std::vector< unsigned int >& a_roResults ) const;
+
+    // World cell and depth limit, and the number of deepest-level cells per
+    // unit length
+    double m_dMinX, m_dMinY, m_dSize, m_dCellsPerUnit;
+    unsigned int m_uiMaxDepth;
+
+    // Pools and free lists
+    std::vector< Node > m_oNodes;
+    std::vector< Object > m_oObjects;
+    unsigned int m_uiFreeChildren;  // first node of first free block of four
+    unsigned int m_uiFreeObject;
+
+    // Nodes waiting for Rebalance
+    std::vector< unsigned int > m_oQueue;
+    unsigned int m_uiQueueStart;
+
+    unsigned int m_uiCount;
+    unsigned int m_uiNodeCount;
+
+};  // class Quadtree
+
+}   // namespace Plane
+
+#include "../Implementations/Quadtree.inl"
+
+#endif  // QUADTREE__H
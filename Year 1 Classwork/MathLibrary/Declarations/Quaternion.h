@@ -6,8 +6,8 @@
  *                      For a rotation of A radians about a normalized axis
  *                      {{Bx,By,Bz}}, the resulting quaternion {{w,x,y,z}} would
  *                      be {{cos(A/2),sin(A/2)Bx,sin(A/2)By,sin(A/2)Bz}}.
- * Last Modified:      March 5, 2014
- * Last Modification:  Debugging.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Non-virtual destructor.
  ******************************************************************************/
 
 #ifndef QUATERNION__H
@@ -36,7 +36,7 @@ public:
                 const Point3D& ac_roUp = Point3D::Zero() );
 
     // Destructor
-    virtual ~Quaternion();
+    ~Quaternion();
 
     // Assignment
     Quaternion& operator=( const Quaternion& ac_roQuaternion );
@@ -106,9 +106,14 @@ public:
     // Keep the quaternion Normalized
     Quaternion& Normalize();
 
-    // Spherical linear interpolation
+    // Dot product, treating both quaternions as 4D vectors
+    double Dot( const Quaternion& ac_roQuaternion ) const;
+
+    // Spherical linear interpolation, always going the shorter way around.
+    // For rotations too close together for the trigonometry to be accurate,
+    // this falls back to normalized linear interpolation.
     Quaternion Slerped( const Quaternion& ac_roQuaternion,
-                        double a_dProgress = 0.5f ) const;
+                        double a_dProgress = 0.5 ) const;
     Quaternion& Slerp( const Quaternion& ac_roQuaternion,
                        double a_dProgress = 0.5 );
     Quaternion Slerped( const Quaternion& ac_roQuaternion,
@@ -118,6 +123,59 @@ public:
                        double a_dRadiansPerSecond, double a_dSeconds,
                        bool a_bClamp = true );
 
+    // Normalized linear interpolation - cheaper than slerp and close to it for
+    // small angles, but it speeds up towards the middle of large ones
+    Quaternion Nlerped( const Quaternion& ac_roQuaternion,
+                        double a_dProgress = 0.5 ) const;
+    Quaternion& Nlerp( const Quaternion& ac_roQuaternion,
+                       double a_dProgress = 0.5 );
+
+    // Approximate slerp - nlerp with the progress adjusted to keep the speed
+    // nearly constant.  Within FastSlerpError() radians of a true slerp.
+    Quaternion FastSlerped( const Quaternion& ac_roQuaternion,
+                            double a_dProgress = 0.5 ) const;
+    Quaternion& FastSlerp( const Quaternion& ac_roQuaternion,
+                           double a_dProgress = 0.5 );
+
+    // Interpolate between two arrays of quaternions, writing a_uiCount results
+    // into the result array, which may be the same as either input array
+    static void Slerp( const Quaternion* ac_paoFrom,
+                       const Quaternion* ac_paoTo,
+                       double a_dProgress,
+                       Quaternion* a_paoResult,
+                       unsigned int a_uiCount );
+    static void Nlerp( const Quaternion* ac_paoFrom,
+                       const Quaternion* ac_paoTo,
+                       double a_dProgress,
+                       Quaternion* a_paoResult,
+                       unsigned int a_uiCount );
+    static void FastSlerp( const Quaternion* ac_paoFrom,
+                           const Quaternion* ac_paoTo,
+                           double a_dProgress,
+                           Quaternion* a_paoResult,
+                           unsigned int a_uiCount );
+
+    // Same as above, for quaternions packed as four doubles each, in {w,x,y,z}
+    // order, which is much friendlier to the cache for large arrays
+    static void Slerp( const double* ac_padFrom,
+                       const double* ac_padTo,
+                       double a_dProgress,
+                       double* a_padResult,
+                       unsigned int a_uiCount );
+    static void Nlerp( const double* ac_padFrom,
+                       const double* ac_padTo,
+                       double a_dProgress,
+                       double* a_padResult,
+                       unsigned int a_uiCount );
+    static void FastSlerp( const double* ac_padFrom,
+                           const double* ac_padTo,
+                           double a_dProgress,
+                           double* a_padResult,
+                           unsigned int a_uiCount );
+
+    // Largest difference, in radians of rotation, between FastSlerp and Slerp
+    static double FastSlerpError();
+
     // Turn into transform
     Transform3D MakeTransform() const;
     void MakeTransform( Transform3D& a_roTransform ) const;
@@ -135,6 +193,22 @@ protected:
     typedef Math::Vector< double, 4 > BaseType;
     typedef BaseType::BaseType RootType;
 
+    // Ways to interpolate
+    enum Interpolation
+    {
+        SPHERICAL,
+        NORMALIZED,
+        APPROXIMATE
+    };
+
+    // Interpolate between two quaternions given as four doubles each, writing
+    // the result to a third - which may be either of the first two
+    static void Interpolate( const double* ac_padFrom,
+                             const double* ac_padTo,
+                             double a_dProgress,
+                             double* a_padResult,
+                             Interpolation a_eInterpolation );
+
     // Construct with specific values
     Quaternion( double a_dW, double a_dX, double a_dY, double a_dZ );
 
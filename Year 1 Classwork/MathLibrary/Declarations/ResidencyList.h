@@ -0,0 +1,116 @@
+/******************************************************************************
+ * File:               ResidencyList.h
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Least-recently-used list of loaded resources that
+ *                      says what to unload to stay within a memory budget.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Creation.
+ ******************************************************************************/
+
+#ifndef RESIDENCY_LIST__H
+#define RESIDENCY_LIST__H
+
+#include <list>
+#include <unordered_map>
+
+namespace Utility
+{
+
+// Keeps track of which resources are loaded (resident), how many bytes each
+// takes up, and the order they were last used in.  The list doesn't load or
+// unload anything itself - the owner tells it whenever a resource is used,
+// and once the resident total goes over budget, asks it which resource to
+// unload next:
+//
+//   Utility::ResidencyList< Texture* > oList( 64 * 1024 * 1024 );
+//   if( !oList.Use( poTexture, uiBytes ) ) { ... just loaded ... }
+//   Texture* poEvicted = nullptr;
+//   while( oList.NextEviction( poEvicted ) ) { poEvicted->Unload(); }
+//
+// Use and Remove take constant time, as does NextEviction unless the least
+// recently used resources are pinned, since pinned resources are kept on a
+// list of their own.  The most recently used unpinned resource is never
+// evicted, so whatever was just loaded stays loaded even if it's bigger than
+// the whole budget.
+template< typename T >
+class ResidencyList
+{
+public:
+
+    // How well the budget is working out
+    struct Stats
+    {
+        unsigned long long ulHits;          // used while already resident
+        unsigned long long ulMisses;        // used while not resident
+        unsigned long long ulEvictions;
+        unsigned long long ulEvictedBytes;
+    };
+
+    // A budget of zero means there's no limit
+    ResidencyList( unsigned long long a_ulBudget = 0 );
+
+    // Change the budget.  Nothing is evicted until NextEviction is called.
+    void SetBudget( unsigned long long a_ulBudget ) { m_ulBudget = a_ulBudget; }
+    unsigned long long Budget() const { return m_ulBudget; }
+
+    // Record that a resource has been used, and how big it is now.  Returns
+    // true if it was already resident, or false if it's new to the list.
+    bool Use( const T& ac_rItem, unsigned long long a_ulBytes );
+
+    // Take a resource off the list without counting it as evicted, e.g.
+    // because it was unloaded for some other reason.  Returns false if it
+    // wasn't on the list.
+    bool Remove( const T& ac_rItem );
+
+    // Pinned resources are never evicted.  Returns false if the resource
+    // isn't on the list.
+    bool Pin( const T& ac_rItem, bool a_bPinned = true );
+    bool IsPinned( const T& ac_rItem ) const;
+    bool IsResident( const T& ac_rItem ) const
+    { return 0 < m_oLookup.count( ac_rItem ); }
+
+    // If over budget, take the least recently used unpinned resource off the
+    // list and return true so the caller can unload it.  Returns false if
+    // within budget, or if there's nothing left that can be evicted.
+    bool NextEviction( T& a_rItem );
+    bool IsOverBudget() const
+    { return 0 < m_ulBudget && m_ulBytes > m_ulBudget; }
+
+    // Total size and number of resident resources
+    unsigned long long Bytes() const { return m_ulBytes; }
+    unsigned int Count() const { return (unsigned int)m_oLookup.size(); }
+
+    // Hits, misses, and evictions so far
+    const Stats& Statistics() const { return m_oStats; }
+    void ResetStatistics();
+
+    // Forget every resource, without counting any as evicted
+    void Clear();
+
+private:
+
+    struct Entry
+    {
+        T oItem;
+        unsigned long long ulBytes;
+        bool bPinned;
+    };
+    typedef std::list< Entry > EntryList;
+    typedef typename EntryList::iterator EntryIterator;
+
+    EntryList m_oUnpinned;  // most recently used first
+    EntryList m_oPinned;    // in no particular order
+    std::unordered_map< T, EntryIterator > m_oLookup;
+
+    unsigned long long m_ulBudget;
+    unsigned long long m_ulBytes;
+    Stats m_oStats;
+
+};  // class ResidencyList
+
+}   // namespace Utility
+
+#include "../Implementations/ResidencyList.inl"
+
+#endif  // RESIDENCY_LIST__H
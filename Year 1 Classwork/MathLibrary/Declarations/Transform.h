@@ -3,8 +3,8 @@
  * Author:             Elizabeth Lowry
  * Date Created:       January 5, 2014
  * Description:        Functions for creating transform matrices.
- * Last Modified:      February 10, 2014
- * Last Modification:  Templatizing PointVector.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Added functions for transforming arrays of points.
  ******************************************************************************/
 
 #ifndef TRANSFORM__H
@@ -29,6 +29,7 @@ typedef Matrix< double, 2 > PointTransform;
 typedef Matrix< double, 3 > Transform;
 typedef Transform HomogeneousTransform;
 typedef Transform HVectorTransform;
+typedef Matrix< double, 3, 2 > AffineTransform;
 
 // Make a transformation that performs the given transformation about a point
 IMEXPORT Transform
@@ -74,11 +75,67 @@ IMEXPORT Transform
                     const Point& ac_roOrigin = Point::Origin(),
                     bool a_bClockwise = false );
 
+// Affine transformations, stored without the constant last column.  Rows 0-1
+// are the linear part and row 2 is the translation, so a row vector times the
+// full transformation is the row vector times the linear part plus the
+// translation.
+IMEXPORT AffineTransform
+    Affine( const PointTransform& ac_roLinear,
+            const Point& ac_roTranslation = Point::Origin() );
+IMEXPORT AffineTransform
+    Affine( const Point& ac_roScale,
+            const PointTransform& ac_roRotation,
+            const Point& ac_roTranslation );    // scale, rotate, translate
+IMEXPORT AffineTransform Affine( const Transform& ac_roTransform );
+IMEXPORT Transform Homogeneous( const AffineTransform& ac_roAffine );
+IMEXPORT AffineTransform AffineScaling( double a_dFactor );
+IMEXPORT AffineTransform AffineScaling( const Point& ac_roFactor );
+IMEXPORT AffineTransform AffineTranslation( const Point& ac_roTranslation );
+IMEXPORT AffineTransform Compose( const AffineTransform& ac_roFirst,
+                                  const AffineTransform& ac_roSecond );
+IMEXPORT AffineTransform AffineInverse( const AffineTransform& ac_roAffine );
+
+// Transform whole arrays of points at once, with the same results as
+// transforming each point individually.  Interleaved arrays hold x, y for each
+// point, or x, y, h for each homogeneous vector; the other versions take a
+// separate array for each coordinate.  Results may overwrite the input.
+// Directions use only the linear part of the transformation.
+IMEXPORT void TransformPoints( const double* ac_padPoints,
+                               double* a_padResults,
+                               unsigned int a_uiCount,
+                               const Transform& ac_roTransform );
+IMEXPORT void TransformPoints( const double* ac_padPoints,
+                               double* a_padResults,
+                               unsigned int a_uiCount,
+                               const AffineTransform& ac_roTransform );
+IMEXPORT void TransformDirections( const double* ac_padDirections,
+                                   double* a_padResults,
+                                   unsigned int a_uiCount,
+                                   const PointTransform& ac_roTransform );
+IMEXPORT void TransformHVectors( const double* ac_padVectors,
+                                 double* a_padResults,
+                                 unsigned int a_uiCount,
+                                 const Transform& ac_roTransform );
+IMEXPORT void TransformPoints( const double* ac_padX, const double* ac_padY,
+                               double* a_padResultX, double* a_padResultY,
+                               unsigned int a_uiCount,
+                               const Transform& ac_roTransform );
+IMEXPORT void TransformPoints( const double* ac_padX, const double* ac_padY,
+                               double* a_padResultX, double* a_padResultY,
+                               unsigned int a_uiCount,
+                               const AffineTransform& ac_roTransform );
+IMEXPORT void TransformDirections( const double* ac_padX,
+                                   const double* ac_padY,
+                                   double* a_padResultX, double* a_padResultY,
+                                   unsigned int a_uiCount,
+                                   const PointTransform& ac_roTransform );
+
 }   // namespace Plane
 typedef Plane::PointTransform PointTransform2D;
 typedef Plane::Transform Transform2D;
 typedef Transform2D HomogeneousTransform2D;
 typedef Transform2D HVectorTransform2D;
+typedef Plane::AffineTransform AffineTransform2D;
 
 namespace Space
 {
@@ -90,6 +147,7 @@ typedef Matrix< double, 3 > PointTransform;
 typedef Matrix< double, 4 > Transform;
 typedef Transform HomogeneousTransform;
 typedef Transform HVectorTransform;
+typedef Matrix< double, 4, 3 > AffineTransform;
 
 // Make a transformation that performs the given transformation about a point
 IMEXPORT Transform
@@ -198,9 +256,68 @@ IMEXPORT Transform
                         const Plane::Point& ac_roScreenCenter
                                                             = Point::Origin() );
 
+// Affine transformations, stored without the constant last column.  Rows 0-2
+// are the linear part and row 3 is the translation, so a row vector times the
+// full transformation is the row vector times the linear part plus the
+// translation.
+IMEXPORT AffineTransform
+    Affine( const PointTransform& ac_roLinear,
+            const Point& ac_roTranslation = Point::Origin() );
+IMEXPORT AffineTransform
+    Affine( const Point& ac_roScale,
+            const PointTransform& ac_roRotation,
+            const Point& ac_roTranslation );    // scale, rotate, translate
+IMEXPORT AffineTransform Affine( const Transform& ac_roTransform );
+IMEXPORT Transform Homogeneous( const AffineTransform& ac_roAffine );
+IMEXPORT AffineTransform AffineScaling( double a_dFactor );
+IMEXPORT AffineTransform AffineScaling( const Point& ac_roFactor );
+IMEXPORT AffineTransform AffineTranslation( const Point& ac_roTranslation );
+IMEXPORT AffineTransform Compose( const AffineTransform& ac_roFirst,
+                                  const AffineTransform& ac_roSecond );
+IMEXPORT AffineTransform AffineInverse( const AffineTransform& ac_roAffine );
+
+// Transform whole arrays of points at once, as above.  Interleaved arrays hold
+// x, y, z for each point, or x, y, z, h for each homogeneous vector.
+IMEXPORT void TransformPoints( const double* ac_padPoints,
+                               double* a_padResults,
+                               unsigned int a_uiCount,
+                               const Transform& ac_roTransform );
+IMEXPORT void TransformPoints( const double* ac_padPoints,
+                               double* a_padResults,
+                               unsigned int a_uiCount,
+                               const AffineTransform& ac_roTransform );
+IMEXPORT void TransformDirections( const double* ac_padDirections,
+                                   double* a_padResults,
+                                   unsigned int a_uiCount,
+                                   const PointTransform& ac_roTransform );
+IMEXPORT void TransformHVectors( const double* ac_padVectors,
+                                 double* a_padResults,
+                                 unsigned int a_uiCount,
+                                 const Transform& ac_roTransform );
+IMEXPORT void TransformPoints( const double* ac_padX, const double* ac_padY,
+                               const double* ac_padZ,
+                               double* a_padResultX, double* a_padResultY,
+                               double* a_padResultZ,
+                               unsigned int a_uiCount,
+                               const Transform& ac_roTransform );
+IMEXPORT void TransformPoints( const double* ac_padX, const double* ac_padY,
+                               const double* ac_padZ,
+                               double* a_padResultX, double* a_padResultY,
+                               double* a_padResultZ,
+                               unsigned int a_uiCount,
+                               const AffineTransform& ac_roTransform );
+IMEXPORT void TransformDirections( const double* ac_padX,
+                                   const double* ac_padY,
+                                   const double* ac_padZ,
+                                   double* a_padResultX, double* a_padResultY,
+                                   double* a_padResultZ,
+                                   unsigned int a_uiCount,
+                                   const PointTransform& ac_roTransform );
+
 }   // namespace Space
 typedef Space::PointTransform PointTransform3D;
 typedef Space::Transform Transform3D;
+typedef Space::AffineTransform AffineTransform3D;
 typedef Transform2D HomogeneousTransform3D;
 typedef Transform2D HVectorTransform3D;
 
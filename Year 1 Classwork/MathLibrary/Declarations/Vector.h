@@ -3,8 +3,9 @@
  * Author:             Elizabeth Lowry
  * Date Created:       November 25, 2013
  * Description:        Base class for vectors of numeric type.
- * Last Modified:      February 12, 2014
- * Last Modification:  Refactoring.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Non-virtual destructor.  Configurable bounds checking for
+ *                      operator[].
  ******************************************************************************/
 
 #ifndef VECTOR__H
@@ -35,7 +36,7 @@ public:
     typedef Vector< InverseT, N, t_bIsRow > NormalType;
 
     // destructor
-    virtual ~Vector();
+    ~Vector();
 
     // Constructors that forward to base class constructors
     Vector();
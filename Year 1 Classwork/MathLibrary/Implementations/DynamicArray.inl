@@ -3,8 +3,8 @@
  * Author:             Elizabeth Lowry
  * Date Created:       March 20, 2014
  * Description:        Function implementations for DynamicArray.
- * Last Modified:      March 20, 2014
- * Last Modification:  Debugging.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Configurable bounds checking for operator[].
  ******************************************************************************/
 
 #ifndef DYNAMIC_ARRAY__INL
@@ -105,19 +105,31 @@ DynamicArray< T >& DynamicArray< T >::operator=( const T& ac_rData )
 // access array elements
 template< typename T >
 T& DynamicArray< T >::operator[]( unsigned int a_uiIndex )
+{
+    MATH_LIBRARY_CHECK_INDEX( "array element", a_uiIndex, m_uiSize );
+    return m_paData[ a_uiIndex ];
+}
+template< typename T >
+const T& DynamicArray< T >::operator[]( unsigned int a_uiIndex ) const
+{
+    MATH_LIBRARY_CHECK_INDEX( "array element", a_uiIndex, m_uiSize );
+    return m_paData[ a_uiIndex ];
+}
+template< typename T >
+T& DynamicArray< T >::At( unsigned int a_uiIndex )
 {
     if( nullptr == m_paData || a_uiIndex >= m_uiSize )
     {
-        throw std::out_of_range( "Index outside array bounds" );
+        ThrowOutOfRange( "array element", a_uiIndex, m_uiSize );
     }
     return m_paData[ a_uiIndex ];
 }
 template< typename T >
-const T& DynamicArray< T >::operator[]( unsigned int a_uiIndex ) const
+const T& DynamicArray< T >::At( unsigned int a_uiIndex ) const
 {
     if( nullptr == m_paData || a_uiIndex >= m_uiSize )
     {
-        throw std::out_of_range( "Index outside array bounds" );
+        ThrowOutOfRange( "array element", a_uiIndex, m_uiSize );
     }
     return m_paData[ a_uiIndex ];
 }
@@ -0,0 +1,88 @@
+/******************************************************************************
+ * File:               EventQueue.inl
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Function implementations for EventQueue.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Creation.
+ ******************************************************************************/
+
+#ifndef EVENT_QUEUE__INL
+#define EVENT_QUEUE__INL
+
+#include "../Declarations/EventQueue.h"
+
+namespace Utility
+{
+
+// Constructor
+template< typename T >
+EventQueue< T >::EventQueue( unsigned int a_uiCapacity )
+    : m_uiMask( 1 ), m_uiPushed( 0 ), m_uiDropped( 0 ), m_uiPopped( 0 )
+{
+    while( m_uiMask < a_uiCapacity && 0x80000000 > m_uiMask )
+    {
+        m_uiMask <<= 1;
+    }
+    m_oEvents.resize( m_uiMask );
+    --m_uiMask;
+}
+
+// Write the event before publishing the new position, so the consumer never
+// sees the position without the event
+template< typename T >
+bool EventQueue< T >::Push( const T& ac_roEvent )
+{
+    unsigned int uiPushed = m_uiPushed;
+    if( uiPushed - m_uiPopped > m_uiMask )
+    {
+        ++m_uiDropped;
+        return false;
+    }
+    EVENT_QUEUE__BARRIER();
+    m_oEvents[ uiPushed & m_uiMask ] = ac_roEvent;
+    EVENT_QUEUE__BARRIER();
+    m_uiPushed = uiPushed + 1;
+    return true;
+}
+
+// Read the event after seeing its position and before giving its slot back
+template< typename T >
+bool EventQueue< T >::Pop( T& a_roEvent )
+{
+    unsigned int uiPopped = m_uiPopped;
+    if( m_uiPushed == uiPopped )
+    {
+        return false;
+    }
+    EVENT_QUEUE__BARRIER();
+    a_roEvent = m_oEvents[ uiPopped & m_uiMask ];
+    EVENT_QUEUE__BARRIER();
+    m_uiPopped = uiPopped + 1;
+    return true;
+}
+template< typename T >
+bool EventQueue< T >::Peek( T& a_roEvent ) const
+{
+    unsigned int uiPopped = m_uiPopped;
+    if( m_uiPushed == uiPopped )
+    {
+        return false;
+    }
+    EVENT_QUEUE__BARRIER();
+    a_roEvent = m_oEvents[ uiPopped & m_uiMask ];
+    return true;
+}
+
+// Only the consumer moves its own position, so this is as safe as popping
+template< typename T >
+void EventQueue< T >::Clear()
+{
+    unsigned int uiPushed = m_uiPushed;
+    EVENT_QUEUE__BARRIER();
+    m_uiPopped = uiPushed;
+}
+
+}   // namespace Utility
+
+#endif  // EVENT_QUEUE__INL
@@ -0,0 +1,280 @@
+/******************************************************************************
+ * File:               Frustum.inl
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Inline function implementations for bounding boxes and
+ *                      view frustums.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Creation.
+ ******************************************************************************/
+
+#ifndef FRUSTUM__INL
+#define FRUSTUM__INL
+
+#include "../Declarations/Frustum.h"
+#include "../Declarations/ImExportMacro.h"
+
+// Use SSE2 to test two boxes at a time where the target supports it
+#if defined _M_X64 || ( defined _M_IX86_FP && _M_IX86_FP >= 2 ) || \
+    defined __SSE2__
+#define FRUSTUM__INL__SSE2
+#include <emmintrin.h>
+#endif
+
+namespace Space
+{
+
+// Smallest box containing the given box after an affine transformation with M
+// rows, the last of which is the translation.  Each coordinate of the result
+// is the translation plus, for each coordinate of the original box, whichever
+// of the minimum or maximum times the matrix element is smaller (or larger).
+template< unsigned int M, unsigned int N >
+inline BoundingBox TransformBoundingBox( const BoundingBox& ac_roBox,
+                                         const Matrix< double, M, N >&
+                                            ac_roTransform )
+{
+    BoundingBox oResult;
+    for( unsigned int j = 0; j < 3; ++j )
+    {
+        oResult.adMin[j] = ac_roTransform[ M - 1 ][j];
+        oResult.adMax[j] = ac_roTransform[ M - 1 ][j];
+        for( unsigned int i = 0; i < 3; ++i )
+        {
+            double dLow = ac_roTransform[i][j] * ac_roBox.adMin[i];
+            double dHigh = ac_roTransform[i][j] * ac_roBox.adMax[i];
+            if( dLow > dHigh )
+            {
+                double dSwap = dLow;
+                dLow = dHigh;
+                dHigh = dSwap;
+            }
+            oResult.adMin[j] += dLow;
+            oResult.adMax[j] += dHigh;
+        }
+    }
+    return oResult;
+}
+
+//
+// BoundingBox
+//
+
+// Smallest box containing this one after an affine transformation
+INLINE BoundingBox
+    BoundingBox::Transformed( const Transform& ac_roTransform ) const
+{
+    return TransformBoundingBox( *this, ac_roTransform );
+}
+INLINE BoundingBox
+    BoundingBox::Transformed( const AffineTransform& ac_roTransform ) const
+{
+    return TransformBoundingBox( *this, ac_roTransform );
+}
+
+// Smallest box containing both this box and the other
+INLINE BoundingBox BoundingBox::Merged( const BoundingBox& ac_roBox ) const
+{
+    BoundingBox oResult;
+    for( unsigned int i = 0; i < 3; ++i )
+    {
+        oResult.adMin[i] = ( adMin[i] < ac_roBox.adMin[i] ? adMin[i]
+                                                          : ac_roBox.adMin[i] );
+        oResult.adMax[i] = ( adMax[i] > ac_roBox.adMax[i] ? adMax[i]
+                                                          : ac_roBox.adMax[i] );
+    }
+    return oResult;
+}
+
+// Does this box contain the other one entirely?
+INLINE bool BoundingBox::Contains( const BoundingBox& ac_roBox ) const
+{
+    for( unsigned int i = 0; i < 3; ++i )
+    {
+        if( ac_roBox.adMin[i] < adMin[i] || ac_roBox.adMax[i] > adMax[i] )
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+//
+// Frustum
+//
+
+// Default frustum contains everything
+INLINE Frustum::Frustum()
+{
+    for( unsigned int ui = 0; ui < PLANE_COUNT; ++ui )
+    {
+        m_aadPlanes[ui][0] = 0.0;
+        m_aadPlanes[ui][1] = 0.0;
+        m_aadPlanes[ui][2] = 0.0;
+        m_aadPlanes[ui][3] = 1.0;
+    }
+}
+
+// Frustum for the given view-projection transformation.  With row vectors, a
+// point's clip coordinates are ( x, y, z, 1 ) times each column, so a plane
+// like w + x >= 0 is the sum of the last and first columns.
+INLINE Frustum::Frustum( const Transform& ac_roViewProjection )
+{
+    for( unsigned int ui = 0; ui < PLANE_COUNT; ++ui )
+    {
+        unsigned int uiAxis = ui / 2;
+        double dSign = ( 0 == ui % 2 ? 1.0 : -1.0 );
+        for( unsigned int i = 0; i < 4; ++i )
+        {
+            m_aadPlanes[ui][i] = ac_roViewProjection[i][3] +
+                                 dSign * ac_roViewProjection[i][ uiAxis ];
+        }
+    }
+}
+
+// Test a box against the planes in the mask
+INLINE Frustum::Containment Frustum::Test( const BoundingBox& ac_roBox,
+                                           unsigned int a_uiPlanes ) const
+{
+    return TestAndNarrow( ac_roBox, a_uiPlanes );
+}
+
+// Test a box, replacing the mask with the planes the box crosses.  For each
+// plane, the corner of the box farthest along the plane's normal comes from
+// the maximum wherever the normal is positive and the minimum wherever it's
+// negative, and the nearest corner is the opposite.  If the farthest corner is
+// outside, so is the whole box, and if the nearest is inside, so is the box.
+INLINE Frustum::Containment
+    Frustum::TestAndNarrow( const BoundingBox& ac_roBox,
+                            unsigned int& a_ruiPlanes ) const
+{
+    unsigned int uiCrossed = 0;
+    for( unsigned int ui = 0; ui < PLANE_COUNT; ++ui )
+    {
+        if( 0 == ( a_ruiPlanes & ( 1u << ui ) ) )
+        {
+            continue;
+        }
+        const double* pcdPlane = m_aadPlanes[ui];
+        double dFar = pcdPlane[3];
+        double dNear = pcdPlane[3];
+        for( unsigned int j = 0; j < 3; ++j )
+        {
+            if( 0.0 <= pcdPlane[j] )
+            {
+                dFar += pcdPlane[j] * ac_roBox.adMax[j];
+                dNear += pcdPlane[j] * ac_roBox.adMin[j];
+            }
+            else
+            {
+                dFar += pcdPlane[j] * ac_roBox.adMin[j];
+                dNear += pcdPlane[j] * ac_roBox.adMax[j];
+            }
+        }
+        if( dFar < 0.0 )
+        {
+            a_ruiPlanes = 0;
+            return OUTSIDE;
+        }
+        if( dNear < 0.0 )
+        {
+            uiCrossed |= ( 1u << ui );
+        }
+    }
+    a_ruiPlanes = uiCrossed;
+    return ( 0 == uiCrossed ? INSIDE : INTERSECTING );
+}
+
+// Test a whole array of boxes at once.  Which array each coordinate of the
+// farthest corner comes from only depends on the plane, so it's chosen once
+// per plane instead of once per box.  Distances are added up in the same order
+// as in TestAndNarrow, so both give the same answer for the same box.
+INLINE unsigned int Frustum::Cull( const double* ac_padMinX,
+                                   const double* ac_padMinY,
+                                   const double* ac_padMinZ,
+                                   const double* ac_padMaxX,
+                                   const double* ac_padMaxY,
+                                   const double* ac_padMaxZ,
+                                   unsigned int a_uiCount,
+                                   unsigned int* a_pauiResults,
+                                   unsigned int a_uiPlanes ) const
+{
+    const double* const apcdMin[3] = { ac_padMinX, ac_padMinY, ac_padMinZ };
+    const double* const apcdMax[3] = { ac_padMaxX, ac_padMaxY, ac_padMaxZ };
+    const double* aapcdCorner[ PLANE_COUNT ][3];
+    const double* apcdPlane[ PLANE_COUNT ];
+    unsigned int uiPlanes = 0;
+    for( unsigned int ui = 0; ui < PLANE_COUNT; ++ui )
+    {
+        if( 0 != ( a_uiPlanes & ( 1u << ui ) ) )
+        {
+            apcdPlane[ uiPlanes ] = m_aadPlanes[ui];
+            for( unsigned int j = 0; j < 3; ++j )
+            {
+                aapcdCorner[ uiPlanes ][j] =
+                    ( 0.0 <= m_aadPlanes[ui][j] ? apcdMax[j] : apcdMin[j] );
+            }
+            ++uiPlanes;
+        }
+    }
+
+    unsigned int uiVisible = 0;
+    unsigned int i = 0;
+
+#ifdef FRUSTUM__INL__SSE2
+    const __m128d oZero = _mm_setzero_pd();
+    for( ; i + 2 <= a_uiCount; i += 2 )
+    {
+        __m128d oOutside = oZero;
+        for( unsigned int ui = 0; ui < uiPlanes; ++ui )
+        {
+            const double* pcdPlane = apcdPlane[ui];
+            __m128d oFar = _mm_set1_pd( pcdPlane[3] );
+            oFar = _mm_add_pd( oFar,
+                               _mm_mul_pd( _mm_set1_pd( pcdPlane[0] ),
+                                           _mm_loadu_pd( aapcdCorner[ui][0] +
+                                                         i ) ) );
+            oFar = _mm_add_pd( oFar,
+                               _mm_mul_pd( _mm_set1_pd( pcdPlane[1] ),
+                                           _mm_loadu_pd( aapcdCorner[ui][1] +
+                                                         i ) ) );
+            oFar = _mm_add_pd( oFar,
+                               _mm_mul_pd( _mm_set1_pd( pcdPlane[2] ),
+                                           _mm_loadu_pd( aapcdCorner[ui][2] +
+                                                         i ) ) );
+            oOutside = _mm_or_pd( oOutside, _mm_cmplt_pd( oFar, oZero ) );
+        }
+        int iOutside = _mm_movemask_pd( oOutside );
+        if( 0 == ( iOutside & 1 ) )
+        {
+            a_pauiResults[ uiVisible++ ] = i;
+        }
+        if( 0 == ( iOutside & 2 ) )
+        {
+            a_pauiResults[ uiVisible++ ] = i + 1;
+        }
+    }
+#endif
+
+    for( ; i < a_uiCount; ++i )
+    {
+        bool bOutside = false;
+        for( unsigned int ui = 0; ui < uiPlanes && !bOutside; ++ui )
+        {
+            const double* pcdPlane = apcdPlane[ui];
+            double dFar = pcdPlane[3];
+            dFar += pcdPlane[0] * aapcdCorner[ui][0][i];
+            dFar += pcdPlane[1] * aapcdCorner[ui][1][i];
+            dFar += pcdPlane[2] * aapcdCorner[ui][2][i];
+            bOutside = ( dFar < 0.0 );
+        }
+        if( !bOutside )
+        {
+            a_pauiResults[ uiVisible++ ] = i;
+        }
+    }
+    return uiVisible;
+}
+
+}   // namespace Space
+
+#endif  // FRUSTUM__INL
@@ -3,16 +3,28 @@
  * Author:             Elizabeth Lowry
  * Date Created:       December 4, 2013
  * Description:        Inline and template function implementations.
- * Last Modified:      March 18, 2014
- * Last Modification:  Debugging.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Separate Round overloads for integers, and no overflow
+ *                      finding powers of two above 2^63.
  ******************************************************************************/
 
 #ifndef FUNCTIONS__INL
 #define FUNCTIONS__INL
 
 #include "../Declarations/Functions.h"
-#include <cmath>    // for fmod, log, pow, abs
+#include <cmath>    // for fmod, floor, ceil, frexp, ldexp
+#include <limits>   // for numeric_limits
 #include <type_traits>  // for enable_if, is_same, and is_floating_point
+#ifdef _MSC_VER
+#include <intrin.h>     // for _BitScanReverse
+#endif
+
+// Use SSE for the float array functions where the target supports it
+#if defined _M_X64 || ( defined _M_IX86_FP && _M_IX86_FP >= 1 ) || \
+    defined __SSE__
+#define FUNCTIONS__INL__SSE
+#include <xmmintrin.h>
+#endif
 
 namespace Math
 {
@@ -46,6 +58,39 @@ inline T Interpolate( const T& ac_rPointA,
 {
     return (T)( ac_rPointA + ( a_fProgress * ( ac_rPointB - ac_rPointA ) ) );
 }
+template< typename T >
+inline void Interpolate( const T* a_pacPointsA,
+                         const T* a_pacPointsB,
+                         float a_fProgress,
+                         T* a_paResults,
+                         unsigned int a_uiCount )
+{
+    unsigned int i = 0;
+#ifdef FUNCTIONS__INL__SSE
+    // Four at a time - same operations as the single-value version, so the
+    // results are identical
+    if( std::is_same< T, float >::value )
+    {
+        const float* pcfA = reinterpret_cast< const float* >( a_pacPointsA );
+        const float* pcfB = reinterpret_cast< const float* >( a_pacPointsB );
+        float* pfResults = reinterpret_cast< float* >( a_paResults );
+        __m128 oProgress = _mm_set1_ps( a_fProgress );
+        for( ; i + 4 <= a_uiCount; i += 4 )
+        {
+            __m128 oA = _mm_loadu_ps( pcfA + i );
+            __m128 oB = _mm_loadu_ps( pcfB + i );
+            _mm_storeu_ps( pfResults + i,
+                           _mm_add_ps( oA, _mm_mul_ps( oProgress,
+                                                       _mm_sub_ps( oB, oA ) ) ) );
+        }
+    }
+#endif
+    for( ; i < a_uiCount; ++i )
+    {
+        a_paResults[i] = Interpolate( a_pacPointsA[i], a_pacPointsB[i],
+                                      a_fProgress );
+    }
+}
 
 // Call fmod for floating-point types and operator% for everything else
 template< typename T, typename U >
@@ -83,7 +128,24 @@ inline typename std::enable_if< std::is_floating_point< T >::value ||
     return a_rDividend;
 }
 
-// Return the power of two closest to the given value
+// Index of the highest set bit of a non-zero value
+inline unsigned int HighestBit( unsigned long long a_ullValue )
+{
+#ifdef _MSC_VER
+    unsigned long ulIndex = 0;
+    if( _BitScanReverse( &ulIndex, (unsigned long)( a_ullValue >> 32 ) ) )
+    {
+        return (unsigned int)ulIndex + 32;
+    }
+    _BitScanReverse( &ulIndex, (unsigned long)a_ullValue );
+    return (unsigned int)ulIndex;
+#else
+    return 63 - (unsigned int)__builtin_clzll( a_ullValue );
+#endif
+}
+
+// Return the power of two closest to the given value, rounding down on ties.
+// Values less than or equal to zero return one.
 template< typename T >
 inline typename std::enable_if< std::is_scalar< T >::value, T >::type
     NearestPowerOfTwo( const T& ac_rValue )
@@ -92,24 +154,80 @@ inline typename std::enable_if< std::is_scalar< T >::value, T >::type
     {
         return (T)1;
     }
-    double dLog = std::log( (double)ac_rValue ) / std::log( 2.0 );
-    double dCeilPower = std::pow( 2.0, std::ceil( dLog ) );
-    double dFloorPower = std::pow( 2.0, std::floor( dLog ) );
-    return (T)( ( std::fabs( (double)ac_rValue - dCeilPower ) <
-                  std::fabs( (double)ac_rValue - dFloorPower ) )
-                ? dCeilPower : dFloorPower );
+
+    // For integers, the floor power is the highest set bit.  The ceiling power
+    // may not fit in T, in which case the cast wraps it the same way casting
+    // it from a double would.
+    if( std::is_integral< T >::value )
+    {
+        unsigned long long ullValue = (unsigned long long)ac_rValue;
+        unsigned int uiBit = HighestBit( ullValue );
+        unsigned long long ullFloor = 1ull << uiBit;
+        if( 63 == uiBit )
+        {
+            return (T)ullFloor; // the ceiling power doesn't fit in 64 bits
+        }
+        unsigned long long ullCeil = ullFloor << 1;
+        return (T)( ullValue != ullFloor &&
+                    ullCeil - ullValue < ullValue - ullFloor
+                    ? ullCeil : ullFloor );
+    }
+
+    // For floating-point values, value = mantissa * 2^exponent with the
+    // mantissa in [0.5, 1), so the floor power is 2^(exponent-1) and the
+    // ceiling power is closer only if the mantissa is over 0.75.  Infinity and
+    // NaN come back out of frexp unchanged.
+    int iExponent = 0;
+    double dMantissa = std::frexp( (double)ac_rValue, &iExponent );
+    if( !( dMantissa < 1.0 ) )
+    {
+        return (T)dMantissa;
+    }
+    if( 0.75 < dMantissa &&
+        iExponent < std::numeric_limits< double >::max_exponent )
+    {
+        return (T)std::ldexp( 1.0, iExponent );
+    }
+    return (T)std::ldexp( 1.0, iExponent - 1 );
+}
+template< typename T >
+inline void NearestPowerOfTwo( const T* a_pacValues,
+                               T* a_paResults,
+                               unsigned int a_uiCount )
+{
+    for( unsigned int i = 0; i < a_uiCount; ++i )
+    {
+        a_paResults[i] = NearestPowerOfTwo( a_pacValues[i] );
+    }
 }
 
-// Round to nearest whole number
+// Round to nearest whole number, rounding down on ties.  Integers are already
+// whole, so they get an overload of their own that never instantiates floor
+// or ceil for an integral type.
 template< typename T >
-inline typename std::enable_if< std::is_scalar< T >::value, T >::type
+inline typename std::enable_if< std::is_scalar< T >::value &&
+                                !std::is_floating_point< T >::value, T >::type
     Round( const T& ac_rValue )
 {
-    double dCeil = std::ceil( (double)ac_rValue );
-    double dFloor = std::floor( (double)ac_rValue );
-    return (T)( ( std::fabs( (double)ac_rValue - dCeil ) <
-                  std::fabs( (double)ac_rValue - dFloor ) )
-                ? dCeil : dFloor );
+    return ac_rValue;
+}
+template< typename T >
+inline typename std::enable_if< std::is_floating_point< T >::value, T >::type
+    Round( const T& ac_rValue )
+{
+    // value - floor is exact, so this picks the same side as comparing the
+    // distances to the floor and ceiling, without computing both distances
+    T tFloor = (T)std::floor( ac_rValue );
+    return ( (T)0.5 < ac_rValue - tFloor ? (T)std::ceil( ac_rValue ) : tFloor );
+}
+template< typename T >
+inline void Round( const T* a_pacValues, T* a_paResults,
+                   unsigned int a_uiCount )
+{
+    for( unsigned int i = 0; i < a_uiCount; ++i )
+    {
+        a_paResults[i] = Round( a_pacValues[i] );
+    }
 }
 
 // Scroll a value into the given bounds, [ ac_rMin, ac_rMax ).
@@ -174,6 +292,16 @@ inline typename std::enable_if< std::is_scalar< T >::value, T >::type
 {
     return -Scroll( -ac_rValue, -(T)PI, (T)PI );
 }
+template< typename T >
+inline void ScrollRadians( const T* a_pacValues,
+                           T* a_paResults,
+                           unsigned int a_uiCount )
+{
+    for( unsigned int i = 0; i < a_uiCount; ++i )
+    {
+        a_paResults[i] = ScrollRadians( a_pacValues[i] );
+    }
+}
 
 // Complex conjugate (if you ever want to use a matrix full of complex numbers,
 // you'll need to define an explicit specialization for this function).
@@ -3,8 +3,8 @@
  * Author:             Elizabeth Lowry
  * Date Created:       November 18, 2013
  * Description:        Function implementations for Matrix template class.
- * Last Modified:      February 12, 2014
- * Last Modification:  Refactoring.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Configurable bounds checking for operator[].
  ******************************************************************************/
 
 #ifndef MATRIX__INL
@@ -136,9 +136,13 @@ template< typename T, unsigned int M, unsigned int N >
 inline T& Matrix< T, M, N >::
     At( unsigned int a_uiRow, unsigned int a_uiColumn )
 {
-    if( a_uiRow >= M || a_uiColumn >= N )
+    if( a_uiRow >= M )
+    {
+        Utility::ThrowOutOfRange( "matrix row", a_uiRow, M );
+    }
+    if( a_uiColumn >= N )
     {
-        throw std::out_of_range( "Cannot access non-existent matrix element" );
+        Utility::ThrowOutOfRange( "matrix column", a_uiColumn, N );
     }
     return m_aaData[a_uiRow][a_uiColumn];
 }
@@ -146,9 +150,13 @@ template< typename T, unsigned int M, unsigned int N >
 inline const T& Matrix< T, M, N >::
     At( unsigned int a_uiRow, unsigned int a_uiColumn ) const
 {
-    if( a_uiRow >= M || a_uiColumn >= N )
+    if( a_uiRow >= M )
+    {
+        Utility::ThrowOutOfRange( "matrix row", a_uiRow, M );
+    }
+    if( a_uiColumn >= N )
     {
-        throw std::out_of_range( "Cannot access non-existent matrix element" );
+        Utility::ThrowOutOfRange( "matrix column", a_uiColumn, N );
     }
     return m_aaData[a_uiRow][a_uiColumn];
 }
@@ -0,0 +1,317 @@
+/******************************************************************************
+ * File:               MatrixExpression.inl
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Function implementations for lazy matrix expressions.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Checking for aliasing by address, now that matrices
+ *                      aren't polymorphic.
+ ******************************************************************************/
+
+#ifndef MATRIX_EXPRESSION__INL
+#define MATRIX_EXPRESSION__INL
+
+#include "../Declarations/MatrixExpression.h"
+
+namespace Math
+{
+
+//
+// MatrixExpression
+//
+
+// The expression as its actual type
+template< typename E, typename T, unsigned int M, unsigned int N >
+inline const E& MatrixExpression< E, T, M, N >::Derived() const
+{
+    return static_cast< const E& >( *this );
+}
+
+// Write the result into a matrix, going through temporary storage if the
+// matrix is one of the operands
+template< typename E, typename T, unsigned int M, unsigned int N >
+inline void MatrixExpression< E, T, M, N >::
+    EvaluateInto( Matrix< T, M, N >& a_roMatrix ) const
+{
+    const E& roExpression = Derived();
+    if( roExpression.Aliases( &a_roMatrix ) )
+    {
+        T aaResult[ M ][ N ];
+        for( unsigned int i = 0; i < M*N; ++i )
+        {
+            aaResult[i/N][i%N] = roExpression.At( i/N, i%N );
+        }
+        a_roMatrix = aaResult;
+    }
+    else
+    {
+        for( unsigned int i = 0; i < M*N; ++i )
+        {
+            a_roMatrix[i/N][i%N] = roExpression.At( i/N, i%N );
+        }
+    }
+}
+template< typename E, typename T, unsigned int M, unsigned int N >
+inline Matrix< T, M, N > MatrixExpression< E, T, M, N >::Evaluate() const
+{
+    Matrix< T, M, N > oResult;
+    EvaluateInto( oResult );
+    return oResult;
+}
+
+//
+// MatrixReference
+//
+
+template< typename T, unsigned int M, unsigned int N >
+inline MatrixReference< T, M, N >::
+    MatrixReference( const Matrix< T, M, N >& ac_roMatrix )
+    : m_roMatrix( ac_roMatrix ) {}
+template< typename T, unsigned int M, unsigned int N >
+inline T MatrixReference< T, M, N >::At( unsigned int a_uiRow,
+                                         unsigned int a_uiColumn ) const
+{
+    return m_roMatrix[ a_uiRow ][ a_uiColumn ];
+}
+template< typename T, unsigned int M, unsigned int N >
+inline bool MatrixReference< T, M, N >::
+    Aliases( const void* ac_pAddress ) const
+{
+    return static_cast< const void* >( &m_roMatrix ) == ac_pAddress;
+}
+
+//
+// MatrixSum
+//
+
+template< typename L, typename R >
+inline MatrixSum< L, R >::MatrixSum( const L& ac_roLeft, const R& ac_roRight )
+    : m_oLeft( ac_roLeft ), m_oRight( ac_roRight ) {}
+template< typename L, typename R >
+inline typename MatrixSum< L, R >::T
+    MatrixSum< L, R >::At( unsigned int a_uiRow,
+                           unsigned int a_uiColumn ) const
+{
+    T tResult = m_oLeft.At( a_uiRow, a_uiColumn );
+    tResult += m_oRight.At( a_uiRow, a_uiColumn );
+    return tResult;
+}
+template< typename L, typename R >
+inline bool MatrixSum< L, R >::
+    Aliases( const void* ac_pAddress ) const
+{
+    return m_oLeft.Aliases( ac_pAddress ) || m_oRight.Aliases( ac_pAddress );
+}
+
+//
+// MatrixDifference
+//
+
+template< typename L, typename R >
+inline MatrixDifference< L, R >::
+    MatrixDifference( const L& ac_roLeft, const R& ac_roRight )
+    : m_oLeft( ac_roLeft ), m_oRight( ac_roRight ) {}
+template< typename L, typename R >
+inline typename MatrixDifference< L, R >::T
+    MatrixDifference< L, R >::At( unsigned int a_uiRow,
+                                  unsigned int a_uiColumn ) const
+{
+    T tResult = m_oLeft.At( a_uiRow, a_uiColumn );
+    tResult -= m_oRight.At( a_uiRow, a_uiColumn );
+    return tResult;
+}
+template< typename L, typename R >
+inline bool MatrixDifference< L, R >::
+    Aliases( const void* ac_pAddress ) const
+{
+    return m_oLeft.Aliases( ac_pAddress ) || m_oRight.Aliases( ac_pAddress );
+}
+
+//
+// MatrixScaled
+//
+
+template< typename E, typename U >
+inline MatrixScaled< E, U >::MatrixScaled( const E& ac_roExpression,
+                                           const U& ac_rScalar )
+    : m_oExpression( ac_roExpression ), m_Scalar( ac_rScalar ) {}
+template< typename E, typename U >
+inline typename MatrixScaled< E, U >::T
+    MatrixScaled< E, U >::At( unsigned int a_uiRow,
+                              unsigned int a_uiColumn ) const
+{
+    T tResult = m_oExpression.At( a_uiRow, a_uiColumn );
+    tResult *= m_Scalar;
+    return tResult;
+}
+template< typename E, typename U >
+inline bool MatrixScaled< E, U >::
+    Aliases( const void* ac_pAddress ) const
+{
+    return m_oExpression.Aliases( ac_pAddress );
+}
+
+//
+// MatrixProduct
+//
+
+template< typename L, typename R >
+inline MatrixProduct< L, R >::MatrixProduct( const L& ac_roLeft,
+                                             const R& ac_roRight )
+    : m_oLeft( ac_roLeft ), m_oRight( ac_roRight ), m_bComputed( false ) {}
+
+// Copies don't bother copying the stored product, since expressions are only
+// copied while they're being built, before anything is computed
+template< typename L, typename R >
+inline MatrixProduct< L, R >::MatrixProduct( const MatrixProduct& ac_roProduct )
+    : m_oLeft( ac_roProduct.m_oLeft ), m_oRight( ac_roProduct.m_oRight ),
+      m_bComputed( false ) {}
+
+template< typename L, typename R >
+inline typename MatrixProduct< L, R >::T
+    MatrixProduct< L, R >::At( unsigned int a_uiRow,
+                               unsigned int a_uiColumn ) const
+{
+    if( !m_bComputed )
+    {
+        Compute();
+    }
+    return m_aaResult[ a_uiRow ][ a_uiColumn ];
+}
+template< typename L, typename R >
+inline bool MatrixProduct< L, R >::
+    Aliases( const void* ac_pAddress ) const
+{
+    return m_oLeft.Aliases( ac_pAddress ) || m_oRight.Aliases( ac_pAddress );
+}
+
+// Same order of operations as Matrix::operator*, so results are identical
+template< typename L, typename R >
+inline void MatrixProduct< L, R >::Compute() const
+{
+    for( unsigned int i = 0; i < L::ROWS; ++i )
+    {
+        for( unsigned int j = 0; j < R::COLUMNS; ++j )
+        {
+            T tResult = 0;
+            for( unsigned int k = 0; k < L::COLUMNS; ++k )
+            {
+                tResult += m_oLeft.At( i, k ) * m_oRight.At( k, j );
+            }
+            m_aaResult[i][j] = tResult;
+        }
+    }
+    m_bComputed = true;
+}
+
+//
+// Operators
+//
+
+// Start a lazy expression with a matrix
+template< typename T, unsigned int M, unsigned int N >
+inline MatrixReference< T, M, N > Lazy( const Matrix< T, M, N >& ac_roMatrix )
+{
+    return MatrixReference< T, M, N >( ac_roMatrix );
+}
+
+// Addition
+template< typename L, typename R, typename T, unsigned int M, unsigned int N >
+inline MatrixSum< L, R >
+    operator+( const MatrixExpression< L, T, M, N >& ac_roLeft,
+               const MatrixExpression< R, T, M, N >& ac_roRight )
+{
+    return MatrixSum< L, R >( ac_roLeft.Derived(), ac_roRight.Derived() );
+}
+template< typename L, typename T, unsigned int M, unsigned int N >
+inline MatrixSum< L, MatrixReference< T, M, N > >
+    operator+( const MatrixExpression< L, T, M, N >& ac_roLeft,
+               const Matrix< T, M, N >& ac_roRight )
+{
+    return MatrixSum< L, MatrixReference< T, M, N > >( ac_roLeft.Derived(),
+                                                       Lazy( ac_roRight ) );
+}
+template< typename R, typename T, unsigned int M, unsigned int N >
+inline MatrixSum< MatrixReference< T, M, N >, R >
+    operator+( const Matrix< T, M, N >& ac_roLeft,
+               const MatrixExpression< R, T, M, N >& ac_roRight )
+{
+    return MatrixSum< MatrixReference< T, M, N >, R >( Lazy( ac_roLeft ),
+                                                       ac_roRight.Derived() );
+}
+
+// Subtraction
+template< typename L, typename R, typename T, unsigned int M, unsigned int N >
+inline MatrixDifference< L, R >
+    operator-( const MatrixExpression< L, T, M, N >& ac_roLeft,
+               const MatrixExpression< R, T, M, N >& ac_roRight )
+{
+    return MatrixDifference< L, R >( ac_roLeft.Derived(),
+                                     ac_roRight.Derived() );
+}
+template< typename L, typename T, unsigned int M, unsigned int N >
+inline MatrixDifference< L, MatrixReference< T, M, N > >
+    operator-( const MatrixExpression< L, T, M, N >& ac_roLeft,
+               const Matrix< T, M, N >& ac_roRight )
+{
+    return MatrixDifference< L, MatrixReference< T, M, N > >
+        ( ac_roLeft.Derived(), Lazy( ac_roRight ) );
+}
+template< typename R, typename T, unsigned int M, unsigned int N >
+inline MatrixDifference< MatrixReference< T, M, N >, R >
+    operator-( const Matrix< T, M, N >& ac_roLeft,
+               const MatrixExpression< R, T, M, N >& ac_roRight )
+{
+    return MatrixDifference< MatrixReference< T, M, N >, R >
+        ( Lazy( ac_roLeft ), ac_roRight.Derived() );
+}
+
+// Scalar multiplication
+template< typename E, typename T, unsigned int M, unsigned int N, typename U >
+inline typename std::enable_if< std::is_scalar< U >::value,
+                                MatrixScaled< E, U > >::type
+    operator*( const MatrixExpression< E, T, M, N >& ac_roExpression,
+               const U& ac_rScalar )
+{
+    return MatrixScaled< E, U >( ac_roExpression.Derived(), ac_rScalar );
+}
+template< typename U, typename E, typename T, unsigned int M, unsigned int N >
+inline typename std::enable_if< std::is_scalar< U >::value,
+                                MatrixScaled< E, U > >::type
+    operator*( const U& ac_rScalar,
+               const MatrixExpression< E, T, M, N >& ac_roExpression )
+{
+    return MatrixScaled< E, U >( ac_roExpression.Derived(), ac_rScalar );
+}
+
+// Matrix multiplication
+template< typename L, typename R, typename T,
+          unsigned int M, unsigned int N, unsigned int P >
+inline MatrixProduct< L, R >
+    operator*( const MatrixExpression< L, T, M, N >& ac_roLeft,
+               const MatrixExpression< R, T, N, P >& ac_roRight )
+{
+    return MatrixProduct< L, R >( ac_roLeft.Derived(), ac_roRight.Derived() );
+}
+template< typename L, typename T,
+          unsigned int M, unsigned int N, unsigned int P >
+inline MatrixProduct< L, MatrixReference< T, N, P > >
+    operator*( const MatrixExpression< L, T, M, N >& ac_roLeft,
+               const Matrix< T, N, P >& ac_roRight )
+{
+    return MatrixProduct< L, MatrixReference< T, N, P > >
+        ( ac_roLeft.Derived(), Lazy( ac_roRight ) );
+}
+template< typename R, typename T,
+          unsigned int M, unsigned int N, unsigned int P >
+inline MatrixProduct< MatrixReference< T, M, N >, R >
+    operator*( const Matrix< T, M, N >& ac_roLeft,
+               const MatrixExpression< R, T, N, P >& ac_roRight )
+{
+    return MatrixProduct< MatrixReference< T, M, N >, R >
+        ( Lazy( ac_roLeft ), ac_roRight.Derived() );
+}
+
+}   // namespace Math
+
+#endif  // MATRIX_EXPRESSION__INL
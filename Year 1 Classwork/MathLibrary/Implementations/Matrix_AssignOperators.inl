@@ -3,8 +3,8 @@
  * Author:             Elizabeth Lowry
  * Date Created:       January 5, 2014
  * Description:        Operator implementations for Matrix template class.
- * Last Modified:      February 4, 2014
- * Last Modification:  Debugging.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Assignment from lazy expressions.
  ******************************************************************************/
 
 #ifndef MATRIX__ASSIGN_OPERATORS__INL
@@ -176,6 +176,16 @@ inline Matrix< T, M, N >& Matrix< T, M, N >::
     return *this;
 }
 
+// Assign by evaluating a lazy expression
+template< typename T, unsigned int M, unsigned int N >
+template< typename E >
+inline Matrix< T, M, N >& Matrix< T, M, N >::
+    operator=( const MatrixExpression< E, T, M, N >& ac_roExpression )
+{
+    ac_roExpression.EvaluateInto( *this );
+    return *this;
+}
+
 }   // namespace Math
 
 #endif  // MATRIX__ASSIGN_OPERATORS__INL
@@ -3,8 +3,8 @@
  * Author:             Elizabeth Lowry
  * Date Created:       December 3, 2013
  * Description:        Constructor implementations for Matrix template class.
- * Last Modified:      February 12, 2014
- * Last Modification:  Refactoring.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Construction from lazy expressions.
  ******************************************************************************/
 
 #ifndef MATRIX__CONSTRUCTORS__INL
@@ -177,6 +177,15 @@ inline Matrix< T, M, N >::
     }
 }
 
+// Construct by evaluating a lazy expression
+template< typename T, unsigned int M, unsigned int N >
+template< typename E >
+inline Matrix< T, M, N >::
+    Matrix( const MatrixExpression< E, T, M, N >& ac_roExpression )
+{
+    ac_roExpression.EvaluateInto( *this );
+}
+
 }   // namespace Math
 
 #endif  // MATRIX__CONSTRUCTORS__INL
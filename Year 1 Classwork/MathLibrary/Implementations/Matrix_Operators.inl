@@ -3,8 +3,8 @@
  * Author:             Elizabeth Lowry
  * Date Created:       December 3, 2013
  * Description:        Operator implementations for Matrix template class.
- * Last Modified:      February 12, 2014
- * Last Modification:  Refactoring.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Configurable bounds checking for operator[].
  ******************************************************************************/
 
 #ifndef MATRIX__OPERATORS__INL
@@ -45,20 +45,14 @@ inline bool Matrix< T, M, N >::operator!=( const Matrix& ac_roMatrix ) const
 template< typename T, unsigned int M, unsigned int N >
 inline T (&Matrix< T, M, N >::operator[]( unsigned int a_uiRow ))[ N ]
 {
-    if( a_uiRow >= M )
-    {
-        throw std::out_of_range( "Cannot access non-existent matrix row" );
-    }
+    MATH_LIBRARY_CHECK_INDEX( "matrix row", a_uiRow, M );
     return m_aaData[a_uiRow];
 }
 template< typename T, unsigned int M, unsigned int N >
 inline const
     T (&Matrix< T, M, N >::operator[]( unsigned int a_uiRow ) const)[ N ]
 {
-    if( a_uiRow >= M )
-    {
-        throw std::out_of_range( "Cannot access non-existent matrix row" );
-    }
+    MATH_LIBRARY_CHECK_INDEX( "matrix row", a_uiRow, M );
     return m_aaData[a_uiRow];
 }
 
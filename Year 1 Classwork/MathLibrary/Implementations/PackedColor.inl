@@ -0,0 +1,318 @@
+/******************************************************************************
+ * File:               PackedColor.inl
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Inline function implementations for packed colors.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Including algorithm for std::min.
+ ******************************************************************************/
+
+#ifndef PACKED_COLOR__INL
+#define PACKED_COLOR__INL
+
+#include "../Declarations/PackedColor.h"
+#include "../Declarations/Functions.h"
+#include "../Declarations/ImExportMacro.h"
+#include <algorithm>    // for min
+#include <cmath>
+
+// Use SSE2 for the array conversions where the target supports it
+#if defined _M_X64 || ( defined _M_IX86_FP && _M_IX86_FP >= 2 ) || \
+    defined __SSE2__
+#define PACKED_COLOR__INL__SSE2
+#include <emmintrin.h>
+#endif
+
+namespace Color
+{
+
+// Four bytes, nothing more
+static_assert( sizeof( PackedColor ) == 4, "PackedColor isn't four bytes" );
+
+// Clamp to [0, 1] and round to a channel value the same way Hex does.  NaN
+// becomes zero, to match the SSE2 version.
+INLINE Channel PackChannel( float a_fValue )
+{
+    return ( !( a_fValue >= 0.0f ) ? 0
+             : a_fValue > 1.0f ? 0xFF
+             : (Channel)Math::Round( a_fValue * 0xFF ) );
+}
+
+// Round c * a / 255 to the nearest integer without dividing
+INLINE Channel MultiplyChannels( Channel a_ucValue, Channel a_ucAlpha )
+{
+    unsigned int uiProduct = a_ucValue * a_ucAlpha + 0x80;
+    return (Channel)( ( uiProduct + ( uiProduct >> 8 ) ) >> 8 );
+}
+
+//
+// PackedColor
+//
+
+// Convert to and from 0xAARRGGBB hex values
+INLINE PackedColor PackedColor::FromHex( FourChannelInt a_uiHex )
+{
+    PackedColor oColor = PACKED_COLOR( a_uiHex );
+    return oColor;
+}
+INLINE FourChannelInt PackedColor::ToHex() const
+{
+    return ( (FourChannelInt)a << 24 ) | ( (FourChannelInt)r << 16 ) |
+           ( (FourChannelInt)g << 8 ) | (FourChannelInt)b;
+}
+
+// Convert from float channel values
+INLINE PackedColor PackedColor::FromFloats( float a_fRed, float a_fGreen,
+                                            float a_fBlue, float a_fAlpha )
+{
+    PackedColor oColor = { PackChannel( a_fRed ), PackChannel( a_fGreen ),
+                           PackChannel( a_fBlue ), PackChannel( a_fAlpha ) };
+    return oColor;
+}
+
+// Compare all four channels
+INLINE bool PackedColor::operator==( const PackedColor& ac_roColor ) const
+{
+    return ( r == ac_roColor.r && g == ac_roColor.g &&
+             b == ac_roColor.b && a == ac_roColor.a );
+}
+INLINE bool PackedColor::operator!=( const PackedColor& ac_roColor ) const
+{
+    return !operator==( ac_roColor );
+}
+
+// Multiply or divide red, green, and blue by alpha
+INLINE PackedColor PackedColor::Premultiplied() const
+{
+    PackedColor oColor = { MultiplyChannels( r, a ), MultiplyChannels( g, a ),
+                           MultiplyChannels( b, a ), a };
+    return oColor;
+}
+INLINE PackedColor PackedColor::Unpremultiplied() const
+{
+    if( 0 == a )
+    {
+        PackedColor oColor = { 0, 0, 0, 0 };
+        return oColor;
+    }
+    unsigned int uiHalf = a / 2;
+    PackedColor oColor =
+        { (Channel)std::min( 0xFFu, ( r * 0xFFu + uiHalf ) / a ),
+          (Channel)std::min( 0xFFu, ( g * 0xFFu + uiHalf ) / a ),
+          (Channel)std::min( 0xFFu, ( b * 0xFFu + uiHalf ) / a ),
+          a };
+    return oColor;
+}
+
+//
+// Conversions
+//
+
+// Convert single colors to and from color vectors
+INLINE PackedColor Pack( const ColorVector& ac_roColor )
+{
+    return PackedColor::FromFloats( ac_roColor.r, ac_roColor.g,
+                                    ac_roColor.b, ac_roColor.a );
+}
+INLINE ColorVector Unpack( const PackedColor& ac_roColor )
+{
+    return ColorVector( (float)ac_roColor.r / 0xFF, (float)ac_roColor.g / 0xFF,
+                        (float)ac_roColor.b / 0xFF, (float)ac_roColor.a / 0xFF );
+}
+
+// Convert arrays of colors to and from floats
+INLINE void Pack( const float* ac_pafColors,
+                  PackedColor* a_paoResults,
+                  unsigned int a_uiCount )
+{
+    unsigned int i = 0;
+#ifdef PACKED_COLOR__INL__SSE2
+    // Four colors at a time, with the same clamping and rounding
+    const __m128 oZero = _mm_setzero_ps();
+    const __m128 oOne = _mm_set1_ps( 1.0f );
+    const __m128 oScale = _mm_set1_ps( (float)0xFF );
+    const __m128 oHalf = _mm_set1_ps( 0.5f );
+    for( ; i + 4 <= a_uiCount; i += 4 )
+    {
+        __m128i aoChannels[4];
+        for( unsigned int j = 0; j < 4; ++j )
+        {
+            // max returns the second operand for NaN, so NaN becomes zero
+            __m128 oValue = _mm_loadu_ps( ac_pafColors + ( i + j ) * 4 );
+            oValue = _mm_min_ps( _mm_max_ps( oValue, oZero ), oOne );
+            oValue = _mm_mul_ps( oValue, oScale );
+
+            // round down on ties, like Math::Round - values aren't negative,
+            // so truncating is the same as taking the floor
+            __m128i oFloor = _mm_cvttps_epi32( oValue );
+            __m128 oFraction = _mm_sub_ps( oValue, _mm_cvtepi32_ps( oFloor ) );
+            aoChannels[j] = _mm_sub_epi32(
+                oFloor, _mm_castps_si128( _mm_cmpgt_ps( oFraction, oHalf ) ) );
+        }
+        __m128i oPacked =
+            _mm_packus_epi16( _mm_packs_epi32( aoChannels[0], aoChannels[1] ),
+                              _mm_packs_epi32( aoChannels[2], aoChannels[3] ) );
+        _mm_storeu_si128( reinterpret_cast< __m128i* >( a_paoResults + i ),
+                          oPacked );
+    }
+#endif
+    for( ; i < a_uiCount; ++i )
+    {
+        const float* pcfColor = ac_pafColors + i * 4;
+        a_paoResults[i] = PackedColor::FromFloats( pcfColor[0], pcfColor[1],
+                                                   pcfColor[2], pcfColor[3] );
+    }
+}
+INLINE void Unpack( const PackedColor* ac_paoColors,
+                    float* a_pafResults,
+                    unsigned int a_uiCount )
+{
+    unsigned int i = 0;
+#ifdef PACKED_COLOR__INL__SSE2
+    // Four colors at a time, dividing the same way
+    const __m128i oZero = _mm_setzero_si128();
+    const __m128 oScale = _mm_set1_ps( (float)0xFF );
+    for( ; i + 4 <= a_uiCount; i += 4 )
+    {
+        __m128i oPacked = _mm_loadu_si128(
+            reinterpret_cast< const __m128i* >( ac_paoColors + i ) );
+        __m128i oLow = _mm_unpacklo_epi8( oPacked, oZero );
+        __m128i oHigh = _mm_unpackhi_epi8( oPacked, oZero );
+        __m128i aoChannels[4] = { _mm_unpacklo_epi16( oLow, oZero ),
+                                  _mm_unpackhi_epi16( oLow, oZero ),
+                                  _mm_unpacklo_epi16( oHigh, oZero ),
+                                  _mm_unpackhi_epi16( oHigh, oZero ) };
+        for( unsigned int j = 0; j < 4; ++j )
+        {
+            _mm_storeu_ps( a_pafResults + ( i + j ) * 4,
+                           _mm_div_ps( _mm_cvtepi32_ps( aoChannels[j] ),
+                                       oScale ) );
+        }
+    }
+#endif
+    for( ; i < a_uiCount; ++i )
+    {
+        float* pfResult = a_pafResults + i * 4;
+        pfResult[0] = (float)ac_paoColors[i].r / 0xFF;
+        pfResult[1] = (float)ac_paoColors[i].g / 0xFF;
+        pfResult[2] = (float)ac_paoColors[i].b / 0xFF;
+        pfResult[3] = (float)ac_paoColors[i].a / 0xFF;
+    }
+}
+
+// Convert between sRGB-encoded and linear channel values
+INLINE float SRGBToLinear( float a_fValue )
+{
+    return ( a_fValue <= 0.04045f
+             ? a_fValue / 12.92f
+             : std::pow( ( a_fValue + 0.055f ) / 1.055f, 2.4f ) );
+}
+INLINE float LinearToSRGB( float a_fValue )
+{
+    return ( a_fValue <= 0.0031308f
+             ? a_fValue * 12.92f
+             : 1.055f * std::pow( a_fValue, 1.0f / 2.4f ) - 0.055f );
+}
+
+// Convert arrays of sRGB-encoded packed colors to and from linear floats.
+INLINE void PackSRGB( const float* ac_pafLinearColors,
+                      PackedColor* a_paoResults,
+                      unsigned int a_uiCount )
+{
+    for( unsigned int i = 0; i < a_uiCount; ++i )
+    {
+        const float* pcfColor = ac_pafLinearColors + i * 4;
+        a_paoResults[i] =
+            PackedColor::FromFloats( LinearToSRGB( pcfColor[0] ),
+                                     LinearToSRGB( pcfColor[1] ),
+                                     LinearToSRGB( pcfColor[2] ),
+                                     pcfColor[3] );
+    }
+}
+INLINE void UnpackSRGB( const PackedColor* ac_paoColors,
+                        float* a_pafLinearResults,
+                        unsigned int a_uiCount )
+{
+    // There are only 256 possible channel values, so for anything but short
+    // arrays, convert each of them once and look the results up
+    float afTable[ 0x100 ];
+    bool bUseTable = ( 0x100 < a_uiCount * 3 );
+    if( bUseTable )
+    {
+        for( unsigned int i = 0; i < 0x100; ++i )
+        {
+            afTable[i] = SRGBToLinear( (float)i / 0xFF );
+        }
+    }
+    for( unsigned int i = 0; i < a_uiCount; ++i )
+    {
+        const PackedColor& rcoColor = ac_paoColors[i];
+        float* pfResult = a_pafLinearResults + i * 4;
+        if( bUseTable )
+        {
+            pfResult[0] = afTable[ rcoColor.r ];
+            pfResult[1] = afTable[ rcoColor.g ];
+            pfResult[2] = afTable[ rcoColor.b ];
+        }
+        else
+        {
+            pfResult[0] = SRGBToLinear( (float)rcoColor.r / 0xFF );
+            pfResult[1] = SRGBToLinear( (float)rcoColor.g / 0xFF );
+            pfResult[2] = SRGBToLinear( (float)rcoColor.b / 0xFF );
+        }
+        pfResult[3] = (float)rcoColor.a / 0xFF;
+    }
+}
+
+// Multiply or divide arrays of colors by their alpha values
+INLINE void Premultiply( const PackedColor* ac_paoColors,
+                         PackedColor* a_paoResults,
+                         unsigned int a_uiCount )
+{
+    unsigned int i = 0;
+#ifdef PACKED_COLOR__INL__SSE2
+    // Four colors at a time, in 16-bit lanes, with the same rounding
+    const __m128i oZero = _mm_setzero_si128();
+    const __m128i oRound = _mm_set1_epi16( 0x80 );
+    const __m128i oAlphaMask = _mm_set_epi16( -1, 0, 0, 0, -1, 0, 0, 0 );
+    for( ; i + 4 <= a_uiCount; i += 4 )
+    {
+        __m128i oPacked = _mm_loadu_si128(
+            reinterpret_cast< const __m128i* >( ac_paoColors + i ) );
+        __m128i aoHalves[2] = { _mm_unpacklo_epi8( oPacked, oZero ),
+                                _mm_unpackhi_epi8( oPacked, oZero ) };
+        for( unsigned int j = 0; j < 2; ++j )
+        {
+            __m128i oAlpha = _mm_shufflehi_epi16(
+                _mm_shufflelo_epi16( aoHalves[j], _MM_SHUFFLE( 3, 3, 3, 3 ) ),
+                _MM_SHUFFLE( 3, 3, 3, 3 ) );
+            __m128i oProduct = _mm_add_epi16(
+                _mm_mullo_epi16( aoHalves[j], oAlpha ), oRound );
+            oProduct = _mm_srli_epi16(
+                _mm_add_epi16( oProduct, _mm_srli_epi16( oProduct, 8 ) ), 8 );
+            aoHalves[j] = _mm_or_si128( _mm_and_si128( oAlphaMask, oAlpha ),
+                                        _mm_andnot_si128( oAlphaMask,
+                                                          oProduct ) );
+        }
+        _mm_storeu_si128( reinterpret_cast< __m128i* >( a_paoResults + i ),
+                          _mm_packus_epi16( aoHalves[0], aoHalves[1] ) );
+    }
+#endif
+    for( ; i < a_uiCount; ++i )
+    {
+        a_paoResults[i] = ac_paoColors[i].Premultiplied();
+    }
+}
+INLINE void Unpremultiply( const PackedColor* ac_paoColors,
+                           PackedColor* a_paoResults,
+                           unsigned int a_uiCount )
+{
+    for( unsigned int i = 0; i < a_uiCount; ++i )
+    {
+        a_paoResults[i] = ac_paoColors[i].Unpremultiplied();
+    }
+}
+
+}   // namespace Color
+
+#endif  // PACKED_COLOR__INL
@@ -0,0 +1,827 @@
+/******************************************************************************
+ * File:               Quadtree.inl
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Function implementations for Quadtree.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Creation.
+ ******************************************************************************/
+
+#ifndef QUADTREE__INL
+#define QUADTREE__INL
+
+#include "../Declarations/BoundsCheck.h"
+#include "../Declarations/Quadtree.h"
+
+namespace Plane
+{
+
+//
+// Query tests - each one says whether a rectangle, either an object's or a
+// node's loose bounds, could contain part of what's being searched for
+//
+
+template< typename T >
+struct Quadtree< T >::RectangleTest
+{
+    double adMin[2];
+    double adMax[2];
+    bool Overlaps( const double* ac_padMin, const double* ac_padMax ) const
+    {
+        return ac_padMin[0] <= adMax[0] && ac_padMax[0] >= adMin[0] &&
+               ac_padMin[1] <= adMax[1] && ac_padMax[1] >= adMin[1];
+    }
+};
+
+template< typename T >
+struct Quadtree< T >::CircleTest
+{
+    double adCenter[2];
+    double dRadiusSquared;
+    bool Overlaps( const double* ac_padMin, const double* ac_padMax ) const
+    {
+        // distance from the center to the nearest point in the rectangle
+        double dDistanceSquared = 0.0;
+        for( unsigned int i = 0; i < 2; ++i )
+        {
+            double d = 0.0;
+            if( adCenter[i] < ac_padMin[i] )
+            {
+                d = ac_padMin[i] - adCenter[i];
+            }
+            else if( adCenter[i] > ac_padMax[i] )
+            {
+                d = adCenter[i] - ac_padMax[i];
+            }
+            dDistanceSquared += d * d;
+        }
+        return dDistanceSquared <= dRadiusSquared;
+    }
+};
+
+template< typename T >
+struct Quadtree< T >::RayTest
+{
+    double adOrigin[2];
+    double adDirection[2];
+    double dMaxDistance;
+    bool Overlaps( const double* ac_padMin, const double* ac_padMax ) const
+    {
+        // narrow the range of the ray inside each pair of sides in turn
+        double dEnter = 0.0;
+        double dExit = dMaxDistance;
+        for( unsigned int i = 0; i < 2; ++i )
+        {
+            if( 0.0 == adDirection[i] )
+            {
+                if( adOrigin[i] < ac_padMin[i] || adOrigin[i] > ac_padMax[i] )
+                {
+                    return false;
+                }
+                continue;
+            }
+            double dNear = ( ac_padMin[i] - adOrigin[i] ) / adDirection[i];
+            double dFar = ( ac_padMax[i] - adOrigin[i] ) / adDirection[i];
+            if( dNear > dFar )
+            {
+                double dSwap = dNear;
+                dNear = dFar;
+                dFar = dSwap;
+            }
+            if( dNear > dEnter )
+            {
+                dEnter = dNear;
+            }
+            if( dFar < dExit )
+            {
+                dExit = dFar;
+            }
+            if( dEnter > dExit )
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+//
+// Setup
+//
+
+// Tree covering the given world rectangle
+template< typename T >
+Quadtree< T >::Quadtree( double a_dMinX, double a_dMinY,
+                         double a_dMaxX, double a_dMaxY,
+                         unsigned int a_uiMaxDepth )
+    : m_dMinX( a_dMinX ), m_dMinY( a_dMinY ),
+      m_dSize( a_dMaxX - a_dMinX > a_dMaxY - a_dMinY ? a_dMaxX - a_dMinX
+                                                      : a_dMaxY - a_dMinY ),
+      m_uiMaxDepth( a_uiMaxDepth ),
+      m_uiFreeChildren( INVALID ), m_uiFreeObject( INVALID ),
+      m_uiQueueStart( 0 ), m_uiCount( 0 ), m_uiNodeCount( 0 )
+{
+    if( m_uiMaxDepth > MAX_DEPTH )
+    {
+        m_uiMaxDepth = MAX_DEPTH;
+    }
+    m_dCellsPerUnit = ( 1u << m_uiMaxDepth ) / m_dSize;
+    Clear();
+}
+
+// Allocate room ahead of time
+template< typename T >
+void Quadtree< T >::Reserve( unsigned int a_uiObjects, unsigned int a_uiNodes )
+{
+    if( 0 == a_uiNodes )
+    {
+        a_uiNodes = a_uiObjects / 2 + 1;
+    }
+    m_oObjects.reserve( a_uiObjects );
+    m_oNodes.reserve( a_uiNodes );
+    m_oQueue.reserve( a_uiNodes );
+}
+
+// Remove all objects
+template< typename T >
+void Quadtree< T >::Clear()
+{
+    Node oRoot;
+    oRoot.dHalfSize = m_dSize / 2;
+    oRoot.dCenterX = m_dMinX + oRoot.dHalfSize;
+    oRoot.dCenterY = m_dMinY + oRoot.dHalfSize;
+    oRoot.uiParent = INVALID;
+    oRoot.uiFirstChild = INVALID;
+    oRoot.uiFirstObject = INVALID;
+    oRoot.uiObjects = 0;
+    oRoot.uiTotal = 0;
+    oRoot.uiDepth = 0;
+    oRoot.bQueued = false;
+    m_oNodes.clear();
+    m_oNodes.push_back( oRoot );
+    m_oObjects.clear();
+    m_oQueue.clear();
+    m_uiFreeChildren = INVALID;
+    m_uiFreeObject = INVALID;
+    m_uiQueueStart = 0;
+    m_uiCount = 0;
+    m_uiNodeCount = 1;
+}
+
+//
+// Adding, moving, and removing objects
+//
+
+// Add an object and return its handle
+template< typename T >
+unsigned int Quadtree< T >::Insert( const T& ac_rValue,
+                                    double a_dMinX, double a_dMinY,
+                                    double a_dMaxX, double a_dMaxY )
+{
+    // reuse a free slot if there is one
+    unsigned int uiObject = m_uiFreeObject;
+    if( INVALID == uiObject )
+    {
+        uiObject = (unsigned int)m_oObjects.size();
+        m_oObjects.push_back( Object() );
+    }
+    else
+    {
+        m_uiFreeObject = m_oObjects[ uiObject ].uiNext;
+    }
+
+    Object& roObject = m_oObjects[ uiObject ];
+    roObject.adMin[0] = a_dMinX;
+    roObject.adMin[1] = a_dMinY;
+    roObject.adMax[0] = a_dMaxX;
+    roObject.adMax[1] = a_dMaxY;
+    roObject.oValue = ac_rValue;
+    Locate( roObject );
+    Link( uiObject, FindNode( roObject ) );
+    ++m_uiCount;
+    return uiObject;
+}
+template< typename T >
+void Quadtree< T >::Insert( unsigned int a_uiCount, const T* ac_paValues,
+                            const double* ac_padMinX, const double* ac_padMinY,
+                            const double* ac_padMaxX, const double* ac_padMaxY,
+                            unsigned int* a_pauiHandles )
+{
+    for( unsigned int ui = 0; ui < a_uiCount; ++ui )
+    {
+        a_pauiHandles[ui] = Insert( ac_paValues[ui],
+                                    ac_padMinX[ui], ac_padMinY[ui],
+                                    ac_padMaxX[ui], ac_padMaxY[ui] );
+    }
+}
+
+// Move an object, changing nodes only if it has to
+template< typename T >
+void Quadtree< T >::Update( unsigned int a_uiHandle,
+                            double a_dMinX, double a_dMinY,
+                            double a_dMaxX, double a_dMaxY )
+{
+    MATH_LIBRARY_CHECK_INDEX( "object handle", a_uiHandle,
+                              (unsigned int)m_oObjects.size() );
+    Object& roObject = m_oObjects[ a_uiHandle ];
+    roObject.adMin[0] = a_dMinX;
+    roObject.adMin[1] = a_dMinY;
+    roObject.adMax[0] = a_dMaxX;
+    roObject.adMax[1] = a_dMaxY;
+    unsigned int uiOldCellX = roObject.uiCellX;
+    unsigned int uiOldCellY = roObject.uiCellY;
+    Locate( roObject );
+
+    // Most moves don't leave the current node's cell, and if the node is as
+    // deep as the object can go or has no children, the object stays put
+    // without searching down from the root
+    unsigned int uiShift = m_uiMaxDepth - roObject.uiNodeDepth;
+    if( roObject.uiNodeDepth <= roObject.uiDepth &&
+        ( roObject.uiNodeDepth == roObject.uiDepth ||
+          roObject.bNodeIsLeaf ) &&
+        ( roObject.uiCellX >> uiShift ) == ( uiOldCellX >> uiShift ) &&
+        ( roObject.uiCellY >> uiShift ) == ( uiOldCellY >> uiShift ) )
+    {
+        return;
+    }
+    unsigned int uiNode = FindNode( roObject );
+    if( uiNode != roObject.uiNode )
+    {
+        Move( a_uiHandle, uiNode );
+    }
+}
+template< typename T >
+void Quadtree< T >::Update( unsigned int a_uiCount,
+                            const unsigned int* ac_pauiHandles,
+                            const double* ac_padMinX, const double* ac_padMinY,
+                            const double* ac_padMaxX, const double* ac_padMaxY )
+{
+    for( unsigned int ui = 0; ui < a_uiCount; ++ui )
+    {
+        Update( ac_pauiHandles[ui], ac_padMinX[ui], ac_padMinY[ui],
+                ac_padMaxX[ui], ac_padMaxY[ui] );
+    }
+}
+
+// Remove an object, putting its slot on the free list
+template< typename T >
+void Quadtree< T >::Remove( unsigned int a_uiHandle )
+{
+    if( !Contains( a_uiHandle ) )
+    {
+        return;
+    }
+    Unlink( a_uiHandle );
+    Object& roObject = m_oObjects[ a_uiHandle ];
+    roObject.oValue = T();
+    roObject.uiNode = INVALID;
+    roObject.uiNext = m_uiFreeObject;
+    m_uiFreeObject = a_uiHandle;
+    --m_uiCount;
+}
+template< typename T >
+void Quadtree< T >::Remove( unsigned int a_uiCount,
+                            const unsigned int* ac_pauiHandles )
+{
+    for( unsigned int ui = 0; ui < a_uiCount; ++ui )
+    {
+        Remove( ac_pauiHandles[ui] );
+    }
+}
+
+//
+// Rebalancing
+//
+
+// Split or merge queued nodes until the budget runs out
+template< typename T >
+unsigned int Quadtree< T >::Rebalance( unsigned int a_uiBudget )
+{
+    while( 0 < a_uiBudget && m_uiQueueStart < m_oQueue.size() )
+    {
+        // Nodes freed since they were queued are skipped
+        unsigned int uiNode = m_oQueue[ m_uiQueueStart++ ];
+        if( !m_oNodes[ uiNode ].bQueued )
+        {
+            continue;
+        }
+        m_oNodes[ uiNode ].bQueued = false;
+        if( INVALID == m_oNodes[ uiNode ].uiFirstChild )
+        {
+            Split( uiNode );
+        }
+        else
+        {
+            Merge( uiNode );
+        }
+        --a_uiBudget;
+    }
+    if( m_uiQueueStart == m_oQueue.size() )
+    {
+        m_oQueue.clear();
+        m_uiQueueStart = 0;
+    }
+    return QueuedCount();
+}
+
+// Give a node children and move down the objects small enough to fit in them
+template< typename T >
+void Quadtree< T >::Split( unsigned int a_uiNode )
+{
+    Node& roNode = m_oNodes[ a_uiNode ];
+    if( INVALID != roNode.uiFirstChild || roNode.uiObjects <= SPLIT_COUNT ||
+        roNode.uiDepth >= m_uiMaxDepth )
+    {
+        return;
+    }
+
+    // Don't bother if none of the objects would move
+    bool bAnyFit = false;
+    for( unsigned int uiObject = roNode.uiFirstObject;
+         INVALID != uiObject && !bAnyFit;
+         uiObject = m_oObjects[ uiObject ].uiNext )
+    {
+        bAnyFit = ( m_oObjects[ uiObject ].uiDepth > roNode.uiDepth );
+    }
+    if( !bAnyFit )
+    {
+        return;
+    }
+
+    // Allocating may move the nodes, so don't use the old reference after.
+    // The parent's total doesn't change.
+    unsigned int uiFirstChild = AllocateChildren( a_uiNode );
+    unsigned int uiObject = m_oNodes[ a_uiNode ].uiFirstObject;
+    while( INVALID != uiObject )
+    {
+        unsigned int uiNext = m_oObjects[ uiObject ].uiNext;
+        const Node& roParent = m_oNodes[ a_uiNode ];
+        if( m_oObjects[ uiObject ].uiDepth > roParent.uiDepth )
+        {
+            unsigned int uiChild = uiFirstChild +
+                                   Quadrant( roParent, m_oObjects[ uiObject ] );
+            Detach( uiObject );
+            Attach( uiObject, uiChild );
+            ++m_oNodes[ uiChild ].uiTotal;
+        }
+        else
+        {
+            m_oObjects[ uiObject ].bNodeIsLeaf = false;
+        }
+        uiObject = uiNext;
+    }
+
+    // Children may need splitting themselves
+    for( unsigned int ui = 0; ui < 4; ++ui )
+    {
+        CheckSplit( uiFirstChild + ui );
+    }
+}
+
+// Move all of a node's descendants' objects into it and free its children
+template< typename T >
+void Quadtree< T >::Merge( unsigned int a_uiNode )
+{
+    Node& roNode = m_oNodes[ a_uiNode ];
+    if( INVALID == roNode.uiFirstChild || roNode.uiTotal > MERGE_COUNT )
+    {
+        return;
+    }
+    unsigned int uiFirstChild = roNode.uiFirstChild;
+    for( unsigned int ui = 0; ui < 4; ++ui )
+    {
+        Collect( uiFirstChild + ui, a_uiNode );
+    }
+    FreeChildren( uiFirstChild );
+    m_oNodes[ a_uiNode ].uiFirstChild = INVALID;
+    m_oNodes[ a_uiNode ].uiObjects = m_oNodes[ a_uiNode ].uiTotal;
+    for( unsigned int uiObject = m_oNodes[ a_uiNode ].uiFirstObject;
+         INVALID != uiObject; uiObject = m_oObjects[ uiObject ].uiNext )
+    {
+        m_oObjects[ uiObject ].bNodeIsLeaf = true;
+    }
+}
+template< typename T >
+void Quadtree< T >::Collect( unsigned int a_uiNode, unsigned int a_uiTarget )
+{
+    // The node is about to be freed, so its list doesn't need undoing
+    unsigned int uiObject = m_oNodes[ a_uiNode ].uiFirstObject;
+    while( INVALID != uiObject )
+    {
+        unsigned int uiNext = m_oObjects[ uiObject ].uiNext;
+        Attach( uiObject, a_uiTarget );
+        uiObject = uiNext;
+    }
+    unsigned int uiFirstChild = m_oNodes[ a_uiNode ].uiFirstChild;
+    if( INVALID != uiFirstChild )
+    {
+        for( unsigned int ui = 0; ui < 4; ++ui )
+        {
+            Collect( uiFirstChild + ui, a_uiTarget );
+        }
+        FreeChildren( uiFirstChild );
+    }
+}
+
+// Get a block of four child nodes from the free list, or the end of the pool
+template< typename T >
+unsigned int Quadtree< T >::AllocateChildren( unsigned int a_uiParent )
+{
+    unsigned int uiFirstChild = m_uiFreeChildren;
+    if( INVALID == uiFirstChild )
+    {
+        uiFirstChild = (unsigned int)m_oNodes.size();
+        m_oNodes.resize( m_oNodes.size() + 4 );
+    }
+    else
+    {
+        m_uiFreeChildren = m_oNodes[ uiFirstChild ].uiParent;
+    }
+
+    const Node& roParent = m_oNodes[ a_uiParent ];
+    double dHalfSize = roParent.dHalfSize / 2;
+    for( unsigned int ui = 0; ui < 4; ++ui )
+    {
+        Node& roChild = m_oNodes[ uiFirstChild + ui ];
+        roChild.dHalfSize = dHalfSize;
+        roChild.dCenterX = roParent.dCenterX +
+                           ( 0 == ( ui & 1 ) ? -dHalfSize : dHalfSize );
+        roChild.dCenterY = roParent.dCenterY +
+                           ( 0 == ( ui & 2 ) ? -dHalfSize : dHalfSize );
+        roChild.uiParent = a_uiParent;
+        roChild.uiFirstChild = INVALID;
+        roChild.uiFirstObject = INVALID;
+        roChild.uiObjects = 0;
+        roChild.uiTotal = 0;
+        roChild.uiDepth = roParent.uiDepth + 1;
+        roChild.bQueued = false;
+    }
+    m_oNodes[ a_uiParent ].uiFirstChild = uiFirstChild;
+    m_uiNodeCount += 4;
+    return uiFirstChild;
+}
+
+// Put a block of four nodes on the free list, chained through their parents
+template< typename T >
+void Quadtree< T >::FreeChildren( unsigned int a_uiFirstChild )
+{
+    for( unsigned int ui = 0; ui < 4; ++ui )
+    {
+        m_oNodes[ a_uiFirstChild + ui ].bQueued = false;
+        m_oNodes[ a_uiFirstChild + ui ].uiFirstChild = INVALID;
+    }
+    m_oNodes[ a_uiFirstChild ].uiParent = m_uiFreeChildren;
+    m_uiFreeChildren = a_uiFirstChild;
+    m_uiNodeCount -= 4;
+}
+
+//
+// Object placement
+//
+
+// Find the deepest level whose cells are at least as big as the object, and
+// the deepest-level cell its center is in
+template< typename T >
+void Quadtree< T >::Locate( Object& a_roObject ) const
+{
+    double dCenterX = ( a_roObject.adMin[0] + a_roObject.adMax[0] ) / 2;
+    double dCenterY = ( a_roObject.adMin[1] + a_roObject.adMax[1] ) / 2;
+    if( !( dCenterX >= m_dMinX && dCenterX < m_dMinX + m_dSize &&
+           dCenterY >= m_dMinY && dCenterY < m_dMinY + m_dSize ) )
+    {
+        a_roObject.uiDepth = 0;
+        a_roObject.uiCellX = 0;
+        a_roObject.uiCellY = 0;
+        return;
+    }
+
+    // Rounding could put a center just inside the far edge in the cell past
+    // it, so keep the cell in range
+    unsigned int uiLastCell = ( 1u << m_uiMaxDepth ) - 1;
+    a_roObject.uiCellX =
+        (unsigned int)( ( dCenterX - m_dMinX ) * m_dCellsPerUnit );
+    a_roObject.uiCellY =
+        (unsigned int)( ( dCenterY - m_dMinY ) * m_dCellsPerUnit );
+    if( a_roObject.uiCellX > uiLastCell )
+    {
+        a_roObject.uiCellX = uiLastCell;
+    }
+    if( a_roObject.uiCellY > uiLastCell )
+    {
+        a_roObject.uiCellY = uiLastCell;
+    }
+
+    double dWidth = a_roObject.adMax[0] - a_roObject.adMin[0];
+    double dHeight = a_roObject.adMax[1] - a_roObject.adMin[1];
+    double dExtent = ( dWidth > dHeight ? dWidth : dHeight );
+    double dCellSize = m_dSize;
+    unsigned int uiDepth = 0;
+    while( uiDepth < m_uiMaxDepth && dExtent <= dCellSize / 2 )
+    {
+        dCellSize /= 2;
+        ++uiDepth;
+    }
+    a_roObject.uiDepth = uiDepth;
+}
+
+// The bit of the object's cell just below the node's depth picks the child
+template< typename T >
+unsigned int Quadtree< T >::Quadrant( const Node& ac_roNode,
+                                      const Object& ac_roObject ) const
+{
+    unsigned int uiShift = m_uiMaxDepth - ac_roNode.uiDepth - 1;
+    return ( ( ac_roObject.uiCellX >> uiShift ) & 1 ) +
+           ( ( ( ac_roObject.uiCellY >> uiShift ) & 1 ) << 1 );
+}
+
+// Follow the object's cell down until there are no more children or the
+// children would be too small
+template< typename T >
+unsigned int Quadtree< T >::FindNode( const Object& ac_roObject ) const
+{
+    unsigned int uiNode = 0;
+    for( ; ; )
+    {
+        const Node& roNode = m_oNodes[ uiNode ];
+        if( INVALID == roNode.uiFirstChild ||
+            roNode.uiDepth >= ac_roObject.uiDepth )
+        {
+            return uiNode;
+        }
+        uiNode = roNode.uiFirstChild + Quadrant( roNode, ac_roObject );
+    }
+}
+
+// Put an object at the front of a node's list
+template< typename T >
+void Quadtree< T >::Attach( unsigned int a_uiObject, unsigned int a_uiNode )
+{
+    Object& roObject = m_oObjects[ a_uiObject ];
+    Node& roNode = m_oNodes[ a_uiNode ];
+    roObject.uiNode = a_uiNode;
+    roObject.uiNodeDepth = roNode.uiDepth;
+    roObject.bNodeIsLeaf = ( INVALID == roNode.uiFirstChild );
+    roObject.uiPrevious = INVALID;
+    roObject.uiNext = roNode.uiFirstObject;
+    if( INVALID != roNode.uiFirstObject )
+    {
+        m_oObjects[ roNode.uiFirstObject ].uiPrevious = a_uiObject;
+    }
+    roNode.uiFirstObject = a_uiObject;
+    ++roNode.uiObjects;
+}
+
+// Take an object out of its node's list
+template< typename T >
+void Quadtree< T >::Detach( unsigned int a_uiObject )
+{
+    const Object& roObject = m_oObjects[ a_uiObject ];
+    Node& roNode = m_oNodes[ roObject.uiNode ];
+    if( INVALID == roObject.uiPrevious )
+    {
+        roNode.uiFirstObject = roObject.uiNext;
+    }
+    else
+    {
+        m_oObjects[ roObject.uiPrevious ].uiNext = roObject.uiNext;
+    }
+    if( INVALID != roObject.uiNext )
+    {
+        m_oObjects[ roObject.uiNext ].uiPrevious = roObject.uiPrevious;
+    }
+    --roNode.uiObjects;
+}
+
+// Add an object to a node, counting it in every node above
+template< typename T >
+void Quadtree< T >::Link( unsigned int a_uiObject, unsigned int a_uiNode )
+{
+    Attach( a_uiObject, a_uiNode );
+    for( unsigned int uiNode = a_uiNode; INVALID != uiNode;
+         uiNode = m_oNodes[ uiNode ].uiParent )
+    {
+        ++m_oNodes[ uiNode ].uiTotal;
+    }
+    CheckSplit( a_uiNode );
+}
+
+// Remove an object from its node, no longer counting it in any node above
+template< typename T >
+void Quadtree< T >::Unlink( unsigned int a_uiObject )
+{
+    unsigned int uiNode = m_oObjects[ a_uiObject ].uiNode;
+    Detach( a_uiObject );
+    unsigned int uiMerge = INVALID;
+    for( ; INVALID != uiNode; uiNode = m_oNodes[ uiNode ].uiParent )
+    {
+        uiMerge = Uncount( uiNode, uiMerge );
+    }
+    if( INVALID != uiMerge )
+    {
+        Enqueue( uiMerge );
+    }
+}
+
+// Move an object from one node to another.  Nodes above both of them have the
+// same total afterward, so counts only change below where the paths meet.
+template< typename T >
+void Quadtree< T >::Move( unsigned int a_uiObject, unsigned int a_uiNode )
+{
+    unsigned int uiFrom = m_oObjects[ a_uiObject ].uiNode;
+    Detach( a_uiObject );
+    Attach( a_uiObject, a_uiNode );
+    unsigned int uiTo = a_uiNode;
+    unsigned int uiMerge = INVALID;
+    while( uiFrom != uiTo )
+    {
+        if( m_oNodes[ uiFrom ].uiDepth >= m_oNodes[ uiTo ].uiDepth )
+        {
+            uiMerge = Uncount( uiFrom, uiMerge );
+            uiFrom = m_oNodes[ uiFrom ].uiParent;
+        }
+        else
+        {
+            ++m_oNodes[ uiTo ].uiTotal;
+            uiTo = m_oNodes[ uiTo ].uiParent;
+        }
+    }
+    if( INVALID != uiMerge )
+    {
+        Enqueue( uiMerge );
+    }
+    CheckSplit( a_uiNode );
+}
+
+// Take one object out of a node's total, and return the node if it now has
+// few enough objects for its children to be merged, or else the given node
+template< typename T >
+unsigned int Quadtree< T >::Uncount( unsigned int a_uiNode,
+                                     unsigned int a_uiMerge )
+{
+    Node& roNode = m_oNodes[ a_uiNode ];
+    --roNode.uiTotal;
+    return ( INVALID != roNode.uiFirstChild && roNode.uiTotal <= MERGE_COUNT
+             ? a_uiNode : a_uiMerge );
+}
+
+// Queue a leaf with too many objects for splitting
+template< typename T >
+void Quadtree< T >::CheckSplit( unsigned int a_uiNode )
+{
+    const Node& roNode = m_oNodes[ a_uiNode ];
+    if( INVALID == roNode.uiFirstChild && roNode.uiObjects > SPLIT_COUNT &&
+        roNode.uiDepth < m_uiMaxDepth )
+    {
+        Enqueue( a_uiNode );
+    }
+}
+
+// Add a node to the rebalancing queue if it isn't already there
+template< typename T >
+void Quadtree< T >::Enqueue( unsigned int a_uiNode )
+{
+    if( !m_oNodes[ a_uiNode ].bQueued )
+    {
+        m_oNodes[ a_uiNode ].bQueued = true;
+        m_oQueue.push_back( a_uiNode );
+    }
+}
+
+//
+// Queries
+//
+
+// Add the handles of the objects overlapping a rectangle
+template< typename T >
+void Quadtree< T >::
+    QueryRectangle( double a_dMinX, double a_dMinY,
+                    double a_dMaxX, double a_dMaxY,
+                    std::vector< unsigned int >& a_roResults ) const
+{
+    RectangleTest oTest;
+    oTest.adMin[0] = a_dMinX;
+    oTest.adMin[1] = a_dMinY;
+    oTest.adMax[0] = a_dMaxX;
+    oTest.adMax[1] = a_dMaxY;
+    Query( oTest, a_roResults );
+}
+
+// Add the handles of the objects overlapping a circle
+template< typename T >
+void Quadtree< T >::
+    QueryCircle( double a_dCenterX, double a_dCenterY, double a_dRadius,
+                 std::vector< unsigned int >& a_roResults ) const
+{
+    CircleTest oTest;
+    oTest.adCenter[0] = a_dCenterX;
+    oTest.adCenter[1] = a_dCenterY;
+    oTest.dRadiusSquared = a_dRadius * a_dRadius;
+    Query( oTest, a_roResults );
+}
+
+// Add the handles of the objects hit by a ray
+template< typename T >
+void Quadtree< T >::
+    QueryRay( double a_dOriginX, double a_dOriginY,
+              double a_dDirectionX, double a_dDirectionY,
+              double a_dMaxDistance,
+              std::vector< unsigned int >& a_roResults ) const
+{
+    RayTest oTest;
+    oTest.adOrigin[0] = a_dOriginX;
+    oTest.adOrigin[1] = a_dOriginY;
+    oTest.adDirection[0] = a_dDirectionX;
+    oTest.adDirection[1] = a_dDirectionY;
+    oTest.dMaxDistance = a_dMaxDistance;
+    Query( oTest, a_roResults );
+}
+
+// Depth-first search of the nodes whose loose bounds pass the test.  At most
+// three siblings per level wait on the stack, so it never needs to grow.
+template< typename T >
+template< typename Test >
+void Quadtree< T >::Query( const Test& ac_roTest,
+                           std::vector< unsigned int >& a_roResults ) const
+{
+    unsigned int auiStack[ 3 * MAX_DEPTH + 4 ];
+    unsigned int uiStackSize = 0;
+    auiStack[ uiStackSize++ ] = 0;  // the root's bounds are unlimited
+    while( 0 < uiStackSize )
+    {
+        const Node& roNode = m_oNodes[ auiStack[ --uiStackSize ] ];
+        for( unsigned int uiObject = roNode.uiFirstObject; INVALID != uiObject;
+             uiObject = m_oObjects[ uiObject ].uiNext )
+        {
+            const Object& roObject = m_oObjects[ uiObject ];
+            if( ac_roTest.Overlaps( roObject.adMin, roObject.adMax ) )
+            {
+                a_roResults.push_back( uiObject );
+            }
+        }
+        if( INVALID == roNode.uiFirstChild )
+        {
+            continue;
+        }
+        for( unsigned int ui = 0; ui < 4; ++ui )
+        {
+            // Loose bounds stick out half a cell past the cell on every side
+            const Node& roChild = m_oNodes[ roNode.uiFirstChild + ui ];
+            double dLooseSize = roChild.dHalfSize * 2;
+            double adMin[2] = { roChild.dCenterX - dLooseSize,
+                                roChild.dCenterY - dLooseSize };
+            double adMax[2] = { roChild.dCenterX + dLooseSize,
+                                roChild.dCenterY + dLooseSize };
+            if( 0 < roChild.uiTotal && ac_roTest.Overlaps( adMin, adMax ) )
+            {
+                auiStack[ uiStackSize++ ] = roNode.uiFirstChild + ui;
+            }
+        }
+    }
+}
+
+//
+// Access
+//
+
+// Access an object's value
+template< typename T >
+T& Quadtree< T >::Value( unsigned int a_uiHandle )
+{
+    MATH_LIBRARY_CHECK_INDEX( "object handle", a_uiHandle,
+                              (unsigned int)m_oObjects.size() );
+    return m_oObjects[ a_uiHandle ].oValue;
+}
+template< typename T >
+const T& Quadtree< T >::Value( unsigned int a_uiHandle ) const
+{
+    MATH_LIBRARY_CHECK_INDEX( "object handle", a_uiHandle,
+                              (unsigned int)m_oObjects.size() );
+    return m_oObjects[ a_uiHandle ].oValue;
+}
+
+// Access an object's rectangle
+template< typename T >
+void Quadtree< T >::GetBounds( unsigned int a_uiHandle,
+                               double& a_rdMinX, double& a_rdMinY,
+                               double& a_rdMaxX, double& a_rdMaxY ) const
+{
+    MATH_LIBRARY_CHECK_INDEX( "object handle", a_uiHandle,
+                              (unsigned int)m_oObjects.size() );
+    const Object& roObject = m_oObjects[ a_uiHandle ];
+    a_rdMinX = roObject.adMin[0];
+    a_rdMinY = roObject.adMin[1];
+    a_rdMaxX = roObject.adMax[0];
+    a_rdMaxY = roObject.adMax[1];
+}
+
+// Is the handle for an object currently in the tree?
+template< typename T >
+bool Quadtree< T >::Contains( unsigned int a_uiHandle ) const
+{
+    return a_uiHandle < m_oObjects.size() &&
+           INVALID != m_oObjects[ a_uiHandle ].uiNode;
+}
+
+}   // namespace Plane
+
+#endif  // QUADTREE__INL
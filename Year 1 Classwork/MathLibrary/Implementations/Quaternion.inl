@@ -3,8 +3,9 @@
  * Author:             Elizabeth Lowry
  * Date Created:       March 3, 2014
  * Description:        Inline implementations for Quaternion functions.
- * Last Modified:      March 5, 2014
- * Last Modification:  Debugging.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Slerp past either end uses sine weights even for
+ *                       small angles.
  ******************************************************************************/
 
 #ifndef QUATERNION__INL
@@ -126,14 +127,18 @@ INLINE Quaternion
 }
 INLINE Quaternion& Quaternion::operator*=( const Quaternion& ac_roQuaternion )
 {
-    w = ( w * ac_roQuaternion.w ) - ( x * ac_roQuaternion.x )
-        - ( y * ac_roQuaternion.y ) - ( z * ac_roQuaternion.z );
-    x = ( w * ac_roQuaternion.x ) + ( x * ac_roQuaternion.w )
-        + ( y * ac_roQuaternion.z ) - ( z * ac_roQuaternion.y );
-    y = ( w * ac_roQuaternion.y ) - ( x * ac_roQuaternion.z )
-        + ( y * ac_roQuaternion.w ) + ( z * ac_roQuaternion.x );
-    w = ( w * ac_roQuaternion.z ) + ( x * ac_roQuaternion.y )
-        - ( y * ac_roQuaternion.x ) + ( z * ac_roQuaternion.w );
+    double dW = ( w * ac_roQuaternion.w ) - ( x * ac_roQuaternion.x )
+                - ( y * ac_roQuaternion.y ) - ( z * ac_roQuaternion.z );
+    double dX = ( w * ac_roQuaternion.x ) + ( x * ac_roQuaternion.w )
+                + ( y * ac_roQuaternion.z ) - ( z * ac_roQuaternion.y );
+    double dY = ( w * ac_roQuaternion.y ) - ( x * ac_roQuaternion.z )
+                + ( y * ac_roQuaternion.w ) + ( z * ac_roQuaternion.x );
+    double dZ = ( w * ac_roQuaternion.z ) + ( x * ac_roQuaternion.y )
+                - ( y * ac_roQuaternion.x ) + ( z * ac_roQuaternion.w );
+    w = dW;
+    x = dX;
+    y = dY;
+    z = dZ;
     return Normalize();
 }
 INLINE Quaternion
@@ -439,6 +444,13 @@ INLINE Quaternion& Quaternion::Normalize()
     return *this;
 }
 
+// Dot product, treating both quaternions as 4D vectors
+INLINE double Quaternion::Dot( const Quaternion& ac_roQuaternion ) const
+{
+    return ( w * ac_roQuaternion.w ) + ( x * ac_roQuaternion.x ) +
+           ( y * ac_roQuaternion.y ) + ( z * ac_roQuaternion.z );
+}
+
 // Spherical linear interpolation: http://en.wikipedia.org/wiki/Slerp
 INLINE Quaternion Quaternion::Slerped( const Quaternion& ac_roQuaternion,
                                        double a_dProgress ) const
@@ -460,9 +472,9 @@ INLINE Quaternion& Quaternion::Slerp( const Quaternion& ac_roQuaternion,
     }
 
     // Slerp
-    Quaternion oDifference = ( ac_roQuaternion / (*this) ).Clamp();
-    operator=( ( oDifference ^ a_dProgress ) * (*this) );
-    return Normalize();
+    Interpolate( m_aaData[0], ac_roQuaternion.m_aaData[0], a_dProgress,
+                 m_aaData[0], SPHERICAL );
+    return *this;
 }
 INLINE Quaternion Quaternion::Slerped( const Quaternion& ac_roQuaternion,
                                        double a_dRadiansPerSecond,
@@ -486,9 +498,10 @@ INLINE Quaternion& Quaternion::Slerp( const Quaternion& ac_roQuaternion,
         return *this;
     }
 
-    // Get the rotation to apply to this one
-    Quaternion oDifference = ( ac_roQuaternion / (*this) ).Clamp();
-    double dRadians = oDifference.GetAngle();
+    // Get the angle of the rotation from this one to the target - for unit
+    // quaternions, the dot product is the cosine of half that angle
+    double dCos = std::abs( Dot( ac_roQuaternion ) );
+    double dRadians = 2 * std::acos( 1.0 < dCos ? 1.0 : dCos );
     double dDistance = a_dRadiansPerSecond * a_dSeconds;
 
     // If clamped (stopping at the target instead of spinning past), check for
@@ -508,8 +521,235 @@ INLINE Quaternion& Quaternion::Slerp( const Quaternion& ac_roQuaternion,
     }
 
     // Slerp
-    operator=( ( oDifference ^ ( dDistance / dRadians ) ) * (*this) );
-    return Normalize();
+    Interpolate( m_aaData[0], ac_roQuaternion.m_aaData[0],
+                 dDistance / dRadians, m_aaData[0], SPHERICAL );
+    return *this;
+}
+
+// Normalized linear interpolation
+INLINE Quaternion Quaternion::Nlerped( const Quaternion& ac_roQuaternion,
+                                       double a_dProgress ) const
+{
+    Quaternion oCopy( *this );
+    return oCopy.Nlerp( ac_roQuaternion, a_dProgress );
+}
+INLINE Quaternion& Quaternion::Nlerp( const Quaternion& ac_roQuaternion,
+                                      double a_dProgress )
+{
+    Interpolate( m_aaData[0], ac_roQuaternion.m_aaData[0], a_dProgress,
+                 m_aaData[0], NORMALIZED );
+    return *this;
+}
+
+// Approximate slerp
+INLINE Quaternion Quaternion::FastSlerped( const Quaternion& ac_roQuaternion,
+                                           double a_dProgress ) const
+{
+    Quaternion oCopy( *this );
+    return oCopy.FastSlerp( ac_roQuaternion, a_dProgress );
+}
+INLINE Quaternion& Quaternion::FastSlerp( const Quaternion& ac_roQuaternion,
+                                          double a_dProgress )
+{
+    Interpolate( m_aaData[0], ac_roQuaternion.m_aaData[0], a_dProgress,
+                 m_aaData[0], APPROXIMATE );
+    return *this;
+}
+
+// Interpolate between two arrays of quaternions
+INLINE void Quaternion::Slerp( const Quaternion* ac_paoFrom,
+                               const Quaternion* ac_paoTo,
+                               double a_dProgress,
+                               Quaternion* a_paoResult,
+                               unsigned int a_uiCount )
+{
+    for( unsigned int ui = 0; ui < a_uiCount; ++ui )
+    {
+        Interpolate( ac_paoFrom[ ui ].m_aaData[0], ac_paoTo[ ui ].m_aaData[0],
+                     a_dProgress, a_paoResult[ ui ].m_aaData[0], SPHERICAL );
+    }
+}
+INLINE void Quaternion::Nlerp( const Quaternion* ac_paoFrom,
+                               const Quaternion* ac_paoTo,
+                               double a_dProgress,
+                               Quaternion* a_paoResult,
+                               unsigned int a_uiCount )
+{
+    for( unsigned int ui = 0; ui < a_uiCount; ++ui )
+    {
+        Interpolate( ac_paoFrom[ ui ].m_aaData[0], ac_paoTo[ ui ].m_aaData[0],
+                     a_dProgress, a_paoResult[ ui ].m_aaData[0], NORMALIZED );
+    }
+}
+INLINE void Quaternion::FastSlerp( const Quaternion* ac_paoFrom,
+                                   const Quaternion* ac_paoTo,
+                                   double a_dProgress,
+                                   Quaternion* a_paoResult,
+                                   unsigned int a_uiCount )
+{
+    for( unsigned int ui = 0; ui < a_uiCount; ++ui )
+    {
+        Interpolate( ac_paoFrom[ ui ].m_aaData[0], ac_paoTo[ ui ].m_aaData[0],
+                     a_dProgress, a_paoResult[ ui ].m_aaData[0], APPROXIMATE );
+    }
+}
+
+// Interpolate between two arrays of packed quaternions
+INLINE void Quaternion::Slerp( const double* ac_padFrom,
+                               const double* ac_padTo,
+                               double a_dProgress,
+                               double* a_padResult,
+                               unsigned int a_uiCount )
+{
+    for( unsigned int ui = 0; ui < 4 * a_uiCount; ui += 4 )
+    {
+        Interpolate( ac_padFrom + ui, ac_padTo + ui, a_dProgress,
+                     a_padResult + ui, SPHERICAL );
+    }
+}
+INLINE void Quaternion::Nlerp( const double* ac_padFrom,
+                               const double* ac_padTo,
+                               double a_dProgress,
+                               double* a_padResult,
+                               unsigned int a_uiCount )
+{
+    for( unsigned int ui = 0; ui < 4 * a_uiCount; ui += 4 )
+    {
+        Interpolate( ac_padFrom + ui, ac_padTo + ui, a_dProgress,
+                     a_padResult + ui, NORMALIZED );
+    }
+}
+INLINE void Quaternion::FastSlerp( const double* ac_padFrom,
+                                   const double* ac_padTo,
+                                   double a_dProgress,
+                                   double* a_padResult,
+                                   unsigned int a_uiCount )
+{
+    for( unsigned int ui = 0; ui < 4 * a_uiCount; ui += 4 )
+    {
+        Interpolate( ac_padFrom + ui, ac_padTo + ui, a_dProgress,
+                     a_padResult + ui, APPROXIMATE );
+    }
+}
+
+// Largest difference between FastSlerp and Slerp, found by comparing the two
+// over a few hundred thousand random pairs of rotations and rounding up
+INLINE double Quaternion::FastSlerpError()
+{
+    return 0.001;
+}
+
+// Interpolate between two quaternions given as four doubles each.  All three
+// methods come down to a weighted sum of the two quaternions, so they differ
+// only in how the weights are picked.
+INLINE void Quaternion::Interpolate( const double* ac_padFrom,
+                                     const double* ac_padTo,
+                                     double a_dProgress,
+                                     double* a_padResult,
+                                     Interpolation a_eInterpolation )
+{
+    // Above this cosine, the angle is small enough that dividing by its sine
+    // loses more precision than nlerp does, and acos loses precision too
+    const double cdSmallAngleCosine = 0.9995;
+
+    // q and -q are the same rotation, so flip the target if that makes the
+    // path shorter
+    double dCos = ( ac_padFrom[0] * ac_padTo[0] ) +
+                  ( ac_padFrom[1] * ac_padTo[1] ) +
+                  ( ac_padFrom[2] * ac_padTo[2] ) +
+                  ( ac_padFrom[3] * ac_padTo[3] );
+    double dSign = 1.0;
+    if( 0.0 > dCos )
+    {
+        dCos = -dCos;
+        dSign = -1.0;
+    }
+
+    // Pick weights
+    double dFromWeight = 1.0 - a_dProgress;
+    double dToWeight = a_dProgress;
+    bool bNormalize = true;
+    if( SPHERICAL == a_eInterpolation &&
+        ( cdSmallAngleCosine > dCos ||
+          0.0 > a_dProgress || 1.0 < a_dProgress ) )
+    {
+        // Nlerp only stays close to slerp between the two rotations, so small
+        // angles still need the sine weights when spinning past either end.
+        // For those, get the angle from the chord between the two instead,
+        // which stays accurate where acos doesn't.
+        double dAngle = 0.0;
+        if( cdSmallAngleCosine > dCos )
+        {
+            dAngle = std::acos( dCos );
+        }
+        else
+        {
+            double dChord = 0.0;
+            double dSum = 0.0;
+            for( unsigned int ui = 0; ui < 4; ++ui )
+            {
+                double dTo = ac_padTo[ ui ] * dSign;
+                dChord += ( dTo - ac_padFrom[ ui ] ) *
+                          ( dTo - ac_padFrom[ ui ] );
+                dSum += ( dTo + ac_padFrom[ ui ] ) * ( dTo + ac_padFrom[ ui ] );
+            }
+            dAngle = 2 * std::atan2( std::sqrt( dChord ), std::sqrt( dSum ) );
+        }
+
+        // sin( ( 1 - t )A ) / sin( A ) and sin( tA ) / sin( A ) keep the
+        // result on the unit sphere, so there's nothing to normalize.  If the
+        // rotations are the same, there's no angle to divide by, and the
+        // linear weights already give the right answer.
+        if( 0.0 < dAngle )
+        {
+            double dInverseSin = 1.0 / std::sin( dAngle );
+            dFromWeight = std::sin( dFromWeight * dAngle ) * dInverseSin;
+            dToWeight = std::sin( dToWeight * dAngle ) * dInverseSin;
+            bNormalize = false;
+        }
+    }
+    else if( APPROXIMATE == a_eInterpolation )
+    {
+        // Nlerp moves too slowly near the ends and too quickly in the middle,
+        // by an amount that depends on the angle.  Correct the progress with a
+        // polynomial fit to that difference.
+        double dHalf = a_dProgress - 0.5;
+        double dA = 1.0904 + dCos * ( -3.2452 +
+                             dCos * ( 3.55645 - dCos * 1.43519 ) );
+        double dB = 0.848013 + dCos * ( -1.06021 + dCos * 0.215638 );
+        dToWeight += a_dProgress * dHalf * ( a_dProgress - 1.0 ) *
+                     ( dA * dHalf * dHalf + dB );
+        dFromWeight = 1.0 - dToWeight;
+    }
+    dToWeight *= dSign;
+
+    // Weighted sum
+    double adResult[4] =
+    { ( dFromWeight * ac_padFrom[0] ) + ( dToWeight * ac_padTo[0] ),
+      ( dFromWeight * ac_padFrom[1] ) + ( dToWeight * ac_padTo[1] ),
+      ( dFromWeight * ac_padFrom[2] ) + ( dToWeight * ac_padTo[2] ),
+      ( dFromWeight * ac_padFrom[3] ) + ( dToWeight * ac_padTo[3] ) };
+
+    // Linear interpolation shortens the quaternion, so normalize
+    if( bNormalize )
+    {
+        double dMagnitudeSquared = ( adResult[0] * adResult[0] ) +
+                                   ( adResult[1] * adResult[1] ) +
+                                   ( adResult[2] * adResult[2] ) +
+                                   ( adResult[3] * adResult[3] );
+        if( 0.0 < dMagnitudeSquared )
+        {
+            double dInverse = 1.0 / std::sqrt( dMagnitudeSquared );
+            adResult[0] *= dInverse;
+            adResult[1] *= dInverse;
+            adResult[2] *= dInverse;
+            adResult[3] *= dInverse;
+        }
+    }
+    a_padResult[0] = adResult[0];
+    a_padResult[1] = adResult[1];
+    a_padResult[2] = adResult[2];
+    a_padResult[3] = adResult[3];
 }
 
 // Turn into transform
@@ -0,0 +1,143 @@
+/******************************************************************************
+ * File:               ResidencyList.inl
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Function implementations for ResidencyList.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Creation.
+ ******************************************************************************/
+
+#ifndef RESIDENCY_LIST__INL
+#define RESIDENCY_LIST__INL
+
+#include "../Declarations/ResidencyList.h"
+
+namespace Utility
+{
+
+// Constructor
+template< typename T >
+ResidencyList< T >::ResidencyList( unsigned long long a_ulBudget )
+    : m_ulBudget( a_ulBudget ), m_ulBytes( 0 )
+{
+    ResetStatistics();
+}
+
+// Move a resident resource to the front of the unpinned list, or add a new one
+// there.  Splicing doesn't invalidate the iterator in the lookup.
+template< typename T >
+bool ResidencyList< T >::Use( const T& ac_rItem, unsigned long long a_ulBytes )
+{
+    typename std::unordered_map< T, EntryIterator >::iterator oFound =
+        m_oLookup.find( ac_rItem );
+    if( m_oLookup.end() == oFound )
+    {
+        Entry oEntry = { ac_rItem, a_ulBytes, false };
+        m_oUnpinned.push_front( oEntry );
+        m_oLookup[ ac_rItem ] = m_oUnpinned.begin();
+        m_ulBytes += a_ulBytes;
+        ++m_oStats.ulMisses;
+        return false;
+    }
+    EntryIterator oEntry = oFound->second;
+    m_ulBytes = m_ulBytes - oEntry->ulBytes + a_ulBytes;
+    oEntry->ulBytes = a_ulBytes;
+    if( !oEntry->bPinned )
+    {
+        m_oUnpinned.splice( m_oUnpinned.begin(), m_oUnpinned, oEntry );
+    }
+    ++m_oStats.ulHits;
+    return true;
+}
+
+// Take a resource off whichever list it's on
+template< typename T >
+bool ResidencyList< T >::Remove( const T& ac_rItem )
+{
+    typename std::unordered_map< T, EntryIterator >::iterator oFound =
+        m_oLookup.find( ac_rItem );
+    if( m_oLookup.end() == oFound )
+    {
+        return false;
+    }
+    EntryIterator oEntry = oFound->second;
+    m_ulBytes -= oEntry->ulBytes;
+    ( oEntry->bPinned ? m_oPinned : m_oUnpinned ).erase( oEntry );
+    m_oLookup.erase( oFound );
+    return true;
+}
+
+// Move a resource between the pinned and unpinned lists.  Unpinning puts it
+// at the front, as if it had just been used.
+template< typename T >
+bool ResidencyList< T >::Pin( const T& ac_rItem, bool a_bPinned )
+{
+    typename std::unordered_map< T, EntryIterator >::iterator oFound =
+        m_oLookup.find( ac_rItem );
+    if( m_oLookup.end() == oFound )
+    {
+        return false;
+    }
+    EntryIterator oEntry = oFound->second;
+    if( oEntry->bPinned != a_bPinned )
+    {
+        oEntry->bPinned = a_bPinned;
+        if( a_bPinned )
+        {
+            m_oPinned.splice( m_oPinned.begin(), m_oUnpinned, oEntry );
+        }
+        else
+        {
+            m_oUnpinned.splice( m_oUnpinned.begin(), m_oPinned, oEntry );
+        }
+    }
+    return true;
+}
+template< typename T >
+bool ResidencyList< T >::IsPinned( const T& ac_rItem ) const
+{
+    typename std::unordered_map< T, EntryIterator >::const_iterator oFound =
+        m_oLookup.find( ac_rItem );
+    return ( m_oLookup.end() != oFound && oFound->second->bPinned );
+}
+
+// The least recently used unpinned resource is at the back of the list, but
+// the one at the front is never evicted
+template< typename T >
+bool ResidencyList< T >::NextEviction( T& a_rItem )
+{
+    if( !IsOverBudget() || 2 > m_oUnpinned.size() )
+    {
+        return false;
+    }
+    Entry& roEntry = m_oUnpinned.back();
+    a_rItem = roEntry.oItem;
+    m_ulBytes -= roEntry.ulBytes;
+    ++m_oStats.ulEvictions;
+    m_oStats.ulEvictedBytes += roEntry.ulBytes;
+    m_oLookup.erase( roEntry.oItem );
+    m_oUnpinned.pop_back();
+    return true;
+}
+
+template< typename T >
+void ResidencyList< T >::ResetStatistics()
+{
+    m_oStats.ulHits = 0;
+    m_oStats.ulMisses = 0;
+    m_oStats.ulEvictions = 0;
+    m_oStats.ulEvictedBytes = 0;
+}
+
+template< typename T >
+void ResidencyList< T >::Clear()
+{
+    m_oUnpinned.clear();
+    m_oPinned.clear();
+    m_oLookup.clear();
+    m_ulBytes = 0;
+}
+
+}   // namespace Utility
+
+#endif  // RESIDENCY_LIST__INL
@@ -4,8 +4,8 @@
  * Date Created:       January 5, 2014
  * Description:        Inline function implementations for Transform.h.
  *                      Remember that this library uses row vectors, not column.
- * Last Modified:      June 26, 2014
- * Last Modification:  Debugging.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Added array transformation file.
  ******************************************************************************/
 
 #ifndef TRANSFORM__INL
@@ -15,6 +15,8 @@
 #include "../Declarations/ImExportMacro.h"
 
 // Separate files to keep file size down
+#include "Transform_Affine.inl"
+#include "Transform_Arrays.inl"
 #include "Transform_Scale.inl"
 #include "Transform_TranslateRotate.inl"
 
@@ -26,11 +28,36 @@ INLINE Transform
    TransformationAbout( const Transform& ac_roTransform,
                         const Point& ac_roOrigin )
 {
-    if( ac_roOrigin == Point::Origin() )
+    // Compare against zero directly instead of through Point::Origin(), since
+    // this gets called by nearly every other builder in this file
+    if( 0.0 == ac_roOrigin.x && 0.0 == ac_roOrigin.y )
     {
         return ac_roTransform;
     }
-    return Translation( -ac_roOrigin ) * ac_roTransform * Translation( ac_roOrigin );
+
+    // Projections and other non-affine transforms need the full product
+    if( 0.0 != ac_roTransform[0][2] || 0.0 != ac_roTransform[1][2] ||
+        1.0 != ac_roTransform[2][2] )
+    {
+        return Translation( -ac_roOrigin ) * ac_roTransform *
+               Translation( ac_roOrigin );
+    }
+
+    // Otherwise, only the translation row changes.  Terms are added in the same
+    // order as the full product, so the result is exactly the same.
+    Transform oResult( ac_roTransform );
+    for( unsigned int j = 0; j < 2; ++j )
+    {
+        double dTranslation = 0.0;
+        for( unsigned int k = 0; k < 2; ++k )
+        {
+            dTranslation += -ac_roOrigin[k] * ac_roTransform[k][j];
+        }
+        dTranslation += ac_roTransform[2][j];
+        dTranslation += ac_roOrigin[j];
+        oResult[2][j] = dTranslation;
+    }
+    return oResult;
 }
 
 }   // namespace Plane
@@ -43,11 +70,37 @@ INLINE Transform
    TransformationAbout( const Transform& ac_roTransform,
                         const Point& ac_roOrigin )
 {
-    if( ac_roOrigin == Point::Origin() )
+    // Compare against zero directly instead of through Point::Origin(), since
+    // this gets called by nearly every other builder in this file
+    if( 0.0 == ac_roOrigin.x && 0.0 == ac_roOrigin.y &&
+        0.0 == ac_roOrigin.z )
     {
         return ac_roTransform;
     }
-    return Translation( -ac_roOrigin ) * ac_roTransform * Translation( ac_roOrigin );
+
+    // Projections and other non-affine transforms need the full product
+    if( 0.0 != ac_roTransform[0][3] || 0.0 != ac_roTransform[1][3] ||
+        0.0 != ac_roTransform[2][3] || 1.0 != ac_roTransform[3][3] )
+    {
+        return Translation( -ac_roOrigin ) * ac_roTransform *
+               Translation( ac_roOrigin );
+    }
+
+    // Otherwise, only the translation row changes.  Terms are added in the same
+    // order as the full product, so the result is exactly the same.
+    Transform oResult( ac_roTransform );
+    for( unsigned int j = 0; j < 3; ++j )
+    {
+        double dTranslation = 0.0;
+        for( unsigned int k = 0; k < 3; ++k )
+        {
+            dTranslation += -ac_roOrigin[k] * ac_roTransform[k][j];
+        }
+        dTranslation += ac_roTransform[3][j];
+        dTranslation += ac_roOrigin[j];
+        oResult[3][j] = dTranslation;
+    }
+    return oResult;
 }
 
 // Perspective project onto plane z = -nearDistance.  Remap coordinates from
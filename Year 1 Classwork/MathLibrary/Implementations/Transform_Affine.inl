@@ -0,0 +1,221 @@
+/******************************************************************************
+ * File:               Transform_Affine.inl
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Inline function implementations for compact affine
+ *                      transformations.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Creation.
+ ******************************************************************************/
+
+#ifndef TRANSFORM__AFFINE__INL
+#define TRANSFORM__AFFINE__INL
+
+#include "../Declarations/Transform.h"
+#include "../Declarations/ImExportMacro.h"
+
+namespace Plane
+{
+
+// Make an affine transformation from a linear transformation followed by a
+// translation
+INLINE AffineTransform Affine( const PointTransform& ac_roLinear,
+                               const Point& ac_roTranslation )
+{
+    double adAffine[3][2] =
+    { { ac_roLinear[0][0],  ac_roLinear[0][1] },
+      { ac_roLinear[1][0],  ac_roLinear[1][1] },
+      { ac_roTranslation.x, ac_roTranslation.y } };
+    return AffineTransform( adAffine );
+}
+
+// Scale, then rotate, then translate
+INLINE AffineTransform Affine( const Point& ac_roScale,
+                               const PointTransform& ac_roRotation,
+                               const Point& ac_roTranslation )
+{
+    double adAffine[3][2] =
+    { { ac_roScale.x * ac_roRotation[0][0], ac_roScale.x * ac_roRotation[0][1] },
+      { ac_roScale.y * ac_roRotation[1][0], ac_roScale.y * ac_roRotation[1][1] },
+      { ac_roTranslation.x,                 ac_roTranslation.y } };
+    return AffineTransform( adAffine );
+}
+
+// Convert between affine and full transformations.  Converting a non-affine
+// transformation drops the last column.
+INLINE AffineTransform Affine( const Transform& ac_roTransform )
+{
+    return AffineTransform( ac_roTransform );
+}
+INLINE Transform Homogeneous( const AffineTransform& ac_roAffine )
+{
+    double adTransform[3][3] =
+    { { ac_roAffine[0][0], ac_roAffine[0][1], 0.0 },
+      { ac_roAffine[1][0], ac_roAffine[1][1], 0.0 },
+      { ac_roAffine[2][0], ac_roAffine[2][1], 1.0 } };
+    return Transform( adTransform );
+}
+
+// Affine versions of scaling and translation
+INLINE AffineTransform AffineScaling( double a_dFactor )
+{
+    return Affine( PointScaling( a_dFactor ) );
+}
+INLINE AffineTransform AffineScaling( const Point& ac_roFactor )
+{
+    return Affine( PointScaling( ac_roFactor ) );
+}
+INLINE AffineTransform AffineTranslation( const Point& ac_roTranslation )
+{
+    return Affine( PointTransform( 0.0, 1.0 ), ac_roTranslation );
+}
+
+// Same result as Homogeneous( ac_roFirst ) * Homogeneous( ac_roSecond ),
+// without the multiplications by the constant last column
+INLINE AffineTransform Compose( const AffineTransform& ac_roFirst,
+                                const AffineTransform& ac_roSecond )
+{
+    AffineTransform oResult;
+    for( unsigned int i = 0; i < 3; ++i )
+    {
+        for( unsigned int j = 0; j < 2; ++j )
+        {
+            double dResult = 0.0;
+            for( unsigned int k = 0; k < 2; ++k )
+            {
+                dResult += ac_roFirst[i][k] * ac_roSecond[k][j];
+            }
+            oResult[i][j] = ( 2 == i ? dResult + ac_roSecond[2][j] : dResult );
+        }
+    }
+    return oResult;
+}
+
+// Invert the linear part and move the translation to match.  Like
+// Matrix::Inverse(), returns zero if the transformation can't be inverted.
+INLINE AffineTransform AffineInverse( const AffineTransform& ac_roAffine )
+{
+    PointTransform oLinear;
+    if( !PointTransform( ac_roAffine ).Inverse( oLinear ) )
+    {
+        return AffineTransform::Zero();
+    }
+    Point oTranslation;
+    for( unsigned int j = 0; j < 2; ++j )
+    {
+        oTranslation[j] = -( ac_roAffine[2][0] * oLinear[0][j] +
+                             ac_roAffine[2][1] * oLinear[1][j] );
+    }
+    return Affine( oLinear, oTranslation );
+}
+
+}   // namespace Plane
+
+namespace Space
+{
+
+// Make an affine transformation from a linear transformation followed by a
+// translation
+INLINE AffineTransform Affine( const PointTransform& ac_roLinear,
+                               const Point& ac_roTranslation )
+{
+    double adAffine[4][3] =
+    { { ac_roLinear[0][0],  ac_roLinear[0][1],  ac_roLinear[0][2] },
+      { ac_roLinear[1][0],  ac_roLinear[1][1],  ac_roLinear[1][2] },
+      { ac_roLinear[2][0],  ac_roLinear[2][1],  ac_roLinear[2][2] },
+      { ac_roTranslation.x, ac_roTranslation.y, ac_roTranslation.z } };
+    return AffineTransform( adAffine );
+}
+
+// Scale, then rotate, then translate - the same result as
+// Scaling( scale ) * rotation * Translation( translation ) with none of the
+// multiplications by zero
+INLINE AffineTransform Affine( const Point& ac_roScale,
+                               const PointTransform& ac_roRotation,
+                               const Point& ac_roTranslation )
+{
+    double adAffine[4][3];
+    for( unsigned int i = 0; i < 3; ++i )
+    {
+        for( unsigned int j = 0; j < 3; ++j )
+        {
+            adAffine[i][j] = ac_roScale[i] * ac_roRotation[i][j];
+        }
+        adAffine[3][i] = ac_roTranslation[i];
+    }
+    return AffineTransform( adAffine );
+}
+
+// Convert between affine and full transformations.  Converting a non-affine
+// transformation drops the last column.
+INLINE AffineTransform Affine( const Transform& ac_roTransform )
+{
+    return AffineTransform( ac_roTransform );
+}
+INLINE Transform Homogeneous( const AffineTransform& ac_roAffine )
+{
+    double adTransform[4][4] =
+    { { ac_roAffine[0][0], ac_roAffine[0][1], ac_roAffine[0][2], 0.0 },
+      { ac_roAffine[1][0], ac_roAffine[1][1], ac_roAffine[1][2], 0.0 },
+      { ac_roAffine[2][0], ac_roAffine[2][1], ac_roAffine[2][2], 0.0 },
+      { ac_roAffine[3][0], ac_roAffine[3][1], ac_roAffine[3][2], 1.0 } };
+    return Transform( adTransform );
+}
+
+// Affine versions of scaling and translation
+INLINE AffineTransform AffineScaling( double a_dFactor )
+{
+    return Affine( PointScaling( a_dFactor ) );
+}
+INLINE AffineTransform AffineScaling( const Point& ac_roFactor )
+{
+    return Affine( PointScaling( ac_roFactor ) );
+}
+INLINE AffineTransform AffineTranslation( const Point& ac_roTranslation )
+{
+    return Affine( PointTransform( 0.0, 1.0 ), ac_roTranslation );
+}
+
+// Same result as Homogeneous( ac_roFirst ) * Homogeneous( ac_roSecond ),
+// without the multiplications by the constant last column
+INLINE AffineTransform Compose( const AffineTransform& ac_roFirst,
+                                const AffineTransform& ac_roSecond )
+{
+    AffineTransform oResult;
+    for( unsigned int i = 0; i < 4; ++i )
+    {
+        for( unsigned int j = 0; j < 3; ++j )
+        {
+            double dResult = 0.0;
+            for( unsigned int k = 0; k < 3; ++k )
+            {
+                dResult += ac_roFirst[i][k] * ac_roSecond[k][j];
+            }
+            oResult[i][j] = ( 3 == i ? dResult + ac_roSecond[3][j] : dResult );
+        }
+    }
+    return oResult;
+}
+
+// Invert the linear part and move the translation to match.  Like
+// Matrix::Inverse(), returns zero if the transformation can't be inverted.
+INLINE AffineTransform AffineInverse( const AffineTransform& ac_roAffine )
+{
+    PointTransform oLinear;
+    if( !PointTransform( ac_roAffine ).Inverse( oLinear ) )
+    {
+        return AffineTransform::Zero();
+    }
+    Point oTranslation;
+    for( unsigned int j = 0; j < 3; ++j )
+    {
+        oTranslation[j] = -( ac_roAffine[3][0] * oLinear[0][j] +
+                             ac_roAffine[3][1] * oLinear[1][j] +
+                             ac_roAffine[3][2] * oLinear[2][j] );
+    }
+    return Affine( oLinear, oTranslation );
+}
+
+}   // namespace Space
+
+#endif  // TRANSFORM__AFFINE__INL
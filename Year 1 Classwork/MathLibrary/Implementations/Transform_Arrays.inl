@@ -0,0 +1,450 @@
+/******************************************************************************
+ * File:               Transform_Arrays.inl
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Inline function implementations for transforming whole
+ *                      arrays of points at once.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Creation.
+ ******************************************************************************/
+
+#ifndef TRANSFORM__ARRAYS__INL
+#define TRANSFORM__ARRAYS__INL
+
+#include "../Declarations/Transform.h"
+#include "../Declarations/ImExportMacro.h"
+
+// Use SSE2 to transform two points at a time where the target supports it
+#if defined _M_X64 || ( defined _M_IX86_FP && _M_IX86_FP >= 2 ) || \
+    defined __SSE2__
+#define TRANSFORM__ARRAYS__INL__SSE2
+#include <emmintrin.h>
+#endif
+
+// Split very large arrays across threads where the parallel patterns library
+// is available
+#if defined _MSC_VER && _MSC_VER >= 1600
+#define TRANSFORM__ARRAYS__INL__PPL
+#include <ppl.h>
+#endif
+
+// Arrays with at least this many points are split into blocks transformed on
+// separate threads, if threads are available.  Define as 0 to never split.
+#ifndef MATH_LIBRARY_PARALLEL_TRANSFORM_COUNT
+#define MATH_LIBRARY_PARALLEL_TRANSFORM_COUNT 65536
+#endif
+#define TRANSFORM__ARRAYS__INL__BLOCK_SIZE 16384
+
+namespace Math
+{
+
+// Copy a transformation into a square array of size D, filling in whatever
+// the transformation doesn't have from the identity matrix
+template< unsigned int D, unsigned int M, unsigned int N >
+inline void FlattenTransform( const Matrix< double, M, N >& ac_roTransform,
+                              double (&a_raadResult)[ D ][ D ] )
+{
+    for( unsigned int i = 0; i < D; ++i )
+    {
+        for( unsigned int j = 0; j < D; ++j )
+        {
+            a_raadResult[i][j] = ( i < M && j < N ? ac_roTransform[i][j]
+                                                  : ( i == j ? 1.0 : 0.0 ) );
+        }
+    }
+}
+
+// Transform points [a_uiBegin, a_uiEnd) from N+1 coordinate streams into N+1
+// coordinate streams, where coordinate k of point i is at
+// ac_rapcdIn[k][ i * a_uiInStride ].  The last stream is only used for
+// homogeneous vectors.  Arithmetic is done in the same order as transforming
+// each point with the matrix classes, so the results are the same.
+//   t_bTranslate   - use the last row of the transformation
+//   t_bDivide      - divide by the resulting h value, if it isn't zero
+//   t_bHomogeneous - read and write h values, dividing by the input h value
+//                    first if it isn't zero
+template< unsigned int N, bool t_bTranslate, bool t_bDivide,
+          bool t_bHomogeneous >
+inline void TransformCoordinates( const double* const (&ac_rapcdIn)[ N + 1 ],
+                                  unsigned int a_uiInStride,
+                                  double* const (&ac_rapdOut)[ N + 1 ],
+                                  unsigned int a_uiOutStride,
+                                  const double (&ac_raadMatrix)[ N + 1 ][ N + 1 ],
+                                  unsigned int a_uiBegin, unsigned int a_uiEnd )
+{
+    static const unsigned int D = ( t_bHomogeneous ? N + 1 : N );
+    unsigned int i = a_uiBegin;
+
+#ifdef TRANSFORM__ARRAYS__INL__SSE2
+    const __m128d oZero = _mm_setzero_pd();
+    const __m128d oOne = _mm_set1_pd( 1.0 );
+    for( ; i + 2 <= a_uiEnd; i += 2 )
+    {
+        // load coordinates for two points
+        __m128d aoIn[ N + 1 ];
+        for( unsigned int k = 0; k < D; ++k )
+        {
+            aoIn[k] = ( 1 == a_uiInStride
+                        ? _mm_loadu_pd( ac_rapcdIn[k] + i )
+                        : _mm_set_pd( ac_rapcdIn[k][ ( i + 1 ) * a_uiInStride ],
+                                      ac_rapcdIn[k][ i * a_uiInStride ] ) );
+        }
+        if( t_bHomogeneous )
+        {
+            // divide by h where h isn't zero, so h becomes one
+            __m128d oMask = _mm_cmpneq_pd( aoIn[N], oZero );
+            __m128d oDivisor = _mm_or_pd( _mm_and_pd( oMask, aoIn[N] ),
+                                          _mm_andnot_pd( oMask, oOne ) );
+            for( unsigned int k = 0; k <= N; ++k )
+            {
+                aoIn[k] = _mm_div_pd( aoIn[k], oDivisor );
+            }
+        }
+
+        // multiply
+        __m128d aoOut[ N + 1 ];
+        for( unsigned int j = 0; j < ( t_bDivide ? N + 1 : N ); ++j )
+        {
+            __m128d oResult =
+                _mm_mul_pd( aoIn[0], _mm_set1_pd( ac_raadMatrix[0][j] ) );
+            for( unsigned int k = 1; k < N; ++k )
+            {
+                oResult = _mm_add_pd( oResult,
+                    _mm_mul_pd( aoIn[k], _mm_set1_pd( ac_raadMatrix[k][j] ) ) );
+            }
+            if( t_bHomogeneous )
+            {
+                oResult = _mm_add_pd( oResult,
+                    _mm_mul_pd( aoIn[N], _mm_set1_pd( ac_raadMatrix[N][j] ) ) );
+            }
+            else if( t_bTranslate )
+            {
+                oResult = _mm_add_pd( oResult,
+                                      _mm_set1_pd( ac_raadMatrix[N][j] ) );
+            }
+            aoOut[j] = oResult;
+        }
+
+        // divide by the resulting h where it isn't zero
+        if( t_bDivide )
+        {
+            __m128d oMask = _mm_cmpneq_pd( aoOut[N], oZero );
+            __m128d oDivisor = _mm_or_pd( _mm_and_pd( oMask, aoOut[N] ),
+                                          _mm_andnot_pd( oMask, oOne ) );
+            for( unsigned int j = 0; j < D; ++j )
+            {
+                aoOut[j] = _mm_div_pd( aoOut[j], oDivisor );
+            }
+        }
+
+        // store the results
+        for( unsigned int j = 0; j < D; ++j )
+        {
+            if( 1 == a_uiOutStride )
+            {
+                _mm_storeu_pd( ac_rapdOut[j] + i, aoOut[j] );
+            }
+            else
+            {
+                _mm_storel_pd( ac_rapdOut[j] + i * a_uiOutStride, aoOut[j] );
+                _mm_storeh_pd( ac_rapdOut[j] + ( i + 1 ) * a_uiOutStride,
+                               aoOut[j] );
+            }
+        }
+    }
+#endif
+
+    // one at a time
+    for( ; i < a_uiEnd; ++i )
+    {
+        double adIn[ N + 1 ];
+        for( unsigned int k = 0; k < D; ++k )
+        {
+            adIn[k] = ac_rapcdIn[k][ i * a_uiInStride ];
+        }
+        if( t_bHomogeneous && 0.0 != adIn[N] )
+        {
+            double dH = adIn[N];
+            for( unsigned int k = 0; k <= N; ++k )
+            {
+                adIn[k] /= dH;
+            }
+        }
+        double adOut[ N + 1 ];
+        for( unsigned int j = 0; j < ( t_bDivide ? N + 1 : N ); ++j )
+        {
+            double dResult = adIn[0] * ac_raadMatrix[0][j];
+            for( unsigned int k = 1; k < N; ++k )
+            {
+                dResult += adIn[k] * ac_raadMatrix[k][j];
+            }
+            if( t_bHomogeneous )
+            {
+                dResult += adIn[N] * ac_raadMatrix[N][j];
+            }
+            else if( t_bTranslate )
+            {
+                dResult += ac_raadMatrix[N][j];
+            }
+            adOut[j] = dResult;
+        }
+        if( t_bDivide && 0.0 != adOut[N] )
+        {
+            double dH = adOut[N];
+            for( unsigned int j = 0; j < D; ++j )
+            {
+                adOut[j] /= dH;
+            }
+        }
+        for( unsigned int j = 0; j < D; ++j )
+        {
+            ac_rapdOut[j][ i * a_uiOutStride ] = adOut[j];
+        }
+    }
+}
+
+// Transform a_uiCount points, splitting the work across threads if there are
+// enough of them
+template< unsigned int N, bool t_bTranslate, bool t_bDivide,
+          bool t_bHomogeneous >
+inline void TransformArray( const double* const (&ac_rapcdIn)[ N + 1 ],
+                            unsigned int a_uiInStride,
+                            double* const (&ac_rapdOut)[ N + 1 ],
+                            unsigned int a_uiOutStride,
+                            const double (&ac_raadMatrix)[ N + 1 ][ N + 1 ],
+                            unsigned int a_uiCount )
+{
+#ifdef TRANSFORM__ARRAYS__INL__PPL
+    if( 0 < MATH_LIBRARY_PARALLEL_TRANSFORM_COUNT &&
+        MATH_LIBRARY_PARALLEL_TRANSFORM_COUNT <= a_uiCount )
+    {
+        const unsigned int cuiBlockSize = TRANSFORM__ARRAYS__INL__BLOCK_SIZE;
+        unsigned int uiBlocks = ( a_uiCount + cuiBlockSize - 1 ) / cuiBlockSize;
+        Concurrency::parallel_for( 0u, uiBlocks, [&]( unsigned int a_uiBlock )
+        {
+            unsigned int uiBegin = a_uiBlock * cuiBlockSize;
+            unsigned int uiEnd = ( a_uiCount - uiBegin < cuiBlockSize
+                                   ? a_uiCount : uiBegin + cuiBlockSize );
+            TransformCoordinates< N, t_bTranslate, t_bDivide, t_bHomogeneous >
+                ( ac_rapcdIn, a_uiInStride, ac_rapdOut, a_uiOutStride,
+                  ac_raadMatrix, uiBegin, uiEnd );
+        } );
+        return;
+    }
+#endif
+    TransformCoordinates< N, t_bTranslate, t_bDivide, t_bHomogeneous >
+        ( ac_rapcdIn, a_uiInStride, ac_rapdOut, a_uiOutStride,
+          ac_raadMatrix, 0, a_uiCount );
+}
+
+}   // namespace Math
+
+namespace Plane
+{
+
+// Interleaved arrays - x, y for each point, or x, y, h for each homogeneous
+// vector
+INLINE void TransformPoints( const double* ac_padPoints,
+                             double* a_padResults,
+                             unsigned int a_uiCount,
+                             const Transform& ac_roTransform )
+{
+    double aadMatrix[3][3];
+    FlattenTransform( ac_roTransform, aadMatrix );
+    const double* const apcdIn[3] = { ac_padPoints, ac_padPoints + 1, nullptr };
+    double* const apdOut[3] = { a_padResults, a_padResults + 1, nullptr };
+    TransformArray< 2, true, true, false >( apcdIn, 2, apdOut, 2,
+                                            aadMatrix, a_uiCount );
+}
+INLINE void TransformPoints( const double* ac_padPoints,
+                             double* a_padResults,
+                             unsigned int a_uiCount,
+                             const AffineTransform& ac_roTransform )
+{
+    double aadMatrix[3][3];
+    FlattenTransform( ac_roTransform, aadMatrix );
+    const double* const apcdIn[3] = { ac_padPoints, ac_padPoints + 1, nullptr };
+    double* const apdOut[3] = { a_padResults, a_padResults + 1, nullptr };
+    TransformArray< 2, true, false, false >( apcdIn, 2, apdOut, 2,
+                                             aadMatrix, a_uiCount );
+}
+INLINE void TransformDirections( const double* ac_padDirections,
+                                 double* a_padResults,
+                                 unsigned int a_uiCount,
+                                 const PointTransform& ac_roTransform )
+{
+    double aadMatrix[3][3];
+    FlattenTransform( ac_roTransform, aadMatrix );
+    const double* const apcdIn[3] =
+        { ac_padDirections, ac_padDirections + 1, nullptr };
+    double* const apdOut[3] = { a_padResults, a_padResults + 1, nullptr };
+    TransformArray< 2, false, false, false >( apcdIn, 2, apdOut, 2,
+                                              aadMatrix, a_uiCount );
+}
+INLINE void TransformHVectors( const double* ac_padVectors,
+                               double* a_padResults,
+                               unsigned int a_uiCount,
+                               const Transform& ac_roTransform )
+{
+    double aadMatrix[3][3];
+    FlattenTransform( ac_roTransform, aadMatrix );
+    const double* const apcdIn[3] =
+        { ac_padVectors, ac_padVectors + 1, ac_padVectors + 2 };
+    double* const apdOut[3] =
+        { a_padResults, a_padResults + 1, a_padResults + 2 };
+    TransformArray< 2, true, true, true >( apcdIn, 3, apdOut, 3,
+                                           aadMatrix, a_uiCount );
+}
+
+// Separate arrays for each coordinate
+INLINE void TransformPoints( const double* ac_padX, const double* ac_padY,
+                             double* a_padResultX, double* a_padResultY,
+                             unsigned int a_uiCount,
+                             const Transform& ac_roTransform )
+{
+    double aadMatrix[3][3];
+    FlattenTransform( ac_roTransform, aadMatrix );
+    const double* const apcdIn[3] = { ac_padX, ac_padY, nullptr };
+    double* const apdOut[3] = { a_padResultX, a_padResultY, nullptr };
+    TransformArray< 2, true, true, false >( apcdIn, 1, apdOut, 1,
+                                            aadMatrix, a_uiCount );
+}
+INLINE void TransformPoints( const double* ac_padX, const double* ac_padY,
+                             double* a_padResultX, double* a_padResultY,
+                             unsigned int a_uiCount,
+                             const AffineTransform& ac_roTransform )
+{
+    double aadMatrix[3][3];
+    FlattenTransform( ac_roTransform, aadMatrix );
+    const double* const apcdIn[3] = { ac_padX, ac_padY, nullptr };
+    double* const apdOut[3] = { a_padResultX, a_padResultY, nullptr };
+    TransformArray< 2, true, false, false >( apcdIn, 1, apdOut, 1,
+                                             aadMatrix, a_uiCount );
+}
+INLINE void TransformDirections( const double* ac_padX, const double* ac_padY,
+                                 double* a_padResultX, double* a_padResultY,
+                                 unsigned int a_uiCount,
+                                 const PointTransform& ac_roTransform )
+{
+    double aadMatrix[3][3];
+    FlattenTransform( ac_roTransform, aadMatrix );
+    const double* const apcdIn[3] = { ac_padX, ac_padY, nullptr };
+    double* const apdOut[3] = { a_padResultX, a_padResultY, nullptr };
+    TransformArray< 2, false, false, false >( apcdIn, 1, apdOut, 1,
+                                              aadMatrix, a_uiCount );
+}
+
+}   // namespace Plane
+
+namespace Space
+{
+
+// Interleaved arrays - x, y, z for each point, or x, y, z, h for each
+// homogeneous vector
+INLINE void TransformPoints( const double* ac_padPoints,
+                             double* a_padResults,
+                             unsigned int a_uiCount,
+                             const Transform& ac_roTransform )
+{
+    double aadMatrix[4][4];
+    FlattenTransform( ac_roTransform, aadMatrix );
+    const double* const apcdIn[4] =
+        { ac_padPoints, ac_padPoints + 1, ac_padPoints + 2, nullptr };
+    double* const apdOut[4] =
+        { a_padResults, a_padResults + 1, a_padResults + 2, nullptr };
+    TransformArray< 3, true, true, false >( apcdIn, 3, apdOut, 3,
+                                            aadMatrix, a_uiCount );
+}
+INLINE void TransformPoints( const double* ac_padPoints,
+                             double* a_padResults,
+                             unsigned int a_uiCount,
+                             const AffineTransform& ac_roTransform )
+{
+    double aadMatrix[4][4];
+    FlattenTransform( ac_roTransform, aadMatrix );
+    const double* const apcdIn[4] =
+        { ac_padPoints, ac_padPoints + 1, ac_padPoints + 2, nullptr };
+    double* const apdOut[4] =
+        { a_padResults, a_padResults + 1, a_padResults + 2, nullptr };
+    TransformArray< 3, true, false, false >( apcdIn, 3, apdOut, 3,
+                                             aadMatrix, a_uiCount );
+}
+INLINE void TransformDirections( const double* ac_padDirections,
+                                 double* a_padResults,
+                                 unsigned int a_uiCount,
+                                 const PointTransform& ac_roTransform )
+{
+    double aadMatrix[4][4];
+    FlattenTransform( ac_roTransform, aadMatrix );
+    const double* const apcdIn[4] = { ac_padDirections, ac_padDirections + 1,
+                                      ac_padDirections + 2, nullptr };
+    double* const apdOut[4] =
+        { a_padResults, a_padResults + 1, a_padResults + 2, nullptr };
+    TransformArray< 3, false, false, false >( apcdIn, 3, apdOut, 3,
+                                              aadMatrix, a_uiCount );
+}
+INLINE void TransformHVectors( const double* ac_padVectors,
+                               double* a_padResults,
+                               unsigned int a_uiCount,
+                               const Transform& ac_roTransform )
+{
+    double aadMatrix[4][4];
+    FlattenTransform( ac_roTransform, aadMatrix );
+    const double* const apcdIn[4] = { ac_padVectors, ac_padVectors + 1,
+                                      ac_padVectors + 2, ac_padVectors + 3 };
+    double* const apdOut[4] = { a_padResults, a_padResults + 1,
+                                a_padResults + 2, a_padResults + 3 };
+    TransformArray< 3, true, true, true >( apcdIn, 4, apdOut, 4,
+                                           aadMatrix, a_uiCount );
+}
+
+// Separate arrays for each coordinate
+INLINE void TransformPoints( const double* ac_padX, const double* ac_padY,
+                             const double* ac_padZ,
+                             double* a_padResultX, double* a_padResultY,
+                             double* a_padResultZ,
+                             unsigned int a_uiCount,
+                             const Transform& ac_roTransform )
+{
+    double aadMatrix[4][4];
+    FlattenTransform( ac_roTransform, aadMatrix );
+    const double* const apcdIn[4] = { ac_padX, ac_padY, ac_padZ, nullptr };
+    double* const apdOut[4] =
+        { a_padResultX, a_padResultY, a_padResultZ, nullptr };
+    TransformArray< 3, true, true, false >( apcdIn, 1, apdOut, 1,
+                                            aadMatrix, a_uiCount );
+}
+INLINE void TransformPoints( const double* ac_padX, const double* ac_padY,
+                             const double* ac_padZ,
+                             double* a_padResultX, double* a_padResultY,
+                             double* a_padResultZ,
+                             unsigned int a_uiCount,
+                             const AffineTransform& ac_roTransform )
+{
+    double aadMatrix[4][4];
+    FlattenTransform( ac_roTransform, aadMatrix );
+    const double* const apcdIn[4] = { ac_padX, ac_padY, ac_padZ, nullptr };
+    double* const apdOut[4] =
+        { a_padResultX, a_padResultY, a_padResultZ, nullptr };
+    TransformArray< 3, true, false, false >( apcdIn, 1, apdOut, 1,
+                                             aadMatrix, a_uiCount );
+}
+INLINE void TransformDirections( const double* ac_padX, const double* ac_padY,
+                                 const double* ac_padZ,
+                                 double* a_padResultX, double* a_padResultY,
+                                 double* a_padResultZ,
+                                 unsigned int a_uiCount,
+                                 const PointTransform& ac_roTransform )
+{
+    double aadMatrix[4][4];
+    FlattenTransform( ac_roTransform, aadMatrix );
+    const double* const apcdIn[4] = { ac_padX, ac_padY, ac_padZ, nullptr };
+    double* const apdOut[4] =
+        { a_padResultX, a_padResultY, a_padResultZ, nullptr };
+    TransformArray< 3, false, false, false >( apcdIn, 1, apdOut, 1,
+                                              aadMatrix, a_uiCount );
+}
+
+}   // namespace Space
+
+#endif  // TRANSFORM__ARRAYS__INL
@@ -4,8 +4,8 @@
  * Date Created:       January 5, 2014
  * Description:        Inline function implementations for making scale
  *                      transformations.
- * Last Modified:      February 10, 2014
- * Last Modification:  Templatizing PointVector.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Uniform scaling without going through Identity().
  ******************************************************************************/
 
 #ifndef TRANSFORM__SCALE__INL
@@ -20,13 +20,14 @@ namespace Plane
 // Scale by a given factor
 INLINE PointTransform PointScaling( double a_dFactor )
 {
-    return PointTransform::Identity() * a_dFactor;
+    return PointTransform( 0.0, a_dFactor );
 }
 INLINE Transform Scaling( double a_dFactor, const Point& ac_roOrigin )
 {
-    Transform oScale = PointTransform::Identity() * a_dFactor;
-    oScale[2][2] = 1.0;
-    return TransformationAbout( oScale, ac_roOrigin );
+    double adScale[3][3] = { { a_dFactor, 0.0,       0.0 },
+                             { 0.0,       a_dFactor, 0.0 },
+                             { 0.0,       0.0,       1.0 } };
+    return TransformationAbout( Transform( adScale ), ac_roOrigin );
 }
 
 // Scale by the given factors along each axis
@@ -68,13 +69,15 @@ namespace Space
 // Scale by a given factor
 INLINE PointTransform PointScaling( double a_dFactor )
 {
-    return PointTransform::Identity() * a_dFactor;
+    return PointTransform( 0.0, a_dFactor );
 }
 INLINE Transform Scaling( double a_dFactor, const Point& ac_roOrigin )
 {
-    Transform oScale = PointScaling( a_dFactor );
-    oScale[3][3] = 1.0;
-    return TransformationAbout( oScale, ac_roOrigin );
+    double adScale[4][4] = { { a_dFactor, 0.0,       0.0,       0.0 },
+                             { 0.0,       a_dFactor, 0.0,       0.0 },
+                             { 0.0,       0.0,       a_dFactor, 0.0 },
+                             { 0.0,       0.0,       0.0,       1.0 } };
+    return TransformationAbout( Transform( adScale ), ac_roOrigin );
 }
 
 // Scale by the given factors along each axis
@@ -3,8 +3,8 @@
  * Author:             Elizabeth Lowry
  * Date Created:       December 17, 2013
  * Description:        Arithmatic operator implementations for Vector.h.
- * Last Modified:      February 12, 2014
- * Last Modification:  Refactoring.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Configurable bounds checking for operator[].
  ******************************************************************************/
 
 #ifndef VECTOR__OPERATORS__INL
@@ -22,21 +22,22 @@ inline T& Vector< T, N, t_bIsRow >::At( unsigned int a_uiIndex )
 {
     if( a_uiIndex >= N )
     {
-        throw std::out_of_range( "Cannot access non-existent vector element" );
+        Utility::ThrowOutOfRange( "vector element", a_uiIndex, N );
     }
     return ( t_bIsRow ? m_aaData[0][a_uiIndex] : m_aaData[a_uiIndex][0] );
 }
 template< typename T, unsigned int N, bool t_bIsRow >
 inline T& Vector< T, N, t_bIsRow >::operator[]( unsigned int a_uiIndex )
 {
-    return At( a_uiIndex );
+    MATH_LIBRARY_CHECK_INDEX( "vector element", a_uiIndex, N );
+    return ( t_bIsRow ? m_aaData[0][a_uiIndex] : m_aaData[a_uiIndex][0] );
 }
 template< typename T, unsigned int N, bool t_bIsRow >
 inline const T& Vector< T, N, t_bIsRow >::At( unsigned int a_uiIndex ) const
 {
     if( a_uiIndex >= N )
     {
-        throw std::out_of_range( "Cannot access non-existent vector element" );
+        Utility::ThrowOutOfRange( "vector element", a_uiIndex, N );
     }
     return ( t_bIsRow ? m_aaData[0][a_uiIndex] : m_aaData[a_uiIndex][0] );
 }
@@ -44,7 +45,8 @@ template< typename T, unsigned int N, bool t_bIsRow >
 inline const T& Vector< T, N, t_bIsRow >::
     operator[]( unsigned int a_uiIndex ) const
 {
-    return At( a_uiIndex );
+    MATH_LIBRARY_CHECK_INDEX( "vector element", a_uiIndex, N );
+    return ( t_bIsRow ? m_aaData[0][a_uiIndex] : m_aaData[a_uiIndex][0] );
 }
 
 // Matrix multiplication and division overrides so the operators won't be
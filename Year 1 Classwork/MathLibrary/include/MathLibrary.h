@@ -3,8 +3,8 @@
  * Author:             Elizabeth Lowry
  * Date Created:       February 5, 2014
  * Description:        All-inclusive header file for the Math library.
- * Last Modified:      March 5, 2014
- * Last Modification:  Disabled warning about extern template instantiation.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Added resource residency lists.
  ******************************************************************************/
 
 #ifndef MATH__LIBRARY__H
@@ -19,21 +19,29 @@
 #pragma warning(push)
 #pragma warning (disable : 4231)
 
+#include "../Declarations/BoundsCheck.h"
 #include "../Declarations/ColorConstants.h"
 #include "../Declarations/ColorVector.h"
 #include "../Declarations/Comparable.h"
 #include "../Declarations/DumbString.h"
 #include "../Declarations/DynamicArray.h"
+#include "../Declarations/EventQueue.h"
+#include "../Declarations/Frustum.h"
 #include "../Declarations/Functions.h"
 #include "../Declarations/Hashable.h"
 #include "../Declarations/Hex.h"
 #include "../Declarations/HomogeneousVector.h"
 #include "../Declarations/InitializeableSingleton.h"
 #include "../Declarations/Matrix.h"
+#include "../Declarations/MatrixExpression.h"
 #include "../Declarations/MostDerivedAddress.h"
 #include "../Declarations/NotCopyable.h"
+#include "../Declarations/PackedColor.h"
 #include "../Declarations/PointVector.h"
+#include "../Declarations/Polymorphic.h"
+#include "../Declarations/Quadtree.h"
 #include "../Declarations/Quaternion.h"
+#include "../Declarations/ResidencyList.h"
 #include "../Declarations/Singleton.h"
 #include "../Declarations/Transform.h"
 #include "../Declarations/Vector.h"
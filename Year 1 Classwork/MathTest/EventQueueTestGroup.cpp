@@ -0,0 +1,215 @@
+/******************************************************************************
+ * File:               EventQueueTestGroup.cpp
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Lock-free event queue tests.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Creation.
+ ******************************************************************************/
+
+#include "EventQueueTestGroup.h"
+#include "MathLibrary.h"
+#include <vector>
+
+using Utility::EventQueue;
+
+namespace
+{
+
+// Something like an input event - a key going up or down at a given time
+struct Event
+{
+    double dTime;
+    unsigned int uiKey;
+    bool bPressed;
+};
+
+typedef EventQueue< Event > Queue;
+
+Event MakeEvent( double a_dTime, unsigned int a_uiKey, bool a_bPressed )
+{
+    Event oEvent = { a_dTime, a_uiKey, a_bPressed };
+    return oEvent;
+}
+
+bool Same( const Event& ac_roA, const Event& ac_roB )
+{
+    return ac_roA.dTime == ac_roB.dTime && ac_roA.uiKey == ac_roB.uiKey &&
+           ac_roA.bPressed == ac_roB.bPressed;
+}
+
+}   // namespace
+
+EventQueueTestGroup::EventQueueTestGroup()
+    : UnitTestGroup("Event queue tests")
+{
+    AddTest( "Capacity and empty queues", Capacity );
+    AddTest( "Bursts of events between frames", Bursts );
+    AddTest( "Pushing to a full queue", Overflow );
+    AddTest( "Positions wrapping around", Wraparound );
+}
+
+UnitTest::Result EventQueueTestGroup::Capacity()
+{
+    Queue oQueue( 100 );
+    if( 128 != oQueue.Capacity() || Queue( 0 ).Capacity() != 1 ||
+        Queue( 64 ).Capacity() != 64 )
+    {
+        return UnitTest::Fail( "Capacity wasn't rounded up to a power of two" );
+    }
+    Event oEvent = MakeEvent( 1.0, 2, true );
+    if( !oQueue.IsEmpty() || 0 != oQueue.Size() || oQueue.Pop( oEvent ) ||
+        oQueue.Peek( oEvent ) || 1.0 != oEvent.dTime )
+    {
+        return UnitTest::Fail( "New queue wasn't empty" );
+    }
+    oQueue.Push( MakeEvent( 3.0, 4, false ) );
+    if( !oQueue.Peek( oEvent ) || 3.0 != oEvent.dTime ||
+        1 != oQueue.Size() )
+    {
+        return UnitTest::Fail( "Peeking didn't leave the event queued" );
+    }
+    oQueue.Clear();
+    if( !oQueue.IsEmpty() || oQueue.Pop( oEvent ) )
+    {
+        return UnitTest::Fail( "Clearing didn't empty the queue" );
+    }
+    return UnitTest::PASS;
+}
+
+// Several presses and releases of the same key between two frames must all
+// come out, in order, on the next frame, rather than being collapsed into
+// whatever state the key ended up in
+UnitTest::Result EventQueueTestGroup::Bursts()
+{
+    Queue oQueue( 64 );
+    std::vector< Event > oPushed;
+    std::vector< Event > oPopped;
+    double dTime = 0.0;
+    for( unsigned int uiFrame = 0; uiFrame < 100; ++uiFrame )
+    {
+        // anywhere from no events up to a few dozen taps of a few keys, all
+        // between one frame and the next
+        unsigned int uiEvents = ( uiFrame * 7 ) % 40;
+        oPushed.clear();
+        for( unsigned int ui = 0; ui < uiEvents; ++ui )
+        {
+            dTime += 0.0001;
+            oPushed.push_back( MakeEvent( dTime, ( ui / 2 ) % 3,
+                                          0 == ui % 2 ) );
+            if( !oQueue.Push( oPushed.back() ) )
+            {
+                return UnitTest::Fail( "Push failed with room in the queue" );
+            }
+        }
+        if( uiEvents != oQueue.Size() )
+        {
+            return UnitTest::Fail( "Queue size doesn't match events pushed" );
+        }
+
+        // drain the queue at the start of the frame
+        oPopped.clear();
+        Event oEvent;
+        while( oQueue.Pop( oEvent ) )
+        {
+            oPopped.push_back( oEvent );
+        }
+        if( oPopped.size() != oPushed.size() )
+        {
+            return UnitTest::Fail( "Events in a burst were lost" );
+        }
+        for( unsigned int ui = 0; ui < oPopped.size(); ++ui )
+        {
+            if( !Same( oPopped[ ui ], oPushed[ ui ] ) )
+            {
+                return UnitTest::Fail( "Events in a burst came out of order" );
+            }
+        }
+    }
+    if( 0 != oQueue.Dropped() )
+    {
+        return UnitTest::Fail( "Events were dropped" );
+    }
+    return UnitTest::PASS;
+}
+
+UnitTest::Result EventQueueTestGroup::Overflow()
+{
+    Queue oQueue( 8 );
+    for( unsigned int ui = 0; ui < 8; ++ui )
+    {
+        if( !oQueue.Push( MakeEvent( ui, ui, true ) ) )
+        {
+            return UnitTest::Fail( "Push failed with room in the queue" );
+        }
+    }
+    if( oQueue.Push( MakeEvent( 8, 8, true ) ) ||
+        oQueue.Push( MakeEvent( 9, 9, true ) ) || 2 != oQueue.Dropped() )
+    {
+        return UnitTest::Fail( "Pushing to a full queue wasn't refused" );
+    }
+
+    // the oldest events are kept, not overwritten
+    Event oEvent;
+    if( !oQueue.Pop( oEvent ) || 0 != oEvent.uiKey )
+    {
+        return UnitTest::Fail( "Full queue lost its oldest event" );
+    }
+    if( !oQueue.Push( MakeEvent( 10, 10, true ) ) )
+    {
+        return UnitTest::Fail( "Popping didn't make room" );
+    }
+    for( unsigned int ui = 1; ui < 8; ++ui )
+    {
+        if( !oQueue.Pop( oEvent ) || ui != oEvent.uiKey )
+        {
+            return UnitTest::Fail( "Events came out of a full queue in the "
+                                   "wrong order" );
+        }
+    }
+    if( !oQueue.Pop( oEvent ) || 10 != oEvent.uiKey || !oQueue.IsEmpty() )
+    {
+        return UnitTest::Fail( "Event pushed after popping was lost" );
+    }
+    return UnitTest::PASS;
+}
+
+// Pushing and popping different numbers of events each time walks the
+// positions around the ring many times over, starting from every slot
+UnitTest::Result EventQueueTestGroup::Wraparound()
+{
+    Queue oQueue( 16 );
+    unsigned int uiNextPush = 0;
+    unsigned int uiNextPop = 0;
+    Event oEvent;
+    for( unsigned int uiRound = 0; uiRound < 1000; ++uiRound )
+    {
+        unsigned int uiPushes = ( uiRound * 5 ) % 17;
+        for( unsigned int ui = 0; ui < uiPushes; ++ui )
+        {
+            if( oQueue.Push( MakeEvent( uiNextPush, uiNextPush, true ) ) )
+            {
+                ++uiNextPush;
+            }
+        }
+        unsigned int uiPops = ( uiRound * 3 ) % 13;
+        for( unsigned int ui = 0; ui < uiPops && oQueue.Pop( oEvent ); ++ui )
+        {
+            if( uiNextPop != oEvent.uiKey )
+            {
+                return UnitTest::Fail( "Events came out in the wrong order "
+                                       "after wrapping around" );
+            }
+            ++uiNextPop;
+        }
+        if( uiNextPush - uiNextPop != oQueue.Size() )
+        {
+            return UnitTest::Fail( "Size was wrong after wrapping around" );
+        }
+    }
+    if( uiNextPush < 10 * oQueue.Capacity() || 0 == oQueue.Dropped() )
+    {
+        return UnitTest::Fail( "Test didn't wrap around a full queue" );
+    }
+    return UnitTest::PASS;
+}
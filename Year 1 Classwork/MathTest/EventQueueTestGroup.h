@@ -0,0 +1,30 @@
+/******************************************************************************
+ * File:               EventQueueTestGroup.h
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Lock-free event queue tests.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Creation.
+ ******************************************************************************/
+
+#ifndef EVENT_QUEUE_TEST_GROUP__H
+#define EVENT_QUEUE_TEST_GROUP__H
+
+#include "UnitTestGroup.h"
+
+class EventQueueTestGroup : public UnitTestGroup
+{
+public:
+
+    EventQueueTestGroup();
+
+private:
+
+    static UnitTest::Result Capacity();
+    static UnitTest::Result Bursts();
+    static UnitTest::Result Overflow();
+    static UnitTest::Result Wraparound();
+
+};
+
+#endif  // EVENT_QUEUE_TEST_GROUP__H
@@ -0,0 +1,463 @@
+/******************************************************************************
+ * File:               FrustumTestGroup.cpp
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Bounding box and view frustum culling tests.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Creation.
+ ******************************************************************************/
+
+#include "FrustumTestGroup.h"
+#include "MathLibrary.h"
+#include <cmath>
+#include <sstream>
+#include <vector>
+
+using namespace Space;
+
+namespace
+{
+
+BoundingBox Box( double a_dMinX, double a_dMinY, double a_dMinZ,
+                 double a_dMaxX, double a_dMaxY, double a_dMaxZ )
+{
+    BoundingBox oBox = { { a_dMinX, a_dMinY, a_dMinZ },
+                         { a_dMaxX, a_dMaxY, a_dMaxZ } };
+    return oBox;
+}
+
+// Repeatable pseudo-random values in [a_dLow, a_dHigh)
+double Next( unsigned int& a_ruiSeed, double a_dLow, double a_dHigh )
+{
+    a_ruiSeed = a_ruiSeed * 1664525u + 1013904223u;
+    return a_dLow + ( a_dHigh - a_dLow ) * ( ( a_ruiSeed >> 8 ) / 16777216.0 );
+}
+
+BoundingBox RandomBox( unsigned int& a_ruiSeed, double a_dRange,
+                       double a_dMaxSize )
+{
+    BoundingBox oBox;
+    for( unsigned int i = 0; i < 3; ++i )
+    {
+        oBox.adMin[i] = Next( a_ruiSeed, -a_dRange, a_dRange );
+        oBox.adMax[i] = oBox.adMin[i] + Next( a_ruiSeed, 0, a_dMaxSize );
+    }
+    return oBox;
+}
+
+const char* const gc_apcNames[3] = { "OUTSIDE", "INTERSECTING", "INSIDE" };
+
+// Describe a test that gave the wrong result
+std::string Describe( const char* ac_pcWhat, const BoundingBox& ac_roBox,
+                      Frustum::Containment a_eResult,
+                      Frustum::Containment a_eExpected )
+{
+    std::ostringstream oOut;
+    oOut << ac_pcWhat << " ( " << ac_roBox.adMin[0] << ", "
+         << ac_roBox.adMin[1] << ", " << ac_roBox.adMin[2] << " ) to ( "
+         << ac_roBox.adMax[0] << ", " << ac_roBox.adMax[1] << ", "
+         << ac_roBox.adMax[2] << " ) was " << gc_apcNames[ a_eResult ]
+         << " instead of " << gc_apcNames[ a_eExpected ];
+    return oOut.str();
+}
+
+}   // namespace
+
+FrustumTestGroup::FrustumTestGroup()
+    : UnitTestGroup("Bounding box and frustum tests")
+{
+    AddTest( "Boxes on and near the clip volume's faces", Edges );
+    AddTest( "Boxes near the clip volume's corners", Corners );
+    AddTest( "Perspective and parallel projections", Projections );
+    AddTest( "Narrowing the planes tested for nested boxes", Narrowing );
+    AddTest( "Testing arrays of boxes", Batch );
+    AddTest( "Transforming boxes", Transformed );
+}
+
+UnitTest::Result FrustumTestGroup::Edges()
+{
+    // With no transformation, the frustum is the clip volume itself
+    Frustum oFrustum( Transform3D::Identity() );
+    struct Case
+    {
+        BoundingBox oBox;
+        Frustum::Containment eExpected;
+    };
+    const Case acoCases[] =
+    {
+        { Box( -0.5, -0.5, -0.5, 0.5, 0.5, 0.5 ), Frustum::INSIDE },
+        { Box( -1, -1, -1, 1, 1, 1 ), Frustum::INSIDE },
+        { Box( 0, 0, 0, 0, 0, 0 ), Frustum::INSIDE },
+        { Box( 1, 1, 1, 1, 1, 1 ), Frustum::INSIDE },
+        { Box( 1, 0, 0, 2, 0.5, 0.5 ), Frustum::INTERSECTING },
+        { Box( -2, 0, 0, -1, 0.5, 0.5 ), Frustum::INTERSECTING },
+        { Box( 0, -0.5, 0, 0.5, 1.5, 0.5 ), Frustum::INTERSECTING },
+        { Box( -5, -5, -5, 5, 5, 5 ), Frustum::INTERSECTING },
+        { Box( 1.0001, 0, 0, 2, 0.5, 0.5 ), Frustum::OUTSIDE },
+        { Box( 0, 0, -2, 0.5, 0.5, -1.0001 ), Frustum::OUTSIDE },
+        { Box( 1, 1, 1.0001, 1, 1, 1.0001 ), Frustum::OUTSIDE },
+        // flat boxes, like sprites
+        { Box( -0.5, -0.5, 0, 0.5, 0.5, 0 ), Frustum::INSIDE },
+        { Box( 0.5, 0.5, 0, 1.5, 1.5, 0 ), Frustum::INTERSECTING },
+        { Box( -0.5, -0.5, 1.5, 0.5, 0.5, 1.5 ), Frustum::OUTSIDE }
+    };
+    for( unsigned int i = 0; i < sizeof( acoCases ) / sizeof( Case ); ++i )
+    {
+        Frustum::Containment eResult = oFrustum.Test( acoCases[i].oBox );
+        if( acoCases[i].eExpected != eResult )
+        {
+            return UnitTest::Fail( Describe( "Box", acoCases[i].oBox, eResult,
+                                             acoCases[i].eExpected ) );
+        }
+    }
+
+    // Only the planes in the mask are tested
+    BoundingBox oInFront = Box( -0.5, -0.5, -3, 0.5, 0.5, -2 );
+    if( Frustum::INSIDE !=
+        oFrustum.Test( oInFront, Frustum::SIDE_PLANES ) )
+    {
+        return UnitTest::Fail( "Depth planes tested when not in mask" );
+    }
+    if( Frustum::INSIDE != oFrustum.Test( oInFront, 0 ) )
+    {
+        return UnitTest::Fail( "Box tested against an empty mask" );
+    }
+
+    // The default frustum contains everything
+    if( Frustum::INSIDE != Frustum().Test( Box( 1e9, 1e9, 1e9,
+                                                2e9, 2e9, 2e9 ) ) )
+    {
+        return UnitTest::Fail( "Default frustum doesn't contain everything" );
+    }
+
+    return UnitTest::PASS;
+}
+
+UnitTest::Result FrustumTestGroup::Corners()
+{
+    // Outside two planes at once
+    Frustum oFrustum( Transform3D::Identity() );
+    BoundingBox oBox = Box( 1.5, 1.5, 0, 2, 2, 0 );
+    if( Frustum::OUTSIDE != oFrustum.Test( oBox ) )
+    {
+        return UnitTest::Fail( Describe( "Box past corner", oBox,
+                                         oFrustum.Test( oBox ),
+                                         Frustum::OUTSIDE ) );
+    }
+
+    // A view rotated 45 degrees, so the visible part of the z = 0 plane is a
+    // diamond with corners at ( +/-sqrt(2), 0 ) and ( 0, +/-sqrt(2) )
+    double dRoot = std::sqrt( 0.5 );
+    Transform3D oRotated = Transform3D::Identity();
+    oRotated[0][0] = dRoot;
+    oRotated[0][1] = dRoot;
+    oRotated[1][0] = -dRoot;
+    oRotated[1][1] = dRoot;
+    oFrustum = Frustum( oRotated );
+
+    // This box is entirely outside the top plane
+    oBox = Box( 0.9, 0.9, 0, 1.5, 1.5, 0 );
+    if( Frustum::OUTSIDE != oFrustum.Test( oBox ) )
+    {
+        return UnitTest::Fail( Describe( "Box past rotated edge", oBox,
+                                         oFrustum.Test( oBox ),
+                                         Frustum::OUTSIDE ) );
+    }
+
+    // This box is just past the corner at ( sqrt(2), 0 ), but isn't entirely
+    // outside either of the planes meeting there, so the test is conservative
+    // and keeps it
+    oBox = Box( 1.45, -0.1, 0, 1.6, 0.1, 0 );
+    if( Frustum::INTERSECTING != oFrustum.Test( oBox ) )
+    {
+        return UnitTest::Fail( Describe( "Box past rotated corner", oBox,
+                                         oFrustum.Test( oBox ),
+                                         Frustum::INTERSECTING ) );
+    }
+
+    // This one covers the corner
+    oBox = Box( 1.0, -0.5, 0, 1.5, 0.5, 0 );
+    if( Frustum::INTERSECTING != oFrustum.Test( oBox ) )
+    {
+        return UnitTest::Fail( Describe( "Box across rotated corner", oBox,
+                                         oFrustum.Test( oBox ),
+                                         Frustum::INTERSECTING ) );
+    }
+
+    return UnitTest::PASS;
+}
+
+UnitTest::Result FrustumTestGroup::Projections()
+{
+    // Camera at the origin looking down the negative z-axis.  At z = -4, the
+    // visible area is 16 units across.  OpenGL clips depth at -w and w, which
+    // this projection puts at z = -1.2 and z = -6.
+    Frustum oFrustum( PerspectiveProjection( 2, 6, Point2D( 4, 4 ) ) );
+    struct Case
+    {
+        BoundingBox oBox;
+        Frustum::Containment eExpected;
+    };
+    const Case acoPerspective[] =
+    {
+        { Box( -1, -1, -4.5, 1, 1, -3.5 ), Frustum::INSIDE },
+        { Box( -1, -1, 1, 1, 1, 2 ), Frustum::OUTSIDE },
+        { Box( -1, -1, -1.1, 1, 1, -1 ), Frustum::OUTSIDE },
+        { Box( -1, -1, -1.3, 1, 1, -1.1 ), Frustum::INTERSECTING },
+        { Box( -1, -1, -10, 1, 1, -8 ), Frustum::OUTSIDE },
+        { Box( -1, -1, -7, 1, 1, -5 ), Frustum::INTERSECTING },
+        { Box( 7, -1, -4, 9, 1, -4 ), Frustum::INTERSECTING },
+        { Box( 8.5, -1, -4, 9, 1, -4 ), Frustum::OUTSIDE },
+        { Box( -9, 6, -4, -7, 7, -4 ), Frustum::INTERSECTING },
+        { Box( -9, 8.5, -4, -7, 9, -4 ), Frustum::OUTSIDE },
+        // contain the camera, but only the second reaches past z = -1.2
+        { Box( -1, -1, -1, 1, 1, 1 ), Frustum::OUTSIDE },
+        { Box( -1, -1, -3, 1, 1, 1 ), Frustum::INTERSECTING }
+    };
+    for( unsigned int i = 0;
+         i < sizeof( acoPerspective ) / sizeof( Case ); ++i )
+    {
+        Frustum::Containment eResult = oFrustum.Test( acoPerspective[i].oBox );
+        if( acoPerspective[i].eExpected != eResult )
+        {
+            return UnitTest::Fail( Describe( "Box in perspective",
+                                             acoPerspective[i].oBox, eResult,
+                                             acoPerspective[i].eExpected ) );
+        }
+    }
+
+    // 2D - a parallel projection of a 512x256 screen, with sprites in the
+    // z = 0 plane, only needs the view rectangle
+    oFrustum = Frustum( ParallelProjection( 0, 1, Point2D( 512, 256 ) ) );
+    const Case acoParallel[] =
+    {
+        { Box( -10, -10, 0, 10, 10, 0 ), Frustum::INSIDE },
+        { Box( -512, -256, 0, 512, 256, 0 ), Frustum::INSIDE },
+        { Box( 500, 0, 0, 520, 10, 0 ), Frustum::INTERSECTING },
+        { Box( 512, 0, 0, 520, 10, 0 ), Frustum::INTERSECTING },
+        { Box( 513, 0, 0, 520, 10, 0 ), Frustum::OUTSIDE },
+        { Box( 0, -270, 0, 10, -257, 0 ), Frustum::OUTSIDE },
+        { Box( -600, -600, 0, 600, 600, 0 ), Frustum::INTERSECTING },
+        // far off the z = 0 plane, but still in the rectangle
+        { Box( -10, -10, 50, 10, 10, 50 ), Frustum::INSIDE }
+    };
+    for( unsigned int i = 0; i < sizeof( acoParallel ) / sizeof( Case ); ++i )
+    {
+        Frustum::Containment eResult =
+            oFrustum.Test( acoParallel[i].oBox, Frustum::SIDE_PLANES );
+        if( acoParallel[i].eExpected != eResult )
+        {
+            return UnitTest::Fail( Describe( "Box in 2D view",
+                                             acoParallel[i].oBox, eResult,
+                                             acoParallel[i].eExpected ) );
+        }
+    }
+
+    return UnitTest::PASS;
+}
+
+UnitTest::Result FrustumTestGroup::Narrowing()
+{
+    Frustum oFrustum( Rotation( 0.3, -0.7, 1.1 ) * Translation( 1, -3, -6 ) *
+                      PerspectiveProjection( 2, 20, Point2D( 4, 3 ) ) );
+    unsigned int uiSeed = 12345;
+    for( unsigned int i = 0; i < 2000; ++i )
+    {
+        BoundingBox oParent = RandomBox( uiSeed, 15, 10 );
+        unsigned int uiPlanes = Frustum::ALL_PLANES;
+        Frustum::Containment eParent =
+            oFrustum.TestAndNarrow( oParent, uiPlanes );
+        if( eParent != oFrustum.Test( oParent ) )
+        {
+            return UnitTest::Fail( "TestAndNarrow and Test disagree" );
+        }
+        if( ( Frustum::INSIDE == eParent || Frustum::OUTSIDE == eParent ) !=
+            ( 0 == uiPlanes ) )
+        {
+            return UnitTest::Fail( "Narrowed mask doesn't match result" );
+        }
+        if( Frustum::OUTSIDE == eParent )
+        {
+            continue;
+        }
+
+        // A box inside the parent gets the same result with the narrowed
+        // mask as with every plane
+        for( unsigned int j = 0; j < 8; ++j )
+        {
+            BoundingBox oChild;
+            for( unsigned int k = 0; k < 3; ++k )
+            {
+                double dSize = oParent.adMax[k] - oParent.adMin[k];
+                oChild.adMin[k] = oParent.adMin[k] +
+                                  Next( uiSeed, 0, dSize );
+                oChild.adMax[k] = oChild.adMin[k] +
+                                  Next( uiSeed, 0, oParent.adMax[k] -
+                                                   oChild.adMin[k] );
+            }
+            Frustum::Containment eExpected = oFrustum.Test( oChild );
+            Frustum::Containment eResult = oFrustum.Test( oChild, uiPlanes );
+            if( eExpected != eResult )
+            {
+                return UnitTest::Fail( Describe( "Child box", oChild, eResult,
+                                                 eExpected ) );
+            }
+        }
+    }
+    return UnitTest::PASS;
+}
+
+UnitTest::Result FrustumTestGroup::Batch()
+{
+    // An odd number of boxes, so the last one isn't part of a pair
+    const unsigned int cuiCount = 10001;
+    std::vector< double > oMinX( cuiCount ), oMinY( cuiCount ),
+                          oMinZ( cuiCount ), oMaxX( cuiCount ),
+                          oMaxY( cuiCount ), oMaxZ( cuiCount );
+    std::vector< BoundingBox > oBoxes( cuiCount );
+    unsigned int uiSeed = 67890;
+    for( unsigned int i = 0; i < cuiCount; ++i )
+    {
+        oBoxes[i] = RandomBox( uiSeed, 12, 3 );
+        // some boxes exactly on a plane, some flat
+        if( 0 == i % 97 )
+        {
+            oBoxes[i].adMin[0] = 1;
+            oBoxes[i].adMax[0] = 1;
+        }
+        if( 0 == i % 5 )
+        {
+            oBoxes[i].adMax[2] = oBoxes[i].adMin[2];
+        }
+        oMinX[i] = oBoxes[i].adMin[0];
+        oMinY[i] = oBoxes[i].adMin[1];
+        oMinZ[i] = oBoxes[i].adMin[2];
+        oMaxX[i] = oBoxes[i].adMax[0];
+        oMaxY[i] = oBoxes[i].adMax[1];
+        oMaxZ[i] = oBoxes[i].adMax[2];
+    }
+
+    const Transform3D acoTransforms[3] =
+    {
+        Transform3D::Identity(),
+        Rotation( 0.3, -0.7, 1.1 ) * Translation( 1, -3, -6 ) *
+            PerspectiveProjection( 2, 20, Point2D( 4, 3 ) ),
+        ParallelProjection( 0, 1, Point2D( 8, 6 ) )
+    };
+    const unsigned int cauiMasks[3] = { Frustum::ALL_PLANES,
+                                        Frustum::SIDE_PLANES,
+                                        Frustum::LEFT_PLANE |
+                                        Frustum::FAR_PLANE };
+    std::vector< unsigned int > oResults( cuiCount );
+    for( unsigned int t = 0; t < 3; ++t )
+    {
+        Frustum oFrustum( acoTransforms[t] );
+        for( unsigned int m = 0; m < 3; ++m )
+        {
+            unsigned int uiVisible =
+                oFrustum.Cull( &oMinX[0], &oMinY[0], &oMinZ[0], &oMaxX[0],
+                               &oMaxY[0], &oMaxZ[0], cuiCount,
+                               &oResults[0], cauiMasks[m] );
+            unsigned int uiExpected = 0;
+            for( unsigned int i = 0; i < cuiCount; ++i )
+            {
+                if( Frustum::OUTSIDE ==
+                    oFrustum.Test( oBoxes[i], cauiMasks[m] ) )
+                {
+                    continue;
+                }
+                if( uiExpected >= uiVisible || oResults[ uiExpected ] != i )
+                {
+                    std::ostringstream oOut;
+                    oOut << "Box " << i << " missing from array results for "
+                         << "transform " << t << ", mask " << cauiMasks[m];
+                    return UnitTest::Fail( oOut.str() );
+                }
+                ++uiExpected;
+            }
+            if( uiExpected != uiVisible )
+            {
+                std::ostringstream oOut;
+                oOut << uiVisible << " boxes kept instead of " << uiExpected
+                     << " for transform " << t << ", mask " << cauiMasks[m];
+                return UnitTest::Fail( oOut.str() );
+            }
+        }
+    }
+
+    // Nothing to test
+    if( 0 != Frustum().Cull( &oMinX[0], &oMinY[0], &oMinZ[0], &oMaxX[0],
+                             &oMaxY[0], &oMaxZ[0], 0, &oResults[0] ) )
+    {
+        return UnitTest::Fail( "Empty array culled to non-empty results" );
+    }
+
+    return UnitTest::PASS;
+}
+
+UnitTest::Result FrustumTestGroup::Transformed()
+{
+    AffineTransform3D oAffine = Space::Affine( Point3D( 2, 0.5, -1 ),
+                                               PointRotation( 0.3, -0.7, 1.1 ),
+                                               Point3D( 1, -3, 2 ) );
+    BoundingBox oBox = Box( -1, -2, 0.5, 3, 1, 0.5 );
+    BoundingBox oResult = oBox.Transformed( oAffine );
+    BoundingBox oHomogeneous = oBox.Transformed( Homogeneous( oAffine ) );
+    for( unsigned int i = 0; i < 3; ++i )
+    {
+        if( oResult.adMin[i] != oHomogeneous.adMin[i] ||
+            oResult.adMax[i] != oHomogeneous.adMax[i] )
+        {
+            return UnitTest::Fail( "Affine and full transformations give "
+                                   "different boxes" );
+        }
+    }
+
+    // Every corner should be inside the result, and every face of the result
+    // should touch a corner
+    double adLow[3] = { 1e300, 1e300, 1e300 };
+    double adHigh[3] = { -1e300, -1e300, -1e300 };
+    for( unsigned int c = 0; c < 8; ++c )
+    {
+        Point3D oCorner( ( c & 1 ) ? oBox.adMax[0] : oBox.adMin[0],
+                         ( c & 2 ) ? oBox.adMax[1] : oBox.adMin[1],
+                         ( c & 4 ) ? oBox.adMax[2] : oBox.adMin[2] );
+        Point3D oMoved( HVector3D( oCorner ) * Homogeneous( oAffine ) );
+        for( unsigned int i = 0; i < 3; ++i )
+        {
+            adLow[i] = ( oMoved[i] < adLow[i] ? oMoved[i] : adLow[i] );
+            adHigh[i] = ( oMoved[i] > adHigh[i] ? oMoved[i] : adHigh[i] );
+        }
+    }
+    for( unsigned int i = 0; i < 3; ++i )
+    {
+        if( std::abs( adLow[i] - oResult.adMin[i] ) > 1e-12 ||
+            std::abs( adHigh[i] - oResult.adMax[i] ) > 1e-12 )
+        {
+            std::ostringstream oOut;
+            oOut << "Transformed box from " << oResult.adMin[i] << " to "
+                 << oResult.adMax[i] << " instead of " << adLow[i] << " to "
+                 << adHigh[i] << " along axis " << i;
+            return UnitTest::Fail( oOut.str() );
+        }
+    }
+
+    // Merging and containment
+    BoundingBox oMerged = oBox.Merged( Box( 2, 2, -1, 4, 3, 0 ) );
+    BoundingBox oExpected = Box( -1, -2, -1, 4, 3, 0.5 );
+    for( unsigned int i = 0; i < 3; ++i )
+    {
+        if( oMerged.adMin[i] != oExpected.adMin[i] ||
+            oMerged.adMax[i] != oExpected.adMax[i] )
+        {
+            return UnitTest::Fail( "Merged box is wrong" );
+        }
+    }
+    if( !oMerged.Contains( oBox ) || oBox.Contains( oMerged ) ||
+        !oBox.Contains( oBox ) )
+    {
+        return UnitTest::Fail( "Containment is wrong" );
+    }
+
+    return UnitTest::PASS;
+}
@@ -0,0 +1,32 @@
+/******************************************************************************
+ * File:               FrustumTestGroup.h
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Bounding box and view frustum culling tests.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Creation.
+ ******************************************************************************/
+
+#ifndef FRUSTUM_TEST_GROUP__H
+#define FRUSTUM_TEST_GROUP__H
+
+#include "UnitTestGroup.h"
+
+class FrustumTestGroup : public UnitTestGroup
+{
+public:
+
+    FrustumTestGroup();
+
+private:
+
+    static UnitTest::Result Edges();
+    static UnitTest::Result Corners();
+    static UnitTest::Result Projections();
+    static UnitTest::Result Narrowing();
+    static UnitTest::Result Batch();
+    static UnitTest::Result Transformed();
+
+};
+
+#endif  // FRUSTUM_TEST_GROUP__H
@@ -3,12 +3,13 @@
  * Author:             Elizabeth Lowry
  * Date Created:       January 5, 2014
  * Description:        Common math functionality tests.
- * Last Modified:      February 5, 2014
- * Last Modification:  Refactoring.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Added a 64-bit power of two test.
  ******************************************************************************/
 
 #include "MathTestGroup.h"
 #include "MathLibrary.h"
+#include <sstream>
 
 MathTestGroup::MathTestGroup()
     : UnitTestGroup("Common math functionality tests")
@@ -16,6 +17,10 @@ MathTestGroup::MathTestGroup()
     AddTest( "Convert between degrees and radians", Conversions );
     AddTest( "Linear interpolation between scalar values", Interpolation );
     AddTest( "Obtaining nearest power of two", NearestPower );
+    AddTest( "Nearest power of two for every 32-bit integer",
+             NearestPowerAllIntegers );
+    AddTest( "Rounding to the nearest whole number", Rounding );
+    AddTest( "Array versions of functions", ArrayFunctions );
     AddTest( "Bitwise operations", ColorBitwise );
 }
 
@@ -84,6 +89,124 @@ UnitTest::Result MathTestGroup::NearestPower()
     return UnitTest::PASS;
 }
 
+UnitTest::Result MathTestGroup::NearestPowerAllIntegers()
+{
+    // Check every 32-bit pattern as both a signed and an unsigned value against
+    // the definition: the closest power of two, rounding down on ties, or one
+    // for values less than one.  Powers that don't fit wrap when cast.
+    unsigned int ui = 0;
+    do
+    {
+        // Smear the highest bit down to get one less than the next power up
+        unsigned long long ullValue = ui;
+        unsigned long long ullSmeared = ullValue;
+        for( unsigned int uiShift = 1; uiShift < 32; uiShift *= 2 )
+        {
+            ullSmeared |= ullSmeared >> uiShift;
+        }
+        unsigned long long ullFloor = ( ullSmeared >> 1 ) + 1;
+        unsigned long long ullExpected =
+            ( 0 == ullValue ? 1 :
+              ullFloor * 2 - ullValue < ullValue - ullFloor
+              ? ullFloor * 2 : ullFloor );
+        int iValue = (int)ui;
+        int iExpected = ( iValue <= 0 ? 1 : (int)ullExpected );
+        if( (unsigned int)ullExpected != Math::NearestPowerOfTwo( ui ) ||
+            iExpected != Math::NearestPowerOfTwo( iValue ) )
+        {
+            std::ostringstream oOut;
+            oOut << "Incorrect nearest power of two to " << ui << " or "
+                 << iValue;
+            return UnitTest::Fail( oOut.str() );
+        }
+    } while( 0 != ++ui );
+
+    // There's no power of two above the highest bit of a 64-bit value
+    if( 1ull << 63 != Math::NearestPowerOfTwo( ~0ull ) ||
+        1ull << 63 != Math::NearestPowerOfTwo( ( 3ull << 62 ) + 1 ) )
+    {
+        return UnitTest::Fail( "Nearest power of two above 2^63 overflowed" );
+    }
+    return UnitTest::PASS;
+}
+
+UnitTest::Result MathTestGroup::Rounding()
+{
+    // Ties round down, for negative numbers too
+    double adValues[8] = { 0.5, -0.5, 1.5, -2.5, 0.7, -0.3, 2.49, -7.51 };
+    double adExpected[8] = { 0.0, -1.0, 1.0, -3.0, 1.0, 0.0, 2.0, -8.0 };
+    for( unsigned int i = 0; i < 8; ++i )
+    {
+        if( adExpected[i] != Math::Round( adValues[i] ) ||
+            (float)adExpected[i] != Math::Round( (float)adValues[i] ) )
+        {
+            std::ostringstream oOut;
+            oOut << "Incorrect rounding of " << adValues[i];
+            return UnitTest::Fail( oOut.str() );
+        }
+    }
+    if( -7 != Math::Round( -7 ) || 2000000001u != Math::Round( 2000000001u ) )
+    {
+        return UnitTest::Fail( "Rounding an integer changed it" );
+    }
+    return UnitTest::PASS;
+}
+
+UnitTest::Result MathTestGroup::ArrayFunctions()
+{
+    // Array versions should match the single-value versions exactly, even
+    // when writing the results over an input array
+    float afA[11], afB[11], afResults[11];
+    double adValues[11], adResults[11];
+    for( unsigned int i = 0; i < 11; ++i )
+    {
+        afA[i] = i * 0.37f - 1.0f;
+        afB[i] = i * -1.1f + 3.0f;
+        adValues[i] = i * 1.75 - 9.5;
+    }
+    Math::Interpolate( afA, afB, 0.3f, afResults, 11 );
+    for( unsigned int i = 0; i < 11; ++i )
+    {
+        if( Math::Interpolate( afA[i], afB[i], 0.3f ) != afResults[i] )
+        {
+            return UnitTest::Fail( "Incorrect array interpolation" );
+        }
+    }
+    Math::Interpolate( afA, afB, 0.3f, afA, 11 );
+    for( unsigned int i = 0; i < 11; ++i )
+    {
+        if( afA[i] != afResults[i] )
+        {
+            return UnitTest::Fail( "Incorrect in-place array interpolation" );
+        }
+    }
+    Math::Round( adValues, adResults, 11 );
+    for( unsigned int i = 0; i < 11; ++i )
+    {
+        if( Math::Round( adValues[i] ) != adResults[i] )
+        {
+            return UnitTest::Fail( "Incorrect array rounding" );
+        }
+    }
+    Math::NearestPowerOfTwo( adValues, adResults, 11 );
+    for( unsigned int i = 0; i < 11; ++i )
+    {
+        if( Math::NearestPowerOfTwo( adValues[i] ) != adResults[i] )
+        {
+            return UnitTest::Fail( "Incorrect array nearest power of two" );
+        }
+    }
+    Math::ScrollRadians( adValues, adValues, 11 );
+    for( unsigned int i = 0; i < 11; ++i )
+    {
+        if( Math::ScrollRadians( i * 1.75 - 9.5 ) != adValues[i] )
+        {
+            return UnitTest::Fail( "Incorrect in-place array radian scrolling" );
+        }
+    }
+    return UnitTest::PASS;
+}
+
 UnitTest::Result MathTestGroup::ColorBitwise()
 {
     Color::Hex oColor = Color::VGA::GREEN & Color::Opacity::HALF;
@@ -3,8 +3,9 @@
  * Author:             Elizabeth Lowry
  * Date Created:       January 5, 2014
  * Description:        Common math functionality tests.
- * Last Modified:      January 5, 2014
- * Last Modification:  Debugging.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Added exhaustive power of two, rounding, and array
+ *                      function tests.
  ******************************************************************************/
 
 #ifndef MATH_TEST_GROUP__H
@@ -23,6 +24,9 @@ private:
     static UnitTest::Result Conversions();
     static UnitTest::Result Interpolation();
     static UnitTest::Result NearestPower();
+    static UnitTest::Result NearestPowerAllIntegers();
+    static UnitTest::Result Rounding();
+    static UnitTest::Result ArrayFunctions();
     static UnitTest::Result ColorBitwise();
 
 };
@@ -3,13 +3,14 @@
  * Author:             Elizabeth Lowry
  * Date Created:       January 5, 2014
  * Description:        4x4 Matrix tests.
- * Last Modified:      June 26, 2014
- * Last Modification:  Debugging.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Added array transformation test.
  ******************************************************************************/
 
 #include "Matrix4x4TestGroup.h"
 #include "MathLibrary.h"
 #include <sstream>
+#include <vector>
 
 using namespace Space;
 using Math::Matrix;
@@ -23,6 +24,9 @@ Matrix4x4TestGroup::Matrix4x4TestGroup()
     AddTest( "HVector translation ", Translate );
     AddTest( "Point scale transformation", PointScale );
     AddTest( "Point rotation", PointRotate );
+    AddTest( "Transformation about a point", About );
+    AddTest( "Affine transformations", Affine );
+    AddTest( "Array transformations", Arrays );
     AddTest( "Matrix multiplication", Multiply );
 }
 
@@ -491,6 +495,201 @@ UnitTest::Result Matrix4x4TestGroup::PointRotate()
     return UnitTest::PASS;
 }
 
+UnitTest::Result Matrix4x4TestGroup::About()
+{
+    // Uniform scaling shouldn't depend on Identity()
+    if( PointTransform3D::Identity() * 0.5 != PointScaling( 0.5 ) )
+    {
+        return UnitTest::Fail( "Uniform point scaling by 0.5 failed" );
+    }
+
+    // Affine transformations about a point should match moving the point to the
+    // origin, transforming, and moving back
+    Point3D oOrigin( 2, 1, -2 );
+    Transform3D aoTransforms[4] = { Scaling( 0.5 ),
+                                    Scaling( 2, 0.5, -1 ),
+                                    Rotation( Math::PI / 3, Point3D::Unit(2) ),
+                                    Rotation( 0.3, -0.7, 1.1 ) *
+                                        Translation( 1, -3, 2 ) };
+    for( unsigned int i = 0; i < 4; ++i )
+    {
+        Transform3D oExpected = Translation( -oOrigin ) * aoTransforms[i] *
+                                Translation( oOrigin );
+        if( oExpected != TransformationAbout( aoTransforms[i], oOrigin ) )
+        {
+            std::ostringstream oOut;
+            oOut << "Transformation " << i << " about " << oOrigin
+                 << " other than " << oExpected;
+            return UnitTest::Fail( oOut.str() );
+        }
+    }
+
+    // Non-affine transformations should too
+    Transform3D oProjection = PerspectiveProjection( 2, 6, Point2D( 4, 4 ) );
+    if( Translation( -oOrigin ) * oProjection * Translation( oOrigin ) !=
+        TransformationAbout( oProjection, oOrigin ) )
+    {
+        return UnitTest::Fail( "Perspective projection about a point failed" );
+    }
+
+    // Transforming about the origin shouldn't change anything
+    if( aoTransforms[3] != TransformationAbout( aoTransforms[3],
+                                                Point3D( 0, 0, 0 ) ) )
+    {
+        return UnitTest::Fail( "Transformation about the origin failed" );
+    }
+
+    return UnitTest::PASS;
+}
+
+UnitTest::Result Matrix4x4TestGroup::Affine()
+{
+    // Scaling, rotating, and translating directly should match multiplying the
+    // full transformations
+    Point3D oScale( 2, 0.5, -1 );
+    Point3D oPosition( 1, -3, 2 );
+    PointTransform3D oRotation = PointRotation( 0.3, -0.7, 1.1 );
+    AffineTransform3D oAffine = Space::Affine( oScale, oRotation, oPosition );
+    Transform3D oExpected = Scaling( oScale ) * Rotation( 0.3, -0.7, 1.1 ) *
+                            Translation( oPosition );
+    if( oExpected != Homogeneous( oAffine ) )
+    {
+        std::ostringstream oOut;
+        oOut << "Affine scale/rotate/translate " << Homogeneous( oAffine )
+             << " other than " << oExpected;
+        return UnitTest::Fail( oOut.str() );
+    }
+    if( oAffine != Space::Affine( oExpected ) )
+    {
+        return UnitTest::Fail( "Conversion from full transformation failed" );
+    }
+
+    // Composition should match multiplication
+    AffineTransform3D oOther = Compose( AffineScaling( 0.5 ),
+                                        AffineTranslation( oPosition ) );
+    if( Scaling( 0.5 ) * Translation( oPosition ) != Homogeneous( oOther ) )
+    {
+        return UnitTest::Fail( "Affine scaling and translation failed" );
+    }
+    if( oExpected * Homogeneous( oOther ) !=
+        Homogeneous( Compose( oAffine, oOther ) ) )
+    {
+        return UnitTest::Fail( "Affine composition failed" );
+    }
+
+    // An affine transformation composed with its inverse should be identity
+    AffineTransform3D oResult = Compose( oAffine, AffineInverse( oAffine ) );
+    if( AffineScaling( 1.0 ) != ( oResult * 1000 ).Round() / 1000 )
+    {
+        std::ostringstream oOut;
+        oOut << "Affine transformation times inverse " << oResult
+             << " other than identity";
+        return UnitTest::Fail( oOut.str() );
+    }
+    if( AffineTransform3D::Zero() !=
+        AffineInverse( AffineScaling( Point3D( 1, 0, 1 ) ) ) )
+    {
+        return UnitTest::Fail( "Inverse of non-invertible affine transformation"
+                               " not zero" );
+    }
+
+    return UnitTest::PASS;
+}
+
+UnitTest::Result Matrix4x4TestGroup::Arrays()
+{
+    // Enough points to be split across threads, plus an odd one
+    const unsigned int cuiCount = 70001;
+    std::vector< double > oPoints( cuiCount * 3 );
+    std::vector< double > oVectors( cuiCount * 4 );
+    for( unsigned int i = 0; i < cuiCount * 4; ++i )
+    {
+        double dValue = ( ( i * 37 ) % 101 ) / 7.0 - 5;
+        oVectors[i] = ( 3 == i % 4 && 0 == i % 12 ? 0.0 : dValue );
+        if( 3 != i % 4 )
+        {
+            oPoints[ ( i / 4 ) * 3 + i % 4 ] = dValue;
+        }
+    }
+    std::vector< double > oX( cuiCount ), oY( cuiCount ), oZ( cuiCount );
+    for( unsigned int i = 0; i < cuiCount; ++i )
+    {
+        oX[i] = oPoints[ i * 3 ];
+        oY[i] = oPoints[ i * 3 + 1 ];
+        oZ[i] = oPoints[ i * 3 + 2 ];
+    }
+    Transform3D oProjection = Rotation( 0.3, -0.7, 1.1 ) *
+                              Translation( 1, -3, 2 ) *
+                              PerspectiveProjection( 2, 6, Point2D( 4, 4 ) );
+    AffineTransform3D oAffine = Space::Affine( Point3D( 2, 0.5, -1 ),
+                                               PointRotation( 0.3, -0.7, 1.1 ),
+                                               Point3D( 1, -3, 2 ) );
+
+    // Every version should match transforming one point at a time
+    std::vector< double > oProjected( cuiCount * 3 );
+    std::vector< double > oMoved( cuiCount * 3 );
+    std::vector< double > oTurned( cuiCount * 3 );
+    std::vector< double > oHVectors( oVectors );
+    std::vector< double > oMovedX( cuiCount ), oMovedY( cuiCount ),
+                          oMovedZ( cuiCount );
+    TransformPoints( &oPoints[0], &oProjected[0], cuiCount, oProjection );
+    TransformPoints( &oPoints[0], &oMoved[0], cuiCount, oAffine );
+    TransformDirections( &oPoints[0], &oTurned[0], cuiCount, oAffine );
+    TransformHVectors( &oHVectors[0], &oHVectors[0], cuiCount, oProjection );
+    TransformPoints( &oX[0], &oY[0], &oZ[0], &oMovedX[0], &oMovedY[0],
+                     &oMovedZ[0], cuiCount, oAffine );
+    TransformPoints( &oX[0], &oY[0], &oZ[0], &oX[0], &oY[0], &oZ[0],
+                     cuiCount, oProjection );
+    for( unsigned int i = 0; i < cuiCount; ++i )
+    {
+        Point3D oPoint( oPoints[ i * 3 ], oPoints[ i * 3 + 1 ],
+                        oPoints[ i * 3 + 2 ] );
+        Point3D oExpected( HVector3D( oPoint ) * oProjection );
+        if( oExpected != Point3D( oProjected[ i * 3 ], oProjected[ i * 3 + 1 ],
+                                  oProjected[ i * 3 + 2 ] ) ||
+            oExpected != Point3D( oX[i], oY[i], oZ[i] ) )
+        {
+            std::ostringstream oOut;
+            oOut << "Projection of point " << i << " other than " << oExpected;
+            return UnitTest::Fail( oOut.str() );
+        }
+        oExpected = HVector3D( oPoint ) * Homogeneous( oAffine );
+        if( oExpected != Point3D( oMoved[ i * 3 ], oMoved[ i * 3 + 1 ],
+                                  oMoved[ i * 3 + 2 ] ) ||
+            oExpected != Point3D( oMovedX[i], oMovedY[i], oMovedZ[i] ) )
+        {
+            std::ostringstream oOut;
+            oOut << "Affine transformation of point " << i << " other than "
+                 << oExpected;
+            return UnitTest::Fail( oOut.str() );
+        }
+        oExpected = oPoint * PointTransform3D( oAffine );
+        if( oExpected != Point3D( oTurned[ i * 3 ], oTurned[ i * 3 + 1 ],
+                                  oTurned[ i * 3 + 2 ] ) )
+        {
+            std::ostringstream oOut;
+            oOut << "Transformation of direction " << i << " other than "
+                 << oExpected;
+            return UnitTest::Fail( oOut.str() );
+        }
+        HVector3D oVector( oVectors[ i * 4 ], oVectors[ i * 4 + 1 ],
+                           oVectors[ i * 4 + 2 ], oVectors[ i * 4 + 3 ] );
+        HVector3D oExpectedVector = oVector * oProjection;
+        if( oExpectedVector != HVector3D( oHVectors[ i * 4 ],
+                                          oHVectors[ i * 4 + 1 ],
+                                          oHVectors[ i * 4 + 2 ],
+                                          oHVectors[ i * 4 + 3 ] ) )
+        {
+            std::ostringstream oOut;
+            oOut << "Projection of homogeneous vector " << i << " other than "
+                 << oExpectedVector;
+            return UnitTest::Fail( oOut.str() );
+        }
+    }
+
+    return UnitTest::PASS;
+}
+
 UnitTest::Result Matrix4x4TestGroup::Multiply()
 {
     // set up some matrices in advance
@@ -3,8 +3,8 @@
  * Author:             Elizabeth Lowry
  * Date Created:       January 5, 2014
  * Description:        4x4 Matrix tests.
- * Last Modified:      January 5, 2014
- * Last Modification:  Debugging.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Added array transformation test.
  ******************************************************************************/
 
 #ifndef MATRIX_4X4_TEST_GROUP__H
@@ -26,6 +26,9 @@ private:
     static UnitTest::Result Translate();
     static UnitTest::Result PointScale();
     static UnitTest::Result PointRotate();
+    static UnitTest::Result About();
+    static UnitTest::Result Affine();
+    static UnitTest::Result Arrays();
     static UnitTest::Result Multiply();
 
 };
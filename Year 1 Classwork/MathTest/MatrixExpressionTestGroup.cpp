@@ -0,0 +1,184 @@
+/******************************************************************************
+ * File:               MatrixExpressionTestGroup.cpp
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Lazy matrix expression tests.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Creation.
+ ******************************************************************************/
+
+#include "MatrixExpressionTestGroup.h"
+#include "MathLibrary.h"
+
+using namespace Space;
+using Math::Lazy;
+using Math::Matrix;
+
+namespace
+{
+
+// Matrices with no special structure, so mistakes in indexing show up
+Transform3D Filled( double a_dStart, double a_dStep )
+{
+    Transform3D oResult;
+    for( unsigned int i = 0; i < 16; ++i )
+    {
+        oResult[i/4][i%4] = a_dStart + a_dStep * ( ( i * 7 ) % 16 );
+    }
+    return oResult;
+}
+
+}   // namespace
+
+MatrixExpressionTestGroup::MatrixExpressionTestGroup()
+    : UnitTestGroup("Lazy matrix expression tests")
+{
+    AddTest( "Chain of transforms", TransformChain );
+    AddTest( "Addition, subtraction, and scalar multiplication",
+             SumsAndScalars );
+    AddTest( "Products of non-square matrices", NonSquare );
+    AddTest( "Assigning to an operand", Aliasing );
+}
+
+UnitTest::Result MatrixExpressionTestGroup::TransformChain()
+{
+    // same chain as the Drawable model matrix
+    Transform3D oBefore = Translation( Point3D( 1, -2, 0.5 ) );
+    Transform3D oAfter = Scaling( 0.25 );
+    Point3D oScale( 2, 3, 4 );
+    Rotation3D oRotation( 0.3, 1.1, -0.7 );
+    Point3D oPosition( -5, 6, 7 );
+    Transform3D oEager = oBefore * Scaling( oScale ) *
+                         oRotation.MakeTransform() *
+                         Translation( oPosition ) * oAfter;
+    Transform3D oLazy;
+    oLazy = Lazy( oBefore ) * Scaling( oScale ) * oRotation.MakeTransform() *
+            Translation( oPosition ) * oAfter;
+    if( oLazy != oEager )
+    {
+        return UnitTest::Fail( "Lazy transform chain differs from eager" );
+    }
+
+    // construction and Evaluate() should give the same result as assignment
+    Transform3D oConstructed( Lazy( oBefore ) * Scaling( oScale ) *
+                              oRotation.MakeTransform() *
+                              Translation( oPosition ) * oAfter );
+    if( oConstructed != oEager )
+    {
+        return UnitTest::Fail( "Matrix constructed from expression differs" );
+    }
+    if( ( Lazy( oBefore ) * oAfter ).Evaluate() != oBefore * oAfter )
+    {
+        return UnitTest::Fail( "Evaluated expression differs" );
+    }
+    return UnitTest::PASS;
+}
+
+UnitTest::Result MatrixExpressionTestGroup::SumsAndScalars()
+{
+    Transform3D oA = Filled( 1.5, 0.5 );
+    Transform3D oB = Filled( -3, 0.25 );
+    Transform3D oC = Filled( 2, -0.125 );
+    Transform3D oResult;
+
+    oResult = Lazy( oA ) + oB * 2;
+    if( oResult != oA + oB * 2 )
+    {
+        return UnitTest::Fail( "Lazy A + 2B differs from eager" );
+    }
+    oResult = Lazy( oA ) + Lazy( oB ) * oC;
+    if( oResult != oA + oB * oC )
+    {
+        return UnitTest::Fail( "Lazy A + B * C differs from eager" );
+    }
+    oResult = 0.5 * ( Lazy( oA ) - oB ) - oC * Lazy( oA ) * 3;
+    if( oResult != ( oA - oB ) * 0.5 - ( oC * oA ) * 3 )
+    {
+        return UnitTest::Fail( "Lazy ( A - B ) / 2 - 3CA differs from eager" );
+    }
+
+    // scaling an integer matrix should truncate the same way
+    Matrix< int, 2 > oInt;
+    oInt[0][0] = 3;
+    oInt[0][1] = -5;
+    oInt[1][0] = 7;
+    oInt[1][1] = 1;
+    Matrix< int, 2 > oIntResult;
+    oIntResult = Lazy( oInt ) * 1.5;
+    if( oIntResult != oInt * 1.5 )
+    {
+        return UnitTest::Fail( "Lazy integer scaling differs from eager" );
+    }
+    return UnitTest::PASS;
+}
+
+UnitTest::Result MatrixExpressionTestGroup::NonSquare()
+{
+    Matrix< double, 2, 3 > oA;
+    Matrix< double, 3, 4 > oB;
+    Matrix< double, 4, 2 > oC;
+    for( unsigned int i = 0; i < 12; ++i )
+    {
+        oB[i/4][i%4] = 0.5 * i - 2;
+        if( i < 6 )
+        {
+            oA[i/3][i%3] = 1.25 * i + 1;
+        }
+        if( i < 8 )
+        {
+            oC[i/2][i%2] = 3 - 0.75 * i;
+        }
+    }
+    Matrix< double, 2, 4 > oAB;
+    oAB = Lazy( oA ) * oB;
+    if( oAB != oA * oB )
+    {
+        return UnitTest::Fail( "Lazy 2x3 * 3x4 product differs from eager" );
+    }
+    Matrix< double, 2 > oABC;
+    oABC = Lazy( oA ) * oB * oC;
+    if( oABC != oA * oB * oC )
+    {
+        return UnitTest::Fail( "Lazy 2x3 * 3x4 * 4x2 product differs from "
+                               "eager" );
+    }
+    return UnitTest::PASS;
+}
+
+UnitTest::Result MatrixExpressionTestGroup::Aliasing()
+{
+    Transform3D oA = Filled( 1.5, 0.5 );
+    Transform3D oB = Filled( -3, 0.25 );
+
+    // target on the left of a product
+    Transform3D oResult = oA;
+    oResult = Lazy( oResult ) * oB;
+    if( oResult != oA * oB )
+    {
+        return UnitTest::Fail( "Assigning X * B to X gave the wrong result" );
+    }
+
+    // target on the right of a product
+    oResult = oA;
+    oResult = Lazy( oB ) * oResult;
+    if( oResult != oB * oA )
+    {
+        return UnitTest::Fail( "Assigning B * X to X gave the wrong result" );
+    }
+
+    // target used more than once
+    oResult = oA;
+    oResult = Lazy( oResult ) * oResult + oResult;
+    if( oResult != oA * oA + oA )
+    {
+        return UnitTest::Fail( "Assigning X * X + X to X gave the wrong "
+                               "result" );
+    }
+    oResult = oA;
+    oResult = oB - Lazy( oResult ) * 2;
+    if( oResult != oB - oA * 2 )
+    {
+        return UnitTest::Fail( "Assigning B - 2X to X gave the wrong result" );
+    }
+    return UnitTest::PASS;
+}
@@ -0,0 +1,30 @@
+/******************************************************************************
+ * File:               MatrixExpressionTestGroup.h
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Lazy matrix expression tests.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Creation.
+ ******************************************************************************/
+
+#ifndef MATRIX_EXPRESSION_TEST_GROUP__H
+#define MATRIX_EXPRESSION_TEST_GROUP__H
+
+#include "UnitTestGroup.h"
+
+class MatrixExpressionTestGroup : public UnitTestGroup
+{
+public:
+
+    MatrixExpressionTestGroup();
+
+private:
+
+    static UnitTest::Result TransformChain();
+    static UnitTest::Result SumsAndScalars();
+    static UnitTest::Result NonSquare();
+    static UnitTest::Result Aliasing();
+
+};
+
+#endif  // MATRIX_EXPRESSION_TEST_GROUP__H
@@ -0,0 +1,482 @@
+/******************************************************************************
+ * File:               QuadtreeTestGroup.cpp
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Loose quadtree tests.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Creation.
+ ******************************************************************************/
+
+#include "QuadtreeTestGroup.h"
+#include "MathLibrary.h"
+#include <algorithm>
+#include <sstream>
+#include <vector>
+
+using Plane::Quadtree;
+
+namespace
+{
+
+typedef Quadtree< unsigned int > Tree;
+
+// Repeatable pseudo-random values in [a_dLow, a_dHigh)
+double Next( unsigned int& a_ruiSeed, double a_dLow, double a_dHigh )
+{
+    a_ruiSeed = a_ruiSeed * 1664525u + 1013904223u;
+    return a_dLow + ( a_dHigh - a_dLow ) * ( ( a_ruiSeed >> 8 ) / 16777216.0 );
+}
+
+struct Area
+{
+    double adMin[2];
+    double adMax[2];
+};
+
+// Mostly small rectangles, some large ones, and a few outside the world
+Area RandomRectangle( unsigned int& a_ruiSeed )
+{
+    double dRange = ( 1.0 > Next( a_ruiSeed, 0, 50 ) ? 1500 : 1000 );
+    double dSize = Next( a_ruiSeed, 0, 1 ) < 0.1 ? 300 : 20;
+    Area oRectangle;
+    for( unsigned int i = 0; i < 2; ++i )
+    {
+        oRectangle.adMin[i] = Next( a_ruiSeed, -dRange, dRange );
+        oRectangle.adMax[i] = oRectangle.adMin[i] +
+                              Next( a_ruiSeed, 0, dSize );
+    }
+    return oRectangle;
+}
+
+// Every object in the tree, kept alongside it so queries can be checked
+// against a search of every object
+class Reference
+{
+public:
+
+    Reference( Tree& a_roTree ) : m_roTree( a_roTree ) {}
+
+    void Insert( const Area& ac_roRectangle )
+    {
+        unsigned int uiHandle =
+            m_roTree.Insert( (unsigned int)m_oObjects.size(),
+                             ac_roRectangle.adMin[0], ac_roRectangle.adMin[1],
+                             ac_roRectangle.adMax[0], ac_roRectangle.adMax[1] );
+        m_oObjects.push_back( ac_roRectangle );
+        m_oHandles.push_back( uiHandle );
+    }
+
+    void Update( unsigned int a_uiObject, const Area& ac_roRectangle )
+    {
+        m_oObjects[ a_uiObject ] = ac_roRectangle;
+        m_roTree.Update( m_oHandles[ a_uiObject ],
+                         ac_roRectangle.adMin[0], ac_roRectangle.adMin[1],
+                         ac_roRectangle.adMax[0], ac_roRectangle.adMax[1] );
+    }
+
+    // Remove by swapping the last object into the removed one's place
+    void Remove( unsigned int a_uiObject )
+    {
+        m_roTree.Remove( m_oHandles[ a_uiObject ] );
+        unsigned int uiLast = (unsigned int)m_oObjects.size() - 1;
+        if( a_uiObject != uiLast )
+        {
+            m_oObjects[ a_uiObject ] = m_oObjects[ uiLast ];
+            m_oHandles[ a_uiObject ] = m_oHandles[ uiLast ];
+            m_roTree.Value( m_oHandles[ a_uiObject ] ) = a_uiObject;
+        }
+        m_oObjects.pop_back();
+        m_oHandles.pop_back();
+    }
+
+    unsigned int Size() const { return (unsigned int)m_oObjects.size(); }
+    const Area& Get( unsigned int a_uiObject ) const
+    { return m_oObjects[ a_uiObject ]; }
+
+    // Compare the objects found by a query, by their values, to the objects
+    // the test accepts
+    template< typename Test >
+    bool Check( const std::vector< unsigned int >& ac_roHandles,
+                const Test& ac_roTest ) const
+    {
+        std::vector< unsigned int > oFound;
+        for( unsigned int i = 0; i < ac_roHandles.size(); ++i )
+        {
+            oFound.push_back( m_roTree.Value( ac_roHandles[i] ) );
+        }
+        std::sort( oFound.begin(), oFound.end() );
+        std::vector< unsigned int > oExpected;
+        for( unsigned int i = 0; i < m_oObjects.size(); ++i )
+        {
+            if( ac_roTest( m_oObjects[i] ) )
+            {
+                oExpected.push_back( i );
+            }
+        }
+        return oFound == oExpected;
+    }
+
+    // Run one of each kind of query and check the results
+    std::string Query( unsigned int& a_ruiSeed ) const;
+
+private:
+
+    Tree& m_roTree;
+    std::vector< Area > m_oObjects;
+    std::vector< unsigned int > m_oHandles;
+
+};
+
+// Brute-force versions of the query tests
+struct InRectangle
+{
+    Area oArea;
+    bool operator()( const Area& ac_roObject ) const
+    {
+        return ac_roObject.adMin[0] <= oArea.adMax[0] &&
+               ac_roObject.adMax[0] >= oArea.adMin[0] &&
+               ac_roObject.adMin[1] <= oArea.adMax[1] &&
+               ac_roObject.adMax[1] >= oArea.adMin[1];
+    }
+};
+struct InCircle
+{
+    double dX, dY, dRadius;
+    bool operator()( const Area& ac_roObject ) const
+    {
+        double dNearestX = std::max( ac_roObject.adMin[0],
+                                     std::min( dX, ac_roObject.adMax[0] ) );
+        double dNearestY = std::max( ac_roObject.adMin[1],
+                                     std::min( dY, ac_roObject.adMax[1] ) );
+        return ( dNearestX - dX ) * ( dNearestX - dX ) +
+               ( dNearestY - dY ) * ( dNearestY - dY ) <= dRadius * dRadius;
+    }
+};
+struct OnRay
+{
+    double dX, dY, dDirectionX, dDirectionY, dLength;
+    bool operator()( const Area& ac_roObject ) const
+    {
+        // skip objects nowhere near the ray, then step along it finely
+        // enough that it can't skip over much of an object
+        double dEndX = dX + dDirectionX * dLength;
+        double dEndY = dY + dDirectionY * dLength;
+        if( ac_roObject.adMax[0] < std::min( dX, dEndX ) ||
+            ac_roObject.adMin[0] > std::max( dX, dEndX ) ||
+            ac_roObject.adMax[1] < std::min( dY, dEndY ) ||
+            ac_roObject.adMin[1] > std::max( dY, dEndY ) )
+        {
+            return false;
+        }
+        const unsigned int cuiSteps = 4000;
+        for( unsigned int i = 0; i <= cuiSteps; ++i )
+        {
+            double dT = dLength * i / cuiSteps;
+            double dPX = dX + dDirectionX * dT;
+            double dPY = dY + dDirectionY * dT;
+            if( dPX >= ac_roObject.adMin[0] && dPX <= ac_roObject.adMax[0] &&
+                dPY >= ac_roObject.adMin[1] && dPY <= ac_roObject.adMax[1] )
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+std::string Reference::Query( unsigned int& a_ruiSeed ) const
+{
+    std::vector< unsigned int > oResults;
+
+    InRectangle oRectangle;
+    oRectangle.oArea = RandomRectangle( a_ruiSeed );
+    oRectangle.oArea.adMax[0] += Next( a_ruiSeed, 0, 200 );
+    oRectangle.oArea.adMax[1] += Next( a_ruiSeed, 0, 200 );
+    m_roTree.QueryRectangle( oRectangle.oArea.adMin[0],
+                             oRectangle.oArea.adMin[1],
+                             oRectangle.oArea.adMax[0],
+                             oRectangle.oArea.adMax[1], oResults );
+    if( !Check( oResults, oRectangle ) )
+    {
+        return "Rectangle query results don't match";
+    }
+
+    InCircle oCircle = { Next( a_ruiSeed, -1100, 1100 ),
+                         Next( a_ruiSeed, -1100, 1100 ),
+                         Next( a_ruiSeed, 0, 150 ) };
+    oResults.clear();
+    m_roTree.QueryCircle( oCircle.dX, oCircle.dY, oCircle.dRadius, oResults );
+    if( !Check( oResults, oCircle ) )
+    {
+        return "Circle query results don't match";
+    }
+
+    // Stepping along a ray can miss the corner of an object, so the tree's
+    // results are only required to include everything the steps hit
+    OnRay oRay = { Next( a_ruiSeed, -1100, 1100 ),
+                   Next( a_ruiSeed, -1100, 1100 ),
+                   Next( a_ruiSeed, -1, 1 ), Next( a_ruiSeed, -1, 1 ),
+                   Next( a_ruiSeed, 0, 400 ) };
+    oResults.clear();
+    m_roTree.QueryRay( oRay.dX, oRay.dY, oRay.dDirectionX, oRay.dDirectionY,
+                       oRay.dLength, oResults );
+    std::vector< unsigned int > oFound;
+    for( unsigned int i = 0; i < oResults.size(); ++i )
+    {
+        oFound.push_back( m_roTree.Value( oResults[i] ) );
+    }
+    std::sort( oFound.begin(), oFound.end() );
+    for( unsigned int i = 0; i < m_oObjects.size(); ++i )
+    {
+        if( oRay( m_oObjects[i] ) &&
+            !std::binary_search( oFound.begin(), oFound.end(), i ) )
+        {
+            return "Ray query missed an object";
+        }
+    }
+    return "";
+}
+
+}   // namespace
+
+QuadtreeTestGroup::QuadtreeTestGroup()
+    : UnitTestGroup("Loose quadtree tests")
+{
+    AddTest( "Touching, flat, and out-of-world objects", Edges );
+    AddTest( "Queries compared to searching every object", Queries );
+    AddTest( "Moving, adding, and removing objects", Moving );
+    AddTest( "Splitting and merging nodes", Rebalancing );
+}
+
+UnitTest::Result QuadtreeTestGroup::Edges()
+{
+    Tree oTree( 0, 0, 100, 100 );
+    unsigned int uiPoint = oTree.Insert( 0, 10, 10, 10, 10 );
+    unsigned int uiLine = oTree.Insert( 1, 20, 0, 20, 100 );
+    unsigned int uiOutside = oTree.Insert( 2, 500, 500, 510, 510 );
+    unsigned int uiHuge = oTree.Insert( 3, -1000, -1000, 1000, 1000 );
+    std::vector< unsigned int > oResults;
+
+    // Touching counts as overlapping
+    oTree.QueryRectangle( 0, 0, 10, 10, oResults );
+    if( 2 != oResults.size() ||
+        std::find( oResults.begin(), oResults.end(), uiPoint ) ==
+            oResults.end() )
+    {
+        return UnitTest::Fail( "Rectangle touching a point missed it" );
+    }
+    oResults.clear();
+    oTree.QueryCircle( 17, 50, 3, oResults );
+    if( 2 != oResults.size() ||
+        std::find( oResults.begin(), oResults.end(), uiLine ) ==
+            oResults.end() )
+    {
+        return UnitTest::Fail( "Circle touching a line missed it" );
+    }
+
+    // Objects outside the world can still be found
+    oResults.clear();
+    oTree.QueryRectangle( 505, 505, 600, 600, oResults );
+    if( 2 != oResults.size() ||
+        std::find( oResults.begin(), oResults.end(), uiOutside ) ==
+            oResults.end() )
+    {
+        return UnitTest::Fail( "Object outside the world wasn't found" );
+    }
+
+    // Rays parallel to an axis, and rays that stop short
+    oResults.clear();
+    oTree.QueryRay( 0, 50, 1, 0, 19.5, oResults );
+    if( 1 != oResults.size() || uiHuge != oResults[0] )
+    {
+        return UnitTest::Fail( "Ray that stops short hit something" );
+    }
+    oResults.clear();
+    oTree.QueryRay( 0, 50, 1, 0, 20, oResults );
+    if( 2 != oResults.size() )
+    {
+        return UnitTest::Fail( "Ray along the x-axis missed a line" );
+    }
+    oResults.clear();
+    oTree.QueryRay( 10, 0, 0, 2, 5, oResults );
+    if( 2 != oResults.size() )
+    {
+        return UnitTest::Fail( "Ray along the y-axis missed a point" );
+    }
+
+    // Removed handles are reused, and removing them twice does nothing
+    oTree.Remove( uiPoint );
+    oTree.Remove( uiPoint );
+    if( oTree.Contains( uiPoint ) || 3 != oTree.Count() )
+    {
+        return UnitTest::Fail( "Removed object is still there" );
+    }
+    if( uiPoint != oTree.Insert( 4, 0, 0, 1, 1 ) || 4 != oTree.Value( uiPoint ) )
+    {
+        return UnitTest::Fail( "Removed object's handle wasn't reused" );
+    }
+
+    oTree.Clear();
+    oResults.clear();
+    oTree.QueryRectangle( -1e9, -1e9, 1e9, 1e9, oResults );
+    if( 0 != oTree.Count() || 1 != oTree.NodeCount() || !oResults.empty() )
+    {
+        return UnitTest::Fail( "Clearing the tree didn't empty it" );
+    }
+
+    return UnitTest::PASS;
+}
+
+UnitTest::Result QuadtreeTestGroup::Queries()
+{
+    // Objects added all at once, with several different depth limits
+    const unsigned int cauiDepths[3] = { 0, 4, 16 };
+    for( unsigned int d = 0; d < 3; ++d )
+    {
+        Tree oTree( -1000, -1000, 1000, 1000, cauiDepths[d] );
+        Reference oReference( oTree );
+        unsigned int uiSeed = 24680 + d;
+        for( unsigned int i = 0; i < 3000; ++i )
+        {
+            oReference.Insert( RandomRectangle( uiSeed ) );
+        }
+        oTree.Rebalance();
+        if( ( 0 == cauiDepths[d] ) != ( 1 == oTree.NodeCount() ) )
+        {
+            return UnitTest::Fail( "Tree split the wrong number of nodes" );
+        }
+        for( unsigned int i = 0; i < 200; ++i )
+        {
+            std::string oFailure = oReference.Query( uiSeed );
+            if( !oFailure.empty() )
+            {
+                std::ostringstream oOut;
+                oOut << oFailure << " with depth limit " << cauiDepths[d];
+                return UnitTest::Fail( oOut.str() );
+            }
+        }
+    }
+    return UnitTest::PASS;
+}
+
+UnitTest::Result QuadtreeTestGroup::Moving()
+{
+    Tree oTree( -1000, -1000, 1000, 1000 );
+    Reference oReference( oTree );
+    unsigned int uiSeed = 13579;
+    for( unsigned int i = 0; i < 1000; ++i )
+    {
+        oReference.Insert( RandomRectangle( uiSeed ) );
+    }
+
+    // Each frame, move most objects a little and a few a long way, add and
+    // remove a few, and rebalance only a little, so queries run against trees
+    // in every state of balance
+    for( unsigned int uiFrame = 0; uiFrame < 60; ++uiFrame )
+    {
+        for( unsigned int i = 0; i < oReference.Size(); ++i )
+        {
+            Area oRectangle = RandomRectangle( uiSeed );
+            if( 0.9 > Next( uiSeed, 0, 1 ) )
+            {
+                oRectangle = oReference.Get( i );
+                double dX = Next( uiSeed, -8, 8 );
+                double dY = Next( uiSeed, -8, 8 );
+                oRectangle.adMin[0] += dX;
+                oRectangle.adMax[0] += dX;
+                oRectangle.adMin[1] += dY;
+                oRectangle.adMax[1] += dY;
+            }
+            oReference.Update( i, oRectangle );
+        }
+        for( unsigned int i = 0; i < 20; ++i )
+        {
+            oReference.Insert( RandomRectangle( uiSeed ) );
+            oReference.Remove( (unsigned int)Next( uiSeed, 0,
+                                                   oReference.Size() ) );
+        }
+        oTree.Rebalance( uiFrame % 4 );
+        std::string oFailure = oReference.Query( uiSeed );
+        if( !oFailure.empty() )
+        {
+            std::ostringstream oOut;
+            oOut << oFailure << " on frame " << uiFrame;
+            return UnitTest::Fail( oOut.str() );
+        }
+    }
+    if( oReference.Size() != oTree.Count() )
+    {
+        return UnitTest::Fail( "Object count doesn't match" );
+    }
+    return UnitTest::PASS;
+}
+
+UnitTest::Result QuadtreeTestGroup::Rebalancing()
+{
+    // Crowding small objects into one corner splits nodes all the way down
+    Tree oTree( 0, 0, 1024, 1024, 6 );
+    std::vector< unsigned int > oHandles;
+    for( unsigned int i = 0; i < 200; ++i )
+    {
+        double dX = ( i % 20 ) * 0.5;
+        double dY = ( i / 20 ) * 0.5;
+        oHandles.push_back( oTree.Insert( i, dX, dY, dX + 0.25, dY + 0.25 ) );
+    }
+    if( 1 != oTree.NodeCount() || 0 == oTree.QueuedCount() )
+    {
+        return UnitTest::Fail( "Nodes split before rebalancing" );
+    }
+    oTree.Rebalance( 1 );
+    if( 5 != oTree.NodeCount() )
+    {
+        return UnitTest::Fail( "Rebalancing one node didn't split the root" );
+    }
+    if( 0 != oTree.Rebalance() || 1 + 4 * 6 != oTree.NodeCount() )
+    {
+        std::ostringstream oOut;
+        oOut << oTree.NodeCount() << " nodes after splitting instead of "
+             << 1 + 4 * 6;
+        return UnitTest::Fail( oOut.str() );
+    }
+
+    // Large objects stay near the root, however crowded it gets
+    Tree oLarge( 0, 0, 1024, 1024 );
+    for( unsigned int i = 0; i < 50; ++i )
+    {
+        oLarge.Insert( i, i, i, i + 600, i + 600 );
+    }
+    oLarge.Rebalance();
+    if( 1 != oLarge.NodeCount() )
+    {
+        return UnitTest::Fail( "Root split for objects that don't fit below" );
+    }
+
+    // Removing the objects merges the nodes back into the root, and the
+    // freed nodes are reused
+    for( unsigned int i = 0; i < 196; ++i )
+    {
+        oTree.Remove( oHandles[i] );
+    }
+    oTree.Rebalance();
+    if( 1 != oTree.NodeCount() )
+    {
+        std::ostringstream oOut;
+        oOut << oTree.NodeCount() << " nodes left after merging";
+        return UnitTest::Fail( oOut.str() );
+    }
+    for( unsigned int i = 0; i < 196; ++i )
+    {
+        double dX = ( i % 20 ) * 0.5;
+        double dY = ( i / 20 ) * 0.5;
+        oHandles[i] = oTree.Insert( i, dX, dY, dX + 0.25, dY + 0.25 );
+    }
+    oTree.Rebalance();
+    std::vector< unsigned int > oResults;
+    oTree.QueryRectangle( 0, 0, 1024, 1024, oResults );
+    if( 1 + 4 * 6 != oTree.NodeCount() || 200 != oResults.size() )
+    {
+        return UnitTest::Fail( "Tree wrong after splitting again" );
+    }
+
+    return UnitTest::PASS;
+}
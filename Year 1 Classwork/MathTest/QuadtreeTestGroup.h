@@ -0,0 +1,30 @@
+/******************************************************************************
+ * File:               QuadtreeTestGroup.h
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Loose quadtree tests.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Creation.
+ ******************************************************************************/
+
+#ifndef QUADTREE_TEST_GROUP__H
+#define QUADTREE_TEST_GROUP__H
+
+#include "UnitTestGroup.h"
+
+class QuadtreeTestGroup : public UnitTestGroup
+{
+public:
+
+    QuadtreeTestGroup();
+
+private:
+
+    static UnitTest::Result Edges();
+    static UnitTest::Result Queries();
+    static UnitTest::Result Moving();
+    static UnitTest::Result Rebalancing();
+
+};
+
+#endif  // QUADTREE_TEST_GROUP__H
@@ -0,0 +1,334 @@
+/******************************************************************************
+ * File:               QuaternionTestGroup.cpp
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Quaternion tests.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Added a test for spinning past the target.
+ ******************************************************************************/
+
+#include "QuaternionTestGroup.h"
+#include "MathLibrary.h"
+#include <cmath>
+
+namespace
+{
+
+// Angle of the rotation taking one quaternion to the other
+double AngleBetween( const Rotation3D& ac_roA, const Rotation3D& ac_roB )
+{
+    double dCos = std::abs( ac_roA.Dot( ac_roB ) );
+    return 2 * std::acos( 1.0 < dCos ? 1.0 : dCos );
+}
+
+// Slerp the way it used to be done, by raising the difference between the two
+// rotations to a power
+Rotation3D PowerSlerp( const Rotation3D& ac_roFrom,
+                       const Rotation3D& ac_roTo,
+                       double a_dProgress )
+{
+    Rotation3D oDifference = ( ac_roTo / ac_roFrom ).Clamp();
+    return ( ( oDifference ^ a_dProgress ) * ac_roFrom ).Normalize();
+}
+
+// A handful of rotations to interpolate between
+const unsigned int ROTATION_COUNT = 6;
+Rotation3D Rotation( unsigned int a_uiIndex )
+{
+    switch( a_uiIndex % ROTATION_COUNT )
+    {
+    case 0: return Rotation3D( 0.3, Point3D( 1, 0, 0 ) );
+    case 1: return Rotation3D( 1.2, Point3D( 0, 1, 0 ) );
+    case 2: return Rotation3D( 2.5, Point3D( 1, 2, 2 ) );
+    case 3: return Rotation3D( 0.1, 0.7, -0.4 );
+    case 4: return Rotation3D( -2.9, Point3D( 0, 0, 1 ) );
+    default: return Rotation3D( 0.31, Point3D( 1, 0.01, 0 ) );
+    }
+}
+
+// Largest acceptable difference, in radians, between exact results
+const double TOLERANCE = 0.00001;
+
+}   // namespace
+
+QuaternionTestGroup::QuaternionTestGroup()
+    : UnitTestGroup("Quaternion tests")
+{
+    AddTest( "Multiplication", Multiplication );
+    AddTest( "Slerp endpoints", SlerpEndpoints );
+    AddTest( "Slerp matches raising to a power", SlerpAccuracy );
+    AddTest( "Slerp takes the shorter path", SlerpShortestPath );
+    AddTest( "Unclamped slerp spins past the target", SlerpSpin );
+    AddTest( "Normalized linear interpolation", Nlerp );
+    AddTest( "Approximate slerp", FastSlerp );
+    AddTest( "Interpolating arrays", ArrayInterpolation );
+}
+
+UnitTest::Result QuaternionTestGroup::Multiplication()
+{
+    // two quarter turns about the same axis make a half turn
+    Rotation3D oQuarter( Math::HALF_PI, Point3D::Unit(2) );
+    if( AngleBetween( oQuarter * oQuarter, Rotation3D::Half(2) ) > TOLERANCE )
+    {
+        return UnitTest::Fail( "Two quarter turns don't make a half turn" );
+    }
+
+    // a rotation times its inverse is no rotation
+    Rotation3D oRotation = Rotation(2);
+    if( AngleBetween( oRotation * oRotation.Inverse(),
+                      Rotation3D::None() ) > TOLERANCE )
+    {
+        return UnitTest::Fail( "Rotation times inverse isn't the identity" );
+    }
+    return UnitTest::PASS;
+}
+
+UnitTest::Result QuaternionTestGroup::SlerpEndpoints()
+{
+    Rotation3D oFrom = Rotation(0);
+    Rotation3D oTo = Rotation(2);
+    if( oFrom.Slerped( oTo, 0.0 ) != oFrom )
+    {
+        return UnitTest::Fail( "Slerp with no progress changed the rotation" );
+    }
+    if( oFrom.Slerped( oTo, 1.0 ) != oTo )
+    {
+        return UnitTest::Fail( "Slerp with full progress didn't reach target" );
+    }
+    if( AngleBetween( oFrom.Slerped( oTo, 0.999999 ), oTo ) > TOLERANCE )
+    {
+        return UnitTest::Fail( "Slerp is discontinuous near the target" );
+    }
+    return UnitTest::PASS;
+}
+
+UnitTest::Result QuaternionTestGroup::SlerpAccuracy()
+{
+    for( unsigned int uiFrom = 0; uiFrom < ROTATION_COUNT; ++uiFrom )
+    {
+        for( unsigned int uiTo = 0; uiTo < ROTATION_COUNT; ++uiTo )
+        {
+            if( uiFrom == uiTo )
+            {
+                continue;
+            }
+            Rotation3D oFrom = Rotation( uiFrom );
+            Rotation3D oTo = Rotation( uiTo );
+            for( double dProgress = 0.1; dProgress < 1.0; dProgress += 0.2 )
+            {
+                Rotation3D oSlerp = oFrom.Slerped( oTo, dProgress );
+                if( AngleBetween( oSlerp,
+                                  PowerSlerp( oFrom, oTo, dProgress ) )
+                    > TOLERANCE )
+                {
+                    return UnitTest::Fail( "Slerp doesn't match difference "
+                                           "raised to a power" );
+                }
+                if( std::abs( oSlerp.Dot( oSlerp ) - 1.0 ) > TOLERANCE )
+                {
+                    return UnitTest::Fail( "Slerp result isn't normalized" );
+                }
+            }
+        }
+    }
+    return UnitTest::PASS;
+}
+
+UnitTest::Result QuaternionTestGroup::SlerpShortestPath()
+{
+    // -q is the same rotation as q, so slerping towards it shouldn't move
+    Rotation3D oFrom = Rotation(3);
+    Rotation3D oNegative = oFrom;
+    for( unsigned int ui = 0; ui < 4; ++ui )
+    {
+        oNegative[ ui ] = -oNegative[ ui ];
+    }
+    if( AngleBetween( oFrom.Slerped( oNegative, 0.5 ), oFrom ) > TOLERANCE )
+    {
+        return UnitTest::Fail( "Slerp to negated quaternion moved" );
+    }
+
+    // halfway should be half the angle between the two
+    Rotation3D oTo = Rotation(4);
+    double dAngle = AngleBetween( oFrom, oTo );
+    if( std::abs( AngleBetween( oFrom, oFrom.Slerped( oTo, 0.5 ) ) -
+                  dAngle / 2 ) > TOLERANCE )
+    {
+        return UnitTest::Fail( "Slerp halfway didn't go half the angle" );
+    }
+    return UnitTest::PASS;
+}
+
+// Progress outside [0,1] keeps turning along the same path, which nlerp can't
+// do even for small angles.  Rotations 0 and 5 are about 0.01 radians apart.
+UnitTest::Result QuaternionTestGroup::SlerpSpin()
+{
+    const double cadProgress[] = { -3.0, -0.5, 1.5, 7.0, 50.0, 300.0 };
+    for( unsigned int uiFrom = 0; uiFrom < ROTATION_COUNT; ++uiFrom )
+    {
+        for( unsigned int uiTo = 0; uiTo < ROTATION_COUNT; ++uiTo )
+        {
+            if( uiFrom == uiTo )
+            {
+                continue;
+            }
+            Rotation3D oFrom = Rotation( uiFrom );
+            Rotation3D oTo = Rotation( uiTo );
+            for( unsigned int ui = 0; ui < 6; ++ui )
+            {
+                if( AngleBetween( oFrom.Slerped( oTo, cadProgress[ ui ] ),
+                                  PowerSlerp( oFrom, oTo, cadProgress[ ui ] ) )
+                    > TOLERANCE )
+                {
+                    return UnitTest::Fail( "Slerp past either end doesn't "
+                                           "match difference raised to a "
+                                           "power" );
+                }
+            }
+        }
+    }
+
+    // Spinning at a fixed rate without stopping at the target
+    Rotation3D oFrom = Rotation(0);
+    Rotation3D oTo = Rotation(5);
+    double dAngle = AngleBetween( oFrom, oTo );
+    for( double dSeconds = 0.25; dSeconds < 3.0; dSeconds += 0.25 )
+    {
+        Rotation3D oSpun = oFrom.Slerped( oTo, 1.0, dSeconds, false );
+        if( AngleBetween( oSpun,
+                          PowerSlerp( oFrom, oTo, dSeconds / dAngle ) )
+            > TOLERANCE )
+        {
+            return UnitTest::Fail( "Unclamped slerp doesn't match difference "
+                                   "raised to a power" );
+        }
+        if( std::abs( AngleBetween( oFrom, oSpun ) - dSeconds ) > TOLERANCE )
+        {
+            return UnitTest::Fail( "Unclamped slerp didn't turn at the given "
+                                   "rate" );
+        }
+    }
+    return UnitTest::PASS;
+}
+
+UnitTest::Result QuaternionTestGroup::Nlerp()
+{
+    // for nearly identical rotations, nlerp and slerp should agree
+    Rotation3D oFrom = Rotation(0);
+    Rotation3D oTo = Rotation(5);
+    if( AngleBetween( oFrom.Nlerped( oTo, 0.3 ),
+                      oFrom.Slerped( oTo, 0.3 ) ) > TOLERANCE )
+    {
+        return UnitTest::Fail( "Nlerp differs from slerp for a small angle" );
+    }
+
+    // nlerp should hit the ends and stay normalized
+    oTo = Rotation(2);
+    if( AngleBetween( oFrom.Nlerped( oTo, 1.0 ), oTo ) > TOLERANCE )
+    {
+        return UnitTest::Fail( "Nlerp with full progress didn't reach target" );
+    }
+    Rotation3D oNlerp = oFrom.Nlerped( oTo, 0.4 );
+    if( std::abs( oNlerp.Dot( oNlerp ) - 1.0 ) > TOLERANCE )
+    {
+        return UnitTest::Fail( "Nlerp result isn't normalized" );
+    }
+    return UnitTest::PASS;
+}
+
+UnitTest::Result QuaternionTestGroup::FastSlerp()
+{
+    for( unsigned int uiFrom = 0; uiFrom < ROTATION_COUNT; ++uiFrom )
+    {
+        for( unsigned int uiTo = 0; uiTo < ROTATION_COUNT; ++uiTo )
+        {
+            Rotation3D oFrom = Rotation( uiFrom );
+            Rotation3D oTo = Rotation( uiTo );
+            for( double dProgress = 0.0; dProgress <= 1.0; dProgress += 0.125 )
+            {
+                if( AngleBetween( oFrom.FastSlerped( oTo, dProgress ),
+                                  oFrom.Slerped( oTo, dProgress ) )
+                    > Rotation3D::FastSlerpError() )
+                {
+                    return UnitTest::Fail( "Approximate slerp is off by more "
+                                           "than the stated error" );
+                }
+            }
+        }
+    }
+    return UnitTest::PASS;
+}
+
+UnitTest::Result QuaternionTestGroup::ArrayInterpolation()
+{
+    // fill arrays, both as quaternion objects and as packed doubles
+    Rotation3D aoFrom[ ROTATION_COUNT ];
+    Rotation3D aoTo[ ROTATION_COUNT ];
+    Rotation3D aoResult[ ROTATION_COUNT ];
+    double adFrom[ 4 * ROTATION_COUNT ];
+    double adTo[ 4 * ROTATION_COUNT ];
+    double adResult[ 4 * ROTATION_COUNT ];
+    for( unsigned int ui = 0; ui < ROTATION_COUNT; ++ui )
+    {
+        aoFrom[ ui ] = Rotation( ui );
+        aoTo[ ui ] = Rotation( ui + 2 );
+        for( unsigned int uj = 0; uj < 4; ++uj )
+        {
+            adFrom[ 4*ui + uj ] = aoFrom[ ui ][ uj ];
+            adTo[ 4*ui + uj ] = aoTo[ ui ][ uj ];
+        }
+    }
+
+    // each array result should match interpolating one at a time
+    Rotation3D::Slerp( aoFrom, aoTo, 0.25, aoResult, ROTATION_COUNT );
+    Rotation3D::Slerp( adFrom, adTo, 0.25, adResult, ROTATION_COUNT );
+    for( unsigned int ui = 0; ui < ROTATION_COUNT; ++ui )
+    {
+        Rotation3D oExpected = aoFrom[ ui ].Slerped( aoTo[ ui ], 0.25 );
+        if( aoResult[ ui ] != oExpected )
+        {
+            return UnitTest::Fail( "Array slerp doesn't match single slerp" );
+        }
+        for( unsigned int uj = 0; uj < 4; ++uj )
+        {
+            if( adResult[ 4*ui + uj ] != oExpected[ uj ] )
+            {
+                return UnitTest::Fail( "Packed array slerp doesn't match "
+                                       "single slerp" );
+            }
+        }
+    }
+    Rotation3D::Nlerp( aoFrom, aoTo, 0.75, aoResult, ROTATION_COUNT );
+    Rotation3D::FastSlerp( adFrom, adTo, 0.75, adResult, ROTATION_COUNT );
+    for( unsigned int ui = 0; ui < ROTATION_COUNT; ++ui )
+    {
+        if( aoResult[ ui ] != aoFrom[ ui ].Nlerped( aoTo[ ui ], 0.75 ) )
+        {
+            return UnitTest::Fail( "Array nlerp doesn't match single nlerp" );
+        }
+        Rotation3D oExpected = aoFrom[ ui ].FastSlerped( aoTo[ ui ], 0.75 );
+        for( unsigned int uj = 0; uj < 4; ++uj )
+        {
+            if( adResult[ 4*ui + uj ] != oExpected[ uj ] )
+            {
+                return UnitTest::Fail( "Packed array approximate slerp doesn't "
+                                       "match single approximate slerp" );
+            }
+        }
+    }
+
+    // results can be written over the input
+    Rotation3D::Slerp( adFrom, adTo, 0.5, adFrom, ROTATION_COUNT );
+    for( unsigned int ui = 0; ui < ROTATION_COUNT; ++ui )
+    {
+        Rotation3D oExpected = aoFrom[ ui ].Slerped( aoTo[ ui ], 0.5 );
+        for( unsigned int uj = 0; uj < 4; ++uj )
+        {
+            if( adFrom[ 4*ui + uj ] != oExpected[ uj ] )
+            {
+                return UnitTest::Fail( "In-place array slerp is wrong" );
+            }
+        }
+    }
+    return UnitTest::PASS;
+}
@@ -0,0 +1,34 @@
+/******************************************************************************
+ * File:               QuaternionTestGroup.h
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Quaternion tests.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Added a test for spinning past the target.
+ ******************************************************************************/
+
+#ifndef QUATERNION_TEST_GROUP__H
+#define QUATERNION_TEST_GROUP__H
+
+#include "UnitTestGroup.h"
+
+class QuaternionTestGroup : public UnitTestGroup
+{
+public:
+
+    QuaternionTestGroup();
+
+private:
+
+    static UnitTest::Result Multiplication();
+    static UnitTest::Result SlerpEndpoints();
+    static UnitTest::Result SlerpAccuracy();
+    static UnitTest::Result SlerpShortestPath();
+    static UnitTest::Result SlerpSpin();
+    static UnitTest::Result Nlerp();
+    static UnitTest::Result FastSlerp();
+    static UnitTest::Result ArrayInterpolation();
+
+};
+
+#endif  // QUATERNION_TEST_GROUP__H
@@ -0,0 +1,205 @@
+/******************************************************************************
+ * File:               ResidencyListTestGroup.cpp
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Least-recently-used residency list tests.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Creation.
+ ******************************************************************************/
+
+#include "ResidencyListTestGroup.h"
+#include "MathLibrary.h"
+#include <vector>
+
+using Utility::ResidencyList;
+
+namespace
+{
+
+typedef ResidencyList< unsigned int > List;
+
+// Evict everything the list asks for, in order
+std::vector< unsigned int > EvictAll( List& a_roList )
+{
+    std::vector< unsigned int > oEvicted;
+    unsigned int uiItem = 0;
+    while( a_roList.NextEviction( uiItem ) )
+    {
+        oEvicted.push_back( uiItem );
+    }
+    return oEvicted;
+}
+
+}   // namespace
+
+ResidencyListTestGroup::ResidencyListTestGroup()
+    : UnitTestGroup("Residency list tests")
+{
+    AddTest( "Hits and misses", HitsAndMisses );
+    AddTest( "Evicting the least recently used", LeastRecentlyUsed );
+    AddTest( "Pinned resources", Pinning );
+    AddTest( "Changing the budget", BudgetChanges );
+}
+
+UnitTest::Result ResidencyListTestGroup::HitsAndMisses()
+{
+    List oList;
+    if( oList.Use( 1, 100 ) || oList.Use( 2, 200 ) || !oList.Use( 1, 100 ) ||
+        !oList.Use( 2, 250 ) )
+    {
+        return UnitTest::Fail( "Use didn't say whether it was a hit" );
+    }
+    if( 2 != oList.Statistics().ulHits || 2 != oList.Statistics().ulMisses )
+    {
+        return UnitTest::Fail( "Hits and misses weren't counted" );
+    }
+    if( 2 != oList.Count() || 350 != oList.Bytes() )
+    {
+        return UnitTest::Fail( "Resident total didn't follow size changes" );
+    }
+
+    // with no budget, nothing is ever evicted
+    unsigned int uiItem = 0;
+    if( oList.IsOverBudget() || oList.NextEviction( uiItem ) )
+    {
+        return UnitTest::Fail( "Evicted with no budget" );
+    }
+    if( !oList.Remove( 1 ) || oList.Remove( 1 ) || oList.IsResident( 1 ) ||
+        250 != oList.Bytes() || 0 != oList.Statistics().ulEvictions )
+    {
+        return UnitTest::Fail( "Removing didn't take it off the list" );
+    }
+    oList.ResetStatistics();
+    if( 0 != oList.Statistics().ulHits || 0 != oList.Statistics().ulMisses )
+    {
+        return UnitTest::Fail( "Statistics weren't reset" );
+    }
+    return UnitTest::PASS;
+}
+
+// A typical frame loop - a few textures used every frame, and a level's worth
+// of others that come and go
+UnitTest::Result ResidencyListTestGroup::LeastRecentlyUsed()
+{
+    List oList( 1000 );
+    oList.Use( 1, 300 );
+    oList.Use( 2, 300 );
+    oList.Use( 3, 300 );
+    oList.Use( 1, 300 );    // 2 is now the least recently used
+    oList.Use( 4, 300 );
+    std::vector< unsigned int > oEvicted = EvictAll( oList );
+    if( 1 != oEvicted.size() || 2 != oEvicted[0] )
+    {
+        return UnitTest::Fail( "Didn't evict the least recently used" );
+    }
+    if( 900 != oList.Bytes() || oList.IsResident( 2 ) ||
+        1 != oList.Statistics().ulEvictions ||
+        300 != oList.Statistics().ulEvictedBytes )
+    {
+        return UnitTest::Fail( "Eviction wasn't accounted for" );
+    }
+
+    // a resource bigger than the whole budget pushes everything else out, but
+    // stays resident itself
+    oList.Use( 5, 5000 );
+    oEvicted = EvictAll( oList );
+    if( 3 != oEvicted.size() || 3 != oEvicted[0] || 1 != oEvicted[1] ||
+        4 != oEvicted[2] || !oList.IsResident( 5 ) || 1 != oList.Count() )
+    {
+        return UnitTest::Fail( "Most recently used resource was evicted" );
+    }
+
+    // cycling through more than fits misses every time
+    oList.Clear();
+    oList.ResetStatistics();
+    for( unsigned int uiRound = 0; uiRound < 10; ++uiRound )
+    {
+        for( unsigned int ui = 0; ui < 4; ++ui )
+        {
+            oList.Use( ui, 300 );
+            EvictAll( oList );
+        }
+    }
+    if( 0 != oList.Statistics().ulHits || 40 != oList.Statistics().ulMisses )
+    {
+        return UnitTest::Fail( "Cycling through too many resources hit" );
+    }
+    return UnitTest::PASS;
+}
+
+UnitTest::Result ResidencyListTestGroup::Pinning()
+{
+    List oList( 500 );
+    if( oList.Pin( 1 ) )
+    {
+        return UnitTest::Fail( "Pinned a resource that wasn't resident" );
+    }
+    oList.Use( 1, 300 );
+    oList.Use( 2, 100 );
+    oList.Use( 3, 100 );
+    if( !oList.Pin( 1 ) || !oList.IsPinned( 1 ) || oList.IsPinned( 2 ) )
+    {
+        return UnitTest::Fail( "Pinning wasn't recorded" );
+    }
+    oList.Use( 4, 200 );
+    std::vector< unsigned int > oEvicted = EvictAll( oList );
+    if( 2 != oEvicted.size() || 2 != oEvicted[0] || 3 != oEvicted[1] ||
+        !oList.IsResident( 1 ) )
+    {
+        return UnitTest::Fail( "Evicted a pinned resource" );
+    }
+
+    // using a pinned resource keeps it pinned, and unpinning makes it the
+    // most recently used
+    oList.Use( 1, 300 );
+    oList.Use( 5, 200 );
+    if( !oList.IsPinned( 1 ) || !oList.Pin( 1, false ) )
+    {
+        return UnitTest::Fail( "Using a pinned resource unpinned it" );
+    }
+    oEvicted = EvictAll( oList );
+    if( 1 != oEvicted.size() || 4 != oEvicted[0] )
+    {
+        return UnitTest::Fail( "Evicted the wrong resource after unpinning" );
+    }
+    oList.Use( 6, 200 );
+    oEvicted = EvictAll( oList );
+    if( 1 != oEvicted.size() || 5 != oEvicted[0] || !oList.IsResident( 1 ) )
+    {
+        return UnitTest::Fail( "Unpinned resource wasn't the most recent" );
+    }
+    return UnitTest::PASS;
+}
+
+UnitTest::Result ResidencyListTestGroup::BudgetChanges()
+{
+    List oList;
+    for( unsigned int ui = 0; ui < 10; ++ui )
+    {
+        oList.Use( ui, 100 );
+    }
+    oList.SetBudget( 450 );
+    if( !oList.IsOverBudget() || 450 != oList.Budget() )
+    {
+        return UnitTest::Fail( "New budget wasn't applied" );
+    }
+    std::vector< unsigned int > oEvicted = EvictAll( oList );
+    if( 6 != oEvicted.size() || 400 != oList.Bytes() )
+    {
+        return UnitTest::Fail( "Didn't evict down to the new budget" );
+    }
+    for( unsigned int ui = 0; ui < oEvicted.size(); ++ui )
+    {
+        if( ui != oEvicted[ ui ] )
+        {
+            return UnitTest::Fail( "Evicted out of order" );
+        }
+    }
+    oList.SetBudget( 0 );
+    oList.Use( 10, 1000 );
+    if( oList.IsOverBudget() || !EvictAll( oList ).empty() )
+    {
+        return UnitTest::Fail( "Evicted after the budget was removed" );
+    }
+    return UnitTest::PASS;
+}
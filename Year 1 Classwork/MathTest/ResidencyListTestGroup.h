@@ -0,0 +1,30 @@
+/******************************************************************************
+ * File:               ResidencyListTestGroup.h
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Least-recently-used residency list tests.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Creation.
+ ******************************************************************************/
+
+#ifndef RESIDENCY_LIST_TEST_GROUP__H
+#define RESIDENCY_LIST_TEST_GROUP__H
+
+#include "UnitTestGroup.h"
+
+class ResidencyListTestGroup : public UnitTestGroup
+{
+public:
+
+    ResidencyListTestGroup();
+
+private:
+
+    static UnitTest::Result HitsAndMisses();
+    static UnitTest::Result LeastRecentlyUsed();
+    static UnitTest::Result Pinning();
+    static UnitTest::Result BudgetChanges();
+
+};
+
+#endif  // RESIDENCY_LIST_TEST_GROUP__H
@@ -3,8 +3,8 @@
  * Author:             Elizabeth Lowry
  * Date Created:       January 5, 2014
  * Description:        Vector2 tests.
- * Last Modified:      February 5, 2014
- * Last Modification:  Refactoring.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Added bounds checking test.
  ******************************************************************************/
 
 #include "Vector2TestGroup.h"
@@ -26,6 +26,7 @@ Vector2TestGroup::Vector2TestGroup()
     AddTest( "Division operator overrides", Division );
     AddTest( "Division by zero", DivisionByZero );
     AddTest( "Interpolation", Interpolation );
+    AddTest( "Bounds checking", BoundsChecking );
 }
 
 UnitTest::Result Vector2TestGroup::DotProduct()
@@ -213,7 +214,7 @@ UnitTest::Result Vector2TestGroup::Operators()
     }
     try
     {
-        oVector[2] = 3;
+        oVector.At( 2 ) = 3;
         return UnitTest::Fail( "Out of range element access didn't throw error" );
     }
     catch( ... ) {}
@@ -459,3 +460,74 @@ UnitTest::Result Vector2TestGroup::Interpolation()
 
     return UnitTest::PASS;
 }
+
+UnitTest::Result Vector2TestGroup::BoundsChecking()
+{
+    // At() should always check, and say what was out of range
+    Point2D oVector( 1, 2 );
+    try
+    {
+        oVector.At( 2 );
+        return UnitTest::Fail( "Out of range vector At() didn't throw error" );
+    }
+    catch( const std::out_of_range& croError )
+    {
+        if( std::string( croError.what() ).find( "2 of 2" ) ==
+            std::string::npos )
+        {
+            return UnitTest::Fail( "Out of range error didn't give the index"
+                                   " and extent" );
+        }
+    }
+    Math::Matrix< double, 3, 2 > oMatrix( 0.0 );
+    try
+    {
+        oMatrix.At( 1, 2 );
+        return UnitTest::Fail( "Out of range matrix At() didn't throw error" );
+    }
+    catch( const std::out_of_range& ) {}
+    Utility::DynamicArray< int > oArray( 3, 0 );
+    try
+    {
+        oArray.At( 3 );
+        return UnitTest::Fail( "Out of range array At() didn't throw error" );
+    }
+    catch( const std::out_of_range& ) {}
+
+    // In range access should work the same either way
+    oMatrix[2][1] = 5.0;
+    oArray[2] = 5;
+    if( 5.0 != oMatrix.At( 2, 1 ) || 5 != oArray.At( 2 ) ||
+        2.0 != oVector[1] || 2.0 != oVector.At( 1 ) )
+    {
+        return UnitTest::Fail( "In range element access failed" );
+    }
+
+    // Operators only throw when configured to.  With the other settings, an
+    // out of range index asserts or is undefined, so there's nothing to test.
+#if MATH_LIBRARY_BOUNDS_CHECK == MATH_LIBRARY_BOUNDS_CHECK_THROW
+    try
+    {
+        oVector[2] = 3;
+        return UnitTest::Fail( "Out of range vector operator[] didn't throw"
+                               " error" );
+    }
+    catch( const std::out_of_range& ) {}
+    try
+    {
+        oMatrix[3][0] = 3;
+        return UnitTest::Fail( "Out of range matrix operator[] didn't throw"
+                               " error" );
+    }
+    catch( const std::out_of_range& ) {}
+    try
+    {
+        oArray[3] = 3;
+        return UnitTest::Fail( "Out of range array operator[] didn't throw"
+                               " error" );
+    }
+    catch( const std::out_of_range& ) {}
+#endif
+
+    return UnitTest::PASS;
+}
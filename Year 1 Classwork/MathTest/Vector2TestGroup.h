@@ -3,8 +3,8 @@
  * Author:             Elizabeth Lowry
  * Date Created:       January 5, 2014
  * Description:        Vector2 tests.
- * Last Modified:      January 5, 2014
- * Last Modification:  Debugging.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Added bounds checking test.
  ******************************************************************************/
 
 #ifndef VECTOR2_TEST_GROUP__H
@@ -30,6 +30,7 @@ private:
     static UnitTest::Result Division();
     static UnitTest::Result DivisionByZero();
     static UnitTest::Result Interpolation();
+    static UnitTest::Result BoundsChecking();
 
 };
 
@@ -3,8 +3,8 @@
  * Author:             Elizabeth Lowry
  * Date Created:       January 5, 2014
  * Description:        Vector3 tests.
- * Last Modified:      February 5, 2014
- * Last Modification:  Refactoring.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Out of range access only throws when configured to.
  ******************************************************************************/
 
 #include "Vector3TestGroup.h"
@@ -225,10 +225,19 @@ UnitTest::Result Vector3TestGroup::Operators()
     }
     try
     {
-        oVector[3] = 4;
+        oVector.At( 3 ) = 4;
         return UnitTest::Fail( "Out of range element access didn't throw error" );
     }
-    catch( ... ) {}
+    catch( const std::out_of_range& ) {}
+#if MATH_LIBRARY_BOUNDS_CHECK == MATH_LIBRARY_BOUNDS_CHECK_THROW
+    try
+    {
+        oVector[3] = 4;
+        return UnitTest::Fail( "Out of range element access operator didn't"
+                               " throw error" );
+    }
+    catch( const std::out_of_range& ) {}
+#endif
 
     // (In)Equality
     if( !( oVector == Point3D( 1, 2, 3 ) ) )
@@ -3,12 +3,27 @@
  * Author:             Elizabeth Lowry
  * Date Created:       January 5, 2014
  * Description:        Vector4 tests.
- * Last Modified:      February 25, 2014
- * Last Modification:  Changed ColorVector from 8-bit Channel to float.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Added packed color test.
  ******************************************************************************/
 
 #include "Vector4TestGroup.h"
 #include "MathLibrary.h"
+#include <sstream>
+#include <type_traits>
+
+// Matrices and vectors should be nothing but their elements
+static_assert( sizeof( Math::Vector< float, 4 > ) == 4 * sizeof( float ),
+               "Vector< float, 4 > has more than its elements" );
+static_assert( sizeof( Math::Matrix< double, 4 > ) == 16 * sizeof( double ),
+               "Matrix< double, 4 > has more than its elements" );
+static_assert( std::alignment_of< Math::Vector< float, 4 > >::value ==
+                std::alignment_of< float >::value,
+               "Vector< float, 4 > is aligned differently than float" );
+static_assert( std::is_standard_layout< Math::Vector< float, 2 > >::value,
+               "Vector< float, 2 > is not standard-layout" );
+static_assert( std::is_standard_layout< Math::Matrix< double, 4 > >::value,
+               "Matrix< double, 4 > is not standard-layout" );
 
 Vector4TestGroup::Vector4TestGroup()
     : UnitTestGroup("Vector4 tests")
@@ -16,7 +31,9 @@ Vector4TestGroup::Vector4TestGroup()
     AddTest( "Create from color Hex constant", ColorConstInit );
     AddTest( "Create from color Hex integer", ColorHexInit );
     AddTest( "Bitwise operation on color vector", ColorBitwiseOp );
+    AddTest( "Packed color conversions", PackedColors );
     AddTest( "Normalization and magnitude", Normalization );
+    AddTest( "Flat arrays of vectors", FlatArray );
 }
 
 UnitTest::Result Vector4TestGroup::ColorConstInit()
@@ -86,6 +103,123 @@ UnitTest::Result Vector4TestGroup::ColorBitwiseOp()
     return UnitTest::PASS;
 }
 
+UnitTest::Result Vector4TestGroup::PackedColors()
+{
+    using Color::PackedColor;
+
+    // Channels are in rgba order in memory whatever the hex value's order
+    const PackedColor coConstant = PACKED_COLOR( 0x7FFF0010 );
+    const Color::Channel* pcucBytes =
+        reinterpret_cast< const Color::Channel* >( &coConstant );
+    if( 0xFF != pcucBytes[0] || 0x00 != pcucBytes[1] ||
+        0x10 != pcucBytes[2] || 0x7F != pcucBytes[3] )
+    {
+        return UnitTest::Fail( "Packed color constant in wrong byte order" );
+    }
+    if( 0x7FFF0010 != coConstant.ToHex() ||
+        PackedColor::FromHex( 0x7FFF0010 ) != coConstant )
+    {
+        return UnitTest::Fail( "Packed color hex conversion failed" );
+    }
+
+    // Packing should match Hex, and unpacking should match ColorVector, for
+    // every channel value and for values out of range
+    const unsigned int cuiCount = 0x103;
+    float afColors[ cuiCount * 4 ];
+    for( unsigned int i = 0; i < cuiCount * 4; ++i )
+    {
+        afColors[i] = ( (float)( ( i * 0x35 ) % cuiCount ) - 1.0f ) / 0xFF;
+    }
+    PackedColor aoPacked[ cuiCount ];
+    Color::Pack( afColors, aoPacked, cuiCount );
+    float afUnpacked[ cuiCount * 4 ];
+    Color::Unpack( aoPacked, afUnpacked, cuiCount );
+    PackedColor aoRepacked[ cuiCount ];
+    Color::Pack( afUnpacked, aoRepacked, cuiCount );
+    for( unsigned int i = 0; i < cuiCount; ++i )
+    {
+        const float* pcfColor = afColors + i * 4;
+        Color::Hex oHex( pcfColor[0], pcfColor[1], pcfColor[2], pcfColor[3] );
+        if( PackedColor::FromHex( oHex.i ) != aoPacked[i] )
+        {
+            std::ostringstream oOut;
+            oOut << "Packed color " << i << " other than hex "
+                 << std::hex << oHex.i;
+            return UnitTest::Fail( oOut.str() );
+        }
+        Color::ColorVector oColor( oHex );
+        if( oColor != Color::ColorVector( afUnpacked[ i * 4 ],
+                                          afUnpacked[ i * 4 + 1 ],
+                                          afUnpacked[ i * 4 + 2 ],
+                                          afUnpacked[ i * 4 + 3 ] ) ||
+            oColor != Color::Unpack( aoPacked[i] ) ||
+            Color::Pack( oColor ) != aoPacked[i] ||
+            aoRepacked[i] != aoPacked[i] )
+        {
+            std::ostringstream oOut;
+            oOut << "Unpacked color " << i << " other than " << oColor;
+            return UnitTest::Fail( oOut.str() );
+        }
+    }
+
+    // Every sRGB channel value should survive a round trip through linear
+    PackedColor aoSRGB[ 0x100 ];
+    for( unsigned int i = 0; i < 0x100; ++i )
+    {
+        PackedColor oColor = { (Color::Channel)i, (Color::Channel)~i,
+                               (Color::Channel)i, (Color::Channel)i };
+        aoSRGB[i] = oColor;
+    }
+    float afLinear[ 0x100 * 4 ];
+    Color::UnpackSRGB( aoSRGB, afLinear, 0x100 );
+    PackedColor aoRoundTrip[ 0x100 ];
+    Color::PackSRGB( afLinear, aoRoundTrip, 0x100 );
+    for( unsigned int i = 0; i < 0x100; ++i )
+    {
+        if( aoRoundTrip[i] != aoSRGB[i] )
+        {
+            std::ostringstream oOut;
+            oOut << "sRGB channel value " << i << " changed by round trip";
+            return UnitTest::Fail( oOut.str() );
+        }
+    }
+    if( 0.0f != Color::SRGBToLinear( 0.0f ) ||
+        1.0f != Color::SRGBToLinear( 1.0f ) ||
+        0.213f > Color::SRGBToLinear( 0.5f ) ||
+        0.215f < Color::SRGBToLinear( 0.5f ) )
+    {
+        return UnitTest::Fail( "sRGB to linear conversion failed" );
+    }
+
+    // Premultiplying should round to the nearest value, and opaque colors
+    // should come back unchanged
+    PackedColor aoPremultiplied[ 0x100 ];
+    Color::Premultiply( aoSRGB, aoPremultiplied, 0x100 );
+    for( unsigned int i = 0; i < 0x100; ++i )
+    {
+        Color::Channel ucExpected =
+            (Color::Channel)Math::Round( i * i / 255.0 );
+        if( ucExpected != aoPremultiplied[i].r ||
+            aoPremultiplied[i] != aoSRGB[i].Premultiplied() )
+        {
+            std::ostringstream oOut;
+            oOut << "Premultiplied channel " << i << " other than "
+                 << (int)ucExpected;
+            return UnitTest::Fail( oOut.str() );
+        }
+    }
+    const PackedColor coOpaque = PACKED_COLOR( 0xFF3366CC );
+    const PackedColor coClear = PACKED_COLOR( 0x00FFFFFF );
+    if( coOpaque.Premultiplied().Unpremultiplied() != coOpaque ||
+        coClear.Premultiplied().ToHex() != 0 ||
+        coClear.Unpremultiplied().ToHex() != 0 )
+    {
+        return UnitTest::Fail( "Unpremultiplying failed" );
+    }
+
+    return UnitTest::PASS;
+}
+
 UnitTest::Result Vector4TestGroup::Normalization()
 {
     double adData[4] = { 1.0, 2.0, 3.0, 4.0 };
@@ -109,3 +243,32 @@ UnitTest::Result Vector4TestGroup::Normalization()
     }
     return UnitTest::PASS;
 }
+
+UnitTest::Result Vector4TestGroup::FlatArray()
+{
+    // An array of vectors should read as one array of floats
+    Math::Vector< float, 4 > aoVectors[3];
+    for( unsigned int i = 0; i < 12; ++i )
+    {
+        aoVectors[i/4][i%4] = (float)i;
+    }
+    const float* cpfData = &( aoVectors[0][0] );
+    for( unsigned int i = 0; i < 12; ++i )
+    {
+        if( (float)i != cpfData[i] )
+        {
+            return UnitTest::Fail( "Array of vectors not laid out as an array"
+                                   " of floats" );
+        }
+    }
+
+    // The polymorphic wrapper should still act like what it wraps
+    Utility::Polymorphic< Math::Vector< float, 4 > > oWrapped( aoVectors[1] );
+    const Utility::MostDerivedAddress& croBase = oWrapped;
+    if( !croBase.IsThis( oWrapped ) || aoVectors[1] != oWrapped.Value() )
+    {
+        return UnitTest::Fail( "Polymorphic wrapper failed" );
+    }
+
+    return UnitTest::PASS;
+}
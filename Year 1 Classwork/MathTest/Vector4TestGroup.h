@@ -3,8 +3,8 @@
  * Author:             Elizabeth Lowry
  * Date Created:       January 5, 2014
  * Description:        Vector4 tests.
- * Last Modified:      January 5, 2014
- * Last Modification:  Debugging.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Added packed color test.
  ******************************************************************************/
 
 #ifndef VECTOR4_TEST_GROUP__H
@@ -23,7 +23,9 @@ private:
     static UnitTest::Result ColorConstInit();
     static UnitTest::Result ColorHexInit();
     static UnitTest::Result ColorBitwiseOp();
+    static UnitTest::Result PackedColors();
     static UnitTest::Result Normalization();
+    static UnitTest::Result FlatArray();
 
 };
 
@@ -0,0 +1,653 @@
+/******************************************************************************
+ * File:               XMLPullParserTestGroup.cpp
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Tests comparing the events reported by tinyxml2's pull
+ *                      parser and SAX handler to the DOM built from the same
+ *                      documents.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Creation.
+ ******************************************************************************/
+
+#include "XMLPullParserTestGroup.h"
+#include "../scratchwork/tinyxml2.h"
+#include <cstring>  // for strlen
+#include <ctime>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace tinyxml2;
+
+namespace
+{
+
+// Each event as a line of text, so event lists can be compared directly
+typedef std::vector< std::string > Events;
+
+// Well-formed documents covering each kind of node, entities, whitespace, and
+// line endings
+const char* const sgc_apcDocuments[] =
+{
+    "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+    "<scores>\n"
+    "  <score name=\"Alice\" value=\"100\"/>\n"
+    "  <score name=\"Bob\" value=\"90\">Second place</score>\n"
+    "</scores>\n",
+
+    "<a title=\"&lt;b&gt; &amp; &quot;c&quot; &apos;d&apos;\">"
+    "x &lt; y &#65;&#x42; &amp;amp; &unknown;</a>",
+
+    "<!-- before --><a><![CDATA[<not> &amp; markup]]><!-- inside --></a>"
+    "<!-- after -->",
+
+    "<!DOCTYPE a [ <!ELEMENT a (#PCDATA)> ]>\n<a/>",
+
+    "<p>  Some   <b>bold</b>\n\t text  <i/>  tail  </p>",
+
+    "<a x=\"one\r\ntwo\">one\r\ntwo\rthree\n</a>",
+
+    "\xEF\xBB\xBF<a>Marked</a>",
+
+    "<a><b><c><d><e/></d></c></b><f g='1' h = \"2\"  i='&apos;'/></a>",
+
+    "<?xml version=\"1.0\"?><?stylesheet href=\"s.css\"?>"
+    "<list><item/><item></item><item>   </item></list>"
+};
+const unsigned int sgc_uiDocumentCount =
+    sizeof( sgc_apcDocuments ) / sizeof( const char* );
+
+// Documents the DOM won't accept
+const char* const sgc_apcMalformed[] =
+{
+    "",
+    "   ",
+    "<a><b></a>",
+    "<a></b>",
+    "<a>",
+    "<a>Unclosed",
+    "<1a/>",
+    "< />",
+    "<a x=\"1>",
+    "<a x=1/>",
+    "<a x=\"1\"",
+    "<a x=\"1\" x=\"2\"/>",
+    "<a><!-- unclosed",
+    "<a><![CDATA[ unclosed",
+    "<?xml version=\"1.0\"",
+    "<!DOCTYPE a",
+    "<a></a><",
+    "<a></a></"
+};
+const unsigned int sgc_uiMalformedCount =
+    sizeof( sgc_apcMalformed ) / sizeof( const char* );
+
+// Documents with an end tag outside of any element, where the DOM stops
+// reading without an error but the pull parser reports one
+const char* const sgc_apcStrayEndTags[] =
+{
+    "</a>",
+    "<a/></b>",
+    "<!-- first --><a>Text</a></a><b/>"
+};
+const unsigned int sgc_uiStrayEndTagCount =
+    sizeof( sgc_apcStrayEndTags ) / sizeof( const char* );
+
+// Parser settings each document is read with
+struct Mode
+{
+    bool bProcessEntities;
+    Whitespace eWhitespace;
+    const char* pcName;
+};
+const Mode sgc_aoModes[] =
+{
+    { true, PRESERVE_WHITESPACE, "entities, preserved whitespace" },
+    { false, PRESERVE_WHITESPACE, "raw entities, preserved whitespace" },
+    { true, COLLAPSE_WHITESPACE, "entities, collapsed whitespace" },
+    { false, COLLAPSE_WHITESPACE, "raw entities, collapsed whitespace" }
+};
+const unsigned int sgc_uiModeCount = sizeof( sgc_aoModes ) / sizeof( Mode );
+
+// Event lines, the same for the DOM and the pull parser
+std::string StartLine( const char* ac_pcName )
+{
+    return std::string( "<" ) + ac_pcName;
+}
+std::string AttributeLine( const char* ac_pcName, const char* ac_pcValue )
+{
+    return std::string( " " ) + ac_pcName + "=\"" + ac_pcValue + "\"";
+}
+std::string EndLine( const char* ac_pcName )
+{
+    return std::string( "</" ) + ac_pcName + ">";
+}
+std::string TextLine( const char* ac_pcValue, bool a_bCData )
+{
+    return std::string( a_bCData ? "CDATA " : "Text " ) + ac_pcValue;
+}
+std::string CommentLine( const char* ac_pcValue )
+{
+    return std::string( "<!--" ) + ac_pcValue + "-->";
+}
+std::string DeclarationLine( const char* ac_pcValue )
+{
+    return std::string( "<?" ) + ac_pcValue + "?>";
+}
+std::string UnknownLine( const char* ac_pcValue )
+{
+    return std::string( "<!" ) + ac_pcValue + ">";
+}
+
+// Records the nodes of a DOM in the order a visitor reaches them
+class DOMRecorder : public XMLVisitor
+{
+public:
+
+    virtual ~DOMRecorder() {}
+
+    virtual bool VisitEnter( const XMLElement& ac_roElement,
+                             const XMLAttribute* ac_poAttribute ) override
+    {
+        std::string oLine = StartLine( ac_roElement.Name() );
+        for( ; nullptr != ac_poAttribute;
+             ac_poAttribute = ac_poAttribute->Next() )
+        {
+            oLine += AttributeLine( ac_poAttribute->Name(),
+                                    ac_poAttribute->Value() );
+        }
+        m_oEvents.push_back( oLine + ">" );
+        return true;
+    }
+    virtual bool VisitExit( const XMLElement& ac_roElement ) override
+    {
+        m_oEvents.push_back( EndLine( ac_roElement.Name() ) );
+        return true;
+    }
+    virtual bool Visit( const XMLText& ac_roText ) override
+    {
+        m_oEvents.push_back( TextLine( ac_roText.Value(), ac_roText.CData() ) );
+        return true;
+    }
+    virtual bool Visit( const XMLComment& ac_roComment ) override
+    {
+        m_oEvents.push_back( CommentLine( ac_roComment.Value() ) );
+        return true;
+    }
+    virtual bool Visit( const XMLDeclaration& ac_roDeclaration ) override
+    {
+        m_oEvents.push_back( DeclarationLine( ac_roDeclaration.Value() ) );
+        return true;
+    }
+    virtual bool Visit( const XMLUnknown& ac_roUnknown ) override
+    {
+        m_oEvents.push_back( UnknownLine( ac_roUnknown.Value() ) );
+        return true;
+    }
+
+    const Events& GetEvents() const { return m_oEvents; }
+
+private:
+
+    Events m_oEvents;
+
+};
+
+// Event lines for the pull parser's current event
+std::string StartLine( XMLPullParser& a_roParser )
+{
+    std::string oLine = StartLine( a_roParser.Name().CStr() );
+    for( int i = 0; i < a_roParser.AttributeCount(); ++i )
+    {
+        oLine += AttributeLine( a_roParser.AttributeName( i ).CStr(),
+                                a_roParser.AttributeValue( i ).CStr() );
+    }
+    return oLine + ">";
+}
+std::string Line( XMLPullParser& a_roParser )
+{
+    switch( a_roParser.Event() )
+    {
+    case XMLPullParser::START_ELEMENT:
+        return StartLine( a_roParser );
+    case XMLPullParser::END_ELEMENT:
+        return EndLine( a_roParser.Name().CStr() );
+    case XMLPullParser::TEXT:
+        return TextLine( a_roParser.Value().CStr(), a_roParser.CData() );
+    case XMLPullParser::COMMENT:
+        return CommentLine( a_roParser.Value().CStr() );
+    case XMLPullParser::DECLARATION:
+        return DeclarationLine( a_roParser.Value().CStr() );
+    case XMLPullParser::UNKNOWN:
+        return UnknownLine( a_roParser.Value().CStr() );
+    default:
+        return "";
+    }
+}
+
+// Records the events handed to a SAX handler, using the callback that was
+// called rather than the parser's event type to tell them apart.  Stops after
+// the given number of events, if there is one.
+class SaxRecorder : public XMLSaxHandler
+{
+public:
+
+    SaxRecorder( unsigned int a_uiLimit = 0 ) : m_uiLimit( a_uiLimit ) {}
+    virtual ~SaxRecorder() {}
+
+    virtual bool StartElement( XMLPullParser& a_roParser ) override
+    {
+        return Add( StartLine( a_roParser ) );
+    }
+    virtual bool EndElement( XMLPullParser& a_roParser ) override
+    {
+        return Add( EndLine( a_roParser.Name().CStr() ) );
+    }
+    virtual bool Text( XMLPullParser& a_roParser ) override
+    {
+        return Add( TextLine( a_roParser.Value().CStr(), a_roParser.CData() ) );
+    }
+    virtual bool Comment( XMLPullParser& a_roParser ) override
+    {
+        return Add( CommentLine( a_roParser.Value().CStr() ) );
+    }
+    virtual bool Declaration( XMLPullParser& a_roParser ) override
+    {
+        return Add( DeclarationLine( a_roParser.Value().CStr() ) );
+    }
+    virtual bool Unknown( XMLPullParser& a_roParser ) override
+    {
+        return Add( UnknownLine( a_roParser.Value().CStr() ) );
+    }
+
+    const Events& GetEvents() const { return m_oEvents; }
+
+private:
+
+    bool Add( const std::string& ac_roLine )
+    {
+        m_oEvents.push_back( ac_roLine );
+        return ( 0 == m_uiLimit || m_oEvents.size() < m_uiLimit );
+    }
+
+    unsigned int m_uiLimit;
+    Events m_oEvents;
+
+};
+
+// The DOM's events for a document
+Events DOMEvents( const char* ac_pcDocument, const Mode& ac_roMode,
+                  XMLError& a_reError )
+{
+    XMLDocument oDocument( ac_roMode.bProcessEntities, ac_roMode.eWhitespace );
+    a_reError = oDocument.Parse( ac_pcDocument );
+    DOMRecorder oRecorder;
+    if( XML_NO_ERROR == a_reError )
+    {
+        oDocument.Accept( &oRecorder );
+    }
+    return oRecorder.GetEvents();
+}
+
+// The pull parser's events for a document
+Events PulledEvents( const char* ac_pcDocument, const Mode& ac_roMode,
+                     XMLError& a_reError )
+{
+    XMLPullParser oParser( ac_roMode.bProcessEntities, ac_roMode.eWhitespace );
+    Events oEvents;
+    oParser.Parse( ac_pcDocument );
+    while( XMLPullParser::END_DOCUMENT != oParser.Next() )
+    {
+        oEvents.push_back( Line( oParser ) );
+    }
+    a_reError = oParser.ErrorID();
+    return oEvents;
+}
+
+// Describe the first difference between two event lists, or return an empty
+// string if they're the same
+std::string Difference( const Events& ac_roExpected, const Events& ac_roActual,
+                        unsigned int a_uiDocument, const Mode& ac_roMode )
+{
+    std::ostringstream oMessage;
+    oMessage << "Document " << a_uiDocument << " (" << ac_roMode.pcName
+             << "): ";
+    for( unsigned int ui = 0;
+         ui < ac_roExpected.size() && ui < ac_roActual.size(); ++ui )
+    {
+        if( ac_roExpected[ ui ] != ac_roActual[ ui ] )
+        {
+            oMessage << "event " << ui << " was \"" << ac_roActual[ ui ]
+                     << "\" instead of \"" << ac_roExpected[ ui ] << "\"";
+            return oMessage.str();
+        }
+    }
+    if( ac_roExpected.size() != ac_roActual.size() )
+    {
+        oMessage << ac_roActual.size() << " events instead of "
+                 << ac_roExpected.size();
+        return oMessage.str();
+    }
+    return "";
+}
+
+// A sprite sheet with the given number of sprites, each with attributes and
+// text to decode
+std::string SpriteSheet( unsigned int a_uiSprites )
+{
+    std::ostringstream oSheet;
+    oSheet << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<sheet>\n";
+    for( unsigned int ui = 0; ui < a_uiSprites; ++ui )
+    {
+        oSheet << "  <sprite name=\"sprite" << ui << "\" x=\"" << ui % 64 * 32
+               << "\" y=\"" << ui / 64 * 32 << "\" w=\"32\" h=\"32\">"
+               << "Frame &amp; hitbox " << ui << "</sprite>\n";
+        if( 0 == ui % 100 )
+        {
+            oSheet << "  <!-- row " << ui / 100 << " -->\n";
+        }
+    }
+    oSheet << "</sheet>\n";
+    return oSheet.str();
+}
+
+// Counts elements and the characters of every attribute value and text,
+// which makes the DOM and the pull parser decode all of them
+class DOMCounter : public XMLVisitor
+{
+public:
+
+    DOMCounter() : m_uiElements( 0 ), m_uiCharacters( 0 ) {}
+    virtual ~DOMCounter() {}
+
+    virtual bool VisitEnter( const XMLElement& ac_roElement,
+                             const XMLAttribute* ac_poAttribute ) override
+    {
+        ++m_uiElements;
+        for( ; nullptr != ac_poAttribute;
+             ac_poAttribute = ac_poAttribute->Next() )
+        {
+            m_uiCharacters += std::strlen( ac_poAttribute->Value() );
+        }
+        return true;
+    }
+    virtual bool Visit( const XMLText& ac_roText ) override
+    {
+        m_uiCharacters += std::strlen( ac_roText.Value() );
+        return true;
+    }
+
+    unsigned int m_uiElements;
+    unsigned int m_uiCharacters;
+
+};
+class SaxCounter : public XMLSaxHandler
+{
+public:
+
+    SaxCounter() : m_uiElements( 0 ), m_uiCharacters( 0 ) {}
+    virtual ~SaxCounter() {}
+
+    virtual bool StartElement( XMLPullParser& a_roParser ) override
+    {
+        ++m_uiElements;
+        for( int i = 0; i < a_roParser.AttributeCount(); ++i )
+        {
+            m_uiCharacters +=
+                std::strlen( a_roParser.AttributeValue( i ).CStr() );
+        }
+        return true;
+    }
+    virtual bool Text( XMLPullParser& a_roParser ) override
+    {
+        m_uiCharacters += std::strlen( a_roParser.Value().CStr() );
+        return true;
+    }
+
+    unsigned int m_uiElements;
+    unsigned int m_uiCharacters;
+
+};
+
+// Seconds since some point, for timing
+double Seconds()
+{
+    return (double)std::clock() / CLOCKS_PER_SEC;
+}
+
+}   // namespace
+
+XMLPullParserTestGroup::XMLPullParserTestGroup()
+    : UnitTestGroup("XML pull parser tests")
+{
+    AddTest( "Pull events match the DOM", PullEvents );
+    AddTest( "SAX events match the DOM", SaxEvents );
+    AddTest( "Malformed documents give the DOM's errors", Errors );
+    AddTest( "Stray end tags are errors", StrayEndTags );
+    AddTest( "Reading a 20,000 sprite sheet", Benchmark );
+}
+
+// Every document, in every mode, should give the same events in the same
+// order as a visitor walking the DOM built from it.
+UnitTest::Result XMLPullParserTestGroup::PullEvents()
+{
+    for( unsigned int uiMode = 0; uiMode < sgc_uiModeCount; ++uiMode )
+    {
+        const Mode& roMode = sgc_aoModes[ uiMode ];
+        for( unsigned int ui = 0; ui < sgc_uiDocumentCount; ++ui )
+        {
+            XMLError eDOMError = XML_NO_ERROR;
+            XMLError ePullError = XML_NO_ERROR;
+            Events oExpected =
+                DOMEvents( sgc_apcDocuments[ ui ], roMode, eDOMError );
+            Events oActual =
+                PulledEvents( sgc_apcDocuments[ ui ], roMode, ePullError );
+            if( XML_NO_ERROR != eDOMError || XML_NO_ERROR != ePullError )
+            {
+                std::ostringstream oMessage;
+                oMessage << "Document " << ui << " gave errors " << eDOMError
+                         << " and " << ePullError;
+                return UnitTest::Fail( oMessage.str() );
+            }
+            std::string oMessage =
+                Difference( oExpected, oActual, ui, roMode );
+            if( !oMessage.empty() )
+            {
+                return UnitTest::Fail( oMessage );
+            }
+        }
+    }
+    return UnitTest::PASS;
+}
+
+// A SAX handler should get the same events, through the callback for each
+// event's type, and a handler that returns false should get no more.
+UnitTest::Result XMLPullParserTestGroup::SaxEvents()
+{
+    for( unsigned int uiMode = 0; uiMode < sgc_uiModeCount; ++uiMode )
+    {
+        const Mode& roMode = sgc_aoModes[ uiMode ];
+        for( unsigned int ui = 0; ui < sgc_uiDocumentCount; ++ui )
+        {
+            XMLError eDOMError = XML_NO_ERROR;
+            Events oExpected =
+                DOMEvents( sgc_apcDocuments[ ui ], roMode, eDOMError );
+
+            XMLPullParser oParser( roMode.bProcessEntities,
+                                   roMode.eWhitespace );
+            oParser.Parse( sgc_apcDocuments[ ui ] );
+            SaxRecorder oRecorder;
+            XMLError eSaxError = oParser.Accept( &oRecorder );
+            std::string oMessage =
+                Difference( oExpected, oRecorder.GetEvents(), ui, roMode );
+            if( XML_NO_ERROR != eSaxError )
+            {
+                return UnitTest::Fail( "Handler was given an error" );
+            }
+            if( !oMessage.empty() )
+            {
+                return UnitTest::Fail( oMessage );
+            }
+
+            // Stop partway through
+            unsigned int uiLimit = ( oExpected.size() + 1 ) / 2;
+            XMLPullParser oStopped( roMode.bProcessEntities,
+                                    roMode.eWhitespace );
+            oStopped.Parse( sgc_apcDocuments[ ui ] );
+            SaxRecorder oStoppedRecorder( uiLimit );
+            oStopped.Accept( &oStoppedRecorder );
+            oExpected.resize( uiLimit );
+            oMessage = Difference( oExpected, oStoppedRecorder.GetEvents(),
+                                   ui, roMode );
+            if( !oMessage.empty() )
+            {
+                return UnitTest::Fail( "Stopped early: " + oMessage );
+            }
+        }
+    }
+    return UnitTest::PASS;
+}
+
+// Every malformed document should make the pull parser end with the same
+// error as the DOM, and the SAX handler should be given that error too.
+UnitTest::Result XMLPullParserTestGroup::Errors()
+{
+    for( unsigned int uiMode = 0; uiMode < sgc_uiModeCount; ++uiMode )
+    {
+        const Mode& roMode = sgc_aoModes[ uiMode ];
+        for( unsigned int ui = 0; ui < sgc_uiMalformedCount; ++ui )
+        {
+            XMLError eDOMError = XML_NO_ERROR;
+            XMLError ePullError = XML_NO_ERROR;
+            DOMEvents( sgc_apcMalformed[ ui ], roMode, eDOMError );
+            PulledEvents( sgc_apcMalformed[ ui ], roMode, ePullError );
+
+            XMLPullParser oParser( roMode.bProcessEntities,
+                                   roMode.eWhitespace );
+            oParser.Parse( sgc_apcMalformed[ ui ] );
+            SaxRecorder oRecorder;
+            XMLError eSaxError = oParser.Accept( &oRecorder );
+
+            if( XML_NO_ERROR == eDOMError || eDOMError != ePullError ||
+                eDOMError != eSaxError )
+            {
+                std::ostringstream oMessage;
+                oMessage << "Malformed document " << ui << " ("
+                         << roMode.pcName << ") gave DOM error " << eDOMError
+                         << ", pull error " << ePullError
+                         << ", and SAX error " << eSaxError;
+                return UnitTest::Fail( oMessage.str() );
+            }
+        }
+    }
+    return UnitTest::PASS;
+}
+
+// The DOM stops at an end tag outside of any element, but the pull parser
+// should report the events before it and then a mismatched element error.
+UnitTest::Result XMLPullParserTestGroup::StrayEndTags()
+{
+    for( unsigned int uiMode = 0; uiMode < sgc_uiModeCount; ++uiMode )
+    {
+        const Mode& roMode = sgc_aoModes[ uiMode ];
+        for( unsigned int ui = 0; ui < sgc_uiStrayEndTagCount; ++ui )
+        {
+            XMLError eDOMError = XML_NO_ERROR;
+            XMLError ePullError = XML_NO_ERROR;
+            Events oExpected =
+                DOMEvents( sgc_apcStrayEndTags[ ui ], roMode, eDOMError );
+            Events oActual =
+                PulledEvents( sgc_apcStrayEndTags[ ui ], roMode, ePullError );
+            if( XML_NO_ERROR != eDOMError ||
+                XML_ERROR_MISMATCHED_ELEMENT != ePullError )
+            {
+                std::ostringstream oMessage;
+                oMessage << "Stray end tag " << ui << " gave DOM error "
+                         << eDOMError << " and pull error " << ePullError;
+                return UnitTest::Fail( oMessage.str() );
+            }
+            std::string oMessage =
+                Difference( oExpected, oActual, ui, roMode );
+            if( !oMessage.empty() )
+            {
+                return UnitTest::Fail( "Stray end tag: " + oMessage );
+            }
+        }
+    }
+    return UnitTest::PASS;
+}
+
+// Time reading a 20,000 sprite sheet into a DOM and visiting it, against
+// pulling its events and handing them to a SAX handler, decoding every value
+// either way.  Only the counts are checked; the times are just reported.
+UnitTest::Result XMLPullParserTestGroup::Benchmark()
+{
+    const unsigned int cuiSprites = 20000;
+    const unsigned int cuiRounds = 5;
+    const std::string coSheet = SpriteSheet( cuiSprites );
+
+    double dDOMSeconds = 0.0;
+    double dPullSeconds = 0.0;
+    double dSaxSeconds = 0.0;
+    DOMCounter oDOMCounter;
+    SaxCounter oPullCounter;
+    SaxCounter oSaxCounter;
+    for( unsigned int ui = 0; ui < cuiRounds; ++ui )
+    {
+        double dStart = Seconds();
+        {
+            XMLDocument oDocument;
+            oDocument.Parse( coSheet.c_str(), coSheet.size() );
+            oDOMCounter = DOMCounter();
+            oDocument.Accept( &oDOMCounter );
+        }
+        double dDOMEnd = Seconds();
+        {
+            XMLPullParser oParser;
+            oParser.Parse( coSheet.c_str(), coSheet.size() );
+            oPullCounter = SaxCounter();
+            for( XMLPullParser::EventType eEvent = oParser.Next();
+                 XMLPullParser::END_DOCUMENT != eEvent;
+                 eEvent = oParser.Next() )
+            {
+                if( XMLPullParser::START_ELEMENT == eEvent )
+                {
+                    oPullCounter.StartElement( oParser );
+                }
+                else if( XMLPullParser::TEXT == eEvent )
+                {
+                    oPullCounter.Text( oParser );
+                }
+            }
+        }
+        double dPullEnd = Seconds();
+        {
+            XMLPullParser oParser;
+            oParser.Parse( coSheet.c_str(), coSheet.size() );
+            oSaxCounter = SaxCounter();
+            oParser.Accept( &oSaxCounter );
+        }
+        double dSaxEnd = Seconds();
+        dDOMSeconds += dDOMEnd - dStart;
+        dPullSeconds += dPullEnd - dDOMEnd;
+        dSaxSeconds += dSaxEnd - dPullEnd;
+    }
+
+    if( cuiSprites + 1 != oDOMCounter.m_uiElements ||
+        oDOMCounter.m_uiElements != oPullCounter.m_uiElements ||
+        oDOMCounter.m_uiElements != oSaxCounter.m_uiElements )
+    {
+        return UnitTest::Fail( "Element counts differed" );
+    }
+    if( oDOMCounter.m_uiCharacters != oPullCounter.m_uiCharacters ||
+        oDOMCounter.m_uiCharacters != oSaxCounter.m_uiCharacters )
+    {
+        return UnitTest::Fail( "Decoded values differed" );
+    }
+    std::ostringstream oMessage;
+    oMessage << "DOM " << dDOMSeconds * 1000.0 / cuiRounds << " ms, pull "
+             << dPullSeconds * 1000.0 / cuiRounds << " ms, SAX "
+             << dSaxSeconds * 1000.0 / cuiRounds << " ms per "
+             << coSheet.size() / 1024 << " KB sheet";
+    return UnitTest::Pass( oMessage.str() );
+}
@@ -0,0 +1,33 @@
+/******************************************************************************
+ * File:               XMLPullParserTestGroup.h
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Tests comparing the events reported by tinyxml2's pull
+ *                      parser and SAX handler to the DOM built from the same
+ *                      documents.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Creation.
+ ******************************************************************************/
+
+#ifndef XML_PULL_PARSER_TEST_GROUP__H
+#define XML_PULL_PARSER_TEST_GROUP__H
+
+#include "UnitTestGroup.h"
+
+class XMLPullParserTestGroup : public UnitTestGroup
+{
+public:
+
+    XMLPullParserTestGroup();
+
+private:
+
+    static UnitTest::Result PullEvents();
+    static UnitTest::Result SaxEvents();
+    static UnitTest::Result Errors();
+    static UnitTest::Result StrayEndTags();
+    static UnitTest::Result Benchmark();
+
+};
+
+#endif  // XML_PULL_PARSER_TEST_GROUP__H
@@ -3,17 +3,24 @@
  * Author:             Elizabeth Lowry
  * Date Created:       January 5, 2014
  * Description:        Runs a list of unit test groups.
- * Last Modified:      January 5, 2014
- * Last Modification:  Debugging.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Added XML pull parser tests.
  ******************************************************************************/
 
 #include "UnitTester.h"
+#include "FrustumTestGroup.h"
 #include "MathTestGroup.h"
+#include "EventQueueTestGroup.h"
+#include "MatrixExpressionTestGroup.h"
+#include "QuadtreeTestGroup.h"
 #include "Matrix3x3TestGroup.h"
 #include "Matrix4x4TestGroup.h"
+#include "QuaternionTestGroup.h"
+#include "ResidencyListTestGroup.h"
 #include "Vector2TestGroup.h"
 #include "Vector3TestGroup.h"
 #include "Vector4TestGroup.h"
+#include "XMLPullParserTestGroup.h"
 #include <conio.h>
 #include <iostream>
 #include <string>
@@ -24,9 +31,16 @@ int main(int argc, char* argv[])
     UnitTester oTester;
     oTester.AddTestGroup( Matrix3x3TestGroup() );
     oTester.AddTestGroup( Matrix4x4TestGroup() );
+    oTester.AddTestGroup( MatrixExpressionTestGroup() );
     oTester.AddTestGroup( Vector2TestGroup() );
     oTester.AddTestGroup( Vector3TestGroup() );
     oTester.AddTestGroup( Vector4TestGroup() );
+    oTester.AddTestGroup( QuaternionTestGroup() );
+    oTester.AddTestGroup( FrustumTestGroup() );
+    oTester.AddTestGroup( QuadtreeTestGroup() );
+    oTester.AddTestGroup( EventQueueTestGroup() );
+    oTester.AddTestGroup( ResidencyListTestGroup() );
+    oTester.AddTestGroup( XMLPullParserTestGroup() );
     oTester.AddTestGroup( MathTestGroup() );
 
     // run
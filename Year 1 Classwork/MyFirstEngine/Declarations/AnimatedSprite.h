@@ -3,26 +3,32 @@
  * Author:             Elizabeth Lowry
  * Date Created:       March 13, 2014
  * Description:        Class representing an sprite that loops through frames.
- * Last Modified:      March 18, 2014
- * Last Modification:  Debugging.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Moved playback state into the Animator.
  ******************************************************************************/
 
 #ifndef ANIMATED_SPRITE__H
 #define ANIMATED_SPRITE__H
 
+#include "Animator.h"
 #include "Sprite.h"
 #include "MyFirstEngineMacros.h"
 
 namespace MyFirstEngine
 {
 
-// A textured rectangle that changes frame automatically
+// A textured rectangle that changes frame automatically.  The playback state
+// lives in the Animator, which can advance every animated sprite at once - the
+// sprite itself only holds the index of its animation there.
 class IMEXPORT_CLASS AnimatedSprite : public Sprite
 {
+    friend class Animator;
+
 public:
 
-    // animation completion callback
-    typedef void (*Callback)( AnimatedSprite& a_roSprite );
+    // animation loop/completion callback - the loop callback is called each
+    // time a loop finishes without finishing the animation
+    typedef Animator::Callback Callback;
     
     // Main constructors
     AnimatedSprite( Texture& a_roTexture,
@@ -80,66 +86,86 @@ public:
     AnimatedSprite& operator=( const Sprite& ac_roSprite );
 
     // Destructor
-    virtual ~AnimatedSprite() {}
+    virtual ~AnimatedSprite();
 
     // increment frame if appropriate
     virtual AnimatedSprite& Update( double a_dDeltaTime = 0.0 );
 
-    // adjust frame based on elapsed time (does nothing if m_dFPS is zero)
-    AnimatedSprite& CalculateFrame();
+    // adjust frame based on elapsed time (does nothing if FPS is zero)
+    AnimatedSprite& CalculateFrame()
+    { Animator::CalculateFrame( m_uiAnimation ); return *this; }
 
     // increment frame and, if neccessary, completed loop count
-    AnimatedSprite& IncrementFrame();
+    AnimatedSprite& IncrementFrame()
+    { Animator::IncrementFrame( m_uiAnimation ); return *this; }
 
     // control progress
-    AnimatedSprite& Play();
-    AnimatedSprite& Pause();
-    AnimatedSprite& Rewind();   // does not pause/unpause
-    AnimatedSprite& Complete();
-    AnimatedSprite& Seek( unsigned int a_uiFrame );
-    AnimatedSprite& Seek( double a_dSeconds );
-    AnimatedSprite& Add( int a_iFrames );
-    AnimatedSprite& Add( double a_dSeconds );
+    AnimatedSprite& Play() { Animator::Play( m_uiAnimation ); return *this; }
+    AnimatedSprite& Pause() { Animator::Pause( m_uiAnimation ); return *this; }
+    AnimatedSprite& Rewind()    // does not pause/unpause
+    { Animator::Rewind( m_uiAnimation ); return *this; }
+    AnimatedSprite& Complete()
+    { Animator::Complete( m_uiAnimation ); return *this; }
+    AnimatedSprite& Seek( unsigned int a_uiFrame )
+    { Animator::Seek( m_uiAnimation, a_uiFrame ); return *this; }
+    AnimatedSprite& Seek( double a_dSeconds )
+    { Animator::Seek( m_uiAnimation, a_dSeconds ); return *this; }
+    AnimatedSprite& Add( int a_iFrames )
+    { Animator::Add( m_uiAnimation, a_iFrames ); return *this; }
+    AnimatedSprite& Add( double a_dSeconds )
+    { Animator::Add( m_uiAnimation, a_dSeconds ); return *this; }
 
     // Get properties
-    bool IsCompleted() const;
-    bool IsPaused() const { return m_bPaused; }
-    unsigned int Loops() const { return m_uiLoops; }
-    double FPS() const { return m_dFPS; }
-    unsigned int CompletedLoops() const { return m_uiCompletedLoops; }
-    Callback CompletionCallback() const { return m_pOnComplete; }
-    unsigned int LengthInFrames() const { return m_uiLoops * FrameCount(); }
+    bool IsCompleted() const { return Animator::IsCompleted( m_uiAnimation ); }
+    bool IsPaused() const { return Animator::IsPaused( m_uiAnimation ); }
+    unsigned int Loops() const { return Animator::Loops( m_uiAnimation ); }
+    double FPS() const { return Animator::FPS( m_uiAnimation ); }
+    unsigned int CompletedLoops() const
+    { return Animator::CompletedLoops( m_uiAnimation ); }
+    Callback CompletionCallback() const
+    { return Animator::CompletionCallback( m_uiAnimation ); }
+    Callback LoopCallback() const
+    { return Animator::LoopCallback( m_uiAnimation ); }
+    unsigned int LengthInFrames() const
+    { return Animator::LengthInFrames( m_uiAnimation ); }
     double LengthInSeconds() const
-    { return ( 0.0 == m_dFPS ? 0.0 : LengthInFrames() / m_dFPS ); }
-    unsigned int ElapsedFrames() const;
-    double ElapsedSeconds() const;
+    { return Animator::LengthInSeconds( m_uiAnimation ); }
+    unsigned int ElapsedFrames() const
+    { return Animator::ElapsedFrames( m_uiAnimation ); }
+    double ElapsedSeconds() const
+    { return Animator::ElapsedSeconds( m_uiAnimation ); }
 
     // Set properties
     AnimatedSprite& SetFPS( double a_dFPS )
-    { m_dFPS = a_dFPS; return Seek( ElapsedFrames() ); }
+    { Animator::SetFPS( m_uiAnimation, a_dFPS ); return *this; }
     AnimatedSprite& SetCompletionCallback( Callback a_pOnComplete )
-    { m_pOnComplete = a_pOnComplete; return *this; }
-    AnimatedSprite& SetLoops( unsigned int a_uiLoops );
-    AnimatedSprite& SetLengthInSeconds( double a_dSeconds );    // no effect if
-                                                                // m_uiLoops = 0
+    {
+        Animator::SetCompletionCallback( m_uiAnimation, a_pOnComplete );
+        return *this;
+    }
+    AnimatedSprite& SetLoopCallback( Callback a_pOnLoop )
+    { Animator::SetLoopCallback( m_uiAnimation, a_pOnLoop ); return *this; }
+    AnimatedSprite& SetLoops( unsigned int a_uiLoops )
+    { Animator::SetLoops( m_uiAnimation, a_uiLoops ); return *this; }
+    AnimatedSprite& SetLengthInSeconds( double a_dSeconds ) // no effect if
+    {                                                       // Loops() = 0
+        Animator::SetLengthInSeconds( m_uiAnimation, a_dSeconds );
+        return *this;
+    }
+
+    // Keep the animation in step with frame changes made directly
+    virtual AnimatedSprite&
+        SetFrameNumber( unsigned int a_uiFrameNumber = 0 ) override;
+    virtual AnimatedSprite& SetFrameList( const Frame::Array& ac_roFrameList =
+                                              Frame::Array::EMPTY ) override;
 
     // Call the completion callback, if there is one, on this animated sprite
-    void OnComplete() { if( nullptr != m_pOnComplete ) m_pOnComplete( *this ); }
+    void OnComplete() { Animator::OnComplete( m_uiAnimation ); }
 
 protected:
 
-    // Animation progress
-    bool m_bPaused;
-    unsigned int m_uiCompletedLoops;
-    double m_dSeconds;  // total play time before last pause
-    double m_dUnpauseTime;
-
-    // Animation properties
-    unsigned int m_uiLoops; // 0 = infinite
-    double m_dFPS;  // 0.0 = increment frame on draw, regardless of elapsed time
-
-    // What to do when the animation finishes looping
-    Callback m_pOnComplete;   // nullptr = do nothing
+    // Index of this sprite's animation in the Animator
+    unsigned int m_uiAnimation;
 
 private:
     
@@ -191,6 +217,7 @@ private:
                     const Point3D& ac_roUpperRightCorner,
                     const Point3D& ac_roForward = Point3D::Unit(0),
                     const Color::ColorVector& ac_roColor = Color::WHITE );
+    AnimatedSprite& SetFrameList( const Frame::Array&& ac_rroFrameList );
 
 };  // class AnimatedSprite
 
@@ -0,0 +1,149 @@
+/******************************************************************************
+ * File:               Animator.h
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Playback state for every animated sprite, kept in
+ *                      parallel arrays and advanced in one pass per frame.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Creation.
+ ******************************************************************************/
+
+#ifndef ANIMATOR__H
+#define ANIMATOR__H
+
+#include "MathLibrary.h"
+#include "MyFirstEngineMacros.h"
+
+namespace MyFirstEngine
+{
+
+using namespace Utility;
+
+class AnimatedSprite;
+
+// Every animated sprite is a handle to one animation here.  The animations'
+// play times, frame rates, loop counts, and frame numbers are kept in parallel
+// arrays, one entry per animation, so advancing all of them is a pass over a
+// few contiguous arrays rather than a virtual call on each sprite:
+//
+//   void MyState::OnUpdate( double a_dDeltaTime )
+//   {
+//       Animator::UpdateAll();
+//       ...
+//   }
+//
+// A sprite is only touched if its frame actually changes.  Loop and completion
+// callbacks that come due during the pass are queued and called once the pass
+// is over, so they're free to play, pause, create, or destroy animated
+// sprites.
+//
+// AnimatedSprite::Update still advances a single animation the same way, so
+// code that updates sprites one at a time doesn't need to change - just don't
+// do both to the same sprite in the same frame.
+class IMEXPORT_CLASS Animator : private Singleton< Animator >
+{
+    friend Singleton< Animator >;
+    friend class AnimatedSprite;
+
+public:
+
+    // animation loop/completion callback
+    typedef void (*Callback)( AnimatedSprite& a_roSprite );
+
+    // What the last UpdateAll did
+    struct Stats
+    {
+        unsigned int uiAnimations;      // all animations
+        unsigned int uiAdvanced;        // playing and not yet completed
+        unsigned int uiFrameChanges;    // sprites whose frame changed
+        unsigned int uiCallbacks;       // loop and completion callbacks
+    };
+
+    // Destructor
+    virtual ~Animator();
+
+    // Advance every playing animation to the given time, then call any loop
+    // and completion callbacks that came due.  By default, the time is the
+    // start of the current frame.
+    static void UpdateAll();
+    static void UpdateAll( double a_dTime );
+
+    // Number of animations
+    static unsigned int Count();
+
+    // Results of the most recent UpdateAll
+    static const Stats& LastUpdate() { return Instance().m_oLastUpdate; }
+
+private:
+
+    // PIMPLE idiom - these classes are only defined in the cpp, so stl members
+    // and inheritance from stl containers won't result in warnings.
+    class Tracks;
+    class CallbackQueue;
+
+    // Constructor
+    Animator();
+
+    // Add an animation for the given sprite, either new or a copy of another,
+    // and return its index
+    static unsigned int Create( AnimatedSprite& a_roOwner, double a_dFPS,
+                                unsigned int a_uiLoops,
+                                Callback a_pOnComplete );
+    static unsigned int Create( AnimatedSprite& a_roOwner,
+                                unsigned int a_uiSource );
+
+    // Copy playback state from one animation to another
+    static void Copy( unsigned int a_uiAnimation, unsigned int a_uiSource );
+
+    // Remove an animation.  The last animation takes its place, and that
+    // animation's sprite is given the new index.
+    static void Destroy( unsigned int a_uiAnimation );
+
+    // Pick up frame list or frame number changes made to the sprite directly
+    static void SyncFrames( unsigned int a_uiAnimation );
+
+    // Per-animation versions of the AnimatedSprite functions
+    static void Update( unsigned int a_uiAnimation );
+    static void CalculateFrame( unsigned int a_uiAnimation );
+    static void IncrementFrame( unsigned int a_uiAnimation );
+    static void Play( unsigned int a_uiAnimation );
+    static void Pause( unsigned int a_uiAnimation );
+    static void Rewind( unsigned int a_uiAnimation );
+    static void Complete( unsigned int a_uiAnimation );
+    static void Seek( unsigned int a_uiAnimation, unsigned int a_uiFrame );
+    static void Seek( unsigned int a_uiAnimation, double a_dSeconds );
+    static void Add( unsigned int a_uiAnimation, int a_iFrames );
+    static void Add( unsigned int a_uiAnimation, double a_dSeconds );
+    static bool IsCompleted( unsigned int a_uiAnimation );
+    static bool IsPaused( unsigned int a_uiAnimation );
+    static unsigned int Loops( unsigned int a_uiAnimation );
+    static double FPS( unsigned int a_uiAnimation );
+    static unsigned int CompletedLoops( unsigned int a_uiAnimation );
+    static Callback CompletionCallback( unsigned int a_uiAnimation );
+    static Callback LoopCallback( unsigned int a_uiAnimation );
+    static unsigned int LengthInFrames( unsigned int a_uiAnimation );
+    static double LengthInSeconds( unsigned int a_uiAnimation );
+    static unsigned int ElapsedFrames( unsigned int a_uiAnimation );
+    static double ElapsedSeconds( unsigned int a_uiAnimation );
+    static void SetFPS( unsigned int a_uiAnimation, double a_dFPS );
+    static void SetCompletionCallback( unsigned int a_uiAnimation,
+                                       Callback a_pOnComplete );
+    static void SetLoopCallback( unsigned int a_uiAnimation,
+                                 Callback a_pOnLoop );
+    static void SetLoops( unsigned int a_uiAnimation, unsigned int a_uiLoops );
+    static void SetLengthInSeconds( unsigned int a_uiAnimation,
+                                    double a_dSeconds );
+    static void OnComplete( unsigned int a_uiAnimation );
+
+    // Call the callbacks queued during the last pass
+    void DispatchCallbacks();
+
+    Tracks* m_poTracks;
+    CallbackQueue* m_poCallbacks;
+    Stats m_oLastUpdate;
+
+};  // class Animator
+
+}   // namespace MyFirstEngine
+
+#endif  // ANIMATOR__H
@@ -5,8 +5,8 @@
  * Description:        Class for managing the projection matrix.
  *                      TODO: switch to non-singleton implementation so there
  *                      can be multiple cameras
- * Last Modified:      March 22, 2014
- * Last Modification:  Creation.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Added IsPerspective.
  ******************************************************************************/
 
 #ifndef CAMERA__H
@@ -41,6 +41,8 @@ public:
     static void SetAspectRatio( double a_dRatio, double a_dHeight = 2.0 );
 
     // Control perspective (<0 = parallel projection)
+    static bool IsPerspective()
+    { return Instance().m_bUseCamera && 0.0 < Instance().m_dFocalLength; }
     static void SetFocalLength( double a_dLength );
     static void SetAngleOfView( double a_dRadians );
     static void SetDepthOfView( double a_dDepth );  // far plane (near is zero)
@@ -0,0 +1,86 @@
+/******************************************************************************
+ * File:               Culling.h
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Skips drawing objects the camera can't see.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Creation.
+ ******************************************************************************/
+
+#ifndef CULLING__H
+#define CULLING__H
+
+#include "MathLibrary.h"
+#include "MyFirstEngineMacros.h"
+
+namespace MyFirstEngine
+{
+
+class Drawable;
+
+// Before drawing an object, Drawable::Draw asks for its bounds in model space
+// and tests them against the frustum of the current model-view-projection
+// matrix.  Objects entirely outside the view aren't drawn at all.  With a
+// parallel projection, like the default 2D camera, only the view rectangle is
+// tested, so objects are never culled for their depth.
+//
+// Testing is hierarchical.  If an object's bounds are entirely inside some of
+// the frustum's planes, anything it draws inside those bounds doesn't need to
+// be tested against those planes again, and if they're entirely inside the
+// frustum, nothing it draws needs to be tested at all.
+//
+// For large worlds, testing every object one at a time is still a lot of
+// work.  Cull tests whole arrays of world-space boxes at once against the
+// current view, so a game can keep its objects' bounds in arrays and only draw
+// the ones that pass.
+class IMEXPORT_CLASS Culling : Utility::Singleton< Culling >
+{
+    friend Utility::Singleton< Culling >;
+public:
+
+    // Control whether or not objects are culled.  Enabled by default.
+    static void Enable() { Instance().m_bEnabled = true; }
+    static void Disable() { Instance().m_bEnabled = false; }
+    static bool IsEnabled() { return Instance().m_bEnabled; }
+
+    // Frustum of the current model-view-projection matrix, and the planes of
+    // it worth testing against with the current camera
+    static Space::Frustum ViewFrustum();
+    static unsigned int ViewPlanes();
+
+    // Test whole arrays of boxes in the current model-view space at once,
+    // writing the indices of the ones that might be visible to the results
+    // array and returning how many there are
+    static unsigned int Cull( const double* ac_padMinX,
+                              const double* ac_padMinY,
+                              const double* ac_padMinZ,
+                              const double* ac_padMaxX,
+                              const double* ac_padMaxY,
+                              const double* ac_padMaxZ,
+                              unsigned int a_uiCount,
+                              unsigned int* a_pauiResults );
+
+    // Planes that objects still need to be tested against, given the bounds
+    // of the objects currently being drawn
+    static unsigned int Planes() { return Instance().m_uiPlanes; }
+    static void SetPlanes( unsigned int a_uiPlanes )
+    { Instance().m_uiPlanes = a_uiPlanes; }
+
+    // Test a drawable whose model matrix has already been applied to the
+    // model-view matrix.  If it might be visible, narrow the planes anything
+    // it draws needs to be tested against and return true.
+    static bool Test( const Drawable& ac_roDrawable );
+
+private:
+
+    // Constructor
+    Culling() : m_bEnabled( true ), m_uiPlanes( Space::Frustum::ALL_PLANES ) {}
+
+    bool m_bEnabled;
+    unsigned int m_uiPlanes;
+
+};  // class Culling
+
+}   // namespace MyFirstEngine
+
+#endif  // CULLING__H
@@ -3,8 +3,8 @@
  * Author:             Elizabeth Lowry
  * Date Created:       February 24, 2014
  * Description:        Base class for drawable objects.
- * Last Modified:      March 12, 2014
- * Last Modification:  Debugging.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Added bounds for culling.
  ******************************************************************************/
 
 #ifndef DRAWABLE__H
@@ -66,6 +66,17 @@ public:
     // since the last time said transformation was calculated, recalculate it.
     virtual const Transform3D& GetModelMatrix() const;
 
+    // Get the box containing everything this object draws, before its model
+    // matrix is applied.  Objects that don't know their bounds return false
+    // and are never culled.  Objects that draw other objects must include
+    // those objects' bounds as well as their own.
+    virtual bool GetLocalBounds( Space::BoundingBox& a_roBounds ) const
+    { return false; }
+
+    // Get the box containing everything this object draws after its model
+    // matrix is applied, if it has bounds
+    bool GetBounds( Space::BoundingBox& a_roBounds ) const;
+
     // Set color
     Drawable& SetColor( const Color::ColorVector& ac_roColor );
     Drawable& SetColor( float a_fRed, float a_fGreen, float a_fBlue,
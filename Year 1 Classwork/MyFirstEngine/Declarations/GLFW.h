@@ -3,8 +3,8 @@
  * Author:             Elizabeth Lowry
  * Date Created:       February 5, 2014
  * Description:        Includes the necessary headers and macros for GLFW.
- * Last Modified:      February 5, 2014
- * Last Modification:  Creation.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Dispatching glfwSetTime.
  ******************************************************************************/
 
 #ifndef MY_FIRST_ENGINE__GLFW__H
@@ -21,4 +21,112 @@
 #undef GLFW_DLL
 #endif
 
+// Functions GLEW loads are already called through pointers it exports, but
+// GLFW, GLEW's own initialization, and the OpenGL 1.1 functions are linked
+// directly.  Within the engine, those are called through the pointers below
+// instead, which start out pointing at the real functions, so that another
+// backend (like the NullBackend) can stand in for the window system and the
+// GL driver.  GLFW.cpp defines MY_FIRST_ENGINE__NO_DISPATCH to get at the
+// real functions.
+#if defined( MYFIRSTENGINE_EXPORTS ) && !defined( MY_FIRST_ENGINE__NO_DISPATCH )
+
+namespace MyFirstEngine
+{
+namespace Dispatch
+{
+
+// OpenGL 1.1
+extern decltype( &::glBindTexture ) glBindTexture;
+extern decltype( &::glBlendFunc ) glBlendFunc;
+extern decltype( &::glClear ) glClear;
+extern decltype( &::glClearColor ) glClearColor;
+extern decltype( &::glDeleteTextures ) glDeleteTextures;
+extern decltype( &::glDrawElements ) glDrawElements;
+extern decltype( &::glEnable ) glEnable;
+extern decltype( &::glGenTextures ) glGenTextures;
+extern decltype( &::glGetIntegerv ) glGetIntegerv;
+extern decltype( &::glGetString ) glGetString;
+extern decltype( &::glGetTexImage ) glGetTexImage;
+extern decltype( &::glIsTexture ) glIsTexture;
+extern decltype( &::glTexImage2D ) glTexImage2D;
+extern decltype( &::glTexParameterfv ) glTexParameterfv;
+extern decltype( &::glTexParameteri ) glTexParameteri;
+extern decltype( &::glViewport ) glViewport;
+
+// GLEW
+extern decltype( &::glewInit ) glewInit;
+
+// GLFW
+extern decltype( &::glfwCreateWindow ) glfwCreateWindow;
+extern decltype( &::glfwDestroyWindow ) glfwDestroyWindow;
+extern decltype( &::glfwGetCurrentContext ) glfwGetCurrentContext;
+extern decltype( &::glfwGetCursorPos ) glfwGetCursorPos;
+extern decltype( &::glfwGetFramebufferSize ) glfwGetFramebufferSize;
+extern decltype( &::glfwGetTime ) glfwGetTime;
+extern decltype( &::glfwInit ) glfwInit;
+extern decltype( &::glfwMakeContextCurrent ) glfwMakeContextCurrent;
+extern decltype( &::glfwPollEvents ) glfwPollEvents;
+extern decltype( &::glfwSetCursorEnterCallback ) glfwSetCursorEnterCallback;
+extern decltype( &::glfwSetErrorCallback ) glfwSetErrorCallback;
+extern decltype( &::glfwSetKeyCallback ) glfwSetKeyCallback;
+extern decltype( &::glfwSetMouseButtonCallback ) glfwSetMouseButtonCallback;
+extern decltype( &::glfwSetTime ) glfwSetTime;
+extern decltype( &::glfwSetWindowCloseCallback ) glfwSetWindowCloseCallback;
+extern decltype( &::glfwSetWindowShouldClose ) glfwSetWindowShouldClose;
+extern decltype( &::glfwSetWindowSize ) glfwSetWindowSize;
+extern decltype( &::glfwSetWindowTitle ) glfwSetWindowTitle;
+extern decltype( &::glfwSwapBuffers ) glfwSwapBuffers;
+extern decltype( &::glfwTerminate ) glfwTerminate;
+extern decltype( &::glfwWindowHint ) glfwWindowHint;
+extern decltype( &::glfwWindowShouldClose ) glfwWindowShouldClose;
+
+}   // namespace Dispatch
+}   // namespace MyFirstEngine
+
+#define glBindTexture MyFirstEngine::Dispatch::glBindTexture
+#define glBlendFunc MyFirstEngine::Dispatch::glBlendFunc
+#define glClear MyFirstEngine::Dispatch::glClear
+#define glClearColor MyFirstEngine::Dispatch::glClearColor
+#define glDeleteTextures MyFirstEngine::Dispatch::glDeleteTextures
+#define glDrawElements MyFirstEngine::Dispatch::glDrawElements
+#define glEnable MyFirstEngine::Dispatch::glEnable
+#define glGenTextures MyFirstEngine::Dispatch::glGenTextures
+#define glGetIntegerv MyFirstEngine::Dispatch::glGetIntegerv
+#define glGetString MyFirstEngine::Dispatch::glGetString
+#define glGetTexImage MyFirstEngine::Dispatch::glGetTexImage
+#define glIsTexture MyFirstEngine::Dispatch::glIsTexture
+#define glTexImage2D MyFirstEngine::Dispatch::glTexImage2D
+#define glTexParameterfv MyFirstEngine::Dispatch::glTexParameterfv
+#define glTexParameteri MyFirstEngine::Dispatch::glTexParameteri
+#define glViewport MyFirstEngine::Dispatch::glViewport
+#define glewInit MyFirstEngine::Dispatch::glewInit
+#define glfwCreateWindow MyFirstEngine::Dispatch::glfwCreateWindow
+#define glfwDestroyWindow MyFirstEngine::Dispatch::glfwDestroyWindow
+#define glfwGetCurrentContext MyFirstEngine::Dispatch::glfwGetCurrentContext
+#define glfwGetCursorPos MyFirstEngine::Dispatch::glfwGetCursorPos
+#define glfwGetFramebufferSize MyFirstEngine::Dispatch::glfwGetFramebufferSize
+#define glfwGetTime MyFirstEngine::Dispatch::glfwGetTime
+#define glfwInit MyFirstEngine::Dispatch::glfwInit
+#define glfwMakeContextCurrent MyFirstEngine::Dispatch::glfwMakeContextCurrent
+#define glfwPollEvents MyFirstEngine::Dispatch::glfwPollEvents
+#define glfwSetCursorEnterCallback \
+    MyFirstEngine::Dispatch::glfwSetCursorEnterCallback
+#define glfwSetErrorCallback MyFirstEngine::Dispatch::glfwSetErrorCallback
+#define glfwSetKeyCallback MyFirstEngine::Dispatch::glfwSetKeyCallback
+#define glfwSetMouseButtonCallback \
+    MyFirstEngine::Dispatch::glfwSetMouseButtonCallback
+#define glfwSetTime MyFirstEngine::Dispatch::glfwSetTime
+#define glfwSetWindowCloseCallback \
+    MyFirstEngine::Dispatch::glfwSetWindowCloseCallback
+#define glfwSetWindowShouldClose \
+    MyFirstEngine::Dispatch::glfwSetWindowShouldClose
+#define glfwSetWindowSize MyFirstEngine::Dispatch::glfwSetWindowSize
+#define glfwSetWindowTitle MyFirstEngine::Dispatch::glfwSetWindowTitle
+#define glfwSwapBuffers MyFirstEngine::Dispatch::glfwSwapBuffers
+#define glfwTerminate MyFirstEngine::Dispatch::glfwTerminate
+#define glfwWindowHint MyFirstEngine::Dispatch::glfwWindowHint
+#define glfwWindowShouldClose MyFirstEngine::Dispatch::glfwWindowShouldClose
+
+#endif  // MYFIRSTENGINE_EXPORTS && !MY_FIRST_ENGINE__NO_DISPATCH
+
 #endif  // MY_FIRST_ENGINE__GLFW__H
@@ -3,8 +3,8 @@
  * Author:             Elizabeth Lowry
  * Date Created:       February 5, 2014
  * Description:        Singleton class representing the game engine as a whole.
- * Last Modified:      March 17, 2014
- * Last Modification:  Adding replacement for deprecated OpenGL matrix stack.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Frame times come from Input, so replays can supply them.
  ******************************************************************************/
 
 #ifndef GAME_ENGINE__H
@@ -12,6 +12,7 @@
 
 #include "GameWindow.h"
 #include "MathLibrary.h"
+#include "Precision.h"
 #include <stack>
 
 #include "MyFirstEngineMacros.h"
@@ -29,6 +30,7 @@ class GameState;
 class IMEXPORT_CLASS GameEngine : private Singleton< GameEngine >
 {
     friend Singleton< GameEngine >;
+    friend class Input;
 
 public:
 
@@ -52,22 +54,23 @@ public:
     static GameState& PushState( GameState& a_roState );
     static GameState& ReplaceCurrentState( GameState& a_roState );
 
-    // Replaces the now-deprecated OpenGL matrix stack
-    static Transform3D ModelViewProjection();
-    static Transform3D& ModelView();
-    static Transform3D& Projection();
-    static Transform3D& SetModelView( const Transform3D& ac_roMatrix );
-    static Transform3D& SetProjection( const Transform3D& ac_roMatrix );
-    static Transform3D& ApplyAfterModelView( const Transform3D& ac_roMatrix );
-    static Transform3D& ApplyAfterProjection( const Transform3D& ac_roMatrix );
-    static Transform3D& ApplyBeforeModelView( const Transform3D& ac_roMatrix );
-    static Transform3D& ApplyBeforeProjection( const Transform3D& ac_roMatrix );
+    // Replaces the now-deprecated OpenGL matrix stack.  Matrices are in the
+    // precision chosen in Precision.h.
+    static GLTransform3D ModelViewProjection();
+    static GLTransform3D& ModelView();
+    static GLTransform3D& Projection();
+    static GLTransform3D& SetModelView( const GLTransform3D& ac_roMatrix );
+    static GLTransform3D& SetProjection( const GLTransform3D& ac_roMatrix );
+    static GLTransform3D& ApplyAfterModelView( const GLTransform3D& ac_roMatrix );
+    static GLTransform3D& ApplyAfterProjection( const GLTransform3D& ac_roMatrix );
+    static GLTransform3D& ApplyBeforeModelView( const GLTransform3D& ac_roMatrix );
+    static GLTransform3D& ApplyBeforeProjection( const GLTransform3D& ac_roMatrix );
     static void ClearModelView();
     static void ClearProjection();
-    static Transform3D PopModelView();
-    static Transform3D PopProjection();
-    static Transform3D& PushModelView( const Transform3D& ac_roMatrix = ModelView() );
-    static Transform3D& PushProjection( const Transform3D& ac_roMatrix = Projection() );
+    static GLTransform3D PopModelView();
+    static GLTransform3D PopProjection();
+    static GLTransform3D& PushModelView( const GLTransform3D& ac_roMatrix = ModelView() );
+    static GLTransform3D& PushProjection( const GLTransform3D& ac_roMatrix = Projection() );
 
     // Print error messages to standard error stream.
     static void PrintError( int a_iCode, const char* ac_pcDescription );
@@ -96,8 +99,9 @@ private:
     // function.  The user never instantiates a GameEngine object directly.
     GameEngine();
 
-    // Returns the time since this function was last called.
-    double DeltaTime();
+    // Move on to a new frame at the given time and return the time since the
+    // last frame.
+    double DeltaTime( double a_dTime );
 
     // get a reference to a static stack object, the top of which contains the
     // current state.
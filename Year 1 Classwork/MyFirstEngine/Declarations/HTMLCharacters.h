@@ -3,14 +3,15 @@
  * Author:             Elizabeth Lowry
  * Date Created:       March 21, 2014
  * Description:        Constants and character map for html extended ASCII.
- * Last Modified:      March 21, 2014
- * Last Modification:  Creation.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Find and Map accepting exactly the same names.
  ******************************************************************************/
 
 #ifndef HTML_CHARACTERS__H
 #define HTML_CHARACTERS__H
 
 #include "CharacterMap.h"
+#include <cstddef>  // for size_t
 #include "MyFirstEngineMacros.h"
 
 // constants named after HTML symbols (such as &amp; or &quot;) with values
@@ -19,10 +20,19 @@ namespace HTML
 {
 
 // Map for ASCII and ANSI extended ASCII characters mapped to their actual char
-// values ("&" for '&'), numbers ("#38" or "x26" for '&'), and, if present, HTML
+// values ("&" for '&'), numbers ("#38", "x26", "#x26", or "#X26" for '&', with
+// hex letters in either case and no leading zeros), and, if present, HTML
 // names ("amp" for '&')
 IMEXPORT const MyFirstEngine::CharacterMap& Map();
 
+// Look up a character by exactly the names Map() accepts, without building the
+// map or allocating.  The first version takes a name that isn't
+// necessarily null-terminated.  Returns false if the name isn't recognized, in
+// which case a_rcCharacter is left alone.
+IMEXPORT bool Find( const char* ac_pcName, std::size_t a_uiLength,
+                    char& a_rcCharacter );
+IMEXPORT bool Find( const char* ac_pcName, char& a_rcCharacter );
+
 const char quot = '"';
 const char amp = '&';
 const char apos = '\'';
@@ -0,0 +1,117 @@
+/******************************************************************************
+ * File:               Input.h
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Queue of timestamped input events applied each frame.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Carrying the clock on from the last replayed frame once a
+ *                      replay runs out.
+ ******************************************************************************/
+
+#ifndef INPUT__H
+#define INPUT__H
+
+#include "MathLibrary.h"
+#include "MyFirstEngineMacros.h"
+
+namespace MyFirstEngine
+{
+
+// Key and mouse button events aren't applied to the keyboard and mouse state
+// as soon as they arrive.  Instead, each one is posted to a lock-free queue
+// with the time it happened, and at the start of each frame the engine applies
+// every event up to the frame's time, in the order they happened.  That way
+// the state stays the same for the whole frame, and several presses and
+// releases between one frame and the next are each seen, with their own
+// times, rather than only whatever state the key ended up in.
+//
+// Events may be posted from one thread other than the one running the game,
+// as long as only one thread posts at a time.
+//
+// Since every key and button change goes through here, along with each
+// frame's time, a session can be recorded to a compact binary file and then
+// played back, so that a profiling run sees exactly the same input at exactly
+// the same times as the run before it:
+//
+//   GameEngine::Initialize();
+//   Input::StartReplay( "session.input" ) ||
+//       Input::StartRecording( "session.input" );
+//   GameEngine::Run();
+//
+// While recording or replaying, the cursor position and window reported by
+// Mouse are also only updated once a frame, so they can be recorded too.
+// While replaying, live key and button events are thrown away, and frame
+// times come from the recording instead of the clock.  Once the recording
+// runs out, the game goes back to live input, and the clock is moved so that
+// time carries on from the last frame replayed instead of jumping.  For the
+// replay to match, the game has to start it in the same state it started
+// recording in.
+class IMEXPORT_CLASS Input : public Utility::InitializeableSingleton< Input >
+{
+    friend class Utility::InitializeableSingleton< Input >;
+public:
+
+    // What kind of thing the event's code refers to
+    enum Device
+    {
+        KEYBOARD,       // code is a Keyboard::Key
+        MOUSE_BUTTON    // code is a Mouse::Button
+    };
+
+    // A key or button going down or coming back up
+    struct Event
+    {
+        double dTime;
+        Device eDevice;
+        int iCode;
+        bool bPressed;
+    };
+
+    // Queue an event to be applied at the start of the next frame, returning
+    // false if the queue is full and the event had to be dropped
+    static bool Post( Device a_eDevice, int a_iCode, bool a_bPressed,
+                      double a_dTime );
+
+    // Start a new frame - forget which keys and buttons changed last frame,
+    // then apply every queued event up to the given time, or the next frame's
+    // events from the recording being replayed.  Returns the frame's time,
+    // which is the given time unless replaying or a replay just ran out.
+    static double Update( double a_dTime );
+
+    // Record every frame's time and input to the given file, replacing it,
+    // until recording is stopped or the engine terminated.  Returns false if
+    // the file can't be opened or a recording is being replayed.
+    static bool StartRecording( const char* ac_pcFileName );
+    static void StopRecording();
+    static bool IsRecording();
+
+    // Play back a recording from the given file instead of live input.
+    // Returns false if the file can't be read or isn't a recording, or if
+    // already recording.
+    static bool StartReplay( const char* ac_pcFileName );
+    static void StopReplay();
+    static bool IsReplaying();
+
+    // How many events have been dropped because the queue was full
+    static unsigned int Dropped();
+
+    static const unsigned int QUEUE_CAPACITY = 1024;
+
+private:
+
+    Input() {}
+
+    virtual void TerminateInstance() override;
+
+    // Send an event to whichever class keeps track of its device
+    static void Dispatch( const Event& ac_roEvent );
+
+    // Apply the next frame of the recording being replayed and get its time,
+    // or return false if the recording has run out
+    static bool ReplayFrame( double& a_rdTime );
+
+};  // class Input
+
+}   // namespace MyFirstEngine
+
+#endif  // INPUT__H
@@ -0,0 +1,108 @@
+/******************************************************************************
+ * File:               InstancedSpriteShaderProgram.h
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Shader program for drawing batches of sprites with
+ *                      instancing.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Instance buffer regions sized for a whole frame.
+ ******************************************************************************/
+
+#ifndef INSTANCED_SPRITE_SHADER_PROGRAM__H
+#define INSTANCED_SPRITE_SHADER_PROGRAM__H
+
+#include "MathLibrary.h"
+#include "ShaderProgram.h"
+#include "SpriteBatch.h"
+#include "StreamBuffer.h"
+#include "Texture.h"
+#include "MyFirstEngineMacros.h"
+
+namespace MyFirstEngine
+{
+
+using namespace Utility;
+
+// Shader program used by SpriteBatch.  Per-sprite data comes from instanced
+// vertex attributes streamed through a StreamBuffer, and the frame table is a
+// texture buffer the vertex shader looks frames up in.  Instances are always
+// single precision, whatever Precision.h chooses for the matrix stacks.
+class IMEXPORT_CLASS InstancedSpriteShaderProgram
+    : public ShaderProgram,
+      public InitializeableSingleton< InstancedSpriteShaderProgram >
+{
+    friend class InitializeableSingleton< InstancedSpriteShaderProgram >;
+
+public:
+
+    // virtual destructor present due to inheritance
+    virtual ~InstancedSpriteShaderProgram() {}
+
+    // Replace the frame table
+    static void SetFrameTable( const SpriteBatch::FrameDescriptor* ac_paoFrames,
+                               unsigned int a_uiCount );
+
+    // Start and finish a run of draws that stream their instances into the
+    // same region of the instance buffer, e.g. everything in one flush of a
+    // sprite batch.  Only a run that doesn't fit in one region has to wait
+    // for the GPU to finish with the next one.
+    static void BeginInstances();
+    static void EndInstances();
+
+    // Draw textured 1x1 quads, one per instance, using the current frame
+    // table.  Runs too large for what's left of the current region are split
+    // into as many draws as the instance buffer needs.
+    static void DrawInstances( Texture& a_roTexture,
+                               const SpriteBatch::Instance* ac_paoInstances,
+                               unsigned int a_uiCount );
+
+    // default instanced sprite shader source code files
+    static const char* const INSTANCED_SPRITE_VERTEX_SHADER_FILE;
+    static const char* const INSTANCED_SPRITE_FRAGMENT_SHADER_FILE;
+
+    // Instances that fit in one region of the instance buffer, enough for a
+    // whole frame's sprites
+    static const unsigned int INSTANCES_PER_FRAME = 16384;
+
+protected:
+
+    // only the parent class's Initialize function can call this.
+    InstancedSpriteShaderProgram();
+
+    // Instance initialization/termination calls StartSetup()/Destroy() before
+    // constructor/destructor.  Setup is finished by FinishAllSetups().
+    virtual void InitializeInstance() override { StartSetup(); }
+    virtual void TerminateInstance() override { Destroy(); }
+
+    // manage the buffers, vertex array, and frame table
+    virtual void DestroyData() override;
+    virtual void SetupData() override;
+    virtual void UseData() const override;
+
+    // Point the instance attributes at the given offset in the instance buffer
+    void BindInstances( unsigned int a_uiOffset ) const;
+
+    // Uniform variable locations
+    GLint m_iTextureID;
+    GLint m_iFramesID;
+
+    // Instance attribute locations
+    GLint m_iModelViewProjectionID;     // first of four
+    GLint m_iColorID;
+    GLint m_iFrameID;
+
+    // Vertex array
+    GLuint m_uiVertexArrayID;
+
+    // Frame table buffer and the texture that reads from it
+    GLuint m_uiFrameBufferID;
+    GLuint m_uiFrameTextureID;
+
+    // Instance data, streamed in each time instances are drawn
+    StreamBuffer* m_poInstances;
+
+};  // class InstancedSpriteShaderProgram
+
+}   // namespace MyFirstEngine
+
+#endif  // INSTANCED_SPRITE_SHADER_PROGRAM__H
@@ -3,14 +3,16 @@
  * Author:             Elizabeth Lowry
  * Date Created:       March 25, 2014
  * Description:        Class for managing keyboard
- * Last Modified:      March 25, 2014
- * Last Modification:  Creation.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Flat key state tables, per-frame pressed and released
+ *                      keys, and events applied through Input.
  ******************************************************************************/
 
 #ifndef KEYBOARD__H
 #define KEYBOARD__H
  
 #include "GameWindow.h"
+#include "Input.h"
 #include "MathLibrary.h"
 #include "MyFirstEngineMacros.h"
 
@@ -21,6 +23,7 @@ class IMEXPORT_CLASS Keyboard
     : public Utility::InitializeableSingleton< Keyboard >
 {
     friend class Utility::InitializeableSingleton< Keyboard >;
+    friend class Input;
 public:
 
     // Keys on a keyboard
@@ -145,7 +148,9 @@ public:
         RIGHT_CONTROL = 345,
         RIGHT_ALT = 346,
         RIGHT_SUPER = 347,
-        MENU = 348
+        MENU = 348,
+
+        KEY_COUNT = 349
 
     };  // enum Key
     static bool IsKey( int a_i );
@@ -158,6 +163,11 @@ public:
     static bool AltIsPressed();
     static bool SuperIsPressed();
 
+    // Did the given key go down or come up since the last frame?  A key tapped
+    // quickly enough does both in the same frame.
+    static bool KeyWasPressed( Key a_eKey );
+    static bool KeyWasReleased( Key a_eKey );
+
     // How long has the given key been pressed/not pressed?
     static double KeyTime( Key a_eKey );
     static double AnyKeyTime();
@@ -176,6 +186,11 @@ private:
 
     virtual void TerminateInstance() override;
 
+    // Called by Input at the start of each frame to forget which keys changed
+    // last frame, and then for each key event that happened since
+    static void NewFrame();
+    static void Apply( const Input::Event& ac_roEvent );
+
 };  // class Keyboard
 
 }   // namespace MyFirstEngine
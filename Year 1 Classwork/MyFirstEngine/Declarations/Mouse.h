@@ -3,14 +3,16 @@
  * Author:             Elizabeth Lowry
  * Date Created:       March 25, 2014
  * Description:        Class for managing mouse input
- * Last Modified:      March 25, 2014
- * Last Modification:  Creation.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Holding the cursor in place for each frame while input is
+ *                      recorded or replayed.
  ******************************************************************************/
 
 #ifndef MOUSE__H
 #define MOUSE__H
 
 #include "GameWindow.h"
+#include "Input.h"
 #include "MathLibrary.h"
 #include "MyFirstEngineMacros.h"
 
@@ -20,6 +22,7 @@ namespace MyFirstEngine
 class IMEXPORT_CLASS Mouse : public Utility::InitializeableSingleton< Mouse >
 {
     friend class Utility::InitializeableSingleton< Mouse >;
+    friend class Input;
 public:
 
     // Mouse buttons
@@ -59,10 +62,17 @@ public:
     static double RightButtonTime()
     { return ButtonTime( RIGHT_BUTTON ); }
 
+    // Did a button go down or come up since the last frame?  A quick enough
+    // click does both in the same frame.
+    static bool ButtonWasPressed( Button m_eButton = LEFT_BUTTON );
+    static bool ButtonWasReleased( Button m_eButton = LEFT_BUTTON );
+
     // Where is the cursor's last reported position, in pixels, relative to the
     // center of the given window (+y = up) and is it even in said window?  If
     // no window is given, use main window. If window isn't valid GLFW window,
-    // return origin.
+    // return origin.  While Input is recording or replaying, this is where
+    // the cursor was at the start of the frame, and only the main window's
+    // position is known.
     static Point2D Position( GameWindow* a_poWindow = nullptr );
 
     // Hook up or unhook the mouse event handlers for the given window
@@ -82,6 +92,20 @@ private:
     virtual void InitializeInstance() override;
     virtual void TerminateInstance() override;
 
+    // Called by Input at the start of each frame to forget which buttons
+    // changed last frame, and then for each button event that happened since
+    static void NewFrame();
+    static void Apply( const Input::Event& ac_roEvent );
+
+    // Called by Input while recording or replaying, so the cursor stays in one
+    // place for the whole frame - get where the cursor really is relative to
+    // the main window's top left corner, then hold it at the given position.
+    static void GetCursor( double& a_rdX, double& a_rdY,
+                           bool& a_rbInMainWindow );
+    static void FreezeCursor( double a_dX, double a_dY, bool a_bInMainWindow,
+                              double a_dTime );
+    static void UnfreezeCursor();
+
 };  // class Mouse
 
 }   // namespace MyFirstEngine
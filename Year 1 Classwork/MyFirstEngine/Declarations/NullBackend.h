@@ -0,0 +1,129 @@
+/******************************************************************************
+ * File:               NullBackend.h
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Stands in for GLFW and OpenGL so the engine can run
+ *                      without a window or a GPU.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Creation.
+ ******************************************************************************/
+
+#ifndef NULL_BACKEND__H
+#define NULL_BACKEND__H
+
+#include "MathLibrary.h"
+#include "MyFirstEngineMacros.h"
+
+namespace MyFirstEngine
+{
+
+// Once installed, every window, texture, shader, buffer, and draw call the
+// engine makes goes to a backend that doesn't draw anything.  It hands out
+// names for GL objects, remembers how big they are, and says that shaders
+// compiled and programs linked, so the engine's update and draw code runs
+// exactly as it would with a real context, only without a display or a GPU.
+// Along the way, it counts the calls made and the bytes uploaded each frame.
+//
+//   NullBackend::Install();
+//   NullBackend::SetFrameLimit( 1000 );
+//   GameEngine::Initialize();
+//   ... push a state ...
+//   NullBackend::ResetStats();
+//   GameEngine::Run();
+//   ... look at NullBackend::RecordedFrame( i ) for each frame ...
+//   GameEngine::Terminate();
+//   NullBackend::Uninstall();
+//
+// A frame ends each time a window's buffers are swapped.  The GLFW clock
+// advances by a fixed step each frame, so a headless run sees the same frame
+// times every time, and a frame's CPU time is measured with a separate, real
+// clock.  Profiler zones are timed with the GLFW clock, so set the frame time
+// to zero before profiling a headless run.  Extensions and newer GL versions
+// aren't reported as supported, so the engine takes the same paths it would
+// on a plain GL 3.x driver.
+//
+// Install before the engine is initialized and uninstall after it's
+// terminated - objects made with one backend mean nothing to the other.
+class IMEXPORT_CLASS NullBackend
+{
+public:
+
+    // Calls made and data sent to the null backend
+    struct Stats
+    {
+        unsigned int uiDrawCalls;
+        unsigned long long ulIndices;       // drawn, counting every instance
+        unsigned long long ulInstances;
+        unsigned int uiClears;
+        unsigned int uiBufferUploads;       // whole or partial
+        unsigned long long ulBufferBytes;
+        unsigned int uiTextureUploads;
+        unsigned long long ulTextureBytes;
+        unsigned int uiUniformSets;
+        unsigned int uiBinds;       // buffers, textures, arrays, and programs
+        unsigned int uiShaderCompiles;
+        unsigned int uiProgramLinks;
+    };
+
+    // What was done during one frame, and how long the CPU took to do it
+    struct FrameStats
+    {
+        double dCPUTime;    // seconds from the last swap to this one
+        Stats oCalls;
+    };
+
+    // Objects that currently exist, and how much memory they'd be using
+    struct Resources
+    {
+        unsigned int uiWindows;
+        unsigned int uiTextures;
+        unsigned long long ulTextureBytes;
+        unsigned int uiBuffers;
+        unsigned long long ulBufferBytes;
+        unsigned int uiVertexArrays;
+        unsigned int uiShaders;
+        unsigned int uiPrograms;
+    };
+
+    // Switch the engine over to the null backend, or back to GLFW and OpenGL
+    static void Install();
+    static void Uninstall();
+    static bool IsInstalled();
+
+    // How far the GLFW clock moves each frame, in seconds.  Defaults to 60
+    // frames a second.  If zero, the clock keeps real time instead.
+    static void SetFrameTime( double a_dSeconds );
+    static double FrameTime();
+
+    // Once this many frames have been recorded, the next time events are
+    // polled every window is closed, as if the user had clicked its close
+    // button.  Zero, the default, means never.
+    static void SetFrameLimit( unsigned int a_uiFrames );
+
+    // Forget the frames and totals recorded so far, e.g. once loading is done
+    static void ResetStats();
+
+    // Frames finished since the stats were last reset
+    static unsigned int FrameCount();
+    static const FrameStats& RecordedFrame( unsigned int a_uiIndex );
+
+    // Calls made so far in the current frame, and since the stats were reset
+    static const Stats& CurrentFrame();
+    static const Stats& Totals();
+
+    // Objects that exist right now
+    static const Resources& Resident();
+
+    // Real time in seconds, for measuring how long the CPU takes
+    static double CPUTime();
+
+private:
+
+    // Static-only class
+    NullBackend();
+
+};  // class NullBackend
+
+}   // namespace MyFirstEngine
+
+#endif  // NULL_BACKEND__H
@@ -0,0 +1,74 @@
+/******************************************************************************
+ * File:               Precision.h
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Build-time choice of float or double for the matrix
+ *                      stacks and shader uniforms.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Creation.
+ ******************************************************************************/
+
+#ifndef PRECISION__H
+#define PRECISION__H
+
+#include "GLFW.h"
+#include "MathLibrary.h"
+
+// Unless MY_FIRST_ENGINE_SINGLE_PRECISION is defined, the model-view and
+// projection stacks hold doubles and the default shaders take double-precision
+// uniforms, which needs OpenGL 4.0 or ARB_gpu_shader_fp64.  Defining it
+// switches both to floats, and the default shader programs load the float
+// versions of their shaders instead.  Objects still build their own
+// transformations in doubles - they're only converted once they're applied to
+// the stacks.
+namespace MyFirstEngine
+{
+
+#ifdef MY_FIRST_ENGINE_SINGLE_PRECISION
+typedef float GLScalar;
+#else
+typedef double GLScalar;
+#endif
+typedef Math::Matrix< GLScalar, 3 > GLTransform2D;
+typedef Math::Matrix< GLScalar, 4 > GLTransform3D;
+typedef Math::Vector< GLScalar, 2 > GLVector2D;
+
+// Upload uniforms of either precision.  OpenGL uses column vectors, while the
+// MathLibrary transforms are made for use with row vectors.  However, OpenGL
+// stores matrix data in column-major order, while the MathLibrary matrices
+// store data in row-major order, so feeding data from the latter to the former
+// is an automatic transposition.
+inline void SetUniform( GLint a_iLocation,
+                        const Math::Matrix< float, 4 >& ac_roMatrix )
+{
+    glUniformMatrix4fv( a_iLocation, 1, false, &( ac_roMatrix[0][0] ) );
+}
+inline void SetUniform( GLint a_iLocation,
+                        const Math::Matrix< double, 4 >& ac_roMatrix )
+{
+    glUniformMatrix4dv( a_iLocation, 1, false, &( ac_roMatrix[0][0] ) );
+}
+inline void SetUniform( GLint a_iLocation,
+                        const Math::Matrix< float, 3 >& ac_roMatrix )
+{
+    glUniformMatrix3fv( a_iLocation, 1, false, &( ac_roMatrix[0][0] ) );
+}
+inline void SetUniform( GLint a_iLocation,
+                        const Math::Matrix< double, 3 >& ac_roMatrix )
+{
+    glUniformMatrix3dv( a_iLocation, 1, false, &( ac_roMatrix[0][0] ) );
+}
+inline void SetUniform( GLint a_iLocation,
+                        const Math::Vector< float, 2 >& ac_roVector )
+{
+    glUniform2fv( a_iLocation, 1, &( ac_roVector[0] ) );
+}
+inline void SetUniform( GLint a_iLocation,
+                        const Math::Vector< double, 2 >& ac_roVector )
+{
+    glUniform2dv( a_iLocation, 1, &( ac_roVector[0] ) );
+}
+
+}   // namespace MyFirstEngine
+
+#endif  // PRECISION__H
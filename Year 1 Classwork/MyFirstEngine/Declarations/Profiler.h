@@ -0,0 +1,203 @@
+/******************************************************************************
+ * File:               Profiler.h
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Frame profiler with scoped CPU/GPU zones and counters.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Added culled object counter.
+ ******************************************************************************/
+
+#ifndef PROFILER__H
+#define PROFILER__H
+
+#include "GLFW.h"
+#include "MathLibrary.h"
+#include "MyFirstEngineMacros.h"
+
+// Instrument code with these macros rather than using the Profiler classes
+// directly.  Unless MY_FIRST_ENGINE_PROFILE is defined, they expand to nothing,
+// so a build without profiling pays nothing for the instrumentation.
+#ifdef MY_FIRST_ENGINE_PROFILE
+#define PROFILER__H__JOIN2( a, b ) a##b
+#define PROFILER__H__JOIN( a, b ) PROFILER__H__JOIN2( a, b )
+#define PROFILE_ZONE( ac_pcName ) \
+    MyFirstEngine::Profiler::Zone \
+        PROFILER__H__JOIN( oProfileZone, __LINE__ )( ac_pcName )
+#define PROFILE_GPU_ZONE( ac_pcName ) \
+    MyFirstEngine::Profiler::GPUZone \
+        PROFILER__H__JOIN( oProfileGPUZone, __LINE__ )( ac_pcName )
+#define PROFILE_COUNT( e_Counter, a_uiAmount ) \
+    MyFirstEngine::Profiler::Count( MyFirstEngine::Profiler::e_Counter, \
+                                    a_uiAmount )
+#define PROFILE_END_FRAME() MyFirstEngine::Profiler::EndFrame()
+#else
+#define PROFILE_ZONE( ac_pcName )
+#define PROFILE_GPU_ZONE( ac_pcName )
+#define PROFILE_COUNT( e_Counter, a_uiAmount )
+#define PROFILE_END_FRAME()
+#endif
+
+namespace MyFirstEngine
+{
+
+// Records how long named zones of code take, on the CPU and (through timer
+// queries) on the GPU, along with per-frame counts of expensive operations.
+// Each thread records into its own ring buffer, which only that thread writes
+// to, so recording never takes a lock.  Once a ring fills up, the oldest
+// events are overwritten.
+class IMEXPORT_CLASS Profiler
+{
+public:
+
+    // Things counted each frame
+    enum Counter
+    {
+        DRAW_CALLS = 0,
+        UNIFORM_UPLOADS,
+        TEXTURE_BINDS,
+        BUFFER_STALLS,
+        CULLED_OBJECTS,
+
+        COUNTER_COUNT
+    };
+
+    // A finished zone.  Times are in seconds since GLFW was initialized.
+    struct Event
+    {
+        const char* pcName;     // should be a string literal
+        double dStart;
+        double dEnd;
+        double dChildTime;      // total time spent in directly nested zones
+        unsigned int uiDepth;   // number of zones this one is nested inside
+        unsigned int uiThread;  // index of the recording thread
+        bool bGPU;              // timed on the GPU instead of the CPU
+    };
+
+    // Totals for all the events with the same name
+    struct ZoneStats
+    {
+        const char* pcName;
+        unsigned int uiCalls;
+        double dTotalTime;      // including nested zones
+        double dSelfTime;       // excluding nested zones
+        double dMinTime;
+        double dMaxTime;
+    };
+
+    // Counter values for a finished frame
+    struct FrameStats
+    {
+        double dStart;
+        double dEnd;
+        unsigned int auiCounters[ COUNTER_COUNT ];
+    };
+
+    // Fixed-size buffer of events that overwrites the oldest event once full.
+    // Only one thread should push to a given ring.
+    class IMEXPORT_CLASS EventRing : public Utility::NotCopyable
+    {
+    public:
+
+        // Capacity is rounded up to a power of two
+        EventRing( unsigned int a_uiCapacity = DEFAULT_CAPACITY );
+        virtual ~EventRing();
+
+        // Add an event, overwriting the oldest if the ring is full
+        void Push( const Event& ac_roEvent );
+
+        // Events currently held, with index 0 being the oldest
+        unsigned int Size() const;
+        const Event& operator[]( unsigned int a_uiIndex ) const;
+
+        // How many events have been overwritten since the ring was cleared
+        unsigned long long Dropped() const;
+
+        unsigned int Capacity() const { return m_uiMask + 1; }
+        void Clear() { m_ulPushed = 0; }
+
+        static const unsigned int DEFAULT_CAPACITY = 16384;
+
+    private:
+
+        Event* m_paoEvents;
+        unsigned int m_uiMask;              // capacity - 1
+        volatile unsigned long long m_ulPushed; // total pushes since clear
+
+    };  // class EventRing
+
+    // Times a CPU zone from construction to destruction
+    class IMEXPORT_CLASS Zone : public Utility::NotCopyable
+    {
+    public:
+        Zone( const char* ac_pcName );
+        virtual ~Zone();
+    private:
+        const char* m_pcName;   // null if not recording
+        double m_dStart;
+    };
+
+    // Times a GPU zone from construction to destruction with a pair of
+    // timestamp queries.  Does nothing without timer query support.  Results
+    // are collected by EndFrame once the GPU has caught up.
+    class IMEXPORT_CLASS GPUZone : public Utility::NotCopyable
+    {
+    public:
+        GPUZone( const char* ac_pcName );
+        virtual ~GPUZone();
+    private:
+        const char* m_pcName;   // null if not recording
+        GLuint m_auiQueries[2];
+    };
+
+    // Turn recording on or off at runtime.  On by default.
+    static void SetEnabled( bool a_bEnabled );
+    static bool IsEnabled();
+
+    // Add to one of this frame's counters
+    static void Count( Counter a_eCounter, unsigned int a_uiAmount = 1 );
+
+    // Current frame's value for a counter
+    static unsigned int CounterValue( Counter a_eCounter );
+
+    // Collect finished GPU zones, store this frame's counters, and start a new
+    // frame
+    static void EndFrame();
+
+    // Most recently finished frame
+    static const FrameStats& LastFrame();
+
+    // The ring the calling thread records into
+    static EventRing& ThreadEvents();
+
+    // Sum up events by name.  Returns the number of entries written, which is
+    // at most a_uiMaxStats - any names beyond that are left out.
+    static unsigned int Aggregate( const EventRing& ac_roEvents,
+                                   ZoneStats* a_paoStats,
+                                   unsigned int a_uiMaxStats );
+
+    // Write everything recorded so far, from all threads, as a JSON file that
+    // chrome://tracing can open.  Call while no other thread is recording.
+    static bool WriteChromeTrace( const char* ac_pcFileName );
+
+    // Forget everything recorded so far
+    static void Clear();
+
+    // Current time for profiling purposes, in seconds
+    static double Now();
+
+    // How deeply zones can nest before the inner ones are ignored
+    static const unsigned int MAX_DEPTH = 64;
+
+    // How many finished frames are kept for the trace file
+    static const unsigned int FRAME_HISTORY = 1024;
+
+private:
+
+    // Static-only class
+    Profiler();
+
+};  // class Profiler
+
+}   // namespace MyFirstEngine
+
+#endif  // PROFILER__H
@@ -0,0 +1,158 @@
+/******************************************************************************
+ * File:               ProgramBinaryCache.h
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Stores linked shader program binaries on disk so that
+ *                       later runs can skip compiling and linking.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Creation.
+ ******************************************************************************/
+
+#ifndef PROGRAM_BINARY_CACHE__H
+#define PROGRAM_BINARY_CACHE__H
+
+#include "GLFW.h"
+#include "MathLibrary.h"
+#include <cstddef>  // for size_t
+#include "MyFirstEngineMacros.h"
+
+namespace MyFirstEngine
+{
+
+using namespace Utility;
+
+// Saves the binaries of successfully linked shader programs to files named for
+// a hash of the driver identity and the program's shader sources, and loads
+// them back in place of linking.  Any entry that can't be used - truncated,
+// corrupt, written for another key, or rejected by the driver - is deleted and
+// the caller falls back to compiling from source.
+//
+// All GL calls go through a Backend object, so the keying and file handling can
+// be exercised without a GL context by passing in a fake backend.
+class IMEXPORT_CLASS ProgramBinaryCache : public NotCopyable
+{
+public:
+
+    // 64-bit hash identifying a cache entry.  Zero means "no key".
+    typedef unsigned long long Key;
+
+    // The GL calls the cache depends on
+    class IMEXPORT_CLASS Backend
+    {
+    public:
+
+        virtual ~Backend() {}
+
+        // Can program binaries be retrieved and loaded at all?
+        virtual bool IsSupported() const = 0;
+
+        // Text identifying the driver, since binaries from one driver (or
+        // driver version) can't be used by another
+        virtual DumbString DriverIdentity() const = 0;
+
+        // Ask for the binary to be kept retrievable - call before linking
+        virtual void PrepareToStore( GLuint a_uiProgram ) const = 0;
+
+        // Get the size of a linked program's binary, then the binary itself.
+        // GetBinary returns false if it couldn't fill the whole buffer.
+        virtual std::size_t BinarySize( GLuint a_uiProgram ) const = 0;
+        virtual bool GetBinary( GLuint a_uiProgram, GLenum& a_reFormat,
+                                char* a_pcData, std::size_t a_uiSize ) const = 0;
+
+        // Give a program a binary, returning true if the program is linked
+        // afterwards
+        virtual bool LoadBinary( GLuint a_uiProgram, GLenum a_eFormat,
+                                 const char* ac_pcData,
+                                 std::size_t a_uiSize ) const = 0;
+
+    };  // class Backend
+
+    // Constructor - the directory name should end with a separator.  If the
+    // directory name is null or empty, the cache is disabled.
+    ProgramBinaryCache( const char* ac_pcDirectory = DEFAULT_DIRECTORY,
+                        const Backend& ac_roBackend = GLBackend() );
+
+    // Destructor
+    virtual ~ProgramBinaryCache() {}
+
+    // Is the cache usable?  False if there's no directory or the driver can't
+    // hand over program binaries.  Requires a GL context the first time.
+    bool IsEnabled() const;
+
+    // Combine the driver identity with the source hashes of a program's shaders
+    // into a cache key.  Returns zero if the cache is disabled or any of the
+    // source hashes is zero (unknown).
+    Key MakeKey( const Key* ac_paulSourceHashes, unsigned int a_uiCount ) const;
+
+    // Try to load the cached binary for the given key into a program.  Returns
+    // false if there is no usable entry, in which case the program should be
+    // compiled and linked from source.
+    bool Load( Key a_ulKey, GLuint a_uiProgram );
+
+    // Ask for a program about to be linked from source to keep its binary
+    // retrievable
+    void PrepareToStore( GLuint a_uiProgram ) const;
+
+    // Write the binary of a successfully linked program to the cache
+    bool Store( Key a_ulKey, GLuint a_uiProgram );
+
+    // Delete the cache entry for a key, if there is one
+    void Invalidate( Key a_ulKey ) const;
+
+    // Get the name of the file holding the entry for a key
+    DumbString FileName( Key a_ulKey ) const;
+
+    // Cache properties
+    const DumbString& Directory() const { return m_oDirectory; }
+    unsigned int Hits() const { return m_uiHits; }
+    unsigned int Misses() const { return m_uiMisses; }
+    unsigned int Rejections() const { return m_uiRejections; }
+
+    // 64-bit FNV-1a hash, which can be chained by passing in a previous result
+    static Key HashBytes( const void* ac_pData, std::size_t a_uiSize,
+                          Key a_ulBasis = HASH_BASIS );
+
+    // Backend that makes the real GL calls
+    static const Backend& GLBackend();
+
+    // The cache used by ShaderProgram::Setup().  Set to null to disable binary
+    // caching; the default writes to DEFAULT_DIRECTORY.
+    static ProgramBinaryCache* Current();
+    static void SetCurrent( ProgramBinaryCache* a_poCache );
+
+    // Cache files go here unless told otherwise
+    static const char* const DEFAULT_DIRECTORY;
+
+    // FNV-1a offset basis
+    static const Key HASH_BASIS = 14695981039346656037ULL;
+
+    // Files larger than this are treated as corrupt
+    static const std::size_t MAX_BINARY_SIZE = 64 * 1024 * 1024;
+
+private:
+
+    // Read a cache file, returning false if anything about it is off
+    bool ReadEntry( Key a_ulKey, GLenum& a_reFormat,
+                    DynamicArray< char >& a_roData ) const;
+
+    // Where cache files go
+    DumbString m_oDirectory;
+
+    // How to talk to the driver
+    const Backend* m_poBackend;
+
+    // Driver support and identity are looked up the first time they're needed,
+    // since they require a GL context
+    mutable int m_iSupported;   // -1 for not yet checked
+    mutable Key m_ulDriverHash;
+
+    // Counters, mostly for checking that the cache does its job
+    unsigned int m_uiHits;
+    unsigned int m_uiMisses;
+    unsigned int m_uiRejections;
+
+};  // class ProgramBinaryCache
+
+}   // namespace MyFirstEngine
+
+#endif  // PROGRAM_BINARY_CACHE__H
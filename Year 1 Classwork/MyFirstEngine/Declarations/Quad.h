@@ -3,8 +3,8 @@
  * Author:             Elizabeth Lowry
  * Date Created:       February 13, 2014
  * Description:        Class representing an untextured rectangle.
- * Last Modified:      March 12, 2014
- * Last Modification:  Debugging.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Added bounds for culling.
  ******************************************************************************/
 
 #ifndef QUAD__H
@@ -89,6 +89,15 @@ public:
         return *this;
     }
 
+    // Quads are drawn as a unit square in the XY plane, centered on the origin
+    virtual bool GetLocalBounds( Space::BoundingBox& a_roBounds ) const override
+    {
+        const Space::BoundingBox UNIT_SQUARE = { { -0.5, -0.5, 0.0 },
+                                                 { 0.5, 0.5, 0.0 } };
+        a_roBounds = UNIT_SQUARE;
+        return true;
+    }
+
 protected:
 
     // Draw the four corners
@@ -3,14 +3,15 @@
  * Author:             Elizabeth Lowry
  * Date Created:       February 26, 2014
  * Description:        Shader program for Quad objects.
- * Last Modified:      February 27, 2014
- * Last Modification:  Overriding virtual functions added to parent class.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Named the number of uniforms set per quad.
  ******************************************************************************/
 
 #ifndef QUAD_SHADER_PROGRAM__H
 #define QUAD_SHADER_PROGRAM__H
 
 #include "MathLibrary.h"
+#include "Precision.h"
 #include "ShaderProgram.h"
 #include "MyFirstEngineMacros.h"
 
@@ -42,9 +43,17 @@ public:
     // For use by other shader programs that reuse this one's elements
     static void DrawElements();
 
-    // Draw a solid-color 1x1 quad at the origin of the XY plane (in model space)
+    // Draw a solid-color 1x1 quad at the origin of the XY plane (in model
+    // space).  If a RenderQueue is recording, the quad is added to it instead.
     static void DrawQuad( const Color::ColorVector& ac_roColor );
 
+    // Set the uniforms for drawing a quad, assuming this program is in use
+    static void SetUniforms( const GLTransform3D& ac_roModelViewProjection,
+                             const Math::Vector< float, 4 >& ac_roColor );
+
+    // How many uniforms SetUniforms sets for each quad
+    static const unsigned int UNIFORM_COUNT = 2;
+
     // default quad shader source code files
     static const char* const QUAD_VERTEX_SHADER_FILE;
     static const char* const QUAD_FRAGMENT_SHADER_FILE;
@@ -59,9 +68,9 @@ protected:
     // only the parent class's Initialize function can call this.
     QuadShaderProgram();
 
-    // Instance initialization/termination calls Setup()/Destroy() before
-    // constructor/destructor
-    virtual void InitializeInstance() override { Setup(); }
+    // Instance initialization/termination calls StartSetup()/Destroy() before
+    // constructor/destructor.  Setup is finished by FinishAllSetups().
+    virtual void InitializeInstance() override { StartSetup(); }
     virtual void TerminateInstance() override { Destroy(); }
 
     // manage the buffers, vertex array, and color uniform variable
@@ -0,0 +1,255 @@
+/******************************************************************************
+ * File:               RenderQueue.h
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Deferred draw queue that sorts draws by layer, depth,
+ *                      shader program, and texture before submitting them.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Batches keep overlapping draws in order.
+ ******************************************************************************/
+
+#ifndef RENDER_QUEUE__H
+#define RENDER_QUEUE__H
+
+#include "MathLibrary.h"
+#include "Precision.h"
+#include "Texture.h"
+#include "MyFirstEngineMacros.h"
+
+namespace MyFirstEngine
+{
+
+using namespace Utility;
+
+// While a queue is recording, QuadShaderProgram::DrawQuad and
+// SpriteShaderProgram::DrawSprite add draws to it instead of drawing right
+// away.  Flushing the queue sorts the draws by a 64-bit key and submits them,
+// only switching shader program or texture when the next draw actually needs a
+// different one:
+//
+//   oQueue.Begin();
+//   oBackground.Draw();
+//   oQueue.SetLayer( 1 );
+//   oHUD.Draw();
+//   oQueue.Flush();
+//
+// There's no depth buffer, so draws are ordered the way a painter would order
+// them - by layer, then back to front by depth.  Draws with the same layer and
+// depth are split into batches in the order they were added: a draw starts a
+// new batch if it's translucent or if its bounds overlap anything already in
+// the open batch.  Batches are drawn in order, and only the draws within a
+// batch are reordered to group shader programs and textures.  Since those
+// draws can't overlap each other, the picture comes out the same as drawing
+// everything in the order it was added.
+//
+// All GL calls go through a Backend object, so the sorting and state tracking
+// can be checked without a GL context by flushing to a Recorder.
+class IMEXPORT_CLASS RenderQueue : public NotCopyable
+{
+public:
+
+    // Sort key.  From most to least significant: 8 bits of layer, 24 bits of
+    // depth, 16 bits of batch, 4 bits of shader program, and 12 bits of
+    // texture.  Draws past the last batch all share it, with the program and
+    // texture bits left zero, so they keep the order they were added in.
+    typedef unsigned long long Key;
+
+    // Shader programs the queue knows how to draw with
+    enum Program
+    {
+        QUAD_PROGRAM = 0,
+        SPRITE_PROGRAM,
+
+        PROGRAM_COUNT
+    };
+
+    // Everything needed to make one draw later
+    struct Command
+    {
+        Key ulKey;
+        Program eProgram;
+        Texture* poTexture;     // null for quads
+        GLTransform3D oModelViewProjection;
+        GLTransform2D oTexTransform;
+        GLVector2D oOffsetUV;
+        GLVector2D oSizeUV;
+        Math::Vector< float, 4 > oColor;
+    };
+
+    // The GL calls made by Flush
+    class IMEXPORT_CLASS Backend
+    {
+    public:
+
+        virtual ~Backend() {}
+
+        // Start using a shader program
+        virtual void UseProgram( Program a_eProgram ) = 0;
+
+        // Bind a texture for the sprite program
+        virtual void BindTexture( Texture& a_roTexture ) = 0;
+
+        // Set the uniforms for a command and draw it, assuming its program and
+        // texture are already current
+        virtual void Draw( const Command& ac_roCommand ) = 0;
+
+        // Called before the first and after the last submission of a flush
+        virtual void BeginSubmit() {}
+        virtual void EndSubmit() {}
+
+    };  // class Backend
+
+    // Backend that makes no GL calls, only keeping a list of what it was asked
+    // to do
+    class IMEXPORT_CLASS Recorder : public Backend
+    {
+    public:
+
+        // What was asked of the backend
+        enum Action
+        {
+            USE_PROGRAM = 0,
+            BIND_TEXTURE,
+            DRAW
+        };
+        struct Submission
+        {
+            Action eAction;
+            Program eProgram;
+            Texture* poTexture;
+            Key ulKey;  // zero unless eAction is DRAW
+        };
+
+        Recorder();
+        virtual ~Recorder();
+
+        virtual void UseProgram( Program a_eProgram ) override;
+        virtual void BindTexture( Texture& a_roTexture ) override;
+        virtual void Draw( const Command& ac_roCommand ) override;
+
+        // Submissions recorded so far, oldest first
+        unsigned int Size() const;
+        const Submission& operator[]( unsigned int a_uiIndex ) const;
+        void Clear();
+
+    private:
+
+        // PIMPLE idiom - this class is only defined in the cpp, so inheritance
+        // from an stl container won't result in warnings.
+        class SubmissionList;
+        SubmissionList* m_poSubmissions;
+
+    };  // class Recorder
+
+    // How many state changes the last flush made, and how many it would have
+    // made drawing in the order the draws were added
+    struct Stats
+    {
+        unsigned int uiDraws;
+        unsigned int uiProgramChanges;
+        unsigned int uiTextureChanges;
+        unsigned int uiUnsortedProgramChanges;
+        unsigned int uiUnsortedTextureChanges;
+    };
+
+    // Constructor/destructor
+    RenderQueue();
+    virtual ~RenderQueue();
+
+    // Make this the queue draws are added to, until it's flushed
+    void Begin();
+
+    // Stop recording, sort the draws added since Begin, submit them through
+    // the given backend, and empty the queue.  With the GL backend, the shader
+    // program that was current before flushing is current again afterwards.
+    void Flush( Backend& a_roBackend = GLBackend() );
+
+    // Drop the draws added since Begin without submitting them
+    void Clear();
+
+    // Layer for the draws added from now on.  Higher layers are drawn later,
+    // on top of lower ones.  Reset to zero by Begin.
+    unsigned char GetLayer() const { return m_ucLayer; }
+    RenderQueue& SetLayer( unsigned char a_ucLayer );
+
+    // Add draws, with the depth taken from where the model-view-projection
+    // matrix puts the model's origin
+    void AddQuad( const GLTransform3D& ac_roModelViewProjection,
+                  const Color::ColorVector& ac_roColor );
+    void AddSprite( Texture& a_roTexture,
+                    const GLTransform3D& ac_roModelViewProjection,
+                    const Point2D& ac_roOffsetUV,
+                    const Point2D& ac_roSizeUV,
+                    const Transform2D& ac_roTexTransform,
+                    const Color::ColorVector& ac_roColor );
+
+    // Draws added since Begin, in the order they were added
+    unsigned int Size() const;
+    const Command& operator[]( unsigned int a_uiIndex ) const;
+
+    // Is this the queue draws are currently added to?
+    bool IsRecording() const { return this == Current(); }
+
+    // Results of the most recent flush
+    const Stats& LastFlush() const { return m_oLastFlush; }
+
+    // Build a sort key.  Depth is in normalized device coordinates, where -1
+    // is nearest and 1 is farthest, and is clamped to that range.
+    static Key MakeKey( unsigned char a_ucLayer, double a_dDepth,
+                        unsigned int a_uiBatch, Program a_eProgram,
+                        unsigned int a_uiTexture );
+
+    // Sort keys, carrying an index along with each, so that equal keys keep
+    // their original order.  The scratch array must be at least as long as
+    // the others.
+    static void Sort( Key* a_paulKeys, unsigned int* a_pauiIndices,
+                      Key* a_paulScratchKeys,
+                      unsigned int* a_pauiScratchIndices,
+                      unsigned int a_uiCount );
+
+    // Backend that makes the real GL calls
+    static Backend& GLBackend();
+
+    // The queue draws are currently added to, or null if draws should be made
+    // immediately
+    static RenderQueue* Current();
+
+private:
+
+    // Assign the texture a number for sorting, in the order textures are first
+    // seen, so the first texture drawn with is also the first one sorted
+    unsigned int TextureNumber( Texture& a_roTexture );
+
+    // Start a new batch for a draw unless it can join the open one without
+    // being reordered past anything it overlaps, and return its batch number
+    unsigned int Batch( const GLTransform3D& ac_roModelViewProjection,
+                        double a_dDepth, bool a_bTranslucent );
+
+    // Area of the screen covered, in normalized device coordinates
+    struct Bounds
+    {
+        double dLeft, dBottom, dRight, dTop;
+    };
+
+    // PIMPLE idiom - these classes are only defined in the cpp, so inheritance
+    // from stl containers won't result in warnings.
+    class CommandList;
+    class SortBuffer;
+    class TextureNumbers;
+    CommandList* m_poCommands;
+    SortBuffer* m_poSortBuffer;
+    TextureNumbers* m_poTextureNumbers;
+
+    unsigned char m_ucLayer;
+    Stats m_oLastFlush;
+
+    // The batch draws are currently added to
+    unsigned int m_uiBatch;
+    Key m_ulBatchPosition;  // layer and depth bits of the batch's sort key
+    Bounds m_oBatchBounds;  // covering every draw in the batch
+
+};  // class RenderQueue
+
+}   // namespace MyFirstEngine
+
+#endif  // RENDER_QUEUE__H
@@ -3,8 +3,9 @@
  * Author:             Elizabeth Lowry
  * Date Created:       February 13, 2014
  * Description:        Represents a GLSL shader.
- * Last Modified:      March 25, 2014
- * Last Modification:  Removing PIMPL static pointers from header.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Deferring compilation and hashing source for the
+ *                       program binary cache.
  ******************************************************************************/
 
 #ifndef SHADER__H
@@ -51,6 +52,12 @@ public:
     // Delete the shader
     void Delete();
 
+    // Compile the shader if its source has been loaded since it was last
+    // compiled.  Compiling is put off until a program actually needs the
+    // shader, so programs loaded from the binary cache never compile at all.
+    static void Compile( GLuint a_uiID );
+    void Compile() const { Compile( m_uiID ); }
+
     // Is this shader compiled and not marked for deletion?
     static bool IsValid( GLuint a_uiID );
     bool IsValid() const { return IsValid( m_uiID ); }
@@ -62,6 +69,10 @@ public:
     GLuint ID() const { return m_uiID; }
     GLenum Type() const;
 
+    // Hash of the shader type and source text, for keying cached program
+    // binaries.  Zero if the source is unknown.
+    unsigned long long SourceHash() const;
+
     // Get the info log
     DumbString GetLog() const;
 
@@ -3,8 +3,9 @@
  * Author:             Elizabeth Lowry
  * Date Created:       February 13, 2014
  * Description:        Represents a GLSL shader program.
- * Last Modified:      March 12, 2014
- * Last Modification:  Refactoring.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Loading programs from the binary cache and splitting
+ *                       setup so several programs can link at once.
  ******************************************************************************/
 
 #ifndef SHADER_PROGRAM__H
@@ -12,6 +13,7 @@
 
 #include "GLFW.h"
 #include "MathLibrary.h"
+#include "ProgramBinaryCache.h"
 #include "Shader.h"
 #include <list>
 
@@ -72,6 +74,9 @@ public:
     // destroy all shader programs
     static void DestroyAll();
 
+    // finish setting up any programs that have started but not finished
+    static void FinishAllSetups();
+
     // get a shader program representing no shader program
     static const ShaderProgram& Null();
 
@@ -84,7 +89,15 @@ protected:
     virtual void DestroyData() {}
 
     // Link, set up vertex arrays, etc.
-    void Setup();
+    void Setup() { StartSetup(); FinishSetup(); }
+
+    // Setup in two parts.  StartSetup loads the program from the binary cache
+    // or starts compiling and linking it, without waiting on the driver, so
+    // several programs can be started before any of them are finished.
+    // FinishSetup waits for the link result, stores the binary in the cache if
+    // it's new, and calls SetupData.
+    void StartSetup();
+    void FinishSetup();
 
     // Set up vertex arrays, get uniform variable locations, etc.
     virtual void SetupData() {}
@@ -108,9 +121,16 @@ private:
     ShaderList& Shaders() { return *m_poShaders; }
     const ShaderList& Shaders() const { return *m_poShaders; }
 
+    // Get the binary cache key for this program's shaders
+    ProgramBinaryCache::Key CacheKey( const ProgramBinaryCache& ac_roCache ) const;
+
     unsigned int m_uiIndex; // location of shader program in list
     ShaderList* m_poShaders; // owned by this object
 
+    bool m_bSetupStarted;   // started but not finished
+    bool m_bFromCache;      // loaded from a cached binary instead of linked
+    ProgramBinaryCache::Key m_ulCacheKey;  // zero if not cacheable
+
 };  // class ShaderProgram
 
 }   // namespace MyFirstEngine
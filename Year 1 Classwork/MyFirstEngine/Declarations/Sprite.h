@@ -3,8 +3,8 @@
  * Author:             Elizabeth Lowry
  * Date Created:       February 27, 2014
  * Description:        Class representing an textured rectangle, or sprite.
- * Last Modified:      March 13, 2014
- * Last Modification:  Debugging.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Added HasTexture.
  ******************************************************************************/
 
 #ifndef SPRITE__H
@@ -77,8 +77,10 @@ public:
     { return ( nullptr == m_pcoFrameList ? 0 : m_pcoFrameList->Size() ); }
     const Frame::Array& FrameList() const;
     const Frame& CurrentFrame() const;
-    Sprite& SetFrameNumber( unsigned int a_uiFrameNumber = 0 );
-    Sprite& SetFrameList( const Frame::Array& ac_roFrameList = Frame::Array::EMPTY );
+    virtual Sprite& SetFrameNumber( unsigned int a_uiFrameNumber = 0 );
+    virtual Sprite& SetFrameList( const Frame::Array& ac_roFrameList =
+                                      Frame::Array::EMPTY );
+    bool HasTexture() const { return nullptr != m_poTexture; }
     Texture& GetTexture() const { return *m_poTexture; }
     Sprite& SetTexture( Texture& a_roTexture );
 
@@ -0,0 +1,217 @@
+/******************************************************************************
+ * File:               SpriteBatch.h
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Collects sprites and draws all the ones sharing a
+ *                      texture with a single instanced draw call.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Creation.
+ ******************************************************************************/
+
+#ifndef SPRITE_BATCH__H
+#define SPRITE_BATCH__H
+
+#include "Frame.h"
+#include "MathLibrary.h"
+#include "Precision.h"
+#include "Sprite.h"
+#include "Texture.h"
+#include "MyFirstEngineMacros.h"
+
+namespace MyFirstEngine
+{
+
+using namespace Utility;
+
+// Drawing a sprite normally sets eight uniforms and makes one draw call.  A
+// sprite batch instead keeps a table of frame descriptors - each frame's
+// texture transform, slice UVs, and clamping - and reduces each sprite to an
+// instance holding its transform, color, and an index into that table.
+// Flushing the batch uploads the table once and draws every sprite sharing a
+// texture with one instanced draw call:
+//
+//   oBatch.Begin();
+//   for each( const Sprite& oSprite in aoSprites )
+//   {
+//       oBatch.Add( oSprite );
+//   }
+//   oBatch.Flush();
+//
+// Sprites are grouped by texture, with textures drawn in the order they were
+// first added and sprites with the same texture drawn in the order they were
+// added.  There's no depth buffer, so sprites with different textures that
+// overlap should go in different batches, or the batch should be flushed
+// between them.
+//
+// Transforms are taken from the matrix stacks when a sprite is added, so the
+// camera can change before the batch is flushed without affecting it.  All GL
+// calls go through a Backend object, so the packing can be checked without a
+// GL context by flushing to a Recorder.
+class IMEXPORT_CLASS SpriteBatch : public NotCopyable
+{
+public:
+
+    // One entry in the frame table, laid out as three vec4s for the shader.
+    // The texture transform is split into the two rows the shader dots with
+    // ( s, t, 1 ), with each row's clamp flag in the last element.
+    struct FrameDescriptor
+    {
+        float afTexTransformS[4];   // s row, then 1 if clamping in s
+        float afTexTransformT[4];   // t row, then 1 if clamping in t
+        float afSliceUV[4];         // offset u, offset v, size u, size v
+    };
+
+    // Everything that differs between sprites drawn together
+    struct Instance
+    {
+        float afModelViewProjection[16];    // row-major, like the matrices
+        Color::PackedColor oColor;
+        unsigned int uiFrame;               // index into the frame table
+    };
+
+    // The GL calls made by Flush
+    class IMEXPORT_CLASS Backend
+    {
+    public:
+
+        virtual ~Backend() {}
+
+        // Replace the frame table
+        virtual void UploadFrames( const FrameDescriptor* ac_paoFrames,
+                                   unsigned int a_uiCount ) = 0;
+
+        // Draw a run of instances that all use the given texture
+        virtual void DrawInstances( Texture& a_roTexture,
+                                    const Instance* ac_paoInstances,
+                                    unsigned int a_uiCount ) = 0;
+
+        // Called before the first and after the last submission of a flush
+        virtual void BeginSubmit() {}
+        virtual void EndSubmit() {}
+
+    };  // class Backend
+
+    // Backend that makes no GL calls, only keeping a copy of what it was
+    // asked to upload and draw
+    class IMEXPORT_CLASS Recorder : public Backend
+    {
+    public:
+
+        // One call to DrawInstances
+        struct Draw
+        {
+            Texture* poTexture;
+            unsigned int uiFirst;   // index of the first instance recorded
+            unsigned int uiCount;
+        };
+
+        Recorder();
+        virtual ~Recorder();
+
+        virtual void UploadFrames( const FrameDescriptor* ac_paoFrames,
+                                   unsigned int a_uiCount ) override;
+        virtual void DrawInstances( Texture& a_roTexture,
+                                    const Instance* ac_paoInstances,
+                                    unsigned int a_uiCount ) override;
+
+        // The most recently uploaded frame table
+        unsigned int FrameCount() const;
+        const FrameDescriptor& GetFrame( unsigned int a_uiIndex ) const;
+        unsigned int Uploads() const { return m_uiUploads; }
+
+        // Draws recorded so far, oldest first, and the instances they drew
+        unsigned int DrawCount() const;
+        const Draw& GetDraw( unsigned int a_uiIndex ) const;
+        unsigned int InstanceCount() const;
+        const Instance& GetInstance( unsigned int a_uiIndex ) const;
+
+        void Clear();
+
+    private:
+
+        // PIMPLE idiom - these classes are only defined in the cpp, so
+        // inheritance from stl containers won't result in warnings.
+        class FrameList;
+        class DrawList;
+        class InstanceList;
+        FrameList* m_poFrames;
+        DrawList* m_poDraws;
+        InstanceList* m_poInstances;
+        unsigned int m_uiUploads;
+
+    };  // class Recorder
+
+    // What the last flush did
+    struct Stats
+    {
+        unsigned int uiInstances;
+        unsigned int uiDraws;
+        unsigned int uiFrames;      // entries in the frame table
+    };
+
+    // Constructor/destructor
+    SpriteBatch();
+    virtual ~SpriteBatch();
+
+    // Empty the batch and start adding sprites
+    void Begin() { Clear(); }
+
+    // Add a sprite, with its transform taken from the current matrix stacks.
+    // Does nothing if the sprite wouldn't be drawn.
+    void Add( const Sprite& ac_roSprite );
+
+    // Add a frame of a frame list (or the whole texture, if the list is empty)
+    // with the given transform
+    void Add( Texture& a_roTexture, const Frame::Array& ac_roFrameList,
+              unsigned int a_uiFrameNumber,
+              const GLTransform3D& ac_roModelViewProjection,
+              const Color::ColorVector& ac_roColor );
+
+    // Group the instances added since Begin by texture, submit them through
+    // the given backend, and empty the batch.  With the GL backend, the shader
+    // program that was current before flushing is current again afterwards.
+    void Flush( Backend& a_roBackend = GLBackend() );
+
+    // Drop everything added since Begin without drawing it
+    void Clear();
+
+    // Instances added since Begin, in the order they were added
+    unsigned int Size() const;
+    const Instance& operator[]( unsigned int a_uiIndex ) const;
+    Texture& GetTexture( unsigned int a_uiIndex ) const;
+
+    // Frame table built from the sprites added since Begin
+    unsigned int FrameCount() const;
+    const FrameDescriptor& GetFrame( unsigned int a_uiIndex ) const;
+
+    // Results of the most recent flush
+    const Stats& LastFlush() const { return m_oLastFlush; }
+
+    // Work out a frame's descriptor for a given texture
+    static FrameDescriptor Describe( const Frame& ac_roFrame,
+                                     const Texture& ac_roTexture );
+
+    // Backend that makes the real GL calls
+    static Backend& GLBackend();
+
+private:
+
+    // Index of the first of a frame list's descriptors for a given texture,
+    // adding them to the table if they aren't there yet
+    unsigned int FirstFrame( Texture& a_roTexture,
+                             const Frame::Array& ac_roFrameList );
+
+    // PIMPLE idiom - these classes are only defined in the cpp, so inheritance
+    // from stl containers won't result in warnings.
+    class InstanceList;
+    class FrameTable;
+    InstanceList* m_poInstances;
+    FrameTable* m_poFrames;
+
+    Stats m_oLastFlush;
+
+};  // class SpriteBatch
+
+}   // namespace MyFirstEngine
+
+#endif  // SPRITE_BATCH__H
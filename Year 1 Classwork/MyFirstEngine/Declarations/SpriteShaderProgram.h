@@ -3,14 +3,15 @@
  * Author:             Elizabeth Lowry
  * Date Created:       March 12, 2014
  * Description:        Shader program for Sprite objects.
- * Last Modified:      March 17, 2014
- * Last Modification:  Debugging.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Named the number of uniforms set per sprite.
  ******************************************************************************/
 
 #ifndef SPRITE_SHADER_PROGRAM__H
 #define SPRITE_SHADER_PROGRAM__H
 
 #include "MathLibrary.h"
+#include "Precision.h"
 #include "ShaderProgram.h"
 #include "Texture.h"
 #include "MyFirstEngineMacros.h"
@@ -38,7 +39,8 @@ public:
         BindTexCoordinateBuffer( const ShaderProgram& ac_roProgram,
                                  const char* ac_pcTexCoordinateAttributeName );
     
-    // Draw a textured 1x1 quad at the origin of the XY plane (in model space)
+    // Draw a textured 1x1 quad at the origin of the XY plane (in model space).
+    // If a RenderQueue is recording, the sprite is added to it instead.
     static void
         DrawSprite( Texture& a_roTexture,
                     const Point2D& ac_roOffsetUV,
@@ -46,6 +48,18 @@ public:
                     const Transform2D& ac_roTexTransform = Transform2D::Identity(),
                     const Color::ColorVector& ac_roColor = Color::WHITE );
 
+    // Set the uniforms for drawing a sprite, assuming this program is in use
+    // and the texture is bound
+    static void SetUniforms( const Texture& ac_roTexture,
+                             const GLTransform3D& ac_roModelViewProjection,
+                             const GLVector2D& ac_roOffsetUV,
+                             const GLVector2D& ac_roSizeUV,
+                             const GLTransform2D& ac_roTexTransform,
+                             const Math::Vector< float, 4 >& ac_roColor );
+
+    // How many uniforms SetUniforms sets for each sprite
+    static const unsigned int UNIFORM_COUNT = 8;
+
     // default sprite shader source code files
     static const char* const SPRITE_VERTEX_SHADER_FILE;
     static const char* const SPRITE_FRAGMENT_SHADER_FILE;
@@ -61,9 +75,9 @@ protected:
     // only the parent class's Initialize function can call this.
     SpriteShaderProgram();
 
-    // Instance initialization/termination calls Setup()/Destroy() before
-    // constructor/destructor
-    virtual void InitializeInstance() override { Setup(); }
+    // Instance initialization/termination calls StartSetup()/Destroy() before
+    // constructor/destructor.  Setup is finished by FinishAllSetups().
+    virtual void InitializeInstance() override { StartSetup(); }
     virtual void TerminateInstance() override { Destroy(); }
 
     // manage the buffers, vertex array, and color uniform variable
@@ -0,0 +1,243 @@
+/******************************************************************************
+ * File:               StreamBuffer.h
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Ring buffer for vertex and instance data that changes
+ *                      every frame.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Added a check for the room left in a region.
+ ******************************************************************************/
+
+#ifndef STREAM_BUFFER__H
+#define STREAM_BUFFER__H
+
+#include "GLFW.h"
+#include "MathLibrary.h"
+#include "MyFirstEngineMacros.h"
+
+namespace MyFirstEngine
+{
+
+using namespace Utility;
+
+// A GL buffer split into several equal regions, one per frame in flight.  Each
+// frame, data is written into the next region, and a fence is placed once the
+// frame's draws have been issued.  Before a region is written to again, the
+// buffer waits for that region's fence, so the CPU never overwrites data the
+// GPU hasn't finished reading.
+//
+//   oStream.BeginFrame();
+//   StreamBuffer::Allocation oVertices = oStream.Allocate( uiBytes, 16 );
+//   ... write uiBytes of data to oVertices.pData ...
+//   oStream.Submit();
+//   ... draw using data at offset oVertices.uiOffset in oStream.ID() ...
+//   oStream.EndFrame();
+//
+// Where the context supports it (GL 4.4 or ARB_buffer_storage), the whole
+// buffer stays persistently mapped and Allocate hands out pointers straight
+// into it.  Otherwise, Allocate hands out pointers into a CPU-side copy of one
+// region, Submit uploads what's been written since the last Submit, and each
+// frame orphans the buffer instead of waiting on fences.
+//
+// All GL calls go through a Backend object, so the fence and region recycling
+// can be checked without a GL context against a SimulatedBackend.
+class IMEXPORT_CLASS StreamBuffer : public NotCopyable
+{
+public:
+
+    // Handle for a fence.  Zero means "no fence".
+    typedef unsigned long long Fence;
+
+    // The GL calls the stream buffer depends on
+    class IMEXPORT_CLASS Backend
+    {
+    public:
+
+        virtual ~Backend() {}
+
+        // Can buffers be persistently mapped?
+        virtual bool SupportsPersistentMapping() const = 0;
+
+        // Create a buffer.  If persistent, it's mapped for writing and the
+        // pointer is returned through a_rpMapped.
+        virtual GLuint CreateBuffer( GLenum a_eTarget, unsigned int a_uiSize,
+                                     bool a_bPersistent,
+                                     void*& a_rpMapped ) = 0;
+        virtual void DestroyBuffer( GLenum a_eTarget, GLuint a_uiBuffer,
+                                    bool a_bPersistent ) = 0;
+
+        // For buffers that aren't persistently mapped - give the buffer new
+        // storage, or copy data into it
+        virtual void Orphan( GLenum a_eTarget, GLuint a_uiBuffer,
+                             unsigned int a_uiSize ) = 0;
+        virtual void Upload( GLenum a_eTarget, GLuint a_uiBuffer,
+                             unsigned int a_uiOffset, unsigned int a_uiSize,
+                             const void* ac_pData ) = 0;
+
+        // Place a fence after all the commands issued so far, check whether
+        // the GPU has passed it without waiting, wait until it has, or delete
+        // it
+        virtual Fence InsertFence() = 0;
+        virtual bool IsSignaled( Fence a_ulFence ) = 0;
+        virtual void WaitFor( Fence a_ulFence ) = 0;
+        virtual void DeleteFence( Fence a_ulFence ) = 0;
+
+    };  // class Backend
+
+    // Backend that makes no GL calls.  Buffers are plain memory, and the GPU
+    // is a timeline of fences that only passes them when told to, so tests can
+    // decide exactly how far behind the CPU the GPU is.
+    class IMEXPORT_CLASS SimulatedBackend : public Backend
+    {
+    public:
+
+        SimulatedBackend( bool a_bPersistent = true );
+        virtual ~SimulatedBackend();
+
+        virtual bool SupportsPersistentMapping() const override
+        { return m_bPersistent; }
+        virtual GLuint CreateBuffer( GLenum a_eTarget, unsigned int a_uiSize,
+                                     bool a_bPersistent,
+                                     void*& a_rpMapped ) override;
+        virtual void DestroyBuffer( GLenum a_eTarget, GLuint a_uiBuffer,
+                                    bool a_bPersistent ) override;
+        virtual void Orphan( GLenum a_eTarget, GLuint a_uiBuffer,
+                             unsigned int a_uiSize ) override;
+        virtual void Upload( GLenum a_eTarget, GLuint a_uiBuffer,
+                             unsigned int a_uiOffset, unsigned int a_uiSize,
+                             const void* ac_pData ) override;
+        virtual Fence InsertFence() override;
+        virtual bool IsSignaled( Fence a_ulFence ) override;
+        virtual void WaitFor( Fence a_ulFence ) override;
+        virtual void DeleteFence( Fence a_ulFence ) override {}
+
+        // Let the GPU pass the given number of fences, or all of them
+        void Advance( unsigned int a_uiFences = 1 );
+        void Finish() { m_ulPassed = m_ulInserted; }
+
+        // Timeline state
+        Fence Inserted() const { return m_ulInserted; }
+        Fence Passed() const { return m_ulPassed; }
+        unsigned int Waits() const { return m_uiWaits; }
+        unsigned int Orphans() const { return m_uiOrphans; }
+        unsigned int Uploads() const { return m_uiUploads; }
+        unsigned int UploadedBytes() const { return m_uiUploadedBytes; }
+
+        // Contents of the simulated buffer
+        const unsigned char* Data() const { return m_paucData; }
+
+    private:
+
+        bool m_bPersistent;
+        unsigned char* m_paucData;
+        Fence m_ulInserted;     // fences are numbered in order from 1
+        Fence m_ulPassed;       // highest fence the GPU has passed
+        unsigned int m_uiWaits;
+        unsigned int m_uiOrphans;
+        unsigned int m_uiUploads;
+        unsigned int m_uiUploadedBytes;
+
+    };  // class SimulatedBackend
+
+    // Part of the buffer handed out for one frame's data.  If the region
+    // didn't have room, pData is null.
+    struct Allocation
+    {
+        void* pData;            // where to write the data
+        unsigned int uiOffset;  // where the data is in the buffer
+    };
+
+    // Counts for profiling
+    struct Stats
+    {
+        unsigned int uiFrames;
+        unsigned int uiStalls;          // waits on fences that hadn't passed
+        double dStallTime;              // seconds spent in those waits
+        unsigned int uiFailedAllocations;
+        unsigned int uiLastFrameBytes;  // allocated during the last frame
+        unsigned int uiPeakFrameBytes;  // most allocated during any frame
+    };
+
+    // Constructor - the buffer itself isn't created until the first frame
+    // begins, since that needs a GL context
+    StreamBuffer( unsigned int a_uiRegionSize,
+                  GLenum a_eTarget = GL_ARRAY_BUFFER,
+                  unsigned int a_uiRegions = DEFAULT_REGIONS,
+                  Backend& a_roBackend = GLBackend() );
+    virtual ~StreamBuffer();
+
+    // Start writing to the next region, waiting for the GPU to finish with it
+    // first if necessary
+    void BeginFrame();
+
+    // Get space in the current region.  Alignment must be a power of two.
+    Allocation Allocate( unsigned int a_uiSize,
+                         unsigned int a_uiAlignment = DEFAULT_ALIGNMENT );
+
+    // Largest allocation with the given alignment that would still fit in the
+    // current region
+    unsigned int Available( unsigned int a_uiAlignment =
+                                DEFAULT_ALIGNMENT ) const;
+
+    // Make everything allocated since the last Submit visible to the GPU.
+    // Does nothing for persistently mapped buffers.
+    void Submit();
+
+    // Submit, and fence off the current region once the frame's draws have
+    // been issued
+    void EndFrame();
+
+    // Delete the buffer and its fences
+    void Destroy();
+
+    // Properties
+    GLuint ID() const { return m_uiID; }
+    GLenum Target() const { return m_eTarget; }
+    bool IsPersistent() const { return m_bPersistent; }
+    unsigned int RegionSize() const { return m_uiRegionSize; }
+    unsigned int RegionCount() const { return m_uiRegions; }
+    unsigned int CurrentRegion() const { return m_uiRegion; }
+    unsigned int BytesUsed() const { return m_uiUsed; }
+    const Stats& GetStats() const { return m_oStats; }
+    void ResetStats();
+
+    // Backend that makes the real GL calls
+    static Backend& GLBackend();
+
+    // Triple buffering - one region being written, up to two being read
+    static const unsigned int DEFAULT_REGIONS = 3;
+
+    // Enough for any vertex attribute type
+    static const unsigned int DEFAULT_ALIGNMENT = 16;
+
+private:
+
+    // Create the buffer on first use
+    void Create();
+
+    // Where the next allocation with the given alignment would start
+    unsigned int AlignedStart( unsigned int a_uiAlignment ) const;
+
+    Backend* m_poBackend;
+    GLenum m_eTarget;
+    GLuint m_uiID;
+    bool m_bPersistent;
+
+    unsigned int m_uiRegionSize;
+    unsigned int m_uiRegions;
+    unsigned int m_uiRegion;        // region being written this frame
+    unsigned int m_uiUsed;          // bytes used in the current region
+    unsigned int m_uiSubmitted;     // bytes already made visible to the GPU
+    bool m_bInFrame;
+
+    unsigned char* m_paucMapped;    // whole buffer if persistent
+    unsigned char* m_paucStaging;   // one region if not
+    Fence* m_paulFences;            // one per region
+
+    Stats m_oStats;
+
+};  // class StreamBuffer
+
+}   // namespace MyFirstEngine
+
+#endif  // STREAM_BUFFER__H
@@ -3,8 +3,8 @@
  * Author:             Elizabeth Lowry
  * Date Created:       March 6, 2014
  * Description:        Class representing an texture.
- * Last Modified:      March 12, 2014
- * Last Modification:  Debugging.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Added pinning for texture residency budgets.
  ******************************************************************************/
 
 #ifndef TEXTURE__H
@@ -23,6 +23,7 @@ using Utility::DumbString;
 // represents a texture
 class IMEXPORT_CLASS Texture : public Utility::NotCopyable
 {
+    friend class TextureResidency;
 public:
     
     // TODO constructor parameters
@@ -46,6 +47,10 @@ public:
     const Frame& TextureFrame() const { return m_oFrame; }
 
     bool IsValid() const;   // is this a valid texture object in OpenGL?
+    bool UsesMipmaps() const;   // do the filters need mipmaps generated?
+
+    // Is every pixel fully opaque?  False until the texture has been loaded.
+    bool IsOpaque() const { return m_bOpaque; }
 
 #ifndef MY_FIRST_ENGINE_CACHE_TEXTURES
 #define TEXTURE__H__CACHE_TEXTURES false
@@ -57,6 +62,11 @@ public:
 #undef TEXTURE__H__CACHE_TEXTURES
     void MakeCurrent();     // bind this texture to GL_TEXTURE0
 
+    // Pinned textures are never unloaded to keep within TextureResidency's
+    // budgets, but can still be destroyed directly
+    void Pin( bool a_bPinned = true );
+    bool IsPinned() const { return m_bPinned; }
+
     static void DestroyAll();   // destroy all textures
 
 protected:
@@ -73,6 +83,9 @@ protected:
     // For no-frame sprites using this texture
     Frame m_oFrame;
 
+    bool m_bOpaque;     // no pixels with alpha below 255, checked on load
+    bool m_bPinned;     // never evicted by TextureResidency
+
     DumbString m_oFile;         // file from which this texture is loaded
     unsigned char* m_paucData;  // texture data cache
 
@@ -0,0 +1,93 @@
+/******************************************************************************
+ * File:               TextureResidency.h
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Keeps texture memory within a budget by unloading the
+ *                      least recently used textures.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Creation.
+ ******************************************************************************/
+
+#ifndef TEXTURE_RESIDENCY__H
+#define TEXTURE_RESIDENCY__H
+
+#include "MathLibrary.h"
+#include "MyFirstEngineMacros.h"
+
+namespace MyFirstEngine
+{
+
+// forward declare Texture
+class Texture;
+
+// Every texture ever constructed stays in the texture list, and once loaded,
+// keeps its GL object (and its CPU-side cache, if it has one) until it's
+// destroyed.  Given a budget, this keeps track of when each texture was last
+// made current, and once the loaded textures add up to more than the budget,
+// unloads the ones that have gone unused the longest:
+//
+//   TextureResidency::SetGPUBudget( 256 * 1024 * 1024 );
+//   TextureResidency::SetCacheBudget( 64 * 1024 * 1024 );
+//   oHUDTexture.Pin();
+//
+// GL objects and CPU-side caches have budgets of their own.  Evicting a GL
+// object destroys it, caching its data first if caching is on by default, so
+// the texture may end up with its cache, or nothing loaded at all.  Evicting
+// a cache throws it away.  Either way, the next time the texture is made
+// current it's loaded again - from its cache if it still has one, or else from
+// its file.  A texture with no file to load from always keeps its cache.
+//
+// Pinned textures are never evicted, and neither is the texture most recently
+// made current, even if it's bigger than the whole budget.  A budget of zero,
+// the default for both, means no limit.
+class IMEXPORT_CLASS TextureResidency
+{
+    friend class Texture;
+public:
+
+    typedef Utility::ResidencyList< Texture* >::Stats Stats;
+
+    // Change the budgets, in bytes, evicting textures if now over budget
+    static void SetGPUBudget( unsigned long long a_ulBytes );
+    static void SetCacheBudget( unsigned long long a_ulBytes );
+    static unsigned long long GPUBudget();
+    static unsigned long long CacheBudget();
+
+    // Bytes currently used by GL objects and by CPU-side caches
+    static unsigned long long GPUBytes();
+    static unsigned long long CacheBytes();
+
+    // A GL object hit is a texture made current while already loaded, and a
+    // miss is one that had to be loaded first.  A cache hit is a texture
+    // loaded from its cache, and a miss is one that had to be cached.
+    static const Stats& GPUStats();
+    static const Stats& CacheStats();
+    static void ResetStats();
+
+    // GL object size for a texture of the given size, with or without a third
+    // as much again for mipmaps, and the size of its cache
+    static unsigned long long GPUBytes( const Texture& ac_roTexture );
+    static unsigned long long CacheBytes( const Texture& ac_roTexture );
+
+private:
+
+    // Static-only class
+    TextureResidency();
+
+    // Called by Texture as it's used, loaded, cached, pinned, and destroyed
+    static void Used( Texture& a_roTexture );
+    static void Loaded( Texture& a_roTexture );
+    static void Unloaded( Texture& a_roTexture );
+    static void Cached( Texture& a_roTexture );
+    static void Uncached( Texture& a_roTexture );
+    static void Pinned( Texture& a_roTexture );
+
+    // Evict textures until within budget
+    static void EvictFromGPU();
+    static void EvictFromCache();
+
+};  // class TextureResidency
+
+}   // namespace MyFirstEngine
+
+#endif  // TEXTURE_RESIDENCY__H
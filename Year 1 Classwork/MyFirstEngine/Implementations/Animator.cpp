@@ -0,0 +1,641 @@
+/******************************************************************************
+ * File:               Animator.cpp
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Function implementations for the Animator class.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Creation.
+ ******************************************************************************/
+
+#include "../Declarations/AnimatedSprite.h"
+#include "../Declarations/Animator.h"
+#include "../Declarations/GameEngine.h"
+#include "../Declarations/Profiler.h"
+#include <vector>
+
+// Use SSE2 to work out two animations' elapsed time at once where the target
+// supports it
+#if defined _M_X64 || ( defined _M_IX86_FP && _M_IX86_FP >= 2 ) || \
+    defined __SSE2__
+#define ANIMATOR__SSE2
+#include <emmintrin.h>
+#endif
+
+namespace MyFirstEngine
+{
+
+// PIMPLE idiom - definitions are only in the cpp so the compiler won't complain
+// about the STL containers
+class Animator::Tracks
+{
+public:
+
+    virtual ~Tracks() {}
+
+    // Playback state, one entry per animation
+    std::vector< AnimatedSprite* > oOwners;
+    std::vector< double > oSeconds;     // total play time before last pause
+    std::vector< double > oUnpauseTimes;
+    std::vector< double > oFPS;         // 0.0 = increment frame on update
+    std::vector< unsigned int > oLoops; // 0 = infinite
+    std::vector< unsigned int > oCompletedLoops;
+    std::vector< unsigned int > oFrameCounts;   // copied from the sprites
+    std::vector< unsigned int > oFrameNumbers;  // copied from the sprites
+    std::vector< unsigned char > oPaused;
+    std::vector< Callback > oOnComplete;        // nullptr = do nothing
+    std::vector< Callback > oOnLoop;            // nullptr = do nothing
+
+    // Scratch space for UpdateAll
+    std::vector< double > oElapsedSeconds;
+    std::vector< double > oElapsedFrames;
+    std::vector< unsigned int > oChanged;
+
+    unsigned int Size() const { return oOwners.size(); }
+
+    bool IsCompleted( unsigned int a_ui ) const
+    {
+        return ( 0 == oFrameCounts[a_ui] ? true :
+                 0 == oLoops[a_ui] ? false :
+                 oLoops[a_ui] <= oCompletedLoops[a_ui] );
+    }
+    unsigned int LengthInFrames( unsigned int a_ui ) const
+    {
+        return oLoops[a_ui] * oFrameCounts[a_ui];
+    }
+    double LengthInSeconds( unsigned int a_ui ) const
+    {
+        return ( 0.0 == oFPS[a_ui] ? 0.0
+                                   : LengthInFrames( a_ui ) / oFPS[a_ui] );
+    }
+
+    // Change the sprite's frame, keeping the copy here in step
+    void SetFrame( unsigned int a_ui, unsigned int a_uiFrame )
+    {
+        if( 0 != oFrameCounts[a_ui] )
+        {
+            oOwners[a_ui]->Sprite::SetFrameNumber( a_uiFrame );
+            oFrameNumbers[a_ui] = a_uiFrame % oFrameCounts[a_ui];
+        }
+    }
+
+    // Work out the completed loops and frame number for a frame-rate-driven
+    // animation, given its elapsed time in seconds and frames.  Sets the
+    // completed loops and returns the frame number without setting it.
+    unsigned int Calculate( unsigned int a_ui, double a_dElapsedSeconds,
+                            double a_dElapsedFrames )
+    {
+        unsigned int uiFrames = (unsigned int)a_dElapsedFrames;
+        if( 0 == oFrameCounts[a_ui] )
+        {
+            oCompletedLoops[a_ui] = 0;
+            return 0;
+        }
+        if( 0 == oLoops[a_ui] )
+        {
+            oCompletedLoops[a_ui] = uiFrames / oFrameCounts[a_ui];
+            return uiFrames % oFrameCounts[a_ui];
+        }
+        oCompletedLoops[a_ui] = (unsigned int)( a_dElapsedSeconds /
+                                                LengthInSeconds( a_ui ) );
+        return ( IsCompleted( a_ui ) ? oFrameCounts[a_ui] - 1
+                                     : uiFrames % oFrameCounts[a_ui] );
+    }
+
+    // Step a frame-by-frame animation forward.  Sets the completed loops and
+    // returns the frame number without setting it.
+    unsigned int Increment( unsigned int a_ui )
+    {
+        if( IsCompleted( a_ui ) )
+        {
+            return ( 0 == oFrameCounts[a_ui] ? 0 : oFrameCounts[a_ui] - 1 );
+        }
+        if( oFrameCounts[a_ui] - 1 == oFrameNumbers[a_ui] )
+        {
+            ++oCompletedLoops[a_ui];
+        }
+        return ( IsCompleted( a_ui ) ? oFrameNumbers[a_ui]
+                                     : ( oFrameNumbers[a_ui] + 1 ) %
+                                       oFrameCounts[a_ui] );
+    }
+
+    // Advance a playing, uncompleted animation.  Returns the new frame number
+    // without setting it, and the callback that came due, if any, through
+    // a_rpDue.
+    unsigned int Advance( unsigned int a_ui, double a_dElapsedSeconds,
+                          double a_dElapsedFrames, Callback& a_rpDue )
+    {
+        unsigned int uiLoops = oCompletedLoops[a_ui];
+        unsigned int uiFrame =
+            ( 0.0 == oFPS[a_ui] ? Increment( a_ui )
+                                : Calculate( a_ui, a_dElapsedSeconds,
+                                             a_dElapsedFrames ) );
+        a_rpDue = ( IsCompleted( a_ui ) ? oOnComplete[a_ui] :
+                    uiLoops < oCompletedLoops[a_ui] ? oOnLoop[a_ui] : nullptr );
+        return uiFrame;
+    }
+
+    // Add an animation at the end of the arrays
+    void PushBack( AnimatedSprite* a_poOwner, double a_dFPS,
+                   unsigned int a_uiLoops, Callback a_pOnComplete )
+    {
+        oOwners.push_back( a_poOwner );
+        oSeconds.push_back( 0.0 );
+        oUnpauseTimes.push_back( 0.0 );
+        oFPS.push_back( a_dFPS );
+        oLoops.push_back( a_uiLoops );
+        oCompletedLoops.push_back( 0 );
+        oFrameCounts.push_back( a_poOwner->FrameCount() );
+        oFrameNumbers.push_back( a_poOwner->FrameNumber() );
+        oPaused.push_back( 1 );
+        oOnComplete.push_back( a_pOnComplete );
+        oOnLoop.push_back( nullptr );
+    }
+
+    // Copy all of one animation's state except its owner over another's
+    void Assign( unsigned int a_ui, unsigned int a_uiSource )
+    {
+        oSeconds[a_ui] = oSeconds[a_uiSource];
+        oUnpauseTimes[a_ui] = oUnpauseTimes[a_uiSource];
+        oFPS[a_ui] = oFPS[a_uiSource];
+        oLoops[a_ui] = oLoops[a_uiSource];
+        oCompletedLoops[a_ui] = oCompletedLoops[a_uiSource];
+        oFrameCounts[a_ui] = oFrameCounts[a_uiSource];
+        oFrameNumbers[a_ui] = oFrameNumbers[a_uiSource];
+        oPaused[a_ui] = oPaused[a_uiSource];
+        oOnComplete[a_ui] = oOnComplete[a_uiSource];
+        oOnLoop[a_ui] = oOnLoop[a_uiSource];
+    }
+
+    // Remove the last animation
+    void PopBack()
+    {
+        oOwners.pop_back();
+        oSeconds.pop_back();
+        oUnpauseTimes.pop_back();
+        oFPS.pop_back();
+        oLoops.pop_back();
+        oCompletedLoops.pop_back();
+        oFrameCounts.pop_back();
+        oFrameNumbers.pop_back();
+        oPaused.pop_back();
+        oOnComplete.pop_back();
+        oOnLoop.pop_back();
+    }
+
+};  // class Animator::Tracks
+
+// Callbacks waiting to be called, and the next one to call
+class Animator::CallbackQueue
+{
+public:
+
+    CallbackQueue() : uiNext( 0 ) {}
+    virtual ~CallbackQueue() {}
+
+    struct Entry
+    {
+        AnimatedSprite* poSprite;   // null if the sprite has been destroyed
+        Callback pCallback;
+    };
+    std::vector< Entry > oEntries;
+    unsigned int uiNext;
+
+};  // class Animator::CallbackQueue
+
+// Constructor/destructor
+Animator::Animator()
+    : m_poTracks( new Tracks ), m_poCallbacks( new CallbackQueue )
+{
+    Stats oStats = { 0, 0, 0, 0 };
+    m_oLastUpdate = oStats;
+}
+Animator::~Animator()
+{
+    delete m_poTracks;
+    delete m_poCallbacks;
+}
+
+// Advance every playing animation, then call the callbacks that came due
+void Animator::UpdateAll()
+{
+    UpdateAll( GameEngine::LastTime() );
+}
+void Animator::UpdateAll( double a_dTime )
+{
+    PROFILE_ZONE( "Animator::UpdateAll" );
+    Animator& roAnimator = Instance();
+    Tracks& roTracks = *roAnimator.m_poTracks;
+    unsigned int uiCount = roTracks.Size();
+    Stats oStats = { uiCount, 0, 0, 0 };
+    if( 0 == uiCount )
+    {
+        roAnimator.m_oLastUpdate = oStats;
+        return;
+    }
+
+    // Work out everyone's elapsed time first.  Paused animations get garbage
+    // here, but they're skipped below, and a branch-free pass is faster than
+    // checking.
+    roTracks.oElapsedSeconds.resize( uiCount );
+    roTracks.oElapsedFrames.resize( uiCount );
+    const double* pcdSeconds = &( roTracks.oSeconds[0] );
+    const double* pcdUnpauseTimes = &( roTracks.oUnpauseTimes[0] );
+    const double* pcdFPS = &( roTracks.oFPS[0] );
+    double* pdElapsedSeconds = &( roTracks.oElapsedSeconds[0] );
+    double* pdElapsedFrames = &( roTracks.oElapsedFrames[0] );
+    unsigned int ui = 0;
+#ifdef ANIMATOR__SSE2
+    __m128d oTime = _mm_set1_pd( a_dTime );
+    for( ; ui + 1 < uiCount; ui += 2 )
+    {
+        __m128d oElapsed =
+            _mm_add_pd( _mm_loadu_pd( pcdSeconds + ui ),
+                        _mm_sub_pd( oTime,
+                                    _mm_loadu_pd( pcdUnpauseTimes + ui ) ) );
+        _mm_storeu_pd( pdElapsedSeconds + ui, oElapsed );
+        _mm_storeu_pd( pdElapsedFrames + ui,
+                       _mm_mul_pd( oElapsed, _mm_loadu_pd( pcdFPS + ui ) ) );
+    }
+#endif
+    for( ; ui < uiCount; ++ui )
+    {
+        pdElapsedSeconds[ui] = pcdSeconds[ui] +
+                               ( a_dTime - pcdUnpauseTimes[ui] );
+        pdElapsedFrames[ui] = pdElapsedSeconds[ui] * pcdFPS[ui];
+    }
+
+    // Then work out completed loops and frame numbers, queueing callbacks and
+    // noting which sprites need their frame changed
+    roTracks.oChanged.clear();
+    for( ui = 0; ui < uiCount; ++ui )
+    {
+        if( 0 != roTracks.oPaused[ui] || roTracks.IsCompleted( ui ) )
+        {
+            continue;
+        }
+        ++oStats.uiAdvanced;
+        Callback pDue = nullptr;
+        unsigned int uiFrame = roTracks.Advance( ui, pdElapsedSeconds[ui],
+                                                 pdElapsedFrames[ui], pDue );
+        if( uiFrame != roTracks.oFrameNumbers[ui] )
+        {
+            roTracks.oFrameNumbers[ui] = uiFrame;
+            roTracks.oChanged.push_back( ui );
+        }
+        if( nullptr != pDue )
+        {
+            CallbackQueue::Entry oEntry = { roTracks.oOwners[ui], pDue };
+            roAnimator.m_poCallbacks->oEntries.push_back( oEntry );
+        }
+    }
+
+    // Only now touch the sprites, and only the ones that changed
+    oStats.uiFrameChanges = roTracks.oChanged.size();
+    for each( unsigned int uiChanged in roTracks.oChanged )
+    {
+        roTracks.oOwners[ uiChanged ]->
+            Sprite::SetFrameNumber( roTracks.oFrameNumbers[ uiChanged ] );
+    }
+
+    oStats.uiCallbacks = roAnimator.m_poCallbacks->oEntries.size() -
+                         roAnimator.m_poCallbacks->uiNext;
+    roAnimator.m_oLastUpdate = oStats;
+    roAnimator.DispatchCallbacks();
+}
+
+// Call the queued callbacks.  Callbacks can trigger another UpdateAll, which
+// carries on through the same queue, so each callback is only called once.
+void Animator::DispatchCallbacks()
+{
+    CallbackQueue& roQueue = *m_poCallbacks;
+    while( roQueue.uiNext < roQueue.oEntries.size() )
+    {
+        CallbackQueue::Entry oEntry = roQueue.oEntries[ roQueue.uiNext++ ];
+        if( nullptr != oEntry.poSprite )
+        {
+            oEntry.pCallback( *oEntry.poSprite );
+        }
+    }
+    roQueue.oEntries.clear();
+    roQueue.uiNext = 0;
+}
+
+// Number of animations
+unsigned int Animator::Count()
+{
+    return Instance().m_poTracks->Size();
+}
+
+// Add an animation for the given sprite and return its index
+unsigned int Animator::Create( AnimatedSprite& a_roOwner, double a_dFPS,
+                               unsigned int a_uiLoops, Callback a_pOnComplete )
+{
+    Tracks& roTracks = *Instance().m_poTracks;
+    roTracks.PushBack( &a_roOwner, a_dFPS, a_uiLoops, a_pOnComplete );
+    return roTracks.Size() - 1;
+}
+unsigned int Animator::Create( AnimatedSprite& a_roOwner,
+                               unsigned int a_uiSource )
+{
+    unsigned int uiAnimation = Create( a_roOwner, 0.0, 0, nullptr );
+    Copy( uiAnimation, a_uiSource );
+    return uiAnimation;
+}
+
+// Copy playback state from one animation to another
+void Animator::Copy( unsigned int a_uiAnimation, unsigned int a_uiSource )
+{
+    if( a_uiAnimation != a_uiSource )
+    {
+        Instance().m_poTracks->Assign( a_uiAnimation, a_uiSource );
+        SyncFrames( a_uiAnimation );
+    }
+}
+
+// Remove an animation, moving the last one into its place
+void Animator::Destroy( unsigned int a_uiAnimation )
+{
+    Animator& roAnimator = Instance();
+    Tracks& roTracks = *roAnimator.m_poTracks;
+
+    // Don't call back a sprite that's gone
+    CallbackQueue& roQueue = *roAnimator.m_poCallbacks;
+    for( unsigned int ui = roQueue.uiNext; ui < roQueue.oEntries.size(); ++ui )
+    {
+        if( roTracks.oOwners[ a_uiAnimation ] == roQueue.oEntries[ui].poSprite )
+        {
+            roQueue.oEntries[ui].poSprite = nullptr;
+        }
+    }
+
+    unsigned int uiLast = roTracks.Size() - 1;
+    if( a_uiAnimation != uiLast )
+    {
+        roTracks.oOwners[ a_uiAnimation ] = roTracks.oOwners[ uiLast ];
+        roTracks.Assign( a_uiAnimation, uiLast );
+        roTracks.oOwners[ a_uiAnimation ]->m_uiAnimation = a_uiAnimation;
+    }
+    roTracks.PopBack();
+}
+
+// Pick up frame list or frame number changes made to the sprite directly
+void Animator::SyncFrames( unsigned int a_uiAnimation )
+{
+    Tracks& roTracks = *Instance().m_poTracks;
+    const AnimatedSprite& roOwner = *roTracks.oOwners[ a_uiAnimation ];
+    roTracks.oFrameCounts[ a_uiAnimation ] = roOwner.FrameCount();
+    roTracks.oFrameNumbers[ a_uiAnimation ] = roOwner.FrameNumber();
+}
+
+// increment frame if appropriate
+void Animator::Update( unsigned int a_uiAnimation )
+{
+    Tracks& roTracks = *Instance().m_poTracks;
+    if( 0 == roTracks.oPaused[ a_uiAnimation ] &&
+        !roTracks.IsCompleted( a_uiAnimation ) )
+    {
+        double dElapsed = roTracks.oSeconds[ a_uiAnimation ] +
+                          ( GameEngine::LastTime() -
+                            roTracks.oUnpauseTimes[ a_uiAnimation ] );
+        Callback pDue = nullptr;
+        unsigned int uiFrame =
+            roTracks.Advance( a_uiAnimation, dElapsed,
+                              dElapsed * roTracks.oFPS[ a_uiAnimation ], pDue );
+        roTracks.SetFrame( a_uiAnimation, uiFrame );
+        if( nullptr != pDue )
+        {
+            pDue( *roTracks.oOwners[ a_uiAnimation ] );
+        }
+    }
+}
+
+// adjust frame based on elapsed time (does nothing if FPS is zero)
+void Animator::CalculateFrame( unsigned int a_uiAnimation )
+{
+    Tracks& roTracks = *Instance().m_poTracks;
+    if( 0.0 != roTracks.oFPS[ a_uiAnimation ] )
+    {
+        roTracks.oCompletedLoops[ a_uiAnimation ] = 0;
+        double dElapsed = ElapsedSeconds( a_uiAnimation );
+        double dFrames = dElapsed * roTracks.oFPS[ a_uiAnimation ];
+        roTracks.SetFrame( a_uiAnimation,
+                           roTracks.Calculate( a_uiAnimation,
+                                               dElapsed, dFrames ) );
+    }
+}
+
+// increment frame and, if neccessary, completed loop count
+void Animator::IncrementFrame( unsigned int a_uiAnimation )
+{
+    Tracks& roTracks = *Instance().m_poTracks;
+    roTracks.SetFrame( a_uiAnimation, roTracks.Increment( a_uiAnimation ) );
+}
+
+// control progress
+void Animator::Play( unsigned int a_uiAnimation )
+{
+    Tracks& roTracks = *Instance().m_poTracks;
+    if( 0 != roTracks.oPaused[ a_uiAnimation ] )
+    {
+        roTracks.oUnpauseTimes[ a_uiAnimation ] = GameEngine::LastTime();
+        roTracks.oPaused[ a_uiAnimation ] = 0;
+    }
+}
+void Animator::Pause( unsigned int a_uiAnimation )
+{
+    Tracks& roTracks = *Instance().m_poTracks;
+    if( 0 == roTracks.oPaused[ a_uiAnimation ] )
+    {
+        roTracks.oSeconds[ a_uiAnimation ] = ElapsedSeconds( a_uiAnimation );
+        roTracks.oPaused[ a_uiAnimation ] = 1;
+    }
+}
+void Animator::Rewind( unsigned int a_uiAnimation )
+{
+    Tracks& roTracks = *Instance().m_poTracks;
+    Seek( a_uiAnimation, 0.0 );
+    roTracks.SetFrame( a_uiAnimation, 0 );
+    roTracks.oCompletedLoops[ a_uiAnimation ] = 0;
+}
+void Animator::Complete( unsigned int a_uiAnimation )
+{
+    Tracks& roTracks = *Instance().m_poTracks;
+    if( 0 != roTracks.oLoops[ a_uiAnimation ] )
+    {
+        roTracks.oLoops[ a_uiAnimation ] =
+            roTracks.oCompletedLoops[ a_uiAnimation ] + 1;
+    }
+    Seek( a_uiAnimation, roTracks.LengthInSeconds( a_uiAnimation ) );
+    roTracks.oCompletedLoops[ a_uiAnimation ] =
+        roTracks.oLoops[ a_uiAnimation ];
+    roTracks.SetFrame( a_uiAnimation,
+                       roTracks.oFrameCounts[ a_uiAnimation ] - 1 );
+    OnComplete( a_uiAnimation );
+}
+void Animator::Seek( unsigned int a_uiAnimation, unsigned int a_uiFrame )
+{
+    Tracks& roTracks = *Instance().m_poTracks;
+    unsigned int uiLength = roTracks.LengthInFrames( a_uiAnimation );
+    if( 0 != uiLength && uiLength <= a_uiFrame )
+    {
+        Complete( a_uiAnimation );
+    }
+    else if( 0.0 != roTracks.oFPS[ a_uiAnimation ] )
+    {
+        Seek( a_uiAnimation, a_uiFrame / roTracks.oFPS[ a_uiAnimation ] );
+    }
+    else
+    {
+        unsigned int uiFrameCount = roTracks.oFrameCounts[ a_uiAnimation ];
+        if( 0 != uiFrameCount )
+        {
+            roTracks.oCompletedLoops[ a_uiAnimation ] =
+                a_uiFrame / uiFrameCount;
+            if( roTracks.oLoops[ a_uiAnimation ] <
+                roTracks.oCompletedLoops[ a_uiAnimation ] )
+            {
+                roTracks.oCompletedLoops[ a_uiAnimation ] =
+                    roTracks.oLoops[ a_uiAnimation ];
+            }
+        }
+        roTracks.SetFrame( a_uiAnimation,
+                           roTracks.IsCompleted( a_uiAnimation )
+                           ? uiFrameCount - 1 : a_uiFrame );
+    }
+}
+void Animator::Seek( unsigned int a_uiAnimation, double a_dSeconds )
+{
+    Tracks& roTracks = *Instance().m_poTracks;
+    roTracks.oSeconds[ a_uiAnimation ] =
+        ( 0.0 > a_dSeconds ? 0.0 : a_dSeconds );
+    if( 0 == roTracks.oPaused[ a_uiAnimation ] )
+    {
+        roTracks.oUnpauseTimes[ a_uiAnimation ] = GameEngine::LastTime();
+    }
+    if( 0.0 != roTracks.oFPS[ a_uiAnimation ] )
+    {
+        if( 0 != roTracks.oLoops[ a_uiAnimation ] &&
+            roTracks.LengthInSeconds( a_uiAnimation ) < a_dSeconds )
+        {
+            roTracks.oSeconds[ a_uiAnimation ] =
+                roTracks.LengthInSeconds( a_uiAnimation );
+        }
+        CalculateFrame( a_uiAnimation );
+    }
+}
+void Animator::Add( unsigned int a_uiAnimation, int a_iFrames )
+{
+    if( 0 > a_iFrames &&
+        ElapsedFrames( a_uiAnimation ) <= (unsigned int)( -a_iFrames ) )
+    {
+        Rewind( a_uiAnimation );
+    }
+    Seek( a_uiAnimation, ElapsedFrames( a_uiAnimation ) + a_iFrames );
+}
+void Animator::Add( unsigned int a_uiAnimation, double a_dSeconds )
+{
+    Seek( a_uiAnimation, ElapsedSeconds( a_uiAnimation ) + a_dSeconds );
+}
+
+// Get properties
+bool Animator::IsCompleted( unsigned int a_uiAnimation )
+{
+    return Instance().m_poTracks->IsCompleted( a_uiAnimation );
+}
+bool Animator::IsPaused( unsigned int a_uiAnimation )
+{
+    return ( 0 != Instance().m_poTracks->oPaused[ a_uiAnimation ] );
+}
+unsigned int Animator::Loops( unsigned int a_uiAnimation )
+{
+    return Instance().m_poTracks->oLoops[ a_uiAnimation ];
+}
+double Animator::FPS( unsigned int a_uiAnimation )
+{
+    return Instance().m_poTracks->oFPS[ a_uiAnimation ];
+}
+unsigned int Animator::CompletedLoops( unsigned int a_uiAnimation )
+{
+    return Instance().m_poTracks->oCompletedLoops[ a_uiAnimation ];
+}
+Animator::Callback Animator::CompletionCallback( unsigned int a_uiAnimation )
+{
+    return Instance().m_poTracks->oOnComplete[ a_uiAnimation ];
+}
+Animator::Callback Animator::LoopCallback( unsigned int a_uiAnimation )
+{
+    return Instance().m_poTracks->oOnLoop[ a_uiAnimation ];
+}
+unsigned int Animator::LengthInFrames( unsigned int a_uiAnimation )
+{
+    return Instance().m_poTracks->LengthInFrames( a_uiAnimation );
+}
+double Animator::LengthInSeconds( unsigned int a_uiAnimation )
+{
+    return Instance().m_poTracks->LengthInSeconds( a_uiAnimation );
+}
+unsigned int Animator::ElapsedFrames( unsigned int a_uiAnimation )
+{
+    Tracks& roTracks = *Instance().m_poTracks;
+    return ( roTracks.IsCompleted( a_uiAnimation )
+             ? roTracks.LengthInFrames( a_uiAnimation )
+             : roTracks.oFrameNumbers[ a_uiAnimation ] +
+               roTracks.oCompletedLoops[ a_uiAnimation ] *
+               roTracks.oFrameCounts[ a_uiAnimation ] );
+}
+double Animator::ElapsedSeconds( unsigned int a_uiAnimation )
+{
+    Tracks& roTracks = *Instance().m_poTracks;
+    return ( roTracks.IsCompleted( a_uiAnimation )
+             ? roTracks.LengthInSeconds( a_uiAnimation )
+             : roTracks.oSeconds[ a_uiAnimation ] +
+               ( 0 != roTracks.oPaused[ a_uiAnimation ] ? 0 :
+                 GameEngine::LastTime() -
+                 roTracks.oUnpauseTimes[ a_uiAnimation ] ) );
+}
+
+// Set properties
+void Animator::SetFPS( unsigned int a_uiAnimation, double a_dFPS )
+{
+    Instance().m_poTracks->oFPS[ a_uiAnimation ] = a_dFPS;
+    Seek( a_uiAnimation, ElapsedFrames( a_uiAnimation ) );
+}
+void Animator::SetCompletionCallback( unsigned int a_uiAnimation,
+                                      Callback a_pOnComplete )
+{
+    Instance().m_poTracks->oOnComplete[ a_uiAnimation ] = a_pOnComplete;
+}
+void Animator::SetLoopCallback( unsigned int a_uiAnimation,
+                                Callback a_pOnLoop )
+{
+    Instance().m_poTracks->oOnLoop[ a_uiAnimation ] = a_pOnLoop;
+}
+void Animator::SetLoops( unsigned int a_uiAnimation, unsigned int a_uiLoops )
+{
+    Tracks& roTracks = *Instance().m_poTracks;
+    roTracks.oLoops[ a_uiAnimation ] = a_uiLoops;
+    if( roTracks.oCompletedLoops[ a_uiAnimation ] > a_uiLoops )
+    {
+        roTracks.oCompletedLoops[ a_uiAnimation ] = a_uiLoops;
+    }
+}
+void Animator::SetLengthInSeconds( unsigned int a_uiAnimation,
+                                   double a_dSeconds )
+{
+    unsigned int uiFrames = LengthInFrames( a_uiAnimation );
+    if( 0.0 != a_dSeconds )
+    {
+        SetFPS( a_uiAnimation, uiFrames / a_dSeconds );
+    }
+}
+void Animator::OnComplete( unsigned int a_uiAnimation )
+{
+    Tracks& roTracks = *Instance().m_poTracks;
+    if( nullptr != roTracks.oOnComplete[ a_uiAnimation ] )
+    {
+        roTracks.oOnComplete[ a_uiAnimation ](
+            *roTracks.oOwners[ a_uiAnimation ] );
+    }
+}
+
+}   // namespace MyFirstEngine
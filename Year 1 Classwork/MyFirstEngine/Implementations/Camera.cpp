@@ -3,8 +3,9 @@
  * Author:             Elizabeth Lowry
  * Date Created:       March 22, 2014
  * Description:        Class for managing the projection matrix.
- * Last Modified:      June 26, 2014
- * Last Modification:  Debugging.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Building the facing transform once instead of on every
+ *                      refresh.
  ******************************************************************************/
 
 #include "../Declarations/Camera.h"
@@ -18,6 +19,10 @@ namespace MyFirstEngine
 const Rotation3D Camera::FACING_NEGY_Z_PLANE = Rotation3D::None();
 const Rotation3D Camera::FACING_XY_PLANE = Rotation3D( Math::PI / 2, -Math::PI / 2 );
 
+// Transform for FACING_XY_PLANE, made once when the library loads.  Must come
+// after FACING_XY_PLANE so that it's initialized first.
+static const Transform3D sgc_oFacingXYPlane = Camera::FACING_XY_PLANE.MakeTransform();
+
 // Constructor
 Camera::Camera()
     : m_dDepthOfView( 1 ), m_dFocalLength( 0 ), m_oPosition( Point3D::Origin() ),
@@ -176,7 +181,7 @@ void Camera::Refresh()
         // The projection matrices assume that the z-axis points towards the
         // camera.  Since normally the z-axis is up and the x-axis forward,
         // rotate the world again.
-        GameEngine::Projection() *= FACING_XY_PLANE.MakeTransform();
+        GameEngine::Projection() *= sgc_oFacingXYPlane;
         oProjection = GameEngine::Projection();
         
         // apply the appropriate projection matrix
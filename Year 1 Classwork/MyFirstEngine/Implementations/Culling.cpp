@@ -0,0 +1,75 @@
+/******************************************************************************
+ * File:               Culling.cpp
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Implementations for Culling functions.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Creation.
+ ******************************************************************************/
+
+#include "../Declarations/Camera.h"
+#include "../Declarations/Culling.h"
+#include "../Declarations/Drawable.h"
+#include "../Declarations/GameEngine.h"
+#include "../Declarations/Profiler.h"
+
+namespace MyFirstEngine
+{
+
+// Frustum of the current model-view-projection matrix
+Space::Frustum Culling::ViewFrustum()
+{
+    return Space::Frustum( Transform3D( GameEngine::ModelViewProjection() ) );
+}
+
+// Depth only matters with a perspective projection
+unsigned int Culling::ViewPlanes()
+{
+    return ( Camera::IsPerspective() ? Space::Frustum::ALL_PLANES
+                                     : Space::Frustum::SIDE_PLANES );
+}
+
+// Test whole arrays of boxes at once
+unsigned int Culling::Cull( const double* ac_padMinX,
+                            const double* ac_padMinY,
+                            const double* ac_padMinZ,
+                            const double* ac_padMaxX,
+                            const double* ac_padMaxY,
+                            const double* ac_padMaxZ,
+                            unsigned int a_uiCount,
+                            unsigned int* a_pauiResults )
+{
+    PROFILE_ZONE( "Culling::Cull" );
+    unsigned int uiVisible =
+        ViewFrustum().Cull( ac_padMinX, ac_padMinY, ac_padMinZ,
+                            ac_padMaxX, ac_padMaxY, ac_padMaxZ,
+                            a_uiCount, a_pauiResults, ViewPlanes() );
+    PROFILE_COUNT( CULLED_OBJECTS, a_uiCount - uiVisible );
+    return uiVisible;
+}
+
+// Test a drawable whose model matrix is already in the model-view matrix
+bool Culling::Test( const Drawable& ac_roDrawable )
+{
+    // Objects without bounds, and objects inside something already known to
+    // be entirely visible, are always drawn
+    Space::BoundingBox oBounds;
+    Culling& roCulling = Instance();
+    if( !roCulling.m_bEnabled || 0 == roCulling.m_uiPlanes ||
+        !ac_roDrawable.GetLocalBounds( oBounds ) )
+    {
+        return true;
+    }
+
+    unsigned int uiPlanes = roCulling.m_uiPlanes & ViewPlanes();
+    if( Space::Frustum::OUTSIDE ==
+        ViewFrustum().TestAndNarrow( oBounds, uiPlanes ) )
+    {
+        PROFILE_COUNT( CULLED_OBJECTS, 1 );
+        return false;
+    }
+    roCulling.m_uiPlanes = uiPlanes;
+    return true;
+}
+
+}   // namespace MyFirstEngine
@@ -3,12 +3,14 @@
  * Author:             Elizabeth Lowry
  * Date Created:       February 24, 2014
  * Description:        Implementations for Drawable member functions.
- * Last Modified:      March 17, 2014
- * Last Modification:  Adding replacement for deprecated OpenGL matrix stack.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Added bounds for culling.
  ******************************************************************************/
 
+#include "../Declarations/Culling.h"
 #include "../Declarations/Drawable.h"
 #include "../Declarations/GameEngine.h"
+#include "../Declarations/Profiler.h"
 #include <cmath>
 
 namespace MyFirstEngine
@@ -65,6 +67,8 @@ Drawable::~Drawable()
 // Draw the object to the screen
 void Drawable::Draw() const
 {
+    PROFILE_ZONE( "Drawable::Draw" );
+
     // Don't bother if the object isn't visible
     if( !m_bVisible )
     {
@@ -76,8 +80,16 @@ void Drawable::Draw() const
     GameEngine::ApplyBeforeModelView( GetModelMatrix() );
 
     // Draw the components of this drawable object - points, lines, other
-    // drawable objects, etc.
-    DrawComponents();
+    // drawable objects, etc. - unless they're entirely out of view.  Anything
+    // drawn inside this object's bounds only needs to be tested against the
+    // view planes the bounds cross, so save the current planes to restore
+    // afterward.
+    unsigned int uiPlanes = Culling::Planes();
+    if( Culling::Test( *this ) )
+    {
+        DrawComponents();
+    }
+    Culling::SetPlanes( uiPlanes );
 
     // reset modelview matrix
     GameEngine::PopModelView();
@@ -89,15 +101,33 @@ const Transform3D& Drawable::GetModelMatrix() const
     // If One of the transformation properties has been updated,
     if( *m_pbUpdateModelMatrix )
     {
-        // Recompute the modelview matrix
-        *m_poModelMatrix = m_oBeforeTransform * Space::Scaling( m_oScale ) *
-                           m_oRotation.MakeTransform() *
-                           Space::Translation( m_oPosition ) * m_oAfterTransform;
+        // Recompute the modelview matrix, without a temporary matrix for each
+        // intermediate product.  Scale, rotation, and position are combined
+        // directly instead of multiplying three full 4x4 matrices.
+        *m_poModelMatrix =
+            Math::Lazy( m_oBeforeTransform ) *
+            Space::Homogeneous( Space::Affine( m_oScale,
+                                               m_oRotation.MakePointTransform(),
+                                               m_oPosition ) ) *
+            m_oAfterTransform;
         *m_pbUpdateModelMatrix = false;
     }
     return *m_poModelMatrix;
 }
 
+// Get the box containing everything this object draws after its model matrix
+// is applied
+bool Drawable::GetBounds( Space::BoundingBox& a_roBounds ) const
+{
+    Space::BoundingBox oLocalBounds;
+    if( !GetLocalBounds( oLocalBounds ) )
+    {
+        return false;
+    }
+    a_roBounds = oLocalBounds.Transformed( GetModelMatrix() );
+    return true;
+}
+
 // Set color
 Drawable& Drawable::SetColor( const Color::ColorVector& ac_roColor )
 {
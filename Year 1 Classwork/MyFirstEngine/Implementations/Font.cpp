@@ -3,8 +3,8 @@
  * Author:             Elizabeth Lowry
  * Date Created:       March 19, 2014
  * Description:        Class representing a font.
- * Last Modified:      March 21, 2014
- * Last Modification:  Refactoring and debugging.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Looking up HTML characters without HTML::Map.
  ******************************************************************************/
 
 #include "../Declarations/Font.h"
@@ -81,16 +81,18 @@ bool Font::Has( char a_cCharacter ) const
 }
 bool Font::Has( const char* ac_pcCharacterName ) const
 {
+    char cCharacter;
     return ( m_oMap.Has( ac_pcCharacterName )
                 ? Has( m_oMap[ ac_pcCharacterName ] ) :
-             HTML::Map().Has( ac_pcCharacterName )
-                ? Has( HTML::Map()[ ac_pcCharacterName ] ) : false );
+             HTML::Find( ac_pcCharacterName, cCharacter )
+                ? Has( cCharacter ) : false );
 }
 char Font::GetCharacter( const char* ac_pcCharacterName ) const
 {
+    char cCharacter;
     return ( m_oMap.Has( ac_pcCharacterName ) ? m_oMap[ ac_pcCharacterName ] :
-             HTML::Map().Has( ac_pcCharacterName )
-                ? HTML::Map()[ ac_pcCharacterName ] : m_cUnknown );
+             HTML::Find( ac_pcCharacterName, cCharacter )
+                ? cCharacter : m_cUnknown );
 }
 
 // for getting and setting character frames directly
@@ -102,10 +104,11 @@ Frame& Font::operator[]( const char* ac_pcCharacterName )
         return m_oFrameList[ m_oMap[ ac_pcCharacterName ] ];
     }
 
-    // Otherwise, check HTML character map
-    if( HTML::Map().Has( ac_pcCharacterName ) )
+    // Otherwise, check HTML characters
+    char cCharacter;
+    if( HTML::Find( ac_pcCharacterName, cCharacter ) )
     {
-        return m_oFrameList[ HTML::Map()[ ac_pcCharacterName ] ];
+        return m_oFrameList[ ((unsigned int)cCharacter) % 256 ];
     }
 
     // If neither map has the symbol, return a reference to a static frame not
@@ -122,10 +125,11 @@ const Frame& Font::operator[]( const char* ac_pcCharacterName ) const
         return m_oFrameList[ ((unsigned int)m_oMap[ ac_pcCharacterName ]) % 256 ];
     }
 
-    // Otherwise, check HTML character map
-    if( HTML::Map().Has( ac_pcCharacterName ) )
+    // Otherwise, check HTML characters
+    char cCharacter;
+    if( HTML::Find( ac_pcCharacterName, cCharacter ) )
     {
-        return m_oFrameList[ ((unsigned int)HTML::Map()[ ac_pcCharacterName ]) % 256 ];
+        return m_oFrameList[ ((unsigned int)cCharacter) % 256 ];
     }
 
     // If neither map has the symbol, return a reference to the zero frame
@@ -0,0 +1,74 @@
+/******************************************************************************
+ * File:               GLFW.cpp
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Pointers the engine calls GLFW and OpenGL 1.1 through.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Dispatching glfwSetTime.
+ ******************************************************************************/
+
+// Don't replace the real functions with the pointers in this file
+#define MY_FIRST_ENGINE__NO_DISPATCH
+#include "..\Declarations\GLFW.h"
+
+namespace MyFirstEngine
+{
+namespace Dispatch
+{
+
+// OpenGL 1.1
+decltype( &::glBindTexture ) glBindTexture = &::glBindTexture;
+decltype( &::glBlendFunc ) glBlendFunc = &::glBlendFunc;
+decltype( &::glClear ) glClear = &::glClear;
+decltype( &::glClearColor ) glClearColor = &::glClearColor;
+decltype( &::glDeleteTextures ) glDeleteTextures = &::glDeleteTextures;
+decltype( &::glDrawElements ) glDrawElements = &::glDrawElements;
+decltype( &::glEnable ) glEnable = &::glEnable;
+decltype( &::glGenTextures ) glGenTextures = &::glGenTextures;
+decltype( &::glGetIntegerv ) glGetIntegerv = &::glGetIntegerv;
+decltype( &::glGetString ) glGetString = &::glGetString;
+decltype( &::glGetTexImage ) glGetTexImage = &::glGetTexImage;
+decltype( &::glIsTexture ) glIsTexture = &::glIsTexture;
+decltype( &::glTexImage2D ) glTexImage2D = &::glTexImage2D;
+decltype( &::glTexParameterfv ) glTexParameterfv = &::glTexParameterfv;
+decltype( &::glTexParameteri ) glTexParameteri = &::glTexParameteri;
+decltype( &::glViewport ) glViewport = &::glViewport;
+
+// GLEW
+decltype( &::glewInit ) glewInit = &::glewInit;
+
+// GLFW
+decltype( &::glfwCreateWindow ) glfwCreateWindow = &::glfwCreateWindow;
+decltype( &::glfwDestroyWindow ) glfwDestroyWindow = &::glfwDestroyWindow;
+decltype( &::glfwGetCurrentContext ) glfwGetCurrentContext =
+    &::glfwGetCurrentContext;
+decltype( &::glfwGetCursorPos ) glfwGetCursorPos = &::glfwGetCursorPos;
+decltype( &::glfwGetFramebufferSize ) glfwGetFramebufferSize =
+    &::glfwGetFramebufferSize;
+decltype( &::glfwGetTime ) glfwGetTime = &::glfwGetTime;
+decltype( &::glfwInit ) glfwInit = &::glfwInit;
+decltype( &::glfwMakeContextCurrent ) glfwMakeContextCurrent =
+    &::glfwMakeContextCurrent;
+decltype( &::glfwPollEvents ) glfwPollEvents = &::glfwPollEvents;
+decltype( &::glfwSetCursorEnterCallback ) glfwSetCursorEnterCallback =
+    &::glfwSetCursorEnterCallback;
+decltype( &::glfwSetErrorCallback ) glfwSetErrorCallback =
+    &::glfwSetErrorCallback;
+decltype( &::glfwSetKeyCallback ) glfwSetKeyCallback = &::glfwSetKeyCallback;
+decltype( &::glfwSetMouseButtonCallback ) glfwSetMouseButtonCallback =
+    &::glfwSetMouseButtonCallback;
+decltype( &::glfwSetTime ) glfwSetTime = &::glfwSetTime;
+decltype( &::glfwSetWindowCloseCallback ) glfwSetWindowCloseCallback =
+    &::glfwSetWindowCloseCallback;
+decltype( &::glfwSetWindowShouldClose ) glfwSetWindowShouldClose =
+    &::glfwSetWindowShouldClose;
+decltype( &::glfwSetWindowSize ) glfwSetWindowSize = &::glfwSetWindowSize;
+decltype( &::glfwSetWindowTitle ) glfwSetWindowTitle = &::glfwSetWindowTitle;
+decltype( &::glfwSwapBuffers ) glfwSwapBuffers = &::glfwSwapBuffers;
+decltype( &::glfwTerminate ) glfwTerminate = &::glfwTerminate;
+decltype( &::glfwWindowHint ) glfwWindowHint = &::glfwWindowHint;
+decltype( &::glfwWindowShouldClose ) glfwWindowShouldClose =
+    &::glfwWindowShouldClose;
+
+}   // namespace Dispatch
+}   // namespace MyFirstEngine
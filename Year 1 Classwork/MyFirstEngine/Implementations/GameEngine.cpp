@@ -3,8 +3,8 @@
  * Author:             Elizabeth Lowry
  * Date Created:       February 5, 2014
  * Description:        Implementations of GameEngine functions.
- * Last Modified:      March 25, 2014
- * Last Modification:  Hooking up mouse and keyboard event handling.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Frame times come from Input, so replays can supply them.
  ******************************************************************************/
 
 #include "..\Declarations\Camera.h"
@@ -12,8 +12,11 @@
 #include "..\Declarations\GameState.h"
 #include "..\Declarations\GameWindow.h"
 #include "..\Declarations\GLFW.h"
+#include "..\Declarations\Input.h"
+#include "..\Declarations\InstancedSpriteShaderProgram.h"
 #include "..\Declarations\Keyboard.h"
 #include "..\Declarations\Mouse.h"
+#include "..\Declarations\Profiler.h"
 #include "..\Declarations\QuadShaderProgram.h"
 #include "..\Declarations\Shader.h"
 #include "..\Declarations\ShaderProgram.h"
@@ -30,7 +33,7 @@ class GameEngine::StateStack : public std::stack< GameState* >
 public:
     virtual ~StateStack() {}
 };
-class GameEngine::TransformStack : public std::stack< Transform3D >
+class GameEngine::TransformStack : public std::stack< GLTransform3D >
 {
 public:
     virtual ~TransformStack() {}
@@ -52,11 +55,11 @@ GameEngine::~GameEngine()
     delete m_poProjection;
 }
 
-// Returns the time since this function was last called.
-double GameEngine::DeltaTime()
+// Move on to a new frame and return the time since the last one
+double GameEngine::DeltaTime( double a_dTime )
 {
     double dThen = m_dLastTime;
-    m_dLastTime = Time();
+    m_dLastTime = a_dTime;
     m_dLastDeltaTime = m_dLastTime - dThen;
     return m_dLastTime - dThen;
 }
@@ -66,52 +69,52 @@ double GameEngine::DeltaTime()
 //
 
 // Replaces the now-deprecated OpenGL matrix stack
-Transform3D GameEngine::ModelViewProjection()
+GLTransform3D GameEngine::ModelViewProjection()
 {
     return ModelView() * Projection();
 }
-Transform3D& GameEngine::ModelView()
+GLTransform3D& GameEngine::ModelView()
 {
     if( Instance().m_poModelView->empty() )
     {
-        Instance().m_poModelView->push( Transform3D::Identity() );
+        Instance().m_poModelView->push( GLTransform3D::Identity() );
     }
     return Instance().m_poModelView->top();
 }
-Transform3D& GameEngine::Projection()
+GLTransform3D& GameEngine::Projection()
 {
     if( Instance().m_poProjection->empty() )
     {
-        Instance().m_poProjection->push( Transform3D::Identity() );
+        Instance().m_poProjection->push( GLTransform3D::Identity() );
     }
     return Instance().m_poProjection->top();
 }
-Transform3D& GameEngine::SetModelView( const Transform3D& ac_roMatrix )
+GLTransform3D& GameEngine::SetModelView( const GLTransform3D& ac_roMatrix )
 {
     ModelView() = ac_roMatrix;
     return ModelView();
 }
-Transform3D& GameEngine::SetProjection( const Transform3D& ac_roMatrix )
+GLTransform3D& GameEngine::SetProjection( const GLTransform3D& ac_roMatrix )
 {
     Projection() = ac_roMatrix;
     return Projection();
 }
-Transform3D& GameEngine::ApplyAfterModelView( const Transform3D& ac_roMatrix )
+GLTransform3D& GameEngine::ApplyAfterModelView( const GLTransform3D& ac_roMatrix )
 {
     ModelView() *= ac_roMatrix;
     return ModelView();
 }
-Transform3D& GameEngine::ApplyAfterProjection( const Transform3D& ac_roMatrix )
+GLTransform3D& GameEngine::ApplyAfterProjection( const GLTransform3D& ac_roMatrix )
 {
     Projection() *= ac_roMatrix;
     return Projection();
 }
-Transform3D& GameEngine::ApplyBeforeModelView( const Transform3D& ac_roMatrix )
+GLTransform3D& GameEngine::ApplyBeforeModelView( const GLTransform3D& ac_roMatrix )
 {
     ModelView() = ac_roMatrix * ModelView();
     return ModelView();
 }
-Transform3D& GameEngine::ApplyBeforeProjection( const Transform3D& ac_roMatrix )
+GLTransform3D& GameEngine::ApplyBeforeProjection( const GLTransform3D& ac_roMatrix )
 {
     Projection() = ac_roMatrix * Projection();
     return Projection();
@@ -130,24 +133,24 @@ void GameEngine::ClearProjection()
         Instance().m_poProjection->pop();
     }
 }
-Transform3D GameEngine::PopModelView()  // returns copy of now-removed top matrix
+GLTransform3D GameEngine::PopModelView()  // returns copy of now-removed top matrix
 {
-    Transform3D oCopy( ModelView() );
+    GLTransform3D oCopy( ModelView() );
     Instance().m_poModelView->pop();
     return oCopy;
 }
-Transform3D GameEngine::PopProjection()  // returns copy of now-removed top matrix
+GLTransform3D GameEngine::PopProjection()  // returns copy of now-removed top matrix
 {
-    Transform3D oCopy( Projection() );
+    GLTransform3D oCopy( Projection() );
     Instance().m_poProjection->pop();
     return oCopy;
 }
-Transform3D& GameEngine::PushModelView( const Transform3D& ac_roMatrix )
+GLTransform3D& GameEngine::PushModelView( const GLTransform3D& ac_roMatrix )
 {
     Instance().m_poModelView->push( ac_roMatrix );
     return ModelView();
 }
-Transform3D& GameEngine::PushProjection( const Transform3D& ac_roMatrix )
+GLTransform3D& GameEngine::PushProjection( const GLTransform3D& ac_roMatrix )
 {
     Instance().m_poProjection->push( ac_roMatrix );
     return Projection();
@@ -181,6 +184,7 @@ bool GameEngine::Initialize( const IntPoint2D& ac_roSize,
         }
 
         // Otherwise, attempt to create an OpenGL context and call glewInit()
+        Input::Initialize();
         Mouse::Initialize();
         Keyboard::Initialize();
         MainWindow().SetClearColor( ac_roColor );
@@ -198,6 +202,8 @@ bool GameEngine::Initialize( const IntPoint2D& ac_roSize,
             glBlendFunc (GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
             QuadShaderProgram::Initialize();
             SpriteShaderProgram::Initialize();
+            InstancedSpriteShaderProgram::Initialize();
+            ShaderProgram::FinishAllSetups();
             Instance().m_dLastTime = Time();
         }
         else    // otherwise, terminate GLFW
@@ -278,15 +284,24 @@ void GameEngine::Run()
     }
     while( GameState::End() != CurrentState() )
     {
-        Instance().DeltaTime();
-        glfwPollEvents();
-        if( GameState::End() == CurrentState() ) { break; }
-        CurrentState().OnUpdate( LastDeltaTime() );
-        if( GameState::End() == CurrentState() ) { break; }
-        glfwPollEvents();   // in case OnUpdate triggered anything
-        if( GameState::End() == CurrentState() ) { break; }
-        Camera::Refresh();
-        CurrentState().Draw();
+        {
+            PROFILE_ZONE( "GameEngine::Run" );
+            glfwPollEvents();
+            Instance().DeltaTime( Input::Update( Time() ) );
+            if( GameState::End() == CurrentState() ) { break; }
+            {
+                PROFILE_ZONE( "GameState::OnUpdate" );
+                CurrentState().OnUpdate( LastDeltaTime() );
+            }
+            if( GameState::End() == CurrentState() ) { break; }
+            glfwPollEvents();   // in case OnUpdate triggered anything
+            if( GameState::End() == CurrentState() ) { break; }
+            Camera::Refresh();
+            PROFILE_ZONE( "GameState::Draw" );
+            PROFILE_GPU_ZONE( "GameState::Draw" );
+            CurrentState().Draw();
+        }
+        PROFILE_END_FRAME();
     }
 }
 
@@ -295,6 +310,7 @@ void GameEngine::Terminate()
 {
     if( IsInitialized() )
     {
+        InstancedSpriteShaderProgram::Terminate();
         SpriteShaderProgram::Terminate();
         QuadShaderProgram::Terminate();
         Texture::DestroyAll();
@@ -303,6 +319,7 @@ void GameEngine::Terminate()
         GameWindow::DestroyAll();
         Keyboard::Terminate();
         Mouse::Terminate();
+        Input::Terminate();
         glfwTerminate();
         Instance().m_bInitialized = false;
     }
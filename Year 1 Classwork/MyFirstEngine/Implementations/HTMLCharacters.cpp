@@ -2,182 +2,361 @@
  * File:               HTMLCharacters.cpp
  * Author:             Elizabeth Lowry
  * Date Created:       March 21, 2014
- * Description:        Initialization of HTML::Map.
- * Last Modified:      March 21, 2014
- * Last Modification:  Creation.
+ * Description:        HTML character lookup and initialization of HTML::Map.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Mapping hex codes in either case and rejecting leading
+ *                       zeros, so HTML::Find and HTML::Map agree.
  ******************************************************************************/
 
 #include "../Declarations/HTMLCharacters.h"
 #include "../Declarations/CharacterMap.h"
 #include "MathLibrary.h"
+#include <cstring>
 #include <sstream>
+#include <string>
 
 namespace
 {
-// create a character map for all the displayable ascii characters, mapping each
-// character to itself, its hex code, its number code, and (if available) its
-// html code
+
+// An HTML name and the character it stands for
+struct NamedCharacter
+{
+    const char* pcName;
+    char cCharacter;
+};
+
+// HTML names, sorted in strcmp order so they can be binary searched.  Since
+// this is an array of constants, the compiler fills it in - there's nothing to
+// construct at startup and nothing on the heap.  "Zscaron" is kept alongside
+// "Zcaron" since fonts may already use the old misspelling.
+const NamedCharacter sg_aoNames[] =
+{
+    { "AElig",   HTML::AElig },
+    { "Aacute",  HTML::Aacute },
+    { "Acirc",   HTML::Acirc },
+    { "Agrave",  HTML::Agrave },
+    { "Aring",   HTML::Aring },
+    { "Atilde",  HTML::Atilde },
+    { "Auml",    HTML::Auml },
+    { "Ccedil",  HTML::Ccedil },
+    { "Dagger",  HTML::Dagger },
+    { "ETH",     HTML::ETH },
+    { "Eacute",  HTML::Eacute },
+    { "Ecirc",   HTML::Ecirc },
+    { "Egrave",  HTML::Egrave },
+    { "Euml",    HTML::Euml },
+    { "Iacute",  HTML::Iacute },
+    { "Icirc",   HTML::Icirc },
+    { "Igrave",  HTML::Igrave },
+    { "Iuml",    HTML::Iuml },
+    { "Ntilde",  HTML::Ntilde },
+    { "OElig",   HTML::OElig },
+    { "Oacute",  HTML::Oacute },
+    { "Ocirc",   HTML::Ocirc },
+    { "Ograve",  HTML::Ograve },
+    { "Oslash",  HTML::Oslash },
+    { "Otilde",  HTML::Otilde },
+    { "Ouml",    HTML::Ouml },
+    { "Scaron",  HTML::Scaron },
+    { "THORN",   HTML::THORN },
+    { "Uacute",  HTML::Uacute },
+    { "Ucirc",   HTML::Ucirc },
+    { "Ugrave",  HTML::Ugrave },
+    { "Uuml",    HTML::Uuml },
+    { "Yacute",  HTML::Yacute },
+    { "Yuml",    HTML::Yuml },
+    { "Zcaron",  HTML::Zcaron },
+    { "Zscaron", HTML::Zcaron },
+    { "aacute",  HTML::aacute },
+    { "acirc",   HTML::acirc },
+    { "acute",   HTML::acute },
+    { "aelig",   HTML::aelig },
+    { "agrave",  HTML::agrave },
+    { "amp",     HTML::amp },
+    { "apos",    HTML::apos },
+    { "aring",   HTML::aring },
+    { "atilde",  HTML::atilde },
+    { "auml",    HTML::auml },
+    { "bdquo",   HTML::bdquo },
+    { "brvbar",  HTML::brvbar },
+    { "bull",    HTML::bull },
+    { "ccedil",  HTML::ccedil },
+    { "cedil",   HTML::cedil },
+    { "cent",    HTML::cent },
+    { "circ",    HTML::circ },
+    { "copy",    HTML::copy },
+    { "curren",  HTML::curren },
+    { "dagger",  HTML::dagger },
+    { "deg",     HTML::deg },
+    { "divide",  HTML::divide },
+    { "eacute",  HTML::eacute },
+    { "ecirc",   HTML::ecirc },
+    { "egrave",  HTML::egrave },
+    { "eth",     HTML::eth },
+    { "euml",    HTML::euml },
+    { "euro",    HTML::euro },
+    { "fnof",    HTML::fnof },
+    { "frac12",  HTML::frac12 },
+    { "frac14",  HTML::frac14 },
+    { "frac34",  HTML::frac34 },
+    { "gt",      HTML::gt },
+    { "hellip",  HTML::hellip },
+    { "iacute",  HTML::iacute },
+    { "icirc",   HTML::icirc },
+    { "iexcl",   HTML::iexcl },
+    { "igrave",  HTML::igrave },
+    { "iquest",  HTML::iquest },
+    { "iuml",    HTML::iuml },
+    { "laquo",   HTML::laquo },
+    { "ldquo",   HTML::ldquo },
+    { "lsaquo",  HTML::lsaquo },
+    { "lsquo",   HTML::lsquo },
+    { "lt",      HTML::lt },
+    { "macr",    HTML::macr },
+    { "mdash",   HTML::mdash },
+    { "micro",   HTML::micro },
+    { "middot",  HTML::middot },
+    { "nbsp",    HTML::nbsp },
+    { "ndash",   HTML::ndash },
+    { "not",     HTML::not },
+    { "ntilde",  HTML::ntilde },
+    { "oacute",  HTML::oacute },
+    { "ocirc",   HTML::ocirc },
+    { "oelig",   HTML::oelig },
+    { "ograve",  HTML::ograve },
+    { "ordf",    HTML::ordf },
+    { "ordm",    HTML::ordm },
+    { "oslash",  HTML::oslash },
+    { "otilde",  HTML::otilde },
+    { "ouml",    HTML::ouml },
+    { "para",    HTML::para },
+    { "permil",  HTML::permil },
+    { "plusmn",  HTML::plusmn },
+    { "pound",   HTML::pound },
+    { "quot",    HTML::quot },
+    { "raquo",   HTML::raquo },
+    { "rdquo",   HTML::rdquo },
+    { "reg",     HTML::reg },
+    { "rsaquo",  HTML::rsaquo },
+    { "rsquo",   HTML::rsquo },
+    { "sbquo",   HTML::sbquo },
+    { "scaron",  HTML::scaron },
+    { "sect",    HTML::sect },
+    { "shy",     HTML::shy },
+    { "sup1",    HTML::sup1 },
+    { "sup2",    HTML::sup2 },
+    { "sup3",    HTML::sup3 },
+    { "szlig",   HTML::szlig },
+    { "thorn",   HTML::thorn },
+    { "tilde",   HTML::tilde },
+    { "times",   HTML::times },
+    { "trade",   HTML::trade },
+    { "uacute",  HTML::uacute },
+    { "ucirc",   HTML::ucirc },
+    { "ugrave",  HTML::ugrave },
+    { "uml",     HTML::uml },
+    { "uuml",    HTML::uuml },
+    { "yacute",  HTML::yacute },
+    { "yen",     HTML::yen },
+    { "yuml",    HTML::yuml },
+    { "zcaron",  HTML::zcaron }
+};
+const unsigned int sg_uiNameCount =
+    sizeof( sg_aoNames ) / sizeof( NamedCharacter );
+
+// Compare a name that isn't null-terminated to one that is, strcmp-style
+int Compare( const char* ac_pcName, std::size_t a_uiLength,
+             const char* ac_pcTableName )
+{
+    for( std::size_t ui = 0; ui < a_uiLength; ++ui )
+    {
+        if( '\0' == ac_pcTableName[ ui ] )
+        {
+            return 1;
+        }
+        if( ac_pcName[ ui ] != ac_pcTableName[ ui ] )
+        {
+            return ( (unsigned char)ac_pcName[ ui ] <
+                     (unsigned char)ac_pcTableName[ ui ] ) ? -1 : 1;
+        }
+    }
+    return ( '\0' == ac_pcTableName[ a_uiLength ] ) ? 0 : -1;
+}
+
+// Parse a character number in the given base (10 or 16).  Fails if there are
+// no digits, a leading zero, a non-digit, or a value too large for a char, so
+// that every number it accepts is one HTMLMap() spells out.
+bool ParseNumber( const char* ac_pcDigits, std::size_t a_uiLength,
+                  unsigned int a_uiBase, char& a_rcCharacter )
+{
+    if( 0 == a_uiLength || ( 1 < a_uiLength && '0' == ac_pcDigits[0] ) )
+    {
+        return false;
+    }
+    unsigned int uiValue = 0;
+    for( std::size_t ui = 0; ui < a_uiLength; ++ui )
+    {
+        char c = ac_pcDigits[ ui ];
+        unsigned int uiDigit = a_uiBase;
+        if( '0' <= c && '9' >= c )
+        {
+            uiDigit = c - '0';
+        }
+        else if( 'a' <= c && 'f' >= c )
+        {
+            uiDigit = c - 'a' + 10;
+        }
+        else if( 'A' <= c && 'F' >= c )
+        {
+            uiDigit = c - 'A' + 10;
+        }
+        if( uiDigit >= a_uiBase )
+        {
+            return false;
+        }
+        uiValue = uiValue * a_uiBase + uiDigit;
+        if( 255 < uiValue )
+        {
+            return false;
+        }
+    }
+    a_rcCharacter = (char)uiValue;
+    return true;
+}
+
+// create a character map for all the ascii characters, mapping each character
+// to itself, its hex code, its number code, and (if available) its html code
 static MyFirstEngine::CharacterMap HTMLMap()
 {
     MyFirstEngine::CharacterMap oHTML;
     std::stringstream oStream;
 
-    // map all characters to their number codes( #___, x__ ) and to themselves
+    // map all characters to their number codes (#___) and to themselves
     for( unsigned int ui = 0; ui < 256; ++ui )
     {
-        oStream.clear();
-        oStream << std::ios::dec;
-        oStream << ui;
-        Utility::DumbString oNum( '#' );
-        oNum += oStream.str().c_str();
-        oStream.clear();
-        oStream << std::ios::hex;
-        oStream << ui;
-        oNum = oStream.str().c_str() + 1;
-        oHTML[ oNum ] =
+        oStream.str( "" );
+        oStream << '#' << std::dec << ui;
+        oHTML[ oStream.str().c_str() ] = (char)ui;
+
+        // map hex codes (x__, #x__, #X__) with every spelling of the digits
+        // that Find() accepts - each letter in either case
+        oStream.str( "" );
+        oStream << std::hex << ui;
+        const std::string coDigits = oStream.str();
+        for( unsigned int uiCase = 0; uiCase < ( 1u << coDigits.size() );
+             ++uiCase )
+        {
+            std::string oDigits = coDigits;
+            bool bRepeat = false;
+            for( std::size_t uj = 0; uj < oDigits.size(); ++uj )
+            {
+                if( 0 != ( uiCase & ( 1u << uj ) ) )
+                {
+                    if( 'a' > oDigits[ uj ] )
+                    {
+                        bRepeat = true;
+                    }
+                    else
+                    {
+                        oDigits[ uj ] = oDigits[ uj ] - 'a' + 'A';
+                    }
+                }
+            }
+            if( !bRepeat )
+            {
+                oHTML[ ( "x" + oDigits ).c_str() ] = (char)ui;
+                oHTML[ ( "#x" + oDigits ).c_str() ] = (char)ui;
+                oHTML[ ( "#X" + oDigits ).c_str() ] = (char)ui;
+            }
+        }
+        if( 0 < ui )
+        {
             oHTML[ Utility::DumbString( (char)ui ) ] = (char)ui;
+        }
     }
 
     // map HTML codes
-    oHTML[ "quot" ] = HTML::quot;
-    oHTML[ "amp" ] = HTML::amp;
-    oHTML[ "apos" ] = HTML::apos;
-    oHTML[ "lt" ] = HTML::lt;
-    oHTML[ "gt" ] = HTML::gt;
-    oHTML[ "euro" ] = HTML::euro;
-    oHTML[ "sbquo" ] = HTML::sbquo;
-    oHTML[ "fnof" ] = HTML::fnof;
-    oHTML[ "bdquo" ] = HTML::bdquo;
-    oHTML[ "hellip" ] = HTML::hellip;
-    oHTML[ "circ" ] = HTML::circ;
-    oHTML[ "dagger" ] = HTML::dagger;
-    oHTML[ "Dagger" ] = HTML::Dagger;
-    oHTML[ "permil" ] = HTML::permil;
-    oHTML[ "Scaron" ] = HTML::Scaron;
-    oHTML[ "lsaquo" ] = HTML::lsaquo;
-    oHTML[ "OElig" ] = HTML::OElig;
-    oHTML[ "Zscaron" ] = HTML::Zcaron;
-    oHTML[ "lsquo" ] = HTML::lsquo;
-    oHTML[ "rsquo" ] = HTML::rsquo;
-    oHTML[ "ldquo" ] = HTML::ldquo;
-    oHTML[ "rdquo" ] = HTML::rdquo;
-    oHTML[ "bull" ] = HTML::bull;
-    oHTML[ "ndash" ] = HTML::ndash;
-    oHTML[ "mdash" ] = HTML::mdash;
-    oHTML[ "tilde" ] = HTML::tilde;
-    oHTML[ "trade" ] = HTML::trade;
-    oHTML[ "scaron" ] = HTML::scaron;
-    oHTML[ "rsaquo" ] = HTML::rsaquo;
-    oHTML[ "oelig" ] = HTML::oelig;
-    oHTML[ "zcaron" ] = HTML::zcaron;
-    oHTML[ "Yuml" ] = HTML::Yuml;
-    oHTML[ "nbsp" ] = HTML::nbsp;
-    oHTML[ "iexcl" ] = HTML::iexcl;
-    oHTML[ "cent" ] = HTML::cent;
-    oHTML[ "pound" ] = HTML::pound;
-    oHTML[ "curren" ] = HTML::curren;
-    oHTML[ "yen" ] = HTML::yen;
-    oHTML[ "brvbar" ] = HTML::brvbar;
-    oHTML[ "sect" ] = HTML::sect;
-    oHTML[ "uml" ] = HTML::uml;
-    oHTML[ "copy" ] = HTML::copy;
-    oHTML[ "ordf" ] = HTML::ordf;
-    oHTML[ "laquo" ] = HTML::laquo;
-    oHTML[ "not" ] = HTML::not;
-    oHTML[ "shy" ] = HTML::shy;
-    oHTML[ "reg" ] = HTML::reg;
-    oHTML[ "macr" ] = HTML::macr;
-    oHTML[ "deg" ] = HTML::deg;
-    oHTML[ "plusmn" ] = HTML::plusmn;
-    oHTML[ "sup2" ] = HTML::sup2;
-    oHTML[ "sup3" ] = HTML::sup3;
-    oHTML[ "acute" ] = HTML::acute;
-    oHTML[ "micro" ] = HTML::micro;
-    oHTML[ "para" ] = HTML::para;
-    oHTML[ "middot" ] = HTML::middot;
-    oHTML[ "cedil" ] = HTML::cedil;
-    oHTML[ "sup1" ] = HTML::sup1;
-    oHTML[ "ordm" ] = HTML::ordm;
-    oHTML[ "raquo" ] = HTML::raquo;
-    oHTML[ "frac14" ] = HTML::frac14;
-    oHTML[ "frac12" ] = HTML::frac12;
-    oHTML[ "frac34" ] = HTML::frac34;
-    oHTML[ "iquest" ] = HTML::iquest;
-    oHTML[ "Agrave" ] = HTML::Agrave;
-    oHTML[ "Aacute" ] = HTML::Aacute;
-    oHTML[ "Acirc" ] = HTML::Acirc;
-    oHTML[ "Atilde" ] = HTML::Atilde;
-    oHTML[ "Auml" ] = HTML::Auml;
-    oHTML[ "Aring" ] = HTML::Aring;
-    oHTML[ "AElig" ] = HTML::AElig;
-    oHTML[ "Ccedil" ] = HTML::Ccedil;
-    oHTML[ "Egrave" ] = HTML::Egrave;
-    oHTML[ "Eacute" ] = HTML::Eacute;
-    oHTML[ "Ecirc" ] = HTML::Ecirc;
-    oHTML[ "Euml" ] = HTML::Euml;
-    oHTML[ "Igrave" ] = HTML::Igrave;
-    oHTML[ "Iacute" ] = HTML::Iacute;
-    oHTML[ "Icirc" ] = HTML::Icirc;
-    oHTML[ "Iuml" ] = HTML::Iuml;
-    oHTML[ "ETH" ] = HTML::ETH;
-    oHTML[ "Ntilde" ] = HTML::Ntilde;
-    oHTML[ "Ograve" ] = HTML::Ograve;
-    oHTML[ "Oacute" ] = HTML::Oacute;
-    oHTML[ "Ocirc" ] = HTML::Ocirc;
-    oHTML[ "Otilde" ] = HTML::Otilde;
-    oHTML[ "Ouml" ] = HTML::Ouml;
-    oHTML[ "times" ] = HTML::times;
-    oHTML[ "Oslash" ] = HTML::Oslash;
-    oHTML[ "Ugrave" ] = HTML::Ugrave;
-    oHTML[ "Uacute" ] = HTML::Uacute;
-    oHTML[ "Ucirc" ] = HTML::Ucirc;
-    oHTML[ "Uuml" ] = HTML::Uuml;
-    oHTML[ "Yacute" ] = HTML::Yacute;
-    oHTML[ "THORN" ] = HTML::THORN;
-    oHTML[ "szlig" ] = HTML::szlig;
-    oHTML[ "agrave" ] = HTML::agrave;
-    oHTML[ "aacute" ] = HTML::aacute;
-    oHTML[ "acirc" ] = HTML::acirc;
-    oHTML[ "atilde" ] = HTML::atilde;
-    oHTML[ "auml" ] = HTML::auml;
-    oHTML[ "aring" ] = HTML::aring;
-    oHTML[ "aelig" ] = HTML::aelig;
-    oHTML[ "ccedil" ] = HTML::ccedil;
-    oHTML[ "egrave" ] = HTML::egrave;
-    oHTML[ "eacute" ] = HTML::eacute;
-    oHTML[ "ecirc" ] = HTML::ecirc;
-    oHTML[ "euml" ] = HTML::euml;
-    oHTML[ "igrave" ] = HTML::igrave;
-    oHTML[ "iacute" ] = HTML::iacute;
-    oHTML[ "icirc" ] = HTML::icirc;
-    oHTML[ "iuml" ] = HTML::iuml;
-    oHTML[ "eth" ] = HTML::eth;
-    oHTML[ "ntilde" ] = HTML::ntilde;
-    oHTML[ "ograve" ] = HTML::ograve;
-    oHTML[ "oacute" ] = HTML::oacute;
-    oHTML[ "ocirc" ] = HTML::ocirc;
-    oHTML[ "otilde" ] = HTML::otilde;
-    oHTML[ "ouml" ] = HTML::ouml;
-    oHTML[ "divide" ] = HTML::divide;
-    oHTML[ "oslash" ] = HTML::oslash;
-    oHTML[ "ugrave" ] = HTML::ugrave;
-    oHTML[ "uacute" ] = HTML::uacute;
-    oHTML[ "ucirc" ] = HTML::ucirc;
-    oHTML[ "uuml" ] = HTML::uuml;
-    oHTML[ "yacute" ] = HTML::yacute;
-    oHTML[ "thorn" ] = HTML::thorn;
-    oHTML[ "yuml" ] = HTML::yuml;
+    for( unsigned int ui = 0; ui < sg_uiNameCount; ++ui )
+    {
+        oHTML[ sg_aoNames[ ui ].pcName ] = sg_aoNames[ ui ].cCharacter;
+    }
 
     // return the resulting character map
     return oHTML;
 }   // HTMLMap()
+
 }   // namespace
 
 namespace HTML
 {
+
 const MyFirstEngine::CharacterMap& Map()
 {
     static MyFirstEngine::CharacterMap soMap = HTMLMap();
     return soMap;
 }
-}
\ No newline at end of file
+
+bool Find( const char* ac_pcName, std::size_t a_uiLength, char& a_rcCharacter )
+{
+    if( nullptr == ac_pcName || 0 == a_uiLength )
+    {
+        return false;
+    }
+
+    // a single character other than null stands for itself
+    if( 1 == a_uiLength )
+    {
+        if( '\0' == ac_pcName[0] )
+        {
+            return false;
+        }
+        a_rcCharacter = ac_pcName[0];
+        return true;
+    }
+
+    // number codes ("#38", "x26", "#x26", or "#X26")
+    if( '#' == ac_pcName[0] )
+    {
+        return ( 'x' == ac_pcName[1] || 'X' == ac_pcName[1] )
+                ? ParseNumber( ac_pcName + 2, a_uiLength - 2, 16,
+                               a_rcCharacter )
+                : ParseNumber( ac_pcName + 1, a_uiLength - 1, 10,
+                               a_rcCharacter );
+    }
+    if( 'x' == ac_pcName[0] &&
+        ParseNumber( ac_pcName + 1, a_uiLength - 1, 16, a_rcCharacter ) )
+    {
+        return true;
+    }
+
+    // HTML names
+    unsigned int uiLow = 0;
+    unsigned int uiHigh = sg_uiNameCount;
+    while( uiLow < uiHigh )
+    {
+        unsigned int uiMiddle = uiLow + ( uiHigh - uiLow ) / 2;
+        int iOrder = Compare( ac_pcName, a_uiLength,
+                              sg_aoNames[ uiMiddle ].pcName );
+        if( 0 == iOrder )
+        {
+            a_rcCharacter = sg_aoNames[ uiMiddle ].cCharacter;
+            return true;
+        }
+        if( 0 > iOrder )
+        {
+            uiHigh = uiMiddle;
+        }
+        else
+        {
+            uiLow = uiMiddle + 1;
+        }
+    }
+    return false;
+}
+bool Find( const char* ac_pcName, char& a_rcCharacter )
+{
+    return ( nullptr != ac_pcName &&
+             Find( ac_pcName, std::strlen( ac_pcName ), a_rcCharacter ) );
+}
+
+}   // namespace HTML
@@ -0,0 +1,357 @@
+/******************************************************************************
+ * File:               Input.cpp
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Implementations for Input functions.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Carrying the clock on from the last replayed frame once a
+ *                      replay runs out.
+ ******************************************************************************/
+
+#include "../Declarations/GameEngine.h"
+#include "../Declarations/GLFW.h"
+#include "../Declarations/Input.h"
+#include "../Declarations/Keyboard.h"
+#include "../Declarations/Mouse.h"
+#include "../Declarations/Profiler.h"
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+//
+// File-only helper variables and functions
+//
+namespace
+{
+
+// Events posted but not yet applied, oldest first
+static Utility::EventQueue< MyFirstEngine::Input::Event >
+    sg_oEvents( MyFirstEngine::Input::QUEUE_CAPACITY );
+
+// Identifies an input recording, along with the version of the file layout
+const char sg_acMagic[4] = { 'M', 'F', 'I', 'R' };
+const unsigned int sg_uiVersion = 1;
+
+// Recordings are built up in memory and only written to the file once this
+// much has piled up, so recording a frame costs a few small copies
+const unsigned int RECORD_BUFFER_SIZE = 65536;
+
+// After the header, a recording is a list of frames, each of which is:
+//
+//   double         frame time
+//   double, double cursor position relative to the main window's top left
+//   unsigned char  1 if the cursor was in the main window, 0 if not
+//   unsigned short number of events applied during the frame, each of which
+//                  is a double time, an unsigned short key or button, an
+//                  unsigned char device, and an unsigned char 1 for pressed
+//                  or 0 for released
+//
+// Fields are written one at a time, so there's no padding.
+static bool sg_bRecording = false;
+static std::ofstream sg_oRecordFile;
+static std::vector< char > sg_oRecordBuffer;
+
+// Recording being played back, and how far into it the replay has got
+static bool sg_bReplaying = false;
+static std::vector< char > sg_oReplayData;
+static unsigned int sg_uiReplayPosition = 0;
+
+// The last time replayed, and the live time it was replayed at, so the clock
+// can carry on from there once the replay runs out
+static double sg_dReplayedTime = 0.0;
+static double sg_dReplayedAt = 0.0;
+
+// Add a field to the end of the recording buffer
+template< typename T >
+void WriteField( const T& ac_rValue )
+{
+    const char* pcValue = (const char*)&ac_rValue;
+    sg_oRecordBuffer.insert( sg_oRecordBuffer.end(),
+                             pcValue, pcValue + sizeof( T ) );
+}
+
+// Read the next field of the replay, returning false if the recording has run
+// out
+template< typename T >
+bool ReadField( T& a_rValue )
+{
+    if( sg_oReplayData.size() - sg_uiReplayPosition < sizeof( T ) )
+    {
+        return false;
+    }
+    std::memcpy( &a_rValue, &( sg_oReplayData[ sg_uiReplayPosition ] ),
+                 sizeof( T ) );
+    sg_uiReplayPosition += sizeof( T );
+    return true;
+}
+
+// Write out everything recorded so far
+void Flush()
+{
+    if( !sg_oRecordBuffer.empty() )
+    {
+        sg_oRecordFile.write( &( sg_oRecordBuffer[0] ),
+                              sg_oRecordBuffer.size() );
+        sg_oRecordBuffer.clear();
+    }
+}
+
+// Record an event applied during the current frame
+void WriteEvent( const MyFirstEngine::Input::Event& ac_roEvent )
+{
+    WriteField( ac_roEvent.dTime );
+    WriteField( (unsigned short)ac_roEvent.iCode );
+    WriteField( (unsigned char)ac_roEvent.eDevice );
+    WriteField( (unsigned char)( ac_roEvent.bPressed ? 1 : 0 ) );
+}
+
+// Read an event applied during the frame being replayed
+bool ReadEvent( MyFirstEngine::Input::Event& a_roEvent )
+{
+    unsigned short usCode = 0;
+    unsigned char ucDevice = 0;
+    unsigned char ucPressed = 0;
+    if( !ReadField( a_roEvent.dTime ) || !ReadField( usCode ) ||
+        !ReadField( ucDevice ) || !ReadField( ucPressed ) )
+    {
+        return false;
+    }
+    a_roEvent.iCode = usCode;
+    a_roEvent.eDevice = (MyFirstEngine::Input::Device)ucDevice;
+    a_roEvent.bPressed = ( 0 != ucPressed );
+    return true;
+}
+
+}   // namespace
+
+namespace MyFirstEngine
+{
+
+// Queue an event along with the time it happened
+bool Input::Post( Device a_eDevice, int a_iCode, bool a_bPressed,
+                  double a_dTime )
+{
+    Event oEvent = { a_dTime, a_eDevice, a_iCode, a_bPressed };
+    return sg_oEvents.Push( oEvent );
+}
+
+// Events stamped after the frame's time are left for the next frame, so
+// nothing a frame sees happened after the frame started
+double Input::Update( double a_dTime )
+{
+    PROFILE_ZONE( "Input::Update" );
+    Keyboard::NewFrame();
+    Mouse::NewFrame();
+    if( sg_bReplaying )
+    {
+        sg_oEvents.Clear();
+        double dTime = 0.0;
+        if( ReplayFrame( dTime ) )
+        {
+            sg_dReplayedTime = dTime;
+            sg_dReplayedAt = a_dTime;
+            return dTime;
+        }
+        StopReplay();
+
+        // Move the clock so this frame's time is as far after the last frame
+        // replayed as it is after the live time that frame was replayed at,
+        // instead of jumping back to live time
+        double dRebased = sg_dReplayedTime + ( a_dTime - sg_dReplayedAt );
+        glfwSetTime( glfwGetTime() + ( dRebased - a_dTime ) );
+        a_dTime = dRebased;
+    }
+
+    // When recording, the frame's event count isn't known until they've all
+    // been applied, so leave room for it and fill it in afterwards
+    unsigned int uiCountPosition = 0;
+    unsigned short usCount = 0;
+    if( sg_bRecording )
+    {
+        double dX = 0.0;
+        double dY = 0.0;
+        bool bInMainWindow = false;
+        Mouse::GetCursor( dX, dY, bInMainWindow );
+        Mouse::FreezeCursor( dX, dY, bInMainWindow, a_dTime );
+        WriteField( a_dTime );
+        WriteField( dX );
+        WriteField( dY );
+        WriteField( (unsigned char)( bInMainWindow ? 1 : 0 ) );
+        uiCountPosition = (unsigned int)sg_oRecordBuffer.size();
+        WriteField( usCount );
+    }
+
+    Event oEvent;
+    while( sg_oEvents.Peek( oEvent ) && oEvent.dTime <= a_dTime )
+    {
+        sg_oEvents.Pop( oEvent );
+        Dispatch( oEvent );
+        if( sg_bRecording )
+        {
+            WriteEvent( oEvent );
+            ++usCount;
+        }
+    }
+
+    if( sg_bRecording )
+    {
+        std::memcpy( &( sg_oRecordBuffer[ uiCountPosition ] ), &usCount,
+                     sizeof( usCount ) );
+        if( RECORD_BUFFER_SIZE <= sg_oRecordBuffer.size() )
+        {
+            Flush();
+        }
+    }
+    return a_dTime;
+}
+
+unsigned int Input::Dropped()
+{
+    return sg_oEvents.Dropped();
+}
+
+// Start a new recording file with the time of the frame before the first one
+// recorded, so the first frame's delta time can be replayed too
+bool Input::StartRecording( const char* ac_pcFileName )
+{
+    if( sg_bReplaying )
+    {
+        return false;
+    }
+    StopRecording();
+    sg_oRecordFile.open( ac_pcFileName,
+                         std::ios::out | std::ios::binary | std::ios::trunc );
+    if( !sg_oRecordFile )
+    {
+        sg_oRecordFile.close();
+        sg_oRecordFile.clear();
+        return false;
+    }
+    sg_oRecordBuffer.reserve( 2 * RECORD_BUFFER_SIZE );
+    WriteField( sg_acMagic );
+    WriteField( sg_uiVersion );
+    WriteField( GameEngine::LastTime() );
+    sg_bRecording = true;
+    return true;
+}
+void Input::StopRecording()
+{
+    if( sg_bRecording )
+    {
+        Flush();
+        sg_oRecordFile.close();
+        sg_oRecordFile.clear();
+        sg_bRecording = false;
+        Mouse::UnfreezeCursor();
+    }
+}
+bool Input::IsRecording()
+{
+    return sg_bRecording;
+}
+
+// Load the whole recording up front, so replaying doesn't touch the disk
+bool Input::StartReplay( const char* ac_pcFileName )
+{
+    if( sg_bRecording )
+    {
+        return false;
+    }
+    StopReplay();
+    std::ifstream oFile( ac_pcFileName, std::ios::in | std::ios::binary );
+    if( !oFile )
+    {
+        return false;
+    }
+    oFile.seekg( 0, std::ios::end );
+    std::streamoff lSize = oFile.tellg();
+    oFile.seekg( 0, std::ios::beg );
+    if( 0 >= lSize )
+    {
+        return false;
+    }
+    sg_oReplayData.resize( (unsigned int)lSize );
+    oFile.read( &( sg_oReplayData[0] ), lSize );
+    sg_uiReplayPosition = 0;
+
+    char acMagic[4];
+    unsigned int uiVersion = 0;
+    double dStartTime = 0.0;
+    if( !oFile.good() || !ReadField( acMagic ) ||
+        0 != std::memcmp( acMagic, sg_acMagic, sizeof( acMagic ) ) ||
+        !ReadField( uiVersion ) || sg_uiVersion != uiVersion ||
+        !ReadField( dStartTime ) )
+    {
+        std::vector< char >().swap( sg_oReplayData );
+        return false;
+    }
+    GameEngine::Instance().m_dLastTime = dStartTime;
+    sg_dReplayedTime = dStartTime;
+    sg_dReplayedAt = GameEngine::Time();
+    sg_bReplaying = true;
+    return true;
+}
+void Input::StopReplay()
+{
+    if( sg_bReplaying )
+    {
+        std::vector< char >().swap( sg_oReplayData );
+        sg_uiReplayPosition = 0;
+        sg_bReplaying = false;
+        Mouse::UnfreezeCursor();
+    }
+}
+bool Input::IsReplaying()
+{
+    return sg_bReplaying;
+}
+
+// Finish any recording, and don't let events or replays left over from before
+// termination carry on after reinitialization
+void Input::TerminateInstance()
+{
+    StopRecording();
+    StopReplay();
+    sg_oEvents.Clear();
+}
+
+// Send an event to whichever class keeps track of its device
+void Input::Dispatch( const Event& ac_roEvent )
+{
+    if( KEYBOARD == ac_roEvent.eDevice )
+    {
+        Keyboard::Apply( ac_roEvent );
+    }
+    else if( MOUSE_BUTTON == ac_roEvent.eDevice )
+    {
+        Mouse::Apply( ac_roEvent );
+    }
+}
+
+// Apply the next frame of the recording being replayed, or return false if
+// there isn't a whole frame left
+bool Input::ReplayFrame( double& a_rdTime )
+{
+    double dX = 0.0;
+    double dY = 0.0;
+    unsigned char ucInMainWindow = 0;
+    unsigned short usCount = 0;
+    if( !ReadField( a_rdTime ) || !ReadField( dX ) || !ReadField( dY ) ||
+        !ReadField( ucInMainWindow ) || !ReadField( usCount ) )
+    {
+        return false;
+    }
+    Mouse::FreezeCursor( dX, dY, 0 != ucInMainWindow, a_rdTime );
+    Event oEvent;
+    for( unsigned short us = 0; us < usCount; ++us )
+    {
+        if( !ReadEvent( oEvent ) )
+        {
+            return false;
+        }
+        Dispatch( oEvent );
+    }
+    return true;
+}
+
+}   // namespace MyFirstEngine
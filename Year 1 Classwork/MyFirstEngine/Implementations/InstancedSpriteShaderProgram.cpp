@@ -0,0 +1,264 @@
+/******************************************************************************
+ * File:               InstancedSpriteShaderProgram.cpp
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Implementation for InstancedSpriteShaderProgram
+ *                      functions.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Counting the uniforms actually set, and asking the
+ *                      stream buffer how much room is left.
+ ******************************************************************************/
+
+#include "../Declarations/InstancedSpriteShaderProgram.h"
+#include "../Declarations/Profiler.h"
+#include "../Declarations/QuadShaderProgram.h"
+#include "../Declarations/SpriteShaderProgram.h"
+#include <cstddef>
+#include <cstring>
+
+namespace MyFirstEngine
+{
+
+// default instanced sprite shader source code files
+const char* const InstancedSpriteShaderProgram::
+    INSTANCED_SPRITE_VERTEX_SHADER_FILE =
+        "resources/shaders/InstancedSpriteVertex.glsl";
+const char* const InstancedSpriteShaderProgram::
+    INSTANCED_SPRITE_FRAGMENT_SHADER_FILE =
+        "resources/shaders/InstancedSpriteFragment.glsl";
+
+// only the parent class's Initialize function can call this.
+InstancedSpriteShaderProgram::InstancedSpriteShaderProgram()
+    : m_iTextureID( 0 ), m_iFramesID( 0 ), m_iModelViewProjectionID( 0 ),
+      m_iColorID( 0 ), m_iFrameID( 0 ), m_uiVertexArrayID( 0 ),
+      m_uiFrameBufferID( 0 ), m_uiFrameTextureID( 0 ),
+      m_poInstances( nullptr ),
+      ShaderProgram( Shader( GL_VERTEX_SHADER,
+                             INSTANCED_SPRITE_VERTEX_SHADER_FILE ),
+                     Shader( GL_FRAGMENT_SHADER,
+                             INSTANCED_SPRITE_FRAGMENT_SHADER_FILE ) ) {}
+
+// Destroy data used by the shader
+void InstancedSpriteShaderProgram::DestroyData()
+{
+    // Zero out uniform variable and attribute locations
+    m_iTextureID = 0;
+    m_iFramesID = 0;
+    m_iModelViewProjectionID = 0;
+    m_iColorID = 0;
+    m_iFrameID = 0;
+
+    // Destroy the vertex array object
+    glDeleteVertexArrays( 1, &m_uiVertexArrayID );
+    m_uiVertexArrayID = 0;
+
+    // Destroy the frame table
+    glDeleteTextures( 1, &m_uiFrameTextureID );
+    m_uiFrameTextureID = 0;
+    glDeleteBuffers( 1, &m_uiFrameBufferID );
+    m_uiFrameBufferID = 0;
+
+    // Destroy the instance buffer
+    if( nullptr != m_poInstances )
+    {
+        m_poInstances->Destroy();
+        delete m_poInstances;
+        m_poInstances = nullptr;
+    }
+}
+
+// Load data used by the shader
+void InstancedSpriteShaderProgram::SetupData()
+{
+    // Get uniform variable and attribute locations
+    GLint iTextureID = glGetUniformLocation( m_uiID, "u_t2dTexture" );
+    GLint iFramesID = glGetUniformLocation( m_uiID, "u_tbFrames" );
+    GLint iModelViewProjectionID =
+        glGetAttribLocation( m_uiID, "i_m4ModelViewProjection" );
+    GLint iColorID = glGetAttribLocation( m_uiID, "i_v4Color" );
+    GLint iFrameID = glGetAttribLocation( m_uiID, "i_uiFrame" );
+
+    // Create vertex array object
+    GLuint uiVAO;
+    glGenVertexArrays( 1, &uiVAO );
+    glBindVertexArray( uiVAO );
+
+    // Use Quad and Sprite shaders' element, vertex, and texture coordinate
+    // arrays
+    QuadShaderProgram::BindElementBuffer();
+    QuadShaderProgram::BindVertexBuffer( *this, "i_v2Position" );
+    SpriteShaderProgram::BindTexCoordinateBuffer( *this, "i_v2TexCoordinate" );
+
+    // Instance attributes advance once per instance, not once per vertex.  A
+    // mat4 attribute takes up four consecutive locations, one per column.
+    // Attributes the shader doesn't use have no location, and are skipped.
+    if( 0 <= iModelViewProjectionID )
+    {
+        for( GLint i = 0; i < 4; ++i )
+        {
+            glEnableVertexAttribArray( iModelViewProjectionID + i );
+            glVertexAttribDivisor( iModelViewProjectionID + i, 1 );
+        }
+    }
+    if( 0 <= iColorID )
+    {
+        glEnableVertexAttribArray( iColorID );
+        glVertexAttribDivisor( iColorID, 1 );
+    }
+    if( 0 <= iFrameID )
+    {
+        glEnableVertexAttribArray( iFrameID );
+        glVertexAttribDivisor( iFrameID, 1 );
+    }
+
+    // Unbind vertex array object so that other initialization calls can't
+    // accidentally add things to it
+    glBindVertexArray( 0 );
+    glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, 0 );
+    glBindBuffer( GL_ARRAY_BUFFER, 0 );
+
+    // Create the frame table buffer and a texture to read it through
+    GLuint uiFrameBuffer;
+    glGenBuffers( 1, &uiFrameBuffer );
+    glBindBuffer( GL_TEXTURE_BUFFER, uiFrameBuffer );
+    glBufferData( GL_TEXTURE_BUFFER, sizeof( SpriteBatch::FrameDescriptor ),
+                  nullptr, GL_DYNAMIC_DRAW );
+    GLuint uiFrameTexture;
+    glGenTextures( 1, &uiFrameTexture );
+    glBindTexture( GL_TEXTURE_BUFFER, uiFrameTexture );
+    glTexBuffer( GL_TEXTURE_BUFFER, GL_RGBA32F, uiFrameBuffer );
+    glBindTexture( GL_TEXTURE_BUFFER, 0 );
+    glBindBuffer( GL_TEXTURE_BUFFER, 0 );
+
+    // now that everything is initialized, store IDs in member variables
+    m_iTextureID = iTextureID;
+    m_iFramesID = iFramesID;
+    m_iModelViewProjectionID = iModelViewProjectionID;
+    m_iColorID = iColorID;
+    m_iFrameID = iFrameID;
+    m_uiVertexArrayID = uiVAO;
+    m_uiFrameBufferID = uiFrameBuffer;
+    m_uiFrameTextureID = uiFrameTexture;
+    m_poInstances = new StreamBuffer( INSTANCES_PER_FRAME *
+                                      sizeof( SpriteBatch::Instance ) );
+}
+
+// Bind vertex array
+void InstancedSpriteShaderProgram::UseData() const
+{
+    glBindVertexArray( m_uiVertexArrayID );
+}
+
+// Point the instance attributes at the given offset in the instance buffer
+void InstancedSpriteShaderProgram::
+    BindInstances( unsigned int a_uiOffset ) const
+{
+    const GLsizei ciStride = sizeof( SpriteBatch::Instance );
+    const char* pcOffset = (const char*)nullptr + a_uiOffset;
+    glBindBuffer( GL_ARRAY_BUFFER, m_poInstances->ID() );
+    if( 0 <= m_iModelViewProjectionID )
+    {
+        for( GLint i = 0; i < 4; ++i )
+        {
+            glVertexAttribPointer( m_iModelViewProjectionID + i, 4, GL_FLOAT,
+                                   GL_FALSE, ciStride,
+                                   pcOffset + i * 4 * sizeof( float ) );
+        }
+    }
+    if( 0 <= m_iColorID )
+    {
+        glVertexAttribPointer( m_iColorID, 4, GL_UNSIGNED_BYTE, GL_TRUE,
+                               ciStride, pcOffset +
+                               offsetof( SpriteBatch::Instance, oColor ) );
+    }
+    if( 0 <= m_iFrameID )
+    {
+        glVertexAttribIPointer( m_iFrameID, 1, GL_UNSIGNED_INT, ciStride,
+                                pcOffset +
+                                offsetof( SpriteBatch::Instance, uiFrame ) );
+    }
+    glBindBuffer( GL_ARRAY_BUFFER, 0 );
+}
+
+//
+// Static functions
+//
+
+// Replace the frame table
+void InstancedSpriteShaderProgram::
+    SetFrameTable( const SpriteBatch::FrameDescriptor* ac_paoFrames,
+                   unsigned int a_uiCount )
+{
+    glBindBuffer( GL_TEXTURE_BUFFER, Instance().m_uiFrameBufferID );
+    glBufferData( GL_TEXTURE_BUFFER,
+                  a_uiCount * sizeof( SpriteBatch::FrameDescriptor ),
+                  ac_paoFrames, GL_DYNAMIC_DRAW );
+    glBindBuffer( GL_TEXTURE_BUFFER, 0 );
+}
+
+// Start and finish a run of draws sharing a region of the instance buffer
+void InstancedSpriteShaderProgram::BeginInstances()
+{
+    Instance().m_poInstances->BeginFrame();
+}
+void InstancedSpriteShaderProgram::EndInstances()
+{
+    Instance().m_poInstances->EndFrame();
+}
+
+// Draw textured 1x1 quads, one per instance
+void InstancedSpriteShaderProgram::
+    DrawInstances( Texture& a_roTexture,
+                   const SpriteBatch::Instance* ac_paoInstances,
+                   unsigned int a_uiCount )
+{
+    InstancedSpriteShaderProgram& roProgram = Instance();
+
+    // start using shader program, texture, and frame table
+    roProgram.Use();
+    a_roTexture.MakeCurrent();
+    glActiveTexture( GL_TEXTURE1 );
+    glBindTexture( GL_TEXTURE_BUFFER, roProgram.m_uiFrameTextureID );
+    glActiveTexture( GL_TEXTURE0 );
+
+    // Point each sampler at its texture unit - everything else is per-instance
+    const GLint caiSamplers[][2] = { { roProgram.m_iTextureID, 0 },
+                                     { roProgram.m_iFramesID, 1 } };
+    const unsigned int cuiSamplers = sizeof( caiSamplers ) /
+                                     sizeof( caiSamplers[0] );
+    for( unsigned int ui = 0; ui < cuiSamplers; ++ui )
+    {
+        glUniform1i( caiSamplers[ ui ][0], caiSamplers[ ui ][1] );
+    }
+    PROFILE_COUNT( UNIFORM_UPLOADS, cuiSamplers );
+
+    // Stream the instances into what's left of the current region, moving on
+    // to the next region only when this one fills up
+    StreamBuffer& roStream = *roProgram.m_poInstances;
+    const unsigned int cuiAlignment = StreamBuffer::DEFAULT_ALIGNMENT;
+    while( 0 < a_uiCount )
+    {
+        unsigned int uiRoom = roStream.Available( cuiAlignment ) /
+                              sizeof( SpriteBatch::Instance );
+        if( 0 == uiRoom )
+        {
+            roStream.EndFrame();
+            roStream.BeginFrame();
+            continue;
+        }
+        unsigned int uiCount = ( uiRoom < a_uiCount ? uiRoom : a_uiCount );
+        unsigned int uiSize = uiCount * sizeof( SpriteBatch::Instance );
+        StreamBuffer::Allocation oAllocation =
+            roStream.Allocate( uiSize, cuiAlignment );
+        std::memcpy( oAllocation.pData, ac_paoInstances, uiSize );
+        roStream.Submit();
+        roProgram.BindInstances( oAllocation.uiOffset );
+        glDrawElementsInstanced( GL_TRIANGLE_STRIP, 4, GL_UNSIGNED_INT, 0,
+                                 uiCount );
+        PROFILE_COUNT( DRAW_CALLS, 1 );
+        ac_paoInstances += uiCount;
+        a_uiCount -= uiCount;
+    }
+}
+
+}   // MyFirstEngine
@@ -3,14 +3,15 @@
  * Author:             Elizabeth Lowry
  * Date Created:       March 25, 2014
  * Description:        Class for managing keyboard
- * Last Modified:      March 25, 2014
- * Last Modification:  Creation.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Flat key state tables, per-frame pressed and released
+ *                      keys, and events applied through Input.
  ******************************************************************************/
 
 #include "../Declarations/GameEngine.h"
 #include "../Declarations/GLFW.h"
 #include "../Declarations/Keyboard.h"
-#include <unordered_map>
+#include <cstring>
 
 //
 // File-only helper functions and variables
@@ -18,7 +19,7 @@
 namespace
 {
 
-// Store the times when each key was last pressed or released
+// Store the times when a key or key combination was last pressed or released
 struct Times
 {
     double pressed;
@@ -29,7 +30,18 @@ struct Times
                 std::max( pressed, released );
     }
 };
-static std::unordered_map< MyFirstEngine::Keyboard::Key, Times > sg_oKeyTimes;
+
+// Key states are kept in tables indexed by key code.  Most codes aren't keys,
+// but the tables are small enough that looking a key up is just an index.
+static const unsigned int KEY_WORDS =
+    ( MyFirstEngine::Keyboard::KEY_COUNT + 31 ) / 32;
+static double sg_adPressTimes[ MyFirstEngine::Keyboard::KEY_COUNT ];
+static double sg_adReleaseTimes[ MyFirstEngine::Keyboard::KEY_COUNT ];
+
+// One bit per key - is it down, and did it go down or come up this frame?
+static unsigned int sg_auiDown[ KEY_WORDS ];
+static unsigned int sg_auiPressed[ KEY_WORDS ];
+static unsigned int sg_auiReleased[ KEY_WORDS ];
 
 // press times for key combinations
 static Times sg_oAnyKeyTimes = { 0.0, 0.0 };
@@ -45,134 +57,173 @@ static unsigned int sg_uiCtrlKeysPressed = 0;
 static unsigned int sg_uiAltKeysPressed = 0;
 static unsigned int sg_uiSuperKeysPressed = 0;
 
-// callback for handling keypresses
+// Read or change a key's bit
+bool TestBit( const unsigned int* ac_pauiBits, unsigned int a_uiKey )
+{
+    return 0 != ( ac_pauiBits[ a_uiKey >> 5 ] & ( 1u << ( a_uiKey & 31 ) ) );
+}
+void SetBit( unsigned int* a_pauiBits, unsigned int a_uiKey )
+{
+    a_pauiBits[ a_uiKey >> 5 ] |= ( 1u << ( a_uiKey & 31 ) );
+}
+void ClearBit( unsigned int* a_pauiBits, unsigned int a_uiKey )
+{
+    a_pauiBits[ a_uiKey >> 5 ] &= ~( 1u << ( a_uiKey & 31 ) );
+}
+
+// Is the given value something the state tables have room for?
+bool InTable( int a_iKey )
+{
+    return ( 0 <= a_iKey && MyFirstEngine::Keyboard::KEY_COUNT > a_iKey );
+}
+
+// callback for handling keypresses - just queue them up for the next frame
 void KeyPressCallback( GLFWwindow* a_poWindow, int a_iKey, int a_iScanCode,
                        int a_iAction, int a_iMods )
 {
     // check to see if the given key is one that can be tracked
-    if( !MyFirstEngine::Keyboard::IsKey( a_iKey ) )
+    if( MyFirstEngine::Keyboard::IsKey( a_iKey ) &&
+        ( GLFW_PRESS == a_iAction || GLFW_RELEASE == a_iAction ) )
+    {
+        MyFirstEngine::Input::Post( MyFirstEngine::Input::KEYBOARD, a_iKey,
+                                    GLFW_PRESS == a_iAction,
+                                    MyFirstEngine::GameEngine::Time() );
+    }
+}
+
+}   // namespace
+
+//
+// Class functions
+//
+namespace MyFirstEngine
+{
+
+// is the given int a valid key?
+bool Keyboard::IsKey( int a_i )
+{
+    return ( 32 == a_i || 39 == a_i || ( 44 <= a_i && 57 >= a_i ) ||
+             59 == a_i || 61 == a_i || ( 65 <= a_i && 93 >= a_i ) ||
+             96 == a_i || 161 == a_i || 162 == a_i ||
+             ( 256 <= a_i && 269 >= a_i ) || ( 280 <= a_i && 284 >= a_i ) ||
+             ( 290 <= a_i && 314 >= a_i ) || ( 320 <= a_i && 336 >= a_i ) ||
+             ( 340 <= a_i && 348 >= a_i ) );
+}
+
+// clean up data
+void Keyboard::TerminateInstance()
+{
+    std::memset( sg_adPressTimes, 0, sizeof( sg_adPressTimes ) );
+    std::memset( sg_adReleaseTimes, 0, sizeof( sg_adReleaseTimes ) );
+    std::memset( sg_auiDown, 0, sizeof( sg_auiDown ) );
+    std::memset( sg_auiPressed, 0, sizeof( sg_auiPressed ) );
+    std::memset( sg_auiReleased, 0, sizeof( sg_auiReleased ) );
+    sg_oAnyKeyTimes.pressed = 0.0;
+    sg_oAnyKeyTimes.released = 0.0;
+    sg_oShiftKeyTimes.pressed = 0.0;
+    sg_oShiftKeyTimes.released = 0.0;
+    sg_oCtrlKeyTimes.pressed = 0.0;
+    sg_oCtrlKeyTimes.released = 0.0;
+    sg_oAltKeyTimes.pressed = 0.0;
+    sg_oAltKeyTimes.released = 0.0;
+    sg_oSuperKeyTimes.pressed = 0.0;
+    sg_oSuperKeyTimes.released = 0.0;
+    sg_uiKeysPressed = 0;
+    sg_uiShiftKeysPressed = 0;
+    sg_uiCtrlKeysPressed = 0;
+    sg_uiAltKeysPressed = 0;
+    sg_uiSuperKeysPressed = 0;
+}
+
+// Forget which keys changed last frame
+void Keyboard::NewFrame()
+{
+    std::memset( sg_auiPressed, 0, sizeof( sg_auiPressed ) );
+    std::memset( sg_auiReleased, 0, sizeof( sg_auiReleased ) );
+}
+
+// Apply a key event at the time it happened
+void Keyboard::Apply( const Input::Event& ac_roEvent )
+{
+    if( !IsKey( ac_roEvent.iCode ) )
     {
         return;
     }
-    MyFirstEngine::Keyboard::Key eKey = (MyFirstEngine::Keyboard::Key)a_iKey;
+    Key eKey = (Key)ac_roEvent.iCode;
+    double dTime = ac_roEvent.dTime;
 
     // If pressing the key when it was not pressed earlier,
-    if( GLFW_PRESS == a_iAction &&
-        sg_oKeyTimes[ eKey ].pressed <= sg_oKeyTimes[ eKey ].released )
+    if( ac_roEvent.bPressed && !TestBit( sg_auiDown, eKey ) )
     {
         // store press time
-        sg_oKeyTimes[ eKey ].pressed = MyFirstEngine::GameEngine::LastTime();
+        SetBit( sg_auiDown, eKey );
+        SetBit( sg_auiPressed, eKey );
+        sg_adPressTimes[ eKey ] = dTime;
         if( 1 == ++sg_uiKeysPressed )
         {
-            sg_oAnyKeyTimes.pressed = MyFirstEngine::GameEngine::LastTime();
+            sg_oAnyKeyTimes.pressed = dTime;
         }
 
         // check for modifier key presses
-        if( ( MyFirstEngine::Keyboard::LEFT_SHIFT == eKey ||
-              MyFirstEngine::Keyboard::RIGHT_SHIFT == eKey ) &&
+        if( ( LEFT_SHIFT == eKey || RIGHT_SHIFT == eKey ) &&
             1 == ++sg_uiShiftKeysPressed )
         {
-            sg_oShiftKeyTimes.pressed = MyFirstEngine::GameEngine::LastTime();
+            sg_oShiftKeyTimes.pressed = dTime;
         }
-        else if( ( MyFirstEngine::Keyboard::LEFT_CONTROL == eKey ||
-                   MyFirstEngine::Keyboard::RIGHT_CONTROL == eKey ) &&
+        else if( ( LEFT_CONTROL == eKey || RIGHT_CONTROL == eKey ) &&
                  1 == ++sg_uiCtrlKeysPressed )
         {
-            sg_oCtrlKeyTimes.pressed = MyFirstEngine::GameEngine::LastTime();
+            sg_oCtrlKeyTimes.pressed = dTime;
         }
-        else if( ( MyFirstEngine::Keyboard::LEFT_ALT == eKey ||
-                   MyFirstEngine::Keyboard::RIGHT_ALT == eKey ) &&
+        else if( ( LEFT_ALT == eKey || RIGHT_ALT == eKey ) &&
                  1 == ++sg_uiAltKeysPressed )
         {
-            sg_oAltKeyTimes.pressed = MyFirstEngine::GameEngine::LastTime();
+            sg_oAltKeyTimes.pressed = dTime;
         }
-        else if( ( MyFirstEngine::Keyboard::LEFT_SUPER == eKey ||
-                   MyFirstEngine::Keyboard::RIGHT_SUPER == eKey ) &&
+        else if( ( LEFT_SUPER == eKey || RIGHT_SUPER == eKey ) &&
                  1 == ++sg_uiSuperKeysPressed )
         {
-            sg_oSuperKeyTimes.pressed = MyFirstEngine::GameEngine::LastTime();
+            sg_oSuperKeyTimes.pressed = dTime;
         }
     }
-    
-    // If releasing the key when it was not pressed earlier,
-    else if( GLFW_RELEASE == a_iAction &&
-        sg_oKeyTimes[ eKey ].pressed >= sg_oKeyTimes[ eKey ].released )
+
+    // If releasing the key when it was pressed earlier,
+    else if( !ac_roEvent.bPressed && TestBit( sg_auiDown, eKey ) )
     {
         // store release time
-        sg_oKeyTimes[ eKey ].released = MyFirstEngine::GameEngine::LastTime();
+        ClearBit( sg_auiDown, eKey );
+        SetBit( sg_auiReleased, eKey );
+        sg_adReleaseTimes[ eKey ] = dTime;
         if( 0 == sg_uiKeysPressed || 0 == --sg_uiKeysPressed )
         {
-            sg_oAnyKeyTimes.released = MyFirstEngine::GameEngine::LastTime();
+            sg_oAnyKeyTimes.released = dTime;
         }
 
         // check for modifier key releases
-        if( ( MyFirstEngine::Keyboard::LEFT_SHIFT == eKey ||
-              MyFirstEngine::Keyboard::RIGHT_SHIFT == eKey ) &&
+        if( ( LEFT_SHIFT == eKey || RIGHT_SHIFT == eKey ) &&
             ( 0 == sg_uiShiftKeysPressed || 0 == --sg_uiShiftKeysPressed ) )
         {
-            sg_oShiftKeyTimes.released = MyFirstEngine::GameEngine::LastTime();
+            sg_oShiftKeyTimes.released = dTime;
         }
-        else if( ( MyFirstEngine::Keyboard::LEFT_CONTROL == eKey ||
-                   MyFirstEngine::Keyboard::RIGHT_CONTROL == eKey ) &&
+        else if( ( LEFT_CONTROL == eKey || RIGHT_CONTROL == eKey ) &&
                  ( 0 == sg_uiCtrlKeysPressed || 0 == --sg_uiCtrlKeysPressed ) )
         {
-            sg_oCtrlKeyTimes.released = MyFirstEngine::GameEngine::LastTime();
+            sg_oCtrlKeyTimes.released = dTime;
         }
-        else if( ( MyFirstEngine::Keyboard::LEFT_ALT == eKey ||
-                   MyFirstEngine::Keyboard::RIGHT_ALT == eKey ) &&
+        else if( ( LEFT_ALT == eKey || RIGHT_ALT == eKey ) &&
                  ( 0 == sg_uiAltKeysPressed || 0 == --sg_uiAltKeysPressed ) )
         {
-            sg_oAltKeyTimes.released = MyFirstEngine::GameEngine::LastTime();
+            sg_oAltKeyTimes.released = dTime;
         }
-        else if( ( MyFirstEngine::Keyboard::LEFT_SUPER == eKey ||
-                   MyFirstEngine::Keyboard::RIGHT_SUPER == eKey ) &&
-                 ( 0 == sg_uiSuperKeysPressed || 0 == --sg_uiSuperKeysPressed ) )
+        else if( ( LEFT_SUPER == eKey || RIGHT_SUPER == eKey ) &&
+                 ( 0 == sg_uiSuperKeysPressed ||
+                   0 == --sg_uiSuperKeysPressed ) )
         {
-            sg_oSuperKeyTimes.released = MyFirstEngine::GameEngine::LastTime();
+            sg_oSuperKeyTimes.released = dTime;
         }
     }
 }
 
-}   // namespace
-
-//
-// Class functions
-//
-namespace MyFirstEngine
-{
-
-// is the given int a valid key?
-bool Keyboard::IsKey( int a_i )
-{
-    return ( 32 == a_i || 39 == a_i || ( 44 <= a_i && 57 >= a_i ) ||
-             59 == a_i || 61 == a_i || ( 65 <= a_i && 93 >= a_i ) ||
-             96 == a_i || 161 == a_i || 162 == a_i ||
-             ( 256 <= a_i && 269 >= a_i ) || ( 280 <= a_i && 284 >= a_i ) ||
-             ( 290 <= a_i && 314 >= a_i ) || ( 320 <= a_i && 336 >= a_i ) ||
-             ( 340 <= a_i && 348 >= a_i ) );
-}
-
-// clean up data
-void Keyboard::TerminateInstance()
-{
-    sg_oKeyTimes.clear();
-    sg_oAnyKeyTimes.pressed = 0.0;
-    sg_oAnyKeyTimes.released = 0.0;
-    sg_oShiftKeyTimes.pressed = 0.0;
-    sg_oShiftKeyTimes.released = 0.0;
-    sg_oCtrlKeyTimes.pressed = 0.0;
-    sg_oCtrlKeyTimes.released = 0.0;
-    sg_oAltKeyTimes.pressed = 0.0;
-    sg_oAltKeyTimes.released = 0.0;
-    sg_oSuperKeyTimes.released = 0.0;
-    sg_oSuperKeyTimes.released = 0.0;
-    sg_uiKeysPressed = 0;
-    sg_uiShiftKeysPressed = 0;
-    sg_uiCtrlKeysPressed = 0;
-    sg_uiAltKeysPressed = 0;
-    sg_uiSuperKeysPressed = 0;
-}
-
 //
 // Static functions
 //
@@ -180,11 +231,7 @@ void Keyboard::TerminateInstance()
 // Is the given key pressed right now?
 bool Keyboard::KeyIsPressed( Key a_eKey )
 {
-    if( 0 == sg_oKeyTimes.count( a_eKey ) )
-    {
-        return false;
-    }
-    return sg_oKeyTimes[ a_eKey ].pressed > sg_oKeyTimes[ a_eKey ].released;
+    return ( InTable( a_eKey ) && TestBit( sg_auiDown, a_eKey ) );
 }
 bool Keyboard::AnyKeyIsPressed()
 {
@@ -207,14 +254,25 @@ bool Keyboard::SuperIsPressed()
     return ( 0 < sg_uiSuperKeysPressed );
 }
 
+// Did the given key go down or come up since the last frame?
+bool Keyboard::KeyWasPressed( Key a_eKey )
+{
+    return ( InTable( a_eKey ) && TestBit( sg_auiPressed, a_eKey ) );
+}
+bool Keyboard::KeyWasReleased( Key a_eKey )
+{
+    return ( InTable( a_eKey ) && TestBit( sg_auiReleased, a_eKey ) );
+}
+
 // How long has the given key been pressed/not pressed?
 double Keyboard::KeyTime( Key a_eKey )
 {
-    if( 0 == sg_oKeyTimes.count( a_eKey ) )
+    if( !InTable( a_eKey ) )
     {
         return GameEngine::LastTime();
     }
-    return sg_oKeyTimes[ a_eKey ].Time();
+    return GameEngine::LastTime() - std::max( sg_adPressTimes[ a_eKey ],
+                                              sg_adReleaseTimes[ a_eKey ] );
 }
 double Keyboard::AnyKeyTime() { return sg_oAnyKeyTimes.Time(); }
 double Keyboard::ShiftTime() { return sg_oShiftKeyTimes.Time(); }
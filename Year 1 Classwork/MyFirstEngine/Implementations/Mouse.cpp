@@ -3,8 +3,9 @@
  * Author:             Elizabeth Lowry
  * Date Created:       March 25, 2014
  * Description:        Class for managing mouse input
- * Last Modified:      March 25, 2014
- * Last Modification:  Creation.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Holding the cursor in place for each frame while input is
+ *                      recorded or replayed.
  ******************************************************************************/
 
 #include "../Declarations/Mouse.h"
@@ -22,9 +23,20 @@ namespace
     // window, if any, the cursor is in.
     static double sg_adPressTimes[ MyFirstEngine::Mouse::BUTTON_COUNT ];
     static double sg_adReleaseTimes[ MyFirstEngine::Mouse::BUTTON_COUNT ];
+    static unsigned int sg_uiDown = 0;      // one bit per button
+    static unsigned int sg_uiPressed = 0;   // went down this frame
+    static unsigned int sg_uiReleased = 0;  // came up this frame
     static MyFirstEngine::GameWindow* sg_poMouseWindow = nullptr;
     static double sg_dMouseWindowChangeTime = 0.0;
 
+    // Cursor position relative to the main window's top left corner, and
+    // whether it's in the main window, held for the frame while recording or
+    // replaying
+    static bool sg_bCursorFrozen = false;
+    static double sg_dFrozenX = 0.0;
+    static double sg_dFrozenY = 0.0;
+    static bool sg_bFrozenInMainWindow = false;
+
     // Called if the mouse enters or exits a game window
     static void CursorEnterCallback( GLFWwindow* a_poWindow, int a_iEntered )
     {
@@ -46,24 +58,17 @@ namespace
         }
     }
 
-    // Called if a mouse button is pressed
+    // Called if a mouse button is pressed - just queue it up for the next
+    // frame
     static void MouseButtonCallback( GLFWwindow* a_poWindow, int a_iButton,
                                      int a_iAction, int a_iMods )
     {
-        if( 0 <= a_iButton && MyFirstEngine::Mouse::BUTTON_COUNT > a_iButton )
+        if( 0 <= a_iButton && MyFirstEngine::Mouse::BUTTON_COUNT > a_iButton &&
+            ( GLFW_PRESS == a_iAction || GLFW_RELEASE == a_iAction ) )
         {
-            if( GLFW_PRESS == a_iAction &&
-                sg_adPressTimes[ a_iButton ] <= sg_adReleaseTimes[ a_iButton ] )
-            {
-                sg_adPressTimes[ a_iButton ] =
-                    MyFirstEngine::GameEngine::LastTime();
-            }
-            else if( GLFW_RELEASE == a_iAction &&
-                sg_adPressTimes[ a_iButton ] >= sg_adReleaseTimes[ a_iButton ] )
-            {
-                sg_adReleaseTimes[ a_iButton ] =
-                    MyFirstEngine::GameEngine::LastTime();
-            }
+            MyFirstEngine::Input::Post( MyFirstEngine::Input::MOUSE_BUTTON,
+                                        a_iButton, GLFW_PRESS == a_iAction,
+                                        MyFirstEngine::GameEngine::Time() );
         }
     }
 
@@ -86,10 +91,75 @@ void Mouse::InitializeInstance()
 }
 void Mouse::TerminateInstance()
 {
+    UnfreezeCursor();
+    sg_uiDown = 0;
+    sg_uiPressed = 0;
+    sg_uiReleased = 0;
     sg_dMouseWindowChangeTime = 0.0;
     sg_poMouseWindow = nullptr;
 }
 
+// Forget which buttons changed last frame
+void Mouse::NewFrame()
+{
+    sg_uiPressed = 0;
+    sg_uiReleased = 0;
+}
+
+// Apply a button event at the time it happened
+void Mouse::Apply( const Input::Event& ac_roEvent )
+{
+    if( 0 > ac_roEvent.iCode || BUTTON_COUNT <= ac_roEvent.iCode )
+    {
+        return;
+    }
+    unsigned int uiBit = 1u << ac_roEvent.iCode;
+    if( ac_roEvent.bPressed && 0 == ( sg_uiDown & uiBit ) )
+    {
+        sg_uiDown |= uiBit;
+        sg_uiPressed |= uiBit;
+        sg_adPressTimes[ ac_roEvent.iCode ] = ac_roEvent.dTime;
+    }
+    else if( !ac_roEvent.bPressed && 0 != ( sg_uiDown & uiBit ) )
+    {
+        sg_uiDown &= ~uiBit;
+        sg_uiReleased |= uiBit;
+        sg_adReleaseTimes[ ac_roEvent.iCode ] = ac_roEvent.dTime;
+    }
+}
+
+// Where is the cursor really?
+void Mouse::GetCursor( double& a_rdX, double& a_rdY, bool& a_rbInMainWindow )
+{
+    a_rdX = 0.0;
+    a_rdY = 0.0;
+    a_rbInMainWindow = false;
+    GameWindow& roWindow = GameEngine::MainWindow();
+    if( roWindow.IsOpen() )
+    {
+        glfwGetCursorPos( roWindow.m_poWindow, &a_rdX, &a_rdY );
+        a_rbInMainWindow = ( &roWindow == sg_poMouseWindow );
+    }
+}
+
+// Hold the cursor in place until the next frame
+void Mouse::FreezeCursor( double a_dX, double a_dY, bool a_bInMainWindow,
+                          double a_dTime )
+{
+    if( a_bInMainWindow != ( &GameEngine::MainWindow() == Window() ) )
+    {
+        sg_dMouseWindowChangeTime = a_dTime;
+    }
+    sg_bCursorFrozen = true;
+    sg_dFrozenX = a_dX;
+    sg_dFrozenY = a_dY;
+    sg_bFrozenInMainWindow = a_bInMainWindow;
+}
+void Mouse::UnfreezeCursor()
+{
+    sg_bCursorFrozen = false;
+}
+
 //
 // Static functions
 //
@@ -101,8 +171,7 @@ bool Mouse::ButtonIsPressed( Button a_eButton )
     {
         throw std::runtime_error( "Invalid mouse button" );
     }
-    return ( IsInitialized() &&
-             sg_adPressTimes[ a_eButton ] > sg_adReleaseTimes[ a_eButton ] );
+    return ( IsInitialized() && 0 != ( sg_uiDown & ( 1u << a_eButton ) ) );
 }
 double Mouse::ButtonTime( Button a_eButton )
 {
@@ -115,6 +184,24 @@ double Mouse::ButtonTime( Button a_eButton )
                           sg_adReleaseTimes[ a_eButton ] );
 }
 
+// Did a button go down or come up since the last frame?
+bool Mouse::ButtonWasPressed( Button a_eButton )
+{
+    if( 0 > a_eButton || BUTTON_COUNT <= a_eButton )
+    {
+        throw std::runtime_error( "Invalid mouse button" );
+    }
+    return ( 0 != ( sg_uiPressed & ( 1u << a_eButton ) ) );
+}
+bool Mouse::ButtonWasReleased( Button a_eButton )
+{
+    if( 0 > a_eButton || BUTTON_COUNT <= a_eButton )
+    {
+        throw std::runtime_error( "Invalid mouse button" );
+    }
+    return ( 0 != ( sg_uiReleased & ( 1u << a_eButton ) ) );
+}
+
 // Where is the cursor's last reported position, in pixels, relative to the
 // center of the given window (+y = up) and is it even in said window?  If
 // no window is given, use main window. If window isn't valid GLFW window,
@@ -130,7 +217,19 @@ Point2D Mouse::Position( GameWindow* a_poWindow )
         return Point2D::Origin();
     }
     Point2D oResult;
-    glfwGetCursorPos( a_poWindow->m_poWindow, &oResult.x, &oResult.y );
+    if( sg_bCursorFrozen )
+    {
+        if( a_poWindow != &GameEngine::MainWindow() )
+        {
+            return Point2D::Origin();
+        }
+        oResult.x = sg_dFrozenX;
+        oResult.y = sg_dFrozenY;
+    }
+    else
+    {
+        glfwGetCursorPos( a_poWindow->m_poWindow, &oResult.x, &oResult.y );
+    }
     oResult.x -= a_poWindow->GetSize().x / 2;
     oResult.y = a_poWindow->GetSize().y / 2 - oResult.y;
     return oResult;
@@ -162,6 +261,10 @@ void Mouse::Deregister( GameWindow& a_roWindow )
 // What game window, if any, is the cursor currently in?
 GameWindow* Mouse::Window()
 {
+    if( sg_bCursorFrozen )
+    {
+        return ( sg_bFrozenInMainWindow ? &GameEngine::MainWindow() : nullptr );
+    }
     return sg_poMouseWindow;
 }
 
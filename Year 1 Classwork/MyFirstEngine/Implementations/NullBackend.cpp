@@ -0,0 +1,1137 @@
+/******************************************************************************
+ * File:               NullBackend.cpp
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Implementations for NullBackend functions.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Null glfwSetTime.
+ ******************************************************************************/
+
+#include "../Declarations/GLFW.h"
+#include "../Declarations/NullBackend.h"
+#include <cstring>
+#include <functional>
+#include <map>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#ifdef _WIN32
+#include <windows.h>    // for performance counter
+#else
+#include <time.h>
+#endif
+
+//
+// File-only helper types, variables, and functions
+//
+namespace
+{
+
+using MyFirstEngine::NullBackend;
+
+// A window that only exists as a size and some flags
+struct NullWindow
+{
+    int iWidth;
+    int iHeight;
+    int iShouldClose;
+    GLFWwindowclosefun pfOnClose;
+    GLFWkeyfun pfOnKey;
+    GLFWmousebuttonfun pfOnMouseButton;
+    GLFWcursorenterfun pfOnCursorEnter;
+};
+
+// Size of a texture's top level, plus a third as much again for mipmaps
+struct NullTexture
+{
+    GLsizei iWidth;
+    GLsizei iHeight;
+    unsigned long long ulBytes;
+    bool bMipmapped;
+};
+
+// Size of a buffer's storage, plus memory for handing out when it's mapped
+struct NullBuffer
+{
+    unsigned long long ulSize;
+    std::vector< char > oMapping;
+};
+
+// Uniform and attribute locations handed out so far, by name
+typedef std::map< std::string, GLint > LocationMap;
+
+const unsigned int TEXTURE_UNITS = 32;
+
+// Replaced functions are put back by running these, last first
+std::vector< std::function< void() > > sg_oRestore;
+bool sg_bInstalled = false;
+
+// Clock and frame settings
+double sg_dFrameTime = 1.0 / 60.0;
+unsigned int sg_uiFrameLimit = 0;
+unsigned int sg_uiSwaps = 0;        // since GLFW was initialized
+double sg_dClockStart = 0.0;        // CPU time GLFW was initialized
+double sg_dClockOffset = 0.0;       // added by glfwSetTime
+double sg_dFrameStart = 0.0;        // CPU time the current frame started
+
+// Stats
+NullBackend::Stats sg_oCurrent;
+NullBackend::Stats sg_oTotals;
+std::vector< NullBackend::FrameStats > sg_oFrames;
+NullBackend::Resources sg_oResident;
+
+// GLFW state
+std::set< NullWindow* > sg_oWindows;
+NullWindow* sg_poCurrentWindow = nullptr;
+GLFWerrorfun sg_pfOnError = nullptr;
+
+// GL state.  Every object gets a different name, whatever type it is, so the
+// glIs* functions can tell them apart.
+GLuint sg_uiNextName = 1;
+std::map< GLuint, NullTexture > sg_oTextures;
+std::map< GLuint, NullBuffer > sg_oBuffers;
+std::set< GLuint > sg_oVertexArrays;
+std::map< GLuint, GLenum > sg_oShaders;
+std::map< GLuint, LocationMap > sg_oPrograms;
+std::set< GLuint > sg_oQueries;
+std::set< GLsync > sg_oSyncs;
+GLuint sg_auiBoundTextures[ TEXTURE_UNITS ] = { 0 };
+unsigned int sg_uiActiveTexture = 0;
+std::map< GLenum, GLuint > sg_oBoundBuffers;
+GLuint sg_uiBoundVertexArray = 0;
+GLuint sg_uiCurrentProgram = 0;
+GLint sg_aiViewport[4] = { 0 };
+
+// Add to a stat for both the current frame and the totals
+void Add( unsigned int NullBackend::Stats::* a_puiField,
+          unsigned int a_uiAmount = 1 )
+{
+    sg_oCurrent.*a_puiField += a_uiAmount;
+    sg_oTotals.*a_puiField += a_uiAmount;
+}
+void Add( unsigned long long NullBackend::Stats::* a_pulField,
+          unsigned long long a_ulAmount )
+{
+    sg_oCurrent.*a_pulField += a_ulAmount;
+    sg_oTotals.*a_pulField += a_ulAmount;
+}
+
+// Point a function pointer at a null function, remembering how to put the
+// original back
+template< typename T >
+void Replace( T& a_rpFunction, T a_pNull )
+{
+    T* ppFunction = &a_rpFunction;
+    T pOriginal = a_rpFunction;
+    sg_oRestore.push_back( [=]() { *ppFunction = pOriginal; } );
+    a_rpFunction = a_pNull;
+}
+
+// Forget every object and binding
+void ClearObjects()
+{
+    for each( NullWindow* poWindow in sg_oWindows )
+    {
+        delete poWindow;
+    }
+    sg_oWindows.clear();
+    sg_poCurrentWindow = nullptr;
+    sg_pfOnError = nullptr;
+    sg_oTextures.clear();
+    sg_oBuffers.clear();
+    sg_oVertexArrays.clear();
+    sg_oShaders.clear();
+    sg_oPrograms.clear();
+    sg_oQueries.clear();
+    sg_oSyncs.clear();
+    std::memset( sg_auiBoundTextures, 0, sizeof( sg_auiBoundTextures ) );
+    sg_uiActiveTexture = 0;
+    sg_oBoundBuffers.clear();
+    sg_uiBoundVertexArray = 0;
+    sg_uiCurrentProgram = 0;
+    std::memset( sg_aiViewport, 0, sizeof( sg_aiViewport ) );
+}
+
+// Bytes per pixel for the usual formats and types
+unsigned int PixelBytes( GLenum a_eFormat, GLenum a_eType )
+{
+    unsigned int uiComponents = 4;
+    switch( a_eFormat )
+    {
+    case GL_RED:
+    case GL_ALPHA:
+    case GL_LUMINANCE:
+    case GL_DEPTH_COMPONENT:
+        uiComponents = 1;
+        break;
+    case GL_RG:
+    case GL_LUMINANCE_ALPHA:
+        uiComponents = 2;
+        break;
+    case GL_RGB:
+    case GL_BGR:
+        uiComponents = 3;
+        break;
+    }
+    switch( a_eType )
+    {
+    case GL_SHORT:
+    case GL_UNSIGNED_SHORT:
+    case GL_HALF_FLOAT:
+        return uiComponents * 2;
+    case GL_INT:
+    case GL_UNSIGNED_INT:
+    case GL_FLOAT:
+        return uiComponents * 4;
+    }
+    return uiComponents;
+}
+
+// The texture bound to the active unit, if it exists
+NullTexture* BoundTexture()
+{
+    std::map< GLuint, NullTexture >::iterator oIter =
+        sg_oTextures.find( sg_auiBoundTextures[ sg_uiActiveTexture ] );
+    return ( sg_oTextures.end() == oIter ? nullptr : &( oIter->second ) );
+}
+
+// The buffer bound to the given target, if it exists
+NullBuffer* BoundBuffer( GLenum a_eTarget )
+{
+    std::map< GLuint, NullBuffer >::iterator oIter =
+        sg_oBuffers.find( sg_oBoundBuffers[ a_eTarget ] );
+    return ( sg_oBuffers.end() == oIter ? nullptr : &( oIter->second ) );
+}
+
+//
+// Null OpenGL 1.1 functions
+//
+
+void GLAPIENTRY NullBindTexture( GLenum a_eTarget, GLuint a_uiTexture )
+{
+    if( GL_TEXTURE_2D == a_eTarget )
+    {
+        sg_auiBoundTextures[ sg_uiActiveTexture ] = a_uiTexture;
+    }
+    Add( &NullBackend::Stats::uiBinds );
+}
+void GLAPIENTRY NullBlendFunc( GLenum a_eSource, GLenum a_eDestination ) {}
+void GLAPIENTRY NullClear( GLbitfield a_uiMask )
+{
+    Add( &NullBackend::Stats::uiClears );
+}
+void GLAPIENTRY NullClearColor( GLclampf a_fRed, GLclampf a_fGreen,
+                                GLclampf a_fBlue, GLclampf a_fAlpha ) {}
+void GLAPIENTRY NullDeleteTextures( GLsizei a_iCount,
+                                    const GLuint* ac_puiTextures )
+{
+    for( GLsizei i = 0; i < a_iCount; ++i )
+    {
+        sg_oTextures.erase( ac_puiTextures[i] );
+        for( unsigned int ui = 0; ui < TEXTURE_UNITS; ++ui )
+        {
+            if( ac_puiTextures[i] == sg_auiBoundTextures[ ui ] )
+            {
+                sg_auiBoundTextures[ ui ] = 0;
+            }
+        }
+    }
+}
+void GLAPIENTRY NullDrawElements( GLenum a_eMode, GLsizei a_iCount,
+                                  GLenum a_eType, const GLvoid* ac_pIndices )
+{
+    Add( &NullBackend::Stats::uiDrawCalls );
+    Add( &NullBackend::Stats::ulIndices, (unsigned long long)a_iCount );
+    Add( &NullBackend::Stats::ulInstances, 1ULL );
+}
+void GLAPIENTRY NullEnable( GLenum a_eCapability ) {}
+void GLAPIENTRY NullGenTextures( GLsizei a_iCount, GLuint* a_puiTextures )
+{
+    for( GLsizei i = 0; i < a_iCount; ++i )
+    {
+        a_puiTextures[i] = sg_uiNextName++;
+        NullTexture oTexture = { 0, 0, 0, false };
+        sg_oTextures[ a_puiTextures[i] ] = oTexture;
+    }
+}
+void GLAPIENTRY NullGetIntegerv( GLenum a_eName, GLint* a_piValues )
+{
+    switch( a_eName )
+    {
+    case GL_ACTIVE_TEXTURE:
+        *a_piValues = GL_TEXTURE0 + sg_uiActiveTexture;
+        break;
+    case GL_ARRAY_BUFFER_BINDING:
+        *a_piValues = sg_oBoundBuffers[ GL_ARRAY_BUFFER ];
+        break;
+    case GL_ELEMENT_ARRAY_BUFFER_BINDING:
+        *a_piValues = sg_oBoundBuffers[ GL_ELEMENT_ARRAY_BUFFER ];
+        break;
+    case GL_TEXTURE_BINDING_2D:
+        *a_piValues = sg_auiBoundTextures[ sg_uiActiveTexture ];
+        break;
+    case GL_VERTEX_ARRAY_BINDING:
+        *a_piValues = sg_uiBoundVertexArray;
+        break;
+    case GL_CURRENT_PROGRAM:
+        *a_piValues = sg_uiCurrentProgram;
+        break;
+    case GL_VIEWPORT:
+        std::memcpy( a_piValues, sg_aiViewport, sizeof( sg_aiViewport ) );
+        break;
+    case GL_MAX_TEXTURE_SIZE:
+        *a_piValues = 8192;
+        break;
+    case GL_MAX_TEXTURE_IMAGE_UNITS:
+    case GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS:
+        *a_piValues = TEXTURE_UNITS;
+        break;
+    case GL_MAX_VERTEX_ATTRIBS:
+        *a_piValues = 16;
+        break;
+    default:    // including GL_NUM_PROGRAM_BINARY_FORMATS
+        *a_piValues = 0;
+        break;
+    }
+}
+const GLubyte* GLAPIENTRY NullGetString( GLenum a_eName )
+{
+    switch( a_eName )
+    {
+    case GL_VENDOR:
+    case GL_RENDERER:
+        return (const GLubyte*)"MyFirstEngine NullBackend";
+    case GL_VERSION:
+        return (const GLubyte*)"3.3.0 NullBackend";
+    case GL_SHADING_LANGUAGE_VERSION:
+        return (const GLubyte*)"3.30 NullBackend";
+    case GL_EXTENSIONS:
+        return (const GLubyte*)"";
+    }
+    return nullptr;
+}
+void GLAPIENTRY NullGetTexImage( GLenum a_eTarget, GLint a_iLevel,
+                                 GLenum a_eFormat, GLenum a_eType,
+                                 GLvoid* a_pPixels )
+{
+    NullTexture* poTexture = BoundTexture();
+    if( nullptr != poTexture && nullptr != a_pPixels && 0 == a_iLevel )
+    {
+        std::memset( a_pPixels, 0, poTexture->iWidth * poTexture->iHeight *
+                                   PixelBytes( a_eFormat, a_eType ) );
+    }
+}
+GLboolean GLAPIENTRY NullIsTexture( GLuint a_uiTexture )
+{
+    return ( 0 < sg_oTextures.count( a_uiTexture ) ? GL_TRUE : GL_FALSE );
+}
+void GLAPIENTRY NullTexImage2D( GLenum a_eTarget, GLint a_iLevel,
+                                GLint a_iInternalFormat, GLsizei a_iWidth,
+                                GLsizei a_iHeight, GLint a_iBorder,
+                                GLenum a_eFormat, GLenum a_eType,
+                                const GLvoid* ac_pPixels )
+{
+    unsigned long long ulBytes = (unsigned long long)a_iWidth * a_iHeight *
+                                 PixelBytes( a_eFormat, a_eType );
+    NullTexture* poTexture = BoundTexture();
+    if( nullptr != poTexture && 0 == a_iLevel )
+    {
+        poTexture->iWidth = a_iWidth;
+        poTexture->iHeight = a_iHeight;
+        poTexture->ulBytes = ulBytes;
+        poTexture->bMipmapped = false;
+    }
+    Add( &NullBackend::Stats::uiTextureUploads );
+    Add( &NullBackend::Stats::ulTextureBytes,
+         nullptr == ac_pPixels ? 0ULL : ulBytes );
+}
+void GLAPIENTRY NullTexParameterfv( GLenum a_eTarget, GLenum a_eName,
+                                    const GLfloat* ac_pfValues ) {}
+void GLAPIENTRY NullTexParameteri( GLenum a_eTarget, GLenum a_eName,
+                                   GLint a_iValue ) {}
+void GLAPIENTRY NullViewport( GLint a_iX, GLint a_iY,
+                              GLsizei a_iWidth, GLsizei a_iHeight )
+{
+    sg_aiViewport[0] = a_iX;
+    sg_aiViewport[1] = a_iY;
+    sg_aiViewport[2] = a_iWidth;
+    sg_aiViewport[3] = a_iHeight;
+}
+
+//
+// Null GLEW functions
+//
+
+// Nothing to load, and no extensions to report
+GLenum GLEWAPIENTRY NullGlewInit()
+{
+    return GLEW_OK;
+}
+
+void GLAPIENTRY NullActiveTexture( GLenum a_eUnit )
+{
+    unsigned int uiUnit = a_eUnit - GL_TEXTURE0;
+    if( uiUnit < TEXTURE_UNITS )
+    {
+        sg_uiActiveTexture = uiUnit;
+    }
+}
+void GLAPIENTRY NullAttachShader( GLuint a_uiProgram, GLuint a_uiShader ) {}
+void GLAPIENTRY NullBindBuffer( GLenum a_eTarget, GLuint a_uiBuffer )
+{
+    sg_oBoundBuffers[ a_eTarget ] = a_uiBuffer;
+    Add( &NullBackend::Stats::uiBinds );
+}
+void GLAPIENTRY NullBindVertexArray( GLuint a_uiArray )
+{
+    sg_uiBoundVertexArray = a_uiArray;
+    Add( &NullBackend::Stats::uiBinds );
+}
+void GLAPIENTRY NullBufferData( GLenum a_eTarget, GLsizeiptr a_iSize,
+                                const GLvoid* ac_pData, GLenum a_eUsage )
+{
+    NullBuffer* poBuffer = BoundBuffer( a_eTarget );
+    if( nullptr != poBuffer )
+    {
+        poBuffer->ulSize = a_iSize;
+    }
+    if( nullptr != ac_pData )
+    {
+        Add( &NullBackend::Stats::uiBufferUploads );
+        Add( &NullBackend::Stats::ulBufferBytes,
+             (unsigned long long)a_iSize );
+    }
+}
+void GLAPIENTRY NullBufferStorage( GLenum a_eTarget, GLsizeiptr a_iSize,
+                                   const GLvoid* ac_pData,
+                                   GLbitfield a_uiFlags )
+{
+    NullBufferData( a_eTarget, a_iSize, ac_pData, GL_STATIC_DRAW );
+}
+void GLAPIENTRY NullBufferSubData( GLenum a_eTarget, GLintptr a_iOffset,
+                                   GLsizeiptr a_iSize, const GLvoid* ac_pData )
+{
+    Add( &NullBackend::Stats::uiBufferUploads );
+    Add( &NullBackend::Stats::ulBufferBytes, (unsigned long long)a_iSize );
+}
+GLenum GLAPIENTRY NullClientWaitSync( GLsync a_pSync, GLbitfield a_uiFlags,
+                                      GLuint64 a_ulTimeout )
+{
+    return GL_ALREADY_SIGNALED;
+}
+void GLAPIENTRY NullCompileShader( GLuint a_uiShader )
+{
+    Add( &NullBackend::Stats::uiShaderCompiles );
+}
+GLuint GLAPIENTRY NullCreateProgram()
+{
+    GLuint uiProgram = sg_uiNextName++;
+    sg_oPrograms[ uiProgram ] = LocationMap();
+    return uiProgram;
+}
+GLuint GLAPIENTRY NullCreateShader( GLenum a_eType )
+{
+    GLuint uiShader = sg_uiNextName++;
+    sg_oShaders[ uiShader ] = a_eType;
+    return uiShader;
+}
+void GLAPIENTRY NullDeleteBuffers( GLsizei a_iCount,
+                                   const GLuint* ac_puiBuffers )
+{
+    for( GLsizei i = 0; i < a_iCount; ++i )
+    {
+        sg_oBuffers.erase( ac_puiBuffers[i] );
+    }
+}
+void GLAPIENTRY NullDeleteProgram( GLuint a_uiProgram )
+{
+    sg_oPrograms.erase( a_uiProgram );
+    if( a_uiProgram == sg_uiCurrentProgram )
+    {
+        sg_uiCurrentProgram = 0;
+    }
+}
+void GLAPIENTRY NullDeleteQueries( GLsizei a_iCount, const GLuint* ac_puiIDs )
+{
+    for( GLsizei i = 0; i < a_iCount; ++i )
+    {
+        sg_oQueries.erase( ac_puiIDs[i] );
+    }
+}
+void GLAPIENTRY NullDeleteShader( GLuint a_uiShader )
+{
+    sg_oShaders.erase( a_uiShader );
+}
+void GLAPIENTRY NullDeleteSync( GLsync a_pSync )
+{
+    sg_oSyncs.erase( a_pSync );
+}
+void GLAPIENTRY NullDeleteVertexArrays( GLsizei a_iCount,
+                                        const GLuint* ac_puiArrays )
+{
+    for( GLsizei i = 0; i < a_iCount; ++i )
+    {
+        sg_oVertexArrays.erase( ac_puiArrays[i] );
+    }
+}
+void GLAPIENTRY NullDrawElementsInstanced( GLenum a_eMode, GLsizei a_iCount,
+                                           GLenum a_eType,
+                                           const GLvoid* ac_pIndices,
+                                           GLsizei a_iInstances )
+{
+    Add( &NullBackend::Stats::uiDrawCalls );
+    Add( &NullBackend::Stats::ulIndices,
+         (unsigned long long)a_iCount * a_iInstances );
+    Add( &NullBackend::Stats::ulInstances,
+         (unsigned long long)a_iInstances );
+}
+void GLAPIENTRY NullEnableVertexAttribArray( GLuint a_uiIndex ) {}
+GLsync GLAPIENTRY NullFenceSync( GLenum a_eCondition, GLbitfield a_uiFlags )
+{
+    GLsync pSync = (GLsync)(std::size_t)( sg_uiNextName++ );
+    sg_oSyncs.insert( pSync );
+    return pSync;
+}
+void GLAPIENTRY NullGenBuffers( GLsizei a_iCount, GLuint* a_puiBuffers )
+{
+    for( GLsizei i = 0; i < a_iCount; ++i )
+    {
+        a_puiBuffers[i] = sg_uiNextName++;
+        sg_oBuffers[ a_puiBuffers[i] ].ulSize = 0;
+    }
+}
+void GLAPIENTRY NullGenQueries( GLsizei a_iCount, GLuint* a_puiIDs )
+{
+    for( GLsizei i = 0; i < a_iCount; ++i )
+    {
+        a_puiIDs[i] = sg_uiNextName++;
+        sg_oQueries.insert( a_puiIDs[i] );
+    }
+}
+void GLAPIENTRY NullGenVertexArrays( GLsizei a_iCount, GLuint* a_puiArrays )
+{
+    for( GLsizei i = 0; i < a_iCount; ++i )
+    {
+        a_puiArrays[i] = sg_uiNextName++;
+        sg_oVertexArrays.insert( a_puiArrays[i] );
+    }
+}
+void GLAPIENTRY NullGenerateMipmap( GLenum a_eTarget )
+{
+    NullTexture* poTexture = BoundTexture();
+    if( nullptr != poTexture && !poTexture->bMipmapped )
+    {
+        poTexture->ulBytes += poTexture->ulBytes / 3;
+        poTexture->bMipmapped = true;
+    }
+}
+
+// Locations are handed out in the order names are first asked for
+GLint GLAPIENTRY NullGetLocation( GLuint a_uiProgram, const GLchar* ac_pcName )
+{
+    std::map< GLuint, LocationMap >::iterator oIter =
+        sg_oPrograms.find( a_uiProgram );
+    if( sg_oPrograms.end() == oIter || nullptr == ac_pcName )
+    {
+        return -1;
+    }
+    LocationMap& roLocations = oIter->second;
+    std::string oName( ac_pcName );
+    if( 0 == roLocations.count( oName ) )
+    {
+        GLint iLocation = (GLint)roLocations.size();
+        roLocations[ oName ] = iLocation;
+    }
+    return roLocations[ oName ];
+}
+void GLAPIENTRY NullGetInteger64v( GLenum a_eName, GLint64* a_piValues )
+{
+    *a_piValues = ( GL_TIMESTAMP == a_eName
+                    ? (GLint64)( NullBackend::CPUTime() * 1.0e9 ) : 0 );
+}
+void GLAPIENTRY NullGetProgramBinary( GLuint a_uiProgram, GLsizei a_iSize,
+                                      GLsizei* a_piLength,
+                                      GLenum* a_peFormat, GLvoid* a_pBinary )
+{
+    if( nullptr != a_piLength )
+    {
+        *a_piLength = 0;
+    }
+}
+
+// Logs are always empty
+void GLAPIENTRY NullGetInfoLog( GLuint a_uiObject, GLsizei a_iSize,
+                                GLsizei* a_piLength, GLchar* a_pcLog )
+{
+    if( nullptr != a_piLength )
+    {
+        *a_piLength = 0;
+    }
+    if( 0 < a_iSize && nullptr != a_pcLog )
+    {
+        a_pcLog[0] = '\0';
+    }
+}
+
+// Every program links
+void GLAPIENTRY NullGetProgramiv( GLuint a_uiProgram, GLenum a_eName,
+                                  GLint* a_piValue )
+{
+    *a_piValue = ( GL_LINK_STATUS == a_eName ||
+                   GL_VALIDATE_STATUS == a_eName ) ? GL_TRUE : 0;
+}
+void GLAPIENTRY NullGetQueryObjectiv( GLuint a_uiID, GLenum a_eName,
+                                      GLint* a_piValue )
+{
+    *a_piValue = ( GL_QUERY_RESULT_AVAILABLE == a_eName ) ? GL_TRUE : 0;
+}
+void GLAPIENTRY NullGetQueryObjectui64v( GLuint a_uiID, GLenum a_eName,
+                                         GLuint64* a_puiValue )
+{
+    *a_puiValue = ( GL_QUERY_RESULT_AVAILABLE == a_eName ) ? GL_TRUE : 0;
+}
+
+// Every shader compiles
+void GLAPIENTRY NullGetShaderiv( GLuint a_uiShader, GLenum a_eName,
+                                 GLint* a_piValue )
+{
+    if( GL_SHADER_TYPE == a_eName )
+    {
+        *a_piValue = ( 0 < sg_oShaders.count( a_uiShader )
+                       ? sg_oShaders[ a_uiShader ] : 0 );
+    }
+    else
+    {
+        *a_piValue = ( GL_COMPILE_STATUS == a_eName ) ? GL_TRUE : 0;
+    }
+}
+GLboolean GLAPIENTRY NullIsProgram( GLuint a_uiProgram )
+{
+    return ( 0 < sg_oPrograms.count( a_uiProgram ) ? GL_TRUE : GL_FALSE );
+}
+GLboolean GLAPIENTRY NullIsShader( GLuint a_uiShader )
+{
+    return ( 0 < sg_oShaders.count( a_uiShader ) ? GL_TRUE : GL_FALSE );
+}
+void GLAPIENTRY NullLinkProgram( GLuint a_uiProgram )
+{
+    Add( &NullBackend::Stats::uiProgramLinks );
+}
+
+// Hand out memory to write into, which counts as uploaded once unmapped
+GLvoid* GLAPIENTRY NullMapBufferRange( GLenum a_eTarget, GLintptr a_iOffset,
+                                       GLsizeiptr a_iLength,
+                                       GLbitfield a_uiAccess )
+{
+    NullBuffer* poBuffer = BoundBuffer( a_eTarget );
+    if( nullptr == poBuffer || 0 >= a_iLength )
+    {
+        return nullptr;
+    }
+    poBuffer->oMapping.resize( (std::size_t)a_iLength );
+    return &( poBuffer->oMapping[0] );
+}
+void GLAPIENTRY NullProgramBinary( GLuint a_uiProgram, GLenum a_eFormat,
+                                   const GLvoid* ac_pBinary,
+                                   GLsizei a_iLength ) {}
+void GLAPIENTRY NullProgramParameteri( GLuint a_uiProgram, GLenum a_eName,
+                                       GLint a_iValue ) {}
+void GLAPIENTRY NullQueryCounter( GLuint a_uiID, GLenum a_eTarget ) {}
+void GLAPIENTRY NullShaderSource( GLuint a_uiShader, GLsizei a_iCount,
+                                  const GLchar** ac_ppcStrings,
+                                  const GLint* ac_piLengths ) {}
+void GLAPIENTRY NullTexBuffer( GLenum a_eTarget, GLenum a_eFormat,
+                               GLuint a_uiBuffer ) {}
+void GLAPIENTRY NullUniform1i( GLint a_iLocation, GLint a_iValue )
+{
+    Add( &NullBackend::Stats::uiUniformSets );
+}
+
+// All the array and matrix uniform setters just count the call
+template< typename T >
+void GLAPIENTRY NullUniformv( GLint a_iLocation, GLsizei a_iCount,
+                              const T* ac_pValues )
+{
+    Add( &NullBackend::Stats::uiUniformSets );
+}
+template< typename T >
+void GLAPIENTRY NullUniformMatrixv( GLint a_iLocation, GLsizei a_iCount,
+                                    GLboolean a_bTranspose,
+                                    const T* ac_pValues )
+{
+    Add( &NullBackend::Stats::uiUniformSets );
+}
+GLboolean GLAPIENTRY NullUnmapBuffer( GLenum a_eTarget )
+{
+    NullBuffer* poBuffer = BoundBuffer( a_eTarget );
+    if( nullptr == poBuffer || poBuffer->oMapping.empty() )
+    {
+        return GL_FALSE;
+    }
+    Add( &NullBackend::Stats::uiBufferUploads );
+    Add( &NullBackend::Stats::ulBufferBytes,
+         (unsigned long long)poBuffer->oMapping.size() );
+    std::vector< char >().swap( poBuffer->oMapping );
+    return GL_TRUE;
+}
+void GLAPIENTRY NullUseProgram( GLuint a_uiProgram )
+{
+    sg_uiCurrentProgram = a_uiProgram;
+    Add( &NullBackend::Stats::uiBinds );
+}
+void GLAPIENTRY NullVertexAttribDivisor( GLuint a_uiIndex,
+                                         GLuint a_uiDivisor ) {}
+void GLAPIENTRY NullVertexAttribIPointer( GLuint a_uiIndex, GLint a_iSize,
+                                          GLenum a_eType, GLsizei a_iStride,
+                                          const GLvoid* ac_pPointer ) {}
+void GLAPIENTRY NullVertexAttribPointer( GLuint a_uiIndex, GLint a_iSize,
+                                         GLenum a_eType,
+                                         GLboolean a_bNormalized,
+                                         GLsizei a_iStride,
+                                         const GLvoid* ac_pPointer ) {}
+
+//
+// Null GLFW functions
+//
+
+// The window a GLFW handle stands for, if it still exists
+NullWindow* Find( GLFWwindow* a_poWindow )
+{
+    NullWindow* poWindow = (NullWindow*)a_poWindow;
+    return ( 0 < sg_oWindows.count( poWindow ) ? poWindow : nullptr );
+}
+
+GLFWwindow* NullCreateWindow( int a_iWidth, int a_iHeight,
+                              const char* ac_pcTitle,
+                              GLFWmonitor* a_poMonitor, GLFWwindow* a_poShare )
+{
+    NullWindow* poWindow = new NullWindow;
+    std::memset( poWindow, 0, sizeof( NullWindow ) );
+    poWindow->iWidth = a_iWidth;
+    poWindow->iHeight = a_iHeight;
+    sg_oWindows.insert( poWindow );
+    return (GLFWwindow*)poWindow;
+}
+void NullDestroyWindow( GLFWwindow* a_poWindow )
+{
+    NullWindow* poWindow = Find( a_poWindow );
+    if( nullptr != poWindow )
+    {
+        if( sg_poCurrentWindow == poWindow )
+        {
+            sg_poCurrentWindow = nullptr;
+        }
+        sg_oWindows.erase( poWindow );
+        delete poWindow;
+    }
+}
+GLFWwindow* NullGetCurrentContext()
+{
+    return (GLFWwindow*)sg_poCurrentWindow;
+}
+
+// The cursor never moves from the top left corner
+void NullGetCursorPos( GLFWwindow* a_poWindow, double* a_pdX, double* a_pdY )
+{
+    if( nullptr != a_pdX )
+    {
+        *a_pdX = 0.0;
+    }
+    if( nullptr != a_pdY )
+    {
+        *a_pdY = 0.0;
+    }
+}
+
+// There's no frame around a null window, so the frame buffer is the same size
+// as the window
+void NullGetFramebufferSize( GLFWwindow* a_poWindow,
+                             int* a_piWidth, int* a_piHeight )
+{
+    NullWindow* poWindow = Find( a_poWindow );
+    if( nullptr != a_piWidth )
+    {
+        *a_piWidth = ( nullptr != poWindow ? poWindow->iWidth : 0 );
+    }
+    if( nullptr != a_piHeight )
+    {
+        *a_piHeight = ( nullptr != poWindow ? poWindow->iHeight : 0 );
+    }
+}
+double NullGetTime()
+{
+    return sg_dClockOffset +
+           ( 0.0 < sg_dFrameTime ? sg_uiSwaps * sg_dFrameTime
+                                 : NullBackend::CPUTime() - sg_dClockStart );
+}
+void NullSetTime( double a_dTime )
+{
+    sg_dClockOffset += a_dTime - NullGetTime();
+}
+
+// Like glfwInit, start the clock over
+int NullInit()
+{
+    sg_uiSwaps = 0;
+    sg_dClockStart = NullBackend::CPUTime();
+    sg_dClockOffset = 0.0;
+    return GL_TRUE;
+}
+void NullMakeContextCurrent( GLFWwindow* a_poWindow )
+{
+    sg_poCurrentWindow = Find( a_poWindow );
+}
+
+// Nothing happens, unless it's time to close the windows.  A close callback
+// may destroy windows, so go through a copy of the list.
+void NullPollEvents()
+{
+    if( 0 == sg_uiFrameLimit || sg_oFrames.size() < sg_uiFrameLimit )
+    {
+        return;
+    }
+    std::vector< NullWindow* > oWindows( sg_oWindows.begin(),
+                                         sg_oWindows.end() );
+    for each( NullWindow* poWindow in oWindows )
+    {
+        if( nullptr != Find( (GLFWwindow*)poWindow ) &&
+            GL_FALSE == poWindow->iShouldClose )
+        {
+            poWindow->iShouldClose = GL_TRUE;
+            if( nullptr != poWindow->pfOnClose )
+            {
+                poWindow->pfOnClose( (GLFWwindow*)poWindow );
+            }
+        }
+    }
+}
+GLFWcursorenterfun NullSetCursorEnterCallback( GLFWwindow* a_poWindow,
+                                               GLFWcursorenterfun a_pfOnEnter )
+{
+    NullWindow* poWindow = Find( a_poWindow );
+    if( nullptr == poWindow )
+    {
+        return nullptr;
+    }
+    GLFWcursorenterfun pfPrevious = poWindow->pfOnCursorEnter;
+    poWindow->pfOnCursorEnter = a_pfOnEnter;
+    return pfPrevious;
+}
+GLFWerrorfun NullSetErrorCallback( GLFWerrorfun a_pfOnError )
+{
+    GLFWerrorfun pfPrevious = sg_pfOnError;
+    sg_pfOnError = a_pfOnError;
+    return pfPrevious;
+}
+GLFWkeyfun NullSetKeyCallback( GLFWwindow* a_poWindow, GLFWkeyfun a_pfOnKey )
+{
+    NullWindow* poWindow = Find( a_poWindow );
+    if( nullptr == poWindow )
+    {
+        return nullptr;
+    }
+    GLFWkeyfun pfPrevious = poWindow->pfOnKey;
+    poWindow->pfOnKey = a_pfOnKey;
+    return pfPrevious;
+}
+GLFWmousebuttonfun NullSetMouseButtonCallback( GLFWwindow* a_poWindow,
+                                               GLFWmousebuttonfun a_pfOnButton )
+{
+    NullWindow* poWindow = Find( a_poWindow );
+    if( nullptr == poWindow )
+    {
+        return nullptr;
+    }
+    GLFWmousebuttonfun pfPrevious = poWindow->pfOnMouseButton;
+    poWindow->pfOnMouseButton = a_pfOnButton;
+    return pfPrevious;
+}
+GLFWwindowclosefun NullSetWindowCloseCallback( GLFWwindow* a_poWindow,
+                                               GLFWwindowclosefun a_pfOnClose )
+{
+    NullWindow* poWindow = Find( a_poWindow );
+    if( nullptr == poWindow )
+    {
+        return nullptr;
+    }
+    GLFWwindowclosefun pfPrevious = poWindow->pfOnClose;
+    poWindow->pfOnClose = a_pfOnClose;
+    return pfPrevious;
+}
+void NullSetWindowShouldClose( GLFWwindow* a_poWindow, int a_iValue )
+{
+    NullWindow* poWindow = Find( a_poWindow );
+    if( nullptr != poWindow )
+    {
+        poWindow->iShouldClose = a_iValue;
+    }
+}
+void NullSetWindowSize( GLFWwindow* a_poWindow, int a_iWidth, int a_iHeight )
+{
+    NullWindow* poWindow = Find( a_poWindow );
+    if( nullptr != poWindow )
+    {
+        poWindow->iWidth = a_iWidth;
+        poWindow->iHeight = a_iHeight;
+    }
+}
+void NullSetWindowTitle( GLFWwindow* a_poWindow, const char* ac_pcTitle ) {}
+
+// Finish the frame - record its stats and how long it took, then move the
+// clock on
+void NullSwapBuffers( GLFWwindow* a_poWindow )
+{
+    if( nullptr == Find( a_poWindow ) )
+    {
+        return;
+    }
+    double dNow = NullBackend::CPUTime();
+    NullBackend::FrameStats oFrame;
+    oFrame.dCPUTime = dNow - sg_dFrameStart;
+    oFrame.oCalls = sg_oCurrent;
+    sg_oFrames.push_back( oFrame );
+    std::memset( &sg_oCurrent, 0, sizeof( sg_oCurrent ) );
+    sg_dFrameStart = dNow;
+    ++sg_uiSwaps;
+}
+void NullTerminate()
+{
+    ClearObjects();
+}
+void NullWindowHint( int a_iTarget, int a_iHint ) {}
+int NullWindowShouldClose( GLFWwindow* a_poWindow )
+{
+    NullWindow* poWindow = Find( a_poWindow );
+    return ( nullptr != poWindow ? poWindow->iShouldClose : GL_FALSE );
+}
+
+}   // namespace
+
+namespace MyFirstEngine
+{
+
+// Swap every function the engine calls for its null version.  The names below
+// are the macros from GLFW.h and glew.h, so they refer to the pointers the
+// engine actually calls through.
+void NullBackend::Install()
+{
+    if( sg_bInstalled )
+    {
+        return;
+    }
+    ClearObjects();
+    ResetStats();
+
+    // OpenGL 1.1
+    Replace( glBindTexture, &NullBindTexture );
+    Replace( glBlendFunc, &NullBlendFunc );
+    Replace( glClear, &NullClear );
+    Replace( glClearColor, &NullClearColor );
+    Replace( glDeleteTextures, &NullDeleteTextures );
+    Replace( glDrawElements, &NullDrawElements );
+    Replace( glEnable, &NullEnable );
+    Replace( glGenTextures, &NullGenTextures );
+    Replace( glGetIntegerv, &NullGetIntegerv );
+    Replace( glGetString, &NullGetString );
+    Replace( glGetTexImage, &NullGetTexImage );
+    Replace( glIsTexture, &NullIsTexture );
+    Replace( glTexImage2D, &NullTexImage2D );
+    Replace( glTexParameterfv, &NullTexParameterfv );
+    Replace( glTexParameteri, &NullTexParameteri );
+    Replace( glViewport, &NullViewport );
+
+    // GLEW
+    Replace( glewInit, &NullGlewInit );
+    Replace( glActiveTexture, &NullActiveTexture );
+    Replace( glAttachShader, &NullAttachShader );
+    Replace( glBindBuffer, &NullBindBuffer );
+    Replace( glBindVertexArray, &NullBindVertexArray );
+    Replace( glBufferData, &NullBufferData );
+    Replace( glBufferStorage, &NullBufferStorage );
+    Replace( glBufferSubData, &NullBufferSubData );
+    Replace( glClientWaitSync, &NullClientWaitSync );
+    Replace( glCompileShader, &NullCompileShader );
+    Replace( glCreateProgram, &NullCreateProgram );
+    Replace( glCreateShader, &NullCreateShader );
+    Replace( glDeleteBuffers, &NullDeleteBuffers );
+    Replace( glDeleteProgram, &NullDeleteProgram );
+    Replace( glDeleteQueries, &NullDeleteQueries );
+    Replace( glDeleteShader, &NullDeleteShader );
+    Replace( glDeleteSync, &NullDeleteSync );
+    Replace( glDeleteVertexArrays, &NullDeleteVertexArrays );
+    Replace( glDrawElementsInstanced, &NullDrawElementsInstanced );
+    Replace( glEnableVertexAttribArray, &NullEnableVertexAttribArray );
+    Replace( glFenceSync, &NullFenceSync );
+    Replace( glGenBuffers, &NullGenBuffers );
+    Replace( glGenQueries, &NullGenQueries );
+    Replace( glGenVertexArrays, &NullGenVertexArrays );
+    Replace( glGenerateMipmap, &NullGenerateMipmap );
+    Replace( glGetAttribLocation, &NullGetLocation );
+    Replace( glGetInteger64v, &NullGetInteger64v );
+    Replace( glGetProgramBinary, &NullGetProgramBinary );
+    Replace( glGetProgramInfoLog, &NullGetInfoLog );
+    Replace( glGetProgramiv, &NullGetProgramiv );
+    Replace( glGetQueryObjectiv, &NullGetQueryObjectiv );
+    Replace( glGetQueryObjectui64v, &NullGetQueryObjectui64v );
+    Replace( glGetShaderInfoLog, &NullGetInfoLog );
+    Replace( glGetShaderiv, &NullGetShaderiv );
+    Replace( glGetUniformLocation, &NullGetLocation );
+    Replace( glIsProgram, &NullIsProgram );
+    Replace( glIsShader, &NullIsShader );
+    Replace( glLinkProgram, &NullLinkProgram );
+    Replace( glMapBufferRange, &NullMapBufferRange );
+    Replace( glProgramBinary, &NullProgramBinary );
+    Replace( glProgramParameteri, &NullProgramParameteri );
+    Replace( glQueryCounter, &NullQueryCounter );
+    Replace( glShaderSource, &NullShaderSource );
+    Replace( glTexBuffer, &NullTexBuffer );
+    Replace( glUniform1i, &NullUniform1i );
+    Replace( glUniform2dv, &NullUniformv< GLdouble > );
+    Replace( glUniform2fv, &NullUniformv< GLfloat > );
+    Replace( glUniform4fv, &NullUniformv< GLfloat > );
+    Replace( glUniformMatrix3dv, &NullUniformMatrixv< GLdouble > );
+    Replace( glUniformMatrix3fv, &NullUniformMatrixv< GLfloat > );
+    Replace( glUniformMatrix4dv, &NullUniformMatrixv< GLdouble > );
+    Replace( glUniformMatrix4fv, &NullUniformMatrixv< GLfloat > );
+    Replace( glUnmapBuffer, &NullUnmapBuffer );
+    Replace( glUseProgram, &NullUseProgram );
+    Replace( glVertexAttribDivisor, &NullVertexAttribDivisor );
+    Replace( glVertexAttribIPointer, &NullVertexAttribIPointer );
+    Replace( glVertexAttribPointer, &NullVertexAttribPointer );
+
+    // GLFW
+    Replace( glfwCreateWindow, &NullCreateWindow );
+    Replace( glfwDestroyWindow, &NullDestroyWindow );
+    Replace( glfwGetCurrentContext, &NullGetCurrentContext );
+    Replace( glfwGetCursorPos, &NullGetCursorPos );
+    Replace( glfwGetFramebufferSize, &NullGetFramebufferSize );
+    Replace( glfwGetTime, &NullGetTime );
+    Replace( glfwInit, &NullInit );
+    Replace( glfwMakeContextCurrent, &NullMakeContextCurrent );
+    Replace( glfwPollEvents, &NullPollEvents );
+    Replace( glfwSetCursorEnterCallback, &NullSetCursorEnterCallback );
+    Replace( glfwSetErrorCallback, &NullSetErrorCallback );
+    Replace( glfwSetKeyCallback, &NullSetKeyCallback );
+    Replace( glfwSetMouseButtonCallback, &NullSetMouseButtonCallback );
+    Replace( glfwSetTime, &NullSetTime );
+    Replace( glfwSetWindowCloseCallback, &NullSetWindowCloseCallback );
+    Replace( glfwSetWindowShouldClose, &NullSetWindowShouldClose );
+    Replace( glfwSetWindowSize, &NullSetWindowSize );
+    Replace( glfwSetWindowTitle, &NullSetWindowTitle );
+    Replace( glfwSwapBuffers, &NullSwapBuffers );
+    Replace( glfwTerminate, &NullTerminate );
+    Replace( glfwWindowHint, &NullWindowHint );
+    Replace( glfwWindowShouldClose, &NullWindowShouldClose );
+
+    sg_bInstalled = true;
+}
+
+// Put the real functions back, last replaced first
+void NullBackend::Uninstall()
+{
+    if( !sg_bInstalled )
+    {
+        return;
+    }
+    while( !sg_oRestore.empty() )
+    {
+        sg_oRestore.back()();
+        sg_oRestore.pop_back();
+    }
+    ClearObjects();
+    sg_bInstalled = false;
+}
+bool NullBackend::IsInstalled()
+{
+    return sg_bInstalled;
+}
+
+// Clock settings
+void NullBackend::SetFrameTime( double a_dSeconds )
+{
+    sg_dFrameTime = ( 0.0 < a_dSeconds ? a_dSeconds : 0.0 );
+}
+double NullBackend::FrameTime()
+{
+    return sg_dFrameTime;
+}
+void NullBackend::SetFrameLimit( unsigned int a_uiFrames )
+{
+    sg_uiFrameLimit = a_uiFrames;
+}
+
+// Forget frames and totals recorded so far
+void NullBackend::ResetStats()
+{
+    std::memset( &sg_oCurrent, 0, sizeof( sg_oCurrent ) );
+    std::memset( &sg_oTotals, 0, sizeof( sg_oTotals ) );
+    std::vector< FrameStats >().swap( sg_oFrames );
+    sg_dFrameStart = CPUTime();
+}
+
+// Frames recorded since the stats were reset
+unsigned int NullBackend::FrameCount()
+{
+    return sg_oFrames.size();
+}
+const NullBackend::FrameStats&
+    NullBackend::RecordedFrame( unsigned int a_uiIndex )
+{
+    if( a_uiIndex >= sg_oFrames.size() )
+    {
+        throw std::out_of_range( "Invalid null backend frame index" );
+    }
+    return sg_oFrames[ a_uiIndex ];
+}
+
+// Calls made so far
+const NullBackend::Stats& NullBackend::CurrentFrame()
+{
+    return sg_oCurrent;
+}
+const NullBackend::Stats& NullBackend::Totals()
+{
+    return sg_oTotals;
+}
+
+// Count up the objects that exist right now
+const NullBackend::Resources& NullBackend::Resident()
+{
+    std::memset( &sg_oResident, 0, sizeof( sg_oResident ) );
+    sg_oResident.uiWindows = sg_oWindows.size();
+    sg_oResident.uiTextures = sg_oTextures.size();
+    for( std::map< GLuint, NullTexture >::const_iterator oIter =
+             sg_oTextures.begin(); oIter != sg_oTextures.end(); ++oIter )
+    {
+        sg_oResident.ulTextureBytes += oIter->second.ulBytes;
+    }
+    sg_oResident.uiBuffers = sg_oBuffers.size();
+    for( std::map< GLuint, NullBuffer >::const_iterator oIter =
+             sg_oBuffers.begin(); oIter != sg_oBuffers.end(); ++oIter )
+    {
+        sg_oResident.ulBufferBytes += oIter->second.ulSize;
+    }
+    sg_oResident.uiVertexArrays = sg_oVertexArrays.size();
+    sg_oResident.uiShaders = sg_oShaders.size();
+    sg_oResident.uiPrograms = sg_oPrograms.size();
+    return sg_oResident;
+}
+
+// Real time, in seconds, from the highest-resolution timer available
+double NullBackend::CPUTime()
+{
+#ifdef _WIN32
+    LARGE_INTEGER oCount;
+    LARGE_INTEGER oFrequency;
+    QueryPerformanceCounter( &oCount );
+    QueryPerformanceFrequency( &oFrequency );
+    return (double)oCount.QuadPart / (double)oFrequency.QuadPart;
+#else
+    timespec oTime;
+    clock_gettime( CLOCK_MONOTONIC, &oTime );
+    return (double)oTime.tv_sec + (double)oTime.tv_nsec * 1.0e-9;
+#endif
+}
+
+}   // namespace MyFirstEngine
@@ -0,0 +1,528 @@
+/******************************************************************************
+ * File:               Profiler.cpp
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Implementations for Profiler functions.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Added culled object counter.
+ ******************************************************************************/
+
+#include "../Declarations/GameEngine.h"
+#include "../Declarations/GLFW.h"
+#include "../Declarations/Profiler.h"
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <stdexcept>
+#include <vector>
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>    // for interlocked functions
+#endif
+
+#ifdef _MSC_VER
+#define PROFILER__THREAD_LOCAL __declspec( thread )
+#else
+#define PROFILER__THREAD_LOCAL __thread
+#endif
+
+//
+// File-local helper classes and functions
+//
+namespace
+{
+
+using MyFirstEngine::Profiler;
+
+// Everything a thread records.  Once created, these are never destroyed, so
+// the trace can still include threads that have exited.
+struct ThreadData
+{
+    Profiler::EventRing oEvents;
+    unsigned int uiIndex;
+    unsigned int uiDepth;
+    double adChildTime[ Profiler::MAX_DEPTH ];
+    ThreadData* poNext;
+};
+
+// GPU zone waiting on its query results
+struct PendingQuery
+{
+    const char* pcName;
+    GLuint auiQueries[2];
+    unsigned int uiDepth;
+};
+class PendingQueryList
+    : public std::vector< PendingQuery >,
+      public Utility::Singleton< PendingQueryList >
+{
+    friend class Utility::Singleton< PendingQueryList >;
+public:
+    virtual ~PendingQueryList() {}
+private:
+    PendingQueryList() {}
+};
+
+// Every thread that has recorded anything, most recent first
+ThreadData* volatile sg_poThreads = nullptr;
+volatile long sg_lThreadCount = 0;
+PROFILER__THREAD_LOCAL ThreadData* sg_poThisThread = nullptr;
+
+// Recording switch and per-frame state.  Counters and GPU zones are only
+// touched by the thread with the GL context.
+volatile bool sg_bEnabled = true;
+unsigned int sg_auiCounters[ Profiler::COUNTER_COUNT ] = { 0 };
+double sg_dFrameStart = 0.0;
+Profiler::FrameStats sg_aoFrames[ Profiler::FRAME_HISTORY ];
+unsigned int sg_uiFrameCount = 0;
+unsigned int sg_uiGPUDepth = 0;
+
+// Offset from GPU timestamps to Profiler::Now(), set the first time a GPU
+// zone is recorded
+bool sg_bGPUCalibrated = false;
+double sg_dGPUOffset = 0.0;
+
+// Add a thread's data to the list without locking
+void Register( ThreadData* a_poThread )
+{
+#ifdef _WIN32
+    a_poThread->uiIndex = (unsigned int)InterlockedIncrement( &sg_lThreadCount );
+    do
+    {
+        a_poThread->poNext = sg_poThreads;
+    } while( a_poThread->poNext !=
+             InterlockedCompareExchangePointer( (PVOID volatile*)&sg_poThreads,
+                                                a_poThread,
+                                                a_poThread->poNext ) );
+#else
+    a_poThread->uiIndex =
+        (unsigned int)__sync_add_and_fetch( &sg_lThreadCount, 1 );
+    do
+    {
+        a_poThread->poNext = sg_poThreads;
+    } while( !__sync_bool_compare_and_swap( &sg_poThreads, a_poThread->poNext,
+                                            a_poThread ) );
+#endif
+}
+
+// Get the data for the calling thread, creating it the first time
+ThreadData& ThisThread()
+{
+    if( nullptr == sg_poThisThread )
+    {
+        sg_poThisThread = new ThreadData();
+        sg_poThisThread->uiDepth = 0;
+        Register( sg_poThisThread );
+    }
+    return *sg_poThisThread;
+}
+
+// Can GPU zones be timed?
+bool CanTimeGPU()
+{
+    return MyFirstEngine::GameEngine::IsInitialized() &&
+           ( GL_FALSE != GLEW_VERSION_3_3 || GL_FALSE != GLEW_ARB_timer_query );
+}
+
+// Write a zone name as a JSON string
+void WriteJSONString( std::ostream& a_roOutput, const char* ac_pcText )
+{
+    a_roOutput << '"';
+    for( const char* pc = ( nullptr == ac_pcText ? "" : ac_pcText );
+         '\0' != *pc; ++pc )
+    {
+        if( '"' == *pc || '\\' == *pc )
+        {
+            a_roOutput << '\\' << *pc;
+        }
+        else if( (unsigned char)*pc < 0x20 )
+        {
+            a_roOutput << ' ';
+        }
+        else
+        {
+            a_roOutput << *pc;
+        }
+    }
+    a_roOutput << '"';
+}
+
+}   // namespace
+
+namespace MyFirstEngine
+{
+
+//
+// EventRing functions
+//
+
+// Constructor rounds the capacity up to a power of two
+Profiler::EventRing::EventRing( unsigned int a_uiCapacity )
+    : m_ulPushed( 0 )
+{
+    unsigned int uiCapacity = 1;
+    while( uiCapacity < a_uiCapacity && 0 != ( uiCapacity << 1 ) )
+    {
+        uiCapacity <<= 1;
+    }
+    m_paoEvents = new Event[ uiCapacity ];
+    m_uiMask = uiCapacity - 1;
+}
+
+// Destructor
+Profiler::EventRing::~EventRing()
+{
+    delete[] m_paoEvents;
+}
+
+// Add an event, overwriting the oldest if the ring is full.  The count is only
+// bumped after the event is written, so a reader never sees a partial event in
+// a slot that wasn't already in use.
+void Profiler::EventRing::Push( const Event& ac_roEvent )
+{
+    m_paoEvents[ (unsigned int)m_ulPushed & m_uiMask ] = ac_roEvent;
+    m_ulPushed = m_ulPushed + 1;
+}
+
+// Events currently held
+unsigned int Profiler::EventRing::Size() const
+{
+    unsigned long long ulPushed = m_ulPushed;
+    return ulPushed < Capacity() ? (unsigned int)ulPushed : Capacity();
+}
+
+// Index 0 is the oldest event held
+const Profiler::Event&
+    Profiler::EventRing::operator[]( unsigned int a_uiIndex ) const
+{
+    if( a_uiIndex >= Size() )
+    {
+        throw std::out_of_range( "Invalid profiler event index" );
+    }
+    unsigned long long ulPushed = m_ulPushed;
+    return m_paoEvents[ (unsigned int)( ulPushed - Size() + a_uiIndex )
+                        & m_uiMask ];
+}
+
+// How many events have been overwritten since the ring was cleared
+unsigned long long Profiler::EventRing::Dropped() const
+{
+    unsigned long long ulPushed = m_ulPushed;
+    return ulPushed < Capacity() ? 0 : ulPushed - Capacity();
+}
+
+//
+// Zone functions
+//
+
+// Start timing a CPU zone
+Profiler::Zone::Zone( const char* ac_pcName )
+    : m_pcName( nullptr ), m_dStart( 0.0 )
+{
+    if( sg_bEnabled && nullptr != ac_pcName )
+    {
+        ThreadData& roThread = ThisThread();
+        if( roThread.uiDepth < MAX_DEPTH )
+        {
+            roThread.adChildTime[ roThread.uiDepth++ ] = 0.0;
+            m_pcName = ac_pcName;
+            m_dStart = Now();
+        }
+    }
+}
+
+// Finish timing a CPU zone and charge its time to the enclosing zone
+Profiler::Zone::~Zone()
+{
+    if( nullptr != m_pcName )
+    {
+        double dEnd = Now();
+        ThreadData& roThread = ThisThread();
+        unsigned int uiDepth = --roThread.uiDepth;
+        Event oEvent;
+        oEvent.pcName = m_pcName;
+        oEvent.dStart = m_dStart;
+        oEvent.dEnd = dEnd;
+        oEvent.dChildTime = roThread.adChildTime[ uiDepth ];
+        oEvent.uiDepth = uiDepth;
+        oEvent.uiThread = roThread.uiIndex;
+        oEvent.bGPU = false;
+        roThread.oEvents.Push( oEvent );
+        if( 0 < uiDepth )
+        {
+            roThread.adChildTime[ uiDepth - 1 ] += dEnd - m_dStart;
+        }
+    }
+}
+
+//
+// GPUZone functions
+//
+
+// Write a timestamp when the GPU reaches this point
+Profiler::GPUZone::GPUZone( const char* ac_pcName )
+    : m_pcName( nullptr )
+{
+    m_auiQueries[0] = m_auiQueries[1] = 0;
+    if( sg_bEnabled && nullptr != ac_pcName && CanTimeGPU() )
+    {
+        // Work out how GPU time lines up with CPU time
+        if( !sg_bGPUCalibrated )
+        {
+            GLint64 iTimestamp = 0;
+            glGetInteger64v( GL_TIMESTAMP, &iTimestamp );
+            sg_dGPUOffset = Now() - (double)iTimestamp * 1.0e-9;
+            sg_bGPUCalibrated = true;
+        }
+        m_pcName = ac_pcName;
+        glGenQueries( 2, m_auiQueries );
+        glQueryCounter( m_auiQueries[0], GL_TIMESTAMP );
+        ++sg_uiGPUDepth;
+    }
+}
+
+// Write another timestamp and leave the pair for EndFrame to collect
+Profiler::GPUZone::~GPUZone()
+{
+    if( nullptr != m_pcName )
+    {
+        glQueryCounter( m_auiQueries[1], GL_TIMESTAMP );
+        PendingQuery oQuery;
+        oQuery.pcName = m_pcName;
+        oQuery.auiQueries[0] = m_auiQueries[0];
+        oQuery.auiQueries[1] = m_auiQueries[1];
+        oQuery.uiDepth = --sg_uiGPUDepth;
+        PendingQueryList::Instance().push_back( oQuery );
+    }
+}
+
+//
+// Static functions
+//
+
+// Turn recording on or off at runtime
+void Profiler::SetEnabled( bool a_bEnabled )
+{
+    sg_bEnabled = a_bEnabled;
+}
+bool Profiler::IsEnabled()
+{
+    return sg_bEnabled;
+}
+
+// Add to one of this frame's counters
+void Profiler::Count( Counter a_eCounter, unsigned int a_uiAmount )
+{
+    if( sg_bEnabled && COUNTER_COUNT > a_eCounter )
+    {
+        sg_auiCounters[ a_eCounter ] += a_uiAmount;
+    }
+}
+
+// Current frame's value for a counter
+unsigned int Profiler::CounterValue( Counter a_eCounter )
+{
+    return COUNTER_COUNT > a_eCounter ? sg_auiCounters[ a_eCounter ] : 0;
+}
+
+// Collect finished GPU zones, store this frame's counters, and start a new
+// frame
+void Profiler::EndFrame()
+{
+    double dNow = Now();
+
+    // GPU queries finish in order, so stop at the first one that isn't done
+    PendingQueryList& roPending = PendingQueryList::Instance();
+    unsigned int uiDone = 0;
+    for( ; uiDone < roPending.size(); ++uiDone )
+    {
+        const PendingQuery& roQuery = roPending[ uiDone ];
+        GLint iAvailable = GL_FALSE;
+        glGetQueryObjectiv( roQuery.auiQueries[1], GL_QUERY_RESULT_AVAILABLE,
+                            &iAvailable );
+        if( GL_FALSE == iAvailable )
+        {
+            break;
+        }
+        GLuint64 auiTimes[2] = { 0, 0 };
+        glGetQueryObjectui64v( roQuery.auiQueries[0], GL_QUERY_RESULT,
+                               &( auiTimes[0] ) );
+        glGetQueryObjectui64v( roQuery.auiQueries[1], GL_QUERY_RESULT,
+                               &( auiTimes[1] ) );
+        glDeleteQueries( 2, roQuery.auiQueries );
+
+        Event oEvent;
+        oEvent.pcName = roQuery.pcName;
+        oEvent.dStart = (double)auiTimes[0] * 1.0e-9 + sg_dGPUOffset;
+        oEvent.dEnd = (double)auiTimes[1] * 1.0e-9 + sg_dGPUOffset;
+        oEvent.dChildTime = 0.0;
+        oEvent.uiDepth = roQuery.uiDepth;
+        oEvent.uiThread = ThisThread().uiIndex;
+        oEvent.bGPU = true;
+        ThisThread().oEvents.Push( oEvent );
+    }
+    roPending.erase( roPending.begin(), roPending.begin() + uiDone );
+
+    // Store and reset counters
+    FrameStats& roFrame = sg_aoFrames[ sg_uiFrameCount % FRAME_HISTORY ];
+    roFrame.dStart = sg_dFrameStart;
+    roFrame.dEnd = dNow;
+    for( unsigned int ui = 0; ui < COUNTER_COUNT; ++ui )
+    {
+        roFrame.auiCounters[ ui ] = sg_auiCounters[ ui ];
+        sg_auiCounters[ ui ] = 0;
+    }
+    ++sg_uiFrameCount;
+    sg_dFrameStart = dNow;
+}
+
+// Most recently finished frame
+const Profiler::FrameStats& Profiler::LastFrame()
+{
+    return sg_aoFrames[ ( sg_uiFrameCount + FRAME_HISTORY - 1 )
+                        % FRAME_HISTORY ];
+}
+
+// The ring the calling thread records into
+Profiler::EventRing& Profiler::ThreadEvents()
+{
+    return ThisThread().oEvents;
+}
+
+// Sum up events by name
+unsigned int Profiler::Aggregate( const EventRing& ac_roEvents,
+                                  ZoneStats* a_paoStats,
+                                  unsigned int a_uiMaxStats )
+{
+    if( nullptr == a_paoStats )
+    {
+        return 0;
+    }
+    unsigned int uiStats = 0;
+    for( unsigned int ui = 0; ui < ac_roEvents.Size(); ++ui )
+    {
+        const Event& roEvent = ac_roEvents[ ui ];
+        double dTime = roEvent.dEnd - roEvent.dStart;
+
+        // Find the entry for this name.  Names are usually literals, so try
+        // comparing addresses before comparing text.
+        unsigned int uiEntry = 0;
+        while( uiEntry < uiStats &&
+               a_paoStats[ uiEntry ].pcName != roEvent.pcName &&
+               0 != std::strcmp( a_paoStats[ uiEntry ].pcName,
+                                 roEvent.pcName ) )
+        {
+            ++uiEntry;
+        }
+        if( uiEntry == uiStats )
+        {
+            if( uiStats == a_uiMaxStats )
+            {
+                continue;
+            }
+            ZoneStats& roNew = a_paoStats[ uiStats++ ];
+            roNew.pcName = roEvent.pcName;
+            roNew.uiCalls = 0;
+            roNew.dTotalTime = 0.0;
+            roNew.dSelfTime = 0.0;
+            roNew.dMinTime = dTime;
+            roNew.dMaxTime = dTime;
+        }
+
+        ZoneStats& roStats = a_paoStats[ uiEntry ];
+        ++roStats.uiCalls;
+        roStats.dTotalTime += dTime;
+        roStats.dSelfTime += dTime - roEvent.dChildTime;
+        if( dTime < roStats.dMinTime )
+        {
+            roStats.dMinTime = dTime;
+        }
+        if( dTime > roStats.dMaxTime )
+        {
+            roStats.dMaxTime = dTime;
+        }
+    }
+    return uiStats;
+}
+
+// Write everything recorded so far as a chrome://tracing JSON file
+bool Profiler::WriteChromeTrace( const char* ac_pcFileName )
+{
+    std::ofstream oFile( ac_pcFileName );
+    if( !oFile )
+    {
+        return false;
+    }
+    oFile << std::fixed << std::setprecision( 3 ) << "{\"traceEvents\":[";
+    bool bFirst = true;
+
+    // Zones, as complete ("X") events with times in microseconds.  GPU zones
+    // get their own row under the thread that recorded them.
+    for( ThreadData* poThread = sg_poThreads;
+         nullptr != poThread; poThread = poThread->poNext )
+    {
+        const EventRing& roEvents = poThread->oEvents;
+        for( unsigned int ui = 0; ui < roEvents.Size(); ++ui )
+        {
+            const Event& roEvent = roEvents[ ui ];
+            oFile << ( bFirst ? "\n" : ",\n" ) << "{\"name\":";
+            WriteJSONString( oFile, roEvent.pcName );
+            oFile << ",\"cat\":\"" << ( roEvent.bGPU ? "gpu" : "cpu" )
+                  << "\",\"ph\":\"X\",\"ts\":" << roEvent.dStart * 1.0e6
+                  << ",\"dur\":" << ( roEvent.dEnd - roEvent.dStart ) * 1.0e6
+                  << ",\"pid\":1,\"tid\":"
+                  << roEvent.uiThread * 2 + ( roEvent.bGPU ? 1 : 0 ) << "}";
+            bFirst = false;
+        }
+    }
+
+    // Counters, as counter ("C") events at the end of each frame
+    static const char* const sc_apcCounterNames[ COUNTER_COUNT ] =
+        { "draw calls", "uniform uploads", "texture binds",
+          "buffer stalls", "culled objects" };
+    unsigned int uiFrames = ( sg_uiFrameCount < FRAME_HISTORY
+                              ? sg_uiFrameCount : FRAME_HISTORY );
+    for( unsigned int ui = sg_uiFrameCount - uiFrames;
+         ui < sg_uiFrameCount; ++ui )
+    {
+        const FrameStats& roFrame = sg_aoFrames[ ui % FRAME_HISTORY ];
+        oFile << ( bFirst ? "\n" : ",\n" )
+              << "{\"name\":\"counters\",\"ph\":\"C\",\"ts\":"
+              << roFrame.dEnd * 1.0e6 << ",\"pid\":1,\"args\":{";
+        for( unsigned int uiCounter = 0; uiCounter < COUNTER_COUNT; ++uiCounter )
+        {
+            oFile << ( 0 == uiCounter ? "\"" : ",\"" )
+                  << sc_apcCounterNames[ uiCounter ] << "\":"
+                  << roFrame.auiCounters[ uiCounter ];
+        }
+        oFile << "}}";
+        bFirst = false;
+    }
+
+    oFile << "\n]}\n";
+    return oFile.good();
+}
+
+// Forget everything recorded so far
+void Profiler::Clear()
+{
+    for( ThreadData* poThread = sg_poThreads;
+         nullptr != poThread; poThread = poThread->poNext )
+    {
+        poThread->oEvents.Clear();
+    }
+    sg_uiFrameCount = 0;
+    for( unsigned int ui = 0; ui < COUNTER_COUNT; ++ui )
+    {
+        sg_auiCounters[ ui ] = 0;
+    }
+}
+
+// Current time, in seconds.  glfwGetTime uses the highest-resolution timer
+// available.
+double Profiler::Now()
+{
+    return glfwGetTime();
+}
+
+}   // namespace MyFirstEngine
@@ -0,0 +1,414 @@
+/******************************************************************************
+ * File:               ProgramBinaryCache.cpp
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Function implementations for the ProgramBinaryCache
+ *                       class.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Creation.
+ ******************************************************************************/
+
+#include "../Declarations/GLFW.h"
+#include "../Declarations/ProgramBinaryCache.h"
+#include "MathLibrary.h"
+#include <cstdio>   // for remove and rename
+#include <fstream>
+#include <string>   // for char_traits
+#ifdef _WIN32
+#include <direct.h> // for _mkdir
+#else
+#include <sys/stat.h>   // for mkdir
+#endif
+
+//
+// File-only helper functions and classes
+//
+namespace
+{
+
+using MyFirstEngine::ProgramBinaryCache;
+
+// Identifies a cache file, along with the version of the file layout
+const char sg_acMagic[4] = { 'M', 'F', 'P', 'B' };
+const unsigned int sg_uiVersion = 1;
+
+// Cache file header.  Fields are written one at a time, so padding doesn't
+// matter.
+struct EntryHeader
+{
+    char acMagic[4];
+    unsigned int uiVersion;
+    ProgramBinaryCache::Key ulKey;
+    unsigned int uiFormat;
+    unsigned int uiSize;
+    ProgramBinaryCache::Key ulChecksum;
+};
+
+// Read/write a single header field
+template< typename T >
+bool ReadField( std::istream& a_roInput, T& a_rValue )
+{
+    a_roInput.read( (char*)&a_rValue, sizeof( T ) );
+    return a_roInput.good();
+}
+template< typename T >
+void WriteField( std::ostream& a_roOutput, const T& ac_rValue )
+{
+    a_roOutput.write( (const char*)&ac_rValue, sizeof( T ) );
+}
+
+// Make a directory, ignoring the error if it already exists
+void MakeDirectory( const char* ac_pcName )
+{
+#ifdef _WIN32
+    _mkdir( ac_pcName );
+#else
+    mkdir( ac_pcName, 0777 );
+#endif
+}
+
+// Backend that makes real GL calls
+class GLProgramBinaryBackend : public ProgramBinaryCache::Backend
+{
+public:
+
+    virtual ~GLProgramBinaryBackend() {}
+
+    // Program binaries are core in 4.1, and available as an extension before
+    // that, but some drivers support the calls without supporting any formats.
+    virtual bool IsSupported() const override
+    {
+        if( GL_FALSE == GLEW_VERSION_4_1 &&
+            GL_FALSE == GLEW_ARB_get_program_binary )
+        {
+            return false;
+        }
+        GLint iFormats = 0;
+        glGetIntegerv( GL_NUM_PROGRAM_BINARY_FORMATS, &iFormats );
+        return ( 0 < iFormats );
+    }
+
+    // A driver update changes at least one of these
+    virtual Utility::DumbString DriverIdentity() const override
+    {
+        Utility::DumbString oIdentity;
+        const GLenum caeNames[] = { GL_VENDOR, GL_RENDERER, GL_VERSION,
+                                    GL_SHADING_LANGUAGE_VERSION };
+        for( unsigned int ui = 0; ui < 4; ++ui )
+        {
+            const GLubyte* pcValue = glGetString( caeNames[ui] );
+            if( nullptr != pcValue )
+            {
+                oIdentity += (const char*)pcValue;
+            }
+            oIdentity += '\n';
+        }
+        return oIdentity;
+    }
+
+    virtual void PrepareToStore( GLuint a_uiProgram ) const override
+    {
+        glProgramParameteri( a_uiProgram,
+                             GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE );
+    }
+
+    virtual std::size_t BinarySize( GLuint a_uiProgram ) const override
+    {
+        GLint iSize = 0;
+        glGetProgramiv( a_uiProgram, GL_PROGRAM_BINARY_LENGTH, &iSize );
+        return ( 0 < iSize ? (std::size_t)iSize : 0 );
+    }
+
+    virtual bool GetBinary( GLuint a_uiProgram, GLenum& a_reFormat,
+                            char* a_pcData, std::size_t a_uiSize ) const override
+    {
+        GLsizei iLength = 0;
+        glGetProgramBinary( a_uiProgram, (GLsizei)a_uiSize, &iLength,
+                            &a_reFormat, a_pcData );
+        return ( (GLsizei)a_uiSize == iLength );
+    }
+
+    virtual bool LoadBinary( GLuint a_uiProgram, GLenum a_eFormat,
+                             const char* ac_pcData,
+                             std::size_t a_uiSize ) const override
+    {
+        glProgramBinary( a_uiProgram, a_eFormat, ac_pcData, (GLsizei)a_uiSize );
+        GLint iLinked = GL_FALSE;
+        glGetProgramiv( a_uiProgram, GL_LINK_STATUS, &iLinked );
+        return ( GL_TRUE == iLinked );
+    }
+
+};  // class GLProgramBinaryBackend
+
+// The cache ShaderProgram uses
+ProgramBinaryCache& DefaultCache()
+{
+    static ProgramBinaryCache soCache;
+    return soCache;
+}
+ProgramBinaryCache* sg_poCurrent = nullptr;
+bool sg_bCurrentSet = false;
+
+}   // namespace
+
+//
+// Class functions
+//
+namespace MyFirstEngine
+{
+
+using namespace Utility;
+
+// Cache files go here unless told otherwise
+const char* const ProgramBinaryCache::DEFAULT_DIRECTORY =
+                                                "resources/shaders/cache/";
+
+// Constructor
+ProgramBinaryCache::ProgramBinaryCache( const char* ac_pcDirectory,
+                                        const Backend& ac_roBackend )
+    : m_oDirectory( nullptr == ac_pcDirectory ? "" : ac_pcDirectory ),
+      m_poBackend( &ac_roBackend ), m_iSupported( -1 ), m_ulDriverHash( 0 ),
+      m_uiHits( 0 ), m_uiMisses( 0 ), m_uiRejections( 0 ) {}
+
+// Is the cache usable?
+bool ProgramBinaryCache::IsEnabled() const
+{
+    if( m_oDirectory.IsEmpty() )
+    {
+        return false;
+    }
+    if( 0 > m_iSupported )
+    {
+        m_iSupported = ( m_poBackend->IsSupported() ? 1 : 0 );
+        if( 0 < m_iSupported )
+        {
+            DumbString oIdentity = m_poBackend->DriverIdentity();
+            m_ulDriverHash = HashBytes( oIdentity.CString(), oIdentity.Size() );
+        }
+    }
+    return ( 0 < m_iSupported );
+}
+
+// Combine the driver identity with the source hashes of a program's shaders
+ProgramBinaryCache::Key
+    ProgramBinaryCache::MakeKey( const Key* ac_paulSourceHashes,
+                                 unsigned int a_uiCount ) const
+{
+    if( !IsEnabled() || nullptr == ac_paulSourceHashes || 0 == a_uiCount )
+    {
+        return 0;
+    }
+    Key ulKey = m_ulDriverHash;
+    for( unsigned int ui = 0; ui < a_uiCount; ++ui )
+    {
+        if( 0 == ac_paulSourceHashes[ui] )
+        {
+            return 0;
+        }
+        ulKey = HashBytes( &( ac_paulSourceHashes[ui] ), sizeof( Key ), ulKey );
+    }
+    return ( 0 == ulKey ? 1 : ulKey );
+}
+
+// Try to load the cached binary for the given key into a program
+bool ProgramBinaryCache::Load( Key a_ulKey, GLuint a_uiProgram )
+{
+    if( 0 == a_ulKey || !IsEnabled() )
+    {
+        return false;
+    }
+
+    // If there's no file, it's a plain miss
+    std::ifstream oFile( FileName( a_ulKey ), std::ios::in | std::ios::binary );
+    if( !oFile )
+    {
+        ++m_uiMisses;
+        return false;
+    }
+    oFile.close();
+
+    // If there's a file but it can't be used, get rid of it so the program's
+    // binary can be stored again once it's linked from source.
+    GLenum eFormat = 0;
+    DynamicArray< char > oData;
+    if( !ReadEntry( a_ulKey, eFormat, oData ) ||
+        !m_poBackend->LoadBinary( a_uiProgram, eFormat,
+                                  &( oData[0] ), oData.Size() ) )
+    {
+        Invalidate( a_ulKey );
+        ++m_uiRejections;
+        return false;
+    }
+    ++m_uiHits;
+    return true;
+}
+
+// Ask for a program about to be linked from source to keep its binary
+// retrievable
+void ProgramBinaryCache::PrepareToStore( GLuint a_uiProgram ) const
+{
+    if( IsEnabled() )
+    {
+        m_poBackend->PrepareToStore( a_uiProgram );
+    }
+}
+
+// Write the binary of a successfully linked program to the cache
+bool ProgramBinaryCache::Store( Key a_ulKey, GLuint a_uiProgram )
+{
+    if( 0 == a_ulKey || !IsEnabled() )
+    {
+        return false;
+    }
+
+    // Get the binary
+    std::size_t uiSize = m_poBackend->BinarySize( a_uiProgram );
+    if( 0 == uiSize || MAX_BINARY_SIZE < uiSize )
+    {
+        return false;
+    }
+    DynamicArray< char > oData( (unsigned int)uiSize );
+    GLenum eFormat = 0;
+    if( !m_poBackend->GetBinary( a_uiProgram, eFormat, &( oData[0] ), uiSize ) )
+    {
+        return false;
+    }
+
+    // Write to a temporary file first, so that a crash partway through never
+    // leaves a half-written entry under the real name.
+    DumbString oFileName = FileName( a_ulKey );
+    DumbString oTempName = oFileName + ".tmp";
+    std::ofstream oFile( oTempName, std::ios::out | std::ios::binary );
+    if( !oFile )
+    {
+        MakeDirectory( m_oDirectory );
+        oFile.clear();
+        oFile.open( oTempName, std::ios::out | std::ios::binary );
+        if( !oFile )
+        {
+            return false;
+        }
+    }
+    WriteField( oFile, sg_acMagic );
+    WriteField( oFile, sg_uiVersion );
+    WriteField( oFile, a_ulKey );
+    WriteField( oFile, (unsigned int)eFormat );
+    WriteField( oFile, (unsigned int)uiSize );
+    WriteField( oFile, HashBytes( &( oData[0] ), uiSize ) );
+    oFile.write( &( oData[0] ), uiSize );
+    bool bWritten = oFile.good();
+    oFile.close();
+
+    // Swap the finished file in for any old entry
+    std::remove( oFileName );
+    if( !bWritten || 0 != std::rename( oTempName, oFileName ) )
+    {
+        std::remove( oTempName );
+        return false;
+    }
+    return true;
+}
+
+// Delete the cache entry for a key, if there is one
+void ProgramBinaryCache::Invalidate( Key a_ulKey ) const
+{
+    std::remove( FileName( a_ulKey ) );
+}
+
+// Get the name of the file holding the entry for a key
+DumbString ProgramBinaryCache::FileName( Key a_ulKey ) const
+{
+    static const char sc_acDigits[] = "0123456789abcdef";
+    char acName[ 2 * sizeof( Key ) + 1 ];
+    for( unsigned int ui = 0; ui < 2 * sizeof( Key ); ++ui )
+    {
+        acName[ 2 * sizeof( Key ) - 1 - ui ] =
+            sc_acDigits[ ( a_ulKey >> ( 4 * ui ) ) & 0xF ];
+    }
+    acName[ 2 * sizeof( Key ) ] = '\0';
+    return m_oDirectory + acName + ".bin";
+}
+
+// Read a cache file, returning false if anything about it is off
+bool ProgramBinaryCache::ReadEntry( Key a_ulKey, GLenum& a_reFormat,
+                                   DynamicArray< char >& a_roData ) const
+{
+    std::ifstream oFile( FileName( a_ulKey ), std::ios::in | std::ios::binary );
+    EntryHeader oHeader;
+    if( !oFile ||
+        !ReadField( oFile, oHeader.acMagic ) ||
+        !ReadField( oFile, oHeader.uiVersion ) ||
+        !ReadField( oFile, oHeader.ulKey ) ||
+        !ReadField( oFile, oHeader.uiFormat ) ||
+        !ReadField( oFile, oHeader.uiSize ) ||
+        !ReadField( oFile, oHeader.ulChecksum ) )
+    {
+        return false;
+    }
+
+    // The header has to match what was asked for.  Checking the key as well as
+    // the file name catches files that were renamed or copied.
+    for( unsigned int ui = 0; ui < 4; ++ui )
+    {
+        if( sg_acMagic[ui] != oHeader.acMagic[ui] )
+        {
+            return false;
+        }
+    }
+    if( sg_uiVersion != oHeader.uiVersion || a_ulKey != oHeader.ulKey ||
+        0 == oHeader.uiSize || MAX_BINARY_SIZE < oHeader.uiSize )
+    {
+        return false;
+    }
+
+    // The data has to be all there, with nothing extra, and match the checksum
+    a_roData.SetSize( oHeader.uiSize );
+    oFile.read( &( a_roData[0] ), oHeader.uiSize );
+    if( !oFile.good() ||
+        std::char_traits< char >::eof() != oFile.peek() ||
+        oHeader.ulChecksum != HashBytes( &( a_roData[0] ), oHeader.uiSize ) )
+    {
+        return false;
+    }
+    a_reFormat = (GLenum)oHeader.uiFormat;
+    return true;
+}
+
+//
+// Static functions
+//
+
+// 64-bit FNV-1a hash
+ProgramBinaryCache::Key
+    ProgramBinaryCache::HashBytes( const void* ac_pData, std::size_t a_uiSize,
+                                   Key a_ulBasis )
+{
+    const unsigned char* pcByte = (const unsigned char*)ac_pData;
+    Key ulHash = a_ulBasis;
+    for( std::size_t ui = 0; ui < a_uiSize; ++ui )
+    {
+        ulHash ^= pcByte[ui];
+        ulHash *= 1099511628211ULL;
+    }
+    return ulHash;
+}
+
+// Backend that makes the real GL calls
+const ProgramBinaryCache::Backend& ProgramBinaryCache::GLBackend()
+{
+    static GLProgramBinaryBackend soBackend;
+    return soBackend;
+}
+
+// The cache used by ShaderProgram::Setup()
+ProgramBinaryCache* ProgramBinaryCache::Current()
+{
+    return sg_bCurrentSet ? sg_poCurrent : &DefaultCache();
+}
+void ProgramBinaryCache::SetCurrent( ProgramBinaryCache* a_poCache )
+{
+    sg_poCurrent = a_poCache;
+    sg_bCurrentSet = true;
+}
+
+}   // namespace MyFirstEngine
@@ -3,22 +3,32 @@
  * Author:             Elizabeth Lowry
  * Date Created:       February 26, 2014
  * Description:        Function implementations for the QuadShaderProgram class.
- * Last Modified:      March 17, 2014
- * Last Modification:  Adding replacement for deprecated OpenGL matrix stack.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Named the number of uniforms set per quad.
  ******************************************************************************/
 
 #include "../Declarations/GameEngine.h"
 #include "../Declarations/GLFW.h"
+#include "../Declarations/Profiler.h"
 #include "../Declarations/QuadShaderProgram.h"
+#include "../Declarations/RenderQueue.h"
 #include "../Declarations/Shader.h"
 #include "../Declarations/ShaderProgram.h"
 
 namespace MyFirstEngine
 {
 
-// default quad shader source code files
+// default quad shader source code files and the name of the uniform that
+// depends on the precision chosen in Precision.h
+#ifdef MY_FIRST_ENGINE_SINGLE_PRECISION
+const char* const QuadShaderProgram::QUAD_VERTEX_SHADER_FILE =
+                                       "resources/shaders/QuadVertexFloat.glsl";
+static const char* const sgc_pcModelViewProjection = "u_m4ModelViewProjection";
+#else
 const char* const QuadShaderProgram::QUAD_VERTEX_SHADER_FILE =
                                             "resources/shaders/QuadVertex.glsl";
+static const char* const sgc_pcModelViewProjection = "u_dm4ModelViewProjection";
+#endif
 const char* const QuadShaderProgram::QUAD_FRAGMENT_SHADER_FILE =
                                           "resources/shaders/QuadFragment.glsl";
 
@@ -60,7 +70,7 @@ void QuadShaderProgram::SetupData()
 {
     // Get location of uniform variables
     GLint iModelViewProjectionID =
-        glGetUniformLocation( m_uiID, "u_dm4ModelViewProjection" );
+        glGetUniformLocation( m_uiID, sgc_pcModelViewProjection );
     GLint iColorID = glGetUniformLocation( m_uiID, "u_v4Color" );
 
     // Create vertex array object
@@ -136,28 +146,40 @@ void QuadShaderProgram::BindElementBuffer()
 void QuadShaderProgram::DrawElements()
 {
     glDrawElements( GL_TRIANGLE_STRIP, 4, GL_UNSIGNED_INT, 0 );
+    PROFILE_COUNT( DRAW_CALLS, 1 );
 }
 
 // Draw a solid-color 1x1 quad at the origin of the XY plane (in model space)
 void QuadShaderProgram::DrawQuad( const Color::ColorVector& ac_roColor )
 {
+    // If draws are being queued up, let the queue draw this one later
+    RenderQueue* poQueue = RenderQueue::Current();
+    if( nullptr != poQueue )
+    {
+        poQueue->AddQuad( GameEngine::ModelViewProjection(), ac_roColor );
+        return;
+    }
+
     // save previous program
     const ShaderProgram& oPrevious = ShaderProgram::Current();
     Instance().Use();
 
-    // OpenGL uses column vectors, while the MathLibrary transforms are made for
-    // use with row vectors.  However, OpenGL stores matrix data in column-major
-    // order, while the MathLibrary matrices store data in row-major order, so
-    // feeding data from the latter to the former is an automatic transposition.
-    glUniformMatrix4dv( Instance().m_iModelViewProjectionID, 1, false,
-                        &( GameEngine::ModelViewProjection()[0][0] ) );
-    
-    // Set other uniforms and draw
-    glUniform4fv( Instance().m_iColorID, 1, &( ac_roColor[0] ) );
+    // Set uniforms and draw
+    SetUniforms( GameEngine::ModelViewProjection(), ac_roColor );
     DrawElements();
 
     // return to previous program
     oPrevious.Use();
 }
 
+// Set the uniforms for drawing a quad, assuming this program is in use
+void QuadShaderProgram::
+    SetUniforms( const GLTransform3D& ac_roModelViewProjection,
+                 const Math::Vector< float, 4 >& ac_roColor )
+{
+    SetUniform( Instance().m_iModelViewProjectionID, ac_roModelViewProjection );
+    glUniform4fv( Instance().m_iColorID, 1, &( ac_roColor[0] ) );
+    PROFILE_COUNT( UNIFORM_UPLOADS, UNIFORM_COUNT );
+}
+
 }   // namespace MyFirstEngine
@@ -0,0 +1,574 @@
+/******************************************************************************
+ * File:               RenderQueue.cpp
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Function implementations for the RenderQueue class.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Batches keep overlapping draws in order.
+ ******************************************************************************/
+
+#include "../Declarations/Profiler.h"
+#include "../Declarations/QuadShaderProgram.h"
+#include "../Declarations/RenderQueue.h"
+#include "../Declarations/ShaderProgram.h"
+#include "../Declarations/SpriteShaderProgram.h"
+#include "../Declarations/Texture.h"
+#include "MathLibrary.h"
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+//
+// File-only helper functions and classes
+//
+namespace
+{
+
+using MyFirstEngine::RenderQueue;
+using MyFirstEngine::Texture;
+
+// Bit positions of the sort key fields
+const unsigned int sgc_uiLayerShift = 56;
+const unsigned int sgc_uiDepthShift = 32;
+const unsigned int sgc_uiBatchShift = 16;
+const unsigned int sgc_uiProgramShift = 12;
+const unsigned int sgc_uiTextureShift = 0;
+const unsigned int sgc_uiDepthMax = 0xFFFFFF;
+const unsigned int sgc_uiBatchMax = 0xFFFF;
+const unsigned int sgc_uiProgramMax = 0xF;
+const unsigned int sgc_uiTextureMax = 0xFFF;
+
+// Backend that makes the real GL calls
+class GLRenderBackend : public RenderQueue::Backend
+{
+public:
+
+    GLRenderBackend() : m_pcoPrevious( nullptr ) {}
+    virtual ~GLRenderBackend() {}
+
+    virtual void UseProgram( RenderQueue::Program a_eProgram ) override
+    {
+        if( RenderQueue::SPRITE_PROGRAM == a_eProgram )
+        {
+            MyFirstEngine::SpriteShaderProgram::Instance().Use();
+        }
+        else
+        {
+            MyFirstEngine::QuadShaderProgram::Instance().Use();
+        }
+    }
+
+    virtual void BindTexture( Texture& a_roTexture ) override
+    {
+        a_roTexture.MakeCurrent();
+    }
+
+    virtual void Draw( const RenderQueue::Command& ac_roCommand ) override
+    {
+        if( RenderQueue::SPRITE_PROGRAM == ac_roCommand.eProgram )
+        {
+            MyFirstEngine::SpriteShaderProgram::
+                SetUniforms( *ac_roCommand.poTexture,
+                             ac_roCommand.oModelViewProjection,
+                             ac_roCommand.oOffsetUV, ac_roCommand.oSizeUV,
+                             ac_roCommand.oTexTransform, ac_roCommand.oColor );
+        }
+        else
+        {
+            MyFirstEngine::QuadShaderProgram::
+                SetUniforms( ac_roCommand.oModelViewProjection,
+                             ac_roCommand.oColor );
+        }
+        MyFirstEngine::QuadShaderProgram::DrawElements();
+    }
+
+    // Resume using the previous program once the flush is done
+    virtual void BeginSubmit() override
+    {
+        m_pcoPrevious = &MyFirstEngine::ShaderProgram::Current();
+    }
+    virtual void EndSubmit() override
+    {
+        if( nullptr != m_pcoPrevious )
+        {
+            m_pcoPrevious->Use();
+            m_pcoPrevious = nullptr;
+        }
+    }
+
+private:
+
+    const MyFirstEngine::ShaderProgram* m_pcoPrevious;
+
+};  // class GLRenderBackend
+
+// Queue that draws are currently added to
+RenderQueue* sg_poCurrent = nullptr;
+
+}   // namespace
+
+namespace MyFirstEngine
+{
+
+// PIMPLE idiom - definitions are only in the cpp so the compiler won't complain
+// about the STL containers
+class RenderQueue::CommandList : public std::vector< Command >
+{
+public:
+    virtual ~CommandList() {}
+};
+class RenderQueue::SortBuffer
+{
+public:
+    virtual ~SortBuffer() {}
+    std::vector< Key > oKeys;
+    std::vector< unsigned int > oIndices;
+    std::vector< Key > oScratchKeys;
+    std::vector< unsigned int > oScratchIndices;
+};
+class RenderQueue::TextureNumbers
+    : public std::unordered_map< Texture*, unsigned int >
+{
+public:
+    virtual ~TextureNumbers() {}
+};
+class RenderQueue::Recorder::SubmissionList : public std::vector< Submission >
+{
+public:
+    virtual ~SubmissionList() {}
+};
+
+//
+// Recorder functions
+//
+
+RenderQueue::Recorder::Recorder() : m_poSubmissions( new SubmissionList ) {}
+RenderQueue::Recorder::~Recorder()
+{
+    delete m_poSubmissions;
+}
+
+void RenderQueue::Recorder::UseProgram( Program a_eProgram )
+{
+    Submission oSubmission = { USE_PROGRAM, a_eProgram, nullptr, 0 };
+    m_poSubmissions->push_back( oSubmission );
+}
+void RenderQueue::Recorder::BindTexture( Texture& a_roTexture )
+{
+    Submission oSubmission = { BIND_TEXTURE, PROGRAM_COUNT, &a_roTexture, 0 };
+    m_poSubmissions->push_back( oSubmission );
+}
+void RenderQueue::Recorder::Draw( const Command& ac_roCommand )
+{
+    Submission oSubmission = { DRAW, ac_roCommand.eProgram,
+                               ac_roCommand.poTexture, ac_roCommand.ulKey };
+    m_poSubmissions->push_back( oSubmission );
+}
+
+unsigned int RenderQueue::Recorder::Size() const
+{
+    return m_poSubmissions->size();
+}
+const RenderQueue::Recorder::Submission&
+    RenderQueue::Recorder::operator[]( unsigned int a_uiIndex ) const
+{
+    return m_poSubmissions->at( a_uiIndex );
+}
+void RenderQueue::Recorder::Clear()
+{
+    m_poSubmissions->clear();
+}
+
+//
+// Instance functions
+//
+
+// Constructor/destructor
+RenderQueue::RenderQueue()
+    : m_poCommands( new CommandList ), m_poSortBuffer( new SortBuffer ),
+      m_poTextureNumbers( new TextureNumbers ), m_ucLayer( 0 ),
+      m_uiBatch( 0 ), m_ulBatchPosition( 0 )
+{
+    Stats oStats = { 0, 0, 0, 0, 0 };
+    m_oLastFlush = oStats;
+    Bounds oBounds = { 0.0, 0.0, 0.0, 0.0 };
+    m_oBatchBounds = oBounds;
+}
+RenderQueue::~RenderQueue()
+{
+    if( IsRecording() )
+    {
+        sg_poCurrent = nullptr;
+    }
+    delete m_poCommands;
+    delete m_poSortBuffer;
+    delete m_poTextureNumbers;
+}
+
+// Make this the queue draws are added to, until it's flushed
+void RenderQueue::Begin()
+{
+    Clear();
+    m_ucLayer = 0;
+    sg_poCurrent = this;
+}
+
+// Sort and submit the draws added since Begin
+void RenderQueue::Flush( Backend& a_roBackend )
+{
+    PROFILE_ZONE( "RenderQueue::Flush" );
+
+    // Stop recording first, so anything the backend draws is drawn right away
+    if( IsRecording() )
+    {
+        sg_poCurrent = nullptr;
+    }
+
+    // Sort indices into the command list by key.  The buffers are kept between
+    // frames, so they only allocate when the queue grows.
+    const CommandList& oCommands = *m_poCommands;
+    unsigned int uiCount = oCommands.size();
+    SortBuffer& roBuffer = *m_poSortBuffer;
+    if( roBuffer.oKeys.size() < uiCount )
+    {
+        roBuffer.oKeys.resize( uiCount );
+        roBuffer.oIndices.resize( uiCount );
+        roBuffer.oScratchKeys.resize( uiCount );
+        roBuffer.oScratchIndices.resize( uiCount );
+    }
+    for( unsigned int ui = 0; ui < uiCount; ++ui )
+    {
+        roBuffer.oKeys[ ui ] = oCommands[ ui ].ulKey;
+        roBuffer.oIndices[ ui ] = ui;
+    }
+    if( 0 < uiCount )
+    {
+        Sort( &( roBuffer.oKeys[0] ), &( roBuffer.oIndices[0] ),
+              &( roBuffer.oScratchKeys[0] ), &( roBuffer.oScratchIndices[0] ),
+              uiCount );
+    }
+
+    // Count the state changes drawing in the original order would have made
+    Stats oStats = { uiCount, 0, 0, 0, 0 };
+    Program eProgram = PROGRAM_COUNT;
+    Texture* poTexture = nullptr;
+    for( unsigned int ui = 0; ui < uiCount; ++ui )
+    {
+        const Command& roCommand = oCommands[ ui ];
+        if( roCommand.eProgram != eProgram )
+        {
+            eProgram = roCommand.eProgram;
+            ++oStats.uiUnsortedProgramChanges;
+        }
+        if( nullptr != roCommand.poTexture && roCommand.poTexture != poTexture )
+        {
+            poTexture = roCommand.poTexture;
+            ++oStats.uiUnsortedTextureChanges;
+        }
+    }
+
+    // Submit in sorted order, only changing state when it's needed.  The
+    // texture binding doesn't depend on the program, so switching programs
+    // doesn't mean the texture has to be bound again.
+    a_roBackend.BeginSubmit();
+    eProgram = PROGRAM_COUNT;
+    poTexture = nullptr;
+    for( unsigned int ui = 0; ui < uiCount; ++ui )
+    {
+        const Command& roCommand = oCommands[ roBuffer.oIndices[ ui ] ];
+        if( roCommand.eProgram != eProgram )
+        {
+            eProgram = roCommand.eProgram;
+            a_roBackend.UseProgram( eProgram );
+            ++oStats.uiProgramChanges;
+        }
+        if( nullptr != roCommand.poTexture && roCommand.poTexture != poTexture )
+        {
+            poTexture = roCommand.poTexture;
+            a_roBackend.BindTexture( *poTexture );
+            ++oStats.uiTextureChanges;
+        }
+        a_roBackend.Draw( roCommand );
+    }
+    a_roBackend.EndSubmit();
+
+    m_oLastFlush = oStats;
+    Clear();
+}
+
+// Drop the draws added since Begin without submitting them
+void RenderQueue::Clear()
+{
+    m_poCommands->clear();
+    m_poTextureNumbers->clear();
+    m_uiBatch = 0;
+}
+
+// Layer for the draws added from now on
+RenderQueue& RenderQueue::SetLayer( unsigned char a_ucLayer )
+{
+    m_ucLayer = a_ucLayer;
+    return *this;
+}
+
+// Add draws, with the depth taken from where the model-view-projection
+// matrix puts the model's origin
+void RenderQueue::AddQuad( const GLTransform3D& ac_roModelViewProjection,
+                           const Color::ColorVector& ac_roColor )
+{
+    // With row vectors, the origin ends up at the bottom row of the matrix
+    double dDepth = ( 0 < ac_roModelViewProjection[3][3]
+                      ? ac_roModelViewProjection[3][2] /
+                        ac_roModelViewProjection[3][3] : 1.0 );
+    unsigned int uiBatch = Batch( ac_roModelViewProjection, dDepth,
+                                  1.0f > ac_roColor.a );
+    m_poCommands->push_back( Command() );
+    Command& roCommand = m_poCommands->back();
+    roCommand.ulKey = MakeKey( m_ucLayer, dDepth, uiBatch, QUAD_PROGRAM, 0 );
+    roCommand.eProgram = QUAD_PROGRAM;
+    roCommand.poTexture = nullptr;
+    roCommand.oModelViewProjection = ac_roModelViewProjection;
+    roCommand.oColor = ac_roColor;
+}
+void RenderQueue::AddSprite( Texture& a_roTexture,
+                             const GLTransform3D& ac_roModelViewProjection,
+                             const Point2D& ac_roOffsetUV,
+                             const Point2D& ac_roSizeUV,
+                             const Transform2D& ac_roTexTransform,
+                             const Color::ColorVector& ac_roColor )
+{
+    double dDepth = ( 0 < ac_roModelViewProjection[3][3]
+                      ? ac_roModelViewProjection[3][2] /
+                        ac_roModelViewProjection[3][3] : 1.0 );
+    unsigned int uiBatch =
+        Batch( ac_roModelViewProjection, dDepth,
+               1.0f > ac_roColor.a || !a_roTexture.IsOpaque() );
+    m_poCommands->push_back( Command() );
+    Command& roCommand = m_poCommands->back();
+    roCommand.ulKey = MakeKey( m_ucLayer, dDepth, uiBatch, SPRITE_PROGRAM,
+                               TextureNumber( a_roTexture ) );
+    roCommand.eProgram = SPRITE_PROGRAM;
+    roCommand.poTexture = &a_roTexture;
+    roCommand.oModelViewProjection = ac_roModelViewProjection;
+    roCommand.oTexTransform = ac_roTexTransform;
+    roCommand.oOffsetUV = ac_roOffsetUV;
+    roCommand.oSizeUV = ac_roSizeUV;
+    roCommand.oColor = ac_roColor;
+}
+
+// Draws added since Begin, in the order they were added
+unsigned int RenderQueue::Size() const
+{
+    return m_poCommands->size();
+}
+const RenderQueue::Command&
+    RenderQueue::operator[]( unsigned int a_uiIndex ) const
+{
+    return m_poCommands->at( a_uiIndex );
+}
+
+// Assign the texture a number for sorting, in the order textures are first
+// seen
+unsigned int RenderQueue::TextureNumber( Texture& a_roTexture )
+{
+    TextureNumbers::iterator oFound = m_poTextureNumbers->find( &a_roTexture );
+    if( m_poTextureNumbers->end() != oFound )
+    {
+        return oFound->second;
+    }
+    unsigned int uiNumber = m_poTextureNumbers->size();
+    (*m_poTextureNumbers)[ &a_roTexture ] = uiNumber;
+    return uiNumber;
+}
+
+// Start a new batch for a draw unless it can join the open one
+unsigned int RenderQueue::Batch( const GLTransform3D& ac_roModelViewProjection,
+                                 double a_dDepth, bool a_bTranslucent )
+{
+    // Find the screen bounds of the model's unit quad.  With row vectors, a
+    // corner at ( x, y ) ends up at x * row 0 + y * row 1 + row 3.  If any
+    // corner is behind the eye, assume the draw covers everything.
+    const double cdInfinity = std::numeric_limits< double >::infinity();
+    Bounds oBounds = { cdInfinity, cdInfinity, -cdInfinity, -cdInfinity };
+    const GLTransform3D& roMatrix = ac_roModelViewProjection;
+    for( unsigned int ui = 0; ui < 4; ++ui )
+    {
+        double dX = ( 0 == ui % 2 ? -0.5 : 0.5 );
+        double dY = ( 2 > ui ? -0.5 : 0.5 );
+        double dW = dX * roMatrix[0][3] + dY * roMatrix[1][3] + roMatrix[3][3];
+        if( 0.0 >= dW )
+        {
+            Bounds oEverything = { -cdInfinity, -cdInfinity,
+                                   cdInfinity, cdInfinity };
+            oBounds = oEverything;
+            break;
+        }
+        double dCornerX =
+            ( dX * roMatrix[0][0] + dY * roMatrix[1][0] + roMatrix[3][0] ) / dW;
+        double dCornerY =
+            ( dX * roMatrix[0][1] + dY * roMatrix[1][1] + roMatrix[3][1] ) / dW;
+        oBounds.dLeft = ( dCornerX < oBounds.dLeft ? dCornerX : oBounds.dLeft );
+        oBounds.dRight = ( dCornerX > oBounds.dRight
+                           ? dCornerX : oBounds.dRight );
+        oBounds.dBottom = ( dCornerY < oBounds.dBottom
+                            ? dCornerY : oBounds.dBottom );
+        oBounds.dTop = ( dCornerY > oBounds.dTop ? dCornerY : oBounds.dTop );
+    }
+
+    // Join the open batch if this draw is opaque, has the same layer and
+    // depth, and doesn't overlap anything already in it.  Touching edges
+    // don't count as overlapping, so tiles can share a batch.
+    Key ulPosition = MakeKey( m_ucLayer, a_dDepth, 0, QUAD_PROGRAM, 0 );
+    if( !m_poCommands->empty() && !a_bTranslucent &&
+        ulPosition == m_ulBatchPosition &&
+        ( oBounds.dLeft >= m_oBatchBounds.dRight ||
+          oBounds.dRight <= m_oBatchBounds.dLeft ||
+          oBounds.dBottom >= m_oBatchBounds.dTop ||
+          oBounds.dTop <= m_oBatchBounds.dBottom ) )
+    {
+        if( oBounds.dLeft < m_oBatchBounds.dLeft )
+        {
+            m_oBatchBounds.dLeft = oBounds.dLeft;
+        }
+        if( oBounds.dBottom < m_oBatchBounds.dBottom )
+        {
+            m_oBatchBounds.dBottom = oBounds.dBottom;
+        }
+        if( oBounds.dRight > m_oBatchBounds.dRight )
+        {
+            m_oBatchBounds.dRight = oBounds.dRight;
+        }
+        if( oBounds.dTop > m_oBatchBounds.dTop )
+        {
+            m_oBatchBounds.dTop = oBounds.dTop;
+        }
+        return m_uiBatch;
+    }
+
+    // Otherwise, start a new batch with just this draw in it
+    if( !m_poCommands->empty() && sgc_uiBatchMax > m_uiBatch )
+    {
+        ++m_uiBatch;
+    }
+    m_ulBatchPosition = ulPosition;
+    m_oBatchBounds = oBounds;
+    return m_uiBatch;
+}
+
+//
+// Static functions
+//
+
+// Build a sort key
+RenderQueue::Key RenderQueue::MakeKey( unsigned char a_ucLayer,
+                                       double a_dDepth,
+                                       unsigned int a_uiBatch,
+                                       Program a_eProgram,
+                                       unsigned int a_uiTexture )
+{
+    // Farthest first - depth 1 becomes 0 and depth -1 becomes the maximum
+    double dDepth = ( a_dDepth < -1.0 ? -1.0 : a_dDepth > 1.0 ? 1.0 : a_dDepth );
+    Key ulDepth = (Key)( ( 1.0 - dDepth ) * 0.5 * sgc_uiDepthMax );
+
+    Key ulKey = ( (Key)a_ucLayer << sgc_uiLayerShift ) |
+                ( ulDepth << sgc_uiDepthShift );
+    if( sgc_uiBatchMax <= a_uiBatch )
+    {
+        // Out of batches, so leave the state bits zero to keep the draws in
+        // the order they were added
+        return ulKey | ( (Key)sgc_uiBatchMax << sgc_uiBatchShift );
+    }
+    ulKey |= ( (Key)a_uiBatch << sgc_uiBatchShift );
+    Key ulProgram = ( (unsigned int)a_eProgram < sgc_uiProgramMax
+                      ? (Key)a_eProgram : sgc_uiProgramMax );
+    Key ulTexture = ( a_uiTexture < sgc_uiTextureMax
+                      ? (Key)a_uiTexture : sgc_uiTextureMax );
+    return ulKey | ( ulProgram << sgc_uiProgramShift ) |
+                   ( ulTexture << sgc_uiTextureShift );
+}
+
+// Least-significant-digit radix sort, a byte at a time.  Each pass is stable,
+// so equal keys keep their original order.  Bytes that are the same in every
+// key, like the layer and usually the top byte of the batch, are skipped.
+void RenderQueue::Sort( Key* a_paulKeys, unsigned int* a_pauiIndices,
+                        Key* a_paulScratchKeys,
+                        unsigned int* a_pauiScratchIndices,
+                        unsigned int a_uiCount )
+{
+    // Count every byte of every key in one pass
+    unsigned int auiCounts[8][256] = {};
+    for( unsigned int ui = 0; ui < a_uiCount; ++ui )
+    {
+        Key ulKey = a_paulKeys[ ui ];
+        for( unsigned int uiByte = 0; uiByte < 8; ++uiByte )
+        {
+            ++auiCounts[ uiByte ][ ( ulKey >> ( uiByte * 8 ) ) & 0xFF ];
+        }
+    }
+
+    Key* paulFromKeys = a_paulKeys;
+    unsigned int* pauiFromIndices = a_pauiIndices;
+    Key* paulToKeys = a_paulScratchKeys;
+    unsigned int* pauiToIndices = a_pauiScratchIndices;
+    for( unsigned int uiByte = 0; uiByte < 8; ++uiByte )
+    {
+        unsigned int uiShift = uiByte * 8;
+        unsigned int* pauiCounts = auiCounts[ uiByte ];
+        if( a_uiCount == pauiCounts[ ( paulFromKeys[0] >> uiShift ) & 0xFF ] )
+        {
+            continue;
+        }
+
+        // Turn counts into starting offsets
+        unsigned int uiOffset = 0;
+        for( unsigned int ui = 0; ui < 256; ++ui )
+        {
+            unsigned int uiCount = pauiCounts[ ui ];
+            pauiCounts[ ui ] = uiOffset;
+            uiOffset += uiCount;
+        }
+
+        // Scatter
+        for( unsigned int ui = 0; ui < a_uiCount; ++ui )
+        {
+            Key ulKey = paulFromKeys[ ui ];
+            unsigned int uiDestination =
+                pauiCounts[ ( ulKey >> uiShift ) & 0xFF ]++;
+            paulToKeys[ uiDestination ] = ulKey;
+            pauiToIndices[ uiDestination ] = pauiFromIndices[ ui ];
+        }
+
+        // Swap buffers
+        Key* paulKeys = paulFromKeys;
+        paulFromKeys = paulToKeys;
+        paulToKeys = paulKeys;
+        unsigned int* pauiIndices = pauiFromIndices;
+        pauiFromIndices = pauiToIndices;
+        pauiToIndices = pauiIndices;
+    }
+
+    // If the results ended up in the scratch buffers, copy them back
+    if( paulFromKeys != a_paulKeys )
+    {
+        for( unsigned int ui = 0; ui < a_uiCount; ++ui )
+        {
+            a_paulKeys[ ui ] = paulFromKeys[ ui ];
+            a_pauiIndices[ ui ] = pauiFromIndices[ ui ];
+        }
+    }
+}
+
+// Backend that makes the real GL calls
+RenderQueue::Backend& RenderQueue::GLBackend()
+{
+    static GLRenderBackend soBackend;
+    return soBackend;
+}
+
+// The queue draws are currently added to
+RenderQueue* RenderQueue::Current()
+{
+    return sg_poCurrent;
+}
+
+}   // namespace MyFirstEngine
@@ -3,17 +3,21 @@
  * Author:             Elizabeth Lowry
  * Date Created:       February 13, 2014
  * Description:        Function implementations for the Shader class.
- * Last Modified:      March 25, 2014
- * Last Modification:  Removing PIMPL static pointers from header.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Deferring compilation and hashing source for the
+ *                       program binary cache.
  ******************************************************************************/
 
 #include "../Declarations/GameEngine.h"
 #include "../Declarations/GLFW.h"
+#include "../Declarations/ProgramBinaryCache.h"
 #include "../Declarations/Shader.h"
 #include "MathLibrary.h"
+#include <cstring>  // for strlen
 #include <fstream>
 #include <stdexcept>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 
 //
@@ -49,6 +53,26 @@ public:
 private:
     SourceNameLookup() {}
 };
+class SourceHashLookup
+    : public std::unordered_map< GLuint, MyFirstEngine::ProgramBinaryCache::Key >,
+      public Utility::Singleton< SourceHashLookup >
+{
+    friend class Utility::Singleton< SourceHashLookup >;
+public:
+    virtual ~SourceHashLookup() {}
+private:
+    SourceHashLookup() {}
+};
+class PendingCompileSet
+    : public std::unordered_set< GLuint >,
+      public Utility::Singleton< PendingCompileSet >
+{
+    friend class Utility::Singleton< PendingCompileSet >;
+public:
+    virtual ~PendingCompileSet() {}
+private:
+    PendingCompileSet() {}
+};
 ShaderLookup& Lookup()
 {
     return ShaderLookup::Instance();
@@ -57,19 +81,32 @@ SourceNameLookup& SourceLookup()
 {
     return SourceNameLookup::Instance();
 }
+SourceHashLookup& HashLookup()
+{
+    return SourceHashLookup::Instance();
+}
+PendingCompileSet& PendingCompiles()
+{
+    return PendingCompileSet::Instance();
+}
 
-// Compile a shader from the given source code
-GLuint CompileShader( const char* ac_pcSourceText, GLuint a_uiID )
+// Give a shader the given source code and mark it to be compiled the next time
+// it's needed
+GLuint LoadSource( GLenum a_eType, const char* ac_pcSourceText, GLuint a_uiID )
 {
+    using MyFirstEngine::ProgramBinaryCache;
     glShaderSource( a_uiID, 1, &ac_pcSourceText, nullptr );
-    glCompileShader( a_uiID );
+    PendingCompiles().insert( a_uiID );
+    HashLookup()[ a_uiID ] =
+        ProgramBinaryCache::HashBytes( ac_pcSourceText,
+                                       std::strlen( ac_pcSourceText ),
+                                       ProgramBinaryCache::HashBytes(
+                                           &a_eType, sizeof( GLenum ) ) );
     return a_uiID;
 }
-GLuint CompileShader( GLenum a_eType, const char* ac_pcSourceText )
+GLuint LoadSource( GLenum a_eType, const char* ac_pcSourceText )
 {
-    GLuint uiID = glCreateShader( a_eType );
-    CompileShader( ac_pcSourceText, uiID );
-    return uiID;
+    return LoadSource( a_eType, ac_pcSourceText, glCreateShader( a_eType ) );
 }
 
 }   // namespace
@@ -104,7 +141,7 @@ Shader::Shader( GLenum a_eType, const char* ac_pcSourceName, bool a_bRecompile )
         // If the recompile flag is set to true, reload and recompile the shader
         if( a_bRecompile )
         {
-            CompileShader( DumbString::LoadFrom( oSourceName ), m_uiID );
+            LoadSource( a_eType, DumbString::LoadFrom( oSourceName ), m_uiID );
         }
     }
 
@@ -112,7 +149,7 @@ Shader::Shader( GLenum a_eType, const char* ac_pcSourceName, bool a_bRecompile )
     // map.
     else
     {
-        m_uiID = CompileShader( a_eType, DumbString::LoadFrom( oSourceName ) );
+        m_uiID = LoadSource( a_eType, DumbString::LoadFrom( oSourceName ) );
         Lookup()[ a_eType ][ oSourceName ] = m_uiID;
         SourceLookup()[ m_uiID ] = oSourceName;
     }
@@ -139,18 +176,19 @@ Shader::Shader( GLenum a_eType, const char* ac_pcSourceName,
         // code is passed in, reload and recompile.
         if( a_bRecompile && ( "" != oSourceName || "" != oSourceText ) )
         {
-            CompileShader( "" == oSourceText
-                            ? DumbString::LoadFrom( oSourceName ) : oSourceText,
-                           m_uiID );
+            LoadSource( a_eType,
+                        "" == oSourceText
+                         ? DumbString::LoadFrom( oSourceName ) : oSourceText,
+                        m_uiID );
         }
     }
 
     // If there is no already-compiled shader, load and compile.
     else
     {
-        m_uiID = CompileShader( a_eType, "" == oSourceText
-                                         ? DumbString::LoadFrom( oSourceName )
-                                         : oSourceText );
+        m_uiID = LoadSource( a_eType, "" == oSourceText
+                                      ? DumbString::LoadFrom( oSourceName )
+                                      : oSourceText );
         Lookup()[ a_eType ][ oSourceName ] = m_uiID;
         SourceLookup()[ m_uiID ] = oSourceName;
     }
@@ -164,6 +202,8 @@ void Shader::Delete()
         glDeleteShader( m_uiID );
         Lookup()[ Type() ].erase( SourceLookup()[ m_uiID ] );
         SourceLookup().erase( m_uiID );
+        HashLookup().erase( m_uiID );
+        PendingCompiles().erase( m_uiID );
     }
 }
 
@@ -192,6 +232,12 @@ GLenum Shader::Type() const
     return (GLenum)iType;
 }
 
+// Hash of the shader type and source text
+unsigned long long Shader::SourceHash() const
+{
+    return 0 < HashLookup().count( m_uiID ) ? HashLookup()[ m_uiID ] : 0;
+}
+
 //
 // Static class functions
 //
@@ -208,6 +254,17 @@ void Shader::DestroyAll()
     }
     Lookup().clear();
     SourceLookup().clear();
+    HashLookup().clear();
+    PendingCompiles().clear();
+}
+
+// Compile the shader if its source has been loaded since it was last compiled
+void Shader::Compile( GLuint a_uiID )
+{
+    if( 0 < PendingCompiles().erase( a_uiID ) )
+    {
+        glCompileShader( a_uiID );
+    }
 }
 
 // Is this shader compiled and not marked for deletion?
@@ -217,6 +274,7 @@ bool Shader::IsValid( GLuint a_uiID )
     {
         return false;
     }
+    Compile( a_uiID );
     GLint iCompiled, iDeleted;
     glGetShaderiv( a_uiID, GL_COMPILE_STATUS, &iCompiled );
     glGetShaderiv( a_uiID, GL_DELETE_STATUS, &iDeleted );
@@ -3,12 +3,14 @@
  * Author:             Elizabeth Lowry
  * Date Created:       February 24, 2014
  * Description:        Function implementations for the ShaderProgram class.
- * Last Modified:      March 12, 2014
- * Last Modification:  Refactoring.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Loading programs from the binary cache and splitting
+ *                       setup so several programs can link at once.
  ******************************************************************************/
 
 #include "../Declarations/GameEngine.h"
 #include "../Declarations/GLFW.h"
+#include "../Declarations/ProgramBinaryCache.h"
 #include "../Declarations/Shader.h"
 #include "../Declarations/ShaderProgram.h"
 #include "MathLibrary.h"
@@ -70,7 +72,8 @@ public:
 
 // Default constructor used only by Null()
 ShaderProgram::ShaderProgram()
-    : m_uiID( 0 ), m_uiIndex( List().size() ), m_poShaders( new ShaderList() )
+    : m_uiID( 0 ), m_uiIndex( List().size() ), m_poShaders( new ShaderList() ),
+      m_bSetupStarted( false ), m_bFromCache( false ), m_ulCacheKey( 0 )
 {
     List().push_back( this );
 }
@@ -79,7 +82,8 @@ ShaderProgram::ShaderProgram()
 ShaderProgram::ShaderProgram( const Shader& ac_roVertexShader,
                               const Shader& ac_roFragmentShader,
                               const Shader& ac_roGeometryShader )
-    : m_uiID( 0 ), m_uiIndex( List().size() ), m_poShaders( new ShaderList() )
+    : m_uiID( 0 ), m_uiIndex( List().size() ), m_poShaders( new ShaderList() ),
+      m_bSetupStarted( false ), m_bFromCache( false ), m_ulCacheKey( 0 )
 {
     List().push_back( this );
     if( Shader::Null() != ac_roVertexShader )
@@ -97,7 +101,8 @@ ShaderProgram::ShaderProgram( const Shader& ac_roVertexShader,
 }
 ShaderProgram::ShaderProgram( const Shader* ac_paoShaders,
                               unsigned int a_uiCount )
-    : m_uiID( 0 ), m_uiIndex( List().size() ), m_poShaders( new ShaderList() )
+    : m_uiID( 0 ), m_uiIndex( List().size() ), m_poShaders( new ShaderList() ),
+      m_bSetupStarted( false ), m_bFromCache( false ), m_ulCacheKey( 0 )
 {
     List().push_back( this );
     if( nullptr != ac_paoShaders )
@@ -129,36 +134,75 @@ void ShaderProgram::Destroy()
         Lookup().erase( m_uiID );
         m_uiID = 0;
     }
+    m_bSetupStarted = false;
 }
 
-// Set up this shader program
-void ShaderProgram::Setup()
+// Start setting up this shader program, without waiting on the driver
+void ShaderProgram::StartSetup()
 {
     if( 0 == m_uiID )
     {
         m_uiID = glCreateProgram();
+        m_bSetupStarted = true;
+
+        // If the program was cached by a previous run, there's no need to
+        // compile or link anything.
+        ProgramBinaryCache* poCache = ProgramBinaryCache::Current();
+        m_ulCacheKey = ( nullptr == poCache ? 0 : CacheKey( *poCache ) );
+        m_bFromCache = ( 0 != m_ulCacheKey &&
+                         poCache->Load( m_ulCacheKey, m_uiID ) );
+        if( m_bFromCache )
+        {
+            return;
+        }
+        if( 0 != m_ulCacheKey )
+        {
+            poCache->PrepareToStore( m_uiID );
+        }
+
+        // Otherwise, send off all the compiles before attaching anything, so
+        // the driver can work on them together.  Nothing here asks for a
+        // result, so none of it has to wait.
+        for each( Shader oShader in Shaders() )
+        {
+            oShader.Compile();
+        }
         for each( Shader oShader in Shaders() )
         {
             if( Shader::Null() != oShader )
             {
-                if( !oShader.IsValid() )
-                {
-                    GameEngine::PrintError( oShader.GetLog() );
-                    glDeleteProgram( m_uiID );
-                    m_uiID = 0;
-                    return;
-                }
                 glAttachShader( m_uiID, oShader.ID() );
             }
         }
         glLinkProgram( m_uiID );
+    }
+}
+
+// Wait for the link result and finish setting up this shader program
+void ShaderProgram::FinishSetup()
+{
+    if( m_bSetupStarted )
+    {
+        m_bSetupStarted = false;
         if( IsValid() )
         {
+            ProgramBinaryCache* poCache = ProgramBinaryCache::Current();
+            if( !m_bFromCache && 0 != m_ulCacheKey && nullptr != poCache )
+            {
+                poCache->Store( m_ulCacheKey, m_uiID );
+            }
             Lookup()[ m_uiID ] = this;
             SetupData();
         }
         else
         {
+            for each( Shader oShader in Shaders() )
+            {
+                if( Shader::Null() != oShader && !oShader.IsValid() )
+                {
+                    GameEngine::PrintError( oShader.GetLog() );
+                }
+            }
             GameEngine::PrintError( GetLog() );
             glDeleteProgram( m_uiID );
             m_uiID = 0;
@@ -203,6 +247,19 @@ DumbString ShaderProgram::GetLog() const
     return oString;
 }
 
+// Get the binary cache key for this program's shaders
+ProgramBinaryCache::Key
+    ShaderProgram::CacheKey( const ProgramBinaryCache& ac_roCache ) const
+{
+    std::vector< ProgramBinaryCache::Key > oHashes;
+    for each( Shader oShader in Shaders() )
+    {
+        oHashes.push_back( oShader.SourceHash() );
+    }
+    return oHashes.empty() ? 0 : ac_roCache.MakeKey( &( oHashes[0] ),
+                                                     oHashes.size() );
+}
+
 // Is the program linked and not flagged for deletion?
 bool ShaderProgram::IsValid() const
 {
@@ -241,6 +298,18 @@ void ShaderProgram::DestroyAll()
     }
 }
 
+// finish setting up any programs that have started but not finished
+void ShaderProgram::FinishAllSetups()
+{
+    for each( ShaderProgram* poProgram in List() )
+    {
+        if( nullptr != poProgram )
+        {
+            poProgram->FinishSetup();
+        }
+    }
+}
+
 // get a shader program representing no shader program
 const ShaderProgram& ShaderProgram::Null()
 {
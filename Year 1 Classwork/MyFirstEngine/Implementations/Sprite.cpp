@@ -3,8 +3,9 @@
  * Author:             Elizabeth Lowry
  * Date Created:       March 5, 2014
  * Description:        Implementations for Sprite functions.
- * Last Modified:      March 17, 2014
- * Last Modification:  Debugging.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Building the scale/rotate/translate part of the model
+ *                      matrix directly.
  ******************************************************************************/
 
 #include "../Declarations/Sprite.h"
@@ -256,9 +257,10 @@ const Transform3D& Sprite::GetModelMatrix() const
     {
         CurrentFrame().DisplayAreaVertexTransform( *m_poModelMatrix );
         *m_poModelMatrix *= m_oBeforeTransform *
-                            Space::Scaling( m_oScale ) *
-                            m_oRotation.MakeTransform() *
-                            Space::Translation( m_oPosition ) *
+                            Space::Homogeneous(
+                                Space::Affine( m_oScale,
+                                               m_oRotation.MakePointTransform(),
+                                               m_oPosition ) ) *
                             m_oAfterTransform;
         *m_pbUpdateModelMatrix = false;
     }
@@ -0,0 +1,460 @@
+/******************************************************************************
+ * File:               SpriteBatch.cpp
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Function implementations for the SpriteBatch class.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Skipping sprites with no texture, and streaming each
+ *                      flush's instances into one region.
+ ******************************************************************************/
+
+#include "../Declarations/GameEngine.h"
+#include "../Declarations/InstancedSpriteShaderProgram.h"
+#include "../Declarations/Profiler.h"
+#include "../Declarations/ShaderProgram.h"
+#include "../Declarations/SpriteBatch.h"
+#include "MathLibrary.h"
+#include <map>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+//
+// File-only helper functions and classes
+//
+namespace
+{
+
+using MyFirstEngine::SpriteBatch;
+using MyFirstEngine::Texture;
+
+// Backend that makes the real GL calls
+class GLSpriteBatchBackend : public SpriteBatch::Backend
+{
+public:
+
+    GLSpriteBatchBackend() : m_pcoPrevious( nullptr ) {}
+    virtual ~GLSpriteBatchBackend() {}
+
+    virtual void
+        UploadFrames( const SpriteBatch::FrameDescriptor* ac_paoFrames,
+                      unsigned int a_uiCount ) override
+    {
+        MyFirstEngine::InstancedSpriteShaderProgram::
+            SetFrameTable( ac_paoFrames, a_uiCount );
+    }
+
+    virtual void DrawInstances( Texture& a_roTexture,
+                                const SpriteBatch::Instance* ac_paoInstances,
+                                unsigned int a_uiCount ) override
+    {
+        MyFirstEngine::InstancedSpriteShaderProgram::
+            DrawInstances( a_roTexture, ac_paoInstances, a_uiCount );
+    }
+
+    // Remember which program was in use, and go back to it when done.  All
+    // the draws in a flush share one region of the instance buffer.
+    virtual void BeginSubmit() override
+    {
+        m_pcoPrevious = &MyFirstEngine::ShaderProgram::Current();
+        MyFirstEngine::InstancedSpriteShaderProgram::BeginInstances();
+    }
+    virtual void EndSubmit() override
+    {
+        MyFirstEngine::InstancedSpriteShaderProgram::EndInstances();
+        if( nullptr != m_pcoPrevious )
+        {
+            m_pcoPrevious->Use();
+            m_pcoPrevious = nullptr;
+        }
+    }
+
+private:
+
+    const MyFirstEngine::ShaderProgram* m_pcoPrevious;
+
+};  // class GLSpriteBatchBackend
+
+// Convert a matrix to floats in the order its elements are stored
+template< typename T >
+void CopyMatrix( const Math::Matrix< T, 4 >& ac_roMatrix, float* a_pafResult )
+{
+    for( unsigned int ui = 0; ui < 4; ++ui )
+    {
+        for( unsigned int uj = 0; uj < 4; ++uj )
+        {
+            a_pafResult[ ui * 4 + uj ] = (float)( ac_roMatrix[ui][uj] );
+        }
+    }
+}
+
+}   // namespace
+
+namespace MyFirstEngine
+{
+
+// PIMPLE idiom - definitions are only in the cpp so the compiler won't complain
+// about the STL containers
+class SpriteBatch::InstanceList
+{
+public:
+    virtual ~InstanceList() {}
+    std::vector< Instance > oInstances;
+    std::vector< Texture* > oTextures;      // one per instance
+
+    // Scratch space for grouping by texture in Flush
+    std::vector< Instance > oGrouped;
+    std::vector< unsigned int > oGroups;    // one per instance
+    std::vector< Texture* > oGroupTextures;
+    std::vector< unsigned int > oGroupStarts;
+    std::unordered_map< Texture*, unsigned int > oGroupNumbers;
+};
+class SpriteBatch::FrameTable
+{
+public:
+    FrameTable() : pcoLastList( nullptr ), poLastTexture( nullptr ),
+                   uiLastFirst( 0 ) {}
+    virtual ~FrameTable() {}
+    typedef std::pair< const Frame::Array*, Texture* > Key;
+    std::vector< FrameDescriptor > oFrames;
+    std::map< Key, unsigned int > oFirstFrames;
+
+    // Sprites added one after another usually share a frame list
+    const Frame::Array* pcoLastList;
+    Texture* poLastTexture;
+    unsigned int uiLastFirst;
+};
+class SpriteBatch::Recorder::FrameList : public std::vector< FrameDescriptor >
+{
+public:
+    virtual ~FrameList() {}
+};
+class SpriteBatch::Recorder::DrawList : public std::vector< Draw >
+{
+public:
+    virtual ~DrawList() {}
+};
+class SpriteBatch::Recorder::InstanceList : public std::vector< Instance >
+{
+public:
+    virtual ~InstanceList() {}
+};
+
+//
+// Recorder functions
+//
+
+SpriteBatch::Recorder::Recorder()
+    : m_poFrames( new FrameList ), m_poDraws( new DrawList ),
+      m_poInstances( new InstanceList ), m_uiUploads( 0 ) {}
+SpriteBatch::Recorder::~Recorder()
+{
+    delete m_poFrames;
+    delete m_poDraws;
+    delete m_poInstances;
+}
+
+void SpriteBatch::Recorder::UploadFrames( const FrameDescriptor* ac_paoFrames,
+                                          unsigned int a_uiCount )
+{
+    m_poFrames->assign( ac_paoFrames, ac_paoFrames + a_uiCount );
+    ++m_uiUploads;
+}
+void SpriteBatch::Recorder::DrawInstances( Texture& a_roTexture,
+                                           const Instance* ac_paoInstances,
+                                           unsigned int a_uiCount )
+{
+    Draw oDraw = { &a_roTexture, (unsigned int)m_poInstances->size(),
+                   a_uiCount };
+    m_poDraws->push_back( oDraw );
+    m_poInstances->insert( m_poInstances->end(),
+                           ac_paoInstances, ac_paoInstances + a_uiCount );
+}
+
+unsigned int SpriteBatch::Recorder::FrameCount() const
+{
+    return m_poFrames->size();
+}
+const SpriteBatch::FrameDescriptor&
+    SpriteBatch::Recorder::GetFrame( unsigned int a_uiIndex ) const
+{
+    return m_poFrames->at( a_uiIndex );
+}
+unsigned int SpriteBatch::Recorder::DrawCount() const
+{
+    return m_poDraws->size();
+}
+const SpriteBatch::Recorder::Draw&
+    SpriteBatch::Recorder::GetDraw( unsigned int a_uiIndex ) const
+{
+    return m_poDraws->at( a_uiIndex );
+}
+unsigned int SpriteBatch::Recorder::InstanceCount() const
+{
+    return m_poInstances->size();
+}
+const SpriteBatch::Instance&
+    SpriteBatch::Recorder::GetInstance( unsigned int a_uiIndex ) const
+{
+    return m_poInstances->at( a_uiIndex );
+}
+void SpriteBatch::Recorder::Clear()
+{
+    m_poFrames->clear();
+    m_poDraws->clear();
+    m_poInstances->clear();
+    m_uiUploads = 0;
+}
+
+//
+// SpriteBatch functions
+//
+
+// Constructor/destructor
+SpriteBatch::SpriteBatch()
+    : m_poInstances( new InstanceList ), m_poFrames( new FrameTable )
+{
+    Stats oStats = { 0, 0, 0 };
+    m_oLastFlush = oStats;
+}
+SpriteBatch::~SpriteBatch()
+{
+    delete m_poInstances;
+    delete m_poFrames;
+}
+
+// Add a sprite, with its transform taken from the current matrix stacks
+void SpriteBatch::Add( const Sprite& ac_roSprite )
+{
+    // Skip the sprites Sprite::Draw would skip
+    if( !ac_roSprite.IsVisible() || !ac_roSprite.HasTexture() ||
+        !ac_roSprite.CurrentFrame().HasDisplayArea() )
+    {
+        return;
+    }
+
+    // Drawable::Draw applies the model matrix before the model-view matrix,
+    // so the model-view-projection matrix is model * model-view * projection
+    Add( ac_roSprite.GetTexture(), ac_roSprite.FrameList(),
+         ac_roSprite.FrameNumber(),
+         GLTransform3D( ac_roSprite.GetModelMatrix() ) *
+         GameEngine::ModelViewProjection(),
+         ac_roSprite.GetColor() );
+}
+
+// Add a frame of a frame list with the given transform
+void SpriteBatch::Add( Texture& a_roTexture,
+                       const Frame::Array& ac_roFrameList,
+                       unsigned int a_uiFrameNumber,
+                       const GLTransform3D& ac_roModelViewProjection,
+                       const Color::ColorVector& ac_roColor )
+{
+    unsigned int uiFrameCount = ac_roFrameList.Size();
+    Instance oInstance;
+    CopyMatrix( ac_roModelViewProjection, oInstance.afModelViewProjection );
+    oInstance.oColor = Color::Pack( ac_roColor );
+    oInstance.uiFrame = FirstFrame( a_roTexture, ac_roFrameList ) +
+                        ( 0 == uiFrameCount ? 0
+                                            : a_uiFrameNumber % uiFrameCount );
+    m_poInstances->oInstances.push_back( oInstance );
+    m_poInstances->oTextures.push_back( &a_roTexture );
+}
+
+// Group the instances by texture and submit them
+void SpriteBatch::Flush( Backend& a_roBackend )
+{
+    PROFILE_ZONE( "SpriteBatch::Flush" );
+    InstanceList& roList = *m_poInstances;
+    unsigned int uiCount = roList.oInstances.size();
+    Stats oStats = { uiCount, 0, (unsigned int)m_poFrames->oFrames.size() };
+    if( 0 == uiCount )
+    {
+        m_oLastFlush = oStats;
+        Clear();
+        return;
+    }
+
+    // Number the textures in the order they're first seen, counting how many
+    // instances use each
+    roList.oGroups.resize( uiCount );
+    roList.oGroupTextures.clear();
+    roList.oGroupStarts.clear();
+    roList.oGroupNumbers.clear();
+    Texture* poLastTexture = nullptr;
+    unsigned int uiLastGroup = 0;
+    for( unsigned int ui = 0; ui < uiCount; ++ui )
+    {
+        Texture* poTexture = roList.oTextures[ui];
+        if( poTexture != poLastTexture )
+        {
+            std::pair< std::unordered_map< Texture*, unsigned int >::iterator,
+                       bool > oResult =
+                roList.oGroupNumbers.insert(
+                    std::make_pair( poTexture, roList.oGroupTextures.size() ) );
+            if( oResult.second )
+            {
+                roList.oGroupTextures.push_back( poTexture );
+                roList.oGroupStarts.push_back( 0 );
+            }
+            poLastTexture = poTexture;
+            uiLastGroup = oResult.first->second;
+        }
+        roList.oGroups[ui] = uiLastGroup;
+        ++roList.oGroupStarts[ uiLastGroup ];
+    }
+
+    // Turn the counts into where each group starts, then copy the instances
+    // into place, keeping their order within each group
+    unsigned int uiGroups = roList.oGroupTextures.size();
+    unsigned int uiStart = 0;
+    for( unsigned int ui = 0; ui < uiGroups; ++ui )
+    {
+        unsigned int uiSize = roList.oGroupStarts[ui];
+        roList.oGroupStarts[ui] = uiStart;
+        uiStart += uiSize;
+    }
+    const Instance* pcoInstances = &( roList.oInstances[0] );
+    if( 1 < uiGroups )
+    {
+        roList.oGrouped.resize( uiCount );
+        std::vector< unsigned int > oNext( roList.oGroupStarts );
+        for( unsigned int ui = 0; ui < uiCount; ++ui )
+        {
+            roList.oGrouped[ oNext[ roList.oGroups[ui] ]++ ] =
+                roList.oInstances[ui];
+        }
+        pcoInstances = &( roList.oGrouped[0] );
+    }
+
+    // Upload the frame table once, then draw each group in one call
+    a_roBackend.BeginSubmit();
+    a_roBackend.UploadFrames( &( m_poFrames->oFrames[0] ),
+                              m_poFrames->oFrames.size() );
+    for( unsigned int ui = 0; ui < uiGroups; ++ui )
+    {
+        unsigned int uiEnd = ( ui + 1 < uiGroups ? roList.oGroupStarts[ui + 1]
+                                                 : uiCount );
+        a_roBackend.DrawInstances( *roList.oGroupTextures[ui],
+                                   pcoInstances + roList.oGroupStarts[ui],
+                                   uiEnd - roList.oGroupStarts[ui] );
+        ++oStats.uiDraws;
+    }
+    a_roBackend.EndSubmit();
+
+    m_oLastFlush = oStats;
+    Clear();
+}
+
+// Drop everything added since Begin
+void SpriteBatch::Clear()
+{
+    m_poInstances->oInstances.clear();
+    m_poInstances->oTextures.clear();
+    m_poFrames->oFrames.clear();
+    m_poFrames->oFirstFrames.clear();
+    m_poFrames->pcoLastList = nullptr;
+    m_poFrames->poLastTexture = nullptr;
+}
+
+// Instances added since Begin
+unsigned int SpriteBatch::Size() const
+{
+    return m_poInstances->oInstances.size();
+}
+const SpriteBatch::Instance&
+    SpriteBatch::operator[]( unsigned int a_uiIndex ) const
+{
+    return m_poInstances->oInstances.at( a_uiIndex );
+}
+Texture& SpriteBatch::GetTexture( unsigned int a_uiIndex ) const
+{
+    return *( m_poInstances->oTextures.at( a_uiIndex ) );
+}
+
+// Frame table built from the sprites added since Begin
+unsigned int SpriteBatch::FrameCount() const
+{
+    return m_poFrames->oFrames.size();
+}
+const SpriteBatch::FrameDescriptor&
+    SpriteBatch::GetFrame( unsigned int a_uiIndex ) const
+{
+    return m_poFrames->oFrames.at( a_uiIndex );
+}
+
+// Index of the first of a frame list's descriptors for a given texture
+unsigned int SpriteBatch::FirstFrame( Texture& a_roTexture,
+                                      const Frame::Array& ac_roFrameList )
+{
+    FrameTable& roTable = *m_poFrames;
+    if( &ac_roFrameList == roTable.pcoLastList &&
+        &a_roTexture == roTable.poLastTexture )
+    {
+        return roTable.uiLastFirst;
+    }
+
+    FrameTable::Key oKey( &ac_roFrameList, &a_roTexture );
+    std::map< FrameTable::Key, unsigned int >::iterator oFound =
+        roTable.oFirstFrames.find( oKey );
+    unsigned int uiFirst = 0;
+    if( roTable.oFirstFrames.end() != oFound )
+    {
+        uiFirst = oFound->second;
+    }
+    else
+    {
+        // An empty frame list means the sprite shows the whole texture
+        uiFirst = roTable.oFrames.size();
+        unsigned int uiFrameCount = ac_roFrameList.Size();
+        if( 0 == uiFrameCount )
+        {
+            roTable.oFrames.push_back( Describe( a_roTexture.TextureFrame(),
+                                                 a_roTexture ) );
+        }
+        for( unsigned int ui = 0; ui < uiFrameCount; ++ui )
+        {
+            roTable.oFrames.push_back( Describe( ac_roFrameList[ui],
+                                                 a_roTexture ) );
+        }
+        roTable.oFirstFrames[ oKey ] = uiFirst;
+    }
+
+    roTable.pcoLastList = &ac_roFrameList;
+    roTable.poLastTexture = &a_roTexture;
+    roTable.uiLastFirst = uiFirst;
+    return uiFirst;
+}
+
+// Work out a frame's descriptor for a given texture
+SpriteBatch::FrameDescriptor
+    SpriteBatch::Describe( const Frame& ac_roFrame,
+                           const Texture& ac_roTexture )
+{
+    // The texture transform is affine, so its last column is always
+    // ( 0, 0, 1 ) and only the first two are needed
+    Transform2D oTransform;
+    ac_roFrame.DisplayAreaTextureTransform( oTransform );
+    Point2D oOffsetUV = ac_roFrame.SliceOffsetUV( ac_roTexture.Size() );
+    Point2D oSizeUV = ac_roFrame.SliceSizeUV( ac_roTexture.Size() );
+    FrameDescriptor oResult =
+    {
+        { (float)oTransform[0][0], (float)oTransform[1][0],
+          (float)oTransform[2][0],
+          GL_CLAMP_TO_EDGE == ac_roTexture.WrapS() ? 1.0f : 0.0f },
+        { (float)oTransform[0][1], (float)oTransform[1][1],
+          (float)oTransform[2][1],
+          GL_CLAMP_TO_EDGE == ac_roTexture.WrapT() ? 1.0f : 0.0f },
+        { (float)oOffsetUV.x, (float)oOffsetUV.y,
+          (float)oSizeUV.x, (float)oSizeUV.y }
+    };
+    return oResult;
+}
+
+// Backend that makes the real GL calls
+SpriteBatch::Backend& SpriteBatch::GLBackend()
+{
+    static GLSpriteBatchBackend soBackend;
+    return soBackend;
+}
+
+}   // namespace MyFirstEngine
@@ -3,22 +3,40 @@
  * Author:             Elizabeth Lowry
  * Date Created:       March 12, 2014
  * Description:        Implementation for SpriteShaderProgram functions.
- * Last Modified:      March 17, 2014
- * Last Modification:  Debugging.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Named the number of uniforms set per sprite.
  ******************************************************************************/
 
 #include "../Declarations/GameEngine.h"
+#include "../Declarations/Profiler.h"
 #include "../Declarations/QuadShaderProgram.h"
+#include "../Declarations/RenderQueue.h"
 #include "../Declarations/SpriteShaderProgram.h"
 
 namespace MyFirstEngine
 {
 
-// default sprite shader source code files
+// default sprite shader source code files and the names of the uniforms that
+// depend on the precision chosen in Precision.h
+#ifdef MY_FIRST_ENGINE_SINGLE_PRECISION
+const char* const SpriteShaderProgram::SPRITE_VERTEX_SHADER_FILE =
+                                     "resources/shaders/SpriteVertexFloat.glsl";
+const char* const SpriteShaderProgram::SPRITE_FRAGMENT_SHADER_FILE =
+                                   "resources/shaders/SpriteFragmentFloat.glsl";
+static const char* const sgc_pcModelViewProjection = "u_m4ModelViewProjection";
+static const char* const sgc_pcTexTransform = "u_m3TexTransform";
+static const char* const sgc_pcOffsetUV = "u_v2OffsetUV";
+static const char* const sgc_pcSizeUV = "u_v2SizeUV";
+#else
 const char* const SpriteShaderProgram::SPRITE_VERTEX_SHADER_FILE =
                                           "resources/shaders/SpriteVertex.glsl";
 const char* const SpriteShaderProgram::SPRITE_FRAGMENT_SHADER_FILE =
                                         "resources/shaders/SpriteFragment.glsl";
+static const char* const sgc_pcModelViewProjection = "u_dm4ModelViewProjection";
+static const char* const sgc_pcTexTransform = "u_dm3TexTransform";
+static const char* const sgc_pcOffsetUV = "u_dv2OffsetUV";
+static const char* const sgc_pcSizeUV = "u_dv2SizeUV";
+#endif
 
 // The texture coordinates of the four corners of a sprite with a frame showing
 // the entire texture within itself with no offsets
@@ -62,12 +80,12 @@ void SpriteShaderProgram::SetupData()
 {
     // Get uniform variable locations
     GLint iModelViewProjectionID =
-        glGetUniformLocation( m_uiID, "u_dm4ModelViewProjection" );
-    GLint iTexTransformID = glGetUniformLocation( m_uiID, "u_dm3TexTransform" );
+        glGetUniformLocation( m_uiID, sgc_pcModelViewProjection );
+    GLint iTexTransformID = glGetUniformLocation( m_uiID, sgc_pcTexTransform );
     GLint iColorID = glGetUniformLocation( m_uiID, "u_v4Color" );
     GLint iTextureID = glGetUniformLocation( m_uiID, "u_t2dTexture" );
-    GLint iOffsetUVID = glGetUniformLocation( m_uiID, "u_dv2OffsetUV" );
-    GLint iSizeUVID = glGetUniformLocation( m_uiID, "u_dv2SizeUV" );
+    GLint iOffsetUVID = glGetUniformLocation( m_uiID, sgc_pcOffsetUV );
+    GLint iSizeUVID = glGetUniformLocation( m_uiID, sgc_pcSizeUV );
     GLint iClampXID = glGetUniformLocation( m_uiID, "u_bClampX" );
     GLint iClampYID = glGetUniformLocation( m_uiID, "u_bClampY" );
 
@@ -143,33 +161,27 @@ void SpriteShaderProgram::DrawSprite( Texture& a_roTexture,
                                       const Transform2D& ac_roTexTransform,
                                       const Color::ColorVector& ac_roColor )
 {
-    // save current shader program and active texture
+    // If draws are being queued up, let the queue draw this one later
+    RenderQueue* poQueue = RenderQueue::Current();
+    if( nullptr != poQueue )
+    {
+        poQueue->AddSprite( a_roTexture, GameEngine::ModelViewProjection(),
+                            ac_roOffsetUV, ac_roSizeUV, ac_roTexTransform,
+                            ac_roColor );
+        return;
+    }
+
+    // save current shader program
     const ShaderProgram& oPrevious = ShaderProgram::Current();
-    GLint iActive;
-    glGetIntegerv( GL_ACTIVE_TEXTURE, &iActive );
 
     // start using shader program and texture
     Instance().Use();
     a_roTexture.MakeCurrent();
 
-    // OpenGL uses column vectors, while the MathLibrary transforms are made for
-    // use with row vectors.  However, OpenGL stores matrix data in column-major
-    // order, while the MathLibrary matrices store data in row-major order, so
-    // feeding data from the latter to the former is an automatic transposition.
-    glUniformMatrix4dv( Instance().m_iModelViewProjectionID, 1, false,
-                        &( GameEngine::ModelViewProjection()[0][0] ) );
-
-    // Set other uniforms
-    glUniformMatrix3dv( Instance().m_iTexTransformID, 1, false,
-                        &( ac_roTexTransform[0][0] ) );
-    glUniform4fv( Instance().m_iColorID, 1, &( ac_roColor[0] ) );
-    glUniform1i( Instance().m_iTextureID, 0 );
-    glUniform2dv( Instance().m_iOffsetUVID, 1, &( ac_roOffsetUV[0] ) );
-    glUniform2dv( Instance().m_iSizeUVID, 1, &( ac_roSizeUV[0] ) );
-    glUniform1i( Instance().m_iClampXID,
-                 GL_CLAMP_TO_EDGE == a_roTexture.WrapS() ? GL_TRUE : GL_FALSE );
-    glUniform1i( Instance().m_iClampYID,
-                 GL_CLAMP_TO_EDGE == a_roTexture.WrapT() ? GL_TRUE : GL_FALSE );
+    // Set uniforms in the chosen precision
+    SetUniforms( a_roTexture, GameEngine::ModelViewProjection(),
+                 GLVector2D( ac_roOffsetUV ), GLVector2D( ac_roSizeUV ),
+                 GLTransform2D( ac_roTexTransform ), ac_roColor );
 
     // Use Quad shader's function for drawing elements
     QuadShaderProgram::DrawElements();
@@ -178,4 +190,27 @@ void SpriteShaderProgram::DrawSprite( Texture& a_roTexture,
     oPrevious.Use();
 }
 
+// Set the uniforms for drawing a sprite, assuming this program is in use and
+// the texture is bound
+void SpriteShaderProgram::
+    SetUniforms( const Texture& ac_roTexture,
+                 const GLTransform3D& ac_roModelViewProjection,
+                 const GLVector2D& ac_roOffsetUV,
+                 const GLVector2D& ac_roSizeUV,
+                 const GLTransform2D& ac_roTexTransform,
+                 const Math::Vector< float, 4 >& ac_roColor )
+{
+    SetUniform( Instance().m_iModelViewProjectionID, ac_roModelViewProjection );
+    SetUniform( Instance().m_iTexTransformID, ac_roTexTransform );
+    glUniform4fv( Instance().m_iColorID, 1, &( ac_roColor[0] ) );
+    glUniform1i( Instance().m_iTextureID, 0 );
+    SetUniform( Instance().m_iOffsetUVID, ac_roOffsetUV );
+    SetUniform( Instance().m_iSizeUVID, ac_roSizeUV );
+    glUniform1i( Instance().m_iClampXID,
+                 GL_CLAMP_TO_EDGE == ac_roTexture.WrapS() ? GL_TRUE : GL_FALSE );
+    glUniform1i( Instance().m_iClampYID,
+                 GL_CLAMP_TO_EDGE == ac_roTexture.WrapT() ? GL_TRUE : GL_FALSE );
+    PROFILE_COUNT( UNIFORM_UPLOADS, UNIFORM_COUNT );
+}
+
 }   // MyFirstEngine
@@ -0,0 +1,456 @@
+/******************************************************************************
+ * File:               StreamBuffer.cpp
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Function implementations for the StreamBuffer class.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Added a check for the room left in a region.
+ ******************************************************************************/
+
+#include "../Declarations/GLFW.h"
+#include "../Declarations/Profiler.h"
+#include "../Declarations/StreamBuffer.h"
+#include "MathLibrary.h"
+#include <cstddef>  // for size_t
+#include <cstring>  // for memcpy
+
+//
+// File-only helper functions and classes
+//
+namespace
+{
+
+using MyFirstEngine::StreamBuffer;
+
+// Binds a buffer for the lifetime of the object, then puts back whatever was
+// bound before, so binding an element buffer doesn't change the vertex array
+// that's currently bound
+class ScopedBind
+{
+public:
+    ScopedBind( GLenum a_eTarget, GLuint a_uiBuffer )
+        : m_eTarget( a_eTarget ), m_iPrevious( 0 )
+    {
+        GLenum eBinding = ( GL_ELEMENT_ARRAY_BUFFER == a_eTarget
+                            ? GL_ELEMENT_ARRAY_BUFFER_BINDING
+                            : GL_ARRAY_BUFFER == a_eTarget
+                            ? GL_ARRAY_BUFFER_BINDING : GL_NONE );
+        if( GL_NONE != eBinding )
+        {
+            glGetIntegerv( eBinding, &m_iPrevious );
+        }
+        glBindBuffer( m_eTarget, a_uiBuffer );
+    }
+    ~ScopedBind()
+    {
+        glBindBuffer( m_eTarget, (GLuint)m_iPrevious );
+    }
+private:
+    GLenum m_eTarget;
+    GLint m_iPrevious;
+};
+
+// Backend that makes real GL calls
+class GLStreamBackend : public StreamBuffer::Backend
+{
+public:
+
+    virtual ~GLStreamBackend() {}
+
+    // Immutable storage is core in 4.4, and available as an extension before
+    virtual bool SupportsPersistentMapping() const override
+    {
+        return ( GL_FALSE != GLEW_VERSION_4_4 ||
+                 GL_FALSE != GLEW_ARB_buffer_storage );
+    }
+
+    virtual GLuint CreateBuffer( GLenum a_eTarget, unsigned int a_uiSize,
+                                 bool a_bPersistent,
+                                 void*& a_rpMapped ) override
+    {
+        GLuint uiBuffer = 0;
+        glGenBuffers( 1, &uiBuffer );
+        ScopedBind oBind( a_eTarget, uiBuffer );
+        a_rpMapped = nullptr;
+        if( a_bPersistent )
+        {
+            // Coherent, so writes show up without explicit flushes - the
+            // fences are what keep the CPU from writing too early
+            const GLbitfield cuiFlags = GL_MAP_WRITE_BIT |
+                                        GL_MAP_PERSISTENT_BIT |
+                                        GL_MAP_COHERENT_BIT;
+            glBufferStorage( a_eTarget, a_uiSize, nullptr, cuiFlags );
+            a_rpMapped = glMapBufferRange( a_eTarget, 0, a_uiSize, cuiFlags );
+        }
+        else
+        {
+            glBufferData( a_eTarget, a_uiSize, nullptr, GL_STREAM_DRAW );
+        }
+        return uiBuffer;
+    }
+
+    virtual void DestroyBuffer( GLenum a_eTarget, GLuint a_uiBuffer,
+                                bool a_bPersistent ) override
+    {
+        if( a_bPersistent )
+        {
+            ScopedBind oBind( a_eTarget, a_uiBuffer );
+            glUnmapBuffer( a_eTarget );
+        }
+        glDeleteBuffers( 1, &a_uiBuffer );
+    }
+
+    virtual void Orphan( GLenum a_eTarget, GLuint a_uiBuffer,
+                         unsigned int a_uiSize ) override
+    {
+        ScopedBind oBind( a_eTarget, a_uiBuffer );
+        glBufferData( a_eTarget, a_uiSize, nullptr, GL_STREAM_DRAW );
+    }
+
+    virtual void Upload( GLenum a_eTarget, GLuint a_uiBuffer,
+                         unsigned int a_uiOffset, unsigned int a_uiSize,
+                         const void* ac_pData ) override
+    {
+        ScopedBind oBind( a_eTarget, a_uiBuffer );
+        glBufferSubData( a_eTarget, a_uiOffset, a_uiSize, ac_pData );
+    }
+
+    virtual StreamBuffer::Fence InsertFence() override
+    {
+        GLsync pSync = glFenceSync( GL_SYNC_GPU_COMMANDS_COMPLETE, 0 );
+        return (StreamBuffer::Fence)(std::size_t)pSync;
+    }
+
+    virtual bool IsSignaled( StreamBuffer::Fence a_ulFence ) override
+    {
+        GLenum eResult = glClientWaitSync( ToSync( a_ulFence ), 0, 0 );
+        return ( GL_ALREADY_SIGNALED == eResult ||
+                 GL_CONDITION_SATISFIED == eResult );
+    }
+
+    // Flush on the first try, in case the fence hasn't even been sent to the
+    // GPU yet, then keep waiting a second at a time
+    virtual void WaitFor( StreamBuffer::Fence a_ulFence ) override
+    {
+        GLsync pSync = ToSync( a_ulFence );
+        GLbitfield uiFlags = GL_SYNC_FLUSH_COMMANDS_BIT;
+        while( GL_TIMEOUT_EXPIRED ==
+               glClientWaitSync( pSync, uiFlags, 1000000000ULL ) )
+        {
+            uiFlags = 0;
+        }
+    }
+
+    virtual void DeleteFence( StreamBuffer::Fence a_ulFence ) override
+    {
+        glDeleteSync( ToSync( a_ulFence ) );
+    }
+
+private:
+
+    static GLsync ToSync( StreamBuffer::Fence a_ulFence )
+    {
+        return (GLsync)(std::size_t)a_ulFence;
+    }
+
+};  // class GLStreamBackend
+
+}   // namespace
+
+namespace MyFirstEngine
+{
+
+//
+// SimulatedBackend functions
+//
+
+StreamBuffer::SimulatedBackend::SimulatedBackend( bool a_bPersistent )
+    : m_bPersistent( a_bPersistent ), m_paucData( nullptr ),
+      m_ulInserted( 0 ), m_ulPassed( 0 ), m_uiWaits( 0 ), m_uiOrphans( 0 ),
+      m_uiUploads( 0 ), m_uiUploadedBytes( 0 ) {}
+StreamBuffer::SimulatedBackend::~SimulatedBackend()
+{
+    delete[] m_paucData;
+}
+
+// Buffers are plain memory.  Only one buffer at a time is simulated.
+GLuint StreamBuffer::SimulatedBackend::CreateBuffer( GLenum a_eTarget,
+                                                     unsigned int a_uiSize,
+                                                     bool a_bPersistent,
+                                                     void*& a_rpMapped )
+{
+    delete[] m_paucData;
+    m_paucData = new unsigned char[ a_uiSize ];
+    std::memset( m_paucData, 0, a_uiSize );
+    a_rpMapped = ( a_bPersistent ? m_paucData : nullptr );
+    return 1;
+}
+void StreamBuffer::SimulatedBackend::DestroyBuffer( GLenum a_eTarget,
+                                                    GLuint a_uiBuffer,
+                                                    bool a_bPersistent )
+{
+    delete[] m_paucData;
+    m_paucData = nullptr;
+}
+void StreamBuffer::SimulatedBackend::Orphan( GLenum a_eTarget,
+                                             GLuint a_uiBuffer,
+                                             unsigned int a_uiSize )
+{
+    ++m_uiOrphans;
+}
+void StreamBuffer::SimulatedBackend::Upload( GLenum a_eTarget,
+                                             GLuint a_uiBuffer,
+                                             unsigned int a_uiOffset,
+                                             unsigned int a_uiSize,
+                                             const void* ac_pData )
+{
+    if( nullptr != m_paucData )
+    {
+        std::memcpy( m_paucData + a_uiOffset, ac_pData, a_uiSize );
+    }
+    ++m_uiUploads;
+    m_uiUploadedBytes += a_uiSize;
+}
+
+// Fences are numbered in the order they're inserted, and the GPU passes them
+// in the same order
+StreamBuffer::Fence StreamBuffer::SimulatedBackend::InsertFence()
+{
+    return ++m_ulInserted;
+}
+bool StreamBuffer::SimulatedBackend::IsSignaled( Fence a_ulFence )
+{
+    return ( a_ulFence <= m_ulPassed );
+}
+void StreamBuffer::SimulatedBackend::WaitFor( Fence a_ulFence )
+{
+    ++m_uiWaits;
+    if( a_ulFence > m_ulPassed )
+    {
+        m_ulPassed = a_ulFence;
+    }
+}
+void StreamBuffer::SimulatedBackend::Advance( unsigned int a_uiFences )
+{
+    m_ulPassed = ( m_ulInserted - m_ulPassed > a_uiFences
+                   ? m_ulPassed + a_uiFences : m_ulInserted );
+}
+
+//
+// Instance functions
+//
+
+// Constructor - the buffer itself is created when the first frame begins
+StreamBuffer::StreamBuffer( unsigned int a_uiRegionSize, GLenum a_eTarget,
+                            unsigned int a_uiRegions, Backend& a_roBackend )
+    : m_poBackend( &a_roBackend ), m_eTarget( a_eTarget ), m_uiID( 0 ),
+      m_bPersistent( false ), m_uiRegionSize( a_uiRegionSize ),
+      m_uiRegions( 0 == a_uiRegions ? 1 : a_uiRegions ), m_uiRegion( 0 ),
+      m_uiUsed( 0 ), m_uiSubmitted( 0 ), m_bInFrame( false ),
+      m_paucMapped( nullptr ), m_paucStaging( nullptr ),
+      m_paulFences( nullptr )
+{
+    m_paulFences = new Fence[ m_uiRegions ];
+    for( unsigned int ui = 0; ui < m_uiRegions; ++ui )
+    {
+        m_paulFences[ ui ] = 0;
+    }
+    ResetStats();
+}
+StreamBuffer::~StreamBuffer()
+{
+    Destroy();
+    delete[] m_paulFences;
+}
+
+// Create the buffer on first use
+void StreamBuffer::Create()
+{
+    // Persistent buffers hold every region.  Orphaned buffers only need one,
+    // since the driver hands out fresh storage each frame.
+    m_bPersistent = m_poBackend->SupportsPersistentMapping();
+    void* pMapped = nullptr;
+    m_uiID = m_poBackend->CreateBuffer( m_eTarget,
+                                        m_bPersistent
+                                        ? m_uiRegionSize * m_uiRegions
+                                        : m_uiRegionSize,
+                                        m_bPersistent, pMapped );
+
+    // If mapping failed, fall back on orphaning
+    if( m_bPersistent && nullptr == pMapped )
+    {
+        m_poBackend->DestroyBuffer( m_eTarget, m_uiID, true );
+        m_bPersistent = false;
+        m_uiID = m_poBackend->CreateBuffer( m_eTarget, m_uiRegionSize,
+                                            false, pMapped );
+    }
+    m_paucMapped = (unsigned char*)pMapped;
+    if( !m_bPersistent && nullptr == m_paucStaging )
+    {
+        m_paucStaging = new unsigned char[ m_uiRegionSize ];
+    }
+    m_uiRegion = m_uiRegions - 1;   // so the first frame uses region 0
+}
+
+// Start writing to the next region
+void StreamBuffer::BeginFrame()
+{
+    if( m_bInFrame )
+    {
+        EndFrame();
+    }
+    if( 0 == m_uiID )
+    {
+        Create();
+    }
+
+    if( m_bPersistent )
+    {
+        // Wait for the GPU to finish reading the region's last contents
+        m_uiRegion = ( m_uiRegion + 1 ) % m_uiRegions;
+        Fence ulFence = m_paulFences[ m_uiRegion ];
+        if( 0 != ulFence )
+        {
+            if( !m_poBackend->IsSignaled( ulFence ) )
+            {
+                PROFILE_ZONE( "StreamBuffer stall" );
+                PROFILE_COUNT( BUFFER_STALLS, 1 );
+                double dStart = Profiler::Now();
+                m_poBackend->WaitFor( ulFence );
+                m_oStats.dStallTime += Profiler::Now() - dStart;
+                ++m_oStats.uiStalls;
+            }
+            m_poBackend->DeleteFence( ulFence );
+            m_paulFences[ m_uiRegion ] = 0;
+        }
+    }
+    else
+    {
+        // The GPU keeps the old storage for as long as it needs it
+        m_uiRegion = 0;
+        m_poBackend->Orphan( m_eTarget, m_uiID, m_uiRegionSize );
+    }
+
+    m_uiUsed = 0;
+    m_uiSubmitted = 0;
+    m_bInFrame = true;
+    ++m_oStats.uiFrames;
+}
+
+// Get space in the current region
+StreamBuffer::Allocation StreamBuffer::Allocate( unsigned int a_uiSize,
+                                                 unsigned int a_uiAlignment )
+{
+    if( !m_bInFrame )
+    {
+        BeginFrame();
+    }
+
+    unsigned int uiStart = AlignedStart( a_uiAlignment );
+    if( uiStart > m_uiRegionSize || a_uiSize > m_uiRegionSize - uiStart )
+    {
+        ++m_oStats.uiFailedAllocations;
+        Allocation oFailed = { nullptr, 0 };
+        return oFailed;
+    }
+    m_uiUsed = uiStart + a_uiSize;
+
+    unsigned int uiOffset = m_uiRegion * m_uiRegionSize + uiStart;
+    Allocation oAllocation =
+        { ( m_bPersistent ? m_paucMapped + uiOffset : m_paucStaging + uiStart ),
+          uiOffset };
+    return oAllocation;
+}
+
+// Largest allocation that would still fit in the current region
+unsigned int StreamBuffer::Available( unsigned int a_uiAlignment ) const
+{
+    unsigned int uiStart = AlignedStart( a_uiAlignment );
+    return ( uiStart < m_uiRegionSize ? m_uiRegionSize - uiStart : 0 );
+}
+
+// Where in the current region the next allocation with the given alignment
+// would start.  The offset is aligned in the whole buffer, not just in the
+// region, since regions after the first needn't start on an aligned offset.
+unsigned int StreamBuffer::AlignedStart( unsigned int a_uiAlignment ) const
+{
+    unsigned int uiMask = ( 0 == a_uiAlignment ? 0 : a_uiAlignment - 1 );
+    unsigned int uiBase = m_uiRegion * m_uiRegionSize;
+    return ( ( uiBase + m_uiUsed + uiMask ) & ~uiMask ) - uiBase;
+}
+
+// Make everything allocated since the last Submit visible to the GPU
+void StreamBuffer::Submit()
+{
+    if( !m_bPersistent && m_uiUsed > m_uiSubmitted )
+    {
+        m_poBackend->Upload( m_eTarget, m_uiID, m_uiSubmitted,
+                             m_uiUsed - m_uiSubmitted,
+                             m_paucStaging + m_uiSubmitted );
+    }
+    m_uiSubmitted = m_uiUsed;
+}
+
+// Submit, and fence off the current region
+void StreamBuffer::EndFrame()
+{
+    if( !m_bInFrame )
+    {
+        return;
+    }
+    Submit();
+    if( m_bPersistent )
+    {
+        m_paulFences[ m_uiRegion ] = m_poBackend->InsertFence();
+    }
+    m_oStats.uiLastFrameBytes = m_uiUsed;
+    if( m_uiUsed > m_oStats.uiPeakFrameBytes )
+    {
+        m_oStats.uiPeakFrameBytes = m_uiUsed;
+    }
+    m_bInFrame = false;
+}
+
+// Delete the buffer and its fences
+void StreamBuffer::Destroy()
+{
+    for( unsigned int ui = 0; ui < m_uiRegions; ++ui )
+    {
+        if( 0 != m_paulFences[ ui ] )
+        {
+            m_poBackend->DeleteFence( m_paulFences[ ui ] );
+            m_paulFences[ ui ] = 0;
+        }
+    }
+    if( 0 != m_uiID )
+    {
+        m_poBackend->DestroyBuffer( m_eTarget, m_uiID, m_bPersistent );
+        m_uiID = 0;
+    }
+    delete[] m_paucStaging;
+    m_paucStaging = nullptr;
+    m_paucMapped = nullptr;
+    m_uiUsed = 0;
+    m_uiSubmitted = 0;
+    m_bInFrame = false;
+}
+
+// Start counting from zero again
+void StreamBuffer::ResetStats()
+{
+    Stats oStats = { 0, 0, 0.0, 0, 0, 0 };
+    m_oStats = oStats;
+}
+
+//
+// Static functions
+//
+
+// Backend that makes the real GL calls
+StreamBuffer::Backend& StreamBuffer::GLBackend()
+{
+    static GLStreamBackend soBackend;
+    return soBackend;
+}
+
+}   // namespace MyFirstEngine
@@ -3,11 +3,13 @@
  * Author:             Elizabeth Lowry
  * Date Created:       March 6, 2014
  * Description:        Class representing an texture.
- * Last Modified:      March 17, 2014
- * Last Modification:  Debugging.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Added pinning for texture residency budgets.
  ******************************************************************************/
 
+#include "../Declarations/Profiler.h"
 #include "../Declarations/Texture.h"
+#include "../Declarations/TextureResidency.h"
 #include "MathLibrary.h"
 #include "SOIL.h"
 #include <unordered_map>
@@ -50,6 +52,23 @@ private:
 static TextureLookup& Lookup() { return TextureLookup::Instance(); }
 static TextureList& List() { return TextureList::Instance(); }
 
+// Check whether all the pixels in RGBA data have full alpha
+static bool AllOpaque( const unsigned char* ac_paucData, int a_iPixels )
+{
+    if( nullptr == ac_paucData )
+    {
+        return false;
+    }
+    for( int i = 0; i < a_iPixels; ++i )
+    {
+        if( 0xFF != ac_paucData[ i * 4 + 3 ] )
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
 }   // namespace
 
 //
@@ -67,7 +86,8 @@ Texture::Texture( const char* const ac_cpcFile,
     : m_oSize( 0, 0 ), m_eWrapS( a_eWrapS ), m_eWrapT( a_eWrapT ),
       m_eMinFilter( a_eMinFilter ), m_eMagFilter( a_eMagFilter ),
       m_oBorderColor( ac_roBorderColor ), m_oFile( ac_cpcFile ), 
-      m_paucData( nullptr ), m_uiID( 0 ), m_oFrame()
+      m_paucData( nullptr ), m_uiID( 0 ), m_oFrame(), m_bOpaque( false ),
+      m_bPinned( false )
 {
     Lookup()[ this ] = List().size();
     List().push_back( this );
@@ -83,6 +103,7 @@ Texture::~Texture()
     m_paucData = nullptr;
     if( nullptr != paucData )
     {
+        TextureResidency::Uncached( *this );
         delete[] paucData;
     }
 }
@@ -93,6 +114,13 @@ bool Texture::IsValid() const
     return ( GL_TRUE == glIsTexture( m_uiID ) );
 }
 
+// Do the filters need mipmaps generated?
+bool Texture::UsesMipmaps() const
+{
+    return ( ( m_eMinFilter != GL_LINEAR && m_eMinFilter != GL_NEAREST ) ||
+             ( m_eMagFilter != GL_NEAREST && m_eMagFilter != GL_LINEAR ) );
+}
+
 // Unload and delete this texture
 void Texture::Destroy( bool a_bCache )
 {
@@ -110,17 +138,21 @@ void Texture::Destroy( bool a_bCache )
         m_paucData = new unsigned char [ m_oSize.x * m_oSize.y * 4 ];
         glGetTexImage( GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, m_paucData );
         glBindTexture( GL_TEXTURE_2D, 0 );
+        TextureResidency::Cached( *this );
     }
 
     // Destroy the texture object
     glDeleteTextures( 1, &m_uiID );
     m_uiID = 0;
+    TextureResidency::Unloaded( *this );
 }
 
 // Load this texture to an unused texture unit (if not already loaded),
 // unloading other textures if neccessary.
 void Texture::Load( bool a_bCache )
 {
+    PROFILE_ZONE( "Texture::Load" );
+
     // If the image is already loaded, nothing needs to be done
     if( IsValid() )
     {
@@ -142,6 +174,8 @@ void Texture::Load( bool a_bCache )
     {
         glTexImage2D( GL_TEXTURE_2D, 0, GL_RGBA, m_oSize.x, m_oSize.y,
                       0, GL_RGBA, GL_UNSIGNED_BYTE, m_paucData );
+        m_bOpaque = AllOpaque( m_paucData, m_oSize.x * m_oSize.y );
+        TextureResidency::Cached( *this );
     }
     else
     {
@@ -152,12 +186,14 @@ void Texture::Load( bool a_bCache )
                       0, GL_RGBA, GL_UNSIGNED_BYTE, paucData );
         m_oFrame.framePixels = m_oSize;
         m_oFrame.slicePixels = m_oSize;
+        m_bOpaque = AllOpaque( paucData, m_oSize.x * m_oSize.y );
 
         // if caching is required, copy to cache
         if( a_bCache )
         {
             m_paucData = new unsigned char[ m_oSize.x * m_oSize.y * 4 ];
             memcpy( m_paucData, paucData, m_oSize.x * m_oSize.y * 4 );
+            TextureResidency::Cached( *this );
         }
 
         // Free data loaded with SOIL
@@ -165,8 +201,7 @@ void Texture::Load( bool a_bCache )
     }
 
     // generate mipmaps if neccessary
-    if( ( m_eMinFilter != GL_LINEAR && m_eMinFilter != GL_NEAREST ) ||
-        ( m_eMagFilter != GL_NEAREST && m_eMagFilter != GL_LINEAR ) )
+    if( UsesMipmaps() )
     {
         glGenerateMipmap(GL_TEXTURE_2D);
     }
@@ -178,15 +213,32 @@ void Texture::Load( bool a_bCache )
     glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, m_eWrapT );
     glTexParameterfv(GL_TEXTURE_2D, GL_TEXTURE_BORDER_COLOR, &(m_oBorderColor[0]) );
 
-    // finished loading
+    // finished loading, so make room for it if over budget
     glBindTexture( GL_TEXTURE_2D, 0 );
+    TextureResidency::Loaded( *this );
 }
 
 // Make this texture's unit active (load if needed)
 void Texture::MakeCurrent()
 {
-    Load();
+    if( IsValid() )
+    {
+        TextureResidency::Used( *this );
+    }
+    else
+    {
+        Load();
+    }
     glBindTexture( GL_TEXTURE_2D, m_uiID );
+    PROFILE_COUNT( TEXTURE_BINDS, 1 );
+}
+
+// Pin or unpin this texture.  Unpinning may unload other textures, if the
+// budget was only being kept by ignoring this one.
+void Texture::Pin( bool a_bPinned )
+{
+    m_bPinned = a_bPinned;
+    TextureResidency::Pinned( *this );
 }
 
 //
@@ -0,0 +1,194 @@
+/******************************************************************************
+ * File:               TextureResidency.cpp
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Implementations for TextureResidency functions.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Residency lists outlive every texture, and evicting keeps
+ *                      the caller's texture binding.
+ ******************************************************************************/
+
+#include "../Declarations/Texture.h"
+#include "../Declarations/TextureResidency.h"
+#include "MathLibrary.h"
+
+//
+// File-only helper types, variables, and functions
+//
+namespace
+{
+
+using MyFirstEngine::Texture;
+typedef Utility::ResidencyList< Texture* > TextureResidencyList;
+
+// Textures with GL objects, and textures with CPU-side caches.  Created on
+// first use so textures constructed before main can still report in, and never
+// deleted so textures destroyed after main can too.
+static TextureResidencyList& GPU()
+{
+    static TextureResidencyList* s_poList = new TextureResidencyList;
+    return *s_poList;
+}
+static TextureResidencyList& Cache()
+{
+    static TextureResidencyList* s_poList = new TextureResidencyList;
+    return *s_poList;
+}
+
+}   // namespace
+
+namespace MyFirstEngine
+{
+
+//
+// Public functions
+//
+
+// Budgets
+void TextureResidency::SetGPUBudget( unsigned long long a_ulBytes )
+{
+    GPU().SetBudget( a_ulBytes );
+    EvictFromGPU();
+}
+void TextureResidency::SetCacheBudget( unsigned long long a_ulBytes )
+{
+    Cache().SetBudget( a_ulBytes );
+    EvictFromCache();
+}
+unsigned long long TextureResidency::GPUBudget()
+{
+    return GPU().Budget();
+}
+unsigned long long TextureResidency::CacheBudget()
+{
+    return Cache().Budget();
+}
+
+// Current totals
+unsigned long long TextureResidency::GPUBytes()
+{
+    return GPU().Bytes();
+}
+unsigned long long TextureResidency::CacheBytes()
+{
+    return Cache().Bytes();
+}
+
+// Hits, misses, and evictions
+const TextureResidency::Stats& TextureResidency::GPUStats()
+{
+    return GPU().Statistics();
+}
+const TextureResidency::Stats& TextureResidency::CacheStats()
+{
+    return Cache().Statistics();
+}
+void TextureResidency::ResetStats()
+{
+    GPU().ResetStatistics();
+    Cache().ResetStatistics();
+}
+
+// Sizes of a single texture, four bytes a pixel
+unsigned long long TextureResidency::GPUBytes( const Texture& ac_roTexture )
+{
+    unsigned long long ulBytes = CacheBytes( ac_roTexture );
+    return ( ac_roTexture.UsesMipmaps() ? ulBytes + ulBytes / 3 : ulBytes );
+}
+unsigned long long TextureResidency::CacheBytes( const Texture& ac_roTexture )
+{
+    return (unsigned long long)ac_roTexture.Size().x *
+           (unsigned long long)ac_roTexture.Size().y * 4;
+}
+
+//
+// Private functions
+//
+
+// A loaded texture was made current
+void TextureResidency::Used( Texture& a_roTexture )
+{
+    GPU().Use( &a_roTexture, GPUBytes( a_roTexture ) );
+}
+
+// A texture was given a GL object, so make room for it
+void TextureResidency::Loaded( Texture& a_roTexture )
+{
+    GPU().Use( &a_roTexture, GPUBytes( a_roTexture ) );
+    GPU().Pin( &a_roTexture, a_roTexture.IsPinned() );
+    EvictFromGPU();
+}
+
+// A texture's GL object was destroyed
+void TextureResidency::Unloaded( Texture& a_roTexture )
+{
+    GPU().Remove( &a_roTexture );
+}
+
+// A texture's cache was created or loaded from.  Textures with no file to
+// reload from have no choice but to keep their caches.
+void TextureResidency::Cached( Texture& a_roTexture )
+{
+    Cache().Use( &a_roTexture, CacheBytes( a_roTexture ) );
+    Cache().Pin( &a_roTexture, a_roTexture.IsPinned() ||
+                               a_roTexture.FileName().IsEmpty() );
+    EvictFromCache();
+}
+
+// A texture's cache was deleted
+void TextureResidency::Uncached( Texture& a_roTexture )
+{
+    Cache().Remove( &a_roTexture );
+}
+
+// A texture was pinned or unpinned
+void TextureResidency::Pinned( Texture& a_roTexture )
+{
+    GPU().Pin( &a_roTexture, a_roTexture.IsPinned() );
+    Cache().Pin( &a_roTexture, a_roTexture.IsPinned() ||
+                               a_roTexture.FileName().IsEmpty() );
+    EvictFromGPU();
+    EvictFromCache();
+}
+
+// Destroy the least recently used GL objects until within budget.  Destroying
+// a texture may cache it, which is counted against the cache budget.  Caching
+// binds the texture to unit zero, so whatever the caller had bound there and
+// whichever unit was active are put back afterwards.
+void TextureResidency::EvictFromGPU()
+{
+    if( !GPU().IsOverBudget() )
+    {
+        return;
+    }
+    GLint iActiveUnit = GL_TEXTURE0;
+    GLint iBound = 0;
+    glGetIntegerv( GL_ACTIVE_TEXTURE, &iActiveUnit );
+    glActiveTexture( GL_TEXTURE0 );
+    glGetIntegerv( GL_TEXTURE_BINDING_2D, &iBound );
+
+    Texture* poTexture = nullptr;
+    while( GPU().NextEviction( poTexture ) )
+    {
+        poTexture->Destroy();
+    }
+
+    // Binding a deleted name would create a new texture, so only rebind the
+    // caller's texture if it wasn't one of the ones evicted
+    glBindTexture( GL_TEXTURE_2D,
+                   GL_TRUE == glIsTexture( (GLuint)iBound ) ? iBound : 0 );
+    glActiveTexture( (GLenum)iActiveUnit );
+}
+
+// Delete the least recently used caches until within budget
+void TextureResidency::EvictFromCache()
+{
+    Texture* poTexture = nullptr;
+    while( Cache().NextEviction( poTexture ) )
+    {
+        delete[] poTexture->m_paucData;
+        poTexture->m_paucData = nullptr;
+    }
+}
+
+}   // namespace MyFirstEngine
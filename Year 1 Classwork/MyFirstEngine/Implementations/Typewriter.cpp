@@ -3,10 +3,11 @@
  * Author:             Elizabeth Lowry
  * Date Created:       March 22, 2014
  * Description:        Implementations for Typewriter class functions.
- * Last Modified:      March 22, 2014
- * Last Modification:  Creation.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Adding profiler instrumentation.
  ******************************************************************************/
 
+#include "../Declarations/Profiler.h"
 #include "../Declarations/Typewriter.h"
 #include "MathLibrary.h"
 
@@ -70,6 +71,8 @@ void Typewriter::DrawSymbol( const char* ac_pcCharacterName )
 // Type text or a special character
 void Typewriter::Type( const char* ac_pcText )
 {
+    PROFILE_ZONE( "Typewriter::Type" );
+
     // do nothing if there is no text or font
     if( nullptr == ac_pcText || nullptr == Instance().m_pcoFont )
     {
@@ -3,8 +3,8 @@
  * Author:             Elizabeth Lowry
  * Date Created:       February 4, 2014
  * Description:        All-inclusive header file for the MyFirstEngine library.
- * Last Modified:      February 25, 2014
- * Last Modification:  Adding includes for recently-implemented classes.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Added texture residency budgets.
  ******************************************************************************/
 
 #ifndef MY_FIRST_ENGINE__H
@@ -16,8 +16,10 @@
 #endif
 
 #include "..\Declarations\AnimatedSprite.h"
+#include "..\Declarations\Animator.h"
 #include "..\Declarations\Camera.h"
 #include "..\Declarations\CharacterMap.h"
+#include "..\Declarations\Culling.h"
 #include "..\Declarations\Drawable.h"
 #include "..\Declarations\Font.h"
 #include "..\Declarations\Frame.h"
@@ -25,15 +27,25 @@
 #include "..\Declarations\GameState.h"
 #include "..\Declarations\GameWindow.h"
 #include "..\Declarations\HTMLCharacters.h"
+#include "..\Declarations\Input.h"
+#include "..\Declarations\InstancedSpriteShaderProgram.h"
 #include "..\Declarations\Keyboard.h"
 #include "..\Declarations\Mouse.h"
+#include "..\Declarations\NullBackend.h"
+#include "..\Declarations\Precision.h"
+#include "..\Declarations\Profiler.h"
+#include "..\Declarations\ProgramBinaryCache.h"
 #include "..\Declarations\Quad.h"
 #include "..\Declarations\QuadShaderProgram.h"
+#include "..\Declarations\RenderQueue.h"
 #include "..\Declarations\Shader.h"
 #include "..\Declarations\ShaderProgram.h"
 #include "..\Declarations\Sprite.h"
+#include "..\Declarations\SpriteBatch.h"
 #include "..\Declarations\SpriteShaderProgram.h"
+#include "..\Declarations\StreamBuffer.h"
 #include "..\Declarations\Texture.h"
+#include "..\Declarations\TextureResidency.h"
 #include "..\Declarations\Typewriter.h"
 
 #endif  // MY_FIRST_ENGINE__H
@@ -0,0 +1,48 @@
+/******************************************************************************
+ * File:               InstancedSpriteFragment.glsl
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Fragment shader for a batch of instanced Sprites.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Creation.
+ ******************************************************************************/
+
+#version 410
+
+uniform sampler2D u_t2dTexture;
+
+in vec2 v_v2TexCoordinate;
+flat in vec4 v_v4SliceUV;
+flat in vec2 v_v2Clamp;
+flat in vec4 v_v4Color;
+
+float ScaleUV( in float a_fValue, in float a_fOffset,
+               in float a_fSize, in bool a_bClamp )
+{
+    if( a_bClamp )
+    {
+        if( a_fValue < 0.0 )
+        {
+            return a_fOffset;
+        }
+        if( a_fValue > 1.0 )
+        {
+            return a_fOffset + a_fSize;
+        }
+        return a_fOffset + ( a_fValue * a_fSize );
+    }
+
+    int iSteps = int( a_fValue );
+    float fPosition = a_fValue - float( iSteps );
+    return float( iSteps ) + a_fOffset + ( a_fSize * fPosition );
+}
+
+void main()
+{
+    vec2 v2TexCoordinateUV =
+        vec2( ScaleUV( v_v2TexCoordinate.x, v_v4SliceUV.x,
+                       v_v4SliceUV.z, v_v2Clamp.x > 0.5 ),
+              ScaleUV( v_v2TexCoordinate.y, v_v4SliceUV.y,
+                       v_v4SliceUV.w, v_v2Clamp.y > 0.5 ) );
+    gl_FragColor = texture( u_t2dTexture, v2TexCoordinateUV ) * v_v4Color;
+}
@@ -0,0 +1,39 @@
+/******************************************************************************
+ * File:               InstancedSpriteVertex.glsl
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Vertex shader for a batch of instanced Sprites.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Creation.
+ ******************************************************************************/
+
+#version 410
+
+// three vec4s per frame: texture transform s row, t row, then slice UVs
+uniform samplerBuffer u_tbFrames;
+
+in vec2 i_v2Position;
+in vec2 i_v2TexCoordinate;
+in mat4 i_m4ModelViewProjection;
+in vec4 i_v4Color;
+in uint i_uiFrame;
+
+out vec2 v_v2TexCoordinate;
+flat out vec4 v_v4SliceUV;
+flat out vec2 v_v2Clamp;
+flat out vec4 v_v4Color;
+
+void main()
+{
+    int iFrame = int( i_uiFrame ) * 3;
+    vec4 v4RowS = texelFetch( u_tbFrames, iFrame );
+    vec4 v4RowT = texelFetch( u_tbFrames, iFrame + 1 );
+    vec3 v3TexCoordinate = vec3( i_v2TexCoordinate, 1.0 );
+
+    gl_Position = i_m4ModelViewProjection * vec4( i_v2Position, 0.0, 1.0 );
+    v_v2TexCoordinate = vec2( dot( v4RowS.xyz, v3TexCoordinate ),
+                              dot( v4RowT.xyz, v3TexCoordinate ) );
+    v_v4SliceUV = texelFetch( u_tbFrames, iFrame + 2 );
+    v_v2Clamp = vec2( v4RowS.w, v4RowT.w );
+    v_v4Color = i_v4Color;
+}
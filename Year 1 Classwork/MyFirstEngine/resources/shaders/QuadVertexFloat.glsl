@@ -0,0 +1,19 @@
+/******************************************************************************
+ * File:               QuadVertexFloat.glsl
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Single-precision vertex shader for a solid Quad.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Creation.
+ ******************************************************************************/
+
+#version 410
+
+uniform mat4 u_m4ModelViewProjection;
+
+in vec2 i_v2Position;
+
+void main()
+{
+    gl_Position = u_m4ModelViewProjection * vec4( i_v2Position, 0.0, 1.0 );
+}
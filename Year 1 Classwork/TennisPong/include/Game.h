@@ -4,8 +4,8 @@
  * Date Created:       September 17, 2013
  * Description:        Definitions for the class that handles the game as a
  *						 whole.
- * Last Modified:      September 24, 2013
- * Last Modification:  Added menu.
+ * Last Modified:      October 1, 2013
+ * Last Modification:  Cached score and time text.
  ******************************************************************************/
 
 #ifndef _GAME_H_
@@ -18,6 +18,7 @@
 #include "Player.h"
 #include "Sprite.h"
 #include "StopWatch.h"
+#include "TextCache.h"
 
 // Handles the game as a whole.
 class Game
@@ -99,6 +100,11 @@ private:
     Menu m_oMenu;
 	StopWatch m_oPlayTime;	// How long has the current match been in progress?
 
+	// Score and time lines, only re-formatted when the values they show change
+	TextCache m_oLeftScoreText;
+	TextCache m_oRightScoreText;
+	TextCache m_oTimeText;
+
 	ScoreListType m_eDisplayScoreListType;	// Which high score list to display?
 	Speed m_eGameSpeed;
 	HumanPlayers m_eHumanPlayers;
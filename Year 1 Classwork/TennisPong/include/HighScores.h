@@ -3,8 +3,8 @@
  * Author:             Elizabeth Lowry
  * Date Created:       September 23, 2013
  * Description:        Definitions for the class that handles high score lists.
- * Last Modified:      September 24, 2013
- * Last Modification:  Debugging.
+ * Last Modified:      October 1, 2013
+ * Last Modification:  Cached score list text.
  ******************************************************************************/
 
 #ifndef _HIGH_SCORES_H_
@@ -14,6 +14,7 @@
 #include "MatchScore.h"
 #include "Player.h"
 #include "StopWatch.h"
+#include "TextCache.h"
 #include <list>
 
 // Manages the game's high score lists
@@ -41,7 +42,8 @@ private:
 
 	static const XYPair LIST_POSITION;
 	static const unsigned int SCORE_LIST_SIZE = 5;
-	static const char* const SCORE_PREFIX;	// "#%d:   "
+	static const char* const PLACE_PREFIX;	// "#"
+	static const char* const PLACE_SUFFIX;	// ":   "
 
 	const Player& m_roLeftPlayer;
 	const Player& m_roRightPlayer;
@@ -52,6 +54,14 @@ private:
 
 	ScoreList m_aoScoreLists[NUMBER_OF_SPEEDS * NUMBER_OF_SCORE_LIST_TYPES];
 
+	// Incremented whenever the corresponding score list changes, so cached
+	// lines of text know when to re-format
+	unsigned int m_auiListRevisions[NUMBER_OF_SPEEDS *
+									NUMBER_OF_SCORE_LIST_TYPES];
+
+	// One line of text per place in the displayed list
+	mutable TextCache m_aoLineText[SCORE_LIST_SIZE];
+
 };
 
 #endif	// _HIGH_SCORES_H_
\ No newline at end of file
@@ -4,14 +4,15 @@
  * Date Created:       September 24, 2013
  * Description:        Definitions for the class that handles the score from a
  *                       single match.
- * Last Modified:      September 24, 2013
- * Last Modification:  Created.
+ * Last Modified:      October 1, 2013
+ * Last Modification:  Added printing to a text cache.
  ******************************************************************************/
 
 #ifndef _MATCH_SCORE_H_
 #define _MATCH_SCORE_H_
 
 #include "Globals.h"
+#include "TextCache.h"
 
 // Stores the score from a single match
 class MatchScore
@@ -30,6 +31,7 @@ public:
 					   unsigned int a_uiBufferSize,
 					   const MatchScore& a_roScore );
 	void Print( char* a_pcBuffer, unsigned int a_uiBufferSize ) const;
+	void Print( TextCache& a_roText ) const;
 
 	static const ScoreComparer COMPARERS[NUMBER_OF_SCORE_LIST_TYPES];
 
@@ -3,8 +3,8 @@
  * Author:             Elizabeth Lowry
  * Date Created:       September 11, 2013
  * Description:        Definitions for the class that handles a player sprite.
- * Last Modified:      September 23, 2013
- * Last Modification:  Updated formatting to follow coding standards.
+ * Last Modified:      October 1, 2013
+ * Last Modification:  Added printing to a text cache.
  ******************************************************************************/
 
 #ifndef _PLAYER_H_
@@ -13,6 +13,7 @@
 #include "AIE.h"
 #include "Ball.h"
 #include "Sprite.h"
+#include "TextCache.h"
 
 class Player : public Sprite
 {
@@ -45,6 +46,7 @@ public:
 	void Hit() const;
 	void IncrementScore();
 	void PrintScore( char* a_pcBuffer, unsigned int a_uiBufferSize );
+	void PrintScore( TextCache& a_roText ) const;
 	void Reset();
 	void Serve() const;
 	void SetMode( Mode a_eMode );
@@ -3,13 +3,15 @@
  * Author:             Elizabeth Lowry
  * Date Created:       September 23, 2013
  * Description:        Definitions for the class that tracks elapsed time.
- * Last Modified:      September 23, 2013
- * Last Modification:  Creation.
+ * Last Modified:      October 1, 2013
+ * Last Modification:  Fixed millisecond overflow after 71 minutes.
  ******************************************************************************/
 
 #ifndef _STOP_WATCH_H_
 #define _STOP_WATCH_H_
 
+#include "TextCache.h"
+
 // Class handling a timer that tracks elapsed time (excluding time paused)
 class StopWatch
 {
@@ -28,6 +30,9 @@ public:
 	static void Print( char* a_pcBuffer,
 					   unsigned int a_uiBufferSize,
 					   unsigned long a_ulTicks );
+	static void Print( TextCache& a_roText, unsigned long a_ulTicks );
+	static unsigned long TotalMilliseconds( unsigned long a_ulTicks );
+	static unsigned int RemainderMilliseconds( unsigned long a_ulTicks );
 	void Start();
 	void Stop();
 
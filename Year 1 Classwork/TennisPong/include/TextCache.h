@@ -0,0 +1,89 @@
+/******************************************************************************
+ * File:               TextCache.h
+ * Author:             Elizabeth Lowry
+ * Date Created:       October 1, 2013
+ * Description:        Definitions for the class that holds a line of text that
+ *                       only needs to be re-formatted when the values it
+ *                       displays change.
+ * Last Modified:      October 1, 2013
+ * Last Modification:  Creation.
+ ******************************************************************************/
+
+#ifndef _TEXT_CACHE_H_
+#define _TEXT_CACHE_H_
+
+#include "AIE.h"
+
+// Holds a pre-formatted line of text along with the values it was formatted
+// from.  Each frame, bind the current values; if none of them changed since the
+// last time the text was formatted, the text can be drawn as-is.
+class TextCache
+{
+public:
+
+	TextCache();
+
+	// Compare a value to the one bound in the given slot last time and, if they
+	// differ, store the new value and mark the text as stale.  Strings are
+	// compared by address, so only bind strings that are never modified.
+	TextCache& Bind( unsigned int a_uiSlot, unsigned long a_ulValue );
+	TextCache& Bind( unsigned int a_uiSlot, const char* const ac_pcValue );
+
+	// Does the text need to be re-formatted?
+	bool IsStale() const;
+
+	// Start formatting over with an empty line.  Clears the stale flag.
+	TextCache& Clear();
+
+	// Append text or an unsigned integer, padded with leading zeroes to the
+	// given minimum number of digits, to the end of the line
+	TextCache& Append( const char* ac_pcText );
+	TextCache& Append( unsigned long a_ulValue, unsigned int a_uiMinDigits = 1 );
+
+	// Draw the cached line without re-formatting it
+	void Draw( int a_iXPos,
+			   int a_iYPos,
+			   SColour a_sColour = SColour(0xFF,0xFF,0xFF,0xFF) ) const;
+
+	// Line properties, measured once when the line is formatted
+	const char* GetText() const;
+	unsigned int GetLength() const;
+
+	// How many times has this line been cleared for re-formatting?
+	unsigned int GetFormatCount() const;
+
+	// Write an unsigned integer to a buffer without going through sprintf_s.
+	// Returns the number of characters written, not counting the terminating
+	// null.  Output is truncated if the buffer is too small.
+	static unsigned int Print( char* a_pcBuffer,
+							   unsigned int a_uiBufferSize,
+							   unsigned long a_ulValue,
+							   unsigned int a_uiMinDigits = 1 );
+
+	static const unsigned int BUFFER_SIZE = 64;
+	static const unsigned int SLOT_COUNT = 4;
+
+private:
+
+	// A value bound to the text - either a number or a string address, with
+	// the unused member left zeroed
+	struct Binding
+	{
+		unsigned long ulValue;
+		const char* pcValue;
+	};
+
+	// "00" "01" "02" ... "99", for converting two digits at a time
+	static const char DIGIT_PAIRS[201];
+
+	Binding m_aoBindings[SLOT_COUNT];
+	bool m_abBound[SLOT_COUNT];	// has anything been bound to each slot yet?
+	bool m_bStale;
+	unsigned int m_uiFormatCount;
+
+	char m_acText[BUFFER_SIZE];
+	unsigned int m_uiLength;
+
+};
+
+#endif	// _TEXT_CACHE_H_
@@ -3,8 +3,8 @@
  * Author:             Elizabeth Lowry
  * Date Created:       September 17, 2013
  * Description:        Implementations for methods of the Game class.
- * Last Modified:      September 25, 2013
- * Last Modification:  Debugging menu.
+ * Last Modified:      October 1, 2013
+ * Last Modification:  Cached score and time text.
  ******************************************************************************/
 
 #include "AIE.h"
@@ -16,6 +16,7 @@
 #include "Player.h"
 #include "Sprite.h"
 #include "StopWatch.h"
+#include "TextCache.h"
 #include <algorithm>	// for std::max(int a, int b)
 #include <cstdlib>	// for rand and abs
 
@@ -182,20 +183,25 @@ void Game::DrawPauseScreen()
 						 (int)PAUSE_MESSAGE_POSITION.y );
 }
 
-// Draw scores and time
+// Draw scores and time.  Text is only re-formatted when the score or displayed
+// time actually changes.
 void Game::DrawScores()
 {
-	// create a buffer to hold text
-	const unsigned int cuiBufferSize = 20;
-	char acBuffer[cuiBufferSize];
-
 	// Draw the left player's score
-	m_oLeftPlayer.PrintScore( acBuffer, cuiBufferSize );
-	DrawString( acBuffer, LEFT_SCORE_X, SCORE_Y );
+	m_oLeftScoreText.Bind( 0, m_oLeftPlayer.GetScore() );
+	if( m_oLeftScoreText.IsStale() )
+	{
+		m_oLeftPlayer.PrintScore( m_oLeftScoreText );
+	}
+	m_oLeftScoreText.Draw( LEFT_SCORE_X, SCORE_Y );
 
 	// Draw the right player's score
-	m_oRightPlayer.PrintScore( acBuffer, cuiBufferSize );
-	DrawString( acBuffer, RIGHT_SCORE_X, SCORE_Y );
+	m_oRightScoreText.Bind( 0, m_oRightPlayer.GetScore() );
+	if( m_oRightScoreText.IsStale() )
+	{
+		m_oRightPlayer.PrintScore( m_oRightScoreText );
+	}
+	m_oRightScoreText.Draw( RIGHT_SCORE_X, SCORE_Y );
 
 	// Draw the match time
 	if( m_oPlayTime.GetSeconds() > OVERTIME_SECONDS )
@@ -206,11 +212,14 @@ void Game::DrawScores()
 	}
 	else
 	{
-		strcpy_s(acBuffer, cuiBufferSize, TIME_PREFIX);
-		unsigned int uiStartPrint = strlen(acBuffer);
-		m_oPlayTime.Print( acBuffer + uiStartPrint,
-						   cuiBufferSize - uiStartPrint );
-		DrawString( acBuffer, (int)TIME_POSITION.x, (int)TIME_POSITION.y );
+		unsigned long ulTicks = m_oPlayTime.GetTicks();
+		m_oTimeText.Bind( 0, StopWatch::TotalMilliseconds( ulTicks ) );
+		if( m_oTimeText.IsStale() )
+		{
+			m_oTimeText.Clear().Append( TIME_PREFIX );
+			StopWatch::Print( m_oTimeText, ulTicks );
+		}
+		m_oTimeText.Draw( (int)TIME_POSITION.x, (int)TIME_POSITION.y );
 	}
 }
 
@@ -3,19 +3,19 @@
  * Author:             Elizabeth Lowry
  * Date Created:       September 23, 2013
  * Description:        Implementations for methods of the Scores class.
- * Last Modified:      September 24, 2013
- * Last Modification:  Debugging.
+ * Last Modified:      October 1, 2013
+ * Last Modification:  Cached score list text.
  ******************************************************************************/
 
 #include "AIE.h"
 #include "HighScores.h"
 #include "MatchScore.h"
 #include "StopWatch.h"
-#include <cstdio>   // for sprintf_s
-#include <cstring>  // for strlen
+#include "TextCache.h"
 
 const XYPair HighScores::LIST_POSITION = {250,440};
-const char* const HighScores::SCORE_PREFIX = "#%d:   ";
+const char* const HighScores::PLACE_PREFIX = "#";
+const char* const HighScores::PLACE_SUFFIX = ":   ";
 
 // Constructor instantiates most members in initializer list
 HighScores::HighScores( const Player& a_roLeftPlayer,
@@ -39,13 +39,21 @@ HighScores::HighScores( const Player& a_roLeftPlayer,
 	{
 		*poScoreList = ScoreList();
 	}
+	for( unsigned int ui = 0;
+		 ui < NUMBER_OF_SPEEDS * NUMBER_OF_SCORE_LIST_TYPES;
+		 ++ui )
+	{
+		m_auiListRevisions[ui] = 0;
+	}
 }
 
 // Add the score to a list.  Keep the list at or below max size.
 void HighScores::AddScoreToList( const MatchScore& ac_roScore,
 								 ScoreListType a_eListType )
 {
-	ScoreList& roScoreList = m_aoScoreLists[ScoreListIndex( a_eListType )];
+	const unsigned int cuiIndex = ScoreListIndex( a_eListType );
+	ScoreList& roScoreList = m_aoScoreLists[cuiIndex];
+	++m_auiListRevisions[cuiIndex];
 	roScoreList.push_back( ac_roScore );
 	roScoreList.sort( MatchScore::COMPARERS[a_eListType] );
 	if( roScoreList.size() > SCORE_LIST_SIZE )
@@ -54,33 +62,34 @@ void HighScores::AddScoreToList( const MatchScore& ac_roScore,
 	}
 }
 
-// Draw the scores to the screen
+// Draw the scores to the screen.  Lines are only re-formatted when a different
+// list is displayed or the displayed list changes.
 void HighScores::Draw() const
 {
 	// Select the list to display
-	const ScoreList& roScoreList =
-		m_aoScoreLists[ScoreListIndex( m_reDisplayListType )];
+	const unsigned int cuiIndex = ScoreListIndex( m_reDisplayListType );
+	const ScoreList& roScoreList = m_aoScoreLists[cuiIndex];
 
 	// Iterate through the list
-	const unsigned int cuiBufferSize = 64;
-	char acScoreTextBuffer[cuiBufferSize];
 	ScoreList::const_iterator oScoreIterator = roScoreList.cbegin();
 	for( unsigned int ui = 0;
-		 oScoreIterator != roScoreList.cend();
+		 oScoreIterator != roScoreList.cend() && ui < SCORE_LIST_SIZE;
 		 ++ui, ++oScoreIterator )
 	{
-		// Print the place in the list
-		sprintf_s( acScoreTextBuffer, cuiBufferSize, SCORE_PREFIX, ui + 1 );
-
-		// Print the score after the place
-		unsigned int uiStartPrint = strlen( acScoreTextBuffer );
-		(*oScoreIterator).Print( acScoreTextBuffer + uiStartPrint,
-								 cuiBufferSize - uiStartPrint );
+		// Re-format the line in "#place:   score" format if the list it shows
+		// has changed
+		TextCache& roLine = m_aoLineText[ui];
+		roLine.Bind( 0, cuiIndex ).Bind( 1, m_auiListRevisions[cuiIndex] );
+		if( roLine.IsStale() )
+		{
+			roLine.Clear().Append( PLACE_PREFIX ).Append( ui + 1 )
+				  .Append( PLACE_SUFFIX );
+			(*oScoreIterator).Print( roLine );
+		}
 
-		// Draw the string
-		DrawString( acScoreTextBuffer,
-					(int)LIST_POSITION.x,
-					(int)LIST_POSITION.y + ( ui * LINE_SEPARATION ) );
+		// Draw the cached line
+		roLine.Draw( (int)LIST_POSITION.x,
+					 (int)LIST_POSITION.y + ( ui * LINE_SEPARATION ) );
 	}
 }
 
@@ -4,13 +4,14 @@
  * Date Created:       September 24, 2013
  * Description:        Definitions for the class that handles the score from a
  *                       single match.
- * Last Modified:      September 24, 2013
- * Last Modification:  Created.
+ * Last Modified:      October 1, 2013
+ * Last Modification:  Added printing to a text cache.
  ******************************************************************************/
 
 #include "Globals.h"
 #include "MatchScore.h"
 #include "StopWatch.h"	// for StopWatch::Print
+#include "TextCache.h"
 #include <algorithm>	// for max
 #include <cstdio>	// for sprintf_s
 
@@ -139,4 +140,14 @@ void MatchScore::Print( char* a_pcBuffer,
 void MatchScore::Print( char* a_pcBuffer, unsigned int a_uiBufferSize ) const
 {
 	Print( a_pcBuffer, a_uiBufferSize, *this );
-}
\ No newline at end of file
+}
+
+// Append a score to a text cache without going through sprintf_s, in the same
+// format as SCORE_TEXT_FORMAT
+void MatchScore::Print( TextCache& a_roText ) const
+{
+	a_roText.Append( m_uiLeftScore ).Append( "-" ).Append( m_uiRightScore )
+			.Append( "   " );
+	StopWatch::Print( a_roText, m_ulTicks );
+	a_roText.Append( "   " ).Append( HUMAN_PLAYER_STRINGS[m_eHumanPlayers] );
+}
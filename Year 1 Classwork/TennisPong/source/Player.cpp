@@ -3,12 +3,13 @@
  * Author:             Elizabeth Lowry
  * Date Created:       September 11, 2013
  * Description:        Implementation for methods of the Player class.
- * Last Modified:      September 23, 2013
- * Last Modification:  Formatting to meet coding standards.
+ * Last Modified:      October 1, 2013
+ * Last Modification:  Added printing to a text cache.
  ******************************************************************************/
 
 #include "AIE.h"
 #include "Player.h"
+#include "TextCache.h"
 #include <cstdio>	// for sprintf_s
 #include <cstdlib>	// for rand
 
@@ -162,6 +163,13 @@ void Player::PrintScore( char* a_pcBuffer, unsigned int a_uiBufferSize )
 			   GetScore() );
 }
 
+// Re-format a text cache with the player's score in "PlayerName: Score" format
+void Player::PrintScore( TextCache& a_roText ) const
+{
+	a_roText.Clear().Append( GetPlayerName() ).Append( ": " )
+					.Append( GetScore() );
+}
+
 // Serve the ball
 void Player::Serve() const
 {
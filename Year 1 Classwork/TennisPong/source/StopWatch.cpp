@@ -3,11 +3,12 @@
  * Author:             Elizabeth Lowry
  * Date Created:       September 23, 2013
  * Description:        Implementation for functions of the StopWatch class.
- * Last Modified:      September 23, 2013
- * Last Modification:  Creation.
+ * Last Modified:      October 1, 2013
+ * Last Modification:  Fixed millisecond overflow after 71 minutes.
  ******************************************************************************/
 
 #include "StopWatch.h"
+#include "TextCache.h"
 #include <cstdio>	// for sprintf_s
 #include <ctime>
 
@@ -79,8 +80,7 @@ void StopWatch::Print( char* a_pcBuffer,
 	unsigned int uiM =
 		(unsigned int)( ( a_ulTicks / ( CLOCKS_PER_SEC * 60 ) ) % 60 );
 	unsigned int uiS = (unsigned int)( ( a_ulTicks / CLOCKS_PER_SEC ) % 60 );
-	unsigned int uiMS =
-		(unsigned int)( ( ( a_ulTicks * 1000 ) / CLOCKS_PER_SEC ) % 1000 );
+	unsigned int uiMS = RemainderMilliseconds( a_ulTicks );
 	sprintf_s( a_pcBuffer, a_uiBufferSize, TIME_FORMAT, ulH, uiM, uiS, uiMS );
 }
 
@@ -91,6 +91,33 @@ void StopWatch::Print( char* a_pcBuffer, unsigned int a_uiBufferSize) const
 	Print( a_pcBuffer, a_uiBufferSize, GetTicks() );
 }
 
+// Append the time to a text cache in hours:minutes:seconds.milliseconds format
+// without going through sprintf_s
+void StopWatch::Print( TextCache& a_roText, unsigned long a_ulTicks )
+{
+	a_roText.Append( a_ulTicks / ( CLOCKS_PER_SEC * 3600 ) ).Append( ":" )
+			.Append( ( a_ulTicks / ( CLOCKS_PER_SEC * 60 ) ) % 60, 2 )
+			.Append( ":" )
+			.Append( ( a_ulTicks / CLOCKS_PER_SEC ) % 60, 2 ).Append( "." )
+			.Append( RemainderMilliseconds( a_ulTicks ), 3 );
+}
+
+// Convert ticks to whole milliseconds - the finest unit that gets printed.
+// Whole seconds and the remainder are converted separately, since multiplying
+// all the ticks by 1000 overflows after a little over an hour.
+unsigned long StopWatch::TotalMilliseconds( unsigned long a_ulTicks )
+{
+	return ( a_ulTicks / CLOCKS_PER_SEC ) * 1000 +
+		   RemainderMilliseconds( a_ulTicks );
+}
+
+// Get the milliseconds past the last whole second
+unsigned int StopWatch::RemainderMilliseconds( unsigned long a_ulTicks )
+{
+	return (unsigned int)( ( a_ulTicks % CLOCKS_PER_SEC ) * 1000 /
+						   CLOCKS_PER_SEC );
+}
+
 // Unpause the stopwatch
 void StopWatch::Start()
 {
@@ -0,0 +1,195 @@
+/******************************************************************************
+ * File:               TextCache.cpp
+ * Author:             Elizabeth Lowry
+ * Date Created:       October 1, 2013
+ * Description:        Implementations for methods of the TextCache class.
+ * Last Modified:      October 1, 2013
+ * Last Modification:  Creation.
+ ******************************************************************************/
+
+#include "AIE.h"
+#include "TextCache.h"
+
+// "00" "01" "02" ... "99"
+const char TextCache::DIGIT_PAIRS[201] =
+	"00010203040506070809"
+	"10111213141516171819"
+	"20212223242526272829"
+	"30313233343536373839"
+	"40414243444546474849"
+	"50515253545556575859"
+	"60616263646566676869"
+	"70717273747576777879"
+	"80818283848586878889"
+	"90919293949596979899";
+
+// Default constructor starts with an empty, stale line and nothing bound
+TextCache::TextCache()
+	: m_bStale( true ),
+	  m_uiFormatCount( 0 ),
+	  m_uiLength( 0 )
+{
+	for( unsigned int ui = 0; ui < SLOT_COUNT; ++ui )
+	{
+		m_aoBindings[ui].ulValue = 0;
+		m_aoBindings[ui].pcValue = nullptr;
+		m_abBound[ui] = false;
+	}
+	m_acText[0] = '\0';
+}
+
+// Bind a number to a slot, marking the text stale if the number changed
+TextCache& TextCache::Bind( unsigned int a_uiSlot, unsigned long a_ulValue )
+{
+	if( a_uiSlot < SLOT_COUNT &&
+		( !m_abBound[a_uiSlot] ||
+		  m_aoBindings[a_uiSlot].ulValue != a_ulValue ||
+		  m_aoBindings[a_uiSlot].pcValue != nullptr ) )
+	{
+		m_aoBindings[a_uiSlot].ulValue = a_ulValue;
+		m_aoBindings[a_uiSlot].pcValue = nullptr;
+		m_abBound[a_uiSlot] = true;
+		m_bStale = true;
+	}
+	return *this;
+}
+
+// Bind a string to a slot, marking the text stale if the string changed
+TextCache& TextCache::Bind( unsigned int a_uiSlot, const char* const ac_pcValue )
+{
+	if( a_uiSlot < SLOT_COUNT &&
+		( !m_abBound[a_uiSlot] ||
+		  m_aoBindings[a_uiSlot].pcValue != ac_pcValue ||
+		  m_aoBindings[a_uiSlot].ulValue != 0 ) )
+	{
+		m_aoBindings[a_uiSlot].ulValue = 0;
+		m_aoBindings[a_uiSlot].pcValue = ac_pcValue;
+		m_abBound[a_uiSlot] = true;
+		m_bStale = true;
+	}
+	return *this;
+}
+
+// Does the text need to be re-formatted?
+bool TextCache::IsStale() const
+{
+	return m_bStale;
+}
+
+// Start over with an empty line
+TextCache& TextCache::Clear()
+{
+	m_acText[0] = '\0';
+	m_uiLength = 0;
+	m_bStale = false;
+	++m_uiFormatCount;
+	return *this;
+}
+
+// Copy as much of the given text onto the end of the line as will fit
+TextCache& TextCache::Append( const char* ac_pcText )
+{
+	if( nullptr != ac_pcText )
+	{
+		while( '\0' != *ac_pcText && m_uiLength + 1 < BUFFER_SIZE )
+		{
+			m_acText[m_uiLength++] = *(ac_pcText++);
+		}
+		m_acText[m_uiLength] = '\0';
+	}
+	return *this;
+}
+
+// Write a number onto the end of the line
+TextCache& TextCache::Append( unsigned long a_ulValue,
+							  unsigned int a_uiMinDigits )
+{
+	m_uiLength += Print( m_acText + m_uiLength,
+						 BUFFER_SIZE - m_uiLength,
+						 a_ulValue,
+						 a_uiMinDigits );
+	return *this;
+}
+
+// Draw the cached line without re-formatting it
+void TextCache::Draw( int a_iXPos, int a_iYPos, SColour a_sColour ) const
+{
+	if( 0 < m_uiLength )
+	{
+		DrawString( m_acText, a_iXPos, a_iYPos, a_sColour );
+	}
+}
+
+// Get the formatted line
+const char* TextCache::GetText() const
+{
+	return m_acText;
+}
+
+// Get the length of the formatted line, in characters
+unsigned int TextCache::GetLength() const
+{
+	return m_uiLength;
+}
+
+// How many times has this line been cleared for re-formatting?
+unsigned int TextCache::GetFormatCount() const
+{
+	return m_uiFormatCount;
+}
+
+// Write an unsigned integer to a buffer, two digits at a time
+unsigned int TextCache::Print( char* a_pcBuffer,
+							   unsigned int a_uiBufferSize,
+							   unsigned long a_ulValue,
+							   unsigned int a_uiMinDigits )
+{
+	if( nullptr == a_pcBuffer || 0 == a_uiBufferSize )
+	{
+		return 0;
+	}
+
+	// Fill a scratch buffer from the end, since digits come out backwards.  An
+	// unsigned long has at most 20 digits.
+	const unsigned int cuiScratchSize = 20;
+	char acScratch[cuiScratchSize];
+	char* pcStart = acScratch + cuiScratchSize;
+	while( a_ulValue >= 100 )
+	{
+		const unsigned int cuiPair = (unsigned int)( a_ulValue % 100 ) * 2;
+		a_ulValue /= 100;
+		*(--pcStart) = DIGIT_PAIRS[cuiPair + 1];
+		*(--pcStart) = DIGIT_PAIRS[cuiPair];
+	}
+	if( a_ulValue >= 10 )
+	{
+		const unsigned int cuiPair = (unsigned int)a_ulValue * 2;
+		*(--pcStart) = DIGIT_PAIRS[cuiPair + 1];
+		*(--pcStart) = DIGIT_PAIRS[cuiPair];
+	}
+	else
+	{
+		*(--pcStart) = (char)( '0' + a_ulValue );
+	}
+
+	// Pad with zeroes
+	if( a_uiMinDigits > cuiScratchSize )
+	{
+		a_uiMinDigits = cuiScratchSize;
+	}
+	while( (unsigned int)( acScratch + cuiScratchSize - pcStart ) <
+		   a_uiMinDigits )
+	{
+		*(--pcStart) = '0';
+	}
+
+	// Copy as many digits as will fit, leaving room for the terminating null
+	unsigned int uiLength = 0;
+	while( pcStart != acScratch + cuiScratchSize &&
+		   uiLength + 1 < a_uiBufferSize )
+	{
+		a_pcBuffer[uiLength++] = *(pcStart++);
+	}
+	a_pcBuffer[uiLength] = '\0';
+	return uiLength;
+}
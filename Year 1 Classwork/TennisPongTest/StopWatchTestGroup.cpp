@@ -0,0 +1,122 @@
+/******************************************************************************
+ * File:               StopWatchTestGroup.cpp
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Tests for printing stopwatch times.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Creation.
+ ******************************************************************************/
+
+#include "StopWatchTestGroup.h"
+#include "StopWatch.h"
+#include "TextCache.h"
+#include <cstdio>   // for sprintf_s
+#include <cstring>  // for strcmp
+#include <ctime>    // for CLOCKS_PER_SEC
+
+namespace
+{
+
+// Ticks after which a 32-bit count of ticks times 1000 overflows - a little
+// under 72 minutes at 1000 ticks per second
+const unsigned long long sgc_ullWrapTicks = 0x100000000ull / 1000;
+
+// Random ticks across the whole 32-bit range
+unsigned int Random( unsigned int& a_ruiSeed )
+{
+    a_ruiSeed = a_ruiSeed * 1664525u + 1013904223u;
+    return a_ruiSeed;
+}
+
+// Print the time the slow way, with 64-bit arithmetic that can't overflow
+void Expected( char* a_pcBuffer, unsigned int a_uiBufferSize,
+               unsigned long a_ulTicks )
+{
+    unsigned long long ullMS =
+        ( (unsigned long long)a_ulTicks * 1000 ) / CLOCKS_PER_SEC;
+    sprintf_s( a_pcBuffer, a_uiBufferSize, "%llu:%02u:%02u.%03u",
+               ullMS / 3600000, (unsigned int)( ( ullMS / 60000 ) % 60 ),
+               (unsigned int)( ( ullMS / 1000 ) % 60 ),
+               (unsigned int)( ullMS % 1000 ) );
+}
+
+// Do both printers give the expected time for the given ticks?
+bool PrintsCorrectly( unsigned long a_ulTicks )
+{
+    char acExpected[32];
+    char acPrinted[32];
+    Expected( acExpected, 32, a_ulTicks );
+    StopWatch::Print( acPrinted, 32, a_ulTicks );
+    TextCache oText;
+    StopWatch::Print( oText.Clear(), a_ulTicks );
+    return ( 0 == std::strcmp( acExpected, acPrinted ) &&
+             0 == std::strcmp( acExpected, oText.GetText() ) );
+}
+
+}   // namespace
+
+StopWatchTestGroup::StopWatchTestGroup()
+    : UnitTestGroup("Stop watch tests")
+{
+    AddTest( "Times past the 32-bit millisecond wrap", PastTheWrap );
+    AddTest( "Printers agree", PrintersAgree );
+}
+
+UnitTest::Result StopWatchTestGroup::PastTheWrap()
+{
+    // Two hours, three minutes, four and a half seconds - past the wrap as
+    // long as there are at least 1000 ticks per second
+    const unsigned long culTicks =
+        ( 2 * 3600 + 3 * 60 + 4 ) * CLOCKS_PER_SEC + CLOCKS_PER_SEC / 2;
+    if( culTicks <= sgc_ullWrapTicks )
+    {
+        return UnitTest::Fail( "Test time doesn't pass the wrap" );
+    }
+    TextCache oText;
+    StopWatch::Print( oText.Clear(), culTicks );
+    if( 0 != std::strcmp( "2:03:04.500", oText.GetText() ) )
+    {
+        return UnitTest::Fail( std::string( "Printed " ) + oText.GetText() );
+    }
+    if( 7384500 != StopWatch::TotalMilliseconds( culTicks ) ||
+        500 != StopWatch::RemainderMilliseconds( culTicks ) )
+    {
+        return UnitTest::Fail( "Milliseconds overflowed" );
+    }
+
+    // Either side of the wrap, and the very last tick
+    const unsigned long caulTicks[] =
+        { (unsigned long)sgc_ullWrapTicks - 1, (unsigned long)sgc_ullWrapTicks,
+          (unsigned long)sgc_ullWrapTicks + 1, culTicks, 0xFFFFFFFFul };
+    for( unsigned int ui = 0; ui < 5; ++ui )
+    {
+        if( !PrintsCorrectly( caulTicks[ui] ) )
+        {
+            return UnitTest::Fail( "Time near the wrap was printed wrong" );
+        }
+    }
+    return UnitTest::PASS;
+}
+
+// Times up to twice the wrap point, and random times up to the largest tick
+// count, come out the same from the sprintf printer, the text cache printer,
+// and 64-bit arithmetic
+UnitTest::Result StopWatchTestGroup::PrintersAgree()
+{
+    for( unsigned long long ull = 0; ull < 2 * sgc_ullWrapTicks; ull += 97 )
+    {
+        if( !PrintsCorrectly( (unsigned long)ull ) )
+        {
+            return UnitTest::Fail( "Printers disagreed around the wrap" );
+        }
+    }
+    unsigned int uiSeed = 12345;
+    for( unsigned int ui = 0; ui < 100000; ++ui )
+    {
+        if( !PrintsCorrectly( Random( uiSeed ) ) )
+        {
+            return UnitTest::Fail( "Printers disagreed on a random time" );
+        }
+    }
+    return UnitTest::PASS;
+}
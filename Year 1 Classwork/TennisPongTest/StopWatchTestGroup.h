@@ -0,0 +1,28 @@
+/******************************************************************************
+ * File:               StopWatchTestGroup.h
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Tests for printing stopwatch times.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Creation.
+ ******************************************************************************/
+
+#ifndef STOP_WATCH_TEST_GROUP__H
+#define STOP_WATCH_TEST_GROUP__H
+
+#include "UnitTestGroup.h"
+
+class StopWatchTestGroup : public UnitTestGroup
+{
+public:
+
+    StopWatchTestGroup();
+
+private:
+
+    static UnitTest::Result PastTheWrap();
+    static UnitTest::Result PrintersAgree();
+
+};
+
+#endif  // STOP_WATCH_TEST_GROUP__H
@@ -0,0 +1,35 @@
+/******************************************************************************
+ * File:               main.cpp
+ * Author:             Elizabeth Lowry
+ * Date Created:       March 28, 2014
+ * Description:        Runs a list of TennisPong unit test groups.
+ * Last Modified:      March 28, 2014
+ * Last Modification:  Creation.
+ ******************************************************************************/
+
+#include "UnitTester.h"
+#include "StopWatchTestGroup.h"
+#include "AIE.h"
+#include <conio.h>
+#include <iostream>
+#include <string>
+
+// Text caches draw through the AIE framework, which needs a window.  Nothing
+// under test draws, so this stands in for it instead of linking the framework.
+void DrawString( const char* a_pText, int a_iXPos, int a_iYPos,
+                 SColour a_sColour )
+{
+}
+
+int main(int argc, char* argv[])
+{
+    // set up
+    UnitTester oTester;
+    oTester.AddTestGroup( StopWatchTestGroup() );
+
+    // run
+    oTester( std::cout );
+    std::cout << std::endl << std::endl << "Press any key to exit...";
+    _getch();
+    return 0;
+}
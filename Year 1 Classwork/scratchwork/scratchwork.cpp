@@ -312,10 +312,10 @@ void PrintScores( const list<Score>& a_roScores )
 
 bool ReadScores( list<Score>& a_roScores, const string& a_roFileName )
 {
-    // try to open the XML file
-    tinyxml2::XMLDocument oXML;
-    tinyxml2::XMLError oError = oXML.LoadFile( a_roFileName.c_str() );
-    if( tinyxml2::XML_SUCCESS != oError )
+    // try to open the XML file.  It gets read as a stream of events instead of
+    // being built into a document tree, so only the scores themselves are kept.
+    tinyxml2::XMLPullParser oXML;
+    if( tinyxml2::XML_SUCCESS != oXML.LoadFile( a_roFileName.c_str() ) )
     {
         cout << "Unable to parse XML file.";
         return false;
@@ -326,37 +326,110 @@ bool ReadScores( list<Score>& a_roScores, const string& a_roFileName )
     // - - score        a single player score
     // - - - name       name of the player that made the score
     // - - - points     point value of the score
-    tinyxml2::XMLElement* poRoot = oXML.FirstChildElement( "scores" );
-    if( NULL == poRoot )
+    bool bFoundList = false;
+    bool bInList = false;
+    bool bFoundScore = false;
+    bool bInScore = false;
+    bool bHasName = false;
+    bool bHasPoints = false;
+    string* poField = NULL;
+    Score oValue;
+    string oPoints;
+    list<Score> oScores;
+    while( tinyxml2::XMLPullParser::END_DOCUMENT != oXML.Next() )
     {
-        cout << "No score list in XML file.";
+        switch( oXML.Event() )
+        {
+        case tinyxml2::XMLPullParser::START_ELEMENT:
+            // only the first score list counts
+            if( 0 == oXML.Depth() && !bFoundList &&
+                oXML.Name().Equals( "scores" ) )
+            {
+                bFoundList = bInList = true;
+            }
+            else if( 1 == oXML.Depth() && bInList &&
+                     oXML.Name().Equals( "score" ) )
+            {
+                bFoundScore = bInScore = true;
+                bHasName = bHasPoints = false;
+            }
+
+            // only the first name and points elements in a score count
+            else if( 2 == oXML.Depth() && bInScore && !bHasName &&
+                     oXML.Name().Equals( "name" ) )
+            {
+                bHasName = true;
+                oValue.name.clear();
+                poField = &oValue.name;
+            }
+            else if( 2 == oXML.Depth() && bInScore && !bHasPoints &&
+                     oXML.Name().Equals( "points" ) )
+            {
+                bHasPoints = true;
+                oPoints.clear();
+                poField = &oPoints;
+            }
+            break;
+
+        case tinyxml2::XMLPullParser::TEXT:
+            if( 3 == oXML.Depth() && NULL != poField )
+            {
+                *poField = oXML.Value().CStr();
+                poField = NULL;
+            }
+            break;
+
+        case tinyxml2::XMLPullParser::END_ELEMENT:
+            if( 2 == oXML.Depth() )
+            {
+                poField = NULL;
+            }
+            else if( 1 == oXML.Depth() && bInScore )
+            {
+                bInScore = false;
+                if( !bHasName || !bHasPoints )
+                {
+                    break;
+                }
+                try
+                {
+                    oValue.points = stoul( oPoints );
+                }
+                catch( exception oException )
+                {
+                    break;
+                }
+                oScores.push_back( oValue );
+            }
+            else if( 0 == oXML.Depth() )
+            {
+                bInList = false;
+            }
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    // report problems
+    if( oXML.Error() )
+    {
+        cout << "Unable to parse XML file.";
         return false;
     }
-    if( poRoot->NoChildren() || NULL == poRoot->FirstChildElement( "score" ) )
+    if( !bFoundList )
     {
-        cout << "No scores in list.";
+        cout << "No score list in XML file.";
         return false;
     }
-
-    // loop through the score elements
-    for( tinyxml2::XMLElement* poScore = poRoot->FirstChildElement( "score" );
-         poScore != NULL;
-         poScore = poScore->NextSiblingElement( "score" ) )
+    if( !bFoundScore )
     {
-        Score oValue;
-        oValue.name = poScore->FirstChildElement( "name" )->GetText();
-        string oPoints = poScore->FirstChildElement( "points" )->GetText();
-        try
-        {
-            oValue.points = stoul( oPoints );
-        }
-        catch( exception oException )
-        {
-            continue;
-        }
-        a_roScores.push_back(oValue);
+        cout << "No scores in list.";
+        return false;
     }
 
+    a_roScores.splice( a_roScores.end(), oScores );
     return true;
 }
 
@@ -19,12 +19,27 @@ must not be misrepresented as being the original software.
 
 3. This notice may not be removed or altered from any source
 distribution.
+
+This is an altered version: XMLStringView, XMLSaxHandler, and XMLPullParser
+(a streaming, in-situ parsing mode) were added to the original source.
 */
 
 #include "stdafx.h" // added so VC++ doesn't complain
 #include "tinyxml2.h"
 
 #include <new>		// yes, this one new style header, is in the Android SDK.
+
+#if !defined(TINYXML2_NO_MMAP)
+#   if defined(_WIN32)
+#       define WIN32_LEAN_AND_MEAN
+#       include <windows.h>	// for XMLPullParser file mapping
+#   else
+#       include <fcntl.h>
+#       include <sys/mman.h>
+#       include <sys/stat.h>
+#       include <unistd.h>
+#   endif
+#endif
 #   ifdef ANDROID_NDK
 #   include <stddef.h>
 #else
@@ -2098,4 +2113,517 @@ bool XMLPrinter::Visit( const XMLUnknown& unknown )
     return true;
 }
 
+
+// --------- XMLStringView ---------- //
+
+bool XMLStringView::Equals( const char* str ) const
+{
+    if ( !_start ) {
+        return !str || !*str;
+    }
+    size_t length = Length();
+    return strncmp( _start, str, length ) == 0 && str[length] == 0;
+}
+
+
+bool XMLStringView::Equals( const XMLStringView& view ) const
+{
+    return Length() == view.Length() && ( Empty() || memcmp( _start, view._start, Length() ) == 0 );
+}
+
+
+const char* XMLStringView::CStr()
+{
+    if ( !_start ) {
+        return "";
+    }
+    if ( !( _flags & DECODED ) ) {
+        // StrPair already knows how to do this in place; borrow it.
+        StrPair pair;
+        pair.Set( _start, _end, _flags );
+        _start = const_cast<char*>( pair.GetStr() );
+        _end = _start + strlen( _start );
+        _flags = DECODED;
+    }
+    return _start;
+}
+
+
+// --------- XMLPullParser ---------- //
+
+// Read a name the same way StrPair::ParseName does.
+static char* ParseViewName( char* p, XMLStringView* view )
+{
+    char* start = p;
+    while( *p && ( p == start ? XMLUtil::IsNameStartChar( *p ) : XMLUtil::IsNameChar( *p ) )) {
+        ++p;
+    }
+    if ( p == start ) {
+        return 0;
+    }
+    view->Set( start, p, 0 );
+    return p;
+}
+
+
+XMLPullParser::XMLPullParser( bool processEntities, Whitespace whitespace ) :
+    _processEntities( processEntities ),
+    _whitespace( whitespace ),
+    _hasBOM( false ),
+    _errorID( XML_NO_ERROR ),
+    _errorStr1( 0 ),
+    _errorStr2( 0 ),
+    _p( 0 ),
+    _afterBracket( false ),
+    _event( NO_EVENT ),
+    _cdata( false ),
+    _selfClosing( false ),
+    _pendingEnd( false ),
+    _charBuffer( 0 ),
+    _mapped( 0 ),
+    _mappedSize( 0 )
+{
+}
+
+
+XMLPullParser::~XMLPullParser()
+{
+    Clear();
+}
+
+
+void XMLPullParser::Clear()
+{
+    _hasBOM = false;
+    _errorID = XML_NO_ERROR;
+    _errorStr1 = 0;
+    _errorStr2 = 0;
+
+    _p = 0;
+    _afterBracket = false;
+    _event = NO_EVENT;
+    _cdata = false;
+    _selfClosing = false;
+    _pendingEnd = false;
+
+    _name = XMLStringView();
+    _value = XMLStringView();
+    _attributes.PopArr( _attributes.Size() );
+    _stack.PopArr( _stack.Size() );
+
+    delete [] _charBuffer;
+    _charBuffer = 0;
+    UnmapFile();
+}
+
+
+XMLError XMLPullParser::ParseInSitu( char* xml, size_t nBytes )
+{
+    Clear();
+    if ( !xml || !*xml ) {
+        SetError( XML_ERROR_EMPTY_DOCUMENT, 0, 0 );
+        return _errorID;
+    }
+    TIXMLASSERT( nBytes == (size_t)(-1) || xml[nBytes] == 0 );
+    (void)nBytes;
+    return Start( xml );
+}
+
+
+XMLError XMLPullParser::Parse( const char* xml, size_t nBytes )
+{
+    Clear();
+    if ( !xml || !*xml ) {
+        SetError( XML_ERROR_EMPTY_DOCUMENT, 0, 0 );
+        return _errorID;
+    }
+    if ( nBytes == (size_t)(-1) ) {
+        nBytes = strlen( xml );
+    }
+    _charBuffer = new char[ nBytes+1 ];
+    memcpy( _charBuffer, xml, nBytes );
+    _charBuffer[nBytes] = 0;
+    return Start( _charBuffer );
+}
+
+
+XMLError XMLPullParser::LoadFile( const char* filename )
+{
+    Clear();
+    if ( MapFile( filename ) ) {
+        return Start( static_cast<char*>( _mapped ) );
+    }
+
+    // Couldn't map it, so read it like XMLDocument does.
+    FILE* fp = 0;
+#if defined(_MSC_VER) && (_MSC_VER >= 1400 )
+    errno_t err = fopen_s(&fp, filename, "rb" );
+    if ( !fp || err) {
+#else
+    fp = fopen( filename, "rb" );
+    if ( !fp) {
+#endif
+        SetError( XML_ERROR_FILE_NOT_FOUND, filename, 0 );
+        return _errorID;
+    }
+
+    fseek( fp, 0, SEEK_END );
+    size_t size = ftell( fp );
+    fseek( fp, 0, SEEK_SET );
+
+    if ( size == 0 ) {
+        fclose( fp );
+        SetError( XML_ERROR_EMPTY_DOCUMENT, 0, 0 );
+        return _errorID;
+    }
+
+    _charBuffer = new char[size+1];
+    size_t read = fread( _charBuffer, 1, size, fp );
+    fclose( fp );
+    if ( read != size ) {
+        SetError( XML_ERROR_FILE_READ_ERROR, 0, 0 );
+        return _errorID;
+    }
+    _charBuffer[size] = 0;
+    return Start( _charBuffer );
+}
+
+
+bool XMLPullParser::MapFile( const char* filename )
+{
+    // Mapped pages past the end of a file read as zero, which gives the
+    // buffer its terminating null for free. A file that exactly fills its
+    // last page has no room for one, so that case is left to be read instead.
+#if defined(TINYXML2_NO_MMAP)
+    (void)filename;
+    return false;
+#elif defined(_WIN32)
+    HANDLE file = CreateFileA( filename, GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0 );
+    if ( file == INVALID_HANDLE_VALUE ) {
+        return false;
+    }
+    LARGE_INTEGER size;
+    SYSTEM_INFO info;
+    GetSystemInfo( &info );
+    if ( !GetFileSizeEx( file, &size ) || size.QuadPart == 0
+            || (ULONGLONG)size.QuadPart != (size_t)size.QuadPart
+            || size.QuadPart % info.dwPageSize == 0 ) {
+        CloseHandle( file );
+        return false;
+    }
+    // Copy-on-write, so parsing in place never touches the file on disk.
+    HANDLE mapping = CreateFileMappingA( file, 0, PAGE_WRITECOPY, 0, 0, 0 );
+    CloseHandle( file );
+    if ( !mapping ) {
+        return false;
+    }
+    _mapped = MapViewOfFile( mapping, FILE_MAP_COPY, 0, 0, 0 );
+    CloseHandle( mapping );	// the view keeps the mapping alive
+    if ( !_mapped ) {
+        return false;
+    }
+    _mappedSize = (size_t)size.QuadPart;
+    return true;
+#else
+    int fd = open( filename, O_RDONLY );
+    if ( fd < 0 ) {
+        return false;
+    }
+    struct stat info;
+    long pageSize = sysconf( _SC_PAGESIZE );
+    if ( fstat( fd, &info ) != 0 || info.st_size == 0 || pageSize <= 0
+            || info.st_size % pageSize == 0 ) {
+        close( fd );
+        return false;
+    }
+    // Private, so parsing in place never touches the file on disk.
+    void* mapped = mmap( 0, info.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0 );
+    close( fd );
+    if ( mapped == MAP_FAILED ) {
+        return false;
+    }
+    _mapped = mapped;
+    _mappedSize = info.st_size;
+    return true;
+#endif
+}
+
+
+void XMLPullParser::UnmapFile()
+{
+    if ( !_mapped ) {
+        return;
+    }
+#if defined(TINYXML2_NO_MMAP)
+#elif defined(_WIN32)
+    UnmapViewOfFile( _mapped );
+#else
+    munmap( _mapped, _mappedSize );
+#endif
+    _mapped = 0;
+    _mappedSize = 0;
+}
+
+
+XMLError XMLPullParser::Start( char* p )
+{
+    p = XMLUtil::SkipWhiteSpace( p );
+    p = const_cast<char*>( XMLUtil::ReadBOM( p, &_hasBOM ) );
+    if ( !p || !*p ) {
+        SetError( XML_ERROR_EMPTY_DOCUMENT, 0, 0 );
+        return _errorID;
+    }
+    _p = p;
+    return _errorID;
+}
+
+
+XMLPullParser::EventType XMLPullParser::SetError( XMLError error, const char* str1, const char* str2 )
+{
+    _errorID = error;
+    _errorStr1 = str1;
+    _errorStr2 = str2;
+    _event = END_DOCUMENT;
+    return _event;
+}
+
+
+XMLPullParser::EventType XMLPullParser::Next()
+{
+    // The element reported last time is now open.
+    if ( _event == START_ELEMENT && !_selfClosing ) {
+        _stack.Push( _name );
+    }
+    _cdata = false;
+    _selfClosing = false;
+    _attributes.PopArr( _attributes.Size() );
+
+    // A self-closing element gets an end event, just like the DOM visitor
+    // gets a VisitExit.
+    if ( _pendingEnd ) {
+        _pendingEnd = false;
+        _event = END_ELEMENT;
+        return _event;
+    }
+
+    if ( Error() || !_p || _event == END_DOCUMENT ) {
+        _event = END_DOCUMENT;
+        return _event;
+    }
+
+    // If the last event was text, the '<' that ended it may have been
+    // overwritten by XMLStringView::CStr(), so don't look for it again.
+    if ( _afterBracket ) {
+        _afterBracket = false;
+        return ParseMarkup( _p );
+    }
+
+    char* start = _p;
+    char* p = XMLUtil::SkipWhiteSpace( start );
+    if ( !*p ) {
+        _p = p;
+        if ( !_stack.Empty() ) {
+            return SetError( XML_ERROR_MISMATCHED_ELEMENT, _stack.PeekTop().Data(), 0 );
+        }
+        _event = END_DOCUMENT;
+        return _event;
+    }
+    if ( *p == '<' ) {
+        return ParseMarkup( p+1 );
+    }
+
+    // Text runs to the next tag, and all of it counts - including the white
+    // space that was skipped looking for a tag.
+    int flags = _processEntities ? StrPair::TEXT_ELEMENT : StrPair::TEXT_ELEMENT_LEAVE_ENTITIES;
+    if ( _whitespace == COLLAPSE_WHITESPACE ) {
+        flags |= StrPair::COLLAPSE_WHITESPACE;
+    }
+    p = strchr( start, '<' );
+    if ( !p ) {
+        return SetError( XML_ERROR_PARSING_TEXT, start, 0 );
+    }
+    _value.Set( start, p, flags );
+    _p = p+1;
+    _afterBracket = true;
+    _event = TEXT;
+    return _event;
+}
+
+
+XMLPullParser::EventType XMLPullParser::ParseMarkup( char* p )
+{
+    // Same identification rules as XMLDocument::Identify; p is just past the '<'.
+    if ( XMLUtil::StringEqual( p, "?", 1 ) ) {
+        return ParseEnclosed( p+1, "?>", StrPair::NEEDS_NEWLINE_NORMALIZATION, XML_ERROR_PARSING_DECLARATION, DECLARATION );
+    }
+    if ( XMLUtil::StringEqual( p, "!--", 3 ) ) {
+        return ParseEnclosed( p+3, "-->", StrPair::COMMENT, XML_ERROR_PARSING_COMMENT, COMMENT );
+    }
+    if ( XMLUtil::StringEqual( p, "![CDATA[", 8 ) ) {
+        EventType event = ParseEnclosed( p+8, "]]>", StrPair::NEEDS_NEWLINE_NORMALIZATION, XML_ERROR_PARSING_CDATA, TEXT );
+        _cdata = ( event == TEXT );
+        return event;
+    }
+    if ( XMLUtil::StringEqual( p, "!", 1 ) ) {
+        return ParseEnclosed( p+1, ">", StrPair::NEEDS_NEWLINE_NORMALIZATION, XML_ERROR_PARSING_UNKNOWN, UNKNOWN );
+    }
+    p = XMLUtil::SkipWhiteSpace( p );
+    if ( *p == '/' ) {
+        return ParseEndTag( p+1 );
+    }
+    return ParseStartTag( p );
+}
+
+
+XMLPullParser::EventType XMLPullParser::ParseEnclosed( char* p, const char* endTag, int flags, XMLError error, EventType event )
+{
+    char* start = p;
+    char  endChar = *endTag;
+    size_t length = strlen( endTag );
+
+    while ( *p ) {
+        if ( *p == endChar && strncmp( p, endTag, length ) == 0 ) {
+            _value.Set( start, p, flags );
+            _p = p + length;
+            _event = event;
+            return _event;
+        }
+        ++p;
+    }
+    return SetError( error, start, 0 );
+}
+
+
+XMLPullParser::EventType XMLPullParser::ParseStartTag( char* p )
+{
+    const char* start = p;
+    p = ParseViewName( p, &_name );
+    if ( !p ) {
+        return SetError( XML_ERROR_PARSING, 0, 0 );	// as the DOM reports a missing name
+    }
+
+    // Read the whole tag before reporting it, so nothing after the end of any
+    // view is still waiting to be parsed if the caller decodes one in place.
+    int flags = _processEntities ? StrPair::ATTRIBUTE_VALUE : StrPair::ATTRIBUTE_VALUE_LEAVE_ENTITIES;
+    while( true ) {
+        p = XMLUtil::SkipWhiteSpace( p );
+        if ( !*p ) {
+            return SetError( XML_ERROR_PARSING_ELEMENT, start, 0 );
+        }
+
+        // attribute.
+        if ( XMLUtil::IsNameStartChar( *p ) ) {
+            XMLStringView* attribute = _attributes.PushArr( 2 );
+            p = ParseViewName( p, &attribute[0] );
+            if ( p ) {
+                p = XMLUtil::SkipWhiteSpace( p );
+                if ( *p == '=' ) {
+                    p = XMLUtil::SkipWhiteSpace( p+1 );
+                    char* end = 0;
+                    if ( *p == '\"' || *p == '\'' ) {
+                        end = strchr( p+1, *p );
+                    }
+                    if ( end ) {
+                        attribute[1].Set( p+1, end, flags );
+                    }
+                    p = end ? end+1 : 0;
+                }
+                else {
+                    p = 0;
+                }
+            }
+            for( int i=0; p && i<AttributeCount()-1; ++i ) {
+                if ( AttributeName( i ).Equals( attribute[0] ) ) {
+                    p = 0;	// duplicate attribute
+                }
+            }
+            if ( !p ) {
+                return SetError( XML_ERROR_PARSING_ATTRIBUTE, start, 0 );
+            }
+        }
+        // end of the tag
+        else if ( *p == '/' && *(p+1) == '>' ) {
+            _selfClosing = true;
+            _pendingEnd = true;
+            _p = p+2;
+            break;
+        }
+        // end of the tag
+        else if ( *p == '>' ) {
+            _p = p+1;
+            break;
+        }
+        else {
+            return SetError( XML_ERROR_PARSING_ELEMENT, start, p );
+        }
+    }
+    _event = START_ELEMENT;
+    return _event;
+}
+
+
+XMLPullParser::EventType XMLPullParser::ParseEndTag( char* p )
+{
+    const char* start = p;
+    p = ParseViewName( p, &_name );
+    if ( !p ) {
+        return SetError( XML_ERROR_PARSING, 0, 0 );	// as the DOM reports a missing name
+    }
+    p = XMLUtil::SkipWhiteSpace( p );
+    if ( *p != '>' ) {
+        return SetError( XML_ERROR_PARSING_ELEMENT, start, p );
+    }
+    if ( _stack.Empty() || !_stack.PeekTop().Equals( _name ) ) {
+        return SetError( XML_ERROR_MISMATCHED_ELEMENT, start, 0 );
+    }
+    _stack.Pop();
+    _p = p+1;
+    _event = END_ELEMENT;
+    return _event;
+}
+
+
+XMLStringView* XMLPullParser::FindAttribute( const char* name )
+{
+    for( int i=0; i<AttributeCount(); ++i ) {
+        if ( AttributeName( i ).Equals( name ) ) {
+            return &AttributeValue( i );
+        }
+    }
+    return 0;
+}
+
+
+XMLError XMLPullParser::Accept( XMLSaxHandler* handler )
+{
+    bool keepGoing = true;
+    while ( keepGoing ) {
+        switch ( Next() ) {
+            case START_ELEMENT:
+                keepGoing = handler->StartElement( *this );
+                break;
+            case END_ELEMENT:
+                keepGoing = handler->EndElement( *this );
+                break;
+            case TEXT:
+                keepGoing = handler->Text( *this );
+                break;
+            case COMMENT:
+                keepGoing = handler->Comment( *this );
+                break;
+            case DECLARATION:
+                keepGoing = handler->Declaration( *this );
+                break;
+            case UNKNOWN:
+                keepGoing = handler->Unknown( *this );
+                break;
+            default:
+                keepGoing = false;
+                break;
+        }
+    }
+    return _errorID;
+}
+
+
 }   // namespace tinyxml2
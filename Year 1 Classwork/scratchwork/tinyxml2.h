@@ -20,6 +20,9 @@ must not be misrepresented as being the original software.
 
 3. This notice may not be removed or altered from any source
 distribution.
+
+This is an altered version: XMLStringView, XMLSaxHandler, and XMLPullParser
+(a streaming, in-situ parsing mode) were added to the original source.
 */
 
 #ifndef TINYXML2_INCLUDED
@@ -1633,6 +1636,270 @@ private:
 };
 
 
+/**
+	A view of a run of characters inside a buffer being parsed by an
+	XMLPullParser. The view is not null terminated; use Data() and Length()
+	to read the raw characters without copying, or CStr() to normalize
+	newlines and translate entities in place, which null terminates the view.
+*/
+class TINYXML2_LIB XMLStringView
+{
+public:
+    XMLStringView() : _start( 0 ), _end( 0 ), _flags( 0 ) {}
+
+    void Set( char* start, char* end, int flags ) {
+        _start = start;
+        _end = end;
+        _flags = flags;
+    }
+
+    /// The raw characters of the view. Not null terminated unless CStr() was called.
+    const char* Data() const {
+        return _start;
+    }
+    /// The number of raw characters in the view.
+    size_t Length() const {
+        return _end - _start;
+    }
+    bool Empty() const {
+        return _start == _end;
+    }
+    /// Compare the raw characters to a null terminated string.
+    bool Equals( const char* str ) const;
+    /// Compare the raw characters to another view.
+    bool Equals( const XMLStringView& view ) const;
+
+    /**
+    	Process the view in place, the same way the DOM processes the values
+    	of its nodes, and return it as a null terminated string. This writes
+    	into the parse buffer, but never past the end of the view.
+    */
+    const char* CStr();
+
+private:
+    enum {
+        DECODED = 0x1000
+    };
+
+    char*   _start;
+    char*   _end;
+    int     _flags;
+};
+
+
+class XMLPullParser;
+
+/**
+	Implements the callbacks used by XMLPullParser::Accept(). Each callback is
+	handed the parser, which holds the data for the current event. Returning
+	false from a callback stops parsing.
+*/
+class TINYXML2_LIB XMLSaxHandler
+{
+public:
+    virtual ~XMLSaxHandler() {}
+
+    /// An element start tag, with its name and attributes. Self-closing elements get both calls.
+    virtual bool StartElement( XMLPullParser& /*parser*/ )	{
+        return true;
+    }
+    /// An element end tag.
+    virtual bool EndElement( XMLPullParser& /*parser*/ )	{
+        return true;
+    }
+    /// Text or CDATA.
+    virtual bool Text( XMLPullParser& /*parser*/ )			{
+        return true;
+    }
+    /// A comment.
+    virtual bool Comment( XMLPullParser& /*parser*/ )		{
+        return true;
+    }
+    /// A declaration.
+    virtual bool Declaration( XMLPullParser& /*parser*/ )	{
+        return true;
+    }
+    /// An unknown tag, such as a DTD.
+    virtual bool Unknown( XMLPullParser& /*parser*/ )		{
+        return true;
+    }
+};
+
+
+/**
+	A streaming parser that uses the same tokenizing rules as XMLDocument, but
+	reports the document as a series of events instead of building nodes. It
+	parses in place: the buffer must stay alive and writable for as long as the
+	parser is used, and the strings it reports are views into that buffer.
+
+	The one difference from XMLDocument is an end tag outside of any element:
+	XMLDocument quietly stops reading there, but the pull parser reports
+	XML_ERROR_MISMATCHED_ELEMENT, since anything after it would be lost.
+
+	@verbatim
+	XMLPullParser parser;
+	parser.LoadFile( "sprites.xml" );
+	while ( parser.Next() != XMLPullParser::END_DOCUMENT ) {
+		if ( parser.Event() == XMLPullParser::START_ELEMENT && parser.Name().Equals( "sprite" ) ) {
+			XMLStringView* frame = parser.FindAttribute( "frame" );
+			...
+		}
+	}
+	if ( parser.Error() ) {
+		...
+	}
+	@endverbatim
+
+	Or, to have events pushed to you, implement an XMLSaxHandler and call
+	Accept().
+*/
+class TINYXML2_LIB XMLPullParser
+{
+public:
+    enum EventType {
+        NO_EVENT,			///< Next() has not been called yet.
+        END_DOCUMENT,		///< The whole document was read, or there was an error.
+        START_ELEMENT,		///< Name() and the attributes are set.
+        END_ELEMENT,		///< Name() is set.
+        TEXT,				///< Value() is set. Check CData().
+        COMMENT,			///< Value() is set.
+        DECLARATION,		///< Value() is set.
+        UNKNOWN				///< Value() is set.
+    };
+
+    XMLPullParser( bool processEntities = true, Whitespace = PRESERVE_WHITESPACE );
+    ~XMLPullParser();
+
+    /**
+    	Parse a writable, null terminated buffer in place. The parser does not
+    	take ownership of the buffer. If 'nBytes' is given, xml[nBytes] must be
+    	the null terminator.
+    */
+    XMLError ParseInSitu( char* xml, size_t nBytes=(size_t)(-1) );
+
+    /**
+    	Copy a buffer and parse the copy, like XMLDocument::Parse().
+    */
+    XMLError Parse( const char* xml, size_t nBytes=(size_t)(-1) );
+
+    /**
+    	Load an XML file from disk. Where possible, the file is memory mapped
+    	copy-on-write instead of read, so the file on disk is never modified.
+    */
+    XMLError LoadFile( const char* filename );
+
+    /// Advance to the next event and return its type.
+    EventType Next();
+
+    /**
+    	Read events and pass them to the handler until the document ends, an
+    	error occurs, or the handler returns false.
+    */
+    XMLError Accept( XMLSaxHandler* handler );
+
+    /// The type of the current event.
+    EventType Event() const {
+        return _event;
+    }
+    /// The element name, for START_ELEMENT and END_ELEMENT.
+    XMLStringView& Name() {
+        return _name;
+    }
+    /// The contents of a TEXT, COMMENT, DECLARATION, or UNKNOWN event.
+    XMLStringView& Value() {
+        return _value;
+    }
+    /// Whether the current TEXT event came from a CDATA section.
+    bool CData() const {
+        return _cdata;
+    }
+    /// Whether the current START_ELEMENT is self-closing, as in <foo/>.
+    bool SelfClosing() const {
+        return _selfClosing;
+    }
+    /// How many elements enclose the current event. An element's own events are outside it.
+    int Depth() const {
+        return _stack.Size();
+    }
+
+    /// The number of attributes on the current START_ELEMENT.
+    int AttributeCount() const {
+        return _attributes.Size() / 2;
+    }
+    XMLStringView& AttributeName( int i ) {
+        return _attributes[i*2];
+    }
+    XMLStringView& AttributeValue( int i ) {
+        return _attributes[i*2+1];
+    }
+    /// The value of the named attribute of the current START_ELEMENT, or null if there is none.
+    XMLStringView* FindAttribute( const char* name );
+
+    bool HasBOM() const {
+        return _hasBOM;
+    }
+    bool ProcessEntities() const		{
+        return _processEntities;
+    }
+    Whitespace WhitespaceMode() const	{
+        return _whitespace;
+    }
+
+    /// Return true if there was an error parsing the document.
+    bool Error() const {
+        return _errorID != XML_NO_ERROR;
+    }
+    XMLError ErrorID() const {
+        return _errorID;
+    }
+    const char* GetErrorStr1() const {
+        return _errorStr1;
+    }
+    const char* GetErrorStr2() const {
+        return _errorStr2;
+    }
+
+    /// Release the buffer and reset the parser to the initial state.
+    void Clear();
+
+private:
+    XMLPullParser( const XMLPullParser& );	// not supported
+    void operator=( const XMLPullParser& );	// not supported
+
+    XMLError Start( char* p );
+    EventType SetError( XMLError error, const char* str1, const char* str2 );
+    EventType ParseMarkup( char* p );
+    EventType ParseStartTag( char* p );
+    EventType ParseEndTag( char* p );
+    EventType ParseEnclosed( char* p, const char* endTag, int flags, XMLError error, EventType event );
+    bool MapFile( const char* filename );
+    void UnmapFile();
+
+    bool        _processEntities;
+    Whitespace  _whitespace;
+    bool        _hasBOM;
+    XMLError    _errorID;
+    const char* _errorStr1;
+    const char* _errorStr2;
+
+    char*       _p;					// read position
+    bool        _afterBracket;		// text ended by consuming the '<' of the next tag
+    EventType   _event;
+    bool        _cdata;
+    bool        _selfClosing;
+    bool        _pendingEnd;		// an END_ELEMENT is owed for a self-closing tag
+
+    XMLStringView _name;
+    XMLStringView _value;
+    DynArray< XMLStringView, 16 > _attributes;	// name, value, name, value...
+    DynArray< XMLStringView, 16 > _stack;		// names of the open elements
+
+    char*       _charBuffer;		// owned copy, from Parse() or LoadFile()
+    void*       _mapped;			// memory mapped file, from LoadFile()
+    size_t      _mappedSize;
+};
+
+
 /**
 	A XMLHandle is a class that wraps a node pointer with null checks; this is
 	an incredibly useful thing. Note that XMLHandle is not part of the TinyXML-2